@@ -1120,6 +1120,10 @@ macro(process_options)
     endif()
   endif()
 
+  if(${NS3_MTP})
+    add_definitions(-DNS3_MTP)
+  endif()
+
   mark_as_advanced(Boost_INCLUDE_DIR)
   find_package(Boost)
   if(${Boost_FOUND})
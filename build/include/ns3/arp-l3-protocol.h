@@ -0,0 +1 @@
+#include "/root/repo/src/internet/model/arp-l3-protocol.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/stats/model/binary-trace-schema.h"
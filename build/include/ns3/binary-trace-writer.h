@@ -0,0 +1 @@
+#include "/root/repo/src/stats/model/binary-trace-writer.h"
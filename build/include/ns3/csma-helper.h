@@ -0,0 +1 @@
+#include "/root/repo/src/csma/helper/csma-helper.h"
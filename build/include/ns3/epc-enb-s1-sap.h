@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/epc-enb-s1-sap.h"
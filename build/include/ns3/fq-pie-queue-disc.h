@@ -0,0 +1 @@
+#include "/root/repo/src/traffic-control/model/fq-pie-queue-disc.h"
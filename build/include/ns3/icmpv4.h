@@ -0,0 +1 @@
+#include "/root/repo/src/internet/model/icmpv4.h"
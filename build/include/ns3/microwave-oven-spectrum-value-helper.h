@@ -0,0 +1 @@
+#include "/root/repo/src/spectrum/model/microwave-oven-spectrum-value-helper.h"
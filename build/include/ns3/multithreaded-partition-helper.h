@@ -0,0 +1 @@
+#include "/root/repo/src/network/helper/multithreaded-partition-helper.h"
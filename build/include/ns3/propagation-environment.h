@@ -0,0 +1 @@
+#include "/root/repo/src/propagation/model/propagation-environment.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/buildings/model/radio-map.h"
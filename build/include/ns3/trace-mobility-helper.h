@@ -0,0 +1 @@
+#include "/root/repo/src/mobility/helper/trace-mobility-helper.h"
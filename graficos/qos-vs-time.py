@@ -11,9 +11,32 @@ from collections import namedtuple
 
 NUM_UES = 75
 
-def readFile(filePath):
-	result = pd.read_csv(filePath, sep=',', header=0, usecols=['Time',
-						'Delay', 'Jitter', 'Throughput', 'PDR'])
+def readQos(runPath):
+	# per interval statistics of the flows, from the FlowMonitor
+	intervals = pd.read_csv(runPath + "/flow-intervals.csv", sep=',', header=0)
+	flows = pd.read_csv(runPath + "/flows.csv", sep=',', header=0)
+
+	# only the downlink flows of the UEs
+	flows = flows[flows['UE'] >= 0]
+	result = intervals.merge(flows[['FlowId', 'UE']], on='FlowId')
+	rx = result['RxPackets']
+	tx = result[['TxPackets', 'RxPackets']].max(axis=1)
+	result = result[tx > 0]
+	rx = rx[tx > 0]
+	tx = tx[tx > 0]
+
+	qos = pd.DataFrame()
+	qos['Time'] = result['End']
+	qos['UE'] = result['UE']
+	qos['Delay'] = (result['DelaySum'] / rx).where(rx > 0, 0)
+	qos['Jitter'] = (result['JitterSum'] / (rx - 1)).where(rx > 1, 0)
+	qos['Throughput'] = result['RxBytes'] * 8.0 / (result['End'] - result['Start']) / 1024 / 1024
+	qos['PDR'] = 100 * rx / tx
+
+	return qos
+
+def readFile(runPath):
+	result = readQos(runPath)[['Time', 'Delay', 'Jitter', 'Throughput', 'PDR']]
 
 	result = result.groupby('Time', as_index=False).mean(numeric_only=True)
 	result['Delay'] = result['Delay'] * 1000
@@ -52,7 +75,7 @@ jitter_rectangles = []
 tp_rectangles = []
 
 for variant in scenario_variants:
-	data_scenarios = readFile(variant.path + "/run=0/qos-vs-time.txt")
+	data_scenarios = readFile(variant.path + "/run=0")
 	print(data_scenarios)
 
 	mean = data_scenarios
@@ -7,6 +7,7 @@ import pandas as pd
 from matplotlib import pyplot as plt
 import csv
 import glob
+import os
 from collections import namedtuple
 
 def getLastNum(directory):
@@ -27,9 +28,32 @@ def getScenarios(path):
 	return scenarios
 
 
-def readFile(filePath):
-	result = pd.read_csv(filePath, sep=',', header=0, usecols=['Time',
-						'Delay', 'Jitter', 'Throughput', 'PDR'])
+def readQos(runPath):
+	# per interval statistics of the flows, from the FlowMonitor
+	intervals = pd.read_csv(runPath + "/flow-intervals.csv", sep=',', header=0)
+	flows = pd.read_csv(runPath + "/flows.csv", sep=',', header=0)
+
+	# only the downlink flows of the UEs
+	flows = flows[flows['UE'] >= 0]
+	result = intervals.merge(flows[['FlowId', 'UE']], on='FlowId')
+	rx = result['RxPackets']
+	tx = result[['TxPackets', 'RxPackets']].max(axis=1)
+	result = result[tx > 0]
+	rx = rx[tx > 0]
+	tx = tx[tx > 0]
+
+	qos = pd.DataFrame()
+	qos['Time'] = result['End']
+	qos['UE'] = result['UE']
+	qos['Delay'] = (result['DelaySum'] / rx).where(rx > 0, 0)
+	qos['Jitter'] = (result['JitterSum'] / (rx - 1)).where(rx > 1, 0)
+	qos['Throughput'] = result['RxBytes'] * 8.0 / (result['End'] - result['Start']) / 1024 / 1024
+	qos['PDR'] = 100 * rx / tx
+
+	return qos
+
+def readFile(runPath):
+	result = readQos(runPath)[['Time', 'Delay', 'Jitter', 'Throughput', 'PDR']]
 
 	grouped = result.groupby('Time', as_index=False)
 	tp = grouped['Throughput'].sum().mean()
@@ -44,7 +68,8 @@ def readFile(filePath):
 def getData(scenarios):
 	data = []
 	for scenario in scenarios.items():
-		runs = glob.glob(scenario[1] + "/run=*/qos-vs-time.txt")
+		runs = glob.glob(scenario[1] + "/run=*/flow-intervals.csv")
+		runs = [os.path.dirname(run) for run in runs]
 		qos = []
 		for run in runs:
 			qos_run = readFile(run)
@@ -19,6 +19,7 @@
 
 #include "antenna-model.h"
 
+#include <ns3/double.h>
 #include <ns3/log.h>
 
 #include <cmath>
@@ -31,6 +32,11 @@ NS_LOG_COMPONENT_DEFINE("AntennaModel");
 NS_OBJECT_ENSURE_REGISTERED(AntennaModel);
 
 AntennaModel::AntennaModel()
+    : m_gainTableStep(0),
+      m_azimuths(0),
+      m_inclinations(0),
+      m_azimuthStep(0),
+      m_inclinationStep(0)
 {
 }
 
@@ -41,8 +47,103 @@ AntennaModel::~AntennaModel()
 TypeId
 AntennaModel::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::AntennaModel").SetParent<Object>().SetGroupName("Antenna");
+    static TypeId tid =
+        TypeId("ns3::AntennaModel")
+            .SetParent<Object>()
+            .SetGroupName("Antenna")
+            .AddAttribute("GainTableStep",
+                          "If positive, the step (degrees) in azimuth and inclination of the "
+                          "table of the pattern in which the gains of GetGainsDb are "
+                          "interpolated. Only meant for static patterns.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&AntennaModel::SetGainTableStep),
+                          MakeDoubleChecker<double>(0, 90));
     return tid;
 }
 
+void
+AntennaModel::GetGainsDb(const std::vector<Angles>& angles, std::vector<double>& gainsDb)
+{
+    NS_LOG_FUNCTION(this << angles.size());
+    gainsDb.resize(angles.size());
+    if (m_gainTableStep <= 0)
+    {
+        DoGetGainsDb(angles, gainsDb);
+        return;
+    }
+    if (m_gainTable.empty())
+    {
+        BuildGainTable();
+    }
+    for (std::size_t i = 0; i < angles.size(); ++i)
+    {
+        double azimuth = angles[i].GetAzimuth();
+        double inclination = angles[i].GetInclination();
+        if (!std::isfinite(azimuth) || !std::isfinite(inclination))
+        {
+            // undefined angles, as GetGainDb handles them
+            gainsDb[i] = GetGainDb(angles[i]);
+            continue;
+        }
+        // bilinear interpolation in the cell of the table holding the
+        // direction, the azimuth being in [-pi, pi)
+        double u = (azimuth + M_PI) / m_azimuthStep;
+        double v = inclination / m_inclinationStep;
+        std::size_t k = std::min(static_cast<std::size_t>(u), m_azimuths - 2);
+        std::size_t l = std::min(static_cast<std::size_t>(v), m_inclinations - 2);
+        double fu = u - k;
+        double fv = v - l;
+        const double* gains = &m_gainTable[k * m_inclinations + l];
+        const double* nextGains = gains + m_inclinations;
+        gainsDb[i] = (1 - fu) * ((1 - fv) * gains[0] + fv * gains[1]) +
+                     fu * ((1 - fv) * nextGains[0] + fv * nextGains[1]);
+    }
+}
+
+void
+AntennaModel::DoGetGainsDb(const std::vector<Angles>& angles, std::vector<double>& gainsDb)
+{
+    for (std::size_t i = 0; i < angles.size(); ++i)
+    {
+        gainsDb[i] = GetGainDb(angles[i]);
+    }
+}
+
+void
+AntennaModel::ClearGainTable()
+{
+    m_gainTable.clear();
+}
+
+void
+AntennaModel::SetGainTableStep(double stepDegrees)
+{
+    NS_LOG_FUNCTION(this << stepDegrees);
+    m_gainTableStep = DegreesToRadians(stepDegrees);
+    ClearGainTable();
+}
+
+void
+AntennaModel::BuildGainTable()
+{
+    NS_LOG_FUNCTION(this);
+    m_azimuths = static_cast<std::size_t>(std::ceil(2 * M_PI / m_gainTableStep)) + 1;
+    m_inclinations = static_cast<std::size_t>(std::ceil(M_PI / m_gainTableStep)) + 1;
+    m_azimuthStep = 2 * M_PI / (m_azimuths - 1);
+    m_inclinationStep = M_PI / (m_inclinations - 1);
+    std::vector<Angles> angles;
+    angles.reserve(m_azimuths * m_inclinations);
+    for (std::size_t k = 0; k < m_azimuths; ++k)
+    {
+        for (std::size_t l = 0; l < m_inclinations; ++l)
+        {
+            angles.emplace_back(-M_PI + k * m_azimuthStep,
+                                std::min(l * m_inclinationStep, M_PI));
+        }
+    }
+    m_gainTable.resize(angles.size());
+    DoGetGainsDb(angles, m_gainTable);
+    NS_LOG_LOGIC("Table of " << m_azimuths << " x " << m_inclinations << " gains");
+}
+
 } // namespace ns3
@@ -24,6 +24,8 @@
 
 #include <ns3/object.h>
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -50,6 +52,15 @@ namespace ns3
  * angles. This choice is the one proposed "Antenna Theory - Analysis
  * and Design", C.A. Balanis, Wiley, 2nd Ed., see in particular
  * section 2.2 "Radiation pattern".
+ *
+ * The pattern may also be evaluated in many directions at once, for
+ * instance towards all the receivers of a transmission, with GetGainsDb.
+ * When the GainTableStep attribute is positive, the gains of GetGainsDb are
+ * interpolated in a table of the pattern sampled every GainTableStep degrees
+ * of azimuth and inclination, which is built at the first call. The table
+ * is only meant for static patterns: it is cleared by the setters of the
+ * models, but not when an attribute bound to a member, such as a maximum
+ * gain, is changed.
  */
 class AntennaModel : public Object
 {
@@ -75,6 +86,57 @@ class AntennaModel : public Object
      * the antenna is expected to be included in the gain value.
      */
     virtual double GetGainDb(Angles a) = 0;
+
+    /**
+     * Evaluate the radiation pattern in many directions at once.
+     *
+     * \param angles the spherical angles at which the radiation pattern
+     * should be evaluated
+     * \param gainsDb the power gains in dBi at each of the angles, as
+     * returned by GetGainDb, or interpolated in the table of the pattern if
+     * the GainTableStep attribute is positive
+     */
+    void GetGainsDb(const std::vector<Angles>& angles, std::vector<double>& gainsDb);
+
+  protected:
+    /**
+     * Clear the table of the pattern, which is built again at the next call
+     * of GetGainsDb. The subclasses must call it when their pattern changes.
+     */
+    void ClearGainTable();
+
+  private:
+    /**
+     * Evaluate the radiation pattern in many directions at once. The default
+     * implementation calls GetGainDb for each direction; the subclasses may
+     * override it to evaluate the pattern without a virtual call and
+     * logging per direction.
+     *
+     * \param angles the spherical angles at which the radiation pattern
+     * should be evaluated
+     * \param gainsDb the power gains in dBi at each of the angles, already
+     * resized to the number of angles
+     */
+    virtual void DoGetGainsDb(const std::vector<Angles>& angles, std::vector<double>& gainsDb);
+
+    /**
+     * Set the step of the table of the pattern.
+     * \param stepDegrees the step in azimuth and inclination, in degrees, or
+     * zero to evaluate the pattern without a table
+     */
+    void SetGainTableStep(double stepDegrees);
+
+    /**
+     * Sample the pattern in the table.
+     */
+    void BuildGainTable();
+
+    double m_gainTableStep;          //!< the step of the table, in radians, or zero
+    std::vector<double> m_gainTable; //!< the gains in dBi, by azimuth, then inclination
+    std::size_t m_azimuths;          //!< the number of azimuths of the table
+    std::size_t m_inclinations;      //!< the number of inclinations of the table
+    double m_azimuthStep;            //!< the step of the azimuths of the table, in radians
+    double m_inclinationStep;        //!< the step of the inclinations of the table, in radians
 };
 
 } // namespace ns3
@@ -110,6 +110,7 @@ CosineAntennaModel::SetVerticalBeamwidth(double verticalBeamwidthDegrees)
 {
     NS_LOG_FUNCTION(this << verticalBeamwidthDegrees);
     m_verticalExponent = GetExponentFromBeamwidth(verticalBeamwidthDegrees);
+    ClearGainTable();
 }
 
 void
@@ -117,6 +118,7 @@ CosineAntennaModel::SetHorizontalBeamwidth(double horizontalBeamwidthDegrees)
 {
     NS_LOG_FUNCTION(this << horizontalBeamwidthDegrees);
     m_horizontalExponent = GetExponentFromBeamwidth(horizontalBeamwidthDegrees);
+    ClearGainTable();
 }
 
 double
@@ -136,6 +138,7 @@ CosineAntennaModel::SetOrientation(double orientationDegrees)
 {
     NS_LOG_FUNCTION(this << orientationDegrees);
     m_orientationRadians = DegreesToRadians(orientationDegrees);
+    ClearGainTable();
 }
 
 double
@@ -166,4 +169,24 @@ CosineAntennaModel::GetGainDb(Angles a)
     return gainDb + m_maxGain;
 }
 
+void
+CosineAntennaModel::DoGetGainsDb(const std::vector<Angles>& angles, std::vector<double>& gainsDb)
+{
+    NS_LOG_FUNCTION(this << angles.size());
+    for (std::size_t i = 0; i < angles.size(); ++i)
+    {
+        if (std::isnan(angles[i].GetAzimuth()))
+        {
+            gainsDb[i] = GetGainDb(angles[i]);
+            continue;
+        }
+        // the pattern of GetGainDb, without the logging
+        double azimuth = WrapToPi(angles[i].GetAzimuth() - m_orientationRadians);
+        double inclination = angles[i].GetInclination();
+        double gain = (std::pow(std::cos(azimuth / 2), 2 * m_horizontalExponent)) *
+                      (std::pow(std::cos((M_PI / 2 - inclination) / 2), 2 * m_verticalExponent));
+        gainsDb[i] = 10 * std::log10(gain) + m_maxGain;
+    }
+}
+
 } // namespace ns3
@@ -78,6 +78,9 @@ class CosineAntennaModel : public AntennaModel
     double GetOrientation() const;
 
   private:
+    // inherited from AntennaModel
+    void DoGetGainsDb(const std::vector<Angles>& angles, std::vector<double>& gainsDb) override;
+
     /**
      * Set the vertical 3 dB beamwidth (bilateral) of the cosine antenna model.
      * \param verticalBeamwidthDegrees the vertical beamwidth in degrees
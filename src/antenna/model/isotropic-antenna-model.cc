@@ -24,6 +24,8 @@
 #include <ns3/double.h>
 #include <ns3/log.h>
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -58,4 +60,12 @@ IsotropicAntennaModel::GetGainDb(Angles a)
     return m_gainDb;
 }
 
+void
+IsotropicAntennaModel::DoGetGainsDb(const std::vector<Angles>& angles,
+                                    std::vector<double>& gainsDb)
+{
+    NS_LOG_FUNCTION(this << angles.size());
+    std::fill(gainsDb.begin(), gainsDb.end(), m_gainDb);
+}
+
 } // namespace ns3
@@ -48,6 +48,10 @@ class IsotropicAntennaModel : public AntennaModel
     // inherited from AntennaModel
     double GetGainDb(Angles a) override;
 
+  private:
+    // inherited from AntennaModel
+    void DoGetGainsDb(const std::vector<Angles>& angles, std::vector<double>& gainsDb) override;
+
   protected:
     /**
      * gain of the antenna in dB, in all directions
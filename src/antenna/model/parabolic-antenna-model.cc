@@ -67,6 +67,7 @@ ParabolicAntennaModel::SetBeamwidth(double beamwidthDegrees)
 {
     NS_LOG_FUNCTION(this << beamwidthDegrees);
     m_beamwidthRadians = DegreesToRadians(beamwidthDegrees);
+    ClearGainTable();
 }
 
 double
@@ -80,6 +81,7 @@ ParabolicAntennaModel::SetOrientation(double orientationDegrees)
 {
     NS_LOG_FUNCTION(this << orientationDegrees);
     m_orientationRadians = DegreesToRadians(orientationDegrees);
+    ClearGainTable();
 }
 
 double
@@ -113,4 +115,22 @@ ParabolicAntennaModel::GetGainDb(Angles a)
     return gainDb;
 }
 
+void
+ParabolicAntennaModel::DoGetGainsDb(const std::vector<Angles>& angles,
+                                    std::vector<double>& gainsDb)
+{
+    NS_LOG_FUNCTION(this << angles.size());
+    for (std::size_t i = 0; i < angles.size(); ++i)
+    {
+        if (std::isnan(angles[i].GetAzimuth()))
+        {
+            gainsDb[i] = GetGainDb(angles[i]);
+            continue;
+        }
+        // the pattern of GetGainDb, without the logging
+        double phi = WrapToPi(angles[i].GetAzimuth() - m_orientationRadians);
+        gainsDb[i] = -std::min(12 * std::pow(phi / m_beamwidthRadians, 2), m_maxAttenuation);
+    }
+}
+
 } // namespace ns3
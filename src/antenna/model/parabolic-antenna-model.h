@@ -78,6 +78,9 @@ class ParabolicAntennaModel : public AntennaModel
     double GetOrientation() const;
 
   private:
+    // inherited from AntennaModel
+    void DoGetGainsDb(const std::vector<Angles>& angles, std::vector<double>& gainsDb) override;
+
     double m_beamwidthRadians;   //!< Beam width in radians
     double m_orientationRadians; //!< Antenna orientation in radians
     double m_maxAttenuation;     //!< Max attenuation
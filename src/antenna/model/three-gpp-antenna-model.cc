@@ -111,4 +111,25 @@ ThreeGppAntennaModel::GetGainDb(Angles a)
     return gainDb;
 }
 
+void
+ThreeGppAntennaModel::DoGetGainsDb(const std::vector<Angles>& angles,
+                                   std::vector<double>& gainsDb)
+{
+    NS_LOG_FUNCTION(this << angles.size());
+    // the pattern of GetGainDb, without the logging
+    double horizontalFactor = 12 / (m_horizontalBeamwidthDegrees * m_horizontalBeamwidthDegrees);
+    double verticalFactor = 12 / (m_verticalBeamwidthDegrees * m_verticalBeamwidthDegrees);
+    for (std::size_t i = 0; i < angles.size(); ++i)
+    {
+        double phiDeg = RadiansToDegrees(angles[i].GetAzimuth());
+        double thetaDeg = RadiansToDegrees(angles[i].GetInclination()) - 90;
+        NS_ASSERT_MSG(-180.0 <= phiDeg && phiDeg <= 180.0, "Out of boundaries: phiDeg=" << phiDeg);
+        NS_ASSERT_MSG(-90.0 <= thetaDeg && thetaDeg <= 90.0,
+                      "Out of boundaries: thetaDeg=" << thetaDeg + 90);
+        double vertGain = -std::min(m_slaV, verticalFactor * thetaDeg * thetaDeg);
+        double horizGain = -std::min(m_aMax, horizontalFactor * phiDeg * phiDeg);
+        gainsDb[i] = m_geMax - std::min(m_aMax, -(vertGain + horizGain));
+    }
+}
+
 } // namespace ns3
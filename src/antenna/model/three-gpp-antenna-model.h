@@ -76,6 +76,9 @@ class ThreeGppAntennaModel : public AntennaModel
     double GetAntennaElementGain() const;
 
   private:
+    // inherited from AntennaModel
+    void DoGetGainsDb(const std::vector<Angles>& angles, std::vector<double>& gainsDb) override;
+
     double m_verticalBeamwidthDegrees; //!< beamwidth in the vertical direction \f$(\theta_{3dB})\f$
                                        //!< [deg]
     double m_horizontalBeamwidthDegrees; //!< beamwidth in the horizontal direction
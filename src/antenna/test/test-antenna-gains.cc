@@ -0,0 +1,177 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/double.h>
+#include <ns3/object-factory.h>
+#include <ns3/parabolic-antenna-model.h>
+#include <ns3/test.h>
+
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup antenna-tests
+ *
+ * \brief Check that the gains evaluated in many directions at once match the
+ * gains evaluated one direction at a time, and that the gains interpolated
+ * in the table of the pattern are close to them.
+ */
+class AntennaGainsTestCase : public TestCase
+{
+  public:
+    /// The attributes of the antenna model
+    using Attributes = std::vector<std::pair<std::string, double>>;
+
+    /**
+     * Constructor
+     * \param typeId the TypeId of the antenna model
+     * \param attributes the attributes of the antenna model
+     */
+    AntennaGainsTestCase(std::string typeId, Attributes attributes);
+
+  private:
+    void DoRun() override;
+
+    std::string m_typeId;    //!< the TypeId of the antenna model
+    Attributes m_attributes; //!< the attributes of the antenna model
+};
+
+AntennaGainsTestCase::AntennaGainsTestCase(std::string typeId, Attributes attributes)
+    : TestCase("Check the gains of the " + typeId + " in many directions"),
+      m_typeId(typeId),
+      m_attributes(attributes)
+{
+}
+
+void
+AntennaGainsTestCase::DoRun()
+{
+    ObjectFactory factory(m_typeId);
+    for (const auto& [name, value] : m_attributes)
+    {
+        factory.Set(name, DoubleValue(value));
+    }
+    Ptr<AntennaModel> antenna = factory.Create<AntennaModel>();
+
+    // every 5 degrees, and off the grid of the table
+    std::vector<Angles> angles;
+    for (double azimuth = -180; azimuth < 180; azimuth += 5)
+    {
+        for (double inclination = 0; inclination <= 180; inclination += 5)
+        {
+            angles.emplace_back(DegreesToRadians(azimuth), DegreesToRadians(inclination));
+            angles.emplace_back(DegreesToRadians(azimuth + 2.3),
+                                DegreesToRadians(std::min(inclination + 1.7, 180.0)));
+        }
+    }
+    std::vector<double> expected;
+    for (const auto& a : angles)
+    {
+        expected.push_back(antenna->GetGainDb(a));
+    }
+
+    std::vector<double> gainsDb;
+    antenna->GetGainsDb(angles, gainsDb);
+    NS_TEST_ASSERT_MSG_EQ(gainsDb.size(), angles.size(), "Wrong number of gains");
+    for (std::size_t i = 0; i < angles.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(gainsDb[i], expected[i], 1e-6, "Wrong gain at " << angles[i]);
+    }
+
+    // the interpolation is only checked off the deep nulls of the patterns,
+    // whose gain changes quickly, and is less accurate at their kinks
+    antenna->SetAttribute("GainTableStep", DoubleValue(1));
+    antenna->GetGainsDb(angles, gainsDb);
+    for (std::size_t i = 0; i < angles.size(); ++i)
+    {
+        if (expected[i] > -30)
+        {
+            NS_TEST_EXPECT_MSG_EQ_TOL(gainsDb[i],
+                                      expected[i],
+                                      0.25,
+                                      "Wrong interpolated gain at " << angles[i]);
+        }
+    }
+}
+
+/**
+ * \ingroup antenna-tests
+ *
+ * \brief Check that the table of the pattern is built again when the
+ * pattern changes.
+ */
+class AntennaGainTableTestCase : public TestCase
+{
+  public:
+    AntennaGainTableTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+AntennaGainTableTestCase::AntennaGainTableTestCase()
+    : TestCase("Check the table of the pattern of a rotated antenna")
+{
+}
+
+void
+AntennaGainTableTestCase::DoRun()
+{
+    Ptr<ParabolicAntennaModel> antenna = CreateObject<ParabolicAntennaModel>();
+    antenna->SetAttribute("GainTableStep", DoubleValue(2));
+    std::vector<Angles> angles = {Angles(0, M_PI_2), Angles(M_PI_2, M_PI_2)};
+    std::vector<double> gainsDb;
+    antenna->GetGainsDb(angles, gainsDb);
+    NS_TEST_EXPECT_MSG_EQ_TOL(gainsDb[0], 0, 1e-6, "Wrong gain at the boresight");
+    NS_TEST_EXPECT_MSG_EQ_TOL(gainsDb[1], -20, 1e-6, "Wrong gain off the boresight");
+
+    antenna->SetOrientation(90);
+    antenna->GetGainsDb(angles, gainsDb);
+    NS_TEST_EXPECT_MSG_EQ_TOL(gainsDb[0], -20, 1e-6, "Stale table");
+    NS_TEST_EXPECT_MSG_EQ_TOL(gainsDb[1], 0, 1e-6, "Stale table");
+}
+
+/**
+ * \ingroup antenna-tests
+ *
+ * \brief TestSuite for the evaluation of the antenna models in many directions
+ */
+class AntennaGainsTestSuite : public TestSuite
+{
+  public:
+    AntennaGainsTestSuite();
+};
+
+AntennaGainsTestSuite::AntennaGainsTestSuite()
+    : TestSuite("antenna-gains", UNIT)
+{
+    AddTestCase(new AntennaGainsTestCase("ns3::IsotropicAntennaModel", {{"Gain", 3}}),
+                TestCase::QUICK);
+    AddTestCase(new AntennaGainsTestCase(
+                    "ns3::CosineAntennaModel",
+                    {{"Orientation", 30}, {"VerticalBeamwidth", 90}, {"MaxGain", 8}}),
+                TestCase::QUICK);
+    AddTestCase(new AntennaGainsTestCase("ns3::ParabolicAntennaModel", {{"Orientation", -120}}),
+                TestCase::QUICK);
+    AddTestCase(new AntennaGainsTestCase("ns3::ThreeGppAntennaModel", {}), TestCase::QUICK);
+    AddTestCase(new AntennaGainTableTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static AntennaGainsTestSuite g_antennaGainsTestSuite;
@@ -28,6 +28,12 @@
 #include "ns3/object-vector.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
 namespace ns3
 {
 
@@ -77,6 +83,25 @@ class BuildingListPriv : public Object
      * \returns the container size
      */
     uint32_t GetNBuildings();
+    /**
+     * \param position a position
+     * \returns the buildings containing the position, in the order of their index.
+     */
+    std::vector<Ptr<Building>> GetBuildingsAt(const Vector& position);
+    /**
+     * \param l1 one end of a line segment
+     * \param l2 the other end of the line segment
+     * \returns true if the line segment intersects a building.
+     */
+    bool IsIntersect(const Vector& l1, const Vector& l2);
+    /**
+     * \param l1 one end of a line segment
+     * \param l2 the other end of the line segment
+     * \returns the buildings intersecting the line segment, in the order of their index.
+     */
+    std::vector<Ptr<Building>> GetIntersectingBuildings(const Vector& l1, const Vector& l2);
+    /** Build the grid again on the next query. */
+    void InvalidateGrid();
 
     /**
      * Get the Singleton instance of BuildingListPriv (or create one)
@@ -98,9 +123,51 @@ class BuildingListPriv : public Object
      *
      */
     static void Delete();
+    /** Build the grid, if buildings were added or moved since it was built. */
+    void UpdateGrid();
+    /**
+     * \param x a coordinate
+     * \param n the number of cells along the axis
+     * \param min the minimum coordinate of the grid along the axis
+     * \returns the index of the cell of the coordinate, clamped to the grid.
+     */
+    uint32_t GetCell(double x, uint32_t n, double min) const;
+    /**
+     * Visit the cells crossed by the projection of a line segment on the
+     * plane, until the visitor returns true.
+     *
+     * \param l1 one end of the line segment
+     * \param l2 the other end of the line segment
+     * \param visit the visitor, called with the index of each cell
+     * \returns true if the visitor returned true.
+     */
+    template <typename F>
+    bool VisitCells(const Vector& l1, const Vector& l2, F visit) const;
+
     std::vector<Ptr<Building>> m_buildings; //!< Container of Building
+
+    std::atomic<bool> m_gridValid; //!< Whether the grid is up to date
+    std::mutex m_gridMutex;        //!< Mutex of the update of the grid
+    double m_gridMinX;             //!< The minimum x coordinate of the grid
+    double m_gridMinY;             //!< The minimum y coordinate of the grid
+    double m_cellSize;             //!< The size of the cells
+    uint32_t m_nCellsX;            //!< The number of cells along x
+    uint32_t m_nCellsY;            //!< The number of cells along y
+    /// The start of the buildings of each cell in m_cellBuildings, and the end of the last one
+    std::vector<uint32_t> m_cellStart;
+    /// The indices of the buildings overlapping each cell, in increasing order
+    std::vector<uint32_t> m_cellBuildings;
 };
 
+namespace
+{
+/**
+ * The margin, in meters, by which the footprints of the buildings are
+ * extended in the grid, so that the rounding errors do not miss a cell.
+ */
+const double GRID_MARGIN = 1e-6;
+} // namespace
+
 NS_OBJECT_ENSURE_REGISTERED(BuildingListPriv);
 
 TypeId
@@ -146,6 +213,12 @@ BuildingListPriv::Delete()
 }
 
 BuildingListPriv::BuildingListPriv()
+    : m_gridValid(false),
+      m_gridMinX(0),
+      m_gridMinY(0),
+      m_cellSize(1),
+      m_nCellsX(0),
+      m_nCellsY(0)
 {
     NS_LOG_FUNCTION_NOARGS();
 }
@@ -165,6 +238,7 @@ BuildingListPriv::DoDispose()
         *i = nullptr;
     }
     m_buildings.erase(m_buildings.begin(), m_buildings.end());
+    InvalidateGrid();
     Object::DoDispose();
 }
 
@@ -173,6 +247,7 @@ BuildingListPriv::Add(Ptr<Building> building)
 {
     uint32_t index = m_buildings.size();
     m_buildings.push_back(building);
+    InvalidateGrid();
     Simulator::ScheduleWithContext(index, TimeStep(0), &Building::Initialize, building);
     return index;
 }
@@ -204,6 +279,275 @@ BuildingListPriv::GetBuilding(uint32_t n)
     return m_buildings.at(n);
 }
 
+void
+BuildingListPriv::InvalidateGrid()
+{
+    m_gridValid.store(false, std::memory_order_release);
+}
+
+void
+BuildingListPriv::UpdateGrid()
+{
+    if (m_gridValid.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_gridMutex);
+    if (m_gridValid.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << m_buildings.size());
+
+    m_cellStart.clear();
+    m_cellBuildings.clear();
+    m_nCellsX = 0;
+    m_nCellsY = 0;
+    if (!m_buildings.empty())
+    {
+        double xMin = std::numeric_limits<double>::max();
+        double yMin = std::numeric_limits<double>::max();
+        double xMax = std::numeric_limits<double>::lowest();
+        double yMax = std::numeric_limits<double>::lowest();
+        double area = 0;
+        for (const auto& building : m_buildings)
+        {
+            Box box = building->GetBoundaries();
+            xMin = std::min(xMin, box.xMin);
+            yMin = std::min(yMin, box.yMin);
+            xMax = std::max(xMax, box.xMax);
+            yMax = std::max(yMax, box.yMax);
+            area += (box.xMax - box.xMin) * (box.yMax - box.yMin);
+        }
+        m_gridMinX = xMin - GRID_MARGIN;
+        m_gridMinY = yMin - GRID_MARGIN;
+        double width = xMax - xMin + 2 * GRID_MARGIN;
+        double height = yMax - yMin + 2 * GRID_MARGIN;
+        // cells of about the average footprint of the buildings, so that a
+        // building overlaps a few cells, and a cell holds a few buildings,
+        // with at most about 4 cells per building
+        double cellArea = std::max(area / m_buildings.size(),
+                                   width * height / (4.0 * m_buildings.size()));
+        m_cellSize = std::max(std::sqrt(cellArea), GRID_MARGIN);
+        m_nCellsX = static_cast<uint32_t>(std::ceil(width / m_cellSize));
+        m_nCellsY = static_cast<uint32_t>(std::ceil(height / m_cellSize));
+        m_nCellsX = std::max(m_nCellsX, 1U);
+        m_nCellsY = std::max(m_nCellsY, 1U);
+
+        // count the buildings of each cell, then fill the cells
+        m_cellStart.assign(m_nCellsX * m_nCellsY + 1, 0);
+        for (int pass = 0; pass < 2; pass++)
+        {
+            for (uint32_t i = 0; i < m_buildings.size(); i++)
+            {
+                Box box = m_buildings[i]->GetBoundaries();
+                uint32_t x1 = GetCell(box.xMin - GRID_MARGIN, m_nCellsX, m_gridMinX);
+                uint32_t x2 = GetCell(box.xMax + GRID_MARGIN, m_nCellsX, m_gridMinX);
+                uint32_t y1 = GetCell(box.yMin - GRID_MARGIN, m_nCellsY, m_gridMinY);
+                uint32_t y2 = GetCell(box.yMax + GRID_MARGIN, m_nCellsY, m_gridMinY);
+                for (uint32_t y = y1; y <= y2; y++)
+                {
+                    for (uint32_t x = x1; x <= x2; x++)
+                    {
+                        uint32_t cell = y * m_nCellsX + x;
+                        if (pass == 0)
+                        {
+                            m_cellStart[cell + 1]++;
+                        }
+                        else
+                        {
+                            m_cellBuildings[m_cellStart[cell]++] = i;
+                        }
+                    }
+                }
+            }
+            if (pass == 0)
+            {
+                for (std::size_t cell = 1; cell < m_cellStart.size(); cell++)
+                {
+                    m_cellStart[cell] += m_cellStart[cell - 1];
+                }
+                m_cellBuildings.resize(m_cellStart.back());
+            }
+            else
+            {
+                // the start of each cell was moved to its end
+                std::copy_backward(m_cellStart.begin(),
+                                   m_cellStart.end() - 1,
+                                   m_cellStart.end());
+                m_cellStart[0] = 0;
+            }
+        }
+        NS_LOG_LOGIC("Grid of " << m_nCellsX << "x" << m_nCellsY << " cells of " << m_cellSize
+                                << " m, with " << m_cellBuildings.size() << " entries");
+    }
+    m_gridValid.store(true, std::memory_order_release);
+}
+
+uint32_t
+BuildingListPriv::GetCell(double x, uint32_t n, double min) const
+{
+    double cell = std::floor((x - min) / m_cellSize);
+    if (cell <= 0)
+    {
+        return 0;
+    }
+    return cell >= n - 1 ? n - 1 : static_cast<uint32_t>(cell);
+}
+
+template <typename F>
+bool
+BuildingListPriv::VisitCells(const Vector& l1, const Vector& l2, F visit) const
+{
+    // clip the segment to the grid
+    double dx = l2.x - l1.x;
+    double dy = l2.y - l1.y;
+    double gridMax[2] = {m_gridMinX + m_nCellsX * m_cellSize,
+                         m_gridMinY + m_nCellsY * m_cellSize};
+    double gridMin[2] = {m_gridMinX, m_gridMinY};
+    double origin[2] = {l1.x, l1.y};
+    double delta[2] = {dx, dy};
+    double t0 = 0;
+    double t1 = 1;
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (delta[axis] == 0)
+        {
+            if (origin[axis] < gridMin[axis] || origin[axis] > gridMax[axis])
+            {
+                return false;
+            }
+            continue;
+        }
+        double ta = (gridMin[axis] - origin[axis]) / delta[axis];
+        double tb = (gridMax[axis] - origin[axis]) / delta[axis];
+        t0 = std::max(t0, std::min(ta, tb));
+        t1 = std::min(t1, std::max(ta, tb));
+    }
+    if (t0 > t1)
+    {
+        return false;
+    }
+
+    // walk the cells from the start of the clipped segment to its end
+    uint32_t x = GetCell(l1.x + t0 * dx, m_nCellsX, m_gridMinX);
+    uint32_t y = GetCell(l1.y + t0 * dy, m_nCellsY, m_gridMinY);
+    uint32_t xEnd = GetCell(l1.x + t1 * dx, m_nCellsX, m_gridMinX);
+    uint32_t yEnd = GetCell(l1.y + t1 * dy, m_nCellsY, m_gridMinY);
+    int stepX = dx > 0 ? 1 : (dx < 0 ? -1 : 0);
+    int stepY = dy > 0 ? 1 : (dy < 0 ? -1 : 0);
+    double inf = std::numeric_limits<double>::infinity();
+    // the value of t at the next boundary of a cell along each axis
+    double tNextX =
+        stepX != 0 ? (m_gridMinX + (x + (stepX > 0)) * m_cellSize - l1.x) / dx : inf;
+    double tNextY =
+        stepY != 0 ? (m_gridMinY + (y + (stepY > 0)) * m_cellSize - l1.y) / dy : inf;
+    double tDeltaX = stepX != 0 ? m_cellSize / std::abs(dx) : inf;
+    double tDeltaY = stepY != 0 ? m_cellSize / std::abs(dy) : inf;
+    while (true)
+    {
+        if (visit(y * m_nCellsX + x))
+        {
+            return true;
+        }
+        if ((x == xEnd && y == yEnd) || std::min(tNextX, tNextY) > t1)
+        {
+            return false;
+        }
+        if (tNextX < tNextY)
+        {
+            if ((stepX < 0 && x == 0) || (stepX > 0 && x == m_nCellsX - 1))
+            {
+                return false;
+            }
+            x += stepX;
+            tNextX += tDeltaX;
+        }
+        else
+        {
+            if ((stepY < 0 && y == 0) || (stepY > 0 && y == m_nCellsY - 1))
+            {
+                return false;
+            }
+            y += stepY;
+            tNextY += tDeltaY;
+        }
+    }
+}
+
+std::vector<Ptr<Building>>
+BuildingListPriv::GetBuildingsAt(const Vector& position)
+{
+    UpdateGrid();
+    std::vector<Ptr<Building>> buildings;
+    if (m_cellStart.empty() || position.x < m_gridMinX || position.y < m_gridMinY)
+    {
+        return buildings;
+    }
+    uint32_t x = GetCell(position.x, m_nCellsX, m_gridMinX);
+    uint32_t y = GetCell(position.y, m_nCellsY, m_gridMinY);
+    uint32_t cell = y * m_nCellsX + x;
+    for (uint32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; i++)
+    {
+        const Ptr<Building>& building = m_buildings[m_cellBuildings[i]];
+        if (building->IsInside(position))
+        {
+            buildings.push_back(building);
+        }
+    }
+    return buildings;
+}
+
+bool
+BuildingListPriv::IsIntersect(const Vector& l1, const Vector& l2)
+{
+    UpdateGrid();
+    if (m_cellStart.empty())
+    {
+        return false;
+    }
+    return VisitCells(l1, l2, [this, &l1, &l2](uint32_t cell) {
+        for (uint32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; i++)
+        {
+            if (m_buildings[m_cellBuildings[i]]->IsIntersect(l1, l2))
+            {
+                return true;
+            }
+        }
+        return false;
+    });
+}
+
+std::vector<Ptr<Building>>
+BuildingListPriv::GetIntersectingBuildings(const Vector& l1, const Vector& l2)
+{
+    UpdateGrid();
+    std::vector<uint32_t> indices;
+    if (!m_cellStart.empty())
+    {
+        VisitCells(l1, l2, [this, &l1, &l2, &indices](uint32_t cell) {
+            for (uint32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; i++)
+            {
+                uint32_t index = m_cellBuildings[i];
+                if (std::find(indices.begin(), indices.end(), index) == indices.end() &&
+                    m_buildings[index]->IsIntersect(l1, l2))
+                {
+                    indices.push_back(index);
+                }
+            }
+            return false;
+        });
+    }
+    std::sort(indices.begin(), indices.end());
+    std::vector<Ptr<Building>> buildings;
+    buildings.reserve(indices.size());
+    for (auto index : indices)
+    {
+        buildings.push_back(m_buildings[index]);
+    }
+    return buildings;
+}
+
 } // namespace ns3
 
 /**
@@ -244,4 +588,28 @@ BuildingList::GetNBuildings()
     return BuildingListPriv::Get()->GetNBuildings();
 }
 
+std::vector<Ptr<Building>>
+BuildingList::GetBuildingsAt(const Vector& position)
+{
+    return BuildingListPriv::Get()->GetBuildingsAt(position);
+}
+
+bool
+BuildingList::IsIntersect(const Vector& l1, const Vector& l2)
+{
+    return BuildingListPriv::Get()->IsIntersect(l1, l2);
+}
+
+std::vector<Ptr<Building>>
+BuildingList::GetIntersectingBuildings(const Vector& l1, const Vector& l2)
+{
+    return BuildingListPriv::Get()->GetIntersectingBuildings(l1, l2);
+}
+
+void
+BuildingList::NotifyBoundariesChanged()
+{
+    BuildingListPriv::Get()->InvalidateGrid();
+}
+
 } // namespace ns3
@@ -23,6 +23,7 @@
 #define BUILDING_LIST_H_
 
 #include "ns3/ptr.h"
+#include "ns3/vector.h"
 
 #include <vector>
 
@@ -33,6 +34,12 @@ class Building;
 
 /**
  * Container for Building class
+ *
+ * The list also indexes the footprints of the buildings in a uniform grid
+ * of the plane, to find the buildings containing a position, or
+ * intersecting a line segment, by checking only the buildings of the cells
+ * which the position or the segment cross. The grid is built on the first
+ * query after buildings were added or moved.
  */
 class BuildingList
 {
@@ -67,6 +74,31 @@ class BuildingList
      * \returns the number of buildings currently in the list.
      */
     static uint32_t GetNBuildings();
+    /**
+     * \param position a position
+     * \returns the buildings containing the position, in the order of their index.
+     */
+    static std::vector<Ptr<Building>> GetBuildingsAt(const Vector& position);
+    /**
+     * \param l1 one end of a line segment
+     * \param l2 the other end of the line segment
+     * \returns true if the line segment intersects a building.
+     */
+    static bool IsIntersect(const Vector& l1, const Vector& l2);
+    /**
+     * \param l1 one end of a line segment
+     * \param l2 the other end of the line segment
+     * \returns the buildings intersecting the line segment, in the order of their index.
+     */
+    static std::vector<Ptr<Building>> GetIntersectingBuildings(const Vector& l1, const Vector& l2);
+    /**
+     * Notify the list that the boundaries of a building changed, so that
+     * the grid is built again.
+     *
+     * This method is called automatically from Building::SetBoundaries so
+     * the user has little reason to call it himself.
+     */
+    static void NotifyBoundariesChanged();
 };
 
 } // namespace ns3
@@ -0,0 +1,591 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "radio-map-propagation-loss-model.h"
+
+#include "building-list.h"
+#include "building.h"
+#include "buildings-propagation-loss-model.h"
+#include "mobility-building-info.h"
+
+#include <ns3/abort.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/double.h>
+#include <ns3/log.h>
+#include <ns3/multithreaded-simulator-impl.h>
+#include <ns3/node.h>
+#include <ns3/object-ptr-container.h>
+#include <ns3/pointer.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/uinteger.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+#ifndef __WIN32__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("RadioMapPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED(RadioMapPropagationLossModel);
+
+namespace
+{
+
+/**
+ * The tolerance on the height of the nodes whose links are looked up in the
+ * radio maps, in meters.
+ */
+const double HEIGHT_TOLERANCE = 1e-3;
+
+/**
+ * A FNV-1a hash of the inputs of a radio map.
+ */
+class MapKeyHash
+{
+  public:
+    /**
+     * Add bytes to the hash.
+     *
+     * \param [in] data The bytes.
+     * \param [in] size The number of bytes.
+     */
+    void Add(const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (std::size_t i = 0; i < size; i++)
+        {
+            m_hash ^= bytes[i];
+            m_hash *= 1099511628211ULL;
+        }
+    }
+
+    /**
+     * Add a value to the hash.
+     *
+     * \param [in] value The value.
+     */
+    void Add(double value)
+    {
+        Add(&value, sizeof(value));
+    }
+
+    /**
+     * Add a string to the hash.
+     *
+     * \param [in] value The string.
+     */
+    void Add(const std::string& value)
+    {
+        uint64_t size = value.size();
+        Add(&size, sizeof(size));
+        Add(value.data(), value.size());
+    }
+
+    /**
+     * Add the type of an object, and the values of its attributes, to the
+     * hash, following the attributes pointing to other objects.
+     *
+     * \param [in] object The object.
+     * \param [in] depth The depth of the object.
+     */
+    void AddObject(Ptr<Object> object, uint32_t depth = 0)
+    {
+        TypeId tid = object->GetInstanceTypeId();
+        Add(tid.GetName());
+        if (depth > 4)
+        {
+            return;
+        }
+        bool isRandomVariable = tid.IsChildOf(RandomVariableStream::GetTypeId());
+        while (true)
+        {
+            for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
+            {
+                TypeId::AttributeInformation info = tid.GetAttribute(i);
+                // the stream of a random variable does not change the
+                // distribution of its values
+                if (!(info.flags & TypeId::ATTR_GET) || !info.accessor->HasGetter() ||
+                    (isRandomVariable && info.name == "Stream"))
+                {
+                    continue;
+                }
+                Ptr<AttributeValue> value = info.initialValue->Copy();
+                if (!object->GetAttributeFailSafe(info.name, *value))
+                {
+                    continue;
+                }
+                Add(info.name);
+                if (auto pointer = DynamicCast<PointerValue>(value))
+                {
+                    Ptr<Object> pointee = pointer->GetObject();
+                    if (pointee)
+                    {
+                        AddObject(pointee, depth + 1);
+                    }
+                }
+                else if (auto number = DynamicCast<DoubleValue>(value))
+                {
+                    Add(number->Get());
+                }
+                else if (!DynamicCast<ObjectPtrContainerValue>(value))
+                {
+                    Add(value->SerializeToString(info.checker));
+                }
+            }
+            TypeId parent = tid.GetParent();
+            if (parent == tid)
+            {
+                break;
+            }
+            tid = parent;
+        }
+    }
+
+    /** \returns The hash. */
+    uint64_t Get() const
+    {
+        return m_hash;
+    }
+
+  private:
+    uint64_t m_hash{14695981039346656037ULL}; //!< The hash.
+};
+
+} // unnamed namespace
+
+TypeId
+RadioMapPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::RadioMapPropagationLossModel")
+            .SetParent<PropagationLossModel>()
+            .SetGroupName("Buildings")
+            .AddConstructor<RadioMapPropagationLossModel>()
+            .AddAttribute("Model",
+                          "The deterministic propagation loss model computing the radio maps, "
+                          "and the links which are not in the maps.",
+                          PointerValue(),
+                          MakePointerAccessor(&RadioMapPropagationLossModel::m_model),
+                          MakePointerChecker<PropagationLossModel>())
+            .AddAttribute("Bounds",
+                          "The area covered by the radio maps.",
+                          RectangleValue(Rectangle(0, 1000, 0, 1000)),
+                          MakeRectangleAccessor(&RadioMapPropagationLossModel::m_bounds),
+                          MakeRectangleChecker())
+            .AddAttribute("Resolution",
+                          "The distance between the points of the radio maps, in meters.",
+                          DoubleValue(5.0),
+                          MakeDoubleAccessor(&RadioMapPropagationLossModel::m_resolution),
+                          MakeDoubleChecker<double>(0.0, std::numeric_limits<double>::max()))
+            .AddAttribute("Height",
+                          "The height of the radio maps, in meters. The links between the "
+                          "sites and the nodes at this height, within the bounds, are looked "
+                          "up in the maps.",
+                          DoubleValue(1.5),
+                          MakeDoubleAccessor(&RadioMapPropagationLossModel::m_height),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("Directory",
+                          "The directory where the radio maps are saved, and loaded from by "
+                          "the next runs. If empty, the maps are not saved.",
+                          StringValue(""),
+                          MakeStringAccessor(&RadioMapPropagationLossModel::m_directory),
+                          MakeStringChecker())
+            .AddAttribute("Processes",
+                          "The number of processes computing a radio map. If 0, the number "
+                          "of hardware threads.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&RadioMapPropagationLossModel::m_processes),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("ShadowingStd",
+                          "The standard deviation of the shadowing of the links looked up in "
+                          "the radio maps, in dB.",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&RadioMapPropagationLossModel::m_shadowingStd),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("ShadowingDecorrelation",
+                          "The decorrelation distance of the shadowing, in meters.",
+                          DoubleValue(50.0),
+                          MakeDoubleAccessor(&RadioMapPropagationLossModel::m_shadowingDistance),
+                          MakeDoubleChecker<double>(0.0, std::numeric_limits<double>::max()));
+    return tid;
+}
+
+RadioMapPropagationLossModel::RadioMapPropagationLossModel()
+    : m_precomputing(false)
+{
+    NS_LOG_FUNCTION(this);
+    m_normal = CreateObject<NormalRandomVariable>();
+    m_normal->SetAttribute("Mean", DoubleValue(0.0));
+    m_normal->SetAttribute("Variance", DoubleValue(1.0));
+}
+
+RadioMapPropagationLossModel::~RadioMapPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+RadioMapPropagationLossModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_model = nullptr;
+    m_normal = nullptr;
+    m_sites.clear();
+    m_siteIndex.clear();
+    PropagationLossModel::DoDispose();
+}
+
+void
+RadioMapPropagationLossModel::AddSite(Ptr<MobilityModel> site)
+{
+    NS_LOG_FUNCTION(this << site);
+    NS_ASSERT(site);
+    if (m_siteIndex.find(PeekPointer(site)) != m_siteIndex.end())
+    {
+        return;
+    }
+    m_siteIndex[PeekPointer(site)] = m_sites.size();
+    Site entry;
+    entry.mobility = site;
+    entry.position = site->GetPosition();
+    m_sites.push_back(entry);
+}
+
+void
+RadioMapPropagationLossModel::PrecomputeMaps()
+{
+    NS_LOG_FUNCTION(this);
+    m_precomputing = true;
+    for (auto& site : m_sites)
+    {
+        GetMap(site, true);
+        GetMap(site, false);
+    }
+    m_precomputing = false;
+}
+
+RadioMapPropagationLossModel::Site*
+RadioMapPropagationLossModel::FindSite(Ptr<MobilityModel> site) const
+{
+    auto it = m_siteIndex.find(PeekPointer(site));
+    if (it == m_siteIndex.end())
+    {
+        return nullptr;
+    }
+    return &m_sites[it->second];
+}
+
+Ptr<const RadioMap>
+RadioMapPropagationLossModel::GetRadioMap(Ptr<MobilityModel> site, bool fromSite) const
+{
+    NS_LOG_FUNCTION(this << site << fromSite);
+    Site* entry = FindSite(site);
+    NS_ABORT_MSG_UNLESS(entry, "The mobility model is not a site of the radio maps");
+    return GetMap(*entry, fromSite);
+}
+
+double
+RadioMapPropagationLossModel::GetShadowing(Ptr<MobilityModel> site, const Vector& position) const
+{
+    NS_LOG_FUNCTION(this << site << position);
+    Site* entry = FindSite(site);
+    NS_ABORT_MSG_UNLESS(entry, "The mobility model is not a site of the radio maps");
+    return DoGetShadowing(*entry, position);
+}
+
+bool
+RadioMapPropagationLossModel::IsOnMaps(const Vector& position) const
+{
+    return std::abs(position.z - m_height) <= HEIGHT_TOLERANCE && m_bounds.IsInside(position);
+}
+
+double
+RadioMapPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                            Ptr<MobilityModel> a,
+                                            Ptr<MobilityModel> b) const
+{
+    NS_ABORT_MSG_UNLESS(m_model, "No propagation loss model set for the radio maps");
+    Site* site = FindSite(a);
+    if (site)
+    {
+        Vector position = b->GetPosition();
+        if (IsOnMaps(position))
+        {
+            Ptr<RadioMap> map = GetMap(*site, true);
+            return txPowerDbm + map->GetGain(position.x, position.y) -
+                   DoGetShadowing(*site, position);
+        }
+    }
+    site = FindSite(b);
+    if (site)
+    {
+        Vector position = a->GetPosition();
+        if (IsOnMaps(position))
+        {
+            Ptr<RadioMap> map = GetMap(*site, false);
+            return txPowerDbm + map->GetGain(position.x, position.y) -
+                   DoGetShadowing(*site, position);
+        }
+    }
+    return m_model->CalcRxPower(txPowerDbm, a, b);
+}
+
+Ptr<RadioMap>
+RadioMapPropagationLossModel::GetMap(Site& site, bool fromSite) const
+{
+    Vector position = site.mobility->GetPosition();
+    if (position.x != site.position.x || position.y != site.position.y ||
+        position.z != site.position.z)
+    {
+        NS_LOG_INFO("The site " << site.mobility << " moved to " << position);
+        site.position = position;
+        site.maps[0] = nullptr;
+        site.maps[1] = nullptr;
+    }
+    Ptr<RadioMap>& map = site.maps[fromSite ? 1 : 0];
+    if (map)
+    {
+        return map;
+    }
+
+    uint64_t key = GetMapKey(site, fromSite);
+    std::string fileName;
+    if (!m_directory.empty())
+    {
+        std::ostringstream oss;
+        oss << m_directory << "/radio-map-" << std::hex << std::setw(16) << std::setfill('0')
+            << key << ".map";
+        fileName = oss.str();
+        map = RadioMap::Load(fileName, key);
+        if (map)
+        {
+            return map;
+        }
+    }
+
+    NS_ABORT_MSG_UNLESS(m_resolution > 0, "The resolution of the radio maps must be positive");
+    auto nX = static_cast<uint32_t>(std::ceil((m_bounds.xMax - m_bounds.xMin) / m_resolution));
+    auto nY = static_cast<uint32_t>(std::ceil((m_bounds.yMax - m_bounds.yMin) / m_resolution));
+    map = RadioMap::Create(m_bounds.xMin,
+                           m_bounds.yMin,
+                           m_resolution,
+                           nX + 1,
+                           nY + 1,
+                           m_height,
+                           key);
+    ComputeMap(map, site.mobility, fromSite);
+    if (!fileName.empty() && !map->Save(fileName))
+    {
+        NS_LOG_WARN("Can't save the radio map " << fileName);
+    }
+    return map;
+}
+
+uint64_t
+RadioMapPropagationLossModel::GetMapKey(const Site& site, bool fromSite) const
+{
+    MapKeyHash hash;
+    Ptr<PropagationLossModel> model = m_model;
+    while (model)
+    {
+        hash.AddObject(model);
+        model = model->GetNext();
+    }
+    hash.Add(site.position.x);
+    hash.Add(site.position.y);
+    hash.Add(site.position.z);
+    hash.Add(fromSite ? 1.0 : 0.0);
+    hash.Add(m_bounds.xMin);
+    hash.Add(m_bounds.xMax);
+    hash.Add(m_bounds.yMin);
+    hash.Add(m_bounds.yMax);
+    hash.Add(m_resolution);
+    hash.Add(m_height);
+    for (auto it = BuildingList::Begin(); it != BuildingList::End(); ++it)
+    {
+        Box boundaries = (*it)->GetBoundaries();
+        hash.Add(boundaries.xMin);
+        hash.Add(boundaries.xMax);
+        hash.Add(boundaries.yMin);
+        hash.Add(boundaries.yMax);
+        hash.Add(boundaries.zMin);
+        hash.Add(boundaries.zMax);
+        hash.AddObject(*it);
+    }
+    return hash.Get();
+}
+
+void
+RadioMapPropagationLossModel::ComputeMap(Ptr<RadioMap> map,
+                                         Ptr<MobilityModel> site,
+                                         bool fromSite) const
+{
+    NS_LOG_FUNCTION(this << map << site << fromSite);
+    uint32_t processes = m_processes;
+    if (processes == 0)
+    {
+        processes = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    processes = std::min(processes, map->GetNY());
+    NS_LOG_INFO("Computing a radio map of " << map->GetNX() << "x" << map->GetNY()
+                                            << " points with " << processes << " processes");
+#ifdef __WIN32__
+    ComputeRows(map, site, fromSite, 0, 1);
+#else
+    // the worker threads of the partitions are running, and their locks would
+    // never be released in the child processes
+    NS_ABORT_MSG_IF(!m_precomputing &&
+                        DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation()),
+                    "The radio maps can't be computed during a multithreaded simulation: "
+                    "call PrecomputeMaps() before Simulator::Run()");
+    // the rows are computed in child processes, even by a single one, so
+    // that the probe node and the state of the wrapped model do not leak into
+    // the simulation
+    std::vector<pid_t> children;
+    for (uint32_t k = 0; k < processes; k++)
+    {
+        std::fflush(nullptr);
+        pid_t pid = fork();
+        NS_ABORT_MSG_IF(pid < 0, "fork() failed");
+        if (pid == 0)
+        {
+            ComputeRows(map, site, fromSite, k, processes);
+            std::fflush(nullptr);
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+    for (pid_t pid : children)
+    {
+        int status;
+        NS_ABORT_MSG_IF(waitpid(pid, &status, 0) < 0, "waitpid() failed");
+        NS_ABORT_MSG_UNLESS(WIFEXITED(status) && WEXITSTATUS(status) == 0,
+                            "The computation of a radio map failed");
+    }
+#endif
+}
+
+void
+RadioMapPropagationLossModel::ComputeRows(Ptr<RadioMap> map,
+                                          Ptr<MobilityModel> site,
+                                          bool fromSite,
+                                          uint32_t first,
+                                          uint32_t step) const
+{
+    NS_LOG_FUNCTION(this << map << site << fromSite << first << step);
+    // the probe is a node, as some models identify the links by the nodes
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<MobilityModel> probe = CreateObject<ConstantPositionMobilityModel>();
+    Ptr<MobilityBuildingInfo> info = CreateObject<MobilityBuildingInfo>();
+    node->AggregateObject(probe);
+    probe->AggregateObject(info);
+    Ptr<BuildingsPropagationLossModel> buildingsModel =
+        DynamicCast<BuildingsPropagationLossModel>(m_model);
+
+    for (uint32_t j = first; j < map->GetNY(); j += step)
+    {
+        float* row = map->GetRow(j);
+        for (uint32_t i = 0; i < map->GetNX(); i++)
+        {
+            probe->SetPosition(Vector(map->GetXMin() + i * map->GetResolution(),
+                                      map->GetYMin() + j * map->GetResolution(),
+                                      map->GetHeight()));
+            info->MakeConsistent(probe);
+            Ptr<MobilityModel> a = fromSite ? site : probe;
+            Ptr<MobilityModel> b = fromSite ? probe : site;
+            double gain;
+            if (buildingsModel)
+            {
+                // without the random shadowing of the model
+                gain = -buildingsModel->GetLoss(a, b);
+                Ptr<PropagationLossModel> next = buildingsModel->GetNext();
+                if (next)
+                {
+                    gain = next->CalcRxPower(gain, a, b);
+                }
+            }
+            else
+            {
+                gain = m_model->CalcRxPower(0.0, a, b);
+            }
+            row[i] = static_cast<float>(gain);
+        }
+    }
+}
+
+double
+RadioMapPropagationLossModel::DoGetShadowing(Site& site, const Vector& position) const
+{
+    if (m_shadowingStd <= 0)
+    {
+        return 0;
+    }
+    // the field is drawn at the points of a grid of the decorrelation
+    // distance, one point beyond the bounds
+    double u = (position.x - m_bounds.xMin) / m_shadowingDistance;
+    double v = (position.y - m_bounds.yMin) / m_shadowingDistance;
+    auto nX =
+        static_cast<uint32_t>(std::ceil((m_bounds.xMax - m_bounds.xMin) / m_shadowingDistance)) +
+        2;
+    auto nY =
+        static_cast<uint32_t>(std::ceil((m_bounds.yMax - m_bounds.yMin) / m_shadowingDistance)) +
+        2;
+    if (site.shadowing.empty())
+    {
+        site.shadowing.resize(static_cast<std::size_t>(nX) * nY);
+        for (auto& value : site.shadowing)
+        {
+            value = m_normal->GetValue();
+        }
+    }
+    uint32_t i = std::min(static_cast<uint32_t>(std::max(u, 0.0)), nX - 2);
+    uint32_t j = std::min(static_cast<uint32_t>(std::max(v, 0.0)), nY - 2);
+    double fu = std::clamp(u - i, 0.0, 1.0);
+    double fv = std::clamp(v - j, 0.0, 1.0);
+    const double* row = site.shadowing.data() + static_cast<std::size_t>(j) * nX + i;
+    const double* next = row + nX;
+    double w[4] = {(1 - fu) * (1 - fv), fu * (1 - fv), (1 - fu) * fv, fu * fv};
+    double value = w[0] * row[0] + w[1] * row[1] + w[2] * next[0] + w[3] * next[1];
+    // the interpolation of independent values has a lower variance
+    double norm = std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2] + w[3] * w[3]);
+    return m_shadowingStd * value / norm;
+}
+
+int64_t
+RadioMapPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_normal->SetStream(stream);
+    int64_t streams = 1;
+    if (m_model)
+    {
+        streams += m_model->AssignStreams(stream + 1);
+    }
+    return streams;
+}
+
+} // namespace ns3
@@ -0,0 +1,214 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RADIO_MAP_PROPAGATION_LOSS_MODEL_H
+#define RADIO_MAP_PROPAGATION_LOSS_MODEL_H
+
+#include "radio-map.h"
+
+#include <ns3/propagation-loss-model.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/rectangle.h>
+#include <ns3/vector.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class MobilityModel;
+
+/**
+ * \ingroup buildings
+ *
+ * \brief A propagation loss model looking up the loss of the links of
+ * static sites in precomputed radio maps.
+ *
+ * This model wraps a deterministic propagation loss model, set by the
+ * \c Model attribute, and computes the gain of this model between each
+ * site added by AddSite(), such as the eNBs, and the points of a grid
+ * covering the \c Bounds of the scenario, at the \c Height of the grid, with
+ * a distance of \c Resolution between the points. The gain of a link
+ * between a site and a node at the height of the grid, within the bounds,
+ * is then interpolated bilinearly between the points of the grid, instead
+ * of being computed by the wrapped model. The other links are computed by
+ * the wrapped model.
+ *
+ * There are two maps per site, one for the links from the site, and one for
+ * the links to the site, computed on the first link of the site, and again
+ * if the site moved. The maps are computed by \c Processes child processes
+ * forked from the simulation program, each computing some of the rows of
+ * the grid, with a copy of the wrapped model. If \c Directory is set, the
+ * maps are saved to this directory, and loaded from it by the next runs of
+ * the scenario, mapped in memory. The files are named after a hash of the
+ * wrapped model, its attributes, the site position, the grid and the
+ * buildings, so that they are computed again when one of them changes.
+ *
+ * A forked child process only runs the thread which forked it, so that a
+ * lock held by another thread of the simulation program, e.g. the thread of
+ * a BinaryTraceWriter, is never released in the child. When the program runs
+ * other threads, the maps must be computed by PrecomputeMaps() before these
+ * threads start, typically before Simulator::Run(), or loaded from the
+ * \c Directory. Computing a map during a run of the
+ * MultithreadedSimulatorImpl is a fatal error.
+ *
+ * The wrapped model must only depend on the position of the nodes, and on
+ * their MobilityBuildingInfo: its random shadowing must be disabled. When
+ * it is a BuildingsPropagationLossModel, the maps hold the loss returned by
+ * BuildingsPropagationLossModel::GetLoss(), without its shadowing. The
+ * ThreeGppPropagationLossModel family must be used with its \c ShadowingEnabled
+ * attribute set to false, and with a deterministic channel condition model, such
+ * as the BuildingsChannelConditionModel.
+ *
+ * The shadowing is instead added by this model, as a Gaussian random field
+ * of standard deviation \c ShadowingStd per site, which is correlated over
+ * about \c ShadowingDecorrelation meters: the field is drawn at the points
+ * of a coarser grid, of this spacing, and interpolated bilinearly between
+ * them, normalized to keep its variance. The field is drawn again in each
+ * run, from the stream of this model, and applies to the links looked up
+ * in the maps only.
+ */
+class RadioMapPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+    RadioMapPropagationLossModel();
+    ~RadioMapPropagationLossModel() override;
+
+    /**
+     * Add a static site, whose links are looked up in the radio maps.
+     *
+     * \param site The mobility model of the site.
+     */
+    void AddSite(Ptr<MobilityModel> site);
+    /**
+     * Compute, or load, the radio maps of all the sites now, instead of on
+     * the first link of each site. To be called after the sites are added,
+     * before the simulation program starts other threads, e.g. before
+     * Simulator::Run().
+     */
+    void PrecomputeMaps();
+    /**
+     * Get the radio map of a site, computing it if needed.
+     *
+     * \param site The mobility model of a site.
+     * \param fromSite true for the map of the links from the site, false
+     *                 for the map of the links to the site.
+     * \returns The radio map, without the shadowing.
+     */
+    Ptr<const RadioMap> GetRadioMap(Ptr<MobilityModel> site, bool fromSite) const;
+    /**
+     * \param site The mobility model of a site.
+     * \param position A position within the bounds of the radio maps.
+     * \returns The shadowing between the site and the position, in dB.
+     */
+    double GetShadowing(Ptr<MobilityModel> site, const Vector& position) const;
+
+  private:
+    /** A site, and its radio maps. */
+    struct Site
+    {
+        Ptr<MobilityModel> mobility;   //!< The mobility model of the site.
+        Vector position;               //!< The position of the site in its radio maps.
+        Ptr<RadioMap> maps[2];         //!< The maps of the links to and from the site.
+        std::vector<double> shadowing; //!< The shadowing field, on the coarse grid.
+    };
+
+    void DoDispose() override;
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    /**
+     * \param site The mobility model of a site.
+     * \returns The site, or \c nullptr if it is not a site.
+     */
+    Site* FindSite(Ptr<MobilityModel> site) const;
+    /**
+     * Get the radio map of a site, computing or loading it if needed.
+     *
+     * \param site The site.
+     * \param fromSite Whether the map is for the links from the site.
+     * \returns The map.
+     */
+    Ptr<RadioMap> GetMap(Site& site, bool fromSite) const;
+    /**
+     * \param site The site.
+     * \param fromSite Whether the map is for the links from the site.
+     * \returns The key of the map.
+     */
+    uint64_t GetMapKey(const Site& site, bool fromSite) const;
+    /**
+     * Compute the gains of a radio map, in child processes.
+     *
+     * \param map The map.
+     * \param site The mobility model of the site.
+     * \param fromSite Whether the map is for the links from the site.
+     */
+    void ComputeMap(Ptr<RadioMap> map, Ptr<MobilityModel> site, bool fromSite) const;
+    /**
+     * Compute some rows of a radio map.
+     *
+     * \param map The map.
+     * \param site The mobility model of the site.
+     * \param fromSite Whether the map is for the links from the site.
+     * \param first The first row.
+     * \param step The distance between the rows.
+     */
+    void ComputeRows(Ptr<RadioMap> map,
+                     Ptr<MobilityModel> site,
+                     bool fromSite,
+                     uint32_t first,
+                     uint32_t step) const;
+    /**
+     * \param site The site.
+     * \param position A position within the bounds of the radio maps.
+     * \returns The shadowing between the site and the position, in dB,
+     *          drawing the shadowing field of the site if needed.
+     */
+    double DoGetShadowing(Site& site, const Vector& position) const;
+    /**
+     * \param position A position.
+     * \returns true if the links between the sites and the position are
+     *          looked up in the radio maps.
+     */
+    bool IsOnMaps(const Vector& position) const;
+
+    Ptr<PropagationLossModel> m_model;  //!< The wrapped propagation loss model.
+    Rectangle m_bounds;                 //!< The area covered by the maps.
+    double m_resolution;                //!< The distance between the points of the maps.
+    double m_height;                    //!< The height of the maps.
+    std::string m_directory;            //!< The directory of the map files.
+    uint32_t m_processes;               //!< The number of processes computing a map.
+    bool m_precomputing;                //!< Whether PrecomputeMaps() is computing the maps.
+    double m_shadowingStd;              //!< The standard deviation of the shadowing.
+    double m_shadowingDistance;         //!< The decorrelation distance of the shadowing.
+    Ptr<NormalRandomVariable> m_normal; //!< The random variable of the shadowing.
+
+    mutable std::vector<Site> m_sites; //!< The sites.
+    /// The index of the sites in m_sites, by mobility model.
+    std::map<const MobilityModel*, std::size_t> m_siteIndex;
+};
+
+} // namespace ns3
+
+#endif /* RADIO_MAP_PROPAGATION_LOSS_MODEL_H */
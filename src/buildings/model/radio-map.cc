@@ -0,0 +1,292 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "radio-map.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#ifndef __WIN32__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("RadioMap");
+
+namespace
+{
+
+/** The header of the radio map files. */
+struct RadioMapHeader
+{
+    char magic[8];      //!< "NS3RMAP".
+    uint32_t version;   //!< The version of the format.
+    uint32_t byteOrder; //!< 0x01020304, in the byte order of the gains.
+    uint32_t nX;        //!< The number of points along the x axis.
+    uint32_t nY;        //!< The number of points along the y axis.
+    uint64_t key;       //!< The key of the map.
+    double xMin;        //!< The x coordinate of the first point.
+    double yMin;        //!< The y coordinate of the first point.
+    double resolution;  //!< The distance between the points.
+    double height;      //!< The height of the grid.
+};
+
+static_assert(sizeof(RadioMapHeader) == 64, "The header must be 64 bytes");
+
+/** The magic of the radio map files. */
+const char RADIO_MAP_MAGIC[8] = "NS3RMAP";
+/** The version of the format of the radio map files. */
+const uint32_t RADIO_MAP_VERSION = 1;
+/** The byte order mark of the radio map files. */
+const uint32_t RADIO_MAP_BYTE_ORDER = 0x01020304;
+
+} // unnamed namespace
+
+RadioMap::RadioMap()
+    : m_xMin(0),
+      m_yMin(0),
+      m_resolution(1),
+      m_nX(0),
+      m_nY(0),
+      m_height(0),
+      m_key(0),
+      m_gains(nullptr),
+      m_mapping(nullptr),
+      m_mappingSize(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+RadioMap::~RadioMap()
+{
+    NS_LOG_FUNCTION(this);
+#ifdef __WIN32__
+    std::free(m_mapping);
+#else
+    if (m_mapping)
+    {
+        munmap(m_mapping, m_mappingSize);
+    }
+#endif
+}
+
+Ptr<RadioMap>
+RadioMap::Create(double xMin,
+                 double yMin,
+                 double resolution,
+                 uint32_t nX,
+                 uint32_t nY,
+                 double height,
+                 uint64_t key)
+{
+    NS_LOG_FUNCTION(xMin << yMin << resolution << nX << nY << height << key);
+    NS_ASSERT_MSG(nX >= 2 && nY >= 2, "A radio map needs at least 2x2 points");
+    Ptr<RadioMap> map = Ptr<RadioMap>(new RadioMap(), false);
+    map->m_xMin = xMin;
+    map->m_yMin = yMin;
+    map->m_resolution = resolution;
+    map->m_nX = nX;
+    map->m_nY = nY;
+    map->m_height = height;
+    map->m_key = key;
+    map->m_mappingSize = static_cast<std::size_t>(nX) * nY * sizeof(float);
+#ifdef __WIN32__
+    map->m_mapping = std::calloc(map->m_mappingSize, 1);
+    NS_ABORT_MSG_UNLESS(map->m_mapping, "Can't allocate the radio map");
+#else
+    // shared with the child processes computing the rows
+    map->m_mapping = mmap(nullptr,
+                          map->m_mappingSize,
+                          PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_ANONYMOUS,
+                          -1,
+                          0);
+    NS_ABORT_MSG_IF(map->m_mapping == MAP_FAILED, "Can't allocate the radio map");
+#endif
+    map->m_gains = static_cast<float*>(map->m_mapping);
+    return map;
+}
+
+Ptr<RadioMap>
+RadioMap::Load(const std::string& fileName, uint64_t key)
+{
+    NS_LOG_FUNCTION(fileName << key);
+    RadioMapHeader header;
+    {
+        std::ifstream file(fileName, std::ios::binary);
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        {
+            return nullptr;
+        }
+    }
+    if (std::memcmp(header.magic, RADIO_MAP_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != RADIO_MAP_VERSION || header.byteOrder != RADIO_MAP_BYTE_ORDER ||
+        header.key != key || header.nX < 2 || header.nY < 2)
+    {
+        NS_LOG_WARN("The radio map " << fileName << " does not match, and is computed again");
+        return nullptr;
+    }
+    std::size_t size = static_cast<std::size_t>(header.nX) * header.nY * sizeof(float);
+
+    Ptr<RadioMap> map = Ptr<RadioMap>(new RadioMap(), false);
+    map->m_xMin = header.xMin;
+    map->m_yMin = header.yMin;
+    map->m_resolution = header.resolution;
+    map->m_nX = header.nX;
+    map->m_nY = header.nY;
+    map->m_height = header.height;
+    map->m_key = header.key;
+#ifdef __WIN32__
+    std::ifstream file(fileName, std::ios::binary);
+    file.seekg(sizeof(header));
+    map->m_mapping = std::malloc(size);
+    NS_ABORT_MSG_UNLESS(map->m_mapping, "Can't allocate the radio map");
+    if (!file.read(static_cast<char*>(map->m_mapping), size))
+    {
+        return nullptr;
+    }
+    map->m_mappingSize = size;
+    map->m_gains = static_cast<float*>(map->m_mapping);
+#else
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(header) + size)
+    {
+        NS_LOG_WARN("The radio map " << fileName << " is truncated");
+        close(fd);
+        return nullptr;
+    }
+    void* mapping = mmap(nullptr, sizeof(header) + size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        NS_LOG_WARN("Can't map the radio map " << fileName);
+        return nullptr;
+    }
+    map->m_mapping = mapping;
+    map->m_mappingSize = sizeof(header) + size;
+    map->m_gains = reinterpret_cast<float*>(static_cast<uint8_t*>(mapping) + sizeof(header));
+#endif
+    NS_LOG_INFO("Loaded the radio map " << fileName << " of " << map->m_nX << "x" << map->m_nY
+                                        << " points");
+    return map;
+}
+
+bool
+RadioMap::Save(const std::string& fileName) const
+{
+    NS_LOG_FUNCTION(this << fileName);
+    RadioMapHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, RADIO_MAP_MAGIC, sizeof(header.magic));
+    header.version = RADIO_MAP_VERSION;
+    header.byteOrder = RADIO_MAP_BYTE_ORDER;
+    header.nX = m_nX;
+    header.nY = m_nY;
+    header.key = m_key;
+    header.xMin = m_xMin;
+    header.yMin = m_yMin;
+    header.resolution = m_resolution;
+    header.height = m_height;
+
+    // written to a temporary file first, so that the concurrent simulations
+    // loading the map never see a partial file
+#ifdef __WIN32__
+    std::string tmpFileName = fileName + ".tmp";
+#else
+    std::string tmpFileName = fileName + ".tmp" + std::to_string(getpid());
+#endif
+    std::ofstream file(tmpFileName, std::ios::binary | std::ios::trunc);
+    if (!file.good())
+    {
+        NS_LOG_ERROR("Can't open file " << tmpFileName);
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(m_gains),
+               static_cast<std::size_t>(m_nX) * m_nY * sizeof(float));
+    file.close();
+    if (!file.good() || std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+    {
+        NS_LOG_ERROR("Can't write file " << fileName);
+        std::remove(tmpFileName.c_str());
+        return false;
+    }
+    return true;
+}
+
+double
+RadioMap::GetXMin() const
+{
+    return m_xMin;
+}
+
+double
+RadioMap::GetYMin() const
+{
+    return m_yMin;
+}
+
+double
+RadioMap::GetResolution() const
+{
+    return m_resolution;
+}
+
+uint32_t
+RadioMap::GetNX() const
+{
+    return m_nX;
+}
+
+uint32_t
+RadioMap::GetNY() const
+{
+    return m_nY;
+}
+
+double
+RadioMap::GetHeight() const
+{
+    return m_height;
+}
+
+uint64_t
+RadioMap::GetKey() const
+{
+    return m_key;
+}
+
+float*
+RadioMap::GetRow(uint32_t j)
+{
+    NS_ASSERT(j < m_nY);
+    return m_gains + static_cast<std::size_t>(j) * m_nX;
+}
+
+} // namespace ns3
@@ -0,0 +1,162 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RADIO_MAP_H
+#define RADIO_MAP_H
+
+#include <ns3/assert.h>
+#include <ns3/ptr.h>
+#include <ns3/simple-ref-count.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \ingroup buildings
+ *
+ * \brief A raster of the propagation gains, in dB, between a site and the
+ * points of a horizontal grid.
+ *
+ * The gains are stored as 32 bits floats, row by row along the x axis, and
+ * are interpolated bilinearly between the points of the grid. The memory
+ * of a map created by Create() is shared with the child processes forked
+ * afterwards, so that they can compute its rows. A map can be saved to a
+ * file, which Load() maps in memory read-only.
+ */
+class RadioMap : public SimpleRefCount<RadioMap>
+{
+  public:
+    ~RadioMap();
+
+    /**
+     * Create a map, whose gains are not computed yet.
+     *
+     * \param [in] xMin The x coordinate of the first point of the grid.
+     * \param [in] yMin The y coordinate of the first point of the grid.
+     * \param [in] resolution The distance between the points of the grid.
+     * \param [in] nX The number of points of the grid along the x axis, at least 2.
+     * \param [in] nY The number of points of the grid along the y axis, at least 2.
+     * \param [in] height The height of the grid.
+     * \param [in] key The key identifying the site, the propagation model
+     *                 and the grid of the map.
+     * \returns The map.
+     */
+    static Ptr<RadioMap> Create(double xMin,
+                                double yMin,
+                                double resolution,
+                                uint32_t nX,
+                                uint32_t nY,
+                                double height,
+                                uint64_t key);
+    /**
+     * Load a map saved by Save().
+     *
+     * \param [in] fileName The name of the file.
+     * \param [in] key The expected key of the map.
+     * \returns The map, or \c nullptr if the file does not exist, or does
+     *          not hold a map of this key.
+     */
+    static Ptr<RadioMap> Load(const std::string& fileName, uint64_t key);
+    /**
+     * Save the map.
+     *
+     * \param [in] fileName The name of the file.
+     * \returns \c false if the file can't be written.
+     */
+    bool Save(const std::string& fileName) const;
+
+    /** \returns The x coordinate of the first point of the grid. */
+    double GetXMin() const;
+    /** \returns The y coordinate of the first point of the grid. */
+    double GetYMin() const;
+    /** \returns The distance between the points of the grid. */
+    double GetResolution() const;
+    /** \returns The number of points of the grid along the x axis. */
+    uint32_t GetNX() const;
+    /** \returns The number of points of the grid along the y axis. */
+    uint32_t GetNY() const;
+    /** \returns The height of the grid. */
+    double GetHeight() const;
+    /** \returns The key of the map. */
+    uint64_t GetKey() const;
+
+    /**
+     * \param [in] j The index of a row of the grid, along the y axis.
+     * \returns The gains of the row, to compute them.
+     */
+    float* GetRow(uint32_t j);
+    /**
+     * \param [in] x The x coordinate of a point.
+     * \param [in] y The y coordinate of a point.
+     * \returns true if the point is covered by the grid.
+     */
+    bool IsInside(double x, double y) const;
+    /**
+     * \param [in] x The x coordinate of a point covered by the grid.
+     * \param [in] y The y coordinate of a point covered by the grid.
+     * \returns The gain at the point, in dB, interpolated between the
+     *          points of the grid.
+     */
+    double GetGain(double x, double y) const;
+
+  private:
+    /** Constructor. */
+    RadioMap();
+
+    double m_xMin;             //!< The x coordinate of the first point of the grid.
+    double m_yMin;             //!< The y coordinate of the first point of the grid.
+    double m_resolution;       //!< The distance between the points of the grid.
+    uint32_t m_nX;             //!< The number of points along the x axis.
+    uint32_t m_nY;             //!< The number of points along the y axis.
+    double m_height;           //!< The height of the grid.
+    uint64_t m_key;            //!< The key of the map.
+    float* m_gains;            //!< The gains.
+    void* m_mapping;           //!< The memory mapping of the map.
+    std::size_t m_mappingSize; //!< The size of the memory mapping.
+};
+
+/*************************************************************************
+ *   Implementation of the inline methods declared above.
+ *************************************************************************/
+
+inline bool
+RadioMap::IsInside(double x, double y) const
+{
+    return x >= m_xMin && y >= m_yMin && x <= m_xMin + (m_nX - 1) * m_resolution &&
+           y <= m_yMin + (m_nY - 1) * m_resolution;
+}
+
+inline double
+RadioMap::GetGain(double x, double y) const
+{
+    NS_ASSERT(IsInside(x, y));
+    double u = (x - m_xMin) / m_resolution;
+    double v = (y - m_yMin) / m_resolution;
+    uint32_t i = std::min(static_cast<uint32_t>(u), m_nX - 2);
+    uint32_t j = std::min(static_cast<uint32_t>(v), m_nY - 2);
+    double fu = u - i;
+    double fv = v - j;
+    const float* row = m_gains + static_cast<std::size_t>(j) * m_nX + i;
+    const float* next = row + m_nX;
+    return (1 - fv) * ((1 - fu) * row[0] + fu * row[1]) + fv * ((1 - fu) * next[0] + fu * next[1]);
+}
+
+} // namespace ns3
+
+#endif /* RADIO_MAP_H */
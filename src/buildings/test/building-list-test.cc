@@ -0,0 +1,163 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/building-list.h"
+#include "ns3/building.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup building-test
+ * \ingroup tests
+ *
+ * Test case for the spatial queries of the BuildingList. It checks that
+ * the buildings found through the grid are the buildings found by checking
+ * every building, for random buildings, positions and line segments.
+ */
+class BuildingListQueryTestCase : public TestCase
+{
+  public:
+    BuildingListQueryTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the queries of a position and a line segment.
+     * \param l1 the position, and one end of the line segment
+     * \param l2 the other end of the line segment
+     */
+    void CheckQueries(const Vector& l1, const Vector& l2);
+};
+
+BuildingListQueryTestCase::BuildingListQueryTestCase()
+    : TestCase("Test case for the spatial queries of the BuildingList")
+{
+}
+
+void
+BuildingListQueryTestCase::CheckQueries(const Vector& l1, const Vector& l2)
+{
+    std::vector<Ptr<Building>> inside;
+    std::vector<Ptr<Building>> intersecting;
+    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+    {
+        if ((*bit)->IsInside(l1))
+        {
+            inside.push_back(*bit);
+        }
+        if ((*bit)->IsIntersect(l1, l2))
+        {
+            intersecting.push_back(*bit);
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ((BuildingList::GetBuildingsAt(l1) == inside),
+                          true,
+                          "Wrong buildings at " << l1);
+    NS_TEST_EXPECT_MSG_EQ((BuildingList::GetIntersectingBuildings(l1, l2) == intersecting),
+                          true,
+                          "Wrong buildings intersecting " << l1 << " " << l2);
+    NS_TEST_EXPECT_MSG_EQ(BuildingList::IsIntersect(l1, l2),
+                          !intersecting.empty(),
+                          "Wrong intersection of " << l1 << " " << l2);
+}
+
+void
+BuildingListQueryTestCase::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+
+    // no building
+    CheckQueries(Vector(0, 0, 0), Vector(10, 10, 0));
+
+    // buildings of various sizes, some of them overlapping, some of them
+    // adjacent, in a 1 km square
+    for (uint32_t i = 0; i < 300; i++)
+    {
+        double x = random->GetValue(0, 1000);
+        double y = random->GetValue(0, 1000);
+        double size = i % 10 == 0 ? random->GetValue(50, 200) : random->GetValue(5, 40);
+        Ptr<Building> building = CreateObject<Building>();
+        building->SetBoundaries(Box(x, x + size, y, y + size, 0, random->GetValue(3, 60)));
+    }
+    Ptr<Building> adjacent = CreateObject<Building>();
+    Box box = BuildingList::GetBuilding(0)->GetBoundaries();
+    adjacent->SetBoundaries(Box(box.xMax, box.xMax + 10, box.yMin, box.yMax, 0, 10));
+
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        // some of the segments start or end outside of the buildings
+        Vector l1(random->GetValue(-100, 1300), random->GetValue(-100, 1300), 1.5);
+        Vector l2;
+        switch (i % 4)
+        {
+        case 0:
+            l2 = Vector(random->GetValue(-100, 1300), random->GetValue(-100, 1300), 25);
+            break;
+        case 1:
+            // short segments
+            l2 = Vector(l1.x + random->GetValue(-20, 20), l1.y + random->GetValue(-20, 20), 1.5);
+            break;
+        case 2:
+            // along an axis
+            l2 = Vector(random->GetValue(-100, 1300), l1.y, 1.5);
+            break;
+        default:
+            // vertical
+            l2 = Vector(l1.x, l1.y, 100);
+        }
+        CheckQueries(l1, l2);
+    }
+    // on the boundaries of the buildings
+    CheckQueries(Vector(box.xMax, box.yMin, 0), Vector(box.xMax, box.yMax, 5));
+    CheckQueries(Vector(box.xMin, box.yMin, 0), Vector(box.xMin - 50, box.yMin - 50, 5));
+
+    // a building moved after the grid was built
+    Ptr<Building> moved = BuildingList::GetBuilding(1);
+    moved->SetBoundaries(Box(2000, 2010, 2000, 2010, 0, 10));
+    NS_TEST_EXPECT_MSG_EQ(BuildingList::GetBuildingsAt(Vector(2005, 2005, 5)).size(),
+                          1,
+                          "The grid was not updated");
+    CheckQueries(Vector(2005, 2005, 5), Vector(0, 0, 5));
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup building-test
+ * \ingroup tests
+ *
+ * Test suite for the spatial queries of the BuildingList
+ */
+class BuildingListTestSuite : public TestSuite
+{
+  public:
+    BuildingListTestSuite();
+};
+
+BuildingListTestSuite::BuildingListTestSuite()
+    : TestSuite("building-list", UNIT)
+{
+    AddTestCase(new BuildingListQueryTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static BuildingListTestSuite g_buildingListTestSuite;
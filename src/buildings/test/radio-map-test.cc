@@ -0,0 +1,267 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/pointer.h"
+#include "ns3/radio-map-propagation-loss-model.h"
+#include "ns3/rectangle.h"
+#include "ns3/string.h"
+#include "ns3/system-path.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <cmath>
+#include <fstream>
+#include <list>
+
+using namespace ns3;
+
+/**
+ * \ingroup building-test
+ * \ingroup tests
+ *
+ * Test case for the RadioMapPropagationLossModel. It checks that the links
+ * of a site looked up in the radio maps match the wrapped model, that the
+ * other links are computed by the wrapped model, that the maps computed by
+ * several processes match, and that the saved maps are loaded again.
+ */
+class RadioMapTestCase : public TestCase
+{
+  public:
+    RadioMapTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \param resolution the resolution of the maps
+     * \param processes the number of processes computing the maps
+     * \param directory the directory of the maps
+     * \returns a model wrapping m_model, of bounds 0 to 200 m
+     */
+    Ptr<RadioMapPropagationLossModel> CreateModel(double resolution,
+                                                  uint32_t processes,
+                                                  std::string directory);
+
+    Ptr<PropagationLossModel> m_model; //!< the wrapped model
+    Ptr<MobilityModel> m_site;         //!< the site
+};
+
+RadioMapTestCase::RadioMapTestCase()
+    : TestCase("Test case for the RadioMapPropagationLossModel")
+{
+}
+
+Ptr<RadioMapPropagationLossModel>
+RadioMapTestCase::CreateModel(double resolution, uint32_t processes, std::string directory)
+{
+    Ptr<RadioMapPropagationLossModel> model = CreateObject<RadioMapPropagationLossModel>();
+    model->SetAttribute("Model", PointerValue(m_model));
+    model->SetAttribute("Bounds", RectangleValue(Rectangle(0, 200, 0, 200)));
+    model->SetAttribute("Resolution", DoubleValue(resolution));
+    model->SetAttribute("Height", DoubleValue(1.5));
+    model->SetAttribute("Processes", UintegerValue(processes));
+    model->SetAttribute("Directory", StringValue(directory));
+    model->AddSite(m_site);
+    return model;
+}
+
+void
+RadioMapTestCase::DoRun()
+{
+    m_model = CreateObject<LogDistancePropagationLossModel>();
+    m_model->SetAttribute("Exponent", DoubleValue(3.0));
+    m_site = CreateObject<ConstantPositionMobilityModel>();
+    m_site->SetPosition(Vector(100, 100, 25));
+    Ptr<MobilityModel> ue = CreateObject<ConstantPositionMobilityModel>();
+
+    Ptr<RadioMapPropagationLossModel> model = CreateModel(10, 1, "");
+    // at the points of the grid, and between them, far enough from the site
+    for (const Vector& position : {Vector(50, 60, 1.5),
+                                   Vector(55, 63, 1.5),
+                                   Vector(170, 121.5, 1.5),
+                                   Vector(200, 0, 1.5)})
+    {
+        ue->SetPosition(position);
+        double expected = m_model->CalcRxPower(10, m_site, ue);
+        NS_TEST_EXPECT_MSG_EQ_TOL(model->CalcRxPower(10, m_site, ue),
+                                  expected,
+                                  0.1,
+                                  "Wrong downlink gain at " << position);
+        NS_TEST_EXPECT_MSG_EQ_TOL(model->CalcRxPower(10, ue, m_site),
+                                  m_model->CalcRxPower(10, ue, m_site),
+                                  0.1,
+                                  "Wrong uplink gain at " << position);
+    }
+    ue->SetPosition(Vector(50, 60, 1.5));
+    NS_TEST_EXPECT_MSG_EQ_TOL(model->CalcRxPower(0, m_site, ue),
+                              m_model->CalcRxPower(0, m_site, ue),
+                              1e-4,
+                              "Wrong gain at a point of the grid");
+
+    // out of the maps
+    for (const Vector& position : {Vector(50, 60, 10), Vector(250, 60, 1.5)})
+    {
+        ue->SetPosition(position);
+        NS_TEST_EXPECT_MSG_EQ(model->CalcRxPower(0, m_site, ue),
+                              m_model->CalcRxPower(0, m_site, ue),
+                              "The link to " << position << " is not computed by the model");
+    }
+
+    // the maps computed by several processes, before the first link
+    Ptr<const RadioMap> map = model->GetRadioMap(m_site, true);
+    Ptr<RadioMapPropagationLossModel> parallelModel = CreateModel(10, 3, "");
+    parallelModel->PrecomputeMaps();
+    Ptr<const RadioMap> parallelMap = parallelModel->GetRadioMap(m_site, true);
+    NS_TEST_ASSERT_MSG_EQ(parallelMap->GetNX(), 21, "Wrong number of points");
+    NS_TEST_ASSERT_MSG_EQ(parallelMap->GetNY(), 21, "Wrong number of points");
+    for (uint32_t j = 0; j < map->GetNY(); j++)
+    {
+        for (uint32_t i = 0; i < map->GetNX(); i++)
+        {
+            double x = i * 10.0;
+            double y = j * 10.0;
+            NS_TEST_EXPECT_MSG_EQ(parallelMap->GetGain(x, y),
+                                  map->GetGain(x, y),
+                                  "Wrong gain at " << x << " " << y);
+        }
+    }
+
+    // the saved maps are loaded again, until the inputs of the maps change
+    std::string directory = CreateTempDirFilename("radio-maps");
+    SystemPath::MakeDirectories(directory);
+    Ptr<RadioMapPropagationLossModel> savingModel = CreateModel(10, 2, directory);
+    ue->SetPosition(Vector(0, 0, 1.5));
+    double gain = savingModel->CalcRxPower(0, m_site, ue);
+    std::list<std::string> files = SystemPath::ReadFiles(directory);
+    NS_TEST_ASSERT_MSG_EQ(files.size(), 1, "The map is not saved");
+    std::string fileName = directory + "/" + files.front();
+    {
+        std::fstream file(fileName, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(64);
+        float value = 123;
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    Ptr<RadioMapPropagationLossModel> loadingModel = CreateModel(10, 2, directory);
+    NS_TEST_EXPECT_MSG_EQ(loadingModel->CalcRxPower(0, m_site, ue), 123, "The map is not loaded");
+    Ptr<RadioMapPropagationLossModel> otherModel = CreateModel(20, 2, directory);
+    NS_TEST_EXPECT_MSG_EQ_TOL(otherModel->CalcRxPower(0, m_site, ue),
+                              gain,
+                              1e-4,
+                              "The map of another resolution is loaded");
+    m_model->SetAttribute("Exponent", DoubleValue(3.5));
+    Ptr<RadioMapPropagationLossModel> otherExponentModel = CreateModel(10, 2, directory);
+    NS_TEST_EXPECT_MSG_EQ_TOL(otherExponentModel->CalcRxPower(0, m_site, ue),
+                              m_model->CalcRxPower(0, m_site, ue),
+                              1e-4,
+                              "The map of another exponent is loaded");
+    NS_TEST_EXPECT_MSG_EQ(SystemPath::ReadFiles(directory).size(), 3, "The maps are not saved");
+}
+
+/**
+ * \ingroup building-test
+ * \ingroup tests
+ *
+ * Test case for the shadowing of the RadioMapPropagationLossModel. It
+ * checks that the shadowing is reciprocal, correlated over short distances,
+ * and of the configured standard deviation.
+ */
+class RadioMapShadowingTestCase : public TestCase
+{
+  public:
+    RadioMapShadowingTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+RadioMapShadowingTestCase::RadioMapShadowingTestCase()
+    : TestCase("Test case for the shadowing of the RadioMapPropagationLossModel")
+{
+}
+
+void
+RadioMapShadowingTestCase::DoRun()
+{
+    const double sigma = 8;
+    Ptr<RadioMapPropagationLossModel> model = CreateObject<RadioMapPropagationLossModel>();
+    model->SetAttribute("Model", PointerValue(CreateObject<LogDistancePropagationLossModel>()));
+    model->SetAttribute("Bounds", RectangleValue(Rectangle(0, 200, 0, 200)));
+    model->SetAttribute("ShadowingStd", DoubleValue(sigma));
+    model->SetAttribute("ShadowingDecorrelation", DoubleValue(50));
+    model->AssignStreams(1);
+
+    // the fields of many sites, at a position between the points of the field
+    const uint32_t sites = 1000;
+    Vector position(80, 135, 1.5);
+    double sum = 0;
+    double sumSquares = 0;
+    double maxStep = 0;
+    for (uint32_t k = 0; k < sites; k++)
+    {
+        Ptr<MobilityModel> site = CreateObject<ConstantPositionMobilityModel>();
+        site->SetPosition(Vector(100, 100, 25));
+        model->AddSite(site);
+        double shadowing = model->GetShadowing(site, position);
+        sum += shadowing;
+        sumSquares += shadowing * shadowing;
+        double nearShadowing = model->GetShadowing(site, position + Vector(1, 1, 0));
+        maxStep = std::max(maxStep, std::abs(nearShadowing - shadowing));
+    }
+    double mean = sum / sites;
+    double sampleStd = std::sqrt(sumSquares / sites - mean * mean);
+    NS_TEST_EXPECT_MSG_EQ_TOL(mean, 0, 1.0, "Wrong mean of the shadowing");
+    NS_TEST_EXPECT_MSG_EQ_TOL(sampleStd, sigma, 0.1 * sigma, "Wrong std of the shadowing");
+    NS_TEST_EXPECT_MSG_LT(maxStep, sigma * 0.25, "The shadowing is not correlated");
+
+    // the shadowing is added to the links of the maps, in both directions
+    Ptr<MobilityModel> site = CreateObject<ConstantPositionMobilityModel>();
+    site->SetPosition(Vector(100, 100, 25));
+    model->AddSite(site);
+    Ptr<MobilityModel> ue = CreateObject<ConstantPositionMobilityModel>();
+    ue->SetPosition(position);
+    double gain = model->GetRadioMap(site, true)->GetGain(position.x, position.y);
+    NS_TEST_EXPECT_MSG_EQ_TOL(model->CalcRxPower(0, site, ue),
+                              gain - model->GetShadowing(site, position),
+                              1e-9,
+                              "The shadowing is not applied");
+    NS_TEST_EXPECT_MSG_EQ_TOL(model->CalcRxPower(0, ue, site),
+                              model->CalcRxPower(0, site, ue),
+                              1e-4,
+                              "The shadowing is not reciprocal");
+}
+
+/**
+ * \ingroup building-test
+ * \ingroup tests
+ *
+ * Test suite for the radio maps.
+ */
+class RadioMapTestSuite : public TestSuite
+{
+  public:
+    RadioMapTestSuite();
+};
+
+RadioMapTestSuite::RadioMapTestSuite()
+    : TestSuite("radio-map", UNIT)
+{
+    AddTestCase(new RadioMapTestCase, TestCase::QUICK);
+    AddTestCase(new RadioMapShadowingTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static RadioMapTestSuite g_radioMapTestSuite;
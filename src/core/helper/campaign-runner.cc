@@ -0,0 +1,376 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "campaign-runner.h"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/log.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-path.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#ifndef __WIN32__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/**
+ * \file
+ * \ingroup core-helpers
+ * ns3::CampaignRunner implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("CampaignRunner");
+
+NS_OBJECT_ENSURE_REGISTERED(CampaignRunner);
+
+namespace
+{
+
+/**
+ * \ingroup core-helpers
+ * Make a name usable in a file name.
+ *
+ * \param [in] name The name.
+ * \returns The name, with the characters other than letters, digits,
+ *          '.', '-', '_' and '=' replaced by '_'.
+ */
+std::string
+CampaignFileName(const std::string& name)
+{
+    std::string fileName = name;
+    for (auto& c : fileName)
+    {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '.' && c != '-' && c != '_' &&
+            c != '=')
+        {
+            c = '_';
+        }
+    }
+    return fileName;
+}
+
+} // unnamed namespace
+
+std::string
+CampaignRunner::Run::Get(const std::string& name) const
+{
+    auto it = parameters.find(name);
+    NS_ABORT_MSG_IF(it == parameters.end(), "Unknown campaign parameter " << name);
+    return it->second;
+}
+
+TypeId
+CampaignRunner::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CampaignRunner")
+            .SetParent<Object>()
+            .SetGroupName("Core")
+            .AddConstructor<CampaignRunner>()
+            .AddAttribute("Parallel",
+                          "The maximum number of runs executed at once, "
+                          "or 0 for the number of hardware threads.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&CampaignRunner::m_parallel),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Replications",
+                          "The number of replications of each combination of parameters.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&CampaignRunner::m_replications),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("FirstRun",
+                          "The run number of the random number generator "
+                          "for the first replication.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&CampaignRunner::m_firstRun),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("OutputDirectory",
+                          "The directory where the directories of the runs are created.",
+                          StringValue("campaign"),
+                          MakeStringAccessor(&CampaignRunner::m_directory),
+                          MakeStringChecker())
+            .AddAttribute("ChangeDirectory",
+                          "Whether the runs execute in their output directory.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&CampaignRunner::m_changeDirectory),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+CampaignRunner::CampaignRunner()
+    : m_isBranch(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+CampaignRunner::~CampaignRunner()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+CampaignRunner::AddParameter(const std::string& name, const std::vector<std::string>& values)
+{
+    NS_LOG_FUNCTION(this << name << values.size());
+    NS_ABORT_MSG_IF(values.empty(), "No value for the campaign parameter " << name);
+    m_parameters.emplace_back(name, values);
+}
+
+uint32_t
+CampaignRunner::GetNRuns() const
+{
+    uint32_t nRuns = m_replications;
+    for (const auto& [name, values] : m_parameters)
+    {
+        nRuns *= values.size();
+    }
+    return nRuns;
+}
+
+CampaignRunner::Run
+CampaignRunner::GetRun(uint32_t index) const
+{
+    NS_ASSERT(index < GetNRuns());
+    Run run;
+    run.index = index;
+    run.replication = index % m_replications;
+    run.runNumber = m_firstRun + run.replication;
+    // the last parameter varies the fastest
+    uint32_t combination = index / m_replications;
+    std::vector<std::string> names(m_parameters.size());
+    for (std::size_t i = m_parameters.size(); i-- > 0;)
+    {
+        const auto& [name, values] = m_parameters[i];
+        const std::string& value = values[combination % values.size()];
+        combination /= values.size();
+        run.parameters[name] = value;
+        std::string shortName = name.substr(name.rfind("::") == std::string::npos
+                                                ? 0
+                                                : name.rfind("::") + 2);
+        names[i] = CampaignFileName(shortName + "=" + value);
+    }
+    run.directory = m_directory;
+    for (const auto& name : names)
+    {
+        run.directory = SystemPath::Append(run.directory, name);
+    }
+    run.directory = SystemPath::Append(run.directory, "run-" + std::to_string(run.runNumber));
+    return run;
+}
+
+int
+CampaignRunner::GetStatus(uint32_t index) const
+{
+    return index < m_statuses.size() ? m_statuses[index] : -1;
+}
+
+uint32_t
+CampaignRunner::GetNFailed() const
+{
+    return std::count_if(m_statuses.begin(), m_statuses.end(), [](int status) {
+        return status != 0;
+    });
+}
+
+void
+CampaignRunner::PrepareChild(const Run& run) const
+{
+    SystemPath::MakeDirectories(run.directory);
+#ifndef __WIN32__
+    NS_ABORT_MSG_IF(m_changeDirectory && chdir(run.directory.c_str()) != 0,
+                    "Can't change to directory " << run.directory);
+#endif
+    RngSeedManager::SetRun(run.runNumber);
+    for (const auto& [name, value] : run.parameters)
+    {
+        if (name.find("::") != std::string::npos)
+        {
+            Config::SetDefault(name, StringValue(value));
+        }
+    }
+}
+
+bool
+CampaignRunner::ForkRuns(uint32_t& index)
+{
+    NS_LOG_FUNCTION(this);
+#ifdef __WIN32__
+    NS_FATAL_ERROR("CampaignRunner is not supported on Windows");
+    return false;
+#else
+    uint32_t nRuns = GetNRuns();
+    uint32_t parallel = m_parallel;
+    if (parallel == 0)
+    {
+        parallel = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    SystemPath::MakeDirectories(m_directory);
+    m_statuses.assign(nRuns, -1);
+
+    std::map<pid_t, uint32_t> children;
+    // wait for a child to end
+    auto wait = [this, &children]() {
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        NS_ABORT_MSG_IF(pid < 0, "waitpid() failed");
+        auto it = children.find(pid);
+        if (it == children.end())
+        {
+            return;
+        }
+        int& runStatus = m_statuses[it->second];
+        runStatus = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+        NS_LOG_INFO("Run " << it->second << " ended with status " << runStatus);
+        children.erase(it);
+    };
+
+    for (uint32_t i = 0; i < nRuns; i++)
+    {
+        while (children.size() >= parallel)
+        {
+            wait();
+        }
+        NS_LOG_INFO("Run " << i << " in " << GetRun(i).directory);
+        // not to write the buffered output in the children too
+        std::cout.flush();
+        std::cerr.flush();
+        std::fflush(nullptr);
+        pid_t pid = fork();
+        NS_ABORT_MSG_IF(pid < 0, "fork() failed");
+        if (pid == 0)
+        {
+            index = i;
+            return true;
+        }
+        children[pid] = i;
+    }
+    while (!children.empty())
+    {
+        wait();
+    }
+    WriteSummary();
+    return false;
+#endif
+}
+
+uint32_t
+CampaignRunner::Execute(RunCallback callback)
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t index;
+    if (ForkRuns(index))
+    {
+        Run run = GetRun(index);
+        PrepareChild(run);
+        int status = callback(run);
+        Simulator::Destroy();
+        std::cout.flush();
+        std::cerr.flush();
+        std::fflush(nullptr);
+        // the static objects belong to the parent process
+        _exit(status);
+    }
+    return GetNFailed();
+}
+
+void
+CampaignRunner::ScheduleBranches(Time delay, RunCallback callback)
+{
+    NS_LOG_FUNCTION(this << delay);
+    Simulator::Schedule(delay, &CampaignRunner::Branch, this, callback);
+}
+
+void
+CampaignRunner::Branch(RunCallback callback)
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t index;
+    if (!ForkRuns(index))
+    {
+        // the branches have completed the simulation
+        Simulator::Stop();
+        return;
+    }
+    m_isBranch = true;
+    m_branch = GetRun(index);
+    PrepareChild(m_branch);
+    int status = callback(m_branch);
+    if (status != 0)
+    {
+        std::cout.flush();
+        std::cerr.flush();
+        std::fflush(nullptr);
+        _exit(status);
+    }
+}
+
+bool
+CampaignRunner::IsBranch() const
+{
+    return m_isBranch;
+}
+
+const CampaignRunner::Run&
+CampaignRunner::GetBranch() const
+{
+    NS_ASSERT_MSG(m_isBranch, "Not a branch");
+    return m_branch;
+}
+
+void
+CampaignRunner::WriteSummary() const
+{
+    NS_LOG_FUNCTION(this);
+    std::string filename = SystemPath::Append(m_directory, "campaign.csv");
+    std::ofstream file(filename);
+    if (!file.is_open())
+    {
+        NS_LOG_ERROR("Can't open file " << filename);
+        return;
+    }
+    file << "index,replication,run";
+    for (const auto& [name, values] : m_parameters)
+    {
+        file << "," << name;
+    }
+    file << ",status,directory\n";
+    for (uint32_t i = 0; i < GetNRuns(); i++)
+    {
+        Run run = GetRun(i);
+        file << run.index << "," << run.replication << "," << run.runNumber;
+        for (const auto& [name, values] : m_parameters)
+        {
+            file << "," << run.parameters.at(name);
+        }
+        file << "," << GetStatus(i) << "," << run.directory << "\n";
+    }
+}
+
+} // namespace ns3
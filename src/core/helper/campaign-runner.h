@@ -0,0 +1,249 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CAMPAIGN_RUNNER_H
+#define CAMPAIGN_RUNNER_H
+
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-helpers
+ * ns3::CampaignRunner declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup core-helpers
+ *
+ * \brief Run a campaign of simulations, over a grid of parameters and
+ * replications, in child processes of the simulation program.
+ *
+ * Each run of the campaign is a combination of the values of the
+ * parameters added by AddParameter(), and a replication number. The
+ * runs are executed by the callback passed to Execute(), which sets up
+ * the simulation of a run, and calls Simulator::Run():
+ *
+ * \code
+ *   int
+ *   RunSimulation(const CampaignRunner::Run& run)
+ *   {
+ *       uint32_t nUes = std::stoul(run.Get("nUes"));
+ *       ...
+ *       Simulator::Run();
+ *       return 0;
+ *   }
+ *
+ *   Ptr<CampaignRunner> campaign = CreateObject<CampaignRunner>();
+ *   campaign->SetAttribute("Replications", UintegerValue(32));
+ *   campaign->AddParameter("nUes", {"50", "100"});
+ *   campaign->AddParameter("ns3::LteHelper::Scheduler",
+ *                          {"ns3::PfFfMacScheduler", "ns3::RrFfMacScheduler"});
+ *   uint32_t nFailed = campaign->Execute(MakeCallback(&RunSimulation));
+ * \endcode
+ *
+ * Each run is executed in a child process forked from the program, at
+ * most \c Parallel at once. The children share the memory of the program,
+ * copy on write: the state set up before Execute(), such as the TypeIds,
+ * the parsed input files or loaded models, is not set up again for each
+ * run, and is not copied unless a run modifies it. The runs are still
+ * isolated from each other, since ns-3 keeps the state of a simulation,
+ * such as the Simulator and the defaults of the attributes, in globals.
+ *
+ * In the child process of a run, before the callback:
+ * - the directory of the run is created, and becomes the working
+ *   directory with the \c ChangeDirectory attribute, so that the output
+ *   files of the simulation end up in the directory of the run;
+ * - the run number of the random number generator is set to the
+ *   \c FirstRun attribute plus the replication number, so that the runs
+ *   of the different combinations of parameters use the same streams;
+ * - the parameters whose name is the full name of an attribute, such as
+ *   "ns3::LteHelper::Scheduler", are set as the default value of the
+ *   attribute, with Config::SetDefault().
+ *
+ * The value returned by the callback is the exit status of the child
+ * process, which is 0 if the run succeeded. The child process ends
+ * without running the destructors of the static objects, so the callback
+ * must close its own output files.
+ *
+ * The program must not have running threads when forking the children.
+ *
+ * Execute() writes a summary of the campaign, with the parameters, the
+ * exit status and the directory of each run, to the \c campaign.csv file
+ * of the \c OutputDirectory.
+ *
+ * The runs can also branch from a simulation which is already running,
+ * to share its warm-up, such as the attachment of the UEs and the setup of
+ * their bearers. ScheduleBranches() schedules the fork of the runs, and
+ * each run continues the simulation from this point, in its child process,
+ * once the callback has configured it:
+ *
+ * \code
+ *   int
+ *   ConfigureBranch(const CampaignRunner::Run& run)
+ *   {
+ *       Config::Set("/NodeList/3/ApplicationList/0/$ns3::UdpClient/Interval",
+ *                   StringValue(run.Get("interval")));
+ *       return 0;
+ *   }
+ *
+ *   ... // set up the simulation
+ *   campaign->AddParameter("interval", {"10ms", "20ms"});
+ *   campaign->ScheduleBranches(Seconds(1), MakeCallback(&ConfigureBranch));
+ *   Simulator::Run();
+ *   if (!campaign->IsBranch())
+ *   {
+ *       // the simulation stopped when the branches ended
+ *       Simulator::Destroy();
+ *       return campaign->GetNFailed() > 0;
+ *   }
+ *   ... // write the results of the branch
+ * \endcode
+ *
+ * A branch ends with the simulation program, whose exit status is the
+ * status of the run, unless the callback returns a non-zero status. The
+ * parent process waits for the branches, then stops its simulation.
+ *
+ * In a branch, the run number and the defaults of the attributes only
+ * apply to the objects created after the branch point. The random
+ * variables created before keep their streams, unless the callback
+ * assigns them again, e.g. with LteHelper::AssignStreams(), which draws
+ * them from the run number of the branch. The files open at the branch
+ * point are shared by the branches, so the output files must be opened
+ * after the branch point, or opened again by the callback.
+ */
+class CampaignRunner : public Object
+{
+  public:
+    /** A run of the campaign. */
+    struct Run
+    {
+        uint32_t index;                                //!< The index of the run in the campaign.
+        uint32_t replication;                          //!< The replication number.
+        uint64_t runNumber;                            //!< The run number of the RNG.
+        std::string directory;                         //!< The output directory.
+        std::map<std::string, std::string> parameters; //!< The values of the parameters.
+
+        /**
+         * \param [in] name The name of a parameter.
+         * \returns The value of the parameter.
+         */
+        std::string Get(const std::string& name) const;
+    };
+
+    /** The callback executing a run, and returning its exit status. */
+    typedef Callback<int, const Run&> RunCallback;
+
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    CampaignRunner();
+    ~CampaignRunner() override;
+
+    /**
+     * Add a parameter to the grid of the campaign.
+     *
+     * \param [in] name The name of the parameter, or the full name of an attribute.
+     * \param [in] values The values of the parameter.
+     */
+    void AddParameter(const std::string& name, const std::vector<std::string>& values);
+    /** \returns The number of runs of the campaign. */
+    uint32_t GetNRuns() const;
+    /**
+     * \param [in] index The index of a run.
+     * \returns The run.
+     */
+    Run GetRun(uint32_t index) const;
+    /**
+     * Execute the runs of the campaign.
+     *
+     * \param [in] callback The callback executing a run.
+     * \returns The number of runs which failed.
+     */
+    uint32_t Execute(RunCallback callback);
+    /**
+     * \param [in] index The index of a run.
+     * \returns The exit status of the run, 128 plus the number of the
+     *          signal if it was killed by a signal, or -1 if not executed.
+     */
+    int GetStatus(uint32_t index) const;
+    /** \returns The number of runs which failed, or were not executed. */
+    uint32_t GetNFailed() const;
+
+    /**
+     * Schedule the fork of the runs of the campaign from the simulation.
+     *
+     * \param [in] delay The delay of the branch point.
+     * \param [in] callback The callback configuring a branch, and
+     *                      returning 0 to continue the branch, or the exit
+     *                      status of the run.
+     */
+    void ScheduleBranches(Time delay, RunCallback callback);
+    /** \returns true in the child process of a branch. */
+    bool IsBranch() const;
+    /** \returns The run of this branch. */
+    const Run& GetBranch() const;
+
+  private:
+    /**
+     * Fork a child process for each run, and wait for them to end.
+     *
+     * \param [out] index The index of the run, in a child process.
+     * \returns true in a child process, and false in this process, once
+     *          the children ended.
+     */
+    bool ForkRuns(uint32_t& index);
+    /**
+     * Set up the directory, the run number and the defaults of the
+     * attributes of a run, in its child process.
+     *
+     * \param [in] run The run.
+     */
+    void PrepareChild(const Run& run) const;
+    /**
+     * Fork the branches.
+     *
+     * \param [in] callback The callback configuring a branch.
+     */
+    void Branch(RunCallback callback);
+    /** Write the summary of the campaign. */
+    void WriteSummary() const;
+
+    uint32_t m_parallel;         //!< The maximum number of runs executed at once.
+    uint32_t m_replications;     //!< The number of replications of each combination.
+    uint64_t m_firstRun;         //!< The run number of the first replication.
+    std::string m_directory;     //!< The output directory of the campaign.
+    bool m_changeDirectory;      //!< Whether the runs execute in their directory.
+    std::vector<int> m_statuses; //!< The exit status of the runs.
+    bool m_isBranch;             //!< Whether this process is a branch.
+    Run m_branch;                //!< The run of this branch.
+    /** The parameters, and their values. */
+    std::vector<std::pair<std::string, std::vector<std::string>>> m_parameters;
+};
+
+} // namespace ns3
+
+#endif /* CAMPAIGN_RUNNER_H */
@@ -20,12 +20,15 @@
 
 #include "global-value.h"
 #include "log.h"
+#include "multithreading.h"
 #include "names.h"
 #include "object-ptr-container.h"
 #include "object.h"
 #include "pointer.h"
 #include "singleton.h"
 
+#include <algorithm>
+#include <map>
 #include <sstream>
 
 /**
@@ -197,10 +200,16 @@ MatchContainer::DisconnectWithoutContext(std::string name, const CallbackBase& c
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, into a sorted list of disjoint
+ * index ranges.
  */
 class ArrayMatcher
 {
   public:
+    /** An inclusive range of indices. */
+    typedef std::pair<uint32_t, uint32_t> Range;
+
     /**
      * Construct from a Config path specification.
      *
@@ -214,8 +223,33 @@ class ArrayMatcher
      * \returns \c true if the index matches the Config Path.
      */
     bool Matches(std::size_t i) const;
+    /**
+     * Test if the specification matches all the indices ("*").
+     *
+     * \returns \c true if all the indices match.
+     */
+    bool MatchesAll() const;
+    /**
+     * Get the number of indices which match the specification,
+     * unless MatchesAll().
+     *
+     * \returns The number of indices.
+     */
+    uint64_t GetCount() const;
+    /**
+     * Get the indices which match the specification, unless MatchesAll().
+     *
+     * \returns The disjoint ranges of indices, in increasing order.
+     */
+    const std::vector<Range>& GetRanges() const;
 
   private:
+    /**
+     * Add the indices matching a Config path specification.
+     *
+     * \param [in] element The Config path specification.
+     */
+    void Parse(std::string element);
     /**
      * Convert a string to an \c uint32_t.
      *
@@ -226,77 +260,127 @@ class ArrayMatcher
     bool StringToUint32(std::string str, uint32_t* value) const;
     /** The Config path element. */
     std::string m_element;
+    /** Whether all the indices match. */
+    bool m_all;
+    /** The indices which match. */
+    std::vector<Range> m_ranges;
 
 }; // class ArrayMatcher
 
 ArrayMatcher::ArrayMatcher(std::string element)
-    : m_element(element)
+    : m_element(element),
+      m_all(false)
 {
     NS_LOG_FUNCTION(this << element);
+    Parse(element);
+    if (m_all)
+    {
+        m_ranges.clear();
+        return;
+    }
+    // sort and merge the ranges
+    std::sort(m_ranges.begin(), m_ranges.end());
+    std::vector<Range> ranges;
+    for (const auto& range : m_ranges)
+    {
+        if (!ranges.empty() && static_cast<uint64_t>(ranges.back().second) + 1 >= range.first)
+        {
+            ranges.back().second = std::max(ranges.back().second, range.second);
+        }
+        else
+        {
+            ranges.push_back(range);
+        }
+    }
+    m_ranges.swap(ranges);
 }
 
-bool
-ArrayMatcher::Matches(std::size_t i) const
+void
+ArrayMatcher::Parse(std::string element)
 {
-    NS_LOG_FUNCTION(this << i);
-    if (m_element == "*")
+    NS_LOG_FUNCTION(this << element);
+    if (element == "*")
     {
-        NS_LOG_DEBUG("Array " << i << " matches *");
-        return true;
+        m_all = true;
+        return;
     }
     std::string::size_type tmp;
-    tmp = m_element.find('|');
+    tmp = element.find('|');
     if (tmp != std::string::npos)
     {
-        std::string left = m_element.substr(0, tmp - 0);
-        std::string right = m_element.substr(tmp + 1, m_element.size() - (tmp + 1));
-        ArrayMatcher matcher = ArrayMatcher(left);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << left);
-            return true;
-        }
-        matcher = ArrayMatcher(right);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << right);
-            return true;
-        }
-        NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-        return false;
+        std::string left = element.substr(0, tmp - 0);
+        std::string right = element.substr(tmp + 1, element.size() - (tmp + 1));
+        Parse(left);
+        Parse(right);
+        return;
     }
-    std::string::size_type leftBracket = m_element.find('[');
-    std::string::size_type rightBracket = m_element.find(']');
-    std::string::size_type dash = m_element.find('-');
-    if (leftBracket == 0 && rightBracket == m_element.size() - 1 && dash > leftBracket &&
+    std::string::size_type leftBracket = element.find('[');
+    std::string::size_type rightBracket = element.find(']');
+    std::string::size_type dash = element.find('-');
+    if (leftBracket == 0 && rightBracket == element.size() - 1 && dash > leftBracket &&
         dash < rightBracket)
     {
-        std::string lowerBound = m_element.substr(leftBracket + 1, dash - (leftBracket + 1));
-        std::string upperBound = m_element.substr(dash + 1, rightBracket - (dash + 1));
+        std::string lowerBound = element.substr(leftBracket + 1, dash - (leftBracket + 1));
+        std::string upperBound = element.substr(dash + 1, rightBracket - (dash + 1));
         uint32_t min;
         uint32_t max;
-        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && i >= min &&
-            i <= max)
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-            return true;
-        }
-        else
+        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && min <= max)
         {
-            NS_LOG_DEBUG("Array " << i << " does not " << m_element);
-            return false;
+            m_ranges.emplace_back(min, max);
         }
+        return;
     }
     uint32_t value;
-    if (StringToUint32(m_element, &value) && i == value)
+    if (StringToUint32(element, &value))
     {
-        NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+        m_ranges.emplace_back(value, value);
+    }
+}
+
+bool
+ArrayMatcher::Matches(std::size_t i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    if (m_all)
+    {
+        NS_LOG_DEBUG("Array " << i << " matches *");
         return true;
     }
+    for (const auto& range : m_ranges)
+    {
+        if (i >= range.first && i <= range.second)
+        {
+            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+            return true;
+        }
+    }
     NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
     return false;
 }
 
+bool
+ArrayMatcher::MatchesAll() const
+{
+    return m_all;
+}
+
+uint64_t
+ArrayMatcher::GetCount() const
+{
+    uint64_t count = 0;
+    for (const auto& range : m_ranges)
+    {
+        count += static_cast<uint64_t>(range.second) - range.first + 1;
+    }
+    return count;
+}
+
+const std::vector<ArrayMatcher::Range>&
+ArrayMatcher::GetRanges() const
+{
+    return m_ranges;
+}
+
 bool
 ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
 {
@@ -307,6 +391,45 @@ ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
     return !iss.bad() && !iss.fail();
 }
 
+/**
+ * \ingroup config-impl
+ * A segment of a Config path, with the interpretations it can have
+ * depending on the object it is applied to.
+ */
+struct CompiledPath::Segment
+{
+    /**
+     * Parse a segment.
+     *
+     * \param [in] segment The segment, without the slashes.
+     */
+    Segment(std::string segment);
+
+    std::string item;     //!< The segment.
+    bool isNames;         //!< Whether the segment is the root of the "/Names" namespace.
+    bool isObject;        //!< Whether the segment is a "$" call to GetObject.
+    std::string tidName;  //!< The name of the TypeId of a "$" segment.
+    bool hasTid;          //!< Whether \c tidName was registered when the path was parsed.
+    TypeId tid;           //!< The TypeId of a "$" segment, if \c hasTid.
+    ArrayMatcher matcher; //!< The segment as an index of a container.
+};
+
+CompiledPath::Segment::Segment(std::string segment)
+    : item(segment),
+      isNames(segment.compare(0, 5, "Names") == 0),
+      isObject(segment.find('$') == 0),
+      hasTid(false),
+      matcher(segment)
+{
+    if (isObject)
+    {
+        tidName = item.substr(1, item.size() - 1);
+        // The type can be registered later, in which case it is
+        // looked up when the path is resolved
+        hasTid = TypeId::LookupByNameFailSafe(tidName, &tid);
+    }
+}
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
@@ -314,12 +437,17 @@ ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
 class Resolver
 {
   public:
+    /** The segments of a Config path. */
+    typedef std::vector<CompiledPath::Segment> Segments;
+
     /**
-     * Construct from a base Config path.
+     * Construct from a parsed Config path.
      *
-     * \param [in] path The Config path.
+     * \param [in] segments The segments of the Config path.
+     * \param [in] context The path of the objects from which the
+     *             Config path is resolved.
      */
-    Resolver(std::string path);
+    Resolver(const Segments& segments, std::string context = "");
     /** Destructor. */
     virtual ~Resolver();
 
@@ -333,23 +461,49 @@ class Resolver
     void Resolve(Ptr<Object> root);
 
   private:
-    /** Ensure the Config path starts and ends with a '/'. */
-    void Canonicalize();
+    /** A pointer or container attribute which can be followed by a Config path. */
+    struct Attribute
+    {
+        std::string name;                      //!< The attribute name.
+        bool isPointer;                        //!< PointerValue, or ObjectPtrContainerValue.
+        Ptr<const AttributeAccessor> accessor; //!< The accessor, if it can be used directly.
+    };
+
+    /**
+     * Get the pointer and container attributes of a type which match
+     * a segment of a Config path.
+     *
+     * \param [in] tid The type.
+     * \param [in] item The segment: an attribute name, or "*".
+     * \returns The attributes, in the order of the inheritance tree.
+     */
+    static const std::vector<Attribute>& GetAttributes(TypeId tid, const std::string& item);
+    /**
+     * Get the value of a pointer or container attribute.
+     *
+     * \param [in] object The object.
+     * \param [in] attribute The attribute.
+     * \param [out] value The value.
+     */
+    static void GetAttribute(Ptr<Object> object,
+                             const Attribute& attribute,
+                             AttributeValue& value);
     /**
      * Parse the next element in the Config path.
      *
-     * \param [in] path The remaining portion of the Config path.
+     * \param [in] segment The index of the next segment of the Config path.
      * \param [in] root The object corresponding to the current position
      *                  in the Config path.
      */
-    void DoResolve(std::string path, Ptr<Object> root);
+    void DoResolve(std::size_t segment, Ptr<Object> root);
     /**
      * Parse an index on the Config path.
      *
-     * \param [in] path The remaining Config path.
-     * \param [in,out] vector The resulting list of matching objects.
+     * \param [in] segment The index of the next segment of the Config path.
+     * \param [in] root The object holding the container.
+     * \param [in] attribute The container attribute.
      */
-    void DoArrayResolve(std::string path, const ObjectPtrContainerValue& vector);
+    void DoArrayResolve(std::size_t segment, Ptr<Object> root, const Attribute& attribute);
     /**
      * Handle one object found on the path.
      *
@@ -372,16 +526,22 @@ class Resolver
 
     /** Current list of path tokens. */
     std::vector<std::string> m_workStack;
-    /** The Config path. */
-    std::string m_path;
+    /** The segments of the Config path. */
+    const Segments& m_segments;
+    /** The path of the root objects, without the trailing '/'. */
+    std::string m_context;
 
 }; // class Resolver
 
-Resolver::Resolver(std::string path)
-    : m_path(path)
+Resolver::Resolver(const Segments& segments, std::string context)
+    : m_segments(segments),
+      m_context(context)
 {
-    NS_LOG_FUNCTION(this << path);
-    Canonicalize();
+    NS_LOG_FUNCTION(this << segments.size() << context);
+    while (!m_context.empty() && m_context.back() == '/')
+    {
+        m_context.pop_back();
+    }
 }
 
 Resolver::~Resolver()
@@ -389,32 +549,12 @@ Resolver::~Resolver()
     NS_LOG_FUNCTION(this);
 }
 
-void
-Resolver::Canonicalize()
-{
-    NS_LOG_FUNCTION(this);
-
-    // ensure that we start and end with a '/'
-    std::string::size_type tmp = m_path.find('/');
-    if (tmp != 0)
-    {
-        // no slash at start
-        m_path = "/" + m_path;
-    }
-    tmp = m_path.find_last_of('/');
-    if (tmp != (m_path.size() - 1))
-    {
-        // no slash at end
-        m_path = m_path + "/";
-    }
-}
-
 void
 Resolver::Resolve(Ptr<Object> root)
 {
     NS_LOG_FUNCTION(this << root);
 
-    DoResolve(m_path, root);
+    DoResolve(0, root);
 }
 
 std::string
@@ -422,7 +562,7 @@ Resolver::GetResolvedPath() const
 {
     NS_LOG_FUNCTION(this);
 
-    std::string fullPath = "/";
+    std::string fullPath = m_context + "/";
     for (auto i = m_workStack.begin(); i != m_workStack.end(); i++)
     {
         fullPath += *i + "/";
@@ -439,14 +579,90 @@ Resolver::DoResolveOne(Ptr<Object> object)
     DoOne(object, GetResolvedPath());
 }
 
+const std::vector<Resolver::Attribute>&
+Resolver::GetAttributes(TypeId tid, const std::string& item)
+{
+    NS_LOG_FUNCTION(tid << item);
+    // the cache is outdated when an attribute is added to a type or a parent
+    // is set, as the name indexes of the IidManager
+    static NS_MTP_THREAD_LOCAL std::map<uint16_t, std::map<std::string, std::vector<Attribute>>>
+        cache;
+    static NS_MTP_THREAD_LOCAL uint32_t generation = 0;
+    if (generation != TypeId::GetGeneration())
+    {
+        cache.clear();
+        generation = TypeId::GetGeneration();
+    }
+    auto [it, inserted] = cache[tid.GetUid()].emplace(item, std::vector<Attribute>());
+    std::vector<Attribute>& attributes = it->second;
+    if (!inserted)
+    {
+        return attributes;
+    }
+
+    TypeId nextTid = tid;
+    do
+    {
+        tid = nextTid;
+
+        for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            TypeId::AttributeInformation info;
+            info = tid.GetAttribute(i);
+            if (info.name != item && item != "*")
+            {
+                continue;
+            }
+            Attribute attribute;
+            attribute.name = info.name;
+            // attempt to cast to a pointer checker.
+            if (dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr)
+            {
+                attribute.isPointer = true;
+            }
+            // attempt to cast to an object vector.
+            else if (dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) !=
+                     nullptr)
+            {
+                attribute.isPointer = false;
+            }
+            else
+            {
+                // this could be anything else and we don't know what to do with it.
+                // So, we just ignore it.
+                continue;
+            }
+            // Let ObjectBase::GetAttribute handle the deprecated
+            // and non gettable attributes
+            if (info.supportLevel == TypeId::SUPPORTED && (info.flags & TypeId::ATTR_GET) &&
+                info.accessor->HasGetter())
+            {
+                attribute.accessor = info.accessor;
+            }
+            attributes.push_back(attribute);
+        }
+
+        nextTid = tid.GetParent();
+    } while (nextTid != tid);
+    return attributes;
+}
+
+void
+Resolver::GetAttribute(Ptr<Object> object, const Attribute& attribute, AttributeValue& value)
+{
+    NS_LOG_FUNCTION(object << attribute.name << &value);
+    if (!attribute.accessor || !attribute.accessor->Get(PeekPointer(object), value))
+    {
+        object->GetAttribute(attribute.name, value);
+    }
+}
+
 void
-Resolver::DoResolve(std::string path, Ptr<Object> root)
+Resolver::DoResolve(std::size_t segment, Ptr<Object> root)
 {
-    NS_LOG_FUNCTION(this << path << root);
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
+    NS_LOG_FUNCTION(this << segment << root);
 
-    if (next == std::string::npos)
+    if (segment == m_segments.size())
     {
         //
         // If root is zero, we're beginning to see if we can use the object name
@@ -462,8 +678,7 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
         }
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    const CompiledPath::Segment& item = m_segments[segment];
 
     //
     // If root is zero, we're beginning to see if we can use the object name
@@ -472,16 +687,12 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     // the root of the "/Names" namespace, so we just ignore it and move on to
     // the next segment.
     //
-    if (!root)
+    if (!root && item.isNames)
     {
-        std::string::size_type offset = path.find("/Names");
-        if (offset == 0)
-        {
-            m_workStack.push_back(item);
-            DoResolve(pathLeft, root);
-            m_workStack.pop_back();
-            return;
-        }
+        m_workStack.push_back(item.item);
+        DoResolve(segment + 1, root);
+        m_workStack.pop_back();
+        return;
     }
 
     //
@@ -490,12 +701,12 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     // zero, this means to look in the root of the "/Names" name space, otherwise
     // it refers to a name space context (level).
     //
-    Ptr<Object> namedObject = Names::Find<Object>(root, item);
+    Ptr<Object> namedObject = Names::Find<Object>(root, item.item);
     if (namedObject)
     {
-        NS_LOG_DEBUG("Name system resolved item = " << item << " to " << namedObject);
-        m_workStack.push_back(item);
-        DoResolve(pathLeft, namedObject);
+        NS_LOG_DEBUG("Name system resolved item = " << item.item << " to " << namedObject);
+        m_workStack.push_back(item.item);
+        DoResolve(segment + 1, namedObject);
         m_workStack.pop_back();
         return;
     }
@@ -511,89 +722,62 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         return;
     }
-    std::string::size_type dollarPos = item.find('$');
-    if (dollarPos == 0)
+    if (item.isObject)
     {
         // This is a call to GetObject
-        std::string tidString = item.substr(1, item.size() - 1);
-        NS_LOG_DEBUG("GetObject=" << tidString << " on path=" << GetResolvedPath());
-        TypeId tid = TypeId::LookupByName(tidString);
+        NS_LOG_DEBUG("GetObject=" << item.tidName << " on path=" << GetResolvedPath());
+        TypeId tid = item.hasTid ? item.tid : TypeId::LookupByName(item.tidName);
         Ptr<Object> object = root->GetObject<Object>(tid);
         if (!object)
         {
-            NS_LOG_DEBUG("GetObject (" << tidString << ") failed on path=" << GetResolvedPath());
+            NS_LOG_DEBUG("GetObject (" << item.tidName
+                                       << ") failed on path=" << GetResolvedPath());
             return;
         }
-        m_workStack.push_back(item);
-        DoResolve(pathLeft, object);
+        m_workStack.push_back(item.item);
+        DoResolve(segment + 1, object);
         m_workStack.pop_back();
     }
     else
     {
         // this is a normal attribute.
-        TypeId tid;
-        TypeId nextTid = root->GetInstanceTypeId();
         bool foundMatch = false;
-
-        do
+        for (const auto& attribute : GetAttributes(root->GetInstanceTypeId(), item.item))
         {
-            tid = nextTid;
-
-            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            if (attribute.isPointer)
             {
-                TypeId::AttributeInformation info;
-                info = tid.GetAttribute(i);
-                if (info.name != item && item != "*")
+                NS_LOG_DEBUG("GetAttribute(ptr)=" << attribute.name
+                                                  << " on path=" << GetResolvedPath());
+                PointerValue pValue;
+                GetAttribute(root, attribute, pValue);
+                Ptr<Object> object = pValue.Get<Object>();
+                if (!object)
                 {
+                    NS_LOG_ERROR("Requested object name=\"" << item.item << "\" exists on path=\""
+                                                            << GetResolvedPath()
+                                                            << "\""
+                                                               " but is null.");
                     continue;
                 }
-                // attempt to cast to a pointer checker.
-                const auto pChecker =
-                    dynamic_cast<const PointerChecker*>(PeekPointer(info.checker));
-                if (pChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
-                                                      << " on path=" << GetResolvedPath());
-                    PointerValue pValue;
-                    root->GetAttribute(info.name, pValue);
-                    Ptr<Object> object = pValue.Get<Object>();
-                    if (!object)
-                    {
-                        NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
-                                                                << GetResolvedPath()
-                                                                << "\""
-                                                                   " but is null.");
-                        continue;
-                    }
-                    foundMatch = true;
-                    m_workStack.push_back(info.name);
-                    DoResolve(pathLeft, object);
-                    m_workStack.pop_back();
-                }
-                // attempt to cast to an object vector.
-                const auto vectorChecker =
-                    dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
-                if (vectorChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path="
-                                                         << GetResolvedPath() << pathLeft);
-                    foundMatch = true;
-                    ObjectPtrContainerValue vector;
-                    root->GetAttribute(info.name, vector);
-                    m_workStack.push_back(info.name);
-                    DoArrayResolve(pathLeft, vector);
-                    m_workStack.pop_back();
-                }
-                // this could be anything else and we don't know what to do with it.
-                // So, we just ignore it.
+                foundMatch = true;
+                m_workStack.push_back(attribute.name);
+                DoResolve(segment + 1, object);
+                m_workStack.pop_back();
             }
-
-            nextTid = tid.GetParent();
-        } while (nextTid != tid);
+            else
+            {
+                NS_LOG_DEBUG("GetAttribute(vector)=" << attribute.name
+                                                     << " on path=" << GetResolvedPath());
+                foundMatch = true;
+                m_workStack.push_back(attribute.name);
+                DoArrayResolve(segment + 1, root, attribute);
+                m_workStack.pop_back();
+            }
+        }
 
         if (!foundMatch)
         {
-            NS_LOG_DEBUG("Requested item=" << item
+            NS_LOG_DEBUG("Requested item=" << item.item
                                            << " does not exist on path=" << GetResolvedPath());
             return;
         }
@@ -601,20 +785,39 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& container)
+Resolver::DoArrayResolve(std::size_t segment, Ptr<Object> root, const Attribute& attribute)
 {
-    NS_LOG_FUNCTION(this << path << &container);
-    NS_ASSERT(!path.empty());
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-    if (next == std::string::npos)
+    NS_LOG_FUNCTION(this << segment << root << attribute.name);
+    if (segment == m_segments.size())
     {
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    const ArrayMatcher& matcher = m_segments[segment].matcher;
 
-    ArrayMatcher matcher = ArrayMatcher(item);
+    // Look up the few matching indices rather than getting all the objects
+    auto accessor = DynamicCast<const ObjectPtrContainerAccessor>(attribute.accessor);
+    std::size_t n;
+    if (accessor && !matcher.MatchesAll() && accessor->GetN(PeekPointer(root), &n) &&
+        matcher.GetCount() <= n)
+    {
+        for (const auto& range : matcher.GetRanges())
+        {
+            for (uint64_t index = range.first; index <= range.second; index++)
+            {
+                Ptr<Object> object;
+                if (accessor->Find(PeekPointer(root), index, &object))
+                {
+                    m_workStack.push_back(std::to_string(index));
+                    DoResolve(segment + 1, object);
+                    m_workStack.pop_back();
+                }
+            }
+        }
+        return;
+    }
+
+    ObjectPtrContainerValue container;
+    GetAttribute(root, attribute, container);
     ObjectPtrContainerValue::Iterator it;
     for (it = container.Begin(); it != container.End(); ++it)
     {
@@ -623,7 +826,7 @@ Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& contai
             std::ostringstream oss;
             oss << (*it).first;
             m_workStack.push_back(oss.str());
-            DoResolve(pathLeft, (*it).second);
+            DoResolve(segment + 1, (*it).second);
             m_workStack.pop_back();
         }
     }
@@ -636,22 +839,14 @@ Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& contai
 class ConfigImpl : public Singleton<ConfigImpl>
 {
   public:
-    // Keep Set and SetFailSafe since their errors are triggered
-    // by the underlying ObjectBase functions.
-    /** \copydoc ns3::Config::Set() */
-    void Set(std::string path, const AttributeValue& value);
-    /** \copydoc ns3::Config::SetFailSafe() */
-    bool SetFailSafe(std::string path, const AttributeValue& value);
-    /** \copydoc ns3::Config::ConnectWithoutContextFailSafe() */
-    bool ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb);
-    /** \copydoc ns3::Config::ConnectFailSafe() */
-    bool ConnectFailSafe(std::string path, const CallbackBase& cb);
-    /** \copydoc ns3::Config::DisconnectWithoutContext() */
-    void DisconnectWithoutContext(std::string path, const CallbackBase& cb);
-    /** \copydoc ns3::Config::Disconnect() */
-    void Disconnect(std::string path, const CallbackBase& cb);
-    /** \copydoc ns3::Config::LookupMatches() */
-    MatchContainer LookupMatches(std::string path);
+    /**
+     * Find the objects matching a parsed Config path.
+     *
+     * \param [in] segments The segments of the Config path.
+     * \param [in] path The Config path.
+     * \returns The matching objects.
+     */
+    MatchContainer LookupMatches(const Resolver::Segments& segments, std::string path);
 
     /** \copydoc ns3::Config::RegisterRootNamespaceObject() */
     void RegisterRootNamespaceObject(Ptr<Object> obj);
@@ -664,15 +859,6 @@ class ConfigImpl : public Singleton<ConfigImpl>
     Ptr<Object> GetRootNamespaceObject(std::size_t i) const;
 
   private:
-    /**
-     * Break a Config path into the leading path and the last leaf token.
-     * \param [in] path The Config path.
-     * \param [in,out] root The leading part of the \pname{path},
-     *   up to the final slash.
-     * \param [in,out] leaf The trailing part of the \pname{path}.
-     */
-    void ParsePath(std::string path, std::string* root, std::string* leaf) const;
-
     /** Container type to hold the root Config path tokens. */
     typedef std::vector<Ptr<Object>> Roots;
 
@@ -681,124 +867,41 @@ class ConfigImpl : public Singleton<ConfigImpl>
 
 }; // class ConfigImpl
 
-void
-ConfigImpl::ParsePath(std::string path, std::string* root, std::string* leaf) const
-{
-    NS_LOG_FUNCTION(this << path << root << leaf);
-
-    std::string::size_type slash = path.find_last_of('/');
-    NS_ASSERT(slash != std::string::npos);
-    *root = path.substr(0, slash);
-    *leaf = path.substr(slash + 1, path.size() - (slash + 1));
-    NS_LOG_FUNCTION(path << *root << *leaf);
-}
-
-void
-ConfigImpl::Set(std::string path, const AttributeValue& value)
-{
-    NS_LOG_FUNCTION(this << path << &value);
-
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    container.Set(leaf, value);
-}
-
-bool
-ConfigImpl::SetFailSafe(std::string path, const AttributeValue& value)
-{
-    NS_LOG_FUNCTION(this << path << &value);
-
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    return container.SetFailSafe(leaf, value);
-}
-
-bool
-ConfigImpl::ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb)
-{
-    NS_LOG_FUNCTION(this << path << &cb);
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    return container.ConnectWithoutContextFailSafe(leaf, cb);
-}
-
-void
-ConfigImpl::DisconnectWithoutContext(std::string path, const CallbackBase& cb)
+/**
+ * \ingroup config-impl
+ * Resolver collecting the objects matching a Config path.
+ */
+class LookupMatchesResolver : public Resolver
 {
-    NS_LOG_FUNCTION(this << path << &cb);
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    if (container.GetN() == 0)
+  public:
+    /**
+     * Construct from a parsed Config path.
+     *
+     * \param [in] segments The segments of the Config path.
+     * \param [in] context The path of the objects from which the
+     *             Config path is resolved.
+     */
+    LookupMatchesResolver(const Segments& segments, std::string context = "")
+        : Resolver(segments, context)
     {
-        std::size_t lastFwdSlash = root.rfind('/');
-        NS_LOG_WARN("Failed to disconnect "
-                    << leaf << ", the Requested object name = " << root.substr(lastFwdSlash + 1)
-                    << " does not exits on path " << root.substr(0, lastFwdSlash));
     }
-    container.DisconnectWithoutContext(leaf, cb);
-}
 
-bool
-ConfigImpl::ConnectFailSafe(std::string path, const CallbackBase& cb)
-{
-    NS_LOG_FUNCTION(this << path << &cb);
-
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    return container.ConnectFailSafe(leaf, cb);
-}
-
-void
-ConfigImpl::Disconnect(std::string path, const CallbackBase& cb)
-{
-    NS_LOG_FUNCTION(this << path << &cb);
-
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    if (container.GetN() == 0)
+    void DoOne(Ptr<Object> object, std::string path) override
     {
-        std::size_t lastFwdSlash = root.rfind('/');
-        NS_LOG_WARN("Failed to disconnect "
-                    << leaf << ", the Requested object name = " << root.substr(lastFwdSlash + 1)
-                    << " does not exits on path " << root.substr(0, lastFwdSlash));
+        m_objects.push_back(object);
+        m_contexts.push_back(path);
     }
-    container.Disconnect(leaf, cb);
-}
+
+    std::vector<Ptr<Object>> m_objects;  //!< The matching objects.
+    std::vector<std::string> m_contexts; //!< The paths of the matching objects.
+};
 
 MatchContainer
-ConfigImpl::LookupMatches(std::string path)
+ConfigImpl::LookupMatches(const Resolver::Segments& segments, std::string path)
 {
     NS_LOG_FUNCTION(this << path);
 
-    class LookupMatchesResolver : public Resolver
-    {
-      public:
-        LookupMatchesResolver(std::string path)
-            : Resolver(path)
-        {
-        }
-
-        void DoOne(Ptr<Object> object, std::string path) override
-        {
-            m_objects.push_back(object);
-            m_contexts.push_back(path);
-        }
-
-        std::vector<Ptr<Object>> m_objects;
-        std::vector<std::string> m_contexts;
-    } resolver = LookupMatchesResolver(path);
+    LookupMatchesResolver resolver(segments);
 
     for (auto i = m_roots.begin(); i != m_roots.end(); i++)
     {
@@ -851,6 +954,191 @@ ConfigImpl::GetRootNamespaceObject(std::size_t i) const
     return m_roots[i];
 }
 
+CompiledPath::CompiledPath()
+    : CompiledPath("/")
+{
+}
+
+CompiledPath::CompiledPath(std::string path)
+    : m_path(path),
+      m_segments(Parse(path))
+{
+    NS_LOG_FUNCTION(this << path);
+
+    // Break the path into the leading path and the last leaf token
+    std::string::size_type slash = path.find_last_of('/');
+    if (slash != std::string::npos)
+    {
+        m_root = path.substr(0, slash);
+        m_leaf = path.substr(slash + 1, path.size() - (slash + 1));
+    }
+    else
+    {
+        m_leaf = path;
+    }
+    m_rootSegments = Parse(m_root);
+    NS_LOG_LOGIC(path << " " << m_root << " " << m_leaf);
+}
+
+CompiledPath::CompiledPath(const CompiledPath& o) = default;
+
+CompiledPath&
+CompiledPath::operator=(const CompiledPath& o) = default;
+
+CompiledPath::~CompiledPath() = default;
+
+std::vector<CompiledPath::Segment>
+CompiledPath::Parse(std::string path)
+{
+    NS_LOG_FUNCTION(path);
+
+    // ensure that we start and end with a '/'
+    std::string::size_type tmp = path.find('/');
+    if (tmp != 0)
+    {
+        // no slash at start
+        path = "/" + path;
+    }
+    tmp = path.find_last_of('/');
+    if (tmp != (path.size() - 1))
+    {
+        // no slash at end
+        path = path + "/";
+    }
+
+    std::vector<Segment> segments;
+    std::string::size_type slash = 0;
+    std::string::size_type next;
+    while ((next = path.find('/', slash + 1)) != std::string::npos)
+    {
+        segments.emplace_back(path.substr(slash + 1, next - (slash + 1)));
+        slash = next;
+    }
+    return segments;
+}
+
+std::string
+CompiledPath::GetPath() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_path;
+}
+
+MatchContainer
+CompiledPath::LookupMatches() const
+{
+    NS_LOG_FUNCTION(this);
+    return ConfigImpl::Get()->LookupMatches(m_segments, m_path);
+}
+
+MatchContainer
+CompiledPath::LookupMatches(const std::vector<Ptr<Object>>& roots,
+                            const std::vector<std::string>& contexts) const
+{
+    NS_LOG_FUNCTION(this << roots.size());
+    NS_ASSERT(roots.size() == contexts.size());
+    std::vector<Ptr<Object>> objects;
+    std::vector<std::string> matchedContexts;
+    for (std::size_t i = 0; i < roots.size(); i++)
+    {
+        LookupMatchesResolver resolver(m_segments, contexts[i]);
+        resolver.Resolve(roots[i]);
+        objects.insert(objects.end(), resolver.m_objects.begin(), resolver.m_objects.end());
+        matchedContexts.insert(matchedContexts.end(),
+                               resolver.m_contexts.begin(),
+                               resolver.m_contexts.end());
+    }
+    return MatchContainer(objects, matchedContexts, m_path);
+}
+
+MatchContainer
+CompiledPath::LookupLeafMatches() const
+{
+    NS_LOG_FUNCTION(this);
+    return ConfigImpl::Get()->LookupMatches(m_rootSegments, m_root);
+}
+
+void
+CompiledPath::Set(const AttributeValue& value) const
+{
+    NS_LOG_FUNCTION(this << &value);
+    LookupLeafMatches().Set(m_leaf, value);
+}
+
+bool
+CompiledPath::SetFailSafe(const AttributeValue& value) const
+{
+    NS_LOG_FUNCTION(this << &value);
+    return LookupLeafMatches().SetFailSafe(m_leaf, value);
+}
+
+void
+CompiledPath::Connect(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    if (!ConnectFailSafe(cb))
+    {
+        NS_FATAL_ERROR("Could not connect callback to " << m_path);
+    }
+}
+
+bool
+CompiledPath::ConnectFailSafe(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    return LookupLeafMatches().ConnectFailSafe(m_leaf, cb);
+}
+
+void
+CompiledPath::ConnectWithoutContext(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    if (!ConnectWithoutContextFailSafe(cb))
+    {
+        NS_FATAL_ERROR("Could not connect callback to " << m_path);
+    }
+}
+
+bool
+CompiledPath::ConnectWithoutContextFailSafe(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    return LookupLeafMatches().ConnectWithoutContextFailSafe(m_leaf, cb);
+}
+
+void
+CompiledPath::WarnDisconnect() const
+{
+    std::size_t lastFwdSlash = m_root.rfind('/');
+    NS_LOG_WARN("Failed to disconnect "
+                << m_leaf << ", the Requested object name = " << m_root.substr(lastFwdSlash + 1)
+                << " does not exits on path " << m_root.substr(0, lastFwdSlash));
+}
+
+void
+CompiledPath::Disconnect(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    MatchContainer container = LookupLeafMatches();
+    if (container.GetN() == 0)
+    {
+        WarnDisconnect();
+    }
+    container.Disconnect(m_leaf, cb);
+}
+
+void
+CompiledPath::DisconnectWithoutContext(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    MatchContainer container = LookupLeafMatches();
+    if (container.GetN() == 0)
+    {
+        WarnDisconnect();
+    }
+    container.DisconnectWithoutContext(m_leaf, cb);
+}
+
 void
 Reset()
 {
@@ -876,14 +1164,14 @@ void
 Set(std::string path, const AttributeValue& value)
 {
     NS_LOG_FUNCTION(path << &value);
-    ConfigImpl::Get()->Set(path, value);
+    CompiledPath(path).Set(value);
 }
 
 bool
 SetFailSafe(std::string path, const AttributeValue& value)
 {
     NS_LOG_FUNCTION(path << &value);
-    return ConfigImpl::Get()->SetFailSafe(path, value);
+    return CompiledPath(path).SetFailSafe(value);
 }
 
 void
@@ -960,14 +1248,14 @@ bool
 ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(path << &cb);
-    return ConfigImpl::Get()->ConnectWithoutContextFailSafe(path, cb);
+    return CompiledPath(path).ConnectWithoutContextFailSafe(cb);
 }
 
 void
 DisconnectWithoutContext(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(path << &cb);
-    ConfigImpl::Get()->DisconnectWithoutContext(path, cb);
+    CompiledPath(path).DisconnectWithoutContext(cb);
 }
 
 void
@@ -984,21 +1272,21 @@ bool
 ConnectFailSafe(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(path << &cb);
-    return ConfigImpl::Get()->ConnectFailSafe(path, cb);
+    return CompiledPath(path).ConnectFailSafe(cb);
 }
 
 void
 Disconnect(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(path << &cb);
-    ConfigImpl::Get()->Disconnect(path, cb);
+    CompiledPath(path).Disconnect(cb);
 }
 
 MatchContainer
 LookupMatches(std::string path)
 {
     NS_LOG_FUNCTION(path);
-    return ConfigImpl::Get()->LookupMatches(path);
+    return CompiledPath(path).LookupMatches();
 }
 
 void
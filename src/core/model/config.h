@@ -361,6 +361,154 @@ class MatchContainer
  */
 MatchContainer LookupMatches(std::string path);
 
+/**
+ * \ingroup config
+ * \brief A Config path parsed once, to be resolved many times.
+ *
+ * The Config functions parse their path on each call. A CompiledPath
+ * parses it when it is constructed, including the array specifications
+ * (e.g., \c "[0-3]|7") and the TypeId of the \c "$" segments, so setting
+ * up the same attributes or trace sinks repeatedly, or relative to many
+ * objects, only pays for the traversal of the objects:
+ *
+ * \code
+ *   Config::CompiledPath path("DeviceList/0/$ns3::PointToPointNetDevice/MacTx");
+ *   for (uint32_t i = 0; i < nodes.GetN(); i++)
+ *   {
+ *       std::ostringstream oss;
+ *       oss << "/NodeList/" << nodes.Get(i)->GetId();
+ *       path.LookupMatches({nodes.Get(i)}, {oss.str()}).ConnectWithoutContext(...);
+ *   }
+ * \endcode
+ *
+ * The array specifications which select a few indices (e.g.,
+ * \c "/NodeList/7") are resolved by looking up these indices only,
+ * rather than by going through the whole container, so that wiring the
+ * nodes one by one costs O(nodes) instead of O(nodes^2).
+ */
+class CompiledPath
+{
+  public:
+    /** Default constructor: the root path. */
+    CompiledPath();
+    /**
+     * Parse a Config path.
+     *
+     * \param [in] path The Config path.
+     */
+    CompiledPath(std::string path);
+    /**
+     * Copy constructor.
+     * \param [in] o The other path.
+     */
+    CompiledPath(const CompiledPath& o);
+    /**
+     * Copy assignment.
+     * \param [in] o The other path.
+     * \returns This path.
+     */
+    CompiledPath& operator=(const CompiledPath& o);
+    /** Destructor. */
+    ~CompiledPath();
+
+    /** \returns The Config path, as given to the constructor. */
+    std::string GetPath() const;
+
+    /**
+     * \returns A container of all the objects which match the path,
+     *          as Config::LookupMatches().
+     */
+    MatchContainer LookupMatches() const;
+    /**
+     * Resolve the path relative to some objects instead of the root
+     * namespace objects and the Names.
+     *
+     * \param [in] roots The objects from which the path is resolved.
+     * \param [in] contexts The path of each of the \pname{roots},
+     *             which prefixes the matched paths of its objects.
+     * \returns A container of all the objects which match the path.
+     */
+    MatchContainer LookupMatches(const std::vector<Ptr<Object>>& roots,
+                                 const std::vector<std::string>& contexts) const;
+
+    /**
+     * \param [in] value The value to set in all matching attributes.
+     * \sa Config::Set
+     */
+    void Set(const AttributeValue& value) const;
+    /**
+     * \param [in] value The value to set in all matching attributes.
+     * \return \c true if any matching attributes could be set.
+     * \sa Config::SetFailSafe
+     */
+    bool SetFailSafe(const AttributeValue& value) const;
+    /**
+     * \param [in] cb The callback to connect to the matching trace sources.
+     * \sa Config::Connect
+     */
+    void Connect(const CallbackBase& cb) const;
+    /**
+     * \param [in] cb The callback to connect to the matching trace sources.
+     * \returns \c true if any trace sources could be connected.
+     * \sa Config::ConnectFailSafe
+     */
+    bool ConnectFailSafe(const CallbackBase& cb) const;
+    /**
+     * \param [in] cb The callback to connect to the matching trace sources.
+     * \sa Config::ConnectWithoutContext
+     */
+    void ConnectWithoutContext(const CallbackBase& cb) const;
+    /**
+     * \param [in] cb The callback to connect to the matching trace sources.
+     * \returns \c true if any trace sources could be connected.
+     * \sa Config::ConnectWithoutContextFailSafe
+     */
+    bool ConnectWithoutContextFailSafe(const CallbackBase& cb) const;
+    /**
+     * \param [in] cb The callback to disconnect from the matching trace sources.
+     * \sa Config::Disconnect
+     */
+    void Disconnect(const CallbackBase& cb) const;
+    /**
+     * \param [in] cb The callback to disconnect from the matching trace sources.
+     * \sa Config::DisconnectWithoutContext
+     */
+    void DisconnectWithoutContext(const CallbackBase& cb) const;
+
+  private:
+    /** Resolver needs the segments. */
+    friend class Resolver;
+    /** ConfigImpl needs the segments. */
+    friend class ConfigImpl;
+
+    /** A parsed segment of the path, defined in config.cc. */
+    struct Segment;
+
+    /**
+     * Parse a path into its segments.
+     *
+     * \param [in] path The path.
+     * \returns The segments.
+     */
+    static std::vector<Segment> Parse(std::string path);
+
+    /**
+     * Get the objects matching all the segments of the path but the
+     * last one, the name of the attribute or trace source.
+     *
+     * \returns The matching objects.
+     */
+    MatchContainer LookupLeafMatches() const;
+    /** Log a warning if there are no objects from which to disconnect. */
+    void WarnDisconnect() const;
+
+    std::string m_path;                  //!< The path.
+    std::vector<Segment> m_segments;     //!< The segments of the path.
+    std::string m_root;                  //!< The path up to the last '/'.
+    std::vector<Segment> m_rootSegments; //!< The segments of \c m_root.
+    std::string m_leaf;                  //!< The name following the last '/'.
+};
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
@@ -20,11 +20,15 @@
 #include "default-simulator-impl.h"
 
 #include "assert.h"
+#include "event-profiler.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
+#include "uinteger.h"
 
 #include <cmath>
+#include <fstream>
 
 /**
  * \file
@@ -45,10 +49,31 @@ NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
-                            .SetParent<SimulatorImpl>()
-                            .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+    static TypeId tid =
+        TypeId("ns3::DefaultSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<DefaultSimulatorImpl>()
+            .AddAttribute("EventProfileReport",
+                          "If not empty, profile the wall clock time of the events, "
+                          "and write the report sorted by event kind to this file "
+                          "when the simulator is destroyed.",
+                          StringValue(""),
+                          MakeStringAccessor(&DefaultSimulatorImpl::m_profileReport),
+                          MakeStringChecker())
+            .AddAttribute("EventProfileTrace",
+                          "If not empty, profile the wall clock time of the events, "
+                          "and write the invocations in the Chrome trace event format "
+                          "to this file when the simulator is destroyed.",
+                          StringValue(""),
+                          MakeStringAccessor(&DefaultSimulatorImpl::m_profileTrace),
+                          MakeStringChecker())
+            .AddAttribute("EventProfileTraceLimit",
+                          "The maximum number of event invocations written to the "
+                          "EventProfileTrace file.",
+                          UintegerValue(1000000),
+                          MakeUintegerAccessor(&DefaultSimulatorImpl::m_profileTraceLimit),
+                          MakeUintegerChecker<uint64_t>());
     return tid;
 }
 
@@ -83,6 +108,7 @@ DefaultSimulatorImpl::DoDispose()
         next.impl->Unref();
     }
     m_events = nullptr;
+    m_profiler.reset();
     SimulatorImpl::DoDispose();
 }
 
@@ -100,6 +126,22 @@ DefaultSimulatorImpl::Destroy()
             ev->Invoke();
         }
     }
+
+    if (m_profiler)
+    {
+        if (!m_profileReport.empty())
+        {
+            std::ofstream os(m_profileReport);
+            m_profiler->Report(os);
+            os << std::endl;
+            m_profiler->Report(os, true);
+        }
+        if (!m_profileTrace.empty())
+        {
+            std::ofstream os(m_profileTrace);
+            m_profiler->WriteChromeTrace(os);
+        }
+    }
 }
 
 void
@@ -141,7 +183,17 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_profiler)
+    {
+        uint32_t uid = m_uid;
+        m_profiler->BeginEvent();
+        next.impl->Invoke();
+        m_profiler->EndEvent(next.impl, m_currentContext, m_currentTs, m_uid - uid);
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -191,6 +243,10 @@ DefaultSimulatorImpl::Run()
     m_mainThreadId = std::this_thread::get_id();
     ProcessEventsWithContext();
     m_stop = false;
+    if (!m_profiler && !(m_profileReport.empty() && m_profileTrace.empty()))
+    {
+        m_profiler = std::make_unique<EventProfiler>(m_profileTraceLimit);
+    }
 
     while (!m_events->IsEmpty() && !m_stop)
     {
@@ -391,6 +447,12 @@ DefaultSimulatorImpl::GetContext() const
     return m_currentContext;
 }
 
+const EventProfiler*
+DefaultSimulatorImpl::GetEventProfiler() const
+{
+    return m_profiler.get();
+}
+
 uint64_t
 DefaultSimulatorImpl::GetEventCount() const
 {
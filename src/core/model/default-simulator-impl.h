@@ -23,6 +23,7 @@
 #include "simulator-impl.h"
 
 #include <list>
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -36,12 +37,17 @@ namespace ns3
 {
 
 // Forward
+class EventProfiler;
 class Scheduler;
 
 /**
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * The wall clock time spent in the events can be attributed to the
+ * functions they invoke by an EventProfiler, which is enabled by
+ * the \c EventProfileReport or \c EventProfileTrace attributes.
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -78,6 +84,13 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
 
+    /**
+     * Get the event profiler.
+     *
+     * \returns The profiler, or \c nullptr if the events are not profiled.
+     */
+    const EventProfiler* GetEventProfiler() const;
+
   private:
     void DoDispose() override;
 
@@ -136,6 +149,15 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /** The event profiler, created by Run() if the events are profiled. */
+    std::unique_ptr<EventProfiler> m_profiler;
+    /** The file name of the event profile report. */
+    std::string m_profileReport;
+    /** The file name of the event profile Chrome trace. */
+    std::string m_profileTrace;
+    /** The maximum number of events in the event profile Chrome trace. */
+    uint64_t m_profileTraceLimit;
 };
 
 } // namespace ns3
@@ -21,6 +21,9 @@
 
 #include "log.h"
 
+#include <algorithm>
+#include <new>
+
 /**
  * \file
  * \ingroup events
@@ -32,6 +35,126 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+namespace
+{
+
+/**
+ * \ingroup events
+ * The free lists of the EventImpl memory, one per size class.
+ *
+ * The members are zero-initialized before any dynamic initialization,
+ * so events can be created by the static constructors of other
+ * translation units. Each free list keeps at most \c MAX_BLOCKS blocks,
+ * so the lists of a thread which deletes the events created by another
+ * thread do not grow without bound.
+ */
+struct EventImplFreeLists
+{
+    /** A block of free memory, linked to the next block of its size class. */
+    struct Block
+    {
+        Block* next; //!< The next free block.
+    };
+
+    /** The granularity of the size classes. */
+    static constexpr std::size_t GRANULARITY = 16;
+    /** The number of size classes. */
+    static constexpr std::size_t CLASSES = 16;
+    /** The maximum number of free blocks of each size class. */
+    static constexpr uint32_t MAX_BLOCKS = 1024;
+
+    /**
+     * Get the size class of an object.
+     *
+     * \param [in] size The size of the object.
+     * \return The size class, or \c CLASSES if the object is too big.
+     */
+    static std::size_t GetClass(std::size_t size)
+    {
+        return size == 0 ? 0 : std::min((size - 1) / GRANULARITY, CLASSES);
+    }
+
+    /** Release the free memory. */
+    ~EventImplFreeLists();
+
+    Block* m_heads[CLASSES];    //!< The free blocks of each size class.
+    uint32_t m_counts[CLASSES]; //!< The number of free blocks of each size class.
+};
+
+/**
+ * The free lists of the calling thread. Events can be created by any
+ * thread, through Simulator::ScheduleWithContext(), so the free lists
+ * are thread-local even without NS3_MTP.
+ */
+thread_local EventImplFreeLists g_eventImplFreeLists;
+
+/**
+ * Whether the free lists of the calling thread have been released, after
+ * which the memory of the events, e.g. of the events released by static
+ * destructors, goes back to the global allocator. It is kept out of
+ * EventImplFreeLists since the members of a destroyed object cannot be read.
+ */
+thread_local bool g_eventImplFreeListsDestroyed = false;
+
+EventImplFreeLists::~EventImplFreeLists()
+{
+    for (auto& head : m_heads)
+    {
+        while (head != nullptr)
+        {
+            Block* block = head;
+            head = head->next;
+            ::operator delete(block);
+        }
+    }
+    g_eventImplFreeListsDestroyed = true;
+}
+
+} // unnamed namespace
+
+void*
+EventImpl::operator new(std::size_t size)
+{
+    std::size_t sizeClass = EventImplFreeLists::GetClass(size);
+    if (sizeClass == EventImplFreeLists::CLASSES || g_eventImplFreeListsDestroyed)
+    {
+        return ::operator new(size);
+    }
+    EventImplFreeLists::Block*& head = g_eventImplFreeLists.m_heads[sizeClass];
+    if (head == nullptr)
+    {
+        // allocate the whole size class, so the block can be reused by any event of the class
+        return ::operator new((sizeClass + 1) * EventImplFreeLists::GRANULARITY);
+    }
+    EventImplFreeLists::Block* block = head;
+    head = head->next;
+    g_eventImplFreeLists.m_counts[sizeClass]--;
+    return block;
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    if (p == nullptr)
+    {
+        return;
+    }
+    std::size_t sizeClass = EventImplFreeLists::GetClass(size);
+    if (sizeClass == EventImplFreeLists::CLASSES || g_eventImplFreeListsDestroyed ||
+        g_eventImplFreeLists.m_counts[sizeClass] == EventImplFreeLists::MAX_BLOCKS)
+    {
+        ::operator delete(p);
+        return;
+    }
+    // The event may have been allocated by another thread:
+    // the block just migrates to the free list of this thread.
+    auto block = static_cast<EventImplFreeLists::Block*>(p);
+    EventImplFreeLists::Block*& head = g_eventImplFreeLists.m_heads[sizeClass];
+    block->next = head;
+    head = block;
+    g_eventImplFreeLists.m_counts[sizeClass]++;
+}
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
@@ -67,4 +190,10 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+uint64_t
+EventImpl::GetFunctionId() const
+{
+    return 0;
+}
+
 } // namespace ns3
@@ -19,8 +19,10 @@
 #ifndef EVENT_IMPL_H
 #define EVENT_IMPL_H
 
+#include "multithreading.h"
 #include "simple-ref-count.h"
 
+#include <cstddef>
 #include <stdint.h>
 
 /**
@@ -41,6 +43,11 @@ namespace ns3
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The memory of the events, including the arguments bound by MakeEvent(),
+ * is recycled through free lists of size classes of 16 bytes, up to
+ * 256 bytes, instead of going through the global allocator for each event.
+ * The free lists are private to each thread, and bounded.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -66,6 +73,30 @@ class EventImpl : public SimpleRefCount<EventImpl>
      * Checked by the simulation engine before calling Invoke().
      */
     bool IsCancelled();
+    /**
+     * Get an identifier of the function or method invoked by this event,
+     * which tells apart the events of the same type bound to different
+     * functions, e.g. for profiling.
+     *
+     * \returns The address of the function, the first word of the
+     *          member function pointer, or zero if unknown.
+     */
+    virtual uint64_t GetFunctionId() const;
+
+    /**
+     * Allocate the memory of an event from the free list of its size class.
+     *
+     * \param [in] size The size of the event object.
+     * \returns The memory of the event.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Return the memory of an event to the free list of its size class.
+     *
+     * \param [in] p The memory of the event.
+     * \param [in] size The size of the event object.
+     */
+    static void operator delete(void* p, std::size_t size);
 
   protected:
     /**
@@ -77,7 +108,11 @@ class EventImpl : public SimpleRefCount<EventImpl>
     virtual void Notify() = 0;
 
   private:
-    bool m_cancel; /**< Has this event been cancelled. */
+    /**
+     * Has this event been cancelled. The events without context can be
+     * cancelled by the threads of several partitions.
+     */
+    MtpAtomic<bool> m_cancel;
 };
 
 } // namespace ns3
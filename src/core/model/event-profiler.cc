@@ -0,0 +1,310 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-profiler.h"
+
+#include "event-impl.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dlfcn.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfiler");
+
+namespace
+{
+
+/**
+ * \ingroup simulator
+ * Demangle a C++ symbol or type name.
+ *
+ * \param [in] mangled The mangled name.
+ * \returns The demangled name, or \p mangled if it can't be demangled.
+ */
+std::string
+EventProfilerDemangle(const char* mangled)
+{
+    std::string ret = mangled;
+#if (__GNUC__ >= 3)
+    int status;
+    char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    if (status == 0)
+    {
+        ret = demangled;
+    }
+    std::free(demangled);
+#endif
+    return ret;
+}
+
+/**
+ * \ingroup simulator
+ * Escape a string for a JSON document.
+ *
+ * \param [in] s The string.
+ * \returns The escaped string.
+ */
+std::string
+EventProfilerJsonEscape(const std::string& s)
+{
+    std::string ret;
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+        {
+            ret += '\\';
+        }
+        ret += c;
+    }
+    return ret;
+}
+
+} // unnamed namespace
+
+EventProfiler::EventProfiler(uint64_t traceLimit)
+    : m_origin(Clock::now()),
+      m_start(m_origin),
+      m_traceLimit(traceLimit)
+{
+    NS_LOG_FUNCTION(this << traceLimit);
+}
+
+std::size_t
+EventProfiler::KeyHash::operator()(const Key& key) const
+{
+    std::size_t h = key.type.hash_code();
+    h ^= std::hash<uint64_t>()(key.function) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<uint32_t>()(key.context) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+void
+EventProfiler::BeginEvent()
+{
+    m_start = Clock::now();
+}
+
+void
+EventProfiler::EndEvent(const EventImpl* event, uint32_t context, uint64_t ts, uint64_t fanOut)
+{
+    Clock::time_point end = Clock::now();
+    auto durNs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_start).count());
+
+    Key key{std::type_index(typeid(*event)), event->GetFunctionId(), context};
+    auto [it, inserted] = m_keys.emplace(key, m_kinds.size());
+    if (inserted)
+    {
+        m_kindKeys.push_back(key);
+        m_kinds.push_back(Stats{"", context, 0, 0, 0, 0});
+    }
+    Stats& stats = m_kinds[it->second];
+    stats.count++;
+    stats.totalNs += durNs;
+    stats.maxNs = std::max(stats.maxNs, durNs);
+    stats.fanOut += fanOut;
+
+    if (m_invocations.size() < m_traceLimit)
+    {
+        auto startNs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(m_start - m_origin).count());
+        m_invocations.push_back(Invocation{startNs, durNs, ts, fanOut, it->second});
+    }
+}
+
+std::string
+EventProfiler::GetName(const Key& key)
+{
+#if defined(__unix__) || defined(__APPLE__)
+    if (key.function != 0)
+    {
+        // Functions and non virtual methods: look for the symbol at this address
+        Dl_info info;
+        auto address = reinterpret_cast<void*>(key.function);
+        if (dladdr(address, &info) != 0 && info.dli_sname != nullptr &&
+            info.dli_saddr == address)
+        {
+            return EventProfilerDemangle(info.dli_sname);
+        }
+    }
+#endif
+
+    // Otherwise use the MakeEvent template arguments, which name the
+    // class and signature of a method, or the function enclosing a lambda
+    std::string name = EventProfilerDemangle(key.type.name());
+    std::string::size_type begin = name.find("MakeEvent<");
+    if (begin != std::string::npos)
+    {
+        int depth = 0;
+        for (std::string::size_type i = begin + 9; i < name.size(); i++)
+        {
+            if (name[i] == '<')
+            {
+                depth++;
+            }
+            else if (name[i] == '>' && --depth == 0)
+            {
+                name = name.substr(begin, i + 1 - begin);
+                break;
+            }
+        }
+    }
+    if (key.function != 0)
+    {
+        // e.g. a virtual method, identified by its vtable offset
+        std::ostringstream oss;
+        oss << name << " #" << std::hex << key.function;
+        name = oss.str();
+    }
+    return name;
+}
+
+std::vector<EventProfiler::Stats>
+EventProfiler::GetStats(bool byContext) const
+{
+    NS_LOG_FUNCTION(this << byContext);
+    std::vector<Stats> stats;
+    std::map<std::string, std::size_t> byName;
+    for (std::size_t i = 0; i < m_kinds.size(); i++)
+    {
+        Stats kind = m_kinds[i];
+        kind.name = GetName(m_kindKeys[i]);
+        if (byContext)
+        {
+            stats.push_back(kind);
+            continue;
+        }
+        auto [it, inserted] = byName.emplace(kind.name, stats.size());
+        if (inserted)
+        {
+            kind.context = Simulator::NO_CONTEXT;
+            stats.push_back(kind);
+        }
+        else
+        {
+            Stats& merged = stats[it->second];
+            merged.count += kind.count;
+            merged.totalNs += kind.totalNs;
+            merged.maxNs = std::max(merged.maxNs, kind.maxNs);
+            merged.fanOut += kind.fanOut;
+        }
+    }
+    std::stable_sort(stats.begin(), stats.end(), [](const Stats& a, const Stats& b) {
+        return a.totalNs > b.totalNs;
+    });
+    return stats;
+}
+
+void
+EventProfiler::Report(std::ostream& os, bool byContext) const
+{
+    NS_LOG_FUNCTION(this << byContext);
+    std::vector<Stats> stats = GetStats(byContext);
+    uint64_t totalNs = 0;
+    uint64_t count = 0;
+    for (const auto& kind : stats)
+    {
+        totalNs += kind.totalNs;
+        count += kind.count;
+    }
+
+    std::ios_base::fmtflags flags = os.flags();
+    os << "Event profile: " << count << " events, " << totalNs * 1e-9 << " s" << std::endl;
+    os << std::setw(12) << "Total (s)" << std::setw(8) << "%" << std::setw(12) << "Count"
+       << std::setw(12) << "Mean (us)" << std::setw(12) << "Max (us)" << std::setw(10)
+       << "Fan-out";
+    if (byContext)
+    {
+        os << std::setw(12) << "Context";
+    }
+    os << "  Event" << std::endl;
+    os << std::fixed;
+    for (const auto& kind : stats)
+    {
+        os << std::setprecision(6) << std::setw(12) << kind.totalNs * 1e-9 << std::setprecision(2)
+           << std::setw(8) << (totalNs ? 100.0 * kind.totalNs / totalNs : 0.0) << std::setw(12)
+           << kind.count << std::setprecision(3) << std::setw(12)
+           << kind.totalNs * 1e-3 / kind.count << std::setw(12) << kind.maxNs * 1e-3
+           << std::setprecision(2) << std::setw(10)
+           << static_cast<double>(kind.fanOut) / kind.count;
+        if (byContext)
+        {
+            os << std::setw(12);
+            if (kind.context == Simulator::NO_CONTEXT)
+            {
+                os << "-";
+            }
+            else
+            {
+                os << kind.context;
+            }
+        }
+        os << "  " << kind.name << std::endl;
+    }
+    os.flags(flags);
+}
+
+void
+EventProfiler::WriteChromeTrace(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<std::string> names;
+    names.reserve(m_kindKeys.size());
+    for (const auto& key : m_kindKeys)
+    {
+        names.push_back(EventProfilerJsonEscape(GetName(key)));
+    }
+
+    std::ios_base::fmtflags flags = os.flags();
+    os << std::fixed << std::setprecision(3);
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" << std::endl;
+    bool first = true;
+    for (const auto& invocation : m_invocations)
+    {
+        uint32_t context = m_kinds[invocation.kind].context;
+        os << (first ? "" : ",\n") << "{\"name\":\"" << names[invocation.kind]
+           << "\",\"cat\":\"event\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+           << (context == Simulator::NO_CONTEXT ? -1 : static_cast<int64_t>(context))
+           << ",\"ts\":" << invocation.startNs * 1e-3 << ",\"dur\":" << invocation.durNs * 1e-3
+           << ",\"args\":{\"time\":" << invocation.ts << ",\"fanout\":" << invocation.fanOut
+           << "}}";
+        first = false;
+    }
+    os << std::endl << "]}" << std::endl;
+    os.flags(flags);
+}
+
+} // namespace ns3
@@ -0,0 +1,183 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <chrono>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ * \ingroup debugging
+ *
+ * Attribute the wall clock time of the simulation to the event kinds.
+ *
+ * The kind of an event is the function or method bound to it by
+ * MakeEvent() (the EventImpl type, together with
+ * EventImpl::GetFunctionId()), and the context (usually the node id)
+ * in which it runs. For each kind the profiler records the number of
+ * invocations, the total and maximum wall clock time of the invocations,
+ * and the number of events scheduled by the invocations (the fan-out).
+ *
+ * The profiler is driven by the simulator implementation, which calls
+ * BeginEvent() and EndEvent() around each event it invokes. It is
+ * enabled in the DefaultSimulatorImpl by the \c EventProfileReport and
+ * \c EventProfileTrace attributes:
+ *
+ * \code
+ *   $ ./ns3 run "lena-simple-epc --ns3::DefaultSimulatorImpl::EventProfileReport=profile.txt"
+ * \endcode
+ *
+ * The names of the kinds are resolved when the results are written:
+ * functions and non virtual methods are named after their symbol when
+ * it is found in the dynamic symbol tables, otherwise after the
+ * MakeEvent() template instantiation (which names the class and the
+ * signature of the method, or the function enclosing a lambda).
+ */
+class EventProfiler
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] traceLimit The maximum number of invocations kept for WriteChromeTrace().
+     */
+    EventProfiler(uint64_t traceLimit = 1000000);
+
+    /** Start timing the invocation of an event. */
+    void BeginEvent();
+    /**
+     * Record the invocation of an event started by BeginEvent().
+     *
+     * \param [in] event The event.
+     * \param [in] context The context of the event.
+     * \param [in] ts The simulation time of the event, in time steps.
+     * \param [in] fanOut The number of events scheduled by the invocation.
+     */
+    void EndEvent(const EventImpl* event, uint32_t context, uint64_t ts, uint64_t fanOut);
+
+    /** The statistics of an event kind. */
+    struct Stats
+    {
+        std::string name; //!< The name of the function invoked.
+        uint32_t context; //!< The context of the events.
+        uint64_t count;   //!< The number of invocations.
+        uint64_t totalNs; //!< The total wall clock time, in ns.
+        uint64_t maxNs;   //!< The maximum wall clock time of an invocation, in ns.
+        uint64_t fanOut;  //!< The number of events scheduled by the invocations.
+    };
+
+    /**
+     * Get the statistics of the event kinds, sorted by decreasing total time.
+     *
+     * \param [in] byContext Whether to tell apart the events of different contexts.
+     * \returns The statistics of each kind.
+     */
+    std::vector<Stats> GetStats(bool byContext) const;
+    /**
+     * Write a report of the event kinds, sorted by decreasing total time.
+     *
+     * \param [in] os The output stream.
+     * \param [in] byContext Whether to tell apart the events of different contexts.
+     */
+    void Report(std::ostream& os, bool byContext = false) const;
+    /**
+     * Write the invocations of the events in the Chrome trace event
+     * format, which can be opened by chrome://tracing and the Perfetto UI.
+     * Each context is shown as a thread.
+     *
+     * \param [in] os The output stream.
+     */
+    void WriteChromeTrace(std::ostream& os) const;
+
+  private:
+    /** The clock measuring the invocations. */
+    using Clock = std::chrono::steady_clock;
+
+    /** The identity of an event kind. */
+    struct Key
+    {
+        std::type_index type; //!< The EventImpl type.
+        uint64_t function;    //!< EventImpl::GetFunctionId().
+        uint32_t context;     //!< The context of the events.
+
+        /**
+         * Equality operator.
+         * \param [in] o The other key.
+         * \returns \c true if the keys are equal.
+         */
+        bool operator==(const Key& o) const
+        {
+            return type == o.type && function == o.function && context == o.context;
+        }
+    };
+
+    /** Hash function for Key. */
+    struct KeyHash
+    {
+        /**
+         * \param [in] key The key.
+         * \returns The hash of the key.
+         */
+        std::size_t operator()(const Key& key) const;
+    };
+
+    /** The invocation of an event, for WriteChromeTrace(). */
+    struct Invocation
+    {
+        uint64_t startNs; //!< The wall clock start time, from the construction of the profiler.
+        uint64_t durNs;   //!< The wall clock duration.
+        uint64_t ts;      //!< The simulation time, in time steps.
+        uint64_t fanOut;  //!< The number of events scheduled.
+        uint32_t kind;    //!< The index of the kind in m_kinds.
+    };
+
+    /**
+     * Get the name of an event kind.
+     *
+     * \param [in] key The event kind.
+     * \returns The name of the function invoked.
+     */
+    static std::string GetName(const Key& key);
+
+    Clock::time_point m_origin;                        //!< The construction time.
+    Clock::time_point m_start;                         //!< The start of the current invocation.
+    std::unordered_map<Key, uint32_t, KeyHash> m_keys; //!< The index of each kind in m_kinds.
+    std::vector<Key> m_kindKeys;                       //!< The kinds.
+    std::vector<Stats> m_kinds;                        //!< The statistics of the kinds.
+    std::vector<Invocation> m_invocations;             //!< The recorded invocations.
+    uint64_t m_traceLimit;                             //!< The maximum size of m_invocations.
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
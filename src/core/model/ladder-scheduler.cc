@@ -0,0 +1,289 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "uinteger.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::LadderScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<LadderScheduler>()
+            .AddAttribute("BucketThreshold",
+                          "The number of events of a bucket above which the bucket "
+                          "is spread over a new rung instead of being sorted",
+                          UintegerValue(50),
+                          MakeUintegerAccessor(&LadderScheduler::m_threshold),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topStart(0),
+      m_topMin(std::numeric_limits<uint64_t>::max()),
+      m_topMax(0),
+      m_rungs(MAX_RUNGS),
+      m_nRungs(0),
+      m_bottomHead(0),
+      m_threshold(50)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t
+LadderScheduler::Rung::GetCurrentStart() const
+{
+    if (current == buckets.size())
+    {
+        // all the buckets have been consumed
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return start + current * width;
+}
+
+std::size_t
+LadderScheduler::Rung::GetIndex(uint64_t ts) const
+{
+    NS_ASSERT(ts >= start);
+    return std::min<uint64_t>((ts - start) / width, buckets.size() - 1);
+}
+
+void
+LadderScheduler::Insert(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    uint64_t ts = ev.key.m_ts;
+    if (ts >= m_topStart)
+    {
+        m_top.push_back(ev);
+        m_topMin = std::min(m_topMin, ts);
+        m_topMax = std::max(m_topMax, ts);
+    }
+    else
+    {
+        // The rungs cover successive, earlier, time spans
+        std::size_t i = 0;
+        while (i < m_nRungs && ts < m_rungs[i].GetCurrentStart())
+        {
+            i++;
+        }
+        if (i < m_nRungs)
+        {
+            Rung& rung = m_rungs[i];
+            rung.buckets[rung.GetIndex(ts)].push_back(ev);
+            rung.count++;
+        }
+        else
+        {
+            auto it = std::upper_bound(m_bottom.begin() + m_bottomHead, m_bottom.end(), ev);
+            m_bottom.insert(it, ev);
+        }
+    }
+    Refill();
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_bottomHead == m_bottom.size();
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    return m_bottom[m_bottomHead];
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    Scheduler::Event ev = m_bottom[m_bottomHead++];
+    if (m_bottomHead > 1024 && m_bottomHead * 2 > m_bottom.size())
+    {
+        // events keep being inserted in the bottom: drop the removed ones
+        m_bottom.erase(m_bottom.begin(), m_bottom.begin() + m_bottomHead);
+        m_bottomHead = 0;
+    }
+    Refill();
+    NS_LOG_DEBUG("remove " << ev.key.m_ts << ", " << ev.key.m_uid);
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_ASSERT(!IsEmpty());
+    uint64_t ts = ev.key.m_ts;
+    if (ts >= m_topStart)
+    {
+        RemoveFromBucket(m_top, ev);
+    }
+    else
+    {
+        std::size_t i = 0;
+        while (i < m_nRungs && ts < m_rungs[i].GetCurrentStart())
+        {
+            i++;
+        }
+        if (i < m_nRungs)
+        {
+            Rung& rung = m_rungs[i];
+            RemoveFromBucket(rung.buckets[rung.GetIndex(ts)], ev);
+            rung.count--;
+        }
+        else
+        {
+            auto it = std::lower_bound(m_bottom.begin() + m_bottomHead, m_bottom.end(), ev);
+            NS_ASSERT_MSG(it != m_bottom.end() && it->key == ev.key, "Event not found");
+            m_bottom.erase(it);
+        }
+    }
+    Refill();
+}
+
+void
+LadderScheduler::RemoveFromBucket(Bucket& bucket, const Scheduler::Event& ev)
+{
+    auto it = std::find(bucket.begin(), bucket.end(), ev);
+    NS_ASSERT_MSG(it != bucket.end(), "Event not found");
+    *it = bucket.back();
+    bucket.pop_back();
+}
+
+void
+LadderScheduler::AddRung(Bucket& events, uint64_t minTs, uint64_t maxTs)
+{
+    NS_LOG_FUNCTION(this << events.size() << minTs << maxTs);
+    NS_ASSERT(m_nRungs < MAX_RUNGS);
+    Rung& rung = m_rungs[m_nRungs++];
+    // about one event per bucket, if the events were evenly distributed
+    rung.width = (maxTs - minTs) / events.size() + 1;
+    rung.buckets.resize((maxTs - minTs) / rung.width + 1);
+    rung.start = minTs;
+    rung.current = 0;
+    rung.count = events.size();
+    for (const auto& ev : events)
+    {
+        rung.buckets[rung.GetIndex(ev.key.m_ts)].push_back(ev);
+    }
+    events.clear();
+    NS_LOG_DEBUG("rung " << m_nRungs - 1 << ": " << rung.count << " events, "
+                         << rung.buckets.size() << " buckets of width " << rung.width);
+}
+
+void
+LadderScheduler::SetBottom(Bucket& events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+    NS_ASSERT(IsEmpty());
+    m_bottom.swap(events);
+    events.clear();
+    m_bottomHead = 0;
+    std::sort(m_bottom.begin(), m_bottom.end());
+}
+
+void
+LadderScheduler::Refill()
+{
+    if (!IsEmpty())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    while (true)
+    {
+        if (m_nRungs == 0)
+        {
+            if (m_top.empty())
+            {
+                m_bottom.clear();
+                m_bottomHead = 0;
+                return;
+            }
+            // the events inserted from now on before m_topStart go to the ladder or the bottom
+            m_topStart = m_topMax + 1;
+            uint64_t minTs = m_topMin;
+            uint64_t maxTs = m_topMax;
+            m_topMin = std::numeric_limits<uint64_t>::max();
+            m_topMax = 0;
+            if (minTs == maxTs)
+            {
+                SetBottom(m_top);
+                return;
+            }
+            AddRung(m_top, minTs, maxTs);
+        }
+        Rung& rung = m_rungs[m_nRungs - 1];
+        if (rung.count == 0)
+        {
+            m_nRungs--;
+            continue;
+        }
+        while (rung.buckets[rung.current].empty())
+        {
+            rung.current++;
+        }
+        Bucket& bucket = rung.buckets[rung.current];
+        rung.count -= bucket.size();
+        rung.current++;
+        if (bucket.size() > m_threshold && m_nRungs < MAX_RUNGS)
+        {
+            auto [minEv, maxEv] = std::minmax_element(bucket.begin(), bucket.end());
+            if (minEv->key.m_ts != maxEv->key.m_ts)
+            {
+                AddRung(bucket, minEv->key.m_ts, maxEv->key.m_ts);
+                continue;
+            }
+        }
+        SetBottom(bucket);
+        return;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,179 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the Ladder Queue published in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng][Tang]. Contrary to the CalendarScheduler, it never
+ * resizes a bucket array to adapt to the event distribution: the events
+ * are sorted only when they get close to the head of the queue.
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * The events are stored in three tiers:
+ * - the *top*, an unsorted vector holding the events later than all the
+ *   events of the other tiers; new events are usually just appended to it;
+ * - the *ladder*, a stack of up to 8 rungs, each one an array of unsorted
+ *   buckets covering a uniform time span. When all the rungs are empty, the
+ *   top is spread over a new rung whose number of buckets is the number of
+ *   events. The earliest non empty bucket of the lowest rung is either moved
+ *   to the bottom, or, if it holds more than \c BucketThreshold events with
+ *   different timestamps, spread over a new, finer, rung;
+ * - the *bottom*, a vector sorted in chronological order, from which the
+ *   events are removed.
+ *
+ * A burst of events with the same timestamp (e.g. the subframe events of
+ * the LTE models) stays in a single bucket, which is sorted once when it
+ * reaches the bottom, instead of spawning rungs or resizing the buckets.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time  | Reason
+ * :----------- | :--------------- | :-----
+ * Insert()     | ~Constant        | Append to the top or to a bucket; sorted insertion in the (short) bottom
+ * IsEmpty()    | Constant         | Check the bottom
+ * PeekNext()   | Constant         | Head of the bottom
+ * Remove()     | Linear in bucket | Search within the top or a bucket
+ * RemoveNext() | ~Constant        | Head of the bottom; refill from the ladder
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 8 rungs + 2 x `std::vector`      | Ladder, top and bottom
+ * Per Event | 0 (plus 24 bytes per bucket)     | `std::vector` buckets, one per event spread
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Bucket type: an unsorted vector of Events. */
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /** A rung of the ladder. */
+    struct Rung
+    {
+        std::vector<Bucket> buckets; //!< The buckets.
+        uint64_t start;              //!< Start time of the first bucket.
+        uint64_t width;              //!< Duration of a bucket, in dimensionless time units.
+        std::size_t current;         //!< Index of the first bucket not yet consumed.
+        std::size_t count;           //!< Number of events in the buckets.
+
+        /**
+         * Get the start time of the current bucket.
+         *
+         * \return The time from which the events can be inserted in this rung,
+         *         or the maximum time if all the buckets have been consumed.
+         */
+        uint64_t GetCurrentStart() const;
+        /**
+         * Get the bucket of an event. The last bucket also holds
+         * the events inserted after the end of the rung.
+         *
+         * \param [in] ts The event timestamp, not earlier than the start of the current bucket.
+         * \return The bucket index.
+         */
+        std::size_t GetIndex(uint64_t ts) const;
+    };
+
+    /**
+     * Spread events over a new rung.
+     *
+     * \param [in] events The events, which are moved to the rung.
+     * \param [in] minTs The earliest timestamp of the events.
+     * \param [in] maxTs The latest timestamp of the events.
+     */
+    void AddRung(Bucket& events, uint64_t minTs, uint64_t maxTs);
+    /**
+     * Move events to the (empty) bottom and sort them.
+     *
+     * \param [in] events The events.
+     */
+    void SetBottom(Bucket& events);
+    /** Move the next events to the bottom, if the bottom is empty. */
+    void Refill();
+    /**
+     * Remove an event from an unsorted bucket.
+     *
+     * \param [in] bucket The bucket.
+     * \param [in] ev The event.
+     */
+    static void RemoveFromBucket(Bucket& bucket, const Scheduler::Event& ev);
+
+    /** The maximum number of rungs. */
+    static constexpr std::size_t MAX_RUNGS = 8;
+
+    /** Unsorted events later than the ones of the ladder and the bottom. */
+    Bucket m_top;
+    /** The earliest time of the events which are inserted in the top. */
+    uint64_t m_topStart;
+    /** The earliest timestamp of the events in the top. */
+    uint64_t m_topMin;
+    /** The latest timestamp of the events in the top. */
+    uint64_t m_topMax;
+    /** The rungs, the first \c m_nRungs of which are in use. */
+    std::vector<Rung> m_rungs;
+    /** The number of rungs in use. */
+    std::size_t m_nRungs;
+    /** The next events, sorted, starting from index \c m_bottomHead. */
+    Bucket m_bottom;
+    /** Index of the next event in the bottom. */
+    std::size_t m_bottomHead;
+    /** The number of events of a bucket above which it is spread over a new rung. */
+    uint32_t m_threshold;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
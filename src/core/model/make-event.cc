@@ -58,6 +58,11 @@ MakeEvent(void (*f)())
             (*m_function)();
         }
 
+        uint64_t GetFunctionId() const override
+        {
+            return MakeEventFunctionId(m_function);
+        }
+
       private:
         F m_function;
     }* ev = new EventFunctionImpl0(f);
@@ -353,9 +353,35 @@ EventImpl* MakeEvent(T function);
 #include "event-impl.h"
 #include "type-traits.h"
 
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+#include <type_traits>
+
 namespace ns3
 {
 
+/**
+ * \ingroup events
+ * Helper for the MakeEvent functions, to implement EventImpl::GetFunctionId().
+ *
+ * \tparam F \deduced The function pointer, member function pointer or functor type.
+ * \param [in] function The function bound to the event.
+ * \returns The address of a function, the first word of a member
+ *          function pointer, or zero for a functor.
+ */
+template <typename F>
+uint64_t
+MakeEventFunctionId(const F& function)
+{
+    uint64_t id = 0;
+    if constexpr (std::is_pointer_v<F> || std::is_member_function_pointer_v<F>)
+    {
+        std::memcpy(&id, &function, std::min(sizeof(F), sizeof(id)));
+    }
+    return id;
+}
+
 /**
  * \ingroup makeeventmemptr
  * Helper for the MakeEvent functions which take a class method.
@@ -416,6 +442,11 @@ MakeEvent(MEM mem_ptr, OBJ obj)
             (EventMemberImplObjTraits<OBJ>::GetReference(m_obj).*m_function)();
         }
 
+        uint64_t GetFunctionId() const override
+        {
+            return MakeEventFunctionId(m_function);
+        }
+
         OBJ m_obj;
         MEM m_function;
     }* ev = new EventMemberImpl0(obj, mem_ptr);
@@ -449,6 +480,11 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1)
             (EventMemberImplObjTraits<OBJ>::GetReference(m_obj).*m_function)(m_a1);
         }
 
+        uint64_t GetFunctionId() const override
+        {
+            return MakeEventFunctionId(m_function);
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -484,6 +520,11 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2)
             (EventMemberImplObjTraits<OBJ>::GetReference(m_obj).*m_function)(m_a1, m_a2);
         }
 
+        uint64_t GetFunctionId() const override
+        {
+            return MakeEventFunctionId(m_function);
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -521,6 +562,11 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3)
             (EventMemberImplObjTraits<OBJ>::GetReference(m_obj).*m_function)(m_a1, m_a2, m_a3);
         }
 
+        uint64_t GetFunctionId() const override
+        {
+            return MakeEventFunctionId(m_function);
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -561,6 +607,11 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4)
              m_function)(m_a1, m_a2, m_a3, m_a4);
         }
 
+        uint64_t GetFunctionId() const override
+        {
+            return MakeEventFunctionId(m_function);
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -609,6 +660,11 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5)
              m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
         }
 
+        uint64_t GetFunctionId() const override
+        {
+            return MakeEventFunctionId(m_function);
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -660,6 +716,11 @@ MakeEvent(MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6)
              m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
         }
 
+        uint64_t GetFunctionId() const override
+        {
+            return MakeEventFunctionId(m_function);
+        }
+
         OBJ m_obj;
         MEM m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
@@ -700,6 +761,11 @@ MakeEvent(void (*f)(U1), T1 a1)
             (*m_function)(m_a1);
         }
 
+        uint64_t GetFunctionId() const override
+        {
+            return MakeEventFunctionId(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
     }* ev = new EventFunctionImpl1(f, a1);
@@ -735,6 +801,11 @@ MakeEvent(void (*f)(U1, U2), T1 a1, T2 a2)
             (*m_function)(m_a1, m_a2);
         }
 
+        uint64_t GetFunctionId() const override
+        {
+            return MakeEventFunctionId(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
         typename TypeTraits<T2>::ReferencedType m_a2;
@@ -772,6 +843,11 @@ MakeEvent(void (*f)(U1, U2, U3), T1 a1, T2 a2, T3 a3)
             (*m_function)(m_a1, m_a2, m_a3);
         }
 
+        uint64_t GetFunctionId() const override
+        {
+            return MakeEventFunctionId(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
         typename TypeTraits<T2>::ReferencedType m_a2;
@@ -818,6 +894,11 @@ MakeEvent(void (*f)(U1, U2, U3, U4), T1 a1, T2 a2, T3 a3, T4 a4)
             (*m_function)(m_a1, m_a2, m_a3, m_a4);
         }
 
+        uint64_t GetFunctionId() const override
+        {
+            return MakeEventFunctionId(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
         typename TypeTraits<T2>::ReferencedType m_a2;
@@ -868,6 +949,11 @@ MakeEvent(void (*f)(U1, U2, U3, U4, U5), T1 a1, T2 a2, T3 a3, T4 a4, T5 a5)
             (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
         }
 
+        uint64_t GetFunctionId() const override
+        {
+            return MakeEventFunctionId(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
         typename TypeTraits<T2>::ReferencedType m_a2;
@@ -922,6 +1008,11 @@ MakeEvent(void (*f)(U1, U2, U3, U4, U5, U6), T1 a1, T2 a2, T3 a3, T4 a4, T5 a5,
             (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
         }
 
+        uint64_t GetFunctionId() const override
+        {
+            return MakeEventFunctionId(m_function);
+        }
+
         F m_function;
         typename TypeTraits<T1>::ReferencedType m_a1;
         typename TypeTraits<T2>::ReferencedType m_a2;
@@ -956,6 +1047,11 @@ MakeEvent(T function)
             m_function();
         }
 
+        uint64_t GetFunctionId() const override
+        {
+            return MakeEventFunctionId(m_function);
+        }
+
         T m_function;
     }* ev = new EventImplFunctional(function);
 
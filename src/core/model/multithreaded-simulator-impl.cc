@@ -0,0 +1,820 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "abort.h"
+#include "assert.h"
+#include "log.h"
+#include "nstime.h"
+#include "simulator.h"
+#include "uinteger.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+thread_local MultithreadedSimulatorImpl::Partition* MultithreadedSimulatorImpl::m_currentPartition =
+    nullptr;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("ThreadCount",
+                          "The maximum number of threads used to run the partitions. "
+                          "0 means the number of hardware threads. More than one thread "
+                          "is used only when ns-3 is built with NS3_MTP.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_maxThreads),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Lookahead",
+                          "The minimum delay of the events scheduled by a partition "
+                          "in another partition. It must be set when there are more "
+                          "than one partition.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&MultithreadedSimulatorImpl::SetLookahead,
+                                           &MultithreadedSimulatorImpl::GetLookahead),
+                          MakeTimeChecker(Seconds(0)));
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+    m_repartition = false;
+    m_lookahead = 0;
+    m_maxThreads = 0;
+    m_nThreads = 1;
+    m_stop = false;
+    m_running = false;
+    m_hasRun = false;
+    m_uid = EventId::UID::VALID;
+    m_currentTs = 0;
+    m_windowEnd = 0;
+    m_mainThreadId = std::this_thread::get_id();
+    m_window = 0;
+    m_pendingThreads = 0;
+    m_exitThreads = false;
+    m_global = CreatePartition(Simulator::NO_CONTEXT);
+    m_partitions.push_back(CreatePartition(0));
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    ProcessRemoteEvents();
+
+    std::vector<std::unique_ptr<Partition>> partitions;
+    partitions.swap(m_partitions);
+    partitions.push_back(std::move(m_global));
+    for (auto& partition : partitions)
+    {
+        while (!partition->events->IsEmpty())
+        {
+            Scheduler::Event next = partition->events->RemoveNext();
+            next.impl->Unref();
+        }
+        partition->events = nullptr;
+    }
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+std::unique_ptr<MultithreadedSimulatorImpl::Partition>
+MultithreadedSimulatorImpl::CreatePartition(uint32_t index) const
+{
+    auto partition = std::make_unique<Partition>();
+    partition->index = index;
+    if (m_schedulerFactory.IsTypeIdSet())
+    {
+        partition->events = m_schedulerFactory.Create<Scheduler>();
+    }
+    partition->uid = m_uid;
+    partition->currentTs = m_currentTs;
+    partition->currentUid = EventId::UID::INVALID;
+    partition->currentContext = Simulator::NO_CONTEXT;
+    partition->eventCount = 0;
+    partition->unscheduledEvents = 0;
+    partition->sentEvents = 0;
+    partition->objectUid = 0;
+    partition->stop = false;
+    return partition;
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    NS_ASSERT_MSG(!m_running, "Cannot change the scheduler while the simulation is running");
+    m_schedulerFactory = schedulerFactory;
+
+    std::vector<Partition*> partitions{m_global.get()};
+    for (auto& partition : m_partitions)
+    {
+        partitions.push_back(partition.get());
+    }
+    for (auto partition : partitions)
+    {
+        Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+        if (partition->events)
+        {
+            while (!partition->events->IsEmpty())
+            {
+                scheduler->Insert(partition->events->RemoveNext());
+            }
+        }
+        partition->events = scheduler;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetPartition(uint32_t context, uint32_t partition)
+{
+    NS_LOG_FUNCTION(this << context << partition);
+    NS_ASSERT_MSG(context != Simulator::NO_CONTEXT, "Events without context have no partition");
+    NS_ABORT_MSG_IF(m_hasRun && GetPartition(context) != partition,
+                    "The partition of context " << context
+                                                << " cannot be changed after Simulator::Run()");
+
+    while (m_partitions.size() <= partition)
+    {
+        m_partitions.push_back(CreatePartition(m_partitions.size()));
+    }
+    if (m_contextPartition.size() <= context)
+    {
+        m_contextPartition.resize(context + 1, 0);
+    }
+    if (m_contextPartition[context] != partition)
+    {
+        m_contextPartition[context] = partition;
+        m_repartition = true;
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition(uint32_t context) const
+{
+    return context < m_contextPartition.size() ? m_contextPartition[context] : 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNPartitions() const
+{
+    return m_partitions.size();
+}
+
+void
+MultithreadedSimulatorImpl::SetLookahead(const Time& lookahead)
+{
+    NS_LOG_FUNCTION(this << lookahead);
+    NS_ASSERT_MSG(!m_running, "Cannot change the lookahead while the simulation is running");
+    m_lookahead = lookahead.GetTimeStep();
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead() const
+{
+    return TimeStep(m_lookahead);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetMaxThreads() const
+{
+    if (m_maxThreads == 0)
+    {
+        return std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    return m_maxThreads;
+}
+
+bool
+MultithreadedSimulatorImpl::AllocatePartitionUid(uint64_t& uid)
+{
+    Partition* partition = m_currentPartition;
+    if (partition == nullptr || partition->index == Simulator::NO_CONTEXT)
+    {
+        return false;
+    }
+    uid = (static_cast<uint64_t>(partition->index) + 1) << 32 | partition->objectUid++;
+    return true;
+}
+
+MultithreadedSimulatorImpl::Partition*
+MultithreadedSimulatorImpl::GetPartitionOf(uint32_t context) const
+{
+    if (context == Simulator::NO_CONTEXT)
+    {
+        return m_global.get();
+    }
+    return m_partitions[GetPartition(context)].get();
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+EventId
+MultithreadedSimulatorImpl::Insert(Partition* partition,
+                                   uint64_t ts,
+                                   uint32_t context,
+                                   EventImpl* event)
+{
+    // Before the first run, the events may be moved to another partition,
+    // so they get their id from a common counter.
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = m_hasRun ? partition->uid++ : m_uid++;
+    partition->unscheduledEvents++;
+    partition->events->Insert(ev);
+    return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::Repartition()
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<Scheduler::Event> events;
+    for (auto& partition : m_partitions)
+    {
+        while (!partition->events->IsEmpty())
+        {
+            events.push_back(partition->events->RemoveNext());
+            partition->unscheduledEvents--;
+        }
+    }
+    for (const auto& ev : events)
+    {
+        Partition* partition = GetPartitionOf(ev.key.m_context);
+        partition->unscheduledEvents++;
+        partition->events->Insert(ev);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent(Partition* partition)
+{
+    Scheduler::Event next = partition->events->RemoveNext();
+
+    PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
+
+    NS_ASSERT(next.key.m_ts >= partition->currentTs);
+    partition->unscheduledEvents--;
+    partition->eventCount.fetch_add(1, std::memory_order_relaxed);
+
+    partition->currentTs = next.key.m_ts;
+    partition->currentContext = next.key.m_context;
+    partition->currentUid = next.key.m_uid;
+    next.impl->Invoke();
+    next.impl->Unref();
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    if (!m_global->events->IsEmpty())
+    {
+        return false;
+    }
+    for (const auto& partition : m_partitions)
+    {
+        if (!partition->events->IsEmpty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessRemoteEvents()
+{
+    // Called by the main thread while the partitions are stopped.
+    std::vector<Partition*> partitions{m_global.get()};
+    for (auto& partition : m_partitions)
+    {
+        partitions.push_back(partition.get());
+    }
+    for (auto partition : partitions)
+    {
+        if (partition->inbox.empty())
+        {
+            continue;
+        }
+        // The events are received in an order which depends on the execution
+        // of the threads: sort them, so that they get their unique id, and
+        // hence their execution order among the events with the same
+        // timestamp, in a deterministic way.
+        std::sort(partition->inbox.begin(),
+                  partition->inbox.end(),
+                  [](const RemoteEvent& a, const RemoteEvent& b) {
+                      return std::tie(a.ts, a.sender, a.seq) < std::tie(b.ts, b.sender, b.seq);
+                  });
+        for (const auto& ev : partition->inbox)
+        {
+            Insert(partition, ev.ts, ev.context, ev.event);
+        }
+        partition->inbox.clear();
+    }
+
+    std::list<ExternalEvent> externalEvents;
+    {
+        std::unique_lock lock{m_externalEventsMutex};
+        m_externalEvents.swap(externalEvents);
+    }
+    for (const auto& ev : externalEvents)
+    {
+        Insert(GetPartitionOf(ev.context), m_currentTs + ev.delay, ev.context, ev.event);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ProcessGlobalEvents(uint64_t ts)
+{
+    m_currentPartition = m_global.get();
+    while (!m_global->stop && !m_global->events->IsEmpty() &&
+           m_global->events->PeekNext().key.m_ts == ts)
+    {
+        ProcessOneEvent(m_global.get());
+    }
+    m_currentPartition = nullptr;
+    m_currentTs = ts;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow(Partition* partition)
+{
+    m_currentPartition = partition;
+    while (!partition->stop && !partition->events->IsEmpty() &&
+           partition->events->PeekNext().key.m_ts < m_windowEnd)
+    {
+        ProcessOneEvent(partition);
+    }
+    m_currentPartition = nullptr;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessPartitions(uint32_t thread)
+{
+    for (std::size_t i = thread; i < m_partitions.size(); i += m_nThreads)
+    {
+        ProcessWindow(m_partitions[i].get());
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunWindow(uint64_t windowEnd)
+{
+    m_windowEnd = windowEnd;
+    if (m_nThreads == 1)
+    {
+        ProcessPartitions(0);
+        return;
+    }
+
+    {
+        std::unique_lock lock{m_barrierMutex};
+        m_pendingThreads = m_nThreads - 1;
+        m_window++;
+    }
+    m_startCondition.notify_all();
+    ProcessPartitions(0);
+    std::unique_lock lock{m_barrierMutex};
+    m_doneCondition.wait(lock, [this] { return m_pendingThreads == 0; });
+}
+
+void
+MultithreadedSimulatorImpl::WorkerLoop(uint32_t thread, uint64_t window)
+{
+    while (true)
+    {
+        {
+            std::unique_lock lock{m_barrierMutex};
+            m_startCondition.wait(lock, [this, window] {
+                return m_exitThreads || m_window != window;
+            });
+            if (m_exitThreads)
+            {
+                return;
+            }
+            window = m_window;
+        }
+        ProcessPartitions(thread);
+        {
+            std::unique_lock lock{m_barrierMutex};
+            if (--m_pendingThreads == 0)
+            {
+                m_doneCondition.notify_one();
+            }
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    // Set the current threadId as the main threadId
+    m_mainThreadId = std::this_thread::get_id();
+    if (m_repartition)
+    {
+        Repartition();
+        m_repartition = false;
+    }
+    if (!m_hasRun)
+    {
+        for (auto& partition : m_partitions)
+        {
+            partition->uid = m_uid;
+        }
+        m_global->uid = m_uid;
+        m_hasRun = true;
+    }
+    NS_ABORT_MSG_IF(m_partitions.size() > 1 && m_lookahead == 0,
+                    "A lookahead is needed to run more than one partition");
+
+    m_nThreads = std::min<uint32_t>(GetMaxThreads(), m_partitions.size());
+#ifndef NS3_MTP
+    if (m_nThreads > 1)
+    {
+        NS_LOG_WARN("ns-3 is built without NS3_MTP: the " << m_partitions.size()
+                                                          << " partitions run in a single thread");
+        m_nThreads = 1;
+    }
+#endif
+    NS_LOG_LOGIC("running " << m_partitions.size() << " partitions with " << m_nThreads
+                            << " threads and a lookahead of " << GetLookahead().As(Time::S));
+
+    m_stop = false;
+    m_global->stop = false;
+    for (auto& partition : m_partitions)
+    {
+        partition->stop = false;
+    }
+    m_running = true;
+    for (uint32_t thread = 1; thread < m_nThreads; thread++)
+    {
+        m_threads.emplace_back(&MultithreadedSimulatorImpl::WorkerLoop, this, thread, m_window);
+    }
+
+    const uint64_t never = std::numeric_limits<uint64_t>::max();
+    while (!m_stop)
+    {
+        ProcessRemoteEvents();
+
+        uint64_t nextGlobal =
+            m_global->events->IsEmpty() ? never : m_global->events->PeekNext().key.m_ts;
+        uint64_t nextLocal = never;
+        for (auto& partition : m_partitions)
+        {
+            if (!partition->events->IsEmpty())
+            {
+                nextLocal = std::min(nextLocal, partition->events->PeekNext().key.m_ts);
+            }
+        }
+        if (nextGlobal == never && nextLocal == never)
+        {
+            break;
+        }
+        if (nextGlobal <= nextLocal)
+        {
+            ProcessGlobalEvents(nextGlobal);
+            continue;
+        }
+
+        // A single partition has no lookahead constraint: it runs until the
+        // next global event.
+        uint64_t windowEnd = nextGlobal;
+        if (m_partitions.size() > 1 && nextLocal < never - m_lookahead)
+        {
+            windowEnd = std::min(windowEnd, nextLocal + m_lookahead);
+        }
+        RunWindow(windowEnd);
+
+        for (auto& partition : m_partitions)
+        {
+            m_currentTs = std::max(m_currentTs, partition->currentTs);
+        }
+    }
+
+    {
+        std::unique_lock lock{m_barrierMutex};
+        m_exitThreads = true;
+    }
+    m_startCondition.notify_all();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+    m_threads.clear();
+    m_exitThreads = false;
+    m_running = false;
+
+    // If the simulator stopped naturally by lack of events, make a
+    // consistency test to check that we didn't lose any events along the way.
+    [[maybe_unused]] int unscheduledEvents = m_global->unscheduledEvents;
+    for (auto& partition : m_partitions)
+    {
+        unscheduledEvents += partition->unscheduledEvents;
+    }
+    NS_ASSERT(m_stop || unscheduledEvents == 0);
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+    if (m_currentPartition != nullptr)
+    {
+        // The other partitions complete the current window.
+        m_currentPartition->stop = true;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(m_currentPartition != nullptr || m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::Schedule Thread-unsafe invocation!");
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+
+    Partition* partition = m_currentPartition;
+    if (partition == nullptr)
+    {
+        return Insert(m_global.get(),
+                      m_currentTs + delay.GetTimeStep(),
+                      Simulator::NO_CONTEXT,
+                      event);
+    }
+    return Insert(partition,
+                  partition->currentTs + delay.GetTimeStep(),
+                  partition->currentContext,
+                  event);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+
+    Partition* current = m_currentPartition;
+    if (current == nullptr && m_mainThreadId != std::this_thread::get_id())
+    {
+        // Thread external to the simulation: the current time is added
+        // in ProcessRemoteEvents()
+        ExternalEvent ev;
+        ev.delay = delay.GetTimeStep();
+        ev.context = context;
+        ev.event = event;
+        std::unique_lock lock{m_externalEventsMutex};
+        m_externalEvents.push_back(ev);
+        return;
+    }
+
+    Partition* target = GetPartitionOf(context);
+    if (current == nullptr || current == target || current == m_global.get())
+    {
+        // Either the caller owns the target partition, or the partitions are stopped
+        uint64_t now = current == nullptr ? m_currentTs : current->currentTs;
+        Insert(target, now + delay.GetTimeStep(), context, event);
+        return;
+    }
+
+    RemoteEvent ev;
+    ev.ts = current->currentTs + delay.GetTimeStep();
+    ev.context = context;
+    ev.sender = current->index;
+    ev.seq = current->sentEvents++;
+    ev.event = event;
+    NS_ABORT_MSG_IF(ev.ts < m_windowEnd,
+                    "Event scheduled by context "
+                        << current->currentContext << " (partition " << current->index
+                        << ") for context " << context << " with a delay of "
+                        << delay.As(Time::S) << ", below the lookahead of "
+                        << GetLookahead().As(Time::S));
+    std::unique_lock lock{target->inboxMutex};
+    target->inbox.push_back(ev);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    EventId id(Ptr<EventImpl>(event, false), Now().GetTimeStep(), 0xffffffff, 2);
+    std::unique_lock lock{m_destroyEventsMutex};
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    Partition* partition = m_currentPartition;
+    return TimeStep(partition == nullptr ? m_currentTs : partition->currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    else
+    {
+        return TimeStep(id.GetTs()) - Now();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    Partition* partition = GetPartitionOf(id.GetContext());
+    if (m_running && m_currentPartition != partition && m_currentPartition != m_global.get())
+    {
+        // The queue of the events without context is not run while the
+        // partitions are, but it may be accessed by several of them
+        NS_ASSERT(partition == m_global.get());
+        id.PeekEventImpl()->Cancel();
+        return;
+    }
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    partition->events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+
+    partition->unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+    {
+        return true;
+    }
+    const Partition* partition = GetPartitionOf(id.GetContext());
+    NS_ABORT_MSG_IF(m_running && m_currentPartition != partition &&
+                        m_currentPartition != m_global.get() && partition != m_global.get(),
+                    "Event of context " << id.GetContext() << " (partition " << partition->index
+                                        << ") accessed by context "
+                                        << m_currentPartition->currentContext << " (partition "
+                                        << m_currentPartition->index << ")");
+    return id.GetTs() < partition->currentTs ||
+           (id.GetTs() == partition->currentTs && id.GetUid() <= partition->currentUid);
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    Partition* partition = m_currentPartition;
+    return partition == nullptr ? Simulator::NO_CONTEXT : partition->currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t eventCount = m_global->eventCount.load(std::memory_order_relaxed);
+    for (const auto& partition : m_partitions)
+    {
+        eventCount += partition->eventCount.load(std::memory_order_relaxed);
+    }
+    return eventCount;
+}
+
+} // namespace ns3
@@ -0,0 +1,345 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "object-factory.h"
+#include "scheduler.h"
+#include "simulator-impl.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ *
+ * A shared memory parallel simulator implementation.
+ *
+ * The execution contexts (i.e., the node ids) are mapped to partitions
+ * with SetPartition(). Each partition has its own event queue, and the
+ * partitions are executed by a pool of threads in time windows whose
+ * length is the lookahead, i.e., the minimum delay of the events that
+ * a partition schedules in another partition (typically, the delay of
+ * the links between the nodes of different partitions). The threads
+ * wait for each other at the end of each window (conservative, YAWNS
+ * like, synchronization), and the events scheduled in other partitions
+ * are then moved to their event queue. Scheduling an event in another
+ * partition within the current window is a fatal error, and so is
+ * cancelling, removing or checking the expiration of an event of another
+ * partition, except for the events without context.
+ *
+ * The events without context (Simulator::NO_CONTEXT), e.g. the events
+ * scheduled by the main program before Simulator::Run(), are executed
+ * by a single thread while the partitions are stopped, so they can
+ * safely access the state of any node.
+ *
+ * The events of the same partition are executed in the same order as
+ * in the DefaultSimulatorImpl; the events of different partitions with
+ * the same timestamp are executed in a deterministic order that does
+ * not depend on the number of threads.
+ *
+ * The models executed in different partitions must not share any state
+ * other than through events scheduled with Simulator::ScheduleWithContext.
+ * Since packets and events are passed between the threads, more than one
+ * thread is used only when ns-3 is built with multithreaded simulation
+ * support (NS3_MTP), which makes the reference counts atomic; otherwise
+ * all the partitions are executed by the main thread.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    void Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Assign an execution context to a partition.
+     *
+     * The contexts which are not assigned belong to partition 0.
+     * The partition of a context cannot be changed once the simulation
+     * has been run.
+     *
+     * \param [in] context The context, i.e., the node id.
+     * \param [in] partition The partition index.
+     */
+    void SetPartition(uint32_t context, uint32_t partition);
+    /**
+     * Get the partition of an execution context.
+     *
+     * \param [in] context The context.
+     * \return The partition index.
+     */
+    uint32_t GetPartition(uint32_t context) const;
+    /**
+     * Get the number of partitions.
+     *
+     * \return The number of partitions.
+     */
+    uint32_t GetNPartitions() const;
+    /**
+     * Set the lookahead, i.e., the minimum delay of the events scheduled
+     * in another partition.
+     *
+     * \param [in] lookahead The lookahead.
+     */
+    void SetLookahead(const Time& lookahead);
+    /**
+     * Get the lookahead.
+     *
+     * \return The lookahead.
+     */
+    Time GetLookahead() const;
+    /**
+     * Get the maximum number of threads used to run the partitions,
+     * as configured by the ThreadCount attribute.
+     *
+     * \return The maximum number of threads.
+     */
+    uint32_t GetMaxThreads() const;
+
+    /**
+     * Allocate a unique id (e.g., a packet uid) from the counter of the
+     * partition executed by the calling thread.
+     *
+     * The ids allocated by a partition depend only on the events of that
+     * partition, so they do not depend on the number of threads or on
+     * the interleaving of the partitions. The partition index is stored
+     * in the upper 32 bits of the id (starting from 1), so the ids of
+     * different partitions never collide.
+     *
+     * \param [out] uid The allocated id.
+     * \return \c false if the calling thread is not executing the events
+     *         of a partition (e.g., the main program, or the events without
+     *         context), in which case \p uid is left unchanged.
+     */
+    static bool AllocatePartitionUid(uint64_t& uid);
+
+  private:
+    void DoDispose() override;
+
+    /** An event scheduled in a partition by another partition. */
+    struct RemoteEvent
+    {
+        uint64_t ts;      //!< Event timestamp.
+        uint32_t context; //!< Event context.
+        uint32_t sender;  //!< Index of the sending partition.
+        uint64_t seq;     //!< Sequence number of the event in the sending partition.
+        EventImpl* event; //!< The event implementation.
+    };
+
+    /** An event scheduled by a thread external to the simulation. */
+    struct ExternalEvent
+    {
+        uint64_t delay;   //!< Event delay, from the time the event is received.
+        uint32_t context; //!< Event context.
+        EventImpl* event; //!< The event implementation.
+    };
+
+    /** The state of a partition. */
+    struct Partition
+    {
+        uint32_t index;                   //!< Partition index.
+        Ptr<Scheduler> events;            //!< The event priority queue.
+        uint32_t uid;                     //!< Next event unique id.
+        uint64_t currentTs;               //!< Timestamp of the current event.
+        uint32_t currentUid;              //!< Unique id of the current event.
+        uint32_t currentContext;          //!< Execution context of the current event.
+        std::atomic<uint64_t> eventCount; //!< The number of events executed.
+        int unscheduledEvents;            //!< Number of events inserted but not yet executed.
+        uint64_t sentEvents;              //!< Number of events sent to other partitions.
+        uint32_t objectUid;               //!< Next id returned by AllocatePartitionUid().
+        bool stop;                        //!< Flag \c true if Stop() was called by this partition.
+        std::vector<RemoteEvent> inbox;   //!< Events received from other partitions.
+        std::mutex inboxMutex;            //!< Mutex protecting the inbox.
+    };
+
+    /**
+     * Create a partition.
+     *
+     * \param [in] index The partition index.
+     * \return The partition.
+     */
+    std::unique_ptr<Partition> CreatePartition(uint32_t index) const;
+    /**
+     * Get the partition which executes the events of a context.
+     *
+     * \param [in] context The context.
+     * \return The partition.
+     */
+    Partition* GetPartitionOf(uint32_t context) const;
+    /**
+     * Insert an event in the queue of a partition.
+     *
+     * \param [in] partition The partition.
+     * \param [in] ts The event timestamp.
+     * \param [in] context The event context.
+     * \param [in] event The event implementation.
+     * \return The event id.
+     */
+    EventId Insert(Partition* partition, uint64_t ts, uint32_t context, EventImpl* event);
+    /**
+     * Move the events of all the partitions to the partition of their context.
+     * Used when the partitions have been changed before running the simulation.
+     */
+    void Repartition();
+    /** Move the events received by the partitions to their event queue. */
+    void ProcessRemoteEvents();
+    /**
+     * Process the events of the global partition at the current time.
+     *
+     * \param [in] ts The current time.
+     */
+    void ProcessGlobalEvents(uint64_t ts);
+    /**
+     * Process the next event of a partition.
+     *
+     * \param [in] partition The partition.
+     */
+    void ProcessOneEvent(Partition* partition);
+    /**
+     * Process the events of a partition until the end of the current window.
+     *
+     * \param [in] partition The partition.
+     */
+    void ProcessWindow(Partition* partition);
+    /**
+     * Process the events of the partitions executed by a thread
+     * until the end of the current window.
+     *
+     * \param [in] thread The thread index.
+     */
+    void ProcessPartitions(uint32_t thread);
+    /**
+     * Run one window on all threads and wait for their completion.
+     *
+     * \param [in] windowEnd The end of the window (excluded).
+     */
+    void RunWindow(uint64_t windowEnd);
+    /**
+     * The loop of a worker thread.
+     *
+     * \param [in] thread The thread index.
+     * \param [in] window The number of the last window already run.
+     */
+    void WorkerLoop(uint32_t thread, uint64_t window);
+
+    /** The partition executed by the calling thread, if any. */
+    static thread_local Partition* m_currentPartition;
+
+    /** The partitions executing the node events. */
+    std::vector<std::unique_ptr<Partition>> m_partitions;
+    /** The partition executing the events without context. */
+    std::unique_ptr<Partition> m_global;
+    /** The partition index of each context. */
+    std::vector<uint32_t> m_contextPartition;
+    /** Flag \c true if the contexts have been moved to another partition. */
+    bool m_repartition;
+    /** The scheduler factory, used to create the event queue of each partition. */
+    ObjectFactory m_schedulerFactory;
+    /** The lookahead, in time steps. */
+    uint64_t m_lookahead;
+    /** The maximum number of threads. */
+    uint32_t m_maxThreads;
+    /** The number of threads used by the current run. */
+    uint32_t m_nThreads;
+
+    /** Container type for the events to run at Simulator::Destroy() */
+    typedef std::list<EventId> DestroyEvents;
+    /** The container of events to run at Destroy. */
+    DestroyEvents m_destroyEvents;
+    /** Mutex protecting the destroy events. */
+    std::mutex m_destroyEventsMutex;
+    /** The events scheduled by threads external to the simulation. */
+    std::list<ExternalEvent> m_externalEvents;
+    /** Mutex protecting the external events. */
+    std::mutex m_externalEventsMutex;
+
+    /** Flag calling for the end of the simulation. */
+    std::atomic<bool> m_stop;
+    /** Flag \c true while Run() is executing. */
+    bool m_running;
+    /** Flag \c true once Run() has been called. */
+    bool m_hasRun;
+    /** Next event unique id, used when the simulation is not running. */
+    uint32_t m_uid;
+    /** The simulation time reached by all the partitions. */
+    uint64_t m_currentTs;
+    /** The end of the current window (excluded). */
+    uint64_t m_windowEnd;
+    /** Main execution thread. */
+    std::thread::id m_mainThreadId;
+
+    /** The worker threads. */
+    std::vector<std::thread> m_threads;
+    /** Mutex protecting the synchronization of the threads. */
+    std::mutex m_barrierMutex;
+    /** Condition notified when a new window starts. */
+    std::condition_variable m_startCondition;
+    /** Condition notified when the last worker thread completes a window. */
+    std::condition_variable m_doneCondition;
+    /** Number of the current window, used to wake up the worker threads. */
+    uint64_t m_window;
+    /** Number of worker threads still executing the current window. */
+    uint32_t m_pendingThreads;
+    /** Flag asking the worker threads to exit. */
+    bool m_exitThreads;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
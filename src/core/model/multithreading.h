@@ -0,0 +1,67 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_MULTITHREADING_H
+#define NS3_MULTITHREADING_H
+
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * Helpers for the state shared by the threads of the MultithreadedSimulatorImpl.
+ *
+ * When ns-3 is built with multithreaded simulation support (NS3_MTP),
+ * the objects passed between the partitions (packets, events) can be
+ * referenced by more than one thread, and the caches of the allocators
+ * must be private to each thread. Without NS3_MTP, all the partitions
+ * are run by the main thread and these helpers reduce to the plain types,
+ * so the single threaded builds do not pay for the synchronization.
+ */
+
+/**
+ * \ingroup simulator
+ * Storage class of the caches (e.g., free lists) which are private
+ * to each thread with NS3_MTP: \c thread_local, or nothing otherwise.
+ */
+#ifdef NS3_MTP
+#define NS_MTP_THREAD_LOCAL thread_local
+#else
+#define NS_MTP_THREAD_LOCAL
+#endif
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ * A value which can be modified by several threads with NS3_MTP,
+ * such as a reference count: \c std::atomic<T>, or \c T otherwise.
+ *
+ * \tparam T \explicit The type of the value.
+ */
+#ifdef NS3_MTP
+template <typename T>
+using MtpAtomic = std::atomic<T>;
+#else
+template <typename T>
+using MtpAtomic = T;
+#endif
+
+} // namespace ns3
+
+#endif /* NS3_MULTITHREADING_H */
@@ -109,6 +109,28 @@ MakeObjectMapAccessor(U T::*memberVector)
             return nullptr;
         }
 
+        bool DoFind(const ObjectBase* object, std::size_t index, Ptr<Object>* value) const override
+        {
+            const T* obj = dynamic_cast<const T*>(object);
+            if (obj == nullptr)
+            {
+                return false;
+            }
+            auto key = static_cast<typename U::key_type>(index);
+            if (static_cast<std::size_t>(key) != index)
+            {
+                // no key has this index
+                return false;
+            }
+            auto it = (obj->*m_memberVector).find(key);
+            if (it == (obj->*m_memberVector).end())
+            {
+                return false;
+            }
+            *value = it->second;
+            return true;
+        }
+
         U T::*m_memberVector;
     }* spec = new MemberStdContainer();
 
@@ -233,7 +233,38 @@ class ObjectPtrContainerAccessor : public AttributeAccessor
     bool HasGetter() const override;
     bool HasSetter() const override;
 
+    /**
+     * Get the number of instances in the container.
+     *
+     * \param [in] object The container object.
+     * \param [out] n The number of instances in the container.
+     * \returns true if the value could be obtained successfully.
+     */
+    bool GetN(const ObjectBase* object, std::size_t* n) const;
+    /**
+     * Get an instance from the container, identified by the index it
+     * has in an ObjectPtrContainerValue, without getting the other
+     * instances.
+     *
+     * \param [in] object The container object.
+     * \param [in] index The index of the instance.
+     * \param [out] value The instance.
+     * \returns true if the container has an instance with this index.
+     */
+    bool Find(const ObjectBase* object, std::size_t index, Ptr<Object>* value) const;
+
   private:
+    /**
+     * Find an instance from the container, identified by index.
+     *
+     * The default implementation goes through the instances with DoGet().
+     *
+     * \param [in] object The container object.
+     * \param [in] index The index of the instance.
+     * \param [out] value The instance.
+     * \returns true if the container has an instance with this index.
+     */
+    virtual bool DoFind(const ObjectBase* object, std::size_t index, Ptr<Object>* value) const;
     /**
      * Get the number of instances in the container.
      *
@@ -281,6 +312,18 @@ MakeObjectPtrContainerAccessor(Ptr<U> (T::*get)(INDEX) const, INDEX (T::*getN)()
             return (obj->*m_get)(i);
         }
 
+        bool DoFind(const ObjectBase* object, std::size_t index, Ptr<Object>* value) const override
+        {
+            std::size_t n;
+            if (!DoGetN(object, &n) || index >= n)
+            {
+                return false;
+            }
+            const T* obj = static_cast<const T*>(object);
+            *value = (obj->*m_get)(index);
+            return true;
+        }
+
         Ptr<U> (T::*m_get)(INDEX) const;
         INDEX (T::*m_getN)() const;
     }* spec = new MemberGetters();
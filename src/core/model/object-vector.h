@@ -24,6 +24,8 @@
 #include "object.h"
 #include "ptr.h"
 
+#include <iterator>
+
 /**
  * \file
  * \ingroup attribute_ObjectVector
@@ -109,6 +111,17 @@ MakeObjectVectorAccessor(U T::*memberVector)
             return nullptr;
         }
 
+        bool DoFind(const ObjectBase* object, std::size_t index, Ptr<Object>* value) const override
+        {
+            const T* obj = dynamic_cast<const T*>(object);
+            if (obj == nullptr || index >= (obj->*m_memberVector).size())
+            {
+                return false;
+            }
+            *value = *std::next((obj->*m_memberVector).begin(), index);
+            return true;
+        }
+
         U T::*m_memberVector;
     }* spec = new MemberStdContainer();
 
@@ -97,10 +97,13 @@ Object::Object()
       m_disposed(false),
       m_initialized(false),
       m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
-      m_getObjectCount(0)
+      m_getObjectCount(0),
+      m_aggregatePosition(0)
 {
     NS_LOG_FUNCTION(this);
     m_aggregates->n = 1;
+    m_aggregates->indexMask = 0;
+    m_aggregates->index = nullptr;
     m_aggregates->buffer[0] = this;
 }
 
@@ -118,8 +121,16 @@ Object::~Object()
                          &m_aggregates->buffer[i + 1],
                          sizeof(Object*) * (m_aggregates->n - (i + 1)));
             m_aggregates->n--;
+            for (uint32_t j = i; j < m_aggregates->n; j++)
+            {
+                m_aggregates->buffer[j]->m_aggregatePosition = j;
+            }
         }
     }
+    // the index refers to this object: the remaining objects,
+    // which are about to be deleted too, do without it
+    delete[] m_aggregates->index;
+    m_aggregates->index = nullptr;
     // finally, if all objects have been removed from the list,
     // delete the aggregate list
     if (m_aggregates->n == 0)
@@ -134,9 +145,12 @@ Object::Object(const Object& o)
       m_disposed(false),
       m_initialized(false),
       m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
-      m_getObjectCount(0)
+      m_getObjectCount(0),
+      m_aggregatePosition(0)
 {
     m_aggregates->n = 1;
+    m_aggregates->indexMask = 0;
+    m_aggregates->index = nullptr;
     m_aggregates->buffer[0] = this;
 }
 
@@ -153,6 +167,16 @@ Object::DoGetObject(TypeId tid) const
     NS_LOG_FUNCTION(this << tid);
     NS_ASSERT(CheckLoose());
 
+    Object* found;
+    if (LookupAggregate(tid, &found))
+    {
+        if (found != nullptr)
+        {
+            CountAggregateAccess(found);
+        }
+        return found;
+    }
+
     uint32_t n = m_aggregates->n;
     TypeId objectTid = Object::GetTypeId();
     for (uint32_t i = 0; i < n; i++)
@@ -182,6 +206,90 @@ Object::DoGetObject(TypeId tid) const
     return nullptr;
 }
 
+bool
+Object::LookupAggregate(TypeId tid, Object** found) const
+{
+    const Aggregates* aggregates = m_aggregates;
+    if (aggregates->index == nullptr)
+    {
+        return false;
+    }
+    uint16_t uid = tid.GetUid();
+    for (uint32_t i = uid & aggregates->indexMask;; i = (i + 1) & aggregates->indexMask)
+    {
+        const IndexEntry& entry = aggregates->index[i];
+        if (entry.uid == uid)
+        {
+            *found = entry.object;
+            return entry.object != nullptr;
+        }
+        if (entry.uid == 0)
+        {
+            *found = nullptr;
+            return true;
+        }
+    }
+}
+
+void
+Object::CountAggregateAccess(Object* current) const
+{
+    // Same 'cache' heuristic as DoGetObject, now that the index makes the
+    // lookups independent of the order of the aggregates: the order is kept
+    // because it is also the order of AggregateIterator, Initialize and Dispose.
+    current->m_getObjectCount++;
+    UpdateSortedArray(m_aggregates, current->m_aggregatePosition);
+}
+
+void
+Object::BuildAggregateIndex(Aggregates* aggregates)
+{
+    NS_LOG_FUNCTION(aggregates);
+    // the TypeIds of each aggregate, from its instance TypeId up to Object
+    std::vector<std::pair<uint16_t, Object*>> types;
+    TypeId objectTid = Object::GetTypeId();
+    for (uint32_t i = 0; i < aggregates->n; i++)
+    {
+        Object* current = aggregates->buffer[i];
+        TypeId cur = current->GetInstanceTypeId();
+        types.emplace_back(cur.GetUid(), current);
+        while (cur != objectTid && cur.HasParent())
+        {
+            cur = cur.GetParent();
+            types.emplace_back(cur.GetUid(), current);
+        }
+    }
+
+    // at most half full, to keep the probe sequences short
+    uint32_t size = 4;
+    while (size < 2 * types.size())
+    {
+        size *= 2;
+    }
+    delete[] aggregates->index;
+    aggregates->index = new IndexEntry[size]();
+    aggregates->indexMask = size - 1;
+    for (const auto& [uid, object] : types)
+    {
+        uint32_t i = uid & aggregates->indexMask;
+        while (aggregates->index[i].uid != 0 && aggregates->index[i].uid != uid)
+        {
+            i = (i + 1) & aggregates->indexMask;
+        }
+        IndexEntry& entry = aggregates->index[i];
+        if (entry.uid == 0)
+        {
+            entry.uid = uid;
+            entry.object = object;
+        }
+        else
+        {
+            // several aggregates have this TypeId: DoGetObject picks one
+            entry.object = nullptr;
+        }
+    }
+}
+
 void
 Object::Initialize()
 {
@@ -245,12 +353,19 @@ void
 Object::UpdateSortedArray(Aggregates* aggregates, uint32_t j) const
 {
     NS_LOG_FUNCTION(this << aggregates << j);
+    // the positions are those in the array assigned to the objects
+    bool assigned = aggregates->buffer[j]->m_aggregates == aggregates;
     while (j > 0 &&
            aggregates->buffer[j]->m_getObjectCount > aggregates->buffer[j - 1]->m_getObjectCount)
     {
         Object* tmp = aggregates->buffer[j - 1];
         aggregates->buffer[j - 1] = aggregates->buffer[j];
         aggregates->buffer[j] = tmp;
+        if (assigned)
+        {
+            aggregates->buffer[j - 1]->m_aggregatePosition = j - 1;
+            aggregates->buffer[j]->m_aggregatePosition = j;
+        }
         j--;
     }
 }
@@ -269,6 +384,8 @@ Object::AggregateObject(Ptr<Object> o)
     uint32_t total = m_aggregates->n + other->m_aggregates->n;
     auto aggregates = (Aggregates*)std::malloc(sizeof(Aggregates) + (total - 1) * sizeof(Object*));
     aggregates->n = total;
+    aggregates->indexMask = 0;
+    aggregates->index = nullptr;
 
     // copy our buffer to the new buffer
     std::memcpy(&aggregates->buffer[0],
@@ -294,12 +411,14 @@ Object::AggregateObject(Ptr<Object> o)
     Aggregates* a = m_aggregates;
     Aggregates* b = other->m_aggregates;
 
-    // Then, assign the new aggregation buffer to every object
+    // Then, index the new aggregation buffer and assign it to every object
+    BuildAggregateIndex(aggregates);
     uint32_t n = aggregates->n;
     for (uint32_t i = 0; i < n; i++)
     {
         Object* current = aggregates->buffer[i];
         current->m_aggregates = aggregates;
+        current->m_aggregatePosition = i;
     }
 
     // Finally, call NotifyNewAggregate on all the objects aggregates together.
@@ -319,6 +438,8 @@ Object::AggregateObject(Ptr<Object> o)
     }
 
     // Now that we are done with them, we can free our old aggregate buffers
+    delete[] a->index;
+    delete[] b->index;
     std::free(a);
     std::free(b);
 }
@@ -346,6 +467,10 @@ Object::SetTypeId(TypeId tid)
     NS_LOG_FUNCTION(this << tid);
     NS_ASSERT(Check());
     m_tid = tid;
+    if (m_aggregates->index != nullptr)
+    {
+        BuildAggregateIndex(m_aggregates);
+    }
 }
 
 void
@@ -331,6 +331,13 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
 
     /**@}*/
 
+    /** An entry of the index of the aggregates by TypeId. */
+    struct IndexEntry
+    {
+        uint16_t uid;   //!< The TypeId uid, or zero for an empty entry.
+        Object* object; //!< The aggregate, or \c nullptr if several aggregates have this TypeId.
+    };
+
     /**
      * The list of Objects aggregated to this one.
      *
@@ -342,11 +349,21 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      * chunk of memory than the struct to allow space for a larger
      * variable sized buffer whose size is indicated by the element
      * \c n
+     *
+     * Once Objects are aggregated, the list also holds an index of
+     * the aggregates by TypeId, which maps the uid of the TypeId of each
+     * aggregate, and of all its parents, to the aggregate. The index
+     * is an open addressing hash table, whose entries with a zero uid
+     * are empty (no TypeId has the uid zero).
      */
     struct Aggregates
     {
         /** The number of entries in \c buffer. */
         uint32_t n;
+        /** The size of \c index minus one, the size being a power of two. */
+        uint32_t indexMask;
+        /** The index of the aggregates by TypeId, or \c nullptr. */
+        IndexEntry* index;
         /** The array of Objects. */
         Object* buffer[1];
     };
@@ -358,6 +375,28 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      * \return The matching Object, if it is found
      */
     Ptr<Object> DoGetObject(TypeId tid) const;
+    /**
+     * Find an Object of TypeId tid in the index of the aggregates of this Object.
+     *
+     * \param [in] tid The TypeId we're looking for
+     * \param [out] found The matching Object, or \c nullptr if no aggregate has this TypeId
+     * \return \c false if the index can't tell, because this Object was never
+     *         aggregated, or because several aggregates have this TypeId.
+     */
+    bool LookupAggregate(TypeId tid, Object** found) const;
+    /**
+     * Count an access to an aggregate with GetObject(), and keep the list
+     * of aggregates in most-recently-used order.
+     *
+     * \param [in] current The aggregate.
+     */
+    void CountAggregateAccess(Object* current) const;
+    /**
+     * Build the index by TypeId of a list of aggregates.
+     *
+     * \param [in,out] aggregates The list of aggregated Objects.
+     */
+    static void BuildAggregateIndex(Aggregates* aggregates);
     /**
      * Verify that this Object is still live, by checking it's reference count.
      * \return \c true if the reference count is non zero.
@@ -444,6 +483,10 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      * the array of aggregates in most-frequently accessed order.
      */
     uint32_t m_getObjectCount;
+    /**
+     * The position of this Object in the array of aggregates.
+     */
+    uint32_t m_aggregatePosition;
 };
 
 template <typename T>
@@ -470,6 +513,18 @@ template <typename T>
 Ptr<T>
 Object::GetObject() const
 {
+    // If this Object is aggregated, the index of the aggregates tells
+    // which one, if any, is a T.
+    Object* found;
+    if (LookupAggregate(T::GetTypeId(), &found))
+    {
+        // Like the cast below, do not count the accesses to the first aggregate
+        if (found != nullptr && found != m_aggregates->buffer[0])
+        {
+            CountAggregateAccess(found);
+        }
+        return Ptr<T>(static_cast<T*>(found));
+    }
     // This is an optimization: if the cast works (which is likely),
     // things will be pretty fast.
     T* result = dynamic_cast<T*>(m_aggregates->buffer[0]);
@@ -478,10 +533,10 @@ Object::GetObject() const
         return Ptr<T>(result);
     }
     // if the cast does not work, we try to do a full type check.
-    Ptr<Object> found = DoGetObject(T::GetTypeId());
-    if (found)
+    Ptr<Object> object = DoGetObject(T::GetTypeId());
+    if (object)
     {
-        return Ptr<T>(static_cast<T*>(PeekPointer(found)));
+        return Ptr<T>(static_cast<T*>(PeekPointer(object)));
     }
     return nullptr;
 }
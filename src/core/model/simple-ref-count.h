@@ -23,6 +23,7 @@
 
 #include "assert.h"
 #include "default-deleter.h"
+#include "multithreading.h"
 
 #include <limits>
 #include <stdint.h>
@@ -125,8 +126,7 @@ class SimpleRefCount : public PARENT
      */
     inline void Unref() const
     {
-        m_count--;
-        if (m_count == 0)
+        if (--m_count == 0)
         {
             DELETER::Delete(static_cast<T*>(const_cast<SimpleRefCount*>(this)));
         }
@@ -149,9 +149,11 @@ class SimpleRefCount : public PARENT
      *
      * \internal
      * Note we make this mutable so that the const methods can still
-     * change it.
+     * change it. When ns-3 is built with multithreaded simulation
+     * support (NS3_MTP), the count is atomic since the objects can be
+     * shared by the threads of the MultithreadedSimulatorImpl.
      */
-    mutable uint32_t m_count;
+    mutable MtpAtomic<uint32_t> m_count;
 };
 
 } // namespace ns3
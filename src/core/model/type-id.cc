@@ -20,14 +20,21 @@
 
 #include "hash.h"
 #include "log.h" // NS_ASSERT and NS_LOG
+#include "multithreading.h"
 #include "singleton.h"
 #include "trace-source-accessor.h"
 
 #include <iomanip>
 #include <map>
+#include <memory>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <mutex>
+#endif
+
 /**
  * \file
  * \ingroup object
@@ -172,6 +179,12 @@ class IidManager : public Singleton<IidManager>
      * \returns The total number.
      */
     uint16_t GetRegisteredN() const;
+    /**
+     * Get the generation of the type ids.
+     * \returns The number of times an Attribute, a TraceSource or a parent
+     *          was added to a type id.
+     */
+    uint32_t GetGeneration() const;
     /**
      * Get a type id by index.
      *
@@ -263,6 +276,24 @@ class IidManager : public Singleton<IidManager>
      * \returns Detailed information about the requested trace source.
      */
     TypeId::TraceSourceInformation GetTraceSource(uint16_t uid, std::size_t i) const;
+    /**
+     * Find an Attribute of a type id, or of its parents, by name.
+     * \param [in] uid The id.
+     * \param [in] name The Attribute name.
+     * \param [out] owner The id of the type which defines the Attribute.
+     * \param [out] i The index of the Attribute in \pname{owner}.
+     * \returns \c true if the Attribute was found.
+     */
+    bool FindAttribute(uint16_t uid, const std::string& name, uint16_t* owner, std::size_t* i);
+    /**
+     * Find a TraceSource of a type id, or of its parents, by name.
+     * \param [in] uid The id.
+     * \param [in] name The TraceSource name.
+     * \param [out] owner The id of the type which defines the TraceSource.
+     * \param [out] i The index of the TraceSource in \pname{owner}.
+     * \returns \c true if the TraceSource was found.
+     */
+    bool FindTraceSource(uint16_t uid, const std::string& name, uint16_t* owner, std::size_t* i);
     /**
      * Check if this TypeId should not be listed in documentation.
      * \param [in] uid The id.
@@ -344,6 +375,45 @@ class IidManager : public Singleton<IidManager>
     /** The by-hash index. */
     hashmap_t m_hashmap;
 
+    /** The id of the type defining an Attribute or a TraceSource, and its index in this type. */
+    typedef std::pair<uint16_t, std::size_t> Location;
+
+    /** The by-name index of the Attributes and TraceSources of a type id and of its parents. */
+    struct NameIndex
+    {
+        /** The Attributes. */
+        std::unordered_map<std::string, Location> attributes;
+        /** The TraceSources. */
+        std::unordered_map<std::string, Location> traceSources;
+    };
+
+    /**
+     * Get the by-name index of a type id, building it if needed.
+     * \param [in] uid The id.
+     * \returns The index.
+     */
+    const NameIndex& GetNameIndex(uint16_t uid);
+    /**
+     * Discard the by-name indexes, which are outdated when an Attribute,
+     * a TraceSource or a parent is added to a type id.
+     */
+    void ClearNameIndexes();
+
+    /**
+     * The by-name indexes, built on demand by GetNameIndex(), by type id.
+     *
+     * Looking up the Attributes and TraceSources by name (e.g., by
+     * ObjectBase::SetAttribute() and by the Config paths) would otherwise
+     * copy the information of each Attribute of the type and its parents.
+     */
+    std::vector<std::unique_ptr<NameIndex>> m_nameIndexes;
+    /** The generation of the type ids, incremented by ClearNameIndexes(). */
+    MtpAtomic<uint32_t> m_generation{0};
+#ifdef NS3_MTP
+    /** Serialize the access to the by-name indexes. */
+    std::mutex m_nameIndexMutex;
+#endif
+
     /** IidManager constants. */
     enum
     {
@@ -468,6 +538,7 @@ IidManager::SetParent(uint16_t uid, uint16_t parent)
     NS_ASSERT(parent <= m_information.size());
     IidInformation* information = LookupInformation(uid);
     information->parent = parent;
+    ClearNameIndexes();
 }
 
 void
@@ -613,6 +684,13 @@ IidManager::GetRegisteredN() const
     return static_cast<uint16_t>(m_information.size());
 }
 
+uint32_t
+IidManager::GetGeneration() const
+{
+    NS_LOG_FUNCTION(IID);
+    return m_generation;
+}
+
 uint16_t
 IidManager::GetRegistered(uint16_t i) const
 {
@@ -685,6 +763,7 @@ IidManager::AddAttribute(uint16_t uid,
     info.supportLevel = supportLevel;
     info.supportMsg = supportMsg;
     information->attributes.push_back(info);
+    ClearNameIndexes();
     NS_LOG_LOGIC(IIDL << information->attributes.size() - 1);
 }
 
@@ -773,6 +852,7 @@ IidManager::AddTraceSource(uint16_t uid,
     source.supportLevel = supportLevel;
     source.supportMsg = supportMsg;
     information->traceSources.push_back(source);
+    ClearNameIndexes();
     NS_LOG_LOGIC(IIDL << information->traceSources.size() - 1);
 }
 
@@ -796,6 +876,97 @@ IidManager::GetTraceSource(uint16_t uid, std::size_t i) const
     return information->traceSources[i];
 }
 
+const IidManager::NameIndex&
+IidManager::GetNameIndex(uint16_t uid)
+{
+    NS_LOG_FUNCTION(IID << uid);
+    if (m_nameIndexes.size() < uid)
+    {
+        m_nameIndexes.resize(m_information.size());
+    }
+    std::unique_ptr<NameIndex>& index = m_nameIndexes[uid - 1];
+    if (!index)
+    {
+        index = std::make_unique<NameIndex>();
+        // Walk up the inheritance tree: the Attributes and TraceSources
+        // of a type are found before the ones of its parents
+        IidInformation* information = LookupInformation(uid);
+        uint16_t owner = uid;
+        while (true)
+        {
+            for (std::size_t i = 0; i < information->attributes.size(); i++)
+            {
+                index->attributes.emplace(information->attributes[i].name, Location(owner, i));
+            }
+            for (std::size_t i = 0; i < information->traceSources.size(); i++)
+            {
+                index->traceSources.emplace(information->traceSources[i].name, Location(owner, i));
+            }
+            IidInformation* parent = LookupInformation(information->parent);
+            if (parent == information)
+            {
+                // top of inheritance tree
+                break;
+            }
+            owner = information->parent;
+            information = parent;
+        }
+        NS_LOG_LOGIC(IIDL << index->attributes.size() << " " << index->traceSources.size());
+    }
+    return *index;
+}
+
+void
+IidManager::ClearNameIndexes()
+{
+    NS_LOG_FUNCTION(IID);
+#ifdef NS3_MTP
+    std::lock_guard<std::mutex> lock(m_nameIndexMutex);
+#endif
+    m_nameIndexes.clear();
+    m_generation++;
+}
+
+bool
+IidManager::FindAttribute(uint16_t uid, const std::string& name, uint16_t* owner, std::size_t* i)
+{
+    NS_LOG_FUNCTION(IID << uid << name);
+#ifdef NS3_MTP
+    std::lock_guard<std::mutex> lock(m_nameIndexMutex);
+#endif
+    const NameIndex& index = GetNameIndex(uid);
+    auto it = index.attributes.find(name);
+    if (it == index.attributes.end())
+    {
+        NS_LOG_LOGIC(IIDL << false);
+        return false;
+    }
+    *owner = it->second.first;
+    *i = it->second.second;
+    NS_LOG_LOGIC(IIDL << *owner << " " << *i);
+    return true;
+}
+
+bool
+IidManager::FindTraceSource(uint16_t uid, const std::string& name, uint16_t* owner, std::size_t* i)
+{
+    NS_LOG_FUNCTION(IID << uid << name);
+#ifdef NS3_MTP
+    std::lock_guard<std::mutex> lock(m_nameIndexMutex);
+#endif
+    const NameIndex& index = GetNameIndex(uid);
+    auto it = index.traceSources.find(name);
+    if (it == index.traceSources.end())
+    {
+        NS_LOG_LOGIC(IIDL << false);
+        return false;
+    }
+    *owner = it->second.first;
+    *i = it->second.second;
+    NS_LOG_LOGIC(IIDL << *owner << " " << *i);
+    return true;
+}
+
 bool
 IidManager::MustHideFromDocumentation(uint16_t uid) const
 {
@@ -881,6 +1052,13 @@ TypeId::GetRegisteredN()
     return IidManager::Get()->GetRegisteredN();
 }
 
+uint32_t
+TypeId::GetGeneration()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    return IidManager::Get()->GetGeneration();
+}
+
 TypeId
 TypeId::GetRegistered(uint16_t i)
 {
@@ -892,38 +1070,24 @@ bool
 TypeId::LookupAttributeByName(std::string name, TypeId::AttributeInformation* info) const
 {
     NS_LOG_FUNCTION(this << name << info);
-    TypeId tid;
-    TypeId nextTid = *this;
-    do
+    uint16_t owner;
+    std::size_t i;
+    if (!IidManager::Get()->FindAttribute(m_tid, name, &owner, &i))
     {
-        tid = nextTid;
-        for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
-        {
-            TypeId::AttributeInformation tmp = tid.GetAttribute(i);
-            if (tmp.name == name)
-            {
-                if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                    *info = tmp;
-                    return true;
-                }
-                else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                    std::cerr << "Attribute '" << name << "' is deprecated: " << tmp.supportMsg
-                              << std::endl;
-                    *info = tmp;
-                    return true;
-                }
-                else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                    NS_FATAL_ERROR("Attribute '" << name << "' is obsolete, with no fallback: "
-                                                 << tmp.supportMsg);
-                }
-            }
-        }
-        nextTid = tid.GetParent();
-    } while (nextTid != tid);
-    return false;
+        return false;
+    }
+    TypeId::AttributeInformation tmp = IidManager::Get()->GetAttribute(owner, i);
+    if (tmp.supportLevel == TypeId::DEPRECATED)
+    {
+        std::cerr << "Attribute '" << name << "' is deprecated: " << tmp.supportMsg << std::endl;
+    }
+    else if (tmp.supportLevel == TypeId::OBSOLETE)
+    {
+        NS_FATAL_ERROR("Attribute '" << name << "' is obsolete, with no fallback: "
+                                     << tmp.supportMsg);
+    }
+    *info = tmp;
+    return true;
 }
 
 TypeId
@@ -1158,39 +1322,25 @@ Ptr<const TraceSourceAccessor>
 TypeId::LookupTraceSourceByName(std::string name, TraceSourceInformation* info) const
 {
     NS_LOG_FUNCTION(this << name);
-    TypeId tid;
-    TypeId nextTid = *this;
-    TypeId::TraceSourceInformation tmp;
-    do
+    uint16_t owner;
+    std::size_t i;
+    if (!IidManager::Get()->FindTraceSource(m_tid, name, &owner, &i))
     {
-        tid = nextTid;
-        for (std::size_t i = 0; i < tid.GetTraceSourceN(); i++)
-        {
-            tmp = tid.GetTraceSource(i);
-            if (tmp.name == name)
-            {
-                if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                    *info = tmp;
-                    return tmp.accessor;
-                }
-                else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                    std::cerr << "TraceSource '" << name << "' is deprecated: " << tmp.supportMsg
-                              << std::endl;
-                    *info = tmp;
-                    return tmp.accessor;
-                }
-                else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                    NS_FATAL_ERROR("TraceSource '" << name << "' is obsolete, with no fallback: "
-                                                   << tmp.supportMsg);
-                }
-            }
-        }
-        nextTid = tid.GetParent();
-    } while (nextTid != tid);
-    return nullptr;
+        return nullptr;
+    }
+    TypeId::TraceSourceInformation tmp = IidManager::Get()->GetTraceSource(owner, i);
+    if (tmp.supportLevel == TypeId::DEPRECATED)
+    {
+        std::cerr << "TraceSource '" << name << "' is deprecated: " << tmp.supportMsg
+                  << std::endl;
+    }
+    else if (tmp.supportLevel == TypeId::OBSOLETE)
+    {
+        NS_FATAL_ERROR("TraceSource '" << name << "' is obsolete, with no fallback: "
+                                       << tmp.supportMsg);
+    }
+    *info = tmp;
+    return tmp.accessor;
 }
 
 Ptr<const TraceSourceAccessor>
@@ -164,6 +164,17 @@ class TypeId
      * \returns The number of TypeId instances registered.
      */
     static uint16_t GetRegisteredN();
+    /**
+     * Get the generation of the registered TypeIds, which changes each time
+     * an Attribute, a TraceSource or a parent is added to a TypeId.
+     *
+     * This allows the caches of the Attributes of the TypeIds to be
+     * invalidated. This is an internal method, which users are not
+     * expected to use.
+     *
+     * \returns The generation.
+     */
+    static uint32_t GetGeneration();
     /**
      * Get a TypeId by index.
      *
@@ -0,0 +1,279 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/campaign-runner.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-path.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * CampaignRunner test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup campaign-runner-tests CampaignRunner test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup campaign-runner-tests
+ * Run a campaign, and check the parameters and the results of the runs.
+ */
+class CampaignRunnerTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    CampaignRunnerTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Execute a run: write its parameters, and fail the runs of the value
+     * "fail" of the parameter "b".
+     * \param [in] run The run.
+     * \returns The exit status of the run.
+     */
+    static int RunSimulation(const CampaignRunner::Run& run);
+    /** Record the time of the simulation. */
+    static void RecordTime();
+
+    static double m_time; //!< The time of the simulation, when it stopped.
+};
+
+double CampaignRunnerTestCase::m_time = 0;
+
+CampaignRunnerTestCase::CampaignRunnerTestCase()
+    : TestCase("Run a campaign over a grid of parameters")
+{
+}
+
+void
+CampaignRunnerTestCase::RecordTime()
+{
+    m_time = Simulator::Now().GetSeconds();
+}
+
+int
+CampaignRunnerTestCase::RunSimulation(const CampaignRunner::Run& run)
+{
+    Simulator::Schedule(Seconds(run.replication + 1), &CampaignRunnerTestCase::RecordTime);
+    Simulator::Run();
+    Ptr<ConstantRandomVariable> constant = CreateObject<ConstantRandomVariable>();
+    // relative to the directory of the run
+    std::ofstream file("result.txt");
+    file << run.Get("b") << " " << constant->GetValue() << " " << RngSeedManager::GetRun()
+         << " " << m_time;
+    return run.Get("b") == "fail" ? 3 : 0;
+}
+
+void
+CampaignRunnerTestCase::DoRun()
+{
+    std::string directory = CreateTempDirFilename("campaign");
+    Ptr<CampaignRunner> campaign = CreateObject<CampaignRunner>();
+    campaign->SetAttribute("OutputDirectory", StringValue(directory));
+    campaign->SetAttribute("Parallel", UintegerValue(3));
+    campaign->SetAttribute("Replications", UintegerValue(2));
+    campaign->SetAttribute("FirstRun", UintegerValue(5));
+    campaign->AddParameter("ns3::ConstantRandomVariable::Constant", {"1.5", "2"});
+    campaign->AddParameter("b", {"x", "fail", "z"});
+    NS_TEST_ASSERT_MSG_EQ(campaign->GetNRuns(), 12, "Wrong number of runs");
+
+    CampaignRunner::Run run = campaign->GetRun(7);
+    NS_TEST_EXPECT_MSG_EQ(run.replication, 1, "Wrong replication");
+    NS_TEST_EXPECT_MSG_EQ(run.runNumber, 6, "Wrong run number");
+    NS_TEST_EXPECT_MSG_EQ(run.Get("ns3::ConstantRandomVariable::Constant"), "2", "Wrong value");
+    NS_TEST_EXPECT_MSG_EQ(run.Get("b"), "x", "Wrong value");
+    NS_TEST_EXPECT_MSG_EQ(run.directory,
+                          SystemPath::Append(
+                              SystemPath::Append(SystemPath::Append(directory, "Constant=2"),
+                                                 "b=x"),
+                              "run-6"),
+                          "Wrong directory");
+
+    uint32_t nFailed = campaign->Execute(MakeCallback(&CampaignRunnerTestCase::RunSimulation));
+    NS_TEST_EXPECT_MSG_EQ(nFailed, 4, "Wrong number of failed runs");
+    for (uint32_t i = 0; i < campaign->GetNRuns(); i++)
+    {
+        run = campaign->GetRun(i);
+        int status = run.Get("b") == "fail" ? 3 : 0;
+        NS_TEST_EXPECT_MSG_EQ(campaign->GetStatus(i), status, "Wrong status of run " << i);
+        std::ifstream file(SystemPath::Append(run.directory, "result.txt"));
+        std::ostringstream result;
+        result << file.rdbuf();
+        std::ostringstream expected;
+        expected << run.Get("b") << " " << run.Get("ns3::ConstantRandomVariable::Constant")
+                 << " " << run.runNumber << " " << run.replication + 1;
+        NS_TEST_EXPECT_MSG_EQ(result.str(), expected.str(), "Wrong result of run " << i);
+    }
+    std::ifstream summary(SystemPath::Append(directory, "campaign.csv"));
+    std::string line;
+    std::getline(summary, line);
+    NS_TEST_EXPECT_MSG_EQ(line,
+                          "index,replication,run,ns3::ConstantRandomVariable::Constant,b,"
+                          "status,directory",
+                          "Wrong summary header");
+    std::getline(summary, line);
+    NS_TEST_EXPECT_MSG_EQ(line,
+                          "0,0,5,1.5,x,0," + campaign->GetRun(0).directory,
+                          "Wrong summary line");
+
+    // the runs do not change the state of this process
+    NS_TEST_EXPECT_MSG_EQ(m_time, 0, "The simulation ran in this process");
+    Ptr<ConstantRandomVariable> constant = CreateObject<ConstantRandomVariable>();
+    NS_TEST_EXPECT_MSG_EQ(constant->GetValue(), 0, "The defaults of this process changed");
+}
+
+/**
+ * \ingroup campaign-runner-tests
+ * Branch runs from a running simulation, and check that they continue it.
+ */
+class CampaignRunnerBranchTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    CampaignRunnerBranchTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Configure a branch.
+     * \param [in] run The run of the branch.
+     * \returns The exit status of the run, to end the branch, or 0.
+     */
+    static int ConfigureBranch(const CampaignRunner::Run& run);
+    /** Count the events of the warm-up, and of the branches. */
+    static void CountEvent();
+
+    static uint32_t m_nEvents; //!< The number of events.
+    static uint32_t m_step;    //!< The number of events counted by each event.
+};
+
+uint32_t CampaignRunnerBranchTestCase::m_nEvents = 0;
+uint32_t CampaignRunnerBranchTestCase::m_step = 1;
+
+CampaignRunnerBranchTestCase::CampaignRunnerBranchTestCase()
+    : TestCase("Branch runs from a running simulation")
+{
+}
+
+void
+CampaignRunnerBranchTestCase::CountEvent()
+{
+    m_nEvents += m_step;
+}
+
+int
+CampaignRunnerBranchTestCase::ConfigureBranch(const CampaignRunner::Run& run)
+{
+    m_step = std::stoul(run.Get("step"));
+    return run.Get("step") == "0" ? 4 : 0;
+}
+
+void
+CampaignRunnerBranchTestCase::DoRun()
+{
+    std::string directory = CreateTempDirFilename("branches");
+    Ptr<CampaignRunner> campaign = CreateObject<CampaignRunner>();
+    campaign->SetAttribute("OutputDirectory", StringValue(directory));
+    campaign->SetAttribute("Parallel", UintegerValue(2));
+    campaign->SetAttribute("Replications", UintegerValue(2));
+    campaign->AddParameter("step", {"0", "10", "100"});
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        Simulator::Schedule(Seconds(i), &CampaignRunnerBranchTestCase::CountEvent);
+    }
+    // the branches run the events at 2 and 3 seconds
+    campaign->ScheduleBranches(Seconds(1.5), MakeCallback(&ConfigureBranch));
+    Simulator::Run();
+    if (campaign->IsBranch())
+    {
+        // relative to the directory of the run
+        std::ofstream file("result.txt");
+        file << m_nEvents << " " << Simulator::Now().GetSeconds() << " "
+             << RngSeedManager::GetRun();
+        file.close();
+        // the branch must not run the other tests
+        std::_Exit(0);
+    }
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nEvents, 2, "The branches ran in this process");
+    NS_TEST_EXPECT_MSG_EQ(campaign->GetNFailed(), 2, "Wrong number of failed runs");
+    for (uint32_t i = 0; i < campaign->GetNRuns(); i++)
+    {
+        CampaignRunner::Run run = campaign->GetRun(i);
+        uint32_t step = std::stoul(run.Get("step"));
+        int status = step == 0 ? 4 : 0;
+        NS_TEST_EXPECT_MSG_EQ(campaign->GetStatus(i), status, "Wrong status of run " << i);
+        if (step == 0)
+        {
+            continue;
+        }
+        std::ifstream file(SystemPath::Append(run.directory, "result.txt"));
+        std::ostringstream result;
+        result << file.rdbuf();
+        std::ostringstream expected;
+        expected << 2 + 2 * step << " 3 " << run.runNumber;
+        NS_TEST_EXPECT_MSG_EQ(result.str(), expected.str(), "Wrong result of run " << i);
+    }
+}
+
+/**
+ * \ingroup campaign-runner-tests
+ * CampaignRunner test suite.
+ */
+class CampaignRunnerTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    CampaignRunnerTestSuite();
+};
+
+CampaignRunnerTestSuite::CampaignRunnerTestSuite()
+    : TestSuite("campaign-runner", UNIT)
+{
+    AddTestCase(new CampaignRunnerTestCase());
+    AddTestCase(new CampaignRunnerBranchTestCase());
+}
+
+/**
+ * \ingroup campaign-runner-tests
+ * CampaignRunnerTestSuite instance variable.
+ */
+static CampaignRunnerTestSuite g_campaignRunnerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -292,6 +292,30 @@ DerivedConfigObject::GetTypeId()
     return tid;
 }
 
+/**
+ * \ingroup config-tests
+ * An object whose pointer Attribute is added by the test, after its type id
+ * is registered.
+ */
+class LateAttributeConfigObject : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    Ptr<ConfigTestObject> m_late; //!< Late Attribute target.
+};
+
+TypeId
+LateAttributeConfigObject::GetTypeId()
+{
+    static TypeId tid = TypeId("LateAttributeConfigObject").SetParent<Object>();
+    return tid;
+}
+
 /**
  * \ingroup config-tests
  * Test for the ability to register and use a root namespace.
@@ -864,6 +888,172 @@ SearchAttributesOfParentObjectsTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(iv.Get(), 42, "Object Attribute \"X\" not settable in derived class");
 }
 
+/**
+ * \ingroup config-tests
+ * Test for the resolution of compiled paths, relative to the root
+ * namespace or to given objects.
+ */
+class CompiledPathConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    CompiledPathConfigTestCase();
+
+    /** Destructor. */
+    ~CompiledPathConfigTestCase() override
+    {
+    }
+
+    /**
+     * Trace callback with context path.
+     * \param path The context path.
+     * \param old The old value.
+     * \param newValue The new value.
+     */
+    void TraceWithPath(std::string path, int16_t old [[maybe_unused]], int16_t newValue)
+    {
+        m_newValue = newValue;
+        m_path = path;
+    }
+
+  private:
+    void DoRun() override;
+
+    int16_t m_newValue; //!< Flag to detect tracing result.
+    std::string m_path; //!< The context path.
+};
+
+CompiledPathConfigTestCase::CompiledPathConfigTestCase()
+    : TestCase("Check the resolution of compiled paths")
+{
+}
+
+void
+CompiledPathConfigTestCase::DoRun()
+{
+    IntegerValue iv;
+
+    //
+    // Two roots, each one with an object holding six objects in its
+    // ObjectVector Attribute.
+    //
+    Ptr<ConfigTestObject> root0 = CreateObject<ConfigTestObject>();
+    Ptr<ConfigTestObject> root1 = CreateObject<ConfigTestObject>();
+    std::vector<Ptr<ConfigTestObject>> objects;
+    for (auto root : {root0, root1})
+    {
+        Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject>();
+        root->SetNodeA(a);
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            Ptr<ConfigTestObject> obj = CreateObject<ConfigTestObject>();
+            a->AddNodeB(obj);
+            objects.push_back(obj);
+        }
+    }
+
+    //
+    // Resolve the same path relative to both roots: the overlapping ranges
+    // match each object once, in the order of the indices.
+    //
+    Config::CompiledPath path("NodeA/NodesB/[1-2]|4|[2-3]");
+    Config::MatchContainer matches = path.LookupMatches({root0, root1}, {"/Root/0", "/Root/1/"});
+    NS_TEST_ASSERT_MSG_EQ(matches.GetN(), 8, "Unexpected number of matches");
+    NS_TEST_ASSERT_MSG_EQ(matches.Get(0), objects[1], "Unexpected first match");
+    NS_TEST_ASSERT_MSG_EQ(matches.Get(3), objects[4], "Unexpected fourth match");
+    NS_TEST_ASSERT_MSG_EQ(matches.Get(4), objects[7], "Unexpected fifth match");
+    NS_TEST_ASSERT_MSG_EQ(matches.GetMatchedPath(0),
+                          "/Root/0/NodeA/NodesB/1/",
+                          "Unexpected matched path");
+    NS_TEST_ASSERT_MSG_EQ(matches.GetMatchedPath(7),
+                          "/Root/1/NodeA/NodesB/4/",
+                          "Unexpected matched path");
+
+    matches = Config::CompiledPath("NodeA/NodesB/6").LookupMatches({root0}, {""});
+    NS_TEST_ASSERT_MSG_EQ(matches.GetN(), 0, "Index out of the vector matched");
+    matches = Config::CompiledPath("NodeA/NodesB/*").LookupMatches({root0}, {""});
+    NS_TEST_ASSERT_MSG_EQ(matches.GetN(), 6, "Unexpected number of matches");
+    NS_TEST_ASSERT_MSG_EQ(matches.GetMatchedPath(5),
+                          "/NodeA/NodesB/5/",
+                          "Unexpected matched path");
+
+    //
+    // Use a compiled path with the root namespace.
+    //
+    Config::RegisterRootNamespaceObject(root0);
+    Config::CompiledPath set("/NodeA/NodesB/0|5/A");
+    NS_TEST_ASSERT_MSG_EQ(set.GetPath(), "/NodeA/NodesB/0|5/A", "Unexpected path");
+    set.Set(IntegerValue(-20));
+    objects[0]->GetAttribute("A", iv);
+    NS_TEST_ASSERT_MSG_EQ(iv.Get(), -20, "Object Attribute \"A\" not set as expected");
+    objects[5]->GetAttribute("A", iv);
+    NS_TEST_ASSERT_MSG_EQ(iv.Get(), -20, "Object Attribute \"A\" not set as expected");
+    objects[1]->GetAttribute("A", iv);
+    NS_TEST_ASSERT_MSG_EQ(iv.Get(), 10, "Object Attribute \"A\" unexpectedly set");
+
+    Config::CompiledPath connect("/NodeA/NodesB/[4-5]/Source");
+    NS_TEST_ASSERT_MSG_EQ(connect.ConnectFailSafe(
+                              MakeCallback(&CompiledPathConfigTestCase::TraceWithPath, this)),
+                          true,
+                          "Could not connect the compiled path");
+    m_newValue = 0;
+    objects[5]->SetAttribute("Source", IntegerValue(-5));
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, -5, "Trace 5 did not fire as expected");
+    NS_TEST_ASSERT_MSG_EQ(m_path,
+                          "/NodeA/NodesB/5/Source",
+                          "Trace 5 did not provide expected context");
+    connect.Disconnect(MakeCallback(&CompiledPathConfigTestCase::TraceWithPath, this));
+    m_newValue = 0;
+    objects[4]->SetAttribute("Source", IntegerValue(-4));
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, 0, "Trace 4 fired after the disconnection");
+    Config::UnregisterRootNamespaceObject(root0);
+}
+
+/**
+ * \ingroup config-tests
+ * Test that an Attribute added to a type id after a path through this type
+ * was resolved is found by the next paths.
+ */
+class LateAttributeConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    LateAttributeConfigTestCase();
+
+    /** Destructor. */
+    ~LateAttributeConfigTestCase() override
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+LateAttributeConfigTestCase::LateAttributeConfigTestCase()
+    : TestCase("Check that the Attributes added after a resolution are found")
+{
+}
+
+void
+LateAttributeConfigTestCase::DoRun()
+{
+    Ptr<LateAttributeConfigObject> object = CreateObject<LateAttributeConfigObject>();
+    object->m_late = CreateObject<ConfigTestObject>();
+    Config::CompiledPath path("Late");
+    Config::MatchContainer matches = path.LookupMatches({object}, {""});
+    NS_TEST_ASSERT_MSG_EQ(matches.GetN(), 0, "Attribute matched before it was added");
+
+    TypeId tid = LateAttributeConfigObject::GetTypeId();
+    tid.AddAttribute("Late",
+                     "",
+                     PointerValue(),
+                     MakePointerAccessor(&LateAttributeConfigObject::m_late),
+                     MakePointerChecker<ConfigTestObject>());
+    matches = path.LookupMatches({object}, {""});
+    NS_TEST_ASSERT_MSG_EQ(matches.GetN(), 1, "Attribute not matched after it was added");
+    NS_TEST_ASSERT_MSG_EQ(matches.Get(0), object->m_late, "Unexpected match");
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -882,6 +1072,8 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
+    AddTestCase(new CompiledPathConfigTestCase);
+    AddTestCase(new LateAttributeConfigTestCase);
 }
 
 /**
@@ -0,0 +1,339 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/config.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \file
+ * \ingroup multithreaded-simulator-tests
+ * MultithreadedSimulatorImpl test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup multithreaded-simulator-tests MultithreadedSimulatorImpl tests
+ */
+
+/**
+ * \ingroup multithreaded-simulator-tests
+ *
+ * \brief Check that the events of each context are executed at the same
+ * time and in the same order as with the DefaultSimulatorImpl, when the
+ * contexts are run in different partitions exchanging events.
+ */
+class MultithreadedSimulatorOrderTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param threads The maximum number of threads.
+     * \param partitions The number of partitions.
+     */
+    MultithreadedSimulatorOrderTestCase(uint32_t threads, uint32_t partitions);
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Run the scenario with a simulator implementation.
+     *
+     * \param simulatorType The simulator implementation type.
+     * \return The events executed by each context.
+     */
+    std::vector<std::vector<std::pair<int64_t, uint32_t>>> RunScenario(
+        const std::string& simulatorType);
+    /**
+     * Periodic event of a context.
+     *
+     * \param context The context.
+     * \param count The number of previous ticks.
+     */
+    void Tick(uint32_t context, uint32_t count);
+    /**
+     * Event received from another context.
+     *
+     * \param context The context.
+     * \param from The sending context.
+     */
+    void Receive(uint32_t context, uint32_t from);
+    /** Event without context. */
+    void Global();
+
+    static constexpr uint32_t N_CONTEXTS = 4; //!< Number of contexts.
+
+    uint32_t m_threads;    //!< The maximum number of threads.
+    uint32_t m_partitions; //!< The number of partitions.
+    /** The time and the kind (sending context, or N_CONTEXTS for a tick) of each event */
+    std::vector<std::vector<std::pair<int64_t, uint32_t>>> m_events;
+    uint32_t m_globalContext; //!< The context of the last event without context.
+};
+
+MultithreadedSimulatorOrderTestCase::MultithreadedSimulatorOrderTestCase(uint32_t threads,
+                                                                         uint32_t partitions)
+    : TestCase("Check the event order with " + std::to_string(partitions) + " partitions and " +
+               std::to_string(threads) + " threads"),
+      m_threads(threads),
+      m_partitions(partitions),
+      m_globalContext(0)
+{
+}
+
+void
+MultithreadedSimulatorOrderTestCase::Tick(uint32_t context, uint32_t count)
+{
+    m_events[context].emplace_back(Simulator::Now().GetMicroSeconds(), N_CONTEXTS);
+    if (count % 3 == 0)
+    {
+        // the delay is above the lookahead, and never a multiple of the tick period
+        uint32_t peer = (context + 1) % N_CONTEXTS;
+        Simulator::ScheduleWithContext(peer,
+                                       MicroSeconds(1013),
+                                       &MultithreadedSimulatorOrderTestCase::Receive,
+                                       this,
+                                       peer,
+                                       context);
+    }
+    Simulator::Schedule(MicroSeconds(300),
+                        &MultithreadedSimulatorOrderTestCase::Tick,
+                        this,
+                        context,
+                        count + 1);
+}
+
+void
+MultithreadedSimulatorOrderTestCase::Receive(uint32_t context, uint32_t from)
+{
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetContext(), context, "Wrong context");
+    m_events[context].emplace_back(Simulator::Now().GetMicroSeconds(), from);
+}
+
+void
+MultithreadedSimulatorOrderTestCase::Global()
+{
+    m_globalContext = Simulator::GetContext();
+}
+
+std::vector<std::vector<std::pair<int64_t, uint32_t>>>
+MultithreadedSimulatorOrderTestCase::RunScenario(const std::string& simulatorType)
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue(simulatorType));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue(m_threads));
+    m_events.assign(N_CONTEXTS, {});
+    m_globalContext = 0;
+
+    Ptr<MultithreadedSimulatorImpl> impl =
+        DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+    if (impl)
+    {
+        for (uint32_t context = 0; context < N_CONTEXTS; context++)
+        {
+            impl->SetPartition(context, context % m_partitions);
+        }
+        impl->SetLookahead(MilliSeconds(1));
+    }
+
+    for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+        Simulator::ScheduleWithContext(context,
+                                       MicroSeconds(100 * context),
+                                       &MultithreadedSimulatorOrderTestCase::Tick,
+                                       this,
+                                       context,
+                                       0);
+    }
+    Simulator::Schedule(MicroSeconds(5050), &MultithreadedSimulatorOrderTestCase::Global, this);
+    Simulator::Stop(MilliSeconds(20));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MilliSeconds(20), "Wrong stop time");
+    NS_TEST_EXPECT_MSG_EQ(m_globalContext,
+                          Simulator::NO_CONTEXT,
+                          "Wrong context of the event without context");
+    if (impl)
+    {
+        NS_TEST_EXPECT_MSG_EQ(impl->GetNPartitions(), m_partitions, "Wrong number of partitions");
+    }
+    Simulator::Destroy();
+    return m_events;
+}
+
+void
+MultithreadedSimulatorOrderTestCase::DoRun()
+{
+    auto expected = RunScenario("ns3::DefaultSimulatorImpl");
+    auto events = RunScenario("ns3::MultithreadedSimulatorImpl");
+
+    for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(events[context].size(),
+                              expected[context].size(),
+                              "Wrong number of events in context " << context);
+        NS_TEST_EXPECT_MSG_GT(events[context].size(), 60, "Too few events");
+        for (std::size_t i = 0; i < events[context].size(); i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(events[context][i].first,
+                                  expected[context][i].first,
+                                  "Wrong time of event " << i << " in context " << context);
+            NS_TEST_EXPECT_MSG_EQ(events[context][i].second,
+                                  expected[context][i].second,
+                                  "Wrong event " << i << " in context " << context);
+        }
+    }
+}
+
+void
+MultithreadedSimulatorOrderTestCase::DoTeardown()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup multithreaded-simulator-tests
+ *
+ * \brief Check the cancellation and removal of events, and the
+ * expiration of their id, in a partition.
+ */
+class MultithreadedSimulatorEventIdTestCase : public TestCase
+{
+  public:
+    MultithreadedSimulatorEventIdTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /** Schedule events and remove or cancel some of them. */
+    void Start();
+    /**
+     * An event which must not be executed.
+     */
+    void Removed();
+    /**
+     * An event which must be executed.
+     */
+    void Executed();
+
+    EventId m_removed;    //!< Event removed by Start().
+    EventId m_cancelled;  //!< Event cancelled by Start().
+    EventId m_executed;   //!< Event executed.
+    uint32_t m_nExecuted; //!< Number of executed events.
+};
+
+MultithreadedSimulatorEventIdTestCase::MultithreadedSimulatorEventIdTestCase()
+    : TestCase("Check the event ids in a partition"),
+      m_nExecuted(0)
+{
+}
+
+void
+MultithreadedSimulatorEventIdTestCase::Start()
+{
+    m_removed = Simulator::Schedule(MilliSeconds(1),
+                                    &MultithreadedSimulatorEventIdTestCase::Removed,
+                                    this);
+    m_cancelled = Simulator::Schedule(MilliSeconds(2),
+                                      &MultithreadedSimulatorEventIdTestCase::Removed,
+                                      this);
+    m_executed = Simulator::Schedule(MilliSeconds(3),
+                                     &MultithreadedSimulatorEventIdTestCase::Executed,
+                                     this);
+    NS_TEST_EXPECT_MSG_EQ(m_executed.GetContext(), 2, "Wrong context of the event id");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetDelayLeft(m_executed),
+                          MilliSeconds(3),
+                          "Wrong delay left");
+    Simulator::Remove(m_removed);
+    Simulator::Cancel(m_cancelled);
+    NS_TEST_EXPECT_MSG_EQ(m_removed.IsExpired(), true, "Removed event not expired");
+    NS_TEST_EXPECT_MSG_EQ(m_cancelled.IsExpired(), true, "Cancelled event not expired");
+    NS_TEST_EXPECT_MSG_EQ(m_executed.IsExpired(), false, "Pending event expired");
+}
+
+void
+MultithreadedSimulatorEventIdTestCase::Removed()
+{
+    NS_TEST_EXPECT_MSG_EQ(true, false, "Removed event executed");
+}
+
+void
+MultithreadedSimulatorEventIdTestCase::Executed()
+{
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetContext(), 2, "Wrong context");
+    m_nExecuted++;
+}
+
+void
+MultithreadedSimulatorEventIdTestCase::DoRun()
+{
+    Config::SetGlobal("SimulatorImplementationType",
+                      StringValue("ns3::MultithreadedSimulatorImpl"));
+    Ptr<MultithreadedSimulatorImpl> impl =
+        DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_ASSERT_MSG_NE(impl, nullptr, "Wrong simulator implementation");
+    impl->SetPartition(1, 0);
+    impl->SetPartition(2, 1);
+    impl->SetLookahead(MilliSeconds(10));
+
+    Simulator::ScheduleWithContext(2,
+                                   MilliSeconds(1),
+                                   &MultithreadedSimulatorEventIdTestCase::Start,
+                                   this);
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nExecuted, 1, "Wrong number of executed events");
+    NS_TEST_EXPECT_MSG_EQ(m_executed.IsExpired(), true, "Executed event not expired");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MilliSeconds(4), "Wrong simulation end time");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount(), 3, "Wrong number of events");
+    Simulator::Destroy();
+}
+
+void
+MultithreadedSimulatorEventIdTestCase::DoTeardown()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup multithreaded-simulator-tests
+ *
+ * \brief The MultithreadedSimulatorImpl TestSuite.
+ */
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+  public:
+    MultithreadedSimulatorTestSuite()
+        : TestSuite("multithreaded-simulator")
+    {
+        AddTestCase(new MultithreadedSimulatorOrderTestCase(1, 1), TestCase::QUICK);
+        AddTestCase(new MultithreadedSimulatorOrderTestCase(1, 4), TestCase::QUICK);
+        AddTestCase(new MultithreadedSimulatorOrderTestCase(2, 4), TestCase::QUICK);
+        AddTestCase(new MultithreadedSimulatorOrderTestCase(4, 3), TestCase::QUICK);
+        AddTestCase(new MultithreadedSimulatorEventIdTestCase(), TestCase::QUICK);
+    }
+};
+
+/// Static variable for test initialization.
+static MultithreadedSimulatorTestSuite g_multithreadedSimulatorTestSuite;
@@ -464,6 +464,61 @@ AggregateObjectTestCase::DoRun()
     NS_TEST_ASSERT_MSG_NE(baseA, nullptr, "Unable to GetObject on released object");
 }
 
+/**
+ * \ingroup object-tests
+ * Test the lookups of the aggregates through the index by TypeId.
+ */
+class AggregateIndexTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    AggregateIndexTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+AggregateIndexTestCase::AggregateIndexTestCase()
+    : TestCase("Check the lookups of the aggregated Objects by TypeId")
+{
+}
+
+void
+AggregateIndexTestCase::DoRun()
+{
+    Ptr<DerivedA> derivedA = CreateObject<DerivedA>();
+    Ptr<DerivedB> derivedB = CreateObject<DerivedB>();
+    derivedA->AggregateObject(derivedB);
+
+    // the aggregates are found by their TypeId and by the TypeIds of their parents
+    NS_TEST_ASSERT_MSG_EQ(derivedA->GetObject<DerivedB>(), derivedB, "Cannot get DerivedB");
+    NS_TEST_ASSERT_MSG_EQ(derivedA->GetObject<BaseB>(), derivedB, "Cannot get BaseB");
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<BaseA>(), derivedA, "Cannot get BaseA");
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<DerivedA>(BaseA::GetTypeId()),
+                          derivedA,
+                          "Cannot get BaseA by TypeId");
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<Object>(), derivedB, "Cannot get Object");
+
+    // the aggregates aggregated later are indexed too
+    Ptr<BaseA> baseA = CreateObject<BaseA>();
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<DerivedB>(), nullptr, "Unexpected DerivedB");
+    baseA->AggregateObject(derivedA);
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<DerivedB>(), derivedB, "Cannot get DerivedB");
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<DerivedA>(), derivedA, "Cannot get DerivedA");
+
+    // BaseA and DerivedA both have the TypeId BaseA
+    Ptr<BaseA> found = derivedB->GetObject<BaseA>();
+    NS_TEST_ASSERT_MSG_EQ((found == baseA || found == derivedA), true, "Cannot get BaseA");
+
+    // the aggregates are still listed once, whatever the lookups
+    uint32_t n = 0;
+    for (auto i = baseA->GetAggregateIterator(); i.HasNext(); i.Next())
+    {
+        n++;
+    }
+    NS_TEST_ASSERT_MSG_EQ(n, 3, "Wrong number of aggregates");
+}
+
 /**
  * \ingroup object-tests
  * Test an Object factory can create Objects
@@ -565,6 +620,7 @@ ObjectTestSuite::ObjectTestSuite()
 {
     AddTestCase(new CreateObjectTestCase);
     AddTestCase(new AggregateObjectTestCase);
+    AddTestCase(new AggregateIndexTestCase);
     AddTestCase(new ObjectFactoryTestCase);
 }
 
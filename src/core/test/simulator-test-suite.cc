@@ -17,13 +17,21 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/calendar-scheduler.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/event-impl.h"
+#include "ns3/event-profiler.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
+#include "ns3/make-event.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <fstream>
+
 using namespace ns3;
 
 /**
@@ -707,6 +715,175 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief An event argument which counts its references.
+ */
+class SimulatorEventArgument : public SimpleRefCount<SimulatorEventArgument>
+{
+};
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the recycling of the EventImpl memory.
+ */
+class SimulatorEventMemoryTestCase : public TestCase
+{
+  public:
+    SimulatorEventMemoryTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Test Event.
+     * \param value Event parameter.
+     */
+    void Event(Ptr<const SimulatorEventArgument> value);
+
+    uint32_t m_events; //!< Number of events invoked.
+};
+
+SimulatorEventMemoryTestCase::SimulatorEventMemoryTestCase()
+    : TestCase("Check the recycling of the EventImpl memory")
+{
+}
+
+void
+SimulatorEventMemoryTestCase::Event(Ptr<const SimulatorEventArgument> /* value */)
+{
+    m_events++;
+}
+
+void
+SimulatorEventMemoryTestCase::DoRun()
+{
+    m_events = 0;
+    auto value = Create<SimulatorEventArgument>();
+
+    // The memory of an event is reused by the next event of the same size
+    EventImpl* first = MakeEvent(&SimulatorEventMemoryTestCase::Event, this, value);
+    NS_TEST_EXPECT_MSG_EQ(value->GetReferenceCount(), 2, "bound argument not copied");
+    void* memory = first;
+    first->Unref();
+    NS_TEST_EXPECT_MSG_EQ(value->GetReferenceCount(), 1, "bound argument not released");
+    EventImpl* second = MakeEvent(&SimulatorEventMemoryTestCase::Event, this, value);
+    NS_TEST_EXPECT_MSG_EQ(static_cast<void*>(second), memory, "event memory not recycled");
+    NS_TEST_EXPECT_MSG_EQ(second->IsCancelled(), false, "recycled event state not reset");
+    second->Unref();
+
+    // The recycling does not change the EventId semantics
+    EventId kept = Simulator::Schedule(Seconds(1), &SimulatorEventMemoryTestCase::Event, this, value);
+    EventId cancelled =
+        Simulator::Schedule(Seconds(1), &SimulatorEventMemoryTestCase::Event, this, value);
+    EventId removed =
+        Simulator::Schedule(Seconds(1), &SimulatorEventMemoryTestCase::Event, this, value);
+    Simulator::Cancel(cancelled);
+    Simulator::Remove(removed);
+    NS_TEST_EXPECT_MSG_EQ(cancelled.IsExpired(), true, "cancelled event not expired");
+    NS_TEST_EXPECT_MSG_EQ(removed.IsExpired(), true, "removed event not expired");
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        Simulator::Schedule(MilliSeconds(i), &SimulatorEventMemoryTestCase::Event, this, value);
+    }
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_events, 101, "wrong number of events invoked");
+    NS_TEST_EXPECT_MSG_EQ(kept.IsExpired(), true, "invoked event not expired");
+    NS_TEST_EXPECT_MSG_EQ(cancelled.IsExpired(), true, "cancelled event not expired");
+    Simulator::Destroy();
+    // the EventIds keep their events, and the bound arguments, alive
+    NS_TEST_EXPECT_MSG_EQ(value->GetReferenceCount(), 4, "bound arguments released too early");
+    kept = cancelled = removed = EventId();
+    NS_TEST_EXPECT_MSG_EQ(value->GetReferenceCount(), 1, "bound arguments not released");
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the EventProfiler of the DefaultSimulatorImpl.
+ */
+class SimulatorEventProfilerTestCase : public TestCase
+{
+  public:
+    SimulatorEventProfilerTestCase();
+    void DoRun() override;
+
+  private:
+    /** Test Event, which schedules two Leaf() events in context 7. */
+    void Root();
+    /** Test Event, with the same signature as Root(). */
+    void Leaf();
+};
+
+SimulatorEventProfilerTestCase::SimulatorEventProfilerTestCase()
+    : TestCase("Check the profiling of the events")
+{
+}
+
+void
+SimulatorEventProfilerTestCase::Root()
+{
+    Simulator::ScheduleWithContext(7, Seconds(1), &SimulatorEventProfilerTestCase::Leaf, this);
+    Simulator::ScheduleWithContext(7, Seconds(2), &SimulatorEventProfilerTestCase::Leaf, this);
+}
+
+void
+SimulatorEventProfilerTestCase::Leaf()
+{
+}
+
+void
+SimulatorEventProfilerTestCase::DoRun()
+{
+    std::string report = CreateTempDirFilename("event-profile.txt");
+    std::string trace = CreateTempDirFilename("event-profile.json");
+    ObjectFactory factory("ns3::DefaultSimulatorImpl");
+    factory.Set("EventProfileReport", StringValue(report));
+    factory.Set("EventProfileTrace", StringValue(trace));
+    Simulator::Destroy();
+    Simulator::SetImplementation(factory.Create<SimulatorImpl>());
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        Simulator::Schedule(Seconds(i), &SimulatorEventProfilerTestCase::Root, this);
+    }
+    Simulator::Run();
+
+    auto impl = DynamicCast<DefaultSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_ASSERT_MSG_NE(impl->GetEventProfiler(), nullptr, "events not profiled");
+    // Root() and Leaf() are told apart although their events have the same type
+    auto stats = impl->GetEventProfiler()->GetStats(false);
+    NS_TEST_ASSERT_MSG_EQ(stats.size(), 2, "wrong number of event kinds");
+    std::sort(stats.begin(), stats.end(), [](const auto& a, const auto& b) {
+        return a.count < b.count;
+    });
+    NS_TEST_EXPECT_MSG_EQ(stats[0].count, 3, "wrong number of Root() events");
+    NS_TEST_EXPECT_MSG_EQ(stats[0].fanOut, 6, "wrong fan-out of Root() events");
+    NS_TEST_EXPECT_MSG_EQ(stats[1].count, 6, "wrong number of Leaf() events");
+    NS_TEST_EXPECT_MSG_EQ(stats[1].fanOut, 0, "wrong fan-out of Leaf() events");
+    NS_TEST_EXPECT_MSG_NE(stats[0].name, stats[1].name, "event kinds with the same name");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(stats[0].maxNs * stats[0].count,
+                                stats[0].totalNs,
+                                "maximum time less than the mean time");
+
+    bool leafInContext = false;
+    for (const auto& kind : impl->GetEventProfiler()->GetStats(true))
+    {
+        leafInContext |= kind.count == 6 && kind.context == 7;
+    }
+    NS_TEST_EXPECT_MSG_EQ(leafInContext, true, "Leaf() events not reported in context 7");
+
+    Simulator::Destroy();
+    std::ifstream reportFile(report);
+    std::string line;
+    std::getline(reportFile, line);
+    NS_TEST_EXPECT_MSG_EQ(line.rfind("Event profile: 9 events", 0), 0, "wrong report " << line);
+    std::ifstream traceFile(trace);
+    std::getline(traceFile, line);
+    NS_TEST_EXPECT_MSG_EQ(line, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", "wrong trace");
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -730,6 +907,10 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+        AddTestCase(new SimulatorEventMemoryTestCase(), TestCase::QUICK);
+        AddTestCase(new SimulatorEventProfilerTestCase(), TestCase::QUICK);
     }
 };
 
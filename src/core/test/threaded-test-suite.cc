@@ -19,6 +19,7 @@
 #include "ns3/calendar-scheduler.h"
 #include "ns3/config.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/simulator.h"
@@ -292,12 +293,14 @@ class ThreadedSimulatorTestSuite : public TestSuite
         std::string simulatorTypes[] = {
             "ns3::RealtimeSimulatorImpl",
             "ns3::DefaultSimulatorImpl",
+            "ns3::MultithreadedSimulatorImpl",
         };
         std::string schedulerTypes[] = {
             "ns3::ListScheduler",
             "ns3::HeapScheduler",
             "ns3::MapScheduler",
             "ns3::CalendarScheduler",
+            "ns3::LadderScheduler",
         };
         unsigned int threadCounts[] = {0, 2, 10, 20};
         ObjectFactory factory;
@@ -19,20 +19,46 @@
 
 #include "flow-monitor.h"
 
+#include "ns3/abort.h"
 #include "ns3/double.h"
+#include "ns3/enum.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 
 #define PERIODIC_CHECK_INTERVAL (Seconds(1))
 
+/// Magic number at the start of binary interval statistics files
+#define INTERVAL_STATS_MAGIC "FMIS"
+/// Version of the binary interval statistics record layout
+#define INTERVAL_STATS_VERSION 1
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("FlowMonitor");
 
+/**
+ * Write the lowest bytes of a value to a stream, least significant byte first
+ * \param os the output stream
+ * \param value the value to write
+ * \param size the number of bytes to write
+ */
+static void
+WriteLittleEndian(std::ostream& os, uint64_t value, uint8_t size)
+{
+    for (uint8_t i = 0; i < size; i++)
+    {
+        os.put(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(FlowMonitor);
 
 TypeId
@@ -80,7 +106,36 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddAttribute("IntervalStatsPeriod",
+                          "The duration of the interval statistics snapshots. "
+                          "A zero value disables the interval statistics.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&FlowMonitor::m_intervalPeriod),
+                          MakeTimeChecker())
+            .AddAttribute("IntervalStatsHistory",
+                          "The number of interval snapshots kept for each flow.",
+                          UintegerValue(16),
+                          MakeUintegerAccessor(&FlowMonitor::m_intervalHistory),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("IntervalStatsFileName",
+                          "The file where the interval snapshots are streamed to. "
+                          "If empty, the snapshots are not exported.",
+                          StringValue(""),
+                          MakeStringAccessor(&FlowMonitor::m_intervalFileName),
+                          MakeStringChecker())
+            .AddAttribute("IntervalStatsFormat",
+                          "The format of the interval statistics file.",
+                          EnumValue(FlowMonitor::INTERVAL_STATS_CSV),
+                          MakeEnumAccessor(&FlowMonitor::m_intervalFormat),
+                          MakeEnumChecker(FlowMonitor::INTERVAL_STATS_CSV,
+                                          "Csv",
+                                          FlowMonitor::INTERVAL_STATS_BINARY,
+                                          "Binary"))
+            .AddTraceSource("IntervalStats",
+                            "Statistics of the flows active during the interval that just ended.",
+                            MakeTraceSourceAccessor(&FlowMonitor::m_intervalStatsTrace),
+                            "ns3::FlowMonitor::IntervalStatsTracedCallback");
     return tid;
 }
 
@@ -91,7 +146,10 @@ FlowMonitor::GetInstanceTypeId() const
 }
 
 FlowMonitor::FlowMonitor()
-    : m_enabled(false)
+    : m_intervalRunning(false),
+      m_lostPacketTick(0),
+      m_lostPacketWheelSize(0),
+      m_enabled(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -102,6 +160,12 @@ FlowMonitor::DoDispose()
     NS_LOG_FUNCTION(this);
     Simulator::Cancel(m_startEvent);
     Simulator::Cancel(m_stopEvent);
+    Simulator::Cancel(m_intervalEvent);
+    m_intervalRunning = false;
+    if (m_intervalFile.is_open())
+    {
+        m_intervalFile.close();
+    }
     for (auto iter = m_classifiers.begin(); iter != m_classifiers.end(); iter++)
     {
         *iter = nullptr;
@@ -143,6 +207,19 @@ FlowMonitor::GetStatsForFlow(FlowId flowId)
     }
 }
 
+FlowMonitor::IntervalStats&
+FlowMonitor::GetIntervalStatsForFlow(FlowId flowId)
+{
+    FlowIntervalState& state = m_intervalState[flowId];
+    if (!state.active)
+    {
+        state.active = true;
+        state.current = IntervalStats();
+        m_activeIntervalFlows.push_back(flowId);
+    }
+    return state.current;
+}
+
 void
 FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
                            uint32_t flowId,
@@ -156,10 +233,12 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         return;
     }
     Time now = Simulator::Now();
-    TrackedPacket& tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
+    TrackedPacketKey key(flowId, packetId);
+    TrackedPacket& tracked = m_trackedPackets[key];
     tracked.firstSeenTime = now;
     tracked.lastSeenTime = tracked.firstSeenTime;
     tracked.timesForwarded = 0;
+    AddToLostPacketWheel(key, now);
     NS_LOG_DEBUG("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId="
                                                                  << packetId << ").");
 
@@ -173,6 +252,13 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         stats.timeFirstTxPacket = now;
     }
     stats.timeLastTxPacket = now;
+
+    if (m_intervalRunning)
+    {
+        IntervalStats& interval = GetIntervalStatsForFlow(flowId);
+        interval.txBytes += packetSize;
+        interval.txPackets++;
+    }
 }
 
 void
@@ -230,19 +316,12 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
     FlowStats& stats = GetStatsForFlow(flowId);
     stats.delaySum += delay;
     stats.delayHistogram.AddValue(delay.GetSeconds());
+    Time jitter = Seconds(0);
     if (stats.rxPackets > 0)
     {
-        Time jitter = stats.lastDelay - delay;
-        if (jitter > Seconds(0))
-        {
-            stats.jitterSum += jitter;
-            stats.jitterHistogram.AddValue(jitter.GetSeconds());
-        }
-        else
-        {
-            stats.jitterSum -= jitter;
-            stats.jitterHistogram.AddValue(-jitter.GetSeconds());
-        }
+        jitter = Abs(stats.lastDelay - delay);
+        stats.jitterSum += jitter;
+        stats.jitterHistogram.AddValue(jitter.GetSeconds());
     }
     stats.lastDelay = delay;
 
@@ -265,6 +344,15 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
     stats.timeLastRxPacket = now;
     stats.timesForwarded += tracked->second.timesForwarded;
 
+    if (m_intervalRunning)
+    {
+        IntervalStats& interval = GetIntervalStatsForFlow(flowId);
+        interval.rxBytes += packetSize;
+        interval.rxPackets++;
+        interval.delaySum += delay;
+        interval.jitterSum += jitter;
+    }
+
     NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                   << packetId << ").");
 
@@ -299,6 +387,11 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
     NS_LOG_DEBUG("++stats.packetsDropped["
                  << reasonCode << "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
+    if (m_intervalRunning)
+    {
+        GetIntervalStatsForFlow(flowId).lostPackets++;
+    }
+
     auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
     if (tracked != m_trackedPackets.end())
     {
@@ -317,30 +410,142 @@ FlowMonitor::GetFlowStats() const
 }
 
 void
-FlowMonitor::CheckForLostPackets(Time maxDelay)
+FlowMonitor::AddToLostPacketWheel(const TrackedPacketKey& key, Time lastSeenTime)
 {
-    NS_LOG_FUNCTION(this << maxDelay.As(Time::S));
-    Time now = Simulator::Now();
+    int64_t tickWidth = PERIODIC_CHECK_INTERVAL.GetTimeStep();
+    if (m_lostPacketWheelSize == 0)
+    {
+        // the wheel is empty: skip the ticks without packets
+        m_lostPacketTick =
+            std::max(m_lostPacketTick, Simulator::Now().GetTimeStep() / tickWidth);
+    }
+    LostPacketWheelEntry entry;
+    entry.key = key;
+    entry.tick = std::max((lastSeenTime + m_maxPerHopDelay).GetTimeStep() / tickWidth,
+                          m_lostPacketTick);
+    PlaceInLostPacketWheel(entry);
+}
+
+void
+FlowMonitor::PlaceInLostPacketWheel(const LostPacketWheelEntry& entry)
+{
+    // a block has 64 ticks, and a superblock 64 blocks
+    if (entry.tick >> 6 == m_lostPacketTick >> 6)
+    {
+        m_lostPacketWheel[entry.tick & 63].push_back(entry);
+    }
+    else if (entry.tick >> 12 == m_lostPacketTick >> 12)
+    {
+        m_lostPacketWheelBlocks[(entry.tick >> 6) & 63].push_back(entry);
+    }
+    else
+    {
+        m_lostPacketOverflow.push_back(entry);
+    }
+    m_lostPacketWheelSize++;
+}
 
-    for (auto iter = m_trackedPackets.begin(); iter != m_trackedPackets.end();)
+void
+FlowMonitor::CheckLostPacketWheelSlot(Time now)
+{
+    std::vector<LostPacketWheelEntry> slot;
+    slot.swap(m_lostPacketWheel[m_lostPacketTick & 63]);
+    m_lostPacketWheelSize -= slot.size();
+    for (const auto& entry : slot)
     {
-        if (now - iter->second.lastSeenTime >= maxDelay)
+        auto iter = m_trackedPackets.find(entry.key);
+        if (iter == m_trackedPackets.end())
+        {
+            // packet already received or dropped
+            continue;
+        }
+        Time deadline = iter->second.lastSeenTime + m_maxPerHopDelay;
+        if (deadline <= now)
         {
             // packet is considered lost, add it to the loss statistics
-            auto flow = m_flowStats.find(iter->first.first);
+            auto flow = m_flowStats.find(entry.key.first);
             NS_ASSERT(flow != m_flowStats.end());
             flow->second.lostPackets++;
+            if (m_intervalRunning)
+            {
+                GetIntervalStatsForFlow(entry.key.first).lostPackets++;
+            }
 
             // we won't track it anymore
-            m_trackedPackets.erase(iter++);
+            m_trackedPackets.erase(iter);
         }
         else
         {
-            iter++;
+            // packet forwarded since it was bucketed, or not due yet in
+            // the current tick
+            AddToLostPacketWheel(entry.key, iter->second.lastSeenTime);
         }
     }
 }
 
+void
+FlowMonitor::CheckForLostPackets(Time maxDelay)
+{
+    NS_LOG_FUNCTION(this << maxDelay.As(Time::S));
+    Time now = Simulator::Now();
+
+    if (maxDelay != m_maxPerHopDelay)
+    {
+        // the wheel is bucketed by the deadlines of MaxPerHopDelay
+        for (auto iter = m_trackedPackets.begin(); iter != m_trackedPackets.end();)
+        {
+            if (now - iter->second.lastSeenTime >= maxDelay)
+            {
+                auto flow = m_flowStats.find(iter->first.first);
+                NS_ASSERT(flow != m_flowStats.end());
+                flow->second.lostPackets++;
+                if (m_intervalRunning)
+                {
+                    GetIntervalStatsForFlow(iter->first.first).lostPackets++;
+                }
+                iter = m_trackedPackets.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+        return;
+    }
+
+    // only the slots of the ticks up to now are checked
+    int64_t nowTick = now.GetTimeStep() / PERIODIC_CHECK_INTERVAL.GetTimeStep();
+    while (m_lostPacketWheelSize > 0)
+    {
+        CheckLostPacketWheelSlot(now);
+        if (m_lostPacketTick == nowTick)
+        {
+            // the rest of the current tick is checked later
+            return;
+        }
+        m_lostPacketTick++;
+        if ((m_lostPacketTick & 63) == 0)
+        {
+            // a block starts: move its slots to the first level, after the
+            // overflow list if a superblock starts
+            std::vector<LostPacketWheelEntry> entries;
+            if ((m_lostPacketTick & 4095) == 0)
+            {
+                entries.swap(m_lostPacketOverflow);
+            }
+            const auto& block = m_lostPacketWheelBlocks[(m_lostPacketTick >> 6) & 63];
+            entries.insert(entries.end(), block.begin(), block.end());
+            m_lostPacketWheelBlocks[(m_lostPacketTick >> 6) & 63].clear();
+            m_lostPacketWheelSize -= entries.size();
+            for (const auto& entry : entries)
+            {
+                PlaceInLostPacketWheel(entry);
+            }
+        }
+    }
+    m_lostPacketTick = std::max(m_lostPacketTick, nowTick);
+}
+
 void
 FlowMonitor::CheckForLostPackets()
 {
@@ -406,6 +611,30 @@ FlowMonitor::StartRightNow()
         return;
     }
     m_enabled = true;
+
+    if (!m_intervalPeriod.IsStrictlyPositive())
+    {
+        return;
+    }
+    if (!m_intervalFileName.empty() && !m_intervalFile.is_open())
+    {
+        m_intervalFile.open(m_intervalFileName, std::ios::out | std::ios::binary);
+        NS_ABORT_MSG_UNLESS(m_intervalFile.is_open(),
+                            "Could not open interval statistics file " << m_intervalFileName);
+        if (m_intervalFormat == INTERVAL_STATS_CSV)
+        {
+            m_intervalFile << "FlowId,Start,End,TxBytes,RxBytes,TxPackets,RxPackets,"
+                              "LostPackets,DelaySum,JitterSum\n";
+        }
+        else
+        {
+            m_intervalFile.write(INTERVAL_STATS_MAGIC, 4);
+            WriteLittleEndian(m_intervalFile, INTERVAL_STATS_VERSION, 4);
+        }
+    }
+    m_intervalRunning = true;
+    m_intervalStart = Simulator::Now();
+    m_intervalEvent = Simulator::Schedule(m_intervalPeriod, &FlowMonitor::EndInterval, this);
 }
 
 void
@@ -419,6 +648,109 @@ FlowMonitor::StopRightNow()
     }
     m_enabled = false;
     CheckForLostPackets();
+
+    if (m_intervalRunning)
+    {
+        // close the partial interval
+        Simulator::Cancel(m_intervalEvent);
+        EndInterval();
+    }
+}
+
+void
+FlowMonitor::EndInterval()
+{
+    NS_LOG_FUNCTION(this);
+    Time now = Simulator::Now();
+    bool trace = !m_intervalStatsTrace.IsEmpty();
+    IntervalStatsContainer closed;
+
+    for (FlowId flowId : m_activeIntervalFlows)
+    {
+        FlowIntervalState& state = m_intervalState[flowId];
+        state.active = false;
+        state.current.start = m_intervalStart;
+        state.current.end = now;
+        if (state.history.size() < m_intervalHistory)
+        {
+            state.history.push_back(state.current);
+        }
+        else
+        {
+            state.history[state.next] = state.current;
+        }
+        state.next = (state.next + 1) % m_intervalHistory;
+
+        WriteIntervalStats(flowId, state.current);
+        if (trace)
+        {
+            closed[flowId] = state.current;
+        }
+    }
+    m_activeIntervalFlows.clear();
+    if (m_intervalFile.is_open())
+    {
+        m_intervalFile.flush();
+    }
+    m_intervalStatsTrace(closed);
+
+    m_intervalStart = now;
+    m_intervalRunning = m_enabled;
+    if (m_intervalRunning)
+    {
+        m_intervalEvent = Simulator::Schedule(m_intervalPeriod, &FlowMonitor::EndInterval, this);
+    }
+}
+
+void
+FlowMonitor::WriteIntervalStats(FlowId flowId, const IntervalStats& stats)
+{
+    if (!m_intervalFile.is_open())
+    {
+        return;
+    }
+    if (m_intervalFormat == INTERVAL_STATS_CSV)
+    {
+        m_intervalFile << flowId << "," << stats.start.GetSeconds() << ","
+                       << stats.end.GetSeconds() << "," << stats.txBytes << "," << stats.rxBytes
+                       << "," << stats.txPackets << "," << stats.rxPackets << ","
+                       << stats.lostPackets << "," << stats.delaySum.GetSeconds() << ","
+                       << stats.jitterSum.GetSeconds() << "\n";
+    }
+    else
+    {
+        WriteLittleEndian(m_intervalFile, flowId, 4);
+        WriteLittleEndian(m_intervalFile, stats.start.GetNanoSeconds(), 8);
+        WriteLittleEndian(m_intervalFile, stats.end.GetNanoSeconds(), 8);
+        WriteLittleEndian(m_intervalFile, stats.txBytes, 8);
+        WriteLittleEndian(m_intervalFile, stats.rxBytes, 8);
+        WriteLittleEndian(m_intervalFile, stats.txPackets, 4);
+        WriteLittleEndian(m_intervalFile, stats.rxPackets, 4);
+        WriteLittleEndian(m_intervalFile, stats.lostPackets, 4);
+        WriteLittleEndian(m_intervalFile, stats.delaySum.GetNanoSeconds(), 8);
+        WriteLittleEndian(m_intervalFile, stats.jitterSum.GetNanoSeconds(), 8);
+    }
+}
+
+std::vector<FlowMonitor::IntervalStats>
+FlowMonitor::GetIntervalStats(FlowId flowId) const
+{
+    std::vector<IntervalStats> snapshots;
+    auto iter = m_intervalState.find(flowId);
+    if (iter == m_intervalState.end())
+    {
+        return snapshots;
+    }
+    const std::vector<IntervalStats>& history = iter->second.history;
+    if (history.size() < m_intervalHistory)
+    {
+        return history;
+    }
+    // the ring is full, the oldest snapshot is the next to be overwritten
+    snapshots.reserve(history.size());
+    snapshots.insert(snapshots.end(), history.begin() + iter->second.next, history.end());
+    snapshots.insert(snapshots.end(), history.begin(), history.begin() + iter->second.next);
+    return snapshots;
 }
 
 void
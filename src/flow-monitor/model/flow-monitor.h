@@ -28,8 +28,12 @@
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
 
+#include <array>
+#include <fstream>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -138,6 +142,46 @@ class FlowMonitor : public Object
         Histogram flowInterruptionsHistogram; //!< histogram of durations of flow interruptions
     };
 
+    /// \brief Structure that represents the metrics of a flow measured during a
+    /// single statistics interval (see the IntervalStatsPeriod attribute)
+    struct IntervalStats
+    {
+        Time start;           //!< absolute time when the interval started
+        Time end;             //!< absolute time when the interval ended
+        uint64_t txBytes;     //!< number of bytes transmitted during the interval
+        uint64_t rxBytes;     //!< number of bytes received during the interval
+        uint32_t txPackets;   //!< number of packets transmitted during the interval
+        uint32_t rxPackets;   //!< number of packets received during the interval
+        uint32_t lostPackets; //!< number of packets dropped or declared lost during the interval
+        Time delaySum;        //!< sum of the delays of the packets received during the interval
+        Time jitterSum;       //!< sum of the jitters of the packets received during the interval
+    };
+
+    /**
+     * Output formats of the interval statistics file.
+     *
+     * The binary format starts with the "FMIS" magic and a 4 byte version,
+     * followed by one 64 byte little endian record per flow and interval:
+     * flowId (4), start (8), end (8), txBytes (8), rxBytes (8), txPackets (4),
+     * rxPackets (4), lostPackets (4), delaySum (8), jitterSum (8), with the
+     * times in nanoseconds.
+     */
+    enum IntervalStatsFormat
+    {
+        INTERVAL_STATS_CSV,    //!< one comma separated line per flow and interval
+        INTERVAL_STATS_BINARY, //!< fixed-size little endian records
+    };
+
+    /// Container: FlowId, IntervalStats
+    typedef std::map<FlowId, IntervalStats> IntervalStatsContainer;
+
+    /**
+     * TracedCallback signature for the end of a statistics interval.
+     *
+     * \param [in] stats the statistics of the flows that were active in the interval
+     */
+    typedef void (*IntervalStatsTracedCallback)(const IntervalStatsContainer& stats);
+
     // --- basic methods ---
     /**
      * \brief Get the type ID.
@@ -277,6 +321,13 @@ class FlowMonitor : public Object
     /// Reset all the statistics
     void ResetAllStats();
 
+    /// Retrieve the most recent interval snapshots of a flow, oldest first.
+    /// At most IntervalStatsHistory snapshots are kept per flow, and only
+    /// the intervals in which the flow was active are recorded.
+    /// \param flowId the Flow identification
+    /// \returns the interval snapshots of the flow
+    std::vector<IntervalStats> GetIntervalStats(FlowId flowId) const;
+
   protected:
     void NotifyConstructionCompleted() override;
     void DoDispose() override;
@@ -290,15 +341,87 @@ class FlowMonitor : public Object
         uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
     };
 
+    /// Per-flow interval statistics: the interval being measured and a ring
+    /// buffer with the snapshots of the last closed intervals
+    struct FlowIntervalState
+    {
+        IntervalStats current;              //!< interval being measured
+        bool active;                        //!< flow was seen in the current interval
+        uint32_t next;                      //!< ring position of the next snapshot
+        std::vector<IntervalStats> history; //!< ring buffer of closed intervals
+    };
+
     /// FlowId --> FlowStats
     FlowStatsContainer m_flowStats;
 
+    std::map<FlowId, FlowIntervalState> m_intervalState; //!< FlowId --> interval state
+    std::vector<FlowId> m_activeIntervalFlows; //!< flows seen in the current interval
+    Time m_intervalStart;                      //!< start of the current interval
+    Time m_intervalPeriod;                     //!< interval statistics period
+    uint32_t m_intervalHistory;                //!< snapshots kept per flow
+    std::string m_intervalFileName;            //!< interval statistics output file
+    IntervalStatsFormat m_intervalFormat;      //!< interval statistics output format
+    std::ofstream m_intervalFile;              //!< interval statistics output stream
+    EventId m_intervalEvent;                   //!< end of the current interval
+    bool m_intervalRunning;                    //!< interval statistics are being measured
+
+    /// Trace fired at the end of each statistics interval
+    TracedCallback<const IntervalStatsContainer&> m_intervalStatsTrace;
+
+    /// (FlowId,PacketId) key of a tracked packet
+    typedef std::pair<FlowId, FlowPacketId> TrackedPacketKey;
+
+    /// Hash function for the tracked packet keys
+    struct TrackedPacketKeyHash
+    {
+        /// \param key the tracked packet key
+        /// \return the hash of the key
+        size_t operator()(const TrackedPacketKey& key) const
+        {
+            return std::hash<uint64_t>()((static_cast<uint64_t>(key.first) << 32) | key.second);
+        }
+    };
+
     /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
+    typedef std::unordered_map<TrackedPacketKey, TrackedPacket, TrackedPacketKeyHash>
+        TrackedPacketMap;
     TrackedPacketMap m_trackedPackets; //!< Tracked packets
     Time m_maxPerHopDelay;             //!< Minimum per-hop delay
     FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
 
+    /// An entry of the lost packet timing wheel
+    struct LostPacketWheelEntry
+    {
+        TrackedPacketKey key; //!< the tracked packet key
+        int64_t tick;         //!< the tick of the deadline of the packet
+    };
+
+    /// Number of slots of each level of the lost packet timing wheel
+    static constexpr uint32_t LOST_PACKET_WHEEL_SLOTS = 64;
+
+    /// A level of the lost packet timing wheel
+    typedef std::array<std::vector<LostPacketWheelEntry>, LOST_PACKET_WHEEL_SLOTS>
+        LostPacketWheelLevel;
+
+    /**
+     * Hierarchical timing wheel of the tracked packets, bucketed by the tick
+     * (periodic check interval) of their deadline, i.e., the time they were
+     * last seen (as known when they were bucketed) plus MaxPerHopDelay. The
+     * first level has a slot per tick of the current block of 64 ticks, the
+     * second level a slot per block of the current superblock of 64 blocks,
+     * and the later deadlines are kept in an overflow list. The slots of a
+     * block are moved to the first level when the block starts, and the
+     * overflow list is distributed when a superblock starts. The entries of
+     * packets that are no longer tracked are discarded when their slot is
+     * checked, and the packets that were forwarded in the meantime are moved
+     * to the slot of their new deadline.
+     */
+    LostPacketWheelLevel m_lostPacketWheel;
+    LostPacketWheelLevel m_lostPacketWheelBlocks;          //!< second level of the wheel
+    std::vector<LostPacketWheelEntry> m_lostPacketOverflow; //!< deadlines beyond the wheel
+    int64_t m_lostPacketTick;                               //!< next tick of the wheel to check
+    uint64_t m_lostPacketWheelSize;                         //!< number of entries in the wheel
+
     // note: this is needed only for serialization
     std::list<Ptr<FlowClassifier>> m_classifiers; //!< the FlowClassifiers
 
@@ -318,6 +441,34 @@ class FlowMonitor : public Object
 
     /// Periodic function to check for lost packets and prune statistics
     void PeriodicCheckForLostPackets();
+
+    /// Add a tracked packet to the lost packet timing wheel
+    /// \param key the tracked packet key
+    /// \param lastSeenTime the time when the packet was last seen
+    void AddToLostPacketWheel(const TrackedPacketKey& key, Time lastSeenTime);
+
+    /// Put an entry in the slot of its tick in the lost packet timing wheel
+    /// \param entry the entry
+    void PlaceInLostPacketWheel(const LostPacketWheelEntry& entry);
+
+    /// Check the packets of the current slot of the lost packet timing wheel
+    /// \param now the current time
+    void CheckLostPacketWheelSlot(Time now);
+
+    /// Get the statistics of the current interval for a given flow, marking
+    /// the flow as active in the interval
+    /// \param flowId the Flow identification
+    /// \returns the interval statistics of the flow
+    IntervalStats& GetIntervalStatsForFlow(FlowId flowId);
+
+    /// Close the current statistics interval: store the snapshots of the
+    /// active flows, export them and fire the IntervalStats trace
+    void EndInterval();
+
+    /// Write the interval statistics of a flow to the output file
+    /// \param flowId the Flow identification
+    /// \param stats the interval statistics
+    void WriteIntervalStats(FlowId flowId, const IntervalStats& stats);
 };
 
 } // namespace ns3
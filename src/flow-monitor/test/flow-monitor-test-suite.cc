@@ -0,0 +1,315 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * \defgroup flow-monitor-tests Tests for flow-monitor
+ * \ingroup flow-monitor
+ * \ingroup tests
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * \brief A FlowProbe whose packet events are reported by the tests.
+ */
+class FlowMonitorTestProbe : public FlowProbe
+{
+  public:
+    /**
+     * Constructor
+     * \param monitor the FlowMonitor
+     */
+    FlowMonitorTestProbe(Ptr<FlowMonitor> monitor)
+        : FlowProbe(monitor)
+    {
+    }
+};
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * \brief Check the interval statistics of a flow whose packets are sent,
+ * received and dropped at known times.
+ */
+class FlowMonitorIntervalStatsTestCase : public TestCase
+{
+  public:
+    FlowMonitorIntervalStatsTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record the statistics of the interval that just ended.
+     * \param stats the statistics of the flows active in the interval
+     */
+    void IntervalStats(const FlowMonitor::IntervalStatsContainer& stats);
+
+    /**
+     * Check the statistics of an interval.
+     * \param stats the statistics
+     * \param start the start of the interval, in seconds
+     * \param txPackets the packets sent during the interval
+     * \param txBytes the bytes sent during the interval
+     * \param rxPackets the packets received during the interval
+     * \param rxBytes the bytes received during the interval
+     * \param lostPackets the packets lost during the interval
+     * \param delaySum the sum of the delays, in seconds
+     * \param jitterSum the sum of the jitters, in seconds
+     */
+    void CheckInterval(const FlowMonitor::IntervalStats& stats,
+                       double start,
+                       uint32_t txPackets,
+                       uint64_t txBytes,
+                       uint32_t rxPackets,
+                       uint64_t rxBytes,
+                       uint32_t lostPackets,
+                       double delaySum,
+                       double jitterSum);
+
+    std::vector<FlowMonitor::IntervalStatsContainer> m_intervals; //!< the traced intervals
+};
+
+FlowMonitorIntervalStatsTestCase::FlowMonitorIntervalStatsTestCase()
+    : TestCase("Check the interval statistics of a known flow")
+{
+}
+
+void
+FlowMonitorIntervalStatsTestCase::IntervalStats(const FlowMonitor::IntervalStatsContainer& stats)
+{
+    m_intervals.push_back(stats);
+}
+
+void
+FlowMonitorIntervalStatsTestCase::CheckInterval(const FlowMonitor::IntervalStats& stats,
+                                                double start,
+                                                uint32_t txPackets,
+                                                uint64_t txBytes,
+                                                uint32_t rxPackets,
+                                                uint64_t rxBytes,
+                                                uint32_t lostPackets,
+                                                double delaySum,
+                                                double jitterSum)
+{
+    NS_TEST_EXPECT_MSG_EQ(stats.start, Seconds(start), "Wrong start");
+    NS_TEST_EXPECT_MSG_EQ(stats.end, Seconds(start + 1), "Wrong end");
+    NS_TEST_EXPECT_MSG_EQ(stats.txPackets, txPackets, "Wrong tx packets at " << start);
+    NS_TEST_EXPECT_MSG_EQ(stats.txBytes, txBytes, "Wrong tx bytes at " << start);
+    NS_TEST_EXPECT_MSG_EQ(stats.rxPackets, rxPackets, "Wrong rx packets at " << start);
+    NS_TEST_EXPECT_MSG_EQ(stats.rxBytes, rxBytes, "Wrong rx bytes at " << start);
+    NS_TEST_EXPECT_MSG_EQ(stats.lostPackets, lostPackets, "Wrong lost packets at " << start);
+    NS_TEST_EXPECT_MSG_EQ(stats.delaySum, Seconds(delaySum), "Wrong delay sum at " << start);
+    NS_TEST_EXPECT_MSG_EQ(stats.jitterSum, Seconds(jitterSum), "Wrong jitter sum at " << start);
+}
+
+void
+FlowMonitorIntervalStatsTestCase::DoRun()
+{
+    std::string fileName = CreateTempDirFilename("flow-intervals.csv");
+    Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor>();
+    monitor->SetAttribute("IntervalStatsPeriod", TimeValue(Seconds(1)));
+    monitor->SetAttribute("IntervalStatsHistory", UintegerValue(2));
+    monitor->SetAttribute("IntervalStatsFileName", StringValue(fileName));
+    monitor->TraceConnectWithoutContext(
+        "IntervalStats",
+        MakeCallback(&FlowMonitorIntervalStatsTestCase::IntervalStats, this));
+    Ptr<FlowProbe> probe = CreateObject<FlowMonitorTestProbe>(monitor);
+
+    // flow 1: packet 1 is received in the interval it is sent, packet 2 in
+    // the next interval, packet 3 is dropped, no packet is sent in the third
+    // interval, and packet 4 is received in the fourth interval
+    FlowId flowId = 1;
+    Simulator::Schedule(Seconds(0.5), &FlowMonitor::ReportFirstTx, monitor, probe, flowId, 1, 100);
+    Simulator::Schedule(Seconds(0.6), &FlowMonitor::ReportLastRx, monitor, probe, flowId, 1, 100);
+    Simulator::Schedule(Seconds(0.7), &FlowMonitor::ReportFirstTx, monitor, probe, flowId, 2, 200);
+    Simulator::Schedule(Seconds(1.2), &FlowMonitor::ReportLastRx, monitor, probe, flowId, 2, 200);
+    Simulator::Schedule(Seconds(1.5), &FlowMonitor::ReportFirstTx, monitor, probe, flowId, 3, 300);
+    Simulator::Schedule(Seconds(1.6), &FlowMonitor::ReportDrop, monitor, probe, flowId, 3, 300, 0);
+    Simulator::Schedule(Seconds(3.5), &FlowMonitor::ReportFirstTx, monitor, probe, flowId, 4, 50);
+    Simulator::Schedule(Seconds(3.6), &FlowMonitor::ReportLastRx, monitor, probe, flowId, 4, 50);
+    monitor->Stop(Seconds(4));
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+
+    // the trace reports every interval, with the flows active in it
+    NS_TEST_ASSERT_MSG_EQ(m_intervals.size(), 4, "Wrong number of intervals");
+    NS_TEST_ASSERT_MSG_EQ(m_intervals[0].count(flowId), 1, "Flow not active in the interval");
+    NS_TEST_ASSERT_MSG_EQ(m_intervals[1].count(flowId), 1, "Flow not active in the interval");
+    NS_TEST_EXPECT_MSG_EQ(m_intervals[2].size(), 0, "Flow active in the idle interval");
+    NS_TEST_ASSERT_MSG_EQ(m_intervals[3].count(flowId), 1, "Flow not active in the interval");
+    CheckInterval(m_intervals[0][flowId], 0, 2, 300, 1, 100, 0, 0.1, 0);
+    CheckInterval(m_intervals[1][flowId], 1, 1, 300, 1, 200, 1, 0.5, 0.4);
+    CheckInterval(m_intervals[3][flowId], 3, 1, 50, 1, 50, 0, 0.1, 0.4);
+
+    // the ring buffer keeps the last two snapshots, oldest first
+    std::vector<FlowMonitor::IntervalStats> history = monitor->GetIntervalStats(flowId);
+    NS_TEST_ASSERT_MSG_EQ(history.size(), 2, "Wrong number of snapshots");
+    CheckInterval(history[0], 1, 1, 300, 1, 200, 1, 0.5, 0.4);
+    CheckInterval(history[1], 3, 1, 50, 1, 50, 0, 0.1, 0.4);
+
+    // the cumulative statistics are not reset by the intervals
+    const FlowMonitor::FlowStats& stats = monitor->GetFlowStats().at(flowId);
+    NS_TEST_EXPECT_MSG_EQ(stats.txPackets, 4, "Wrong cumulative tx packets");
+    NS_TEST_EXPECT_MSG_EQ(stats.rxPackets, 3, "Wrong cumulative rx packets");
+    NS_TEST_EXPECT_MSG_EQ(stats.lostPackets, 1, "Wrong cumulative lost packets");
+
+    monitor->Dispose();
+    Simulator::Destroy();
+
+    // the CSV file has a header and a line per flow and active interval
+    std::ifstream file(fileName);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        lines.push_back(line);
+    }
+    NS_TEST_ASSERT_MSG_EQ(lines.size(), 4, "Wrong number of lines in " << fileName);
+    NS_TEST_EXPECT_MSG_EQ(lines[2], "1,1,2,300,200,1,1,1,0.5,0.4", "Wrong CSV line");
+}
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * \brief Check that the packets not seen for MaxPerHopDelay are reported as
+ * lost at the first periodic check past their deadline, for deadlines within
+ * the first level of the lost packet timing wheel, at its span, and beyond
+ * its second level.
+ */
+class FlowMonitorLostPacketsTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * \param maxPerHopDelay the MaxPerHopDelay of the monitor
+     */
+    FlowMonitorLostPacketsTestCase(Time maxPerHopDelay);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the lost packets of the flow.
+     * \param expected the expected number of lost packets
+     */
+    void CheckLostPackets(uint32_t expected);
+
+    Time m_maxPerHopDelay;      //!< the MaxPerHopDelay of the monitor
+    Ptr<FlowMonitor> m_monitor; //!< the monitor
+};
+
+FlowMonitorLostPacketsTestCase::FlowMonitorLostPacketsTestCase(Time maxPerHopDelay)
+    : TestCase("Check the lost packets with MaxPerHopDelay " +
+               std::to_string(maxPerHopDelay.ToInteger(Time::S)) + " s"),
+      m_maxPerHopDelay(maxPerHopDelay)
+{
+}
+
+void
+FlowMonitorLostPacketsTestCase::CheckLostPackets(uint32_t expected)
+{
+    uint32_t lostPackets = m_monitor->GetFlowStats().at(1).lostPackets;
+    NS_TEST_EXPECT_MSG_EQ(lostPackets,
+                          expected,
+                          "Wrong lost packets at " << Simulator::Now().As(Time::S));
+}
+
+void
+FlowMonitorLostPacketsTestCase::DoRun()
+{
+    m_monitor = CreateObject<FlowMonitor>();
+    m_monitor->SetAttribute("MaxPerHopDelay", TimeValue(m_maxPerHopDelay));
+    Ptr<FlowProbe> probe = CreateObject<FlowMonitorTestProbe>(m_monitor);
+
+    // packet 1 is never seen again, packet 2 is forwarded halfway through its
+    // deadline, and packet 3 is received just before its deadline
+    Time d = m_maxPerHopDelay;
+    Simulator::Schedule(Seconds(0.5), &FlowMonitor::ReportFirstTx, m_monitor, probe, 1, 1, 100);
+    Simulator::Schedule(Seconds(0.5), &FlowMonitor::ReportFirstTx, m_monitor, probe, 1, 2, 100);
+    Simulator::Schedule(Seconds(0.5), &FlowMonitor::ReportFirstTx, m_monitor, probe, 1, 3, 100);
+    Simulator::Schedule(d / 2 + Seconds(0.5),
+                        &FlowMonitor::ReportForwarding,
+                        m_monitor,
+                        probe,
+                        1,
+                        2,
+                        100);
+    Simulator::Schedule(d - Seconds(0.5), &FlowMonitor::ReportLastRx, m_monitor, probe, 1, 3, 100);
+
+    // the packets are checked every second
+    Simulator::Schedule(d + Seconds(0.75),
+                        &FlowMonitorLostPacketsTestCase::CheckLostPackets,
+                        this,
+                        0);
+    Simulator::Schedule(d + Seconds(1.25),
+                        &FlowMonitorLostPacketsTestCase::CheckLostPackets,
+                        this,
+                        1);
+    Simulator::Schedule(d * 1.5 + Seconds(0.75),
+                        &FlowMonitorLostPacketsTestCase::CheckLostPackets,
+                        this,
+                        1);
+    Simulator::Schedule(d * 1.5 + Seconds(1.25),
+                        &FlowMonitorLostPacketsTestCase::CheckLostPackets,
+                        this,
+                        2);
+    Simulator::Stop(d * 2);
+    Simulator::Run();
+
+    m_monitor->CheckForLostPackets();
+    CheckLostPackets(2);
+    m_monitor->Dispose();
+    m_monitor = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * \brief TestSuite for the FlowMonitor
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+  public:
+    FlowMonitorTestSuite();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite()
+    : TestSuite("flow-monitor", UNIT)
+{
+    AddTestCase(new FlowMonitorIntervalStatsTestCase, TestCase::QUICK);
+    // within the first level, at the span of the first level, and beyond the
+    // span of the second level of the timing wheel
+    AddTestCase(new FlowMonitorLostPacketsTestCase(Seconds(10)), TestCase::QUICK);
+    AddTestCase(new FlowMonitorLostPacketsTestCase(Seconds(64)), TestCase::QUICK);
+    AddTestCase(new FlowMonitorLostPacketsTestCase(Seconds(5000)), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static FlowMonitorTestSuite g_flowMonitorTestSuite;
@@ -19,6 +19,7 @@
 
 #include "lte-stats-calculator.h"
 
+#include <ns3/boolean.h>
 #include <ns3/config.h>
 #include <ns3/log.h>
 #include <ns3/lte-enb-net-device.h>
@@ -35,7 +36,8 @@ NS_OBJECT_ENSURE_REGISTERED(LteStatsCalculator);
 
 LteStatsCalculator::LteStatsCalculator()
     : m_dlOutputFilename(""),
-      m_ulOutputFilename("")
+      m_ulOutputFilename(""),
+      m_binaryOutput(false)
 {
     // Nothing to do here
 }
@@ -51,10 +53,46 @@ LteStatsCalculator::GetTypeId()
     static TypeId tid = TypeId("ns3::LteStatsCalculator")
                             .SetParent<Object>()
                             .SetGroupName("Lte")
-                            .AddConstructor<LteStatsCalculator>();
+                            .AddConstructor<LteStatsCalculator>()
+                            .AddAttribute("BinaryOutput",
+                                          "Whether the statistics are written as binary traces "
+                                          "instead of text files.",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&LteStatsCalculator::m_binaryOutput),
+                                          MakeBooleanChecker());
     return tid;
 }
 
+bool
+LteStatsCalculator::IsBinaryOutput() const
+{
+    return m_binaryOutput;
+}
+
+Ptr<BinaryTraceWriter>
+LteStatsCalculator::CreateBinaryTrace(std::string filename, const BinaryTraceSchema& schema)
+{
+    NS_LOG_FUNCTION(filename << schema.GetName());
+    Ptr<BinaryTraceWriter> trace = CreateObject<BinaryTraceWriter>();
+    trace->Open(GetBinaryFilename(filename));
+    trace->AddSchema(schema);
+    return trace;
+}
+
+std::string
+LteStatsCalculator::GetBinaryFilename(std::string filename)
+{
+    const std::string textExtension = ".txt";
+    if (filename.size() >= textExtension.size() &&
+        filename.compare(filename.size() - textExtension.size(),
+                         textExtension.size(),
+                         textExtension) == 0)
+    {
+        filename.resize(filename.size() - textExtension.size());
+    }
+    return filename + ".bin";
+}
+
 void
 LteStatsCalculator::SetUlOutputFilename(std::string outputFilename)
 {
@@ -20,6 +20,7 @@
 #ifndef LTE_STATS_CALCULATOR_H_
 #define LTE_STATS_CALCULATOR_H_
 
+#include "ns3/binary-trace-writer.h"
 #include "ns3/object.h"
 #include "ns3/string.h"
 
@@ -34,6 +35,10 @@ namespace ns3
  * Base class for ***StatsCalculator classes. Provides
  * basic functionality to parse and store IMSI and CellId.
  * Also stores names of output files.
+ *
+ * With the BinaryOutput attribute, the statistics are written as binary
+ * traces (see BinaryTraceWriter) instead of text files, under the file
+ * names returned by GetBinaryFilename().
  */
 
 class LteStatsCalculator : public Object
@@ -81,6 +86,15 @@ class LteStatsCalculator : public Object
      */
     std::string GetDlOutputFilename();
 
+    /**
+     * Get the name of the binary trace written instead of a text file when
+     * the BinaryOutput attribute is set: the ".txt" extension, if any, is
+     * replaced by ".bin", otherwise ".bin" is appended.
+     * @param filename the name of the text file
+     * @return the name of the binary trace
+     */
+    static std::string GetBinaryFilename(std::string filename);
+
     /**
      * Checks if there is an already stored IMSI for the given path
      * @param path Path in the attribute system to check
@@ -124,6 +138,21 @@ class LteStatsCalculator : public Object
     uint16_t GetCellIdPath(std::string path);
 
   protected:
+    /**
+     * \returns true if the statistics are written as binary traces
+     */
+    bool IsBinaryOutput() const;
+
+    /**
+     * Create a binary trace, configured by the default values of the
+     * attributes of BinaryTraceWriter.
+     * @param filename the name of the text file, see GetBinaryFilename()
+     * @param schema the schema of the records
+     * @return the open binary trace, where the records have the type 0
+     */
+    static Ptr<BinaryTraceWriter> CreateBinaryTrace(std::string filename,
+                                                    const BinaryTraceSchema& schema);
+
     /**
      * Retrieves IMSI from Enb RLC path in the attribute system
      * @param path Path in the attribute system to get
@@ -204,6 +233,11 @@ class LteStatsCalculator : public Object
      * Name of the file where the uplink results will be saved
      */
     std::string m_ulOutputFilename;
+
+    /**
+     * Whether the statistics are written as binary traces
+     */
+    bool m_binaryOutput;
 };
 
 } // namespace ns3
@@ -110,6 +110,40 @@ MacStatsCalculator::DlScheduling(uint16_t cellId,
              << (uint32_t)dlSchedulingCallbackInfo.mcsTb2 << dlSchedulingCallbackInfo.sizeTb2);
     NS_LOG_INFO("Write DL Mac Stats in " << GetDlOutputFilename());
 
+    if (m_dlFirstWrite && IsBinaryOutput())
+    {
+        m_dlTrace = CreateBinaryTrace(GetDlOutputFilename(),
+                                      BinaryTraceSchema("DlMac")
+                                          .AddField<double>("time")
+                                          .AddField<uint16_t>("cellId")
+                                          .AddField<uint64_t>("IMSI")
+                                          .AddField<uint32_t>("frame")
+                                          .AddField<uint32_t>("sframe")
+                                          .AddField<uint16_t>("RNTI")
+                                          .AddField<uint8_t>("mcsTb1")
+                                          .AddField<uint16_t>("sizeTb1")
+                                          .AddField<uint8_t>("mcsTb2")
+                                          .AddField<uint16_t>("sizeTb2")
+                                          .AddField<uint8_t>("ccId"));
+        m_dlFirstWrite = false;
+    }
+    if (m_dlTrace)
+    {
+        m_dlTrace->Write(0,
+                         Simulator::Now().GetSeconds(),
+                         cellId,
+                         imsi,
+                         dlSchedulingCallbackInfo.frameNo,
+                         dlSchedulingCallbackInfo.subframeNo,
+                         dlSchedulingCallbackInfo.rnti,
+                         dlSchedulingCallbackInfo.mcsTb1,
+                         dlSchedulingCallbackInfo.sizeTb1,
+                         dlSchedulingCallbackInfo.mcsTb2,
+                         dlSchedulingCallbackInfo.sizeTb2,
+                         dlSchedulingCallbackInfo.componentCarrierId);
+        return;
+    }
+
     if (m_dlFirstWrite)
     {
         m_dlOutFile.open(GetDlOutputFilename());
@@ -151,6 +185,36 @@ MacStatsCalculator::UlScheduling(uint16_t cellId,
                          << size);
     NS_LOG_INFO("Write UL Mac Stats in " << GetUlOutputFilename());
 
+    if (m_ulFirstWrite && IsBinaryOutput())
+    {
+        m_ulTrace = CreateBinaryTrace(GetUlOutputFilename(),
+                                      BinaryTraceSchema("UlMac")
+                                          .AddField<double>("time")
+                                          .AddField<uint16_t>("cellId")
+                                          .AddField<uint64_t>("IMSI")
+                                          .AddField<uint32_t>("frame")
+                                          .AddField<uint32_t>("sframe")
+                                          .AddField<uint16_t>("RNTI")
+                                          .AddField<uint8_t>("mcs")
+                                          .AddField<uint16_t>("size")
+                                          .AddField<uint8_t>("ccId"));
+        m_ulFirstWrite = false;
+    }
+    if (m_ulTrace)
+    {
+        m_ulTrace->Write(0,
+                         Simulator::Now().GetSeconds(),
+                         cellId,
+                         imsi,
+                         frameNo,
+                         subframeNo,
+                         rnti,
+                         mcsTb,
+                         size,
+                         componentCarrierId);
+        return;
+    }
+
     if (m_ulFirstWrite)
     {
         m_ulOutFile.open(GetUlOutputFilename());
@@ -191,6 +191,16 @@ class MacStatsCalculator : public LteStatsCalculator
      * Uplink output trace file
      */
     std::ofstream m_ulOutFile;
+
+    /**
+     * Downlink binary trace, with the BinaryOutput attribute
+     */
+    Ptr<BinaryTraceWriter> m_dlTrace;
+
+    /**
+     * Uplink binary trace, with the BinaryOutput attribute
+     */
+    Ptr<BinaryTraceWriter> m_ulTrace;
 };
 
 } // namespace ns3
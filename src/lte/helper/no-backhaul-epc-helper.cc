@@ -22,6 +22,7 @@
 
 #include "ns3/boolean.h"
 #include "ns3/epc-enb-application.h"
+#include "ns3/epc-gtpu-direct-link.h"
 #include "ns3/epc-mme-application.h"
 #include "ns3/epc-pgw-application.h"
 #include "ns3/epc-sgw-application.h"
@@ -34,6 +35,7 @@
 #include "ns3/lte-enb-net-device.h"
 #include "ns3/lte-enb-rrc.h"
 #include "ns3/lte-ue-net-device.h"
+#include "ns3/multithreaded-partition-helper.h"
 #include "ns3/packet-socket-address.h"
 #include "ns3/point-to-point-helper.h"
 #include "ns3/string.h"
@@ -53,7 +55,9 @@ NoBackhaulEpcHelper::NoBackhaulEpcHelper()
       m_gtpcUdpPort(2123), // fixed by the standard
       m_s5LinkDataRate(DataRate("10Gb/s")),
       m_s5LinkDelay(Seconds(0)),
-      m_s5LinkMtu(3000)
+      m_s5LinkMtu(3000),
+      m_s5uDirectLinks(false),
+      m_gtpuTunnels(false)
 {
     NS_LOG_FUNCTION(this);
     // To access the attribute value within the constructor
@@ -139,11 +143,12 @@ NoBackhaulEpcHelper::NoBackhaulEpcHelper()
 
     Ipv4Address pgwS5Address = pgwSgwIpIfaces.GetAddress(0);
     Ipv4Address sgwS5Address = pgwSgwIpIfaces.GetAddress(1);
+    m_sgwS5Address = sgwS5Address;
 
     // Create S5-U socket in the PGW
-    Ptr<Socket> pgwS5uSocket =
+    m_pgwS5uSocket =
         Socket::CreateSocket(m_pgw, TypeId::LookupByName("ns3::UdpSocketFactory"));
-    retval = pgwS5uSocket->Bind(InetSocketAddress(pgwS5Address, m_gtpuUdpPort));
+    retval = m_pgwS5uSocket->Bind(InetSocketAddress(pgwS5Address, m_gtpuUdpPort));
     NS_ASSERT(retval == 0);
 
     // Create S5-C socket in the PGW
@@ -154,16 +159,16 @@ NoBackhaulEpcHelper::NoBackhaulEpcHelper()
 
     // Create EpcPgwApplication
     m_pgwApp =
-        CreateObject<EpcPgwApplication>(m_tunDevice, pgwS5Address, pgwS5uSocket, pgwS5cSocket);
+        CreateObject<EpcPgwApplication>(m_tunDevice, pgwS5Address, m_pgwS5uSocket, pgwS5cSocket);
     m_pgw->AddApplication(m_pgwApp);
 
     // Connect EpcPgwApplication and virtual net device for tunneling
     m_tunDevice->SetSendCallback(MakeCallback(&EpcPgwApplication::RecvFromTunDevice, m_pgwApp));
 
     // Create S5-U socket in the SGW
-    Ptr<Socket> sgwS5uSocket =
+    m_sgwS5uSocket =
         Socket::CreateSocket(m_sgw, TypeId::LookupByName("ns3::UdpSocketFactory"));
-    retval = sgwS5uSocket->Bind(InetSocketAddress(sgwS5Address, m_gtpuUdpPort));
+    retval = m_sgwS5uSocket->Bind(InetSocketAddress(sgwS5Address, m_gtpuUdpPort));
     NS_ASSERT(retval == 0);
 
     // Create S5-C socket in the SGW
@@ -173,14 +178,16 @@ NoBackhaulEpcHelper::NoBackhaulEpcHelper()
     NS_ASSERT(retval == 0);
 
     // Create S1-U socket in the SGW
-    Ptr<Socket> sgwS1uSocket =
+    m_sgwS1uSocket =
         Socket::CreateSocket(m_sgw, TypeId::LookupByName("ns3::UdpSocketFactory"));
-    retval = sgwS1uSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), m_gtpuUdpPort));
+    retval = m_sgwS1uSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), m_gtpuUdpPort));
     NS_ASSERT(retval == 0);
 
     // Create EpcSgwApplication
-    m_sgwApp =
-        CreateObject<EpcSgwApplication>(sgwS1uSocket, sgwS5Address, sgwS5uSocket, sgwS5cSocket);
+    m_sgwApp = CreateObject<EpcSgwApplication>(m_sgwS1uSocket,
+                                               sgwS5Address,
+                                               m_sgwS5uSocket,
+                                               sgwS5cSocket);
     m_sgw->AddApplication(m_sgwApp);
     m_sgwApp->AddPgw(pgwS5Address);
     m_pgwApp->AddSgw(sgwS5Address);
@@ -576,6 +583,11 @@ NoBackhaulEpcHelper::AddS1Interface(Ptr<Node> enb,
 {
     NS_LOG_FUNCTION(this << enb << enbAddress << sgwAddress << cellIds.size());
 
+    NS_ABORT_MSG_IF(m_s5uDirectLinks,
+                    "The GTP-U sockets of the SGW and the PGW have been removed for "
+                    "the direct links: the GTP-U tunnels cannot be mixed with them");
+    m_gtpuTunnels = true;
+
     // create S1-U socket for the ENB
     Ptr<Socket> enbS1uSocket =
         Socket::CreateSocket(enb, TypeId::LookupByName("ns3::UdpSocketFactory"));
@@ -586,6 +598,37 @@ NoBackhaulEpcHelper::AddS1Interface(Ptr<Node> enb,
     NS_ASSERT_MSG(enbApp, "EpcEnbApplication not available");
     enbApp->AddS1Interface(enbS1uSocket, enbAddress, sgwAddress);
 
+    ConnectS1Interface(enbApp, enbAddress, sgwAddress, cellIds);
+}
+
+void
+NoBackhaulEpcHelper::RemoveGtpuSockets()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_gtpuTunnels,
+                    "The GTP-U sockets are used by the S1 interface of an eNB: "
+                    "the direct links cannot be mixed with GTP-U tunnels");
+
+    m_pgwApp->SetS5uSocket(nullptr);
+    m_sgwApp->SetS5uSocket(nullptr);
+    m_sgwApp->SetS1uSocket(nullptr);
+    for (auto& socket : {m_pgwS5uSocket, m_sgwS5uSocket, m_sgwS1uSocket})
+    {
+        socket->Close();
+    }
+    m_pgwS5uSocket = nullptr;
+    m_sgwS5uSocket = nullptr;
+    m_sgwS1uSocket = nullptr;
+}
+
+void
+NoBackhaulEpcHelper::ConnectS1Interface(Ptr<EpcEnbApplication> enbApp,
+                                        Ipv4Address enbAddress,
+                                        Ipv4Address sgwAddress,
+                                        std::vector<uint16_t> cellIds)
+{
+    NS_LOG_FUNCTION(this << enbApp << enbAddress << sgwAddress << cellIds.size());
+
     NS_LOG_INFO("Connect S1-AP interface");
     for (uint16_t cellId : cellIds)
     {
@@ -594,6 +637,65 @@ NoBackhaulEpcHelper::AddS1Interface(Ptr<Node> enb,
         m_sgwApp->AddEnb(cellId, enbAddress, sgwAddress);
     }
     enbApp->SetS1apSapMme(m_mmeApp->GetS1apSapMme());
+
+    // the S1-AP primitives are direct calls between the eNB and the MME
+    MultithreadedPartitionHelper::AddLink(enbApp->GetNode(), m_mme, Seconds(0));
+}
+
+void
+NoBackhaulEpcHelper::AddS5uDirectLinks()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_s5uDirectLinks)
+    {
+        return;
+    }
+    m_s5uDirectLinks = true;
+    RemoveGtpuSockets();
+
+    Ptr<EpcGtpuDirectLink> downlink = CreateObject<EpcGtpuDirectLink>();
+    downlink->SetAttribute("DataRate", DataRateValue(m_s5LinkDataRate));
+    downlink->SetAttribute("Delay", TimeValue(m_s5LinkDelay));
+    downlink->SetReceiver(m_sgw, MakeCallback(&EpcSgwApplication::RecvFromS5uDirectLink, m_sgwApp));
+    m_pgwApp->AddS5uDirectLink(m_sgwS5Address, downlink);
+
+    Ptr<EpcGtpuDirectLink> uplink = CreateObject<EpcGtpuDirectLink>();
+    uplink->SetAttribute("DataRate", DataRateValue(m_s5LinkDataRate));
+    uplink->SetAttribute("Delay", TimeValue(m_s5LinkDelay));
+    uplink->SetReceiver(m_pgw, MakeCallback(&EpcPgwApplication::RecvFromS5uDirectLink, m_pgwApp));
+    m_sgwApp->SetS5uDirectLink(uplink);
+    MultithreadedPartitionHelper::AddLink(m_sgw, m_pgw, m_s5LinkDelay);
+}
+
+void
+NoBackhaulEpcHelper::AddS1uDirectLinks(Ptr<Node> enb,
+                                       Ipv4Address enbAddress,
+                                       Ipv4Address sgwAddress,
+                                       std::vector<uint16_t> cellIds,
+                                       DataRate dataRate,
+                                       Time delay)
+{
+    NS_LOG_FUNCTION(this << enb << enbAddress << sgwAddress << cellIds.size() << dataRate
+                         << delay);
+
+    Ptr<EpcEnbApplication> enbApp = enb->GetApplication(0)->GetObject<EpcEnbApplication>();
+    NS_ASSERT_MSG(enbApp, "EpcEnbApplication not available");
+    enbApp->AddS1Interface(nullptr, enbAddress, sgwAddress);
+
+    Ptr<EpcGtpuDirectLink> downlink = CreateObject<EpcGtpuDirectLink>();
+    downlink->SetAttribute("DataRate", DataRateValue(dataRate));
+    downlink->SetAttribute("Delay", TimeValue(delay));
+    downlink->SetReceiver(enb, MakeCallback(&EpcEnbApplication::RecvFromS1uDirectLink, enbApp));
+    m_sgwApp->AddS1uDirectLink(enbAddress, downlink);
+
+    Ptr<EpcGtpuDirectLink> uplink = CreateObject<EpcGtpuDirectLink>();
+    uplink->SetAttribute("DataRate", DataRateValue(dataRate));
+    uplink->SetAttribute("Delay", TimeValue(delay));
+    uplink->SetReceiver(m_sgw, MakeCallback(&EpcSgwApplication::RecvFromS1uDirectLink, m_sgwApp));
+    enbApp->SetS1uDirectLink(uplink);
+    MultithreadedPartitionHelper::AddLink(enb, m_sgw, delay);
+
+    ConnectS1Interface(enbApp, enbAddress, sgwAddress, cellIds);
 }
 
 int64_t
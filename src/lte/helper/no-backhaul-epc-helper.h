@@ -29,6 +29,8 @@ namespace ns3
 class EpcSgwApplication;
 class EpcPgwApplication;
 class EpcMmeApplication;
+class EpcEnbApplication;
+class Socket;
 
 /**
  * \ingroup lte
@@ -115,7 +117,54 @@ class NoBackhaulEpcHelper : public EpcHelper
                                           const Ptr<EpcTft>& tft,
                                           const EpsBearer& bearer) const;
 
+    /**
+     * \brief Forward the user plane packets between the SGW and the PGW over
+     * direct links modelled after the S5 link, instead of tunneling them
+     * over GTP-U/UDP/IP. Has no effect if the direct links already exist.
+     */
+    void AddS5uDirectLinks();
+
+    /**
+     * \brief Add the S1 interface of an eNB whose user plane packets are
+     * forwarded to and from the SGW over direct links, instead of being
+     * tunneled over GTP-U/UDP/IP. Unlike AddS1Interface, no S1-U socket is
+     * created, and the S1-U addresses only identify the eNB and the SGW.
+     *
+     * \param enb the eNB node
+     * \param enbAddress the S1-U address of the eNB
+     * \param sgwAddress the S1-U address of the SGW
+     * \param cellIds cellIds of the eNB
+     * \param dataRate the data rate of the links
+     * \param delay the delay of the links
+     */
+    void AddS1uDirectLinks(Ptr<Node> enb,
+                           Ipv4Address enbAddress,
+                           Ipv4Address sgwAddress,
+                           std::vector<uint16_t> cellIds,
+                           DataRate dataRate,
+                           Time delay);
+
   private:
+    /**
+     * \brief Close the GTP-U sockets of the SGW and the PGW, which are not
+     * used when the user plane packets are forwarded over direct links.
+     */
+    void RemoveGtpuSockets();
+
+    /**
+     * \brief Connect the S1-AP interface of an eNB to the MME, and register
+     * the eNB in the SGW.
+     *
+     * \param enbApp the EPC application of the eNB
+     * \param enbAddress the S1-U address of the eNB
+     * \param sgwAddress the S1-U address of the SGW
+     * \param cellIds cellIds of the eNB
+     */
+    void ConnectS1Interface(Ptr<EpcEnbApplication> enbApp,
+                            Ipv4Address enbAddress,
+                            Ipv4Address sgwAddress,
+                            std::vector<uint16_t> cellIds);
+
     /**
      * helper to assign IPv4 addresses to UE devices as well as to the TUN device of the SGW/PGW
      */
@@ -214,6 +263,36 @@ class NoBackhaulEpcHelper : public EpcHelper
      */
     uint16_t m_s5LinkMtu;
 
+    /**
+     * SGW address in the S5 interface
+     */
+    Ipv4Address m_sgwS5Address;
+
+    /**
+     * Whether the user plane packets are forwarded over direct S5-U links
+     */
+    bool m_s5uDirectLinks;
+
+    /**
+     * Whether the S1 interface of an eNB tunnels the user plane packets
+     */
+    bool m_gtpuTunnels;
+
+    /**
+     * S5-U socket of the PGW, null with the direct links
+     */
+    Ptr<Socket> m_pgwS5uSocket;
+
+    /**
+     * S5-U socket of the SGW, null with the direct links
+     */
+    Ptr<Socket> m_sgwS5uSocket;
+
+    /**
+     * S1-U socket of the SGW, null with the direct links
+     */
+    Ptr<Socket> m_sgwS1uSocket;
+
     /**
      * Map storing for each IMSI the corresponding eNB NetDevice
      */
@@ -106,6 +106,42 @@ PhyRxStatsCalculator::DlPhyReception(PhyReceptionStatParameters params)
                          << params.m_ndi << params.m_correctness);
     NS_LOG_INFO("Write DL Rx Phy Stats in " << GetDlRxOutputFilename());
 
+    if (m_dlRxFirstWrite && IsBinaryOutput())
+    {
+        m_dlTrace = CreateBinaryTrace(GetDlRxOutputFilename(),
+                                      BinaryTraceSchema("DlRxPhy")
+                                          .AddField<int64_t>("time")
+                                          .AddField<uint16_t>("cellId")
+                                          .AddField<uint64_t>("IMSI")
+                                          .AddField<uint16_t>("RNTI")
+                                          .AddField<uint8_t>("txMode")
+                                          .AddField<uint8_t>("layer")
+                                          .AddField<uint8_t>("mcs")
+                                          .AddField<uint16_t>("size")
+                                          .AddField<uint8_t>("rv")
+                                          .AddField<uint8_t>("ndi")
+                                          .AddField<uint8_t>("correct")
+                                          .AddField<uint8_t>("ccId"));
+        m_dlRxFirstWrite = false;
+    }
+    if (m_dlTrace)
+    {
+        m_dlTrace->Write(0,
+                         params.m_timestamp,
+                         params.m_cellId,
+                         params.m_imsi,
+                         params.m_rnti,
+                         params.m_txMode,
+                         params.m_layer,
+                         params.m_mcs,
+                         params.m_size,
+                         params.m_rv,
+                         params.m_ndi,
+                         params.m_correctness,
+                         params.m_ccId);
+        return;
+    }
+
     if (m_dlRxFirstWrite)
     {
         m_dlRxOutFile.open(GetDlRxOutputFilename());
@@ -142,6 +178,40 @@ PhyRxStatsCalculator::UlPhyReception(PhyReceptionStatParameters params)
                          << params.m_ndi << params.m_correctness);
     NS_LOG_INFO("Write UL Rx Phy Stats in " << GetUlRxOutputFilename());
 
+    if (m_ulRxFirstWrite && IsBinaryOutput())
+    {
+        m_ulTrace = CreateBinaryTrace(GetUlRxOutputFilename(),
+                                      BinaryTraceSchema("UlRxPhy")
+                                          .AddField<int64_t>("time")
+                                          .AddField<uint16_t>("cellId")
+                                          .AddField<uint64_t>("IMSI")
+                                          .AddField<uint16_t>("RNTI")
+                                          .AddField<uint8_t>("layer")
+                                          .AddField<uint8_t>("mcs")
+                                          .AddField<uint16_t>("size")
+                                          .AddField<uint8_t>("rv")
+                                          .AddField<uint8_t>("ndi")
+                                          .AddField<uint8_t>("correct")
+                                          .AddField<uint8_t>("ccId"));
+        m_ulRxFirstWrite = false;
+    }
+    if (m_ulTrace)
+    {
+        m_ulTrace->Write(0,
+                         params.m_timestamp,
+                         params.m_cellId,
+                         params.m_imsi,
+                         params.m_rnti,
+                         params.m_layer,
+                         params.m_mcs,
+                         params.m_size,
+                         params.m_rv,
+                         params.m_ndi,
+                         params.m_correctness,
+                         params.m_ccId);
+        return;
+    }
+
     if (m_ulRxFirstWrite)
     {
         m_ulRxOutFile.open(GetUlRxOutputFilename());
@@ -155,6 +155,16 @@ class PhyRxStatsCalculator : public LteStatsCalculator
      * UL RX PHY output trace file
      */
     std::ofstream m_ulRxOutFile;
+
+    /**
+     * DL PHY statistics binary trace, with the BinaryOutput attribute
+     */
+    Ptr<BinaryTraceWriter> m_dlTrace;
+
+    /**
+     * UL PHY statistics binary trace, with the BinaryOutput attribute
+     */
+    Ptr<BinaryTraceWriter> m_ulTrace;
 };
 
 } // namespace ns3
@@ -132,6 +132,32 @@ PhyStatsCalculator::ReportCurrentCellRsrpSinr(uint16_t cellId,
     NS_LOG_FUNCTION(this << cellId << imsi << rnti << rsrp << sinr);
     NS_LOG_INFO("Write RSRP/SINR Phy Stats in " << GetCurrentCellRsrpSinrFilename());
 
+    if (m_RsrpSinrFirstWrite && IsBinaryOutput())
+    {
+        m_rsrpTrace = CreateBinaryTrace(GetCurrentCellRsrpSinrFilename(),
+                                        BinaryTraceSchema("RsrpSinr")
+                                            .AddField<double>("time")
+                                            .AddField<uint16_t>("cellId")
+                                            .AddField<uint64_t>("IMSI")
+                                            .AddField<uint16_t>("RNTI")
+                                            .AddField<double>("rsrp")
+                                            .AddField<double>("sinr")
+                                            .AddField<uint8_t>("ComponentCarrierId"));
+        m_RsrpSinrFirstWrite = false;
+    }
+    if (m_rsrpTrace)
+    {
+        m_rsrpTrace->Write(0,
+                           Simulator::Now().GetSeconds(),
+                           cellId,
+                           imsi,
+                           rnti,
+                           rsrp,
+                           sinr,
+                           componentCarrierId);
+        return;
+    }
+
     if (m_RsrpSinrFirstWrite)
     {
         m_rsrpOutFile.open(GetCurrentCellRsrpSinrFilename());
@@ -164,6 +190,30 @@ PhyStatsCalculator::ReportUeSinr(uint16_t cellId,
     NS_LOG_FUNCTION(this << cellId << imsi << rnti << sinrLinear);
     NS_LOG_INFO("Write SINR Linear Phy Stats in " << GetUeSinrFilename());
 
+    if (m_UeSinrFirstWrite && IsBinaryOutput())
+    {
+        m_ueSinrTrace = CreateBinaryTrace(GetUeSinrFilename(),
+                                          BinaryTraceSchema("UeSinr")
+                                              .AddField<double>("time")
+                                              .AddField<uint16_t>("cellId")
+                                              .AddField<uint64_t>("IMSI")
+                                              .AddField<uint16_t>("RNTI")
+                                              .AddField<double>("sinrLinear")
+                                              .AddField<uint8_t>("componentCarrierId"));
+        m_UeSinrFirstWrite = false;
+    }
+    if (m_ueSinrTrace)
+    {
+        m_ueSinrTrace->Write(0,
+                             Simulator::Now().GetSeconds(),
+                             cellId,
+                             imsi,
+                             rnti,
+                             sinrLinear,
+                             componentCarrierId);
+        return;
+    }
+
     if (m_UeSinrFirstWrite)
     {
         m_ueSinrOutFile.open(GetUeSinrFilename());
@@ -190,6 +240,28 @@ PhyStatsCalculator::ReportInterference(uint16_t cellId, Ptr<SpectrumValue> inter
     NS_LOG_FUNCTION(this << cellId << interference);
     NS_LOG_INFO("Write Interference Phy Stats in " << GetInterferenceFilename());
 
+    if (m_InterferenceFirstWrite && IsBinaryOutput())
+    {
+        m_interferenceTrace = CreateBinaryTrace(GetInterferenceFilename(),
+                                                BinaryTraceSchema("Interference")
+                                                    .AddField<double>("time")
+                                                    .AddField<uint16_t>("cellId")
+                                                    .AddField<uint16_t>("rb")
+                                                    .AddField<double>("interference"));
+        m_InterferenceFirstWrite = false;
+    }
+    if (m_interferenceTrace)
+    {
+        double now = Simulator::Now().GetSeconds();
+        uint16_t rb = 0;
+        for (auto it = interference->ConstValuesBegin(); it != interference->ConstValuesEnd();
+             ++it, ++rb)
+        {
+            m_interferenceTrace->Write(0, now, cellId, rb, *it);
+        }
+        return;
+    }
+
     if (m_InterferenceFirstWrite)
     {
         m_interferenceOutFile.open(GetInterferenceFilename());
@@ -255,6 +255,22 @@ class PhyStatsCalculator : public LteStatsCalculator
      * Interference statistics output trace file
      */
     std::ofstream m_interferenceOutFile;
+
+    /**
+     * RSRP statistics binary trace, with the BinaryOutput attribute
+     */
+    Ptr<BinaryTraceWriter> m_rsrpTrace;
+
+    /**
+     * UE SINR statistics binary trace, with the BinaryOutput attribute
+     */
+    Ptr<BinaryTraceWriter> m_ueSinrTrace;
+
+    /**
+     * Interference statistics binary trace, with the BinaryOutput attribute,
+     * holding one record per RB
+     */
+    Ptr<BinaryTraceWriter> m_interferenceTrace;
 };
 
 } // namespace ns3
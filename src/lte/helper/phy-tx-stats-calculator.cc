@@ -106,6 +106,38 @@ PhyTxStatsCalculator::DlPhyTransmission(PhyTransmissionStatParameters params)
                          << params.m_ndi);
     NS_LOG_INFO("Write DL Tx Phy Stats in " << GetDlTxOutputFilename());
 
+    if (m_dlTxFirstWrite && IsBinaryOutput())
+    {
+        m_dlTrace = CreateBinaryTrace(GetDlTxOutputFilename(),
+                                      BinaryTraceSchema("DlTxPhy")
+                                          .AddField<int64_t>("time")
+                                          .AddField<uint16_t>("cellId")
+                                          .AddField<uint64_t>("IMSI")
+                                          .AddField<uint16_t>("RNTI")
+                                          .AddField<uint8_t>("layer")
+                                          .AddField<uint8_t>("mcs")
+                                          .AddField<uint16_t>("size")
+                                          .AddField<uint8_t>("rv")
+                                          .AddField<uint8_t>("ndi")
+                                          .AddField<uint8_t>("ccId"));
+        m_dlTxFirstWrite = false;
+    }
+    if (m_dlTrace)
+    {
+        m_dlTrace->Write(0,
+                         params.m_timestamp,
+                         params.m_cellId,
+                         params.m_imsi,
+                         params.m_rnti,
+                         params.m_layer,
+                         params.m_mcs,
+                         params.m_size,
+                         params.m_rv,
+                         params.m_ndi,
+                         params.m_ccId);
+        return;
+    }
+
     if (m_dlTxFirstWrite)
     {
         m_dlTxOutFile.open(GetDlOutputFilename());
@@ -140,6 +172,38 @@ PhyTxStatsCalculator::UlPhyTransmission(PhyTransmissionStatParameters params)
                          << params.m_ndi);
     NS_LOG_INFO("Write UL Tx Phy Stats in " << GetUlTxOutputFilename());
 
+    if (m_ulTxFirstWrite && IsBinaryOutput())
+    {
+        m_ulTrace = CreateBinaryTrace(GetUlTxOutputFilename(),
+                                      BinaryTraceSchema("UlTxPhy")
+                                          .AddField<int64_t>("time")
+                                          .AddField<uint16_t>("cellId")
+                                          .AddField<uint64_t>("IMSI")
+                                          .AddField<uint16_t>("RNTI")
+                                          .AddField<uint8_t>("layer")
+                                          .AddField<uint8_t>("mcs")
+                                          .AddField<uint16_t>("size")
+                                          .AddField<uint8_t>("rv")
+                                          .AddField<uint8_t>("ndi")
+                                          .AddField<uint8_t>("ccId"));
+        m_ulTxFirstWrite = false;
+    }
+    if (m_ulTrace)
+    {
+        m_ulTrace->Write(0,
+                         params.m_timestamp,
+                         params.m_cellId,
+                         params.m_imsi,
+                         params.m_rnti,
+                         params.m_layer,
+                         params.m_mcs,
+                         params.m_size,
+                         params.m_rv,
+                         params.m_ndi,
+                         params.m_ccId);
+        return;
+    }
+
     if (m_ulTxFirstWrite)
     {
         m_ulTxOutFile.open(GetUlTxOutputFilename());
@@ -155,6 +155,16 @@ class PhyTxStatsCalculator : public LteStatsCalculator
      * UL TX PHY statistics output trace file
      */
     std::ofstream m_ulTxOutFile;
+
+    /**
+     * DL PHY statistics binary trace, with the BinaryOutput attribute
+     */
+    Ptr<BinaryTraceWriter> m_dlTrace;
+
+    /**
+     * UL PHY statistics binary trace, with the BinaryOutput attribute
+     */
+    Ptr<BinaryTraceWriter> m_ulTrace;
 };
 
 } // namespace ns3
@@ -88,6 +88,15 @@ PointToPointEpcHelper::GetTypeId()
                           "Enable Pcap for X2 link",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PointToPointEpcHelper::m_s1uLinkEnablePcap),
+                          MakeBooleanChecker())
+            .AddAttribute("S1uS5uDirect",
+                          "If true, the user plane packets of the next eNBs to be added are "
+                          "forwarded directly between the EPC applications, with the latency "
+                          "and capacity of the S1-U and S5 links, instead of being tunneled "
+                          "over GTP-U/UDP/IP. No S1-U point-to-point link nor GTP-U socket "
+                          "is created for them.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PointToPointEpcHelper::m_s1uS5uDirect),
                           MakeBooleanChecker());
     return tid;
 }
@@ -114,6 +123,23 @@ PointToPointEpcHelper::AddEnb(Ptr<Node> enb,
 
     NoBackhaulEpcHelper::AddEnb(enb, lteEnbNetDevice, cellIds);
 
+    if (m_s1uS5uDirect)
+    {
+        // no S1-U link is created: the S1-U addresses only identify the eNB
+        // and the SGW, and the user plane packets go over direct links
+        m_s1uIpv4AddressHelper.NewNetwork();
+        Ipv4Address enbS1uAddress = m_s1uIpv4AddressHelper.NewAddress();
+        Ipv4Address sgwS1uAddress = m_s1uIpv4AddressHelper.NewAddress();
+        AddS5uDirectLinks();
+        AddS1uDirectLinks(enb,
+                          enbS1uAddress,
+                          sgwS1uAddress,
+                          cellIds,
+                          m_s1uLinkDataRate,
+                          m_s1uLinkDelay);
+        return;
+    }
+
     // create a point to point link between the eNB and the SGW with
     // the corresponding new NetDevices on each side
     Ptr<Node> sgw = GetSgwNode();
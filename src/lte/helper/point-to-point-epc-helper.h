@@ -104,6 +104,11 @@ class PointToPointEpcHelper : public NoBackhaulEpcHelper
      * Prefix for the PCAP file for the S1 link
      */
     std::string m_s1uLinkPcapPrefix;
+
+    /**
+     * Forward the user plane packets over direct S1-U and S5-U links
+     */
+    bool m_s1uS5uDirect;
 };
 
 } // namespace ns3
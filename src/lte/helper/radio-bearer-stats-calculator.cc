@@ -106,6 +106,11 @@ RadioBearerStatsCalculator::DoDispose()
     {
         ShowResults();
     }
+    if (m_ulTrace)
+    {
+        m_ulTrace->Close();
+        m_dlTrace->Close();
+    }
 }
 
 void
@@ -241,6 +246,22 @@ RadioBearerStatsCalculator::ShowResults()
     NS_LOG_INFO("Write Rlc Stats in " << GetUlOutputFilename() << " and in "
                                       << GetDlOutputFilename());
 
+    if (IsBinaryOutput())
+    {
+        if (m_firstWrite)
+        {
+            m_ulTrace = CreateBinaryTrace(GetUlOutputFilename(),
+                                          GetBinaryTraceSchema("Ul" + m_protocolType));
+            m_dlTrace = CreateBinaryTrace(GetDlOutputFilename(),
+                                          GetBinaryTraceSchema("Dl" + m_protocolType));
+            m_firstWrite = false;
+        }
+        WriteBinaryResults(m_ulTrace, true);
+        WriteBinaryResults(m_dlTrace, false);
+        m_pendingOutput = false;
+        return;
+    }
+
     std::ofstream ulOutFile;
     std::ofstream dlOutFile;
 
@@ -291,14 +312,13 @@ RadioBearerStatsCalculator::ShowResults()
     m_pendingOutput = false;
 }
 
-void
-RadioBearerStatsCalculator::WriteUlResults(std::ofstream& outFile)
+std::vector<ImsiLcidPair_t>
+RadioBearerStatsCalculator::GetImsiLcidPairs(const Uint32Map& txPackets,
+                                             const Uint32Map& rxPackets) const
 {
-    NS_LOG_FUNCTION(this);
-
     // Get the unique IMSI/LCID pairs list
     std::vector<ImsiLcidPair_t> pairVector;
-    for (auto it = m_ulTxPackets.begin(); it != m_ulTxPackets.end(); ++it)
+    for (auto it = txPackets.begin(); it != txPackets.end(); ++it)
     {
         if (find(pairVector.begin(), pairVector.end(), (*it).first) == pairVector.end())
         {
@@ -306,13 +326,94 @@ RadioBearerStatsCalculator::WriteUlResults(std::ofstream& outFile)
         }
     }
 
-    for (auto it = m_ulRxPackets.begin(); it != m_ulRxPackets.end(); ++it)
+    for (auto it = rxPackets.begin(); it != rxPackets.end(); ++it)
     {
         if (find(pairVector.begin(), pairVector.end(), (*it).first) == pairVector.end())
         {
             pairVector.push_back((*it).first);
         }
     }
+    return pairVector;
+}
+
+BinaryTraceSchema
+RadioBearerStatsCalculator::GetBinaryTraceSchema(std::string name)
+{
+    return BinaryTraceSchema(name)
+        .AddField<double>("start")
+        .AddField<double>("end")
+        .AddField<uint32_t>("CellId")
+        .AddField<uint64_t>("IMSI")
+        .AddField<uint16_t>("RNTI")
+        .AddField<uint8_t>("LCID")
+        .AddField<uint32_t>("nTxPDUs")
+        .AddField<uint64_t>("TxBytes")
+        .AddField<uint32_t>("nRxPDUs")
+        .AddField<uint64_t>("RxBytes")
+        .AddField<double>("delay")
+        .AddField<double>("delayStdDev")
+        .AddField<double>("delayMin")
+        .AddField<double>("delayMax")
+        .AddField<double>("PduSize")
+        .AddField<double>("PduSizeStdDev")
+        .AddField<double>("PduSizeMin")
+        .AddField<double>("PduSizeMax");
+}
+
+void
+RadioBearerStatsCalculator::WriteBinaryResults(Ptr<BinaryTraceWriter> trace, bool uplink)
+{
+    NS_LOG_FUNCTION(this << uplink);
+
+    std::vector<ImsiLcidPair_t> pairVector = uplink
+                                                 ? GetImsiLcidPairs(m_ulTxPackets, m_ulRxPackets)
+                                                 : GetImsiLcidPairs(m_dlTxPackets, m_dlRxPackets);
+
+    double startTime = m_startTime.GetSeconds();
+    double endTime = (m_startTime + m_epochDuration).GetSeconds();
+    for (const auto& p : pairVector)
+    {
+        auto flowIdIt = m_flowId.find(p);
+        NS_ASSERT_MSG(flowIdIt != m_flowId.end(),
+                      "FlowId (imsi " << p.m_imsi << " lcid " << (uint32_t)p.m_lcId
+                                      << ") is missing");
+        LteFlowId_t flowId = flowIdIt->second;
+        NS_ASSERT_MSG(flowId.m_lcId == p.m_lcId, "lcid mismatch");
+
+        std::vector<double> delay =
+            uplink ? GetUlDelayStats(p.m_imsi, p.m_lcId) : GetDlDelayStats(p.m_imsi, p.m_lcId);
+        std::vector<double> pduSize = uplink ? GetUlPduSizeStats(p.m_imsi, p.m_lcId)
+                                             : GetDlPduSizeStats(p.m_imsi, p.m_lcId);
+        trace->Write(0,
+                     startTime,
+                     endTime,
+                     uplink ? GetUlCellId(p.m_imsi, p.m_lcId) : GetDlCellId(p.m_imsi, p.m_lcId),
+                     p.m_imsi,
+                     flowId.m_rnti,
+                     flowId.m_lcId,
+                     uplink ? GetUlTxPackets(p.m_imsi, p.m_lcId)
+                            : GetDlTxPackets(p.m_imsi, p.m_lcId),
+                     uplink ? GetUlTxData(p.m_imsi, p.m_lcId) : GetDlTxData(p.m_imsi, p.m_lcId),
+                     uplink ? GetUlRxPackets(p.m_imsi, p.m_lcId)
+                            : GetDlRxPackets(p.m_imsi, p.m_lcId),
+                     uplink ? GetUlRxData(p.m_imsi, p.m_lcId) : GetDlRxData(p.m_imsi, p.m_lcId),
+                     delay[0] * 1e-9,
+                     delay[1] * 1e-9,
+                     delay[2] * 1e-9,
+                     delay[3] * 1e-9,
+                     pduSize[0],
+                     pduSize[1],
+                     pduSize[2],
+                     pduSize[3]);
+    }
+}
+
+void
+RadioBearerStatsCalculator::WriteUlResults(std::ofstream& outFile)
+{
+    NS_LOG_FUNCTION(this);
+
+    std::vector<ImsiLcidPair_t> pairVector = GetImsiLcidPairs(m_ulTxPackets, m_ulRxPackets);
 
     Time endTime = m_startTime + m_epochDuration;
     for (auto it = pairVector.begin(); it != pairVector.end(); ++it)
@@ -356,23 +457,7 @@ RadioBearerStatsCalculator::WriteDlResults(std::ofstream& outFile)
 {
     NS_LOG_FUNCTION(this);
 
-    // Get the unique IMSI/LCID pairs list
-    std::vector<ImsiLcidPair_t> pairVector;
-    for (auto it = m_dlTxPackets.begin(); it != m_dlTxPackets.end(); ++it)
-    {
-        if (find(pairVector.begin(), pairVector.end(), (*it).first) == pairVector.end())
-        {
-            pairVector.push_back((*it).first);
-        }
-    }
-
-    for (auto it = m_dlRxPackets.begin(); it != m_dlRxPackets.end(); ++it)
-    {
-        if (find(pairVector.begin(), pairVector.end(), (*it).first) == pairVector.end())
-        {
-            pairVector.push_back((*it).first);
-        }
-    }
+    std::vector<ImsiLcidPair_t> pairVector = GetImsiLcidPairs(m_dlTxPackets, m_dlRxPackets);
 
     Time endTime = m_startTime + m_epochDuration;
     for (auto pair = pairVector.begin(); pair != pairVector.end(); ++pair)
@@ -31,6 +31,7 @@
 #include <fstream>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -346,6 +347,31 @@ class RadioBearerStatsCalculator : public LteStatsCalculator
      */
     void ShowResults();
 
+    /**
+     * Get the unique (IMSI, LCID) pairs with transmitted or received PDUs.
+     * @param txPackets the number of transmitted PDUs by (IMSI, LCID) pair
+     * @param rxPackets the number of received PDUs by (IMSI, LCID) pair
+     * @return the pairs, in the order of the transmitted then received PDUs maps
+     */
+    std::vector<ImsiLcidPair_t> GetImsiLcidPairs(const Uint32Map& txPackets,
+                                                 const Uint32Map& rxPackets) const;
+
+    /**
+     * Get the schema of the records of the binary traces, with the fields
+     * of the text files.
+     * @param name the name of the schema
+     * @return the schema
+     */
+    static BinaryTraceSchema GetBinaryTraceSchema(std::string name);
+
+    /**
+     * Writes collected statistics to a binary trace, one record per
+     * (IMSI, LCID) pair, with the BinaryOutput attribute.
+     * @param trace the binary trace
+     * @param uplink true for the UL statistics, false for the DL statistics
+     */
+    void WriteBinaryResults(Ptr<BinaryTraceWriter> trace, bool uplink);
+
     /**
      * Writes collected statistics to UL output file and
      * closes UL output file.
@@ -413,6 +439,16 @@ class RadioBearerStatsCalculator : public LteStatsCalculator
      */
     bool m_firstWrite;
 
+    /**
+     * UL binary trace, with the BinaryOutput attribute
+     */
+    Ptr<BinaryTraceWriter> m_ulTrace;
+
+    /**
+     * DL binary trace, with the BinaryOutput attribute
+     */
+    Ptr<BinaryTraceWriter> m_dlTrace;
+
     /**
      * true if any output is pending
      */
@@ -20,25 +20,49 @@
 #include "radio-environment-map-helper.h"
 
 #include <ns3/abort.h>
+#include <ns3/angles.h>
+#include <ns3/antenna-model.h>
 #include <ns3/boolean.h>
 #include <ns3/buildings-helper.h>
+#include <ns3/component-carrier-enb.h>
 #include <ns3/config.h>
 #include <ns3/constant-position-mobility-model.h>
 #include <ns3/double.h>
 #include <ns3/integer.h>
 #include <ns3/log.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-enb-phy.h>
+#include <ns3/lte-spectrum-phy.h>
 #include <ns3/lte-spectrum-value-helper.h>
 #include <ns3/mobility-building-info.h>
+#include <ns3/node-list.h>
 #include <ns3/node.h>
 #include <ns3/pointer.h>
+#include <ns3/propagation-loss-model.h>
 #include <ns3/rem-spectrum-phy.h>
 #include <ns3/simulator.h>
 #include <ns3/spectrum-channel.h>
+#include <ns3/spectrum-converter.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/spectrum-signal-parameters.h>
 #include <ns3/string.h>
 #include <ns3/uinteger.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <fstream>
 #include <limits>
+#include <numeric>
+#include <thread>
+
+#ifndef __WIN32__
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 namespace ns3
 {
@@ -169,7 +193,27 @@ RadioEnvironmentMapHelper::GetTypeId()
                           "default value is -1, what means REM will be averaged from all RBs",
                           IntegerValue(-1),
                           MakeIntegerAccessor(&RadioEnvironmentMapHelper::m_rbId),
-                          MakeIntegerChecker<int32_t>());
+                          MakeIntegerChecker<int32_t>())
+            .AddAttribute("Direct",
+                          "If true, the REM is computed from the link budgets of the eNBs "
+                          "attached to the channel, assuming that they transmit on all the RBs, "
+                          "instead of being measured by RemSpectrumPhy objects during the "
+                          "simulation",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RadioEnvironmentMapHelper::m_direct),
+                          MakeBooleanChecker())
+            .AddAttribute("Processes",
+                          "The number of processes computing the REM if Direct is true, "
+                          "0 for the number of hardware threads",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&RadioEnvironmentMapHelper::m_processes),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("TileSize",
+                          "The number of columns of the tiles of the REM computed by the "
+                          "processes if Direct is true",
+                          UintegerValue(16),
+                          MakeUintegerAccessor(&RadioEnvironmentMapHelper::m_tileSize),
+                          MakeUintegerChecker<uint32_t>(1, std::numeric_limits<uint32_t>::max()));
     return tid;
 }
 
@@ -235,7 +279,14 @@ RadioEnvironmentMapHelper::Install()
         startDelay = 0.5001;
     }
 
-    Simulator::Schedule(Seconds(startDelay), &RadioEnvironmentMapHelper::DelayedInstall, this);
+    if (m_direct)
+    {
+        Simulator::Schedule(Seconds(startDelay), &RadioEnvironmentMapHelper::DirectInstall, this);
+    }
+    else
+    {
+        Simulator::Schedule(Seconds(startDelay), &RadioEnvironmentMapHelper::DelayedInstall, this);
+    }
 }
 
 void
@@ -359,6 +410,286 @@ RadioEnvironmentMapHelper::PrintAndReset()
     }
 }
 
+std::vector<RadioEnvironmentMapHelper::RemTransmitter>
+RadioEnvironmentMapHelper::GetTransmitters() const
+{
+    NS_LOG_FUNCTION(this);
+    Ptr<const SpectrumModel> rxModel =
+        LteSpectrumValueHelper::GetSpectrumModel(m_earfcn, m_bandwidth);
+    std::vector<RemTransmitter> transmitters;
+    for (auto nit = NodeList::Begin(); nit != NodeList::End(); ++nit)
+    {
+        for (uint32_t i = 0; i < (*nit)->GetNDevices(); ++i)
+        {
+            Ptr<LteEnbNetDevice> enbDev = DynamicCast<LteEnbNetDevice>((*nit)->GetDevice(i));
+            if (!enbDev)
+            {
+                continue;
+            }
+            for (const auto& [ccId, cc] : enbDev->GetCcMap())
+            {
+                Ptr<LteEnbPhy> phy = DynamicCast<ComponentCarrierEnb>(cc)->GetPhy();
+                Ptr<LteSpectrumPhy> dlPhy = phy->GetDownlinkSpectrumPhy();
+                if (dlPhy->GetChannel() != m_channel || !dlPhy->GetMobility())
+                {
+                    continue;
+                }
+                // the PSD of the control frames, which are sent on all the RBs
+                std::vector<int> rbs(cc->GetDlBandwidth());
+                std::iota(rbs.begin(), rbs.end(), 0);
+                Ptr<SpectrumValue> psd =
+                    LteSpectrumValueHelper::CreateTxPowerSpectralDensity(cc->GetDlEarfcn(),
+                                                                         cc->GetDlBandwidth(),
+                                                                         phy->GetTxPower(),
+                                                                         rbs);
+                if (psd->GetSpectrumModelUid() != rxModel->GetUid())
+                {
+                    if (psd->GetSpectrumModel()->IsOrthogonal(*rxModel))
+                    {
+                        continue;
+                    }
+                    SpectrumConverter converter(psd->GetSpectrumModel(), rxModel);
+                    psd = converter.Convert(psd);
+                }
+                RemTransmitter transmitter;
+                transmitter.phy = dlPhy;
+                transmitter.mobility = dlPhy->GetMobility();
+                transmitter.antenna = DynamicCast<AntennaModel>(dlPhy->GetAntenna());
+                transmitter.psd = psd;
+                transmitter.power = m_rbId >= 0 ? (*psd)[m_rbId] * 180000 : Integral(*psd);
+                transmitters.push_back(transmitter);
+            }
+        }
+    }
+    return transmitters;
+}
+
+void
+RadioEnvironmentMapHelper::ComputeTile(const std::vector<RemTransmitter>& transmitters,
+                                       const std::vector<double>& xs,
+                                       const std::vector<double>& ys,
+                                       std::size_t firstColumn,
+                                       std::size_t endColumn,
+                                       double* sinr) const
+{
+    NS_LOG_FUNCTION(this << firstColumn << endColumn);
+    Ptr<PropagationLossModel> propagationLoss = m_channel->GetPropagationLossModel();
+    Ptr<SpectrumPropagationLossModel> spectrumLoss = m_channel->GetSpectrumPropagationLossModel();
+    DoubleValue maxLossDb;
+    m_channel->GetAttribute("MaxLossDb", maxLossDb);
+
+    Ptr<MobilityModel> rx = CreateObject<ConstantPositionMobilityModel>();
+    Ptr<MobilityBuildingInfo> buildingInfo = CreateObject<MobilityBuildingInfo>();
+    rx->AggregateObject(buildingInfo);
+    // the gains of the antennas of the transmitters towards the points of a
+    // column, evaluated at once
+    std::vector<std::vector<double>> txAntennaGains(transmitters.size());
+    std::vector<Angles> txAngles;
+    for (std::size_t i = firstColumn; i < endColumn; ++i)
+    {
+        for (std::size_t t = 0; t < transmitters.size(); ++t)
+        {
+            if (transmitters[t].antenna)
+            {
+                Vector txPosition = transmitters[t].mobility->GetPosition();
+                txAngles.clear();
+                for (std::size_t j = 0; j < ys.size(); ++j)
+                {
+                    txAngles.emplace_back(Vector(xs[i], ys[j], m_z), txPosition);
+                }
+                transmitters[t].antenna->GetGainsDb(txAngles, txAntennaGains[t]);
+            }
+        }
+        for (std::size_t j = 0; j < ys.size(); ++j)
+        {
+            Vector position(xs[i], ys[j], m_z);
+            rx->SetPosition(position);
+            buildingInfo->MakeConsistent(rx);
+            // as the channel and the RemSpectrumPhy, with an isotropic
+            // receiver
+            double sumPower = 0;
+            double referenceSignalPower = 0;
+            for (std::size_t t = 0; t < transmitters.size(); ++t)
+            {
+                const RemTransmitter& transmitter = transmitters[t];
+                double pathLossDb = 0;
+                if (transmitter.antenna)
+                {
+                    pathLossDb -= txAntennaGains[t][j];
+                }
+                if (propagationLoss)
+                {
+                    pathLossDb -= propagationLoss->CalcRxPower(0, transmitter.mobility, rx);
+                }
+                if (pathLossDb > maxLossDb.Get())
+                {
+                    continue;
+                }
+                double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
+                double power = transmitter.power * pathGainLinear;
+                if (spectrumLoss)
+                {
+                    Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters>();
+                    params->psd = Copy<SpectrumValue>(transmitter.psd);
+                    *(params->psd) *= pathGainLinear;
+                    params->txPhy = transmitter.phy;
+                    params->txAntenna = transmitter.antenna;
+                    Ptr<SpectrumValue> psd =
+                        spectrumLoss->CalcRxPowerSpectralDensity(params, transmitter.mobility, rx);
+                    power = m_rbId >= 0 ? (*psd)[m_rbId] * 180000 : Integral(*psd);
+                }
+                sumPower += power;
+                referenceSignalPower = std::max(referenceSignalPower, power);
+            }
+            sinr[i * ys.size() + j] =
+                referenceSignalPower / (sumPower - referenceSignalPower + m_noisePower);
+        }
+    }
+}
+
+void
+RadioEnvironmentMapHelper::DirectInstall()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_channel->GetPhasedArraySpectrumPropagationLossModel(),
+                    "The direct REM does not support phased array spectrum propagation loss "
+                    "models");
+    m_xStep = (m_xMax - m_xMin) / (m_xRes - 1);
+    m_yStep = (m_yMax - m_yMin) / (m_yRes - 1);
+
+    // the points of DelayedInstall()
+    std::vector<double> xs;
+    std::vector<double> ys;
+    for (double x = m_xMin; x < m_xMax + 0.5 * m_xStep; x += m_xStep)
+    {
+        xs.push_back(x);
+    }
+    for (double y = m_yMin; y < m_yMax + 0.5 * m_yStep; y += m_yStep)
+    {
+        ys.push_back(y);
+    }
+    std::vector<RemTransmitter> transmitters = GetTransmitters();
+    NS_LOG_INFO("Computing a REM of " << xs.size() << "x" << ys.size() << " points from "
+                                      << transmitters.size() << " transmitters");
+
+    std::size_t tiles = (xs.size() + m_tileSize - 1) / m_tileSize;
+    std::size_t points = xs.size() * ys.size();
+    auto writeTile = [&](std::size_t tile, const double* sinr) {
+        std::size_t endColumn = std::min((tile + 1) * m_tileSize, xs.size());
+        for (std::size_t i = tile * m_tileSize; i < endColumn; ++i)
+        {
+            for (std::size_t j = 0; j < ys.size(); ++j)
+            {
+                m_outFile << xs[i] << "\t" << ys[j] << "\t" << m_z << "\t"
+                          << sinr[i * ys.size() + j] << "\n";
+            }
+        }
+    };
+
+#ifdef __WIN32__
+    std::vector<double> sinr(points);
+    for (std::size_t tile = 0; tile < tiles; ++tile)
+    {
+        ComputeTile(transmitters,
+                    xs,
+                    ys,
+                    tile * m_tileSize,
+                    std::min((tile + 1) * m_tileSize, xs.size()),
+                    sinr.data());
+        writeTile(tile, sinr.data());
+    }
+#else
+    uint32_t processes = m_processes;
+    if (processes == 0)
+    {
+        processes = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    processes = std::min<std::size_t>(processes, tiles);
+
+    // the processes take the next tile from a shared counter, and flag the
+    // tiles they computed, which are written in order as they complete
+    static_assert(std::atomic<uint32_t>::is_always_lock_free,
+                  "The tiles are flagged through lock free atomics");
+    std::size_t flagsSize = (tiles + 1) * sizeof(std::atomic<uint32_t>);
+    flagsSize = (flagsSize + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+    std::size_t size = flagsSize + points * sizeof(double);
+    void* mapping =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    NS_ABORT_MSG_IF(mapping == MAP_FAILED, "Can't allocate the REM");
+    auto flags = static_cast<std::atomic<uint32_t>*>(mapping);
+    for (std::size_t k = 0; k <= tiles; ++k)
+    {
+        new (&flags[k]) std::atomic<uint32_t>(0);
+    }
+    std::atomic<uint32_t>& nextTile = flags[tiles];
+    auto sinr = reinterpret_cast<double*>(static_cast<uint8_t*>(mapping) + flagsSize);
+
+    std::vector<pid_t> children;
+    for (uint32_t k = 0; k < processes; ++k)
+    {
+        std::fflush(nullptr);
+        pid_t pid = fork();
+        NS_ABORT_MSG_IF(pid < 0, "fork() failed");
+        if (pid == 0)
+        {
+            for (std::size_t tile = nextTile++; tile < tiles; tile = nextTile++)
+            {
+                ComputeTile(transmitters,
+                            xs,
+                            ys,
+                            tile * m_tileSize,
+                            std::min((tile + 1) * m_tileSize, xs.size()),
+                            sinr);
+                flags[tile].store(1, std::memory_order_release);
+            }
+            std::fflush(nullptr);
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+
+    std::size_t running = children.size();
+    for (std::size_t tile = 0; tile < tiles; ++tile)
+    {
+        while (!flags[tile].load(std::memory_order_acquire))
+        {
+            for (auto& pid : children)
+            {
+                int status;
+                if (pid > 0 && waitpid(pid, &status, WNOHANG) == pid)
+                {
+                    NS_ABORT_MSG_UNLESS(WIFEXITED(status) && WEXITSTATUS(status) == 0,
+                                        "The computation of the REM failed");
+                    pid = 0;
+                    --running;
+                }
+            }
+            if (running == 0)
+            {
+                // the children flagged the tile before exiting
+                NS_ABORT_MSG_UNLESS(flags[tile].load(std::memory_order_acquire),
+                                    "The computation of the REM failed");
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        writeTile(tile, sinr);
+    }
+    for (pid_t pid : children)
+    {
+        int status;
+        if (pid > 0)
+        {
+            NS_ABORT_MSG_IF(waitpid(pid, &status, 0) < 0, "waitpid() failed");
+            NS_ABORT_MSG_UNLESS(WIFEXITED(status) && WEXITSTATUS(status) == 0,
+                                "The computation of the REM failed");
+        }
+    }
+    munmap(mapping, size);
+#endif
+    Finalize();
+}
+
 void
 RadioEnvironmentMapHelper::Finalize()
 {
@@ -23,11 +23,15 @@
 #include <ns3/object.h>
 
 #include <fstream>
+#include <vector>
 
 namespace ns3
 {
 
 class RemSpectrumPhy;
+class LteSpectrumPhy;
+class AntennaModel;
+class SpectrumValue;
 class Node;
 class NetDevice;
 class SpectrumChannel;
@@ -40,6 +44,12 @@ class MobilityModel;
  * Generates a 2D map of the SINR from the strongest transmitter in the
  * downlink of an LTE FDD system. For instructions on usage, please refer to
  * the User Documentation.
+ *
+ * By default, the map is measured by RemSpectrumPhy objects attached to the
+ * channel, during the simulation. If the `Direct` attribute is true, the map
+ * is instead computed from the link budgets of the eNBs attached to the
+ * channel, through the propagation loss models of the channel, by child
+ * processes computing tiles of the map.
  */
 class RadioEnvironmentMapHelper : public Object
 {
@@ -104,6 +114,45 @@ class RadioEnvironmentMapHelper : public Object
     /// Called when the map generation procedure has been completed.
     void Finalize();
 
+    /// A transmitter of the direct computation of the map.
+    struct RemTransmitter
+    {
+        Ptr<LteSpectrumPhy> phy;      ///< The DL spectrum PHY of the eNB.
+        Ptr<MobilityModel> mobility;  ///< The position of the eNB.
+        Ptr<AntennaModel> antenna;    ///< The antenna of the eNB, if any.
+        Ptr<const SpectrumValue> psd; ///< The PSD, in the spectrum model of the map.
+        double power;                 ///< The power measured by the map, in W.
+    };
+
+    /**
+     * Scheduled by Install() instead of DelayedInstall() if the `Direct`
+     * attribute is true: computes the whole map, and writes it to the
+     * output file, without simulation events.
+     */
+    void DirectInstall();
+
+    /**
+     * \return the DL PHYs of the eNBs attached to the channel
+     */
+    std::vector<RemTransmitter> GetTransmitters() const;
+
+    /**
+     * Compute the SINR of a tile of the map.
+     *
+     * \param transmitters The transmitters.
+     * \param xs The x coordinates of the columns of the map.
+     * \param ys The y coordinates of the points of a column.
+     * \param firstColumn The first column of the tile.
+     * \param endColumn The column following the tile.
+     * \param sinr The SINR of the map, by column.
+     */
+    void ComputeTile(const std::vector<RemTransmitter>& transmitters,
+                     const std::vector<double>& xs,
+                     const std::vector<double>& ys,
+                     std::size_t firstColumn,
+                     std::size_t endColumn,
+                     double* sinr) const;
+
     /// A complete Radio Environment Map is composed of many of this structure.
     struct RemPoint
     {
@@ -159,6 +208,10 @@ class RadioEnvironmentMapHelper : public Object
     bool m_useDataChannel; ///< The `UseDataChannel` attribute.
     int32_t m_rbId;        ///< The `RbId` attribute.
 
+    bool m_direct;        ///< The `Direct` attribute.
+    uint32_t m_processes; ///< The `Processes` attribute.
+    uint32_t m_tileSize;  ///< The `TileSize` attribute.
+
 }; // end of `class RadioEnvironmentMapHelper`
 
 } // namespace ns3
@@ -142,21 +142,25 @@ A2A4RsrqHandoverAlgorithm::DoReportUeMeas(uint16_t rnti, LteRrcSap::MeasResults
     {
         NS_ASSERT_MSG(measResults.measResultPCell.rsrqResult <= m_servingCellThreshold,
                       "Invalid UE measurement report");
-        EvaluateHandover(rnti, measResults.measResultPCell.rsrqResult);
+        auto it = m_neighbourCellMeasures.find(rnti);
+        if (it == m_neighbourCellMeasures.end())
+        {
+            NS_LOG_WARN("Skipping handover evaluation for RNTI "
+                        << rnti << " because neighbour cells information is not found");
+        }
+        else
+        {
+            EvaluateHandover(rnti, measResults.measResultPCell.rsrqResult, it->second);
+        }
     }
     else if (std::find(begin(m_a4MeasIds), end(m_a4MeasIds), measResults.measId) !=
              std::end(m_a4MeasIds))
     {
         if (measResults.haveMeasResultNeighCells && !measResults.measResultListEutra.empty())
         {
-            for (auto it = measResults.measResultListEutra.begin();
-                 it != measResults.measResultListEutra.end();
-                 ++it)
-            {
-                NS_ASSERT_MSG(it->haveRsrqResult == true,
-                              "RSRQ measurement is missing from cellId " << it->physCellId);
-                UpdateNeighbourMeasurements(rnti, it->physCellId, it->rsrqResult);
-            }
+            // a new UE entry is inserted if needed
+            UpdateNeighbourMeasurements(m_neighbourCellMeasures[rnti],
+                                        measResults.measResultListEutra);
         }
         else
         {
@@ -172,49 +176,133 @@ A2A4RsrqHandoverAlgorithm::DoReportUeMeas(uint16_t rnti, LteRrcSap::MeasResults
 } // end of DoReportUeMeas
 
 void
-A2A4RsrqHandoverAlgorithm::EvaluateHandover(uint16_t rnti, uint8_t servingCellRsrq)
+A2A4RsrqHandoverAlgorithm::DoReportUeMeasBatch(
+    const std::vector<LteHandoverManagementSapProvider::UeMeasReport>& reports)
 {
-    NS_LOG_FUNCTION(this << rnti << (uint16_t)servingCellRsrq);
+    NS_LOG_FUNCTION(this << reports.size());
 
-    auto it1 = m_neighbourCellMeasures.find(rnti);
+    // the reports of each UE, in the order of the first report of each UE
+    struct UeReports
+    {
+        uint16_t rnti;
+        const LteRrcSap::MeasResults* a2Report;
+        std::vector<const std::list<LteRrcSap::MeasResultEutra>*> a4Lists;
+    };
+
+    std::vector<UeReports> ueReports;
+    std::map<uint16_t, std::size_t> ueReportsIndex;
 
-    if (it1 == m_neighbourCellMeasures.end())
+    for (const auto& report : reports)
     {
-        NS_LOG_WARN("Skipping handover evaluation for RNTI "
-                    << rnti << " because neighbour cells information is not found");
+        const LteRrcSap::MeasResults& measResults = report.measResults;
+        bool isA2 = std::find(begin(m_a2MeasIds), end(m_a2MeasIds), measResults.measId) !=
+                    std::end(m_a2MeasIds);
+        bool isA4 = std::find(begin(m_a4MeasIds), end(m_a4MeasIds), measResults.measId) !=
+                    std::end(m_a4MeasIds);
+
+        if (!isA2 && !isA4)
+        {
+            NS_LOG_WARN("Ignoring measId " << (uint16_t)measResults.measId);
+            continue;
+        }
+
+        if (!isA2 &&
+            (!measResults.haveMeasResultNeighCells || measResults.measResultListEutra.empty()))
+        {
+            NS_LOG_WARN(
+                this << " Event A4 received without measurement results from neighbouring cells");
+            continue;
+        }
+
+        auto ret = ueReportsIndex.insert(std::make_pair(report.rnti, ueReports.size()));
+        if (ret.second)
+        {
+            ueReports.push_back({report.rnti, nullptr, {}});
+        }
+        UeReports& ue = ueReports[ret.first->second];
+
+        if (isA2)
+        {
+            NS_ASSERT_MSG(measResults.measResultPCell.rsrqResult <= m_servingCellThreshold,
+                          "Invalid UE measurement report");
+            ue.a2Report = &measResults;
+        }
+        else
+        {
+            ue.a4Lists.push_back(&measResults.measResultListEutra);
+        }
     }
-    else
+
+    for (const auto& ue : ueReports)
     {
-        // Find the best neighbour cell (eNB)
-        NS_LOG_LOGIC("Number of neighbour cells = " << it1->second.size());
-        uint16_t bestNeighbourCellId = 0;
-        uint8_t bestNeighbourRsrq = 0;
-        for (auto it2 = it1->second.begin(); it2 != it1->second.end(); ++it2)
+        // the UE entry is looked up once for all the reports of the UE
+        auto it = m_neighbourCellMeasures.end();
+
+        if (!ue.a4Lists.empty())
         {
-            if ((it2->second->m_rsrq > bestNeighbourRsrq) && IsValidNeighbour(it2->first))
+            it = m_neighbourCellMeasures.insert(std::make_pair(ue.rnti, MeasurementRow_t())).first;
+            for (const auto measResultListEutra : ue.a4Lists)
             {
-                bestNeighbourCellId = it2->first;
-                bestNeighbourRsrq = it2->second->m_rsrq;
+                UpdateNeighbourMeasurements(it->second, *measResultListEutra);
             }
         }
 
-        // Trigger Handover, if needed
-        if (bestNeighbourCellId > 0)
+        if (ue.a2Report)
         {
-            NS_LOG_LOGIC("Best neighbour cellId " << bestNeighbourCellId);
-
-            if ((bestNeighbourRsrq - servingCellRsrq) >= m_neighbourCellOffset)
+            if (it == m_neighbourCellMeasures.end())
             {
-                NS_LOG_LOGIC("Trigger Handover to cellId " << bestNeighbourCellId);
-                NS_LOG_LOGIC("target cell RSRQ " << (uint16_t)bestNeighbourRsrq);
-                NS_LOG_LOGIC("serving cell RSRQ " << (uint16_t)servingCellRsrq);
+                it = m_neighbourCellMeasures.find(ue.rnti);
+            }
 
-                // Inform eNodeB RRC about handover
-                m_handoverManagementSapUser->TriggerHandover(rnti, bestNeighbourCellId);
+            if (it == m_neighbourCellMeasures.end())
+            {
+                NS_LOG_WARN("Skipping handover evaluation for RNTI "
+                            << ue.rnti << " because neighbour cells information is not found");
+            }
+            else
+            {
+                EvaluateHandover(ue.rnti, ue.a2Report->measResultPCell.rsrqResult, it->second);
             }
         }
+    }
+
+} // end of DoReportUeMeasBatch
+
+void
+A2A4RsrqHandoverAlgorithm::EvaluateHandover(uint16_t rnti,
+                                            uint8_t servingCellRsrq,
+                                            const MeasurementRow_t& row)
+{
+    NS_LOG_FUNCTION(this << rnti << (uint16_t)servingCellRsrq);
+
+    // Find the best neighbour cell (eNB)
+    NS_LOG_LOGIC("Number of neighbour cells = " << row.size());
+    uint16_t bestNeighbourCellId = 0;
+    uint8_t bestNeighbourRsrq = 0;
+    for (auto it = row.begin(); it != row.end(); ++it)
+    {
+        if ((it->second->m_rsrq > bestNeighbourRsrq) && IsValidNeighbour(it->first))
+        {
+            bestNeighbourCellId = it->first;
+            bestNeighbourRsrq = it->second->m_rsrq;
+        }
+    }
 
-    } // end of else of if (it1 == m_neighbourCellMeasures.end ())
+    // Trigger Handover, if needed
+    if (bestNeighbourCellId > 0)
+    {
+        NS_LOG_LOGIC("Best neighbour cellId " << bestNeighbourCellId);
+
+        if ((bestNeighbourRsrq - servingCellRsrq) >= m_neighbourCellOffset)
+        {
+            NS_LOG_LOGIC("Trigger Handover to cellId " << bestNeighbourCellId);
+            NS_LOG_LOGIC("target cell RSRQ " << (uint16_t)bestNeighbourRsrq);
+            NS_LOG_LOGIC("serving cell RSRQ " << (uint16_t)servingCellRsrq);
+
+            // Inform eNodeB RRC about handover
+            m_handoverManagementSapUser->TriggerHandover(rnti, bestNeighbourCellId);
+        }
+    }
 
 } // end of EvaluateMeasurementReport
 
@@ -233,39 +321,31 @@ A2A4RsrqHandoverAlgorithm::IsValidNeighbour(uint16_t cellId)
 }
 
 void
-A2A4RsrqHandoverAlgorithm::UpdateNeighbourMeasurements(uint16_t rnti, uint16_t cellId, uint8_t rsrq)
+A2A4RsrqHandoverAlgorithm::UpdateNeighbourMeasurements(
+    MeasurementRow_t& row,
+    const std::list<LteRrcSap::MeasResultEutra>& measResultListEutra)
 {
-    NS_LOG_FUNCTION(this << rnti << cellId << (uint16_t)rsrq);
-    auto it1 = m_neighbourCellMeasures.find(rnti);
+    NS_LOG_FUNCTION(this << measResultListEutra.size());
 
-    if (it1 == m_neighbourCellMeasures.end())
+    for (const auto& measResult : measResultListEutra)
     {
-        // insert a new UE entry
-        MeasurementRow_t row;
-        auto ret = m_neighbourCellMeasures.insert(std::pair<uint16_t, MeasurementRow_t>(rnti, row));
-        NS_ASSERT(ret.second);
-        it1 = ret.first;
-    }
+        NS_ASSERT_MSG(measResult.haveRsrqResult == true,
+                      "RSRQ measurement is missing from cellId " << measResult.physCellId);
+        uint16_t cellId = measResult.physCellId;
+        uint8_t rsrq = measResult.rsrqResult;
+        NS_LOG_LOGIC("cellId " << cellId << " RSRQ " << (uint16_t)rsrq);
 
-    NS_ASSERT(it1 != m_neighbourCellMeasures.end());
-    Ptr<UeMeasure> neighbourCellMeasures;
-    auto it2 = it1->second.find(cellId);
+        Ptr<UeMeasure>& neighbourCellMeasures = row[cellId];
+
+        if (!neighbourCellMeasures)
+        {
+            // insert a new cell entry
+            neighbourCellMeasures = Create<UeMeasure>();
+        }
 
-    if (it2 != it1->second.end())
-    {
-        neighbourCellMeasures = it2->second;
-        neighbourCellMeasures->m_cellId = cellId;
-        neighbourCellMeasures->m_rsrp = 0;
-        neighbourCellMeasures->m_rsrq = rsrq;
-    }
-    else
-    {
-        // insert a new cell entry
-        neighbourCellMeasures = Create<UeMeasure>();
         neighbourCellMeasures->m_cellId = cellId;
         neighbourCellMeasures->m_rsrp = 0;
         neighbourCellMeasures->m_rsrq = rsrq;
-        it1->second[cellId] = neighbourCellMeasures;
     }
 
 } // end of UpdateNeighbourMeasurements
@@ -107,41 +107,19 @@ class A2A4RsrqHandoverAlgorithm : public LteHandoverAlgorithm
     // inherited from LteHandoverAlgorithm as a Handover Management SAP implementation
     void DoReportUeMeas(uint16_t rnti, LteRrcSap::MeasResults measResults) override;
 
-  private:
     /**
-     * Called when Event A2 is detected, then trigger a handover if needed.
+     * \brief Implementation of LteHandoverManagementSapProvider::ReportUeMeasBatch.
+     * \param reports the reports, in the order in which they were received
      *
-     * \param rnti The RNTI of the UE who reported the event.
-     * \param servingCellRsrq The RSRQ of this cell as reported by the UE.
+     * The neighbour measurements of each UE are looked up once, updated with
+     * all its Event A4 reports in the batch, and then, if the UE has also
+     * reported Event A2, a single handover decision is made with its latest
+     * Event A2 report.
      */
-    void EvaluateHandover(uint16_t rnti, uint8_t servingCellRsrq);
-
-    /**
-     * Determines if a neighbour cell is a valid destination for handover.
-     * Currently always return true.
-     *
-     * \param cellId The cell ID of the neighbour cell.
-     * \return True if the cell is a valid destination for handover.
-     */
-    bool IsValidNeighbour(uint16_t cellId);
-
-    /**
-     * Called when Event A4 is reported, then update the measurements table.
-     * If the RNTI and/or cell ID is not found in the table, a corresponding
-     * entry will be created. Only the latest measurements are stored in the
-     * table.
-     *
-     * \param rnti The RNTI of the UE who reported the event.
-     * \param cellId The cell ID of the measured cell.
-     * \param rsrq The RSRQ of the cell as measured by the UE.
-     */
-    void UpdateNeighbourMeasurements(uint16_t rnti, uint16_t cellId, uint8_t rsrq);
-
-    /// The expected measurement identities for A2 measurements.
-    std::vector<uint8_t> m_a2MeasIds;
-    /// The expected measurement identities for A4 measurements.
-    std::vector<uint8_t> m_a4MeasIds;
+    void DoReportUeMeasBatch(
+        const std::vector<LteHandoverManagementSapProvider::UeMeasReport>& reports) override;
 
+  private:
     /**
      * Measurements reported by a UE for a cell ID. The values are quantized
      * according 3GPP TS 36.133 section 9.1.4 and 9.1.7.
@@ -166,6 +144,41 @@ class A2A4RsrqHandoverAlgorithm : public LteHandoverAlgorithm
      */
     typedef std::map<uint16_t, MeasurementRow_t> MeasurementTable_t;
 
+    /**
+     * Called when Event A2 is detected, then trigger a handover if needed.
+     *
+     * \param rnti The RNTI of the UE who reported the event.
+     * \param servingCellRsrq The RSRQ of this cell as reported by the UE.
+     * \param row The neighbour cell measurements of the UE.
+     */
+    void EvaluateHandover(uint16_t rnti, uint8_t servingCellRsrq, const MeasurementRow_t& row);
+
+    /**
+     * Determines if a neighbour cell is a valid destination for handover.
+     * Currently always return true.
+     *
+     * \param cellId The cell ID of the neighbour cell.
+     * \return True if the cell is a valid destination for handover.
+     */
+    bool IsValidNeighbour(uint16_t cellId);
+
+    /**
+     * Called when Event A4 is reported, then update the measurements of a UE.
+     * If a cell ID is not found in the row, a corresponding entry will be
+     * created. Only the latest measurements are stored in the row.
+     *
+     * \param row The neighbour cell measurements of the UE who reported the event.
+     * \param measResultListEutra The cells measured by the UE, with their RSRQ.
+     */
+    void UpdateNeighbourMeasurements(
+        MeasurementRow_t& row,
+        const std::list<LteRrcSap::MeasResultEutra>& measResultListEutra);
+
+    /// The expected measurement identities for A2 measurements.
+    std::vector<uint8_t> m_a2MeasIds;
+    /// The expected measurement identities for A4 measurements.
+    std::vector<uint8_t> m_a4MeasIds;
+
     /// Table of measurement reports from all UEs.
     MeasurementTable_t m_neighbourCellMeasures;
 
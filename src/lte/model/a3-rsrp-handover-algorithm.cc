@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <list>
+#include <map>
 
 namespace ns3
 {
@@ -134,24 +135,9 @@ A3RsrpHandoverAlgorithm::DoReportUeMeas(uint16_t rnti, LteRrcSap::MeasResults me
     {
         uint16_t bestNeighbourCellId = 0;
         uint8_t bestNeighbourRsrp = 0;
-
-        for (auto it = measResults.measResultListEutra.begin();
-             it != measResults.measResultListEutra.end();
-             ++it)
-        {
-            if (it->haveRsrpResult)
-            {
-                if ((bestNeighbourRsrp < it->rsrpResult) && IsValidNeighbour(it->physCellId))
-                {
-                    bestNeighbourCellId = it->physCellId;
-                    bestNeighbourRsrp = it->rsrpResult;
-                }
-            }
-            else
-            {
-                NS_LOG_WARN("RSRP measurement is missing from cell ID " << it->physCellId);
-            }
-        }
+        UpdateBestNeighbour(measResults.measResultListEutra,
+                            bestNeighbourCellId,
+                            bestNeighbourRsrp);
 
         if (bestNeighbourCellId > 0)
         {
@@ -171,6 +157,97 @@ A3RsrpHandoverAlgorithm::DoReportUeMeas(uint16_t rnti, LteRrcSap::MeasResults me
 
 } // end of DoReportUeMeas
 
+void
+A3RsrpHandoverAlgorithm::DoReportUeMeasBatch(
+    const std::vector<LteHandoverManagementSapProvider::UeMeasReport>& reports)
+{
+    NS_LOG_FUNCTION(this << reports.size());
+
+    // the best neighbour cell of each UE over all its reports, in the order of
+    // the first report of each UE
+    struct BestNeighbour
+    {
+        uint16_t rnti;
+        uint16_t cellId;
+        uint8_t rsrp;
+        uint8_t servingCellRsrp;
+    };
+
+    std::vector<BestNeighbour> bestNeighbours;
+    std::map<uint16_t, std::size_t> bestNeighbourIndex;
+
+    for (const auto& report : reports)
+    {
+        const LteRrcSap::MeasResults& measResults = report.measResults;
+
+        if (std::find(begin(m_measIds), end(m_measIds), measResults.measId) == std::end(m_measIds))
+        {
+            NS_LOG_WARN("Ignoring measId " << (uint16_t)measResults.measId);
+            continue;
+        }
+
+        if (!measResults.haveMeasResultNeighCells || measResults.measResultListEutra.empty())
+        {
+            NS_LOG_WARN(
+                this << " Event A3 received without measurement results from neighbouring cells");
+            continue;
+        }
+
+        auto ret = bestNeighbourIndex.insert(std::make_pair(report.rnti, bestNeighbours.size()));
+        if (ret.second)
+        {
+            bestNeighbours.push_back({report.rnti, 0, 0, 0});
+        }
+        BestNeighbour& best = bestNeighbours[ret.first->second];
+
+        uint8_t previousRsrp = best.rsrp;
+        UpdateBestNeighbour(measResults.measResultListEutra, best.cellId, best.rsrp);
+        if (best.rsrp != previousRsrp)
+        {
+            best.servingCellRsrp = measResults.measResultPCell.rsrpResult;
+        }
+    }
+
+    // a single handover decision per UE
+    for (const auto& best : bestNeighbours)
+    {
+        if (best.cellId > 0)
+        {
+            NS_LOG_LOGIC("Trigger Handover of RNTI " << best.rnti << " to cellId " << best.cellId);
+            NS_LOG_LOGIC("target cell RSRP " << (uint16_t)best.rsrp);
+            NS_LOG_LOGIC("serving cell RSRP " << (uint16_t)best.servingCellRsrp);
+
+            // Inform eNodeB RRC about handover
+            m_handoverManagementSapUser->TriggerHandover(best.rnti, best.cellId);
+        }
+    }
+
+} // end of DoReportUeMeasBatch
+
+void
+A3RsrpHandoverAlgorithm::UpdateBestNeighbour(
+    const std::list<LteRrcSap::MeasResultEutra>& measResultListEutra,
+    uint16_t& bestNeighbourCellId,
+    uint8_t& bestNeighbourRsrp)
+{
+    for (const auto& measResult : measResultListEutra)
+    {
+        if (measResult.haveRsrpResult)
+        {
+            if ((bestNeighbourRsrp < measResult.rsrpResult) &&
+                IsValidNeighbour(measResult.physCellId))
+            {
+                bestNeighbourCellId = measResult.physCellId;
+                bestNeighbourRsrp = measResult.rsrpResult;
+            }
+        }
+        else
+        {
+            NS_LOG_WARN("RSRP measurement is missing from cell ID " << measResult.physCellId);
+        }
+    }
+}
+
 bool
 A3RsrpHandoverAlgorithm::IsValidNeighbour(uint16_t cellId)
 {
@@ -91,7 +91,29 @@ class A3RsrpHandoverAlgorithm : public LteHandoverAlgorithm
     // inherited from LteHandoverAlgorithm as a Handover Management SAP implementation
     void DoReportUeMeas(uint16_t rnti, LteRrcSap::MeasResults measResults) override;
 
+    /**
+     * \brief Implementation of LteHandoverManagementSapProvider::ReportUeMeasBatch.
+     * \param reports the reports, in the order in which they were received
+     *
+     * The best neighbour cell of each UE is selected over all its reports in
+     * the batch, and at most one handover is triggered per UE.
+     */
+    void DoReportUeMeasBatch(
+        const std::vector<LteHandoverManagementSapProvider::UeMeasReport>& reports) override;
+
   private:
+    /**
+     * Select the best valid neighbour cell of a report, if it is better than
+     * the best neighbour cell found so far.
+     *
+     * \param measResultListEutra The cells measured by the UE, with their RSRP.
+     * \param bestNeighbourCellId The best neighbour cell so far, 0 if none, updated.
+     * \param bestNeighbourRsrp The RSRP of the best neighbour cell so far, updated.
+     */
+    void UpdateBestNeighbour(const std::list<LteRrcSap::MeasResultEutra>& measResultListEutra,
+                             uint16_t& bestNeighbourCellId,
+                             uint8_t& bestNeighbourRsrp);
+
     /**
      * Determines if a neighbour cell is a valid destination for handover.
      * Currently always return true.
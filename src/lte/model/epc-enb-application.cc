@@ -81,6 +81,7 @@ EpcEnbApplication::DoDispose()
     m_lteSocket = nullptr;
     m_lteSocket6 = nullptr;
     m_s1uSocket = nullptr;
+    m_s1uDirectLink = nullptr;
     delete m_s1SapProvider;
     delete m_s1apSapEnb;
 }
@@ -109,11 +110,21 @@ EpcEnbApplication::AddS1Interface(Ptr<Socket> s1uSocket,
     NS_LOG_FUNCTION(this << s1uSocket << enbAddress << sgwAddress);
 
     m_s1uSocket = s1uSocket;
-    m_s1uSocket->SetRecvCallback(MakeCallback(&EpcEnbApplication::RecvFromS1uSocket, this));
+    if (m_s1uSocket)
+    {
+        m_s1uSocket->SetRecvCallback(MakeCallback(&EpcEnbApplication::RecvFromS1uSocket, this));
+    }
     m_enbS1uAddress = enbAddress;
     m_sgwS1uAddress = sgwAddress;
 }
 
+void
+EpcEnbApplication::SetS1uDirectLink(Ptr<EpcGtpuDirectLink> link)
+{
+    NS_LOG_FUNCTION(this << link);
+    m_s1uDirectLink = link;
+}
+
 EpcEnbApplication::~EpcEnbApplication()
 {
     NS_LOG_FUNCTION(this);
@@ -301,7 +312,19 @@ EpcEnbApplication::RecvFromS1uSocket(Ptr<Socket> socket)
     Ptr<Packet> packet = socket->Recv();
     GtpuHeader gtpu;
     packet->RemoveHeader(gtpu);
-    uint32_t teid = gtpu.GetTeid();
+    DoRecvFromS1u(packet, gtpu.GetTeid());
+}
+
+void
+EpcEnbApplication::RecvFromS1uDirectLink(Ptr<Packet> packet, uint32_t teid)
+{
+    NS_LOG_FUNCTION(this << packet << teid);
+    DoRecvFromS1u(packet, teid);
+}
+
+void
+EpcEnbApplication::DoRecvFromS1u(Ptr<Packet> packet, uint32_t teid)
+{
     NS_LOG_INFO("Received packet from S1-U interface with GTP TEID: " << teid);
     auto it = m_teidRbidMap.find(teid);
     if (it == m_teidRbidMap.end())
@@ -350,6 +373,12 @@ void
 EpcEnbApplication::SendToS1uSocket(Ptr<Packet> packet, uint32_t teid)
 {
     NS_LOG_FUNCTION(this << packet << teid << packet->GetSize());
+    if (m_s1uDirectLink)
+    {
+        NS_LOG_INFO("Forward packet from eNB's LTE to S1-U direct link with TEID: " << teid);
+        m_s1uDirectLink->Send(packet, teid);
+        return;
+    }
     GtpuHeader gtpu;
     gtpu.SetTeid(teid);
     // From 3GPP TS 29.281 v10.0.0 Section 5.1
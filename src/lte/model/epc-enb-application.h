@@ -22,6 +22,7 @@
 #define EPC_ENB_APPLICATION_H
 
 #include "epc-enb-s1-sap.h"
+#include "epc-gtpu-direct-link.h"
 #include "epc-s1ap-sap.h"
 
 #include <ns3/address.h>
@@ -79,7 +80,7 @@ class EpcEnbApplication : public Application
      * Add a S1-U interface to the eNB
      *
      * \param s1uSocket the socket to be used to send/receive packets to/from the S1-U interface
-     * connected with the SGW
+     * connected with the SGW, or null if the user plane packets go over direct links
      * \param enbS1uAddress the IPv4 address of the S1-U interface of this eNB
      * \param sgwS1uAddress the IPv4 address at which this eNB will be able to reach its SGW for
      * S1-U communications
@@ -88,6 +89,15 @@ class EpcEnbApplication : public Application
                         Ipv4Address enbS1uAddress,
                         Ipv4Address sgwS1uAddress);
 
+    /**
+     * Forward the uplink user plane packets to the SGW over a direct link
+     * instead of the S1-U socket. The downlink direct link is expected to
+     * be connected to RecvFromS1uDirectLink().
+     *
+     * \param link the direct link towards the SGW
+     */
+    void SetS1uDirectLink(Ptr<EpcGtpuDirectLink> link);
+
     /**
      * Destructor
      *
@@ -136,6 +146,15 @@ class EpcEnbApplication : public Application
      */
     void RecvFromS1uSocket(Ptr<Socket> socket);
 
+    /**
+     * Method to be assigned to the receive callback of the direct link from the SGW. It is
+     * called when the eNB receives a data packet from the SGW that is to be forwarded to the UE.
+     *
+     * \param packet the packet, without GTP-U header
+     * \param teid the Tunnel Endpoint Identifier
+     */
+    void RecvFromS1uDirectLink(Ptr<Packet> packet, uint32_t teid);
+
     /**
      * TracedCallback signature for data Packet reception event.
      *
@@ -257,6 +276,14 @@ class EpcEnbApplication : public Application
      */
     void SetupS1Bearer(uint32_t teid, uint16_t rnti, uint8_t bid);
 
+    /**
+     * Forward a packet received from the S1-U interface to the UE
+     *
+     * \param packet the packet, without GTP-U header
+     * \param teid the Tunnel Endpoint Identifier
+     */
+    void DoRecvFromS1u(Ptr<Packet> packet, uint32_t teid);
+
     /**
      * raw packet socket to send and receive the packets to and from the LTE radio interface
      */
@@ -272,6 +299,11 @@ class EpcEnbApplication : public Application
      */
     Ptr<Socket> m_s1uSocket;
 
+    /**
+     * direct link used instead of the S1-U socket to send packets to the SGW, if any
+     */
+    Ptr<EpcGtpuDirectLink> m_s1uDirectLink;
+
     /**
      * address of the eNB for S1-U communications
      */
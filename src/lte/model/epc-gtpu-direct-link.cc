@@ -0,0 +1,116 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "epc-gtpu-direct-link.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EpcGtpuDirectLink");
+
+NS_OBJECT_ENSURE_REGISTERED(EpcGtpuDirectLink);
+
+TypeId
+EpcGtpuDirectLink::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::EpcGtpuDirectLink")
+            .SetParent<Object>()
+            .SetGroupName("Lte")
+            .AddConstructor<EpcGtpuDirectLink>()
+            .AddAttribute("DataRate",
+                          "The data rate of the link",
+                          DataRateValue(DataRate("10Gb/s")),
+                          MakeDataRateAccessor(&EpcGtpuDirectLink::m_dataRate),
+                          MakeDataRateChecker())
+            .AddAttribute("Delay",
+                          "The propagation delay of the link",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&EpcGtpuDirectLink::m_delay),
+                          MakeTimeChecker())
+            .AddAttribute("Overhead",
+                          "The number of bytes added to each packet when computing its "
+                          "transmission time. The default accounts for the GTP-U, UDP, IPv4 "
+                          "and PPP headers that the tunneled packet would carry.",
+                          UintegerValue(38),
+                          MakeUintegerAccessor(&EpcGtpuDirectLink::m_overhead),
+                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+EpcGtpuDirectLink::EpcGtpuDirectLink()
+    : m_txEndTime(Seconds(0)),
+      m_rxNodeId(Simulator::NO_CONTEXT)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+EpcGtpuDirectLink::~EpcGtpuDirectLink()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+EpcGtpuDirectLink::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_rxCallback = MakeNullCallback<void, Ptr<Packet>, uint32_t>();
+    Object::DoDispose();
+}
+
+void
+EpcGtpuDirectLink::SetReceiver(Ptr<Node> node, ReceiveCallback cb)
+{
+    NS_LOG_FUNCTION(this << node);
+    m_rxNodeId = node->GetId();
+    m_rxCallback = cb;
+}
+
+void
+EpcGtpuDirectLink::Send(Ptr<Packet> packet, uint32_t teid)
+{
+    NS_LOG_FUNCTION(this << packet << teid << packet->GetSize());
+    NS_ASSERT_MSG(!m_rxCallback.IsNull(), "the far end of the link is not set");
+
+    // packets are transmitted back to back: a packet starts its
+    // transmission when the previous one is over
+    Time now = Simulator::Now();
+    Time txStart = std::max(now, m_txEndTime);
+    m_txEndTime = txStart + m_dataRate.CalculateBytesTxTime(packet->GetSize() + m_overhead);
+    Time rxTime = m_txEndTime + m_delay;
+    NS_LOG_LOGIC("TEID " << teid << " delivered at " << rxTime.As(Time::S));
+    Simulator::ScheduleWithContext(m_rxNodeId,
+                                   rxTime - now,
+                                   &EpcGtpuDirectLink::Receive,
+                                   this,
+                                   packet,
+                                   teid);
+}
+
+void
+EpcGtpuDirectLink::Receive(Ptr<Packet> packet, uint32_t teid)
+{
+    NS_LOG_FUNCTION(this << packet << teid);
+    if (!m_rxCallback.IsNull())
+    {
+        m_rxCallback(packet, teid);
+    }
+}
+
+} // namespace ns3
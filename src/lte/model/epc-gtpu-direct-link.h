@@ -0,0 +1,100 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EPC_GTPU_DIRECT_LINK_H
+#define EPC_GTPU_DIRECT_LINK_H
+
+#include "ns3/callback.h"
+#include "ns3/data-rate.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/packet.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup lte
+ *
+ * Unidirectional user plane link between two EPC applications
+ * (eNB -> SGW, SGW -> eNB, SGW -> PGW or PGW -> SGW).
+ *
+ * The link replaces the GTP-U/UDP/IP encapsulation and the point-to-point
+ * NetDevices of the S1-U and S5-U interfaces: the packet is handed over
+ * as is, together with its TEID, to the receive callback of the far end.
+ * Packets are serialized one after the other at the configured data rate
+ * (accounting for the tunneling overhead of each packet) and then
+ * delivered after the configured propagation delay. The link has no
+ * queue limit, so packets are never dropped.
+ */
+class EpcGtpuDirectLink : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    EpcGtpuDirectLink();
+    ~EpcGtpuDirectLink() override;
+
+    /**
+     * Callback invoked at the far end of the link
+     * with the received packet and its TEID
+     */
+    typedef Callback<void, Ptr<Packet>, uint32_t> ReceiveCallback;
+
+    /**
+     * Set the far end of the link
+     *
+     * \param node the node hosting the receiving application, used as
+     *             the context of the reception events
+     * \param cb the callback to be invoked upon reception
+     */
+    void SetReceiver(Ptr<Node> node, ReceiveCallback cb);
+
+    /**
+     * Send a packet over the link
+     *
+     * \param packet the packet, without any GTP-U header
+     * \param teid the TEID of the tunnel the packet belongs to
+     */
+    void Send(Ptr<Packet> packet, uint32_t teid);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * Deliver a packet to the far end of the link
+     *
+     * \param packet the packet
+     * \param teid the TEID of the tunnel the packet belongs to
+     */
+    void Receive(Ptr<Packet> packet, uint32_t teid);
+
+    DataRate m_dataRate;          ///< The data rate of the link
+    Time m_delay;                 ///< The propagation delay of the link
+    uint32_t m_overhead;          ///< The tunneling overhead per packet, in bytes
+    Time m_txEndTime;             ///< The end of the transmission of the last packet sent
+    uint32_t m_rxNodeId;          ///< The id of the node at the far end of the link
+    ReceiveCallback m_rxCallback; ///< The receive callback of the far end
+};
+
+} // namespace ns3
+
+#endif // EPC_GTPU_DIRECT_LINK_H
@@ -135,10 +135,14 @@ void
 EpcPgwApplication::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    m_s5uSocket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
-    m_s5uSocket = nullptr;
+    if (m_s5uSocket)
+    {
+        m_s5uSocket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+        m_s5uSocket = nullptr;
+    }
     m_s5cSocket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
     m_s5cSocket = nullptr;
+    m_s5uDirectLinks.clear();
 }
 
 EpcPgwApplication::EpcPgwApplication(const Ptr<VirtualNetDevice> tunDevice,
@@ -153,7 +157,10 @@ EpcPgwApplication::EpcPgwApplication(const Ptr<VirtualNetDevice> tunDevice,
       m_gtpcUdpPort(2123)  // fixed by the standard
 {
     NS_LOG_FUNCTION(this << tunDevice << s5Addr << s5uSocket << s5cSocket);
-    m_s5uSocket->SetRecvCallback(MakeCallback(&EpcPgwApplication::RecvFromS5uSocket, this));
+    if (m_s5uSocket)
+    {
+        SetS5uSocket(m_s5uSocket);
+    }
     m_s5cSocket->SetRecvCallback(MakeCallback(&EpcPgwApplication::RecvFromS5cSocket, this));
 }
 
@@ -253,6 +260,24 @@ EpcPgwApplication::RecvFromS5uSocket(Ptr<Socket> socket)
     SendToTunDevice(packet, teid);
 }
 
+void
+EpcPgwApplication::RecvFromS5uDirectLink(Ptr<Packet> packet, uint32_t teid)
+{
+    NS_LOG_FUNCTION(this << packet << teid);
+    if (!m_rxS5PktTrace.IsEmpty())
+    {
+        // the trace reports the packets as received from the S5-U socket
+        Ptr<Packet> tracedPacket = packet->Copy();
+        GtpuHeader gtpu;
+        gtpu.SetTeid(teid);
+        gtpu.SetLength(packet->GetSize() + gtpu.GetSerializedSize() - 8);
+        tracedPacket->AddHeader(gtpu);
+        m_rxS5PktTrace(tracedPacket);
+    }
+
+    SendToTunDevice(packet, teid);
+}
+
 void
 EpcPgwApplication::RecvFromS5cSocket(Ptr<Socket> socket)
 {
@@ -469,6 +494,13 @@ EpcPgwApplication::SendToS5uSocket(Ptr<Packet> packet, Ipv4Address sgwAddr, uint
 {
     NS_LOG_FUNCTION(this << packet << sgwAddr << teid);
 
+    auto linkIt = m_s5uDirectLinks.find(sgwAddr);
+    if (linkIt != m_s5uDirectLinks.end())
+    {
+        linkIt->second->Send(packet, teid);
+        return;
+    }
+
     GtpuHeader gtpu;
     gtpu.SetTeid(teid);
     // From 3GPP TS 29.281 v10.0.0 Section 5.1
@@ -486,6 +518,28 @@ EpcPgwApplication::AddSgw(Ipv4Address sgwS5Addr)
     m_sgwS5Addr = sgwS5Addr;
 }
 
+void
+EpcPgwApplication::SetS5uSocket(Ptr<Socket> s5uSocket)
+{
+    NS_LOG_FUNCTION(this << s5uSocket);
+    if (m_s5uSocket)
+    {
+        m_s5uSocket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    }
+    m_s5uSocket = s5uSocket;
+    if (m_s5uSocket)
+    {
+        m_s5uSocket->SetRecvCallback(MakeCallback(&EpcPgwApplication::RecvFromS5uSocket, this));
+    }
+}
+
+void
+EpcPgwApplication::AddS5uDirectLink(Ipv4Address sgwS5Addr, Ptr<EpcGtpuDirectLink> link)
+{
+    NS_LOG_FUNCTION(this << sgwS5Addr << link);
+    m_s5uDirectLinks[sgwS5Addr] = link;
+}
+
 void
 EpcPgwApplication::AddUe(uint64_t imsi)
 {
@@ -22,6 +22,7 @@
 #define EPC_PGW_APPLICATION_H
 
 #include "epc-gtpc-header.h"
+#include "epc-gtpu-direct-link.h"
 #include "epc-tft-classifier.h"
 
 #include "ns3/application.h"
@@ -66,7 +67,8 @@ class EpcPgwApplication : public Application
      * the SGi interface of the PGW in the internet
      * over GTP-U/UDP/IP on the S5 interface
      * \param s5Addr IP address of the PGW S5 interface
-     * \param s5uSocket socket used to send GTP-U packets to the peer SGW
+     * \param s5uSocket socket used to send GTP-U packets to the peer SGW,
+     * or null if it is set later
      * \param s5cSocket socket used to send GTP-C packets to the peer SGW
      */
     EpcPgwApplication(const Ptr<VirtualNetDevice> tunDevice,
@@ -103,6 +105,16 @@ class EpcPgwApplication : public Application
      */
     void RecvFromS5uSocket(Ptr<Socket> socket);
 
+    /**
+     * Method to be assigned to the receive callback of the direct link from the SGW.
+     * It is called when the PGW receives a data packet from the SGW
+     * that is to be forwarded to the internet.
+     *
+     * \param packet the packet, without GTP-U header
+     * \param teid the Tunnel Endpoint Identifier
+     */
+    void RecvFromS5uDirectLink(Ptr<Packet> packet, uint32_t teid);
+
     /**
      * Method to be assigned to the receiver callback of the S5-C socket.
      * It is called when the PGW receives a control packet from the SGW.
@@ -135,6 +147,25 @@ class EpcPgwApplication : public Application
      */
     void AddSgw(Ipv4Address sgwS5Addr);
 
+    /**
+     * Set the socket used to send/receive GTP-U packets to/from the SGWs,
+     * replacing the one given to the constructor
+     *
+     * \param s5uSocket the S5-U socket, or null if the packets are only
+     *        forwarded over direct links
+     */
+    void SetS5uSocket(Ptr<Socket> s5uSocket);
+
+    /**
+     * Forward the downlink user plane packets to a SGW over a direct link
+     * instead of the S5-U socket. The uplink direct link from the SGW is
+     * expected to be connected to RecvFromS5uDirectLink().
+     *
+     * \param sgwS5Addr the address of the SGW S5 interface
+     * \param link the direct link towards the SGW
+     */
+    void AddS5uDirectLink(Ipv4Address sgwS5Addr, Ptr<EpcGtpuDirectLink> link);
+
     /**
      * Let the PGW be aware of a new UE
      *
@@ -328,6 +359,11 @@ class EpcPgwApplication : public Application
      */
     Ipv4Address m_sgwS5Addr;
 
+    /**
+     * Direct links used instead of the S5-U socket to send packets to the SGWs, by SGW address
+     */
+    std::map<Ipv4Address, Ptr<EpcGtpuDirectLink>> m_s5uDirectLinks;
+
     /**
      * \brief Callback to trace received data packets at Tun NetDevice from internet.
      */
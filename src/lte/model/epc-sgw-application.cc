@@ -45,8 +45,14 @@ EpcSgwApplication::EpcSgwApplication(const Ptr<Socket> s1uSocket,
       m_teidCount(0)
 {
     NS_LOG_FUNCTION(this << s1uSocket << s5Addr << s5uSocket << s5cSocket);
-    m_s1uSocket->SetRecvCallback(MakeCallback(&EpcSgwApplication::RecvFromS1uSocket, this));
-    m_s5uSocket->SetRecvCallback(MakeCallback(&EpcSgwApplication::RecvFromS5uSocket, this));
+    if (m_s1uSocket)
+    {
+        SetS1uSocket(m_s1uSocket);
+    }
+    if (m_s5uSocket)
+    {
+        SetS5uSocket(m_s5uSocket);
+    }
     m_s5cSocket->SetRecvCallback(MakeCallback(&EpcSgwApplication::RecvFromS5cSocket, this));
 }
 
@@ -59,12 +65,20 @@ void
 EpcSgwApplication::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    m_s1uSocket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
-    m_s1uSocket = nullptr;
-    m_s5uSocket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
-    m_s5uSocket = nullptr;
+    if (m_s1uSocket)
+    {
+        m_s1uSocket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+        m_s1uSocket = nullptr;
+    }
+    if (m_s5uSocket)
+    {
+        m_s5uSocket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+        m_s5uSocket = nullptr;
+    }
     m_s5cSocket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
     m_s5cSocket = nullptr;
+    m_s5uDirectLink = nullptr;
+    m_s1uDirectLinks.clear();
 }
 
 TypeId
@@ -100,6 +114,50 @@ EpcSgwApplication::AddEnb(uint16_t cellId, Ipv4Address enbAddr, Ipv4Address sgwA
     m_enbInfoByCellId[cellId] = enbInfo;
 }
 
+void
+EpcSgwApplication::SetS1uSocket(Ptr<Socket> s1uSocket)
+{
+    NS_LOG_FUNCTION(this << s1uSocket);
+    if (m_s1uSocket)
+    {
+        m_s1uSocket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    }
+    m_s1uSocket = s1uSocket;
+    if (m_s1uSocket)
+    {
+        m_s1uSocket->SetRecvCallback(MakeCallback(&EpcSgwApplication::RecvFromS1uSocket, this));
+    }
+}
+
+void
+EpcSgwApplication::SetS5uSocket(Ptr<Socket> s5uSocket)
+{
+    NS_LOG_FUNCTION(this << s5uSocket);
+    if (m_s5uSocket)
+    {
+        m_s5uSocket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    }
+    m_s5uSocket = s5uSocket;
+    if (m_s5uSocket)
+    {
+        m_s5uSocket->SetRecvCallback(MakeCallback(&EpcSgwApplication::RecvFromS5uSocket, this));
+    }
+}
+
+void
+EpcSgwApplication::AddS1uDirectLink(Ipv4Address enbAddr, Ptr<EpcGtpuDirectLink> link)
+{
+    NS_LOG_FUNCTION(this << enbAddr << link);
+    m_s1uDirectLinks[enbAddr] = link;
+}
+
+void
+EpcSgwApplication::SetS5uDirectLink(Ptr<EpcGtpuDirectLink> link)
+{
+    NS_LOG_FUNCTION(this << link);
+    m_s5uDirectLink = link;
+}
+
 void
 EpcSgwApplication::RecvFromS11Socket(Ptr<Socket> socket)
 {
@@ -149,6 +207,15 @@ EpcSgwApplication::RecvFromS5uSocket(Ptr<Socket> socket)
     SendToS1uSocket(packet, enbAddr, teid);
 }
 
+void
+EpcSgwApplication::RecvFromS5uDirectLink(Ptr<Packet> packet, uint32_t teid)
+{
+    NS_LOG_FUNCTION(this << packet << teid);
+    Ipv4Address enbAddr = m_enbByTeidMap[teid];
+    NS_LOG_DEBUG("eNB " << enbAddr << " TEID " << teid);
+    SendToS1uSocket(packet, enbAddr, teid);
+}
+
 void
 EpcSgwApplication::RecvFromS5cSocket(Ptr<Socket> socket)
 {
@@ -192,11 +259,25 @@ EpcSgwApplication::RecvFromS1uSocket(Ptr<Socket> socket)
     SendToS5uSocket(packet, m_pgwAddr, teid);
 }
 
+void
+EpcSgwApplication::RecvFromS1uDirectLink(Ptr<Packet> packet, uint32_t teid)
+{
+    NS_LOG_FUNCTION(this << packet << teid);
+    SendToS5uSocket(packet, m_pgwAddr, teid);
+}
+
 void
 EpcSgwApplication::SendToS1uSocket(Ptr<Packet> packet, Ipv4Address enbAddr, uint32_t teid)
 {
     NS_LOG_FUNCTION(this << packet << enbAddr << teid);
 
+    auto linkIt = m_s1uDirectLinks.find(enbAddr);
+    if (linkIt != m_s1uDirectLinks.end())
+    {
+        linkIt->second->Send(packet, teid);
+        return;
+    }
+
     GtpuHeader gtpu;
     gtpu.SetTeid(teid);
     // From 3GPP TS 29.281 v10.0.0 Section 5.1
@@ -211,6 +292,12 @@ EpcSgwApplication::SendToS5uSocket(Ptr<Packet> packet, Ipv4Address pgwAddr, uint
 {
     NS_LOG_FUNCTION(this << packet << pgwAddr << teid);
 
+    if (m_s5uDirectLink)
+    {
+        m_s5uDirectLink->Send(packet, teid);
+        return;
+    }
+
     GtpuHeader gtpu;
     gtpu.SetTeid(teid);
     // From 3GPP TS 29.281 v10.0.0 Section 5.1
@@ -21,6 +21,7 @@
 #define EPC_SGW_APPLICATION_H
 
 #include "epc-gtpc-header.h"
+#include "epc-gtpu-direct-link.h"
 
 #include "ns3/address.h"
 #include "ns3/application.h"
@@ -61,9 +62,11 @@ class EpcSgwApplication : public Application
     /**
      * Constructor that binds callback methods of sockets.
      *
-     * \param s1uSocket socket used to send/receive GTP-U packets to/from the eNBs
+     * \param s1uSocket socket used to send/receive GTP-U packets to/from the eNBs,
+     * or null if it is set later
      * \param s5Addr IPv4 address of the S5 interface
-     * \param s5uSocket socket used to send/receive GTP-U packets to/from the PGW
+     * \param s5uSocket socket used to send/receive GTP-U packets to/from the PGW,
+     * or null if it is set later
      * \param s5cSocket socket used to send/receive GTP-C packets to/from the PGW
      */
     EpcSgwApplication(const Ptr<Socket> s1uSocket,
@@ -98,6 +101,63 @@ class EpcSgwApplication : public Application
      */
     void AddEnb(uint16_t cellId, Ipv4Address enbAddr, Ipv4Address sgwAddr);
 
+    /**
+     * Set the socket used to send/receive GTP-U packets to/from the eNBs,
+     * replacing the one given to the constructor
+     *
+     * \param s1uSocket the S1-U socket, or null if the packets are only
+     *        forwarded over direct links
+     */
+    void SetS1uSocket(Ptr<Socket> s1uSocket);
+
+    /**
+     * Set the socket used to send/receive GTP-U packets to/from the PGW,
+     * replacing the one given to the constructor
+     *
+     * \param s5uSocket the S5-U socket, or null if the packets are only
+     *        forwarded over direct links
+     */
+    void SetS5uSocket(Ptr<Socket> s5uSocket);
+
+    /**
+     * Forward the downlink user plane packets to an eNB over a direct link
+     * instead of the S1-U socket. The uplink direct link from the eNB is
+     * expected to be connected to RecvFromS1uDirectLink().
+     *
+     * \param enbAddr the S1-U address of the eNB
+     * \param link the direct link towards the eNB
+     */
+    void AddS1uDirectLink(Ipv4Address enbAddr, Ptr<EpcGtpuDirectLink> link);
+
+    /**
+     * Forward the uplink user plane packets to the PGW over a direct link
+     * instead of the S5-U socket. The downlink direct link from the PGW is
+     * expected to be connected to RecvFromS5uDirectLink().
+     *
+     * \param link the direct link towards the PGW
+     */
+    void SetS5uDirectLink(Ptr<EpcGtpuDirectLink> link);
+
+    /**
+     * Method to be assigned to the receive callback of the direct link from an eNB.
+     * It is called when the SGW receives a data packet from the eNB
+     * that is to be forwarded to the PGW.
+     *
+     * \param packet the packet, without GTP-U header
+     * \param teid the Tunnel Endpoint Identifier
+     */
+    void RecvFromS1uDirectLink(Ptr<Packet> packet, uint32_t teid);
+
+    /**
+     * Method to be assigned to the receive callback of the direct link from the PGW.
+     * It is called when the SGW receives a data packet from the PGW
+     * that is to be forwarded to an eNB.
+     *
+     * \param packet the packet, without GTP-U header
+     * \param teid the Tunnel Endpoint Identifier
+     */
+    void RecvFromS5uDirectLink(Ptr<Packet> packet, uint32_t teid);
+
   private:
     /**
      * Method to be assigned to the recv callback of the S11 socket.
@@ -232,6 +292,16 @@ class EpcSgwApplication : public Application
      */
     Ptr<Socket> m_s1uSocket;
 
+    /**
+     * Direct link used instead of the S5-U socket to send packets to the PGW, if any
+     */
+    Ptr<EpcGtpuDirectLink> m_s5uDirectLink;
+
+    /**
+     * Direct links used instead of the S1-U socket to send packets to the eNBs, by eNB address
+     */
+    std::map<Ipv4Address, Ptr<EpcGtpuDirectLink>> m_s1uDirectLinks;
+
     /**
      * UDP port to be used for GTP-U
      */
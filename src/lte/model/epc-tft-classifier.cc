@@ -39,6 +39,8 @@
 #include "ns3/udp-header.h"
 #include "ns3/udp-l4-protocol.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -49,14 +51,40 @@ EpcTftClassifier::EpcTftClassifier()
     NS_LOG_FUNCTION(this);
 }
 
+bool
+EpcTftClassifier::FilterKey::operator==(const FilterKey& other) const
+{
+    return remoteAddress == other.remoteAddress && localAddress == other.localAddress &&
+           remotePort == other.remotePort && localPort == other.localPort && tos == other.tos;
+}
+
+size_t
+EpcTftClassifier::FilterKeyHash::operator()(const FilterKey& key) const
+{
+    uint64_t addresses = (static_cast<uint64_t>(key.remoteAddress) << 32) | key.localAddress;
+    uint64_t others = (static_cast<uint64_t>(key.remotePort) << 24) |
+                      (static_cast<uint64_t>(key.localPort) << 8) | key.tos;
+    return std::hash<uint64_t>()(addresses ^ (others * 0x9e3779b97f4a7c15ULL));
+}
+
 void
 EpcTftClassifier::Add(Ptr<EpcTft> tft, uint32_t id)
 {
     NS_LOG_FUNCTION(this << tft << id);
+    bool replaced = m_tftMap.find(id) != m_tftMap.end();
     m_tftMap[id] = tft;
 
     // simple sanity check: there shouldn't be more than 16 bearers (hence TFTs) per UE
     NS_ASSERT(m_tftMap.size() <= 16);
+
+    if (replaced)
+    {
+        RebuildIndex();
+    }
+    else
+    {
+        IndexTft(tft, id);
+    }
 }
 
 void
@@ -64,6 +92,140 @@ EpcTftClassifier::Delete(uint32_t id)
 {
     NS_LOG_FUNCTION(this << id);
     m_tftMap.erase(id);
+    RebuildIndex();
+}
+
+void
+EpcTftClassifier::IndexTft(Ptr<EpcTft> tft, uint32_t id)
+{
+    NS_LOG_FUNCTION(this << tft << id);
+    for (const auto& filter : tft->GetPacketFilters())
+    {
+        bool remotePortAny = filter.remotePortStart == 0 && filter.remotePortEnd == 65535;
+        bool localPortAny = filter.localPortStart == 0 && filter.localPortEnd == 65535;
+        bool remotePortExact = filter.remotePortStart == filter.remotePortEnd;
+        bool localPortExact = filter.localPortStart == filter.localPortEnd;
+
+        if (!(remotePortAny || remotePortExact) || !(localPortAny || localPortExact))
+        {
+            // port ranges are evaluated one filter at a time
+            auto it = m_rangeFilters.begin();
+            while (it != m_rangeFilters.end() && it->first >= id)
+            {
+                ++it;
+            }
+            m_rangeFilters.insert(it, std::make_pair(id, filter));
+            continue;
+        }
+
+        uint32_t remoteMask = filter.remoteMask.Get();
+        uint32_t localMask = filter.localMask.Get();
+        auto group = m_filterGroups.begin();
+        for (; group != m_filterGroups.end(); ++group)
+        {
+            if (group->remoteMask == remoteMask && group->localMask == localMask &&
+                group->remotePortExact == remotePortExact &&
+                group->localPortExact == localPortExact &&
+                group->tosMask == filter.typeOfServiceMask)
+            {
+                break;
+            }
+        }
+        if (group == m_filterGroups.end())
+        {
+            FilterGroup newGroup;
+            newGroup.remoteMask = remoteMask;
+            newGroup.localMask = localMask;
+            newGroup.remotePortExact = remotePortExact;
+            newGroup.localPortExact = localPortExact;
+            newGroup.tosMask = filter.typeOfServiceMask;
+            newGroup.maxId = 0;
+            group = m_filterGroups.insert(m_filterGroups.end(), newGroup);
+        }
+
+        FilterKey key;
+        key.remoteAddress = filter.remoteAddress.Get() & remoteMask;
+        key.localAddress = filter.localAddress.Get() & localMask;
+        key.remotePort = remotePortExact ? filter.remotePortStart : 0;
+        key.localPort = localPortExact ? filter.localPortStart : 0;
+        key.tos = filter.typeOfService & filter.typeOfServiceMask;
+
+        auto entry = group->table.insert(std::make_pair(key, std::array<uint32_t, 2>{0, 0}));
+        std::array<uint32_t, 2>& ids = entry.first->second;
+        if (filter.direction & EpcTft::DOWNLINK)
+        {
+            ids[0] = std::max(ids[0], id);
+        }
+        if (filter.direction & EpcTft::UPLINK)
+        {
+            ids[1] = std::max(ids[1], id);
+        }
+        group->maxId = std::max(group->maxId, id);
+    }
+}
+
+void
+EpcTftClassifier::RebuildIndex()
+{
+    NS_LOG_FUNCTION(this);
+    m_filterGroups.clear();
+    m_rangeFilters.clear();
+    for (const auto& tft : m_tftMap)
+    {
+        IndexTft(tft.second, tft.first);
+    }
+}
+
+uint32_t
+EpcTftClassifier::ClassifyIpv4(EpcTft::Direction direction,
+                               Ipv4Address remoteAddress,
+                               Ipv4Address localAddress,
+                               uint16_t remotePort,
+                               uint16_t localPort,
+                               uint8_t tos)
+{
+    uint32_t dirIndex = (direction == EpcTft::UPLINK) ? 1 : 0;
+    uint32_t ra = remoteAddress.Get();
+    uint32_t la = localAddress.Get();
+    uint32_t bestId = 0;
+
+    for (const auto& group : m_filterGroups)
+    {
+        if (group.maxId <= bestId)
+        {
+            continue;
+        }
+        FilterKey key;
+        key.remoteAddress = ra & group.remoteMask;
+        key.localAddress = la & group.localMask;
+        key.remotePort = group.remotePortExact ? remotePort : 0;
+        key.localPort = group.localPortExact ? localPort : 0;
+        key.tos = tos & group.tosMask;
+        auto it = group.table.find(key);
+        if (it != group.table.end())
+        {
+            bestId = std::max(bestId, it->second[dirIndex]);
+        }
+    }
+
+    for (auto& rangeFilter : m_rangeFilters)
+    {
+        if (rangeFilter.first <= bestId)
+        {
+            break;
+        }
+        if (rangeFilter.second.Matches(direction,
+                                       remoteAddress,
+                                       localAddress,
+                                       remotePort,
+                                       localPort,
+                                       tos))
+        {
+            bestId = rangeFilter.first;
+            break;
+        }
+    }
+    return bestId;
 }
 
 uint32_t
@@ -268,27 +430,16 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
                     << (uint16_t)tos);
 
         // now it is possible to classify the packet!
-        // we use a reverse iterator since filter priority is not implemented properly.
-        // This way, since the default bearer is expected to be added first, it will be evaluated
-        // last.
-        std::map<uint32_t, Ptr<EpcTft>>::const_reverse_iterator it;
+        // filter priority is not implemented properly, the matching TFT with the
+        // highest id is selected. This way, since the default bearer is expected to be
+        // added first, it will be selected only if no other TFT matches.
         NS_LOG_LOGIC("TFT MAP size: " << m_tftMap.size());
-
-        for (it = m_tftMap.rbegin(); it != m_tftMap.rend(); ++it)
+        uint32_t id =
+            ClassifyIpv4(direction, remoteAddressIpv4, localAddressIpv4, remotePort, localPort, tos);
+        if (id != 0)
         {
-            NS_LOG_LOGIC("TFT id: " << it->first);
-            NS_LOG_LOGIC(" Ptr<EpcTft>: " << it->second);
-            Ptr<EpcTft> tft = it->second;
-            if (tft->Matches(direction,
-                             remoteAddressIpv4,
-                             localAddressIpv4,
-                             remotePort,
-                             localPort,
-                             tos))
-            {
-                NS_LOG_LOGIC("matches with TFT ID = " << it->first);
-                return it->first; // the id of the matching TFT
-            }
+            NS_LOG_LOGIC("matches with TFT ID = " << id);
+            return id; // the id of the matching TFT
         }
     }
     else if (protocolNumber == Ipv6L3Protocol::PROT_NUMBER)
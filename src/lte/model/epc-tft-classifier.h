@@ -25,7 +25,10 @@
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 
+#include <array>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -48,6 +51,14 @@ class Packet;
  *
  * When we cannot cache the port info, the TFT of the default bearer is used. This may happen
  * if there is reordering or losses of IP packets.
+ *
+ * IPv4 packets are classified with an index of the packet filters that is
+ * updated on Add and Delete. The filters whose ports are either a single
+ * value or the full range are grouped by their address masks, ToS mask and
+ * kind of port match, and each group is a hash table of the masked filter
+ * fields. A packet is looked up once per group, and only the filters with
+ * port ranges are evaluated one by one. As with the TFT walk, the TFT with
+ * the highest identifier among the matching ones is selected.
  */
 class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
 {
@@ -93,6 +104,82 @@ class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
                                    ///<   not first fragment or not enough payload data for TCP/UDP
                                    ///< An entry is removed when the last fragment is classified
                                    ///<   Note: If last fragment is lost, entry is not removed
+
+  private:
+    /// Fields of an IPv4 packet, masked according to a filter group
+    struct FilterKey
+    {
+        uint32_t remoteAddress; ///< masked remote address
+        uint32_t localAddress;  ///< masked local address
+        uint16_t remotePort;    ///< remote port, 0 if the group matches any port
+        uint16_t localPort;     ///< local port, 0 if the group matches any port
+        uint8_t tos;            ///< masked type of service
+
+        /**
+         * Equality operator
+         * \param other the key to compare with
+         * \return true if the keys are equal
+         */
+        bool operator==(const FilterKey& other) const;
+    };
+
+    /// Hash function for the filter keys
+    struct FilterKeyHash
+    {
+        /**
+         * \param key the filter key
+         * \return the hash of the key
+         */
+        size_t operator()(const FilterKey& key) const;
+    };
+
+    /// IPv4 packet filters sharing the same masks and kinds of port match
+    struct FilterGroup
+    {
+        uint32_t remoteMask;  ///< remote address mask
+        uint32_t localMask;   ///< local address mask
+        bool remotePortExact; ///< the filters match a single remote port
+        bool localPortExact;  ///< the filters match a single local port
+        uint8_t tosMask;      ///< type of service mask
+        uint32_t maxId;       ///< highest TFT id in the group
+        /// masked fields --> highest TFT id matching them, in downlink (0) and uplink (1)
+        std::unordered_map<FilterKey, std::array<uint32_t, 2>, FilterKeyHash> table;
+    };
+
+    /**
+     * Add the IPv4 packet filters of a TFT to the index
+     *
+     * \param tft the TFT
+     * \param id the ID of the bearer classified by the TFT
+     */
+    void IndexTft(Ptr<EpcTft> tft, uint32_t id);
+
+    /**
+     * Rebuild the IPv4 packet filter index from the TFT map
+     */
+    void RebuildIndex();
+
+    /**
+     * Classify an IPv4 packet using the packet filter index
+     *
+     * \param direction the EPC TFT direction (downlink or uplink)
+     * \param remoteAddress the remote address
+     * \param localAddress the local address
+     * \param remotePort the remote port
+     * \param localPort the local port
+     * \param tos the type of service
+     * \return the identifier of the matching TFT with the highest identifier; 0 if no TFT matched
+     */
+    uint32_t ClassifyIpv4(EpcTft::Direction direction,
+                          Ipv4Address remoteAddress,
+                          Ipv4Address localAddress,
+                          uint16_t remotePort,
+                          uint16_t localPort,
+                          uint8_t tos);
+
+    std::vector<FilterGroup> m_filterGroups; ///< IPv4 filters matched through hash tables
+    /// IPv4 filters with port ranges, sorted by decreasing TFT id
+    std::vector<std::pair<uint32_t, EpcTft::PacketFilter>> m_rangeFilters;
 };
 
 } // namespace ns3
@@ -27,6 +27,15 @@ LteAnrSapProvider::~LteAnrSapProvider()
 {
 }
 
+void
+LteAnrSapProvider::ReportUeMeasBatch(const std::vector<LteRrcSap::MeasResults>& measResults)
+{
+    for (const auto& report : measResults)
+    {
+        ReportUeMeas(report);
+    }
+}
+
 LteAnrSapUser::~LteAnrSapUser()
 {
 }
@@ -49,6 +49,17 @@ class LteAnrSapProvider
      */
     virtual void ReportUeMeas(LteRrcSap::MeasResults measResults) = 0;
 
+    /**
+     * \brief Send a batch of UE measurement reports to the ANC instance.
+     * \param measResults the reports, in the order in which they were received
+     *
+     * The default implementation calls ReportUeMeas for each report in turn.
+     * The ANR handles the batch natively, updating each reported neighbour cell
+     * once. It is used by the eNodeB RRC instance when the measurement reports
+     * are batched (see the LteEnbRrc::MeasReportBatching attribute).
+     */
+    virtual void ReportUeMeasBatch(const std::vector<LteRrcSap::MeasResults>& measResults);
+
     /**
      * \brief Add a new Neighbour Relation entry.
      * \param cellId the Physical Cell ID of the new neighbouring cell
@@ -135,6 +146,7 @@ class MemberLteAnrSapProvider : public LteAnrSapProvider
 
     // inherited from LteAnrSapProvider
     void ReportUeMeas(LteRrcSap::MeasResults measResults) override;
+    void ReportUeMeasBatch(const std::vector<LteRrcSap::MeasResults>& measResults) override;
     void AddNeighbourRelation(uint16_t cellId) override;
     bool GetNoRemove(uint16_t cellId) const override;
     bool GetNoHo(uint16_t cellId) const override;
@@ -158,6 +170,14 @@ MemberLteAnrSapProvider<C>::ReportUeMeas(LteRrcSap::MeasResults measResults)
     m_owner->DoReportUeMeas(measResults);
 }
 
+template <class C>
+void
+MemberLteAnrSapProvider<C>::ReportUeMeasBatch(
+    const std::vector<LteRrcSap::MeasResults>& measResults)
+{
+    m_owner->DoReportUeMeasBatch(measResults);
+}
+
 template <class C>
 void
 MemberLteAnrSapProvider<C>::AddNeighbourRelation(uint16_t cellId)
@@ -29,6 +29,8 @@
 #include <ns3/log.h>
 #include <ns3/uinteger.h>
 
+#include <set>
+
 namespace ns3
 {
 
@@ -164,51 +166,89 @@ LteAnr::DoReportUeMeas(LteRrcSap::MeasResults measResults)
                 // Keep new RSRQ value reported for the neighbour cell
                 NS_ASSERT_MSG(it->haveRsrqResult == true,
                               "RSRQ measure missing for cellId " << it->physCellId);
+                UpdateNeighbourRelation(it->physCellId);
+            }
+        }
+        else
+        {
+            NS_LOG_WARN(
+                this << " Event A4 received without measurement results from neighbouring cells");
+            /// \todo Remove neighbours in the NRT.
+        }
+    }
 
-                // Update Neighbour Relation Table
-                auto itNrt = m_neighbourRelationTable.find(it->physCellId);
-                if (itNrt != m_neighbourRelationTable.end())
-                {
-                    // Update neighbour relation entry
-                    NS_LOG_LOGIC(this << " updating NRT of cell " << m_servingCellId
-                                      << " with entry of cell " << it->physCellId);
-                    if (!itNrt->second.noX2)
-                    {
-                        NS_LOG_LOGIC(this << " enabling handover"
-                                          << " from cell " << m_servingCellId << " to cell "
-                                          << it->physCellId);
-                        itNrt->second.noHo = false;
-                    }
-                    itNrt->second.detectedAsNeighbour = true;
-                }
-                else
-                {
-                    // Discovered new neighbour
-                    NS_LOG_LOGIC(this << " inserting NRT of cell " << m_servingCellId
-                                      << " with newly discovered neighbouring cell "
-                                      << it->physCellId);
-                    NeighbourRelation_t neighbourRelation;
-                    neighbourRelation.noRemove = false;
-                    neighbourRelation.noHo = true;
-                    neighbourRelation.noX2 = true;
-                    neighbourRelation.detectedAsNeighbour = true;
-                    m_neighbourRelationTable[it->physCellId] = neighbourRelation;
-                }
-
-            } // end of for (it = measResults.measResultListEutra.begin ())
-
-        } // end of if (measResults.haveMeasResultNeighCells &&
-          // !(measResults.measResultListEutra.empty ()))
+} // end of DoReportUeMeas
+
+void
+LteAnr::DoReportUeMeasBatch(const std::vector<LteRrcSap::MeasResults>& measResults)
+{
+    NS_LOG_FUNCTION(this << m_servingCellId << measResults.size());
+
+    // the cells reported in the batch, each of which is looked up once in the NRT
+    std::set<uint16_t> reportedCellIds;
+
+    for (const auto& report : measResults)
+    {
+        if (report.measId != m_measId)
+        {
+            NS_LOG_WARN(this << " Skipping unexpected measurement identity "
+                             << (uint16_t)report.measId);
+        }
+        else if (report.haveMeasResultNeighCells && !(report.measResultListEutra.empty()))
+        {
+            for (const auto& measResult : report.measResultListEutra)
+            {
+                NS_ASSERT_MSG(measResult.haveRsrqResult == true,
+                              "RSRQ measure missing for cellId " << measResult.physCellId);
+                reportedCellIds.insert(measResult.physCellId);
+            }
+        }
         else
         {
             NS_LOG_WARN(
                 this << " Event A4 received without measurement results from neighbouring cells");
             /// \todo Remove neighbours in the NRT.
         }
+    }
 
-    } // end of else of if (measId != m_measId)
+    for (uint16_t cellId : reportedCellIds)
+    {
+        UpdateNeighbourRelation(cellId);
+    }
 
-} // end of DoReportUeMeas
+} // end of DoReportUeMeasBatch
+
+void
+LteAnr::UpdateNeighbourRelation(uint16_t cellId)
+{
+    // Update Neighbour Relation Table
+    auto itNrt = m_neighbourRelationTable.find(cellId);
+    if (itNrt != m_neighbourRelationTable.end())
+    {
+        // Update neighbour relation entry
+        NS_LOG_LOGIC(this << " updating NRT of cell " << m_servingCellId << " with entry of cell "
+                          << cellId);
+        if (!itNrt->second.noX2)
+        {
+            NS_LOG_LOGIC(this << " enabling handover"
+                              << " from cell " << m_servingCellId << " to cell " << cellId);
+            itNrt->second.noHo = false;
+        }
+        itNrt->second.detectedAsNeighbour = true;
+    }
+    else
+    {
+        // Discovered new neighbour
+        NS_LOG_LOGIC(this << " inserting NRT of cell " << m_servingCellId
+                          << " with newly discovered neighbouring cell " << cellId);
+        NeighbourRelation_t neighbourRelation;
+        neighbourRelation.noRemove = false;
+        neighbourRelation.noHo = true;
+        neighbourRelation.noX2 = true;
+        neighbourRelation.detectedAsNeighbour = true;
+        m_neighbourRelationTable[cellId] = neighbourRelation;
+    }
+}
 
 void
 LteAnr::DoAddNeighbourRelation(uint16_t cellId)
@@ -153,6 +153,22 @@ class LteAnr : public Object
      */
     void DoReportUeMeas(LteRrcSap::MeasResults measResults);
 
+    /**
+     * \brief Implementation of LteAnrSapProvider::ReportUeMeasBatch.
+     * \param measResults the reports, in the order in which they were received
+     *
+     * Each cell reported in the batch is looked up once in the Neighbour
+     * Relation Table, whatever the number of reports it appears in.
+     */
+    void DoReportUeMeasBatch(const std::vector<LteRrcSap::MeasResults>& measResults);
+
+    /**
+     * \brief Update the entry of a reported cell in the Neighbour Relation
+     *        Table, inserting it if the cell is newly discovered.
+     * \param cellId the cell ID of the reported neighbour cell
+     */
+    void UpdateNeighbourRelation(uint16_t cellId);
+
     /**
      * \brief Implementation of LteAnrSapProvider::AddNeighbourRelation.
      * \param cellId the Physical Cell ID of the new neighbouring cell
@@ -1363,7 +1363,14 @@ UeManager::RecvMeasurementReport(LteRrcSap::MeasurementReport msg)
         (m_rrc->m_handoverMeasIds.find(measId) != m_rrc->m_handoverMeasIds.end()))
     {
         // this measurement was requested by the handover algorithm
-        m_rrc->m_handoverManagementSapProvider->ReportUeMeas(m_rnti, msg.measResults);
+        if (m_rrc->m_measReportBatching)
+        {
+            m_rrc->m_handoverMeasReportBatch.push_back({m_rnti, msg.measResults});
+        }
+        else
+        {
+            m_rrc->m_handoverManagementSapProvider->ReportUeMeas(m_rnti, msg.measResults);
+        }
     }
 
     if ((m_rrc->m_ccmRrcSapProvider != nullptr) &&
@@ -1377,7 +1384,14 @@ UeManager::RecvMeasurementReport(LteRrcSap::MeasurementReport msg)
         (m_rrc->m_anrMeasIds.find(measId) != m_rrc->m_anrMeasIds.end()))
     {
         // this measurement was requested by the ANR function
-        m_rrc->m_anrSapProvider->ReportUeMeas(msg.measResults);
+        if (m_rrc->m_measReportBatching)
+        {
+            m_rrc->m_anrMeasReportBatch.push_back(msg.measResults);
+        }
+        else
+        {
+            m_rrc->m_anrSapProvider->ReportUeMeas(msg.measResults);
+        }
     }
 
     if ((!m_rrc->m_ffrRrcSapProvider.empty()) &&
@@ -1850,6 +1864,7 @@ LteEnbRrc::LteEnbRrc()
       m_cphySapProvider(0),
       m_configured(false),
       m_lastAllocatedRnti(0),
+      m_measReportBatching(false),
       m_srsCurrentPeriodicityId(0),
       m_lastAllocatedConfigurationIndex(0),
       m_reconfigureUes(false),
@@ -1912,6 +1927,9 @@ LteEnbRrc::DoDispose()
     m_ffrRrcSapUser.erase(m_ffrRrcSapUser.begin(), m_ffrRrcSapUser.end());
     m_ffrRrcSapUser.clear();
     m_ueMap.clear();
+    m_measReportBatchEvent.Cancel();
+    m_measReportBatch.clear();
+    m_measReportBatchIndex.clear();
     delete m_handoverManagementSapUser;
     delete m_ccmRrcSapUser;
     delete m_anrSapUser;
@@ -2055,6 +2073,16 @@ LteEnbRrc::GetTypeId()
                           UintegerValue(4),
                           MakeUintegerAccessor(&LteEnbRrc::m_rsrqFilterCoefficient),
                           MakeUintegerChecker<uint8_t>(0))
+            .AddAttribute("MeasReportBatching",
+                          "If true, the measurement reports received in the same time step "
+                          "(e.g., all the reports of a TTI with the ideal RRC protocol) are "
+                          "processed together at the end of the time step: only the latest "
+                          "report of each UE for each measurement identity is kept, and the "
+                          "reports for the handover algorithm and for the ANR are delivered "
+                          "in one call each",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&LteEnbRrc::m_measReportBatching),
+                          MakeBooleanChecker())
 
             // Trace sources
             .AddTraceSource("NewUeContext",
@@ -2778,7 +2806,68 @@ void
 LteEnbRrc::DoRecvMeasurementReport(uint16_t rnti, LteRrcSap::MeasurementReport msg)
 {
     NS_LOG_FUNCTION(this << rnti);
-    GetUeManager(rnti)->RecvMeasurementReport(msg);
+    if (!m_measReportBatching)
+    {
+        GetUeManager(rnti)->RecvMeasurementReport(msg);
+        return;
+    }
+
+    NS_ASSERT_MSG(HasUeManager(rnti), "RNTI " << rnti << " not found in eNB");
+    auto key = std::make_pair(rnti, msg.measResults.measId);
+    auto ret = m_measReportBatchIndex.insert(std::make_pair(key, m_measReportBatch.size()));
+    if (ret.second)
+    {
+        m_measReportBatch.emplace_back(rnti, msg);
+    }
+    else
+    {
+        // a more recent report supersedes the queued one
+        NS_LOG_LOGIC("replacing report of RNTI " << rnti << " for measId "
+                                                 << (uint16_t)msg.measResults.measId);
+        m_measReportBatch[ret.first->second].second = msg;
+    }
+
+    if (!m_measReportBatchEvent.IsRunning())
+    {
+        m_measReportBatchEvent =
+            Simulator::ScheduleNow(&LteEnbRrc::ProcessMeasurementReportBatch, this);
+    }
+}
+
+void
+LteEnbRrc::ProcessMeasurementReportBatch()
+{
+    NS_LOG_FUNCTION(this << m_measReportBatch.size());
+    std::vector<std::pair<uint16_t, LteRrcSap::MeasurementReport>> batch;
+    batch.swap(m_measReportBatch);
+    m_measReportBatchIndex.clear();
+
+    for (const auto& report : batch)
+    {
+        // the UE context may have been removed since the report was received
+        auto it = m_ueMap.find(report.first);
+        if (it == m_ueMap.end())
+        {
+            NS_LOG_WARN("UE context of RNTI " << report.first
+                                              << " not found, discarding measurement report");
+            continue;
+        }
+        it->second->RecvMeasurementReport(report.second);
+    }
+
+    if (!m_handoverMeasReportBatch.empty())
+    {
+        std::vector<LteHandoverManagementSapProvider::UeMeasReport> handoverReports;
+        handoverReports.swap(m_handoverMeasReportBatch);
+        m_handoverManagementSapProvider->ReportUeMeasBatch(handoverReports);
+    }
+
+    if (!m_anrMeasReportBatch.empty())
+    {
+        std::vector<LteRrcSap::MeasResults> anrReports;
+        anrReports.swap(m_anrMeasReportBatch);
+        m_anrSapProvider->ReportUeMeasBatch(anrReports);
+    }
 }
 
 void
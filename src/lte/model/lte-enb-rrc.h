@@ -1211,6 +1211,12 @@ class LteEnbRrc : public Object
      * \param msg the LteRrcSap::MeasurementReport
      */
     void DoRecvMeasurementReport(uint16_t rnti, LteRrcSap::MeasurementReport msg);
+    /**
+     * Process the measurement reports queued by DoRecvMeasurementReport when
+     * the `MeasReportBatching` attribute is enabled, then deliver the reports
+     * intended for the handover algorithm and for the ANR in one call each.
+     */
+    void ProcessMeasurementReportBatch();
     /**
      * \brief Part of the RRC protocol. Forwarding
      * LteEnbRrcSapProvider::RecvIdealUeContextRemoveRequest interface to
@@ -1613,6 +1619,22 @@ class LteEnbRrc : public Object
     /// List of measurement identities which are intended for component carrier management purposes.
     std::set<uint8_t> m_componentCarrierMeasIds;
 
+    /**
+     * The `MeasReportBatching` attribute. Whether the measurement reports
+     * received in the same time step are processed together.
+     */
+    bool m_measReportBatching;
+    /// Measurement reports waiting to be processed, in order of arrival.
+    std::vector<std::pair<uint16_t, LteRrcSap::MeasurementReport>> m_measReportBatch;
+    /// Position in m_measReportBatch of the report of each RNTI and measurement identity.
+    std::map<std::pair<uint16_t, uint8_t>, std::size_t> m_measReportBatchIndex;
+    /// Event processing the measurement reports waiting in m_measReportBatch.
+    EventId m_measReportBatchEvent;
+    /// Reports for the handover algorithm, collected while processing a batch.
+    std::vector<LteHandoverManagementSapProvider::UeMeasReport> m_handoverMeasReportBatch;
+    /// Reports for the ANR, collected while processing a batch.
+    std::vector<LteRrcSap::MeasResults> m_anrMeasReportBatch;
+
     /// X2uTeidInfo structure
     struct X2uTeidInfo
     {
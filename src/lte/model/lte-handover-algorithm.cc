@@ -49,4 +49,15 @@ LteHandoverAlgorithm::DoDispose()
 {
 }
 
+void
+LteHandoverAlgorithm::DoReportUeMeasBatch(
+    const std::vector<LteHandoverManagementSapProvider::UeMeasReport>& reports)
+{
+    NS_LOG_FUNCTION(this << reports.size());
+    for (const auto& report : reports)
+    {
+        DoReportUeMeas(report.rnti, report.measResults);
+    }
+}
+
 } // end of namespace ns3
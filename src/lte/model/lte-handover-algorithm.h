@@ -21,16 +21,16 @@
 #ifndef LTE_HANDOVER_ALGORITHM_H
 #define LTE_HANDOVER_ALGORITHM_H
 
+#include "lte-handover-management-sap.h"
 #include "lte-rrc-sap.h"
 
 #include <ns3/object.h>
 
+#include <vector>
+
 namespace ns3
 {
 
-class LteHandoverManagementSapUser;
-class LteHandoverManagementSapProvider;
-
 /**
  * \brief The abstract base class of a handover algorithm that operates using
  *        the Handover Management SAP interface.
@@ -103,6 +103,15 @@ class LteHandoverAlgorithm : public Object
      */
     virtual void DoReportUeMeas(uint16_t rnti, LteRrcSap::MeasResults measResults) = 0;
 
+    /**
+     * \brief Implementation of LteHandoverManagementSapProvider::ReportUeMeasBatch.
+     * \param reports the reports, in the order in which they were received
+     *
+     * The default implementation calls DoReportUeMeas for each report in turn.
+     */
+    virtual void DoReportUeMeasBatch(
+        const std::vector<LteHandoverManagementSapProvider::UeMeasReport>& reports);
+
 }; // end of class LteHandoverAlgorithm
 
 } // end of namespace ns3
@@ -27,6 +27,15 @@ LteHandoverManagementSapProvider::~LteHandoverManagementSapProvider()
 {
 }
 
+void
+LteHandoverManagementSapProvider::ReportUeMeasBatch(const std::vector<UeMeasReport>& reports)
+{
+    for (const auto& report : reports)
+    {
+        ReportUeMeas(report.rnti, report.measResults);
+    }
+}
+
 LteHandoverManagementSapUser::~LteHandoverManagementSapUser()
 {
 }
@@ -52,6 +52,25 @@ class LteHandoverManagementSapProvider
      */
     virtual void ReportUeMeas(uint16_t rnti, LteRrcSap::MeasResults measResults) = 0;
 
+    /// A UE measurement report, as delivered by ReportUeMeasBatch
+    struct UeMeasReport
+    {
+        uint16_t rnti;                      ///< RNTI of the UE where the report originates from
+        LteRrcSap::MeasResults measResults; ///< a single report of one measurement identity
+    };
+
+    /**
+     * \brief Send a batch of UE measurement reports to handover algorithm.
+     * \param reports the reports, in the order in which they were received
+     *
+     * The default implementation calls ReportUeMeas for each report in turn.
+     * A handover algorithm may instead handle the batch natively, e.g., by
+     * making a single handover decision per UE. It is used by the eNodeB RRC
+     * instance when the measurement reports are batched (see the
+     * LteEnbRrc::MeasReportBatching attribute).
+     */
+    virtual void ReportUeMeasBatch(const std::vector<UeMeasReport>& reports);
+
 }; // end of class LteHandoverManagementSapProvider
 
 /**
@@ -123,6 +142,7 @@ class MemberLteHandoverManagementSapProvider : public LteHandoverManagementSapPr
 
     // inherited from LteHandoverManagementSapProvider
     void ReportUeMeas(uint16_t rnti, LteRrcSap::MeasResults measResults) override;
+    void ReportUeMeasBatch(const std::vector<UeMeasReport>& reports) override;
 
   private:
     C* m_owner; ///< the owner class
@@ -143,6 +163,14 @@ MemberLteHandoverManagementSapProvider<C>::ReportUeMeas(uint16_t rnti,
     m_owner->DoReportUeMeas(rnti, measResults);
 }
 
+template <class C>
+void
+MemberLteHandoverManagementSapProvider<C>::ReportUeMeasBatch(
+    const std::vector<UeMeasReport>& reports)
+{
+    m_owner->DoReportUeMeasBatch(reports);
+}
+
 /**
  * \brief Template for the implementation of the LteHandoverManagementSapUser
  *        as a member of an owner class of type C to which all methods are
@@ -32,14 +32,17 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4.h"
 #include "ns3/log.h"
 #include "ns3/packet-sink-helper.h"
 #include "ns3/packet-sink.h"
 #include "ns3/point-to-point-epc-helper.h"
 #include "ns3/point-to-point-helper.h"
+#include "ns3/point-to-point-net-device.h"
 #include "ns3/seq-ts-header.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 #include <ns3/ipv4-interface.h>
 #include <ns3/ipv4-static-routing-helper.h>
@@ -305,18 +308,32 @@ class EpcS1uUlTestCase : public TestCase
      *
      * \param name the reference name
      * \param v the list of UE lists
+     * \param direct whether the S1-U and S5-U user plane is forwarded over direct links
      */
-    EpcS1uUlTestCase(std::string name, std::vector<EnbUlTestData> v);
+    EpcS1uUlTestCase(std::string name, std::vector<EnbUlTestData> v, bool direct = false);
     ~EpcS1uUlTestCase() override;
 
   private:
     void DoRun() override;
+
+    /**
+     * Check that the eNBs have an S1-U point-to-point link, and that the
+     * eNBs, the SGW and the PGW have GTP-U sockets, unless the user plane
+     * packets are forwarded over direct links.
+     *
+     * \param epcHelper the EPC helper
+     * \param enbs the eNB nodes
+     */
+    void CheckS1uS5u(Ptr<PointToPointEpcHelper> epcHelper, NodeContainer enbs);
+
     std::vector<EnbUlTestData> m_enbUlTestData; ///< ENB UL test data
+    bool m_direct;                              ///< whether the S1-U and S5-U links are direct
 };
 
-EpcS1uUlTestCase::EpcS1uUlTestCase(std::string name, std::vector<EnbUlTestData> v)
+EpcS1uUlTestCase::EpcS1uUlTestCase(std::string name, std::vector<EnbUlTestData> v, bool direct)
     : TestCase(name),
-      m_enbUlTestData(v)
+      m_enbUlTestData(v),
+      m_direct(direct)
 {
 }
 
@@ -324,10 +341,63 @@ EpcS1uUlTestCase::~EpcS1uUlTestCase()
 {
 }
 
+void
+EpcS1uUlTestCase::CheckS1uS5u(Ptr<PointToPointEpcHelper> epcHelper, NodeContainer enbs)
+{
+    // the SGW has an S5 and an S11 link, plus an S1-U link per eNB when the
+    // packets are tunneled
+    uint32_t s1uLinks = m_direct ? 0 : 1;
+    uint32_t sgwLinks = 0;
+    Ptr<Node> sgw = epcHelper->GetSgwNode();
+    for (uint32_t i = 0; i < sgw->GetNDevices(); ++i)
+    {
+        sgwLinks += DynamicCast<PointToPointNetDevice>(sgw->GetDevice(i)) ? 1 : 0;
+    }
+    NS_TEST_EXPECT_MSG_EQ(sgwLinks, 2 + s1uLinks * enbs.GetN(), "wrong SGW links");
+
+    for (auto it = enbs.Begin(); it != enbs.End(); ++it)
+    {
+        uint32_t enbLinks = 0;
+        for (uint32_t i = 0; i < (*it)->GetNDevices(); ++i)
+        {
+            enbLinks += DynamicCast<PointToPointNetDevice>((*it)->GetDevice(i)) ? 1 : 0;
+        }
+        NS_TEST_EXPECT_MSG_EQ(enbLinks, s1uLinks, "wrong eNB links");
+    }
+
+    // the GTP-U port is free when no GTP-U socket is bound to it, neither
+    // to the wildcard address nor to one of the addresses of the node
+    NodeContainer gtpuNodes(epcHelper->GetSgwNode(), epcHelper->GetPgwNode());
+    gtpuNodes.Add(enbs);
+    for (auto it = gtpuNodes.Begin(); it != gtpuNodes.End(); ++it)
+    {
+        Ptr<Ipv4> ipv4 = (*it)->GetObject<Ipv4>();
+        std::vector<Ipv4Address> addresses{Ipv4Address::GetAny()};
+        for (uint32_t i = 0; i < ipv4->GetNInterfaces(); ++i)
+        {
+            for (uint32_t j = 0; j < ipv4->GetNAddresses(i); ++j)
+            {
+                addresses.push_back(ipv4->GetAddress(i, j).GetLocal());
+            }
+        }
+        bool gtpuPortFree = true;
+        for (const auto& address : addresses)
+        {
+            Ptr<Socket> socket = Socket::CreateSocket(*it, UdpSocketFactory::GetTypeId());
+            gtpuPortFree = gtpuPortFree && socket->Bind(InetSocketAddress(address, 2152)) == 0;
+            socket->Close();
+        }
+        NS_TEST_EXPECT_MSG_EQ(gtpuPortFree,
+                              m_direct,
+                              "wrong GTP-U sockets in node " << (*it)->GetId());
+    }
+}
+
 void
 EpcS1uUlTestCase::DoRun()
 {
     Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper>();
+    epcHelper->SetAttribute("S1uS5uDirect", BooleanValue(m_direct));
     Ptr<Node> pgw = epcHelper->GetPgwNode();
 
     // allow jumbo packets
@@ -484,6 +554,8 @@ EpcS1uUlTestCase::DoRun()
 
     Simulator::Run();
 
+    CheckS1uS5u(epcHelper, enbs);
+
     for (auto enbit = m_enbUlTestData.begin(); enbit < m_enbUlTestData.end(); ++enbit)
     {
         for (auto ueit = enbit->ues.begin(); ueit < enbit->ues.end(); ++ueit)
@@ -571,4 +643,9 @@ EpcS1uUlTestSuite::EpcS1uUlTestSuite()
     e8.ues.push_back(f8);
     v8.push_back(e8);
     AddTestCase(new EpcS1uUlTestCase("1 eNB, 100 pkts 15000 bytes each", v8), TestCase::QUICK);
+
+    AddTestCase(new EpcS1uUlTestCase("3 eNBs, direct S1-U and S5-U", v4, true), TestCase::QUICK);
+    AddTestCase(
+        new EpcS1uUlTestCase("1 eNB, 100 pkts 15000 bytes each, direct S1-U and S5-U", v8, true),
+        TestCase::QUICK);
 }
@@ -0,0 +1,183 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/lte-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/pointer.h"
+#include "ns3/radio-environment-map-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <fstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("LteTestRadioEnvironmentMap");
+
+/**
+ * \ingroup lte-test
+ *
+ * \brief Test case that checks that the REM computed directly from the link
+ * budgets of the eNBs matches the REM measured by the RemSpectrumPhy objects
+ * during the simulation.
+ */
+class LteRadioEnvironmentMapTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param processes the number of processes computing the direct REM
+     */
+    LteRadioEnvironmentMapTestCase(uint32_t processes);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \param remHelper the REM helper
+     * \param fileName the output file of the REM
+     * \param direct whether the REM is computed directly
+     */
+    void ConfigureRem(Ptr<RadioEnvironmentMapHelper> remHelper,
+                      std::string fileName,
+                      bool direct);
+
+    uint32_t m_processes; ///< the number of processes computing the direct REM
+};
+
+LteRadioEnvironmentMapTestCase::LteRadioEnvironmentMapTestCase(uint32_t processes)
+    : TestCase("Direct REM with " + std::to_string(processes) + " processes"),
+      m_processes(processes)
+{
+}
+
+void
+LteRadioEnvironmentMapTestCase::ConfigureRem(Ptr<RadioEnvironmentMapHelper> remHelper,
+                                             std::string fileName,
+                                             bool direct)
+{
+    remHelper->SetAttribute("OutputFile", StringValue(fileName));
+    remHelper->SetAttribute("XMin", DoubleValue(-200.0));
+    remHelper->SetAttribute("XMax", DoubleValue(700.0));
+    remHelper->SetAttribute("XRes", UintegerValue(7));
+    remHelper->SetAttribute("YMin", DoubleValue(-300.0));
+    remHelper->SetAttribute("YMax", DoubleValue(300.0));
+    remHelper->SetAttribute("YRes", UintegerValue(5));
+    remHelper->SetAttribute("Z", DoubleValue(1.5));
+    remHelper->SetAttribute("StopWhenDone", BooleanValue(false));
+    remHelper->SetAttribute("Direct", BooleanValue(direct));
+    remHelper->SetAttribute("Processes", UintegerValue(m_processes));
+    remHelper->SetAttribute("TileSize", UintegerValue(3));
+    remHelper->Install();
+}
+
+void
+LteRadioEnvironmentMapTestCase::DoRun()
+{
+    Ptr<LteHelper> lteHelper = CreateObject<LteHelper>();
+    lteHelper->SetEnbAntennaModelType("ns3::CosineAntennaModel");
+    lteHelper->SetEnbAntennaModelAttribute("Orientation", DoubleValue(30));
+
+    NodeContainer enbNodes;
+    enbNodes.Create(2);
+    NodeContainer ueNodes;
+    ueNodes.Create(1);
+    Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 30.0));
+    positionAlloc->Add(Vector(500.0, 0.0, 30.0));
+    positionAlloc->Add(Vector(100.0, 0.0, 1.5));
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.Install(enbNodes);
+    mobility.Install(ueNodes);
+
+    NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice(enbNodes);
+    NetDeviceContainer ueDevs = lteHelper->InstallUeDevice(ueNodes);
+    lteHelper->Attach(ueDevs, enbDevs.Get(0));
+
+    std::string measuredFileName = CreateTempDirFilename("rem-measured.out");
+    std::string directFileName = CreateTempDirFilename("rem-direct.out");
+    Ptr<RadioEnvironmentMapHelper> measuredRem = CreateObject<RadioEnvironmentMapHelper>();
+    measuredRem->SetAttribute("Channel", PointerValue(lteHelper->GetDownlinkSpectrumChannel()));
+    ConfigureRem(measuredRem, measuredFileName, false);
+    Ptr<RadioEnvironmentMapHelper> directRem = CreateObject<RadioEnvironmentMapHelper>();
+    directRem->SetAttribute("Channel", PointerValue(lteHelper->GetDownlinkSpectrumChannel()));
+    ConfigureRem(directRem, directFileName, true);
+
+    Simulator::Stop(Seconds(0.02));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    std::ifstream measured(measuredFileName);
+    std::ifstream direct(directFileName);
+    uint32_t points = 0;
+    double x;
+    double y;
+    double z;
+    double sinr;
+    while (measured >> x >> y >> z >> sinr)
+    {
+        double directX;
+        double directY;
+        double directZ;
+        double directSinr;
+        NS_TEST_ASSERT_MSG_EQ(bool(direct >> directX >> directY >> directZ >> directSinr),
+                              true,
+                              "The direct REM has less points");
+        NS_TEST_EXPECT_MSG_EQ(directX, x, "Wrong x coordinate");
+        NS_TEST_EXPECT_MSG_EQ(directY, y, "Wrong y coordinate");
+        NS_TEST_EXPECT_MSG_EQ(directZ, z, "Wrong z coordinate");
+        NS_TEST_EXPECT_MSG_EQ_TOL(directSinr,
+                                  sinr,
+                                  sinr * 1e-5,
+                                  "Wrong SINR at " << x << " " << y);
+        ++points;
+    }
+    NS_TEST_EXPECT_MSG_EQ(points, 35, "Wrong number of points");
+    NS_TEST_EXPECT_MSG_EQ(bool(direct >> x), false, "The direct REM has more points");
+}
+
+/**
+ * \ingroup lte-test
+ *
+ * \brief Test suite for the direct computation of the REM.
+ */
+class LteRadioEnvironmentMapTestSuite : public TestSuite
+{
+  public:
+    LteRadioEnvironmentMapTestSuite();
+};
+
+LteRadioEnvironmentMapTestSuite::LteRadioEnvironmentMapTestSuite()
+    : TestSuite("lte-radio-environment-map", SYSTEM)
+{
+    AddTestCase(new LteRadioEnvironmentMapTestCase(1), TestCase::QUICK);
+    AddTestCase(new LteRadioEnvironmentMapTestCase(2), TestCase::QUICK);
+}
+
+/**
+ * \ingroup lte-test
+ * Static variable for test initialization
+ */
+static LteRadioEnvironmentMapTestSuite g_lteRadioEnvironmentMapTestSuite;
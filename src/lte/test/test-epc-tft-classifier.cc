@@ -32,6 +32,7 @@
 #include "ns3/udp-l4-protocol.h"
 
 #include <iomanip>
+#include <map>
 
 using namespace ns3;
 
@@ -203,6 +204,199 @@ EpcTftClassifierTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(obtainedTftId, (uint16_t)m_tftId, "bad classification of UDP packet");
 }
 
+/**
+ * \ingroup lte-test
+ *
+ * \brief Test case to check that the packet filter index of the Tft Classifier
+ * selects the same TFT as a walk over all the TFTs, with many TFTs mixing
+ * exact, masked and ranged packet filters, and after TFTs are deleted.
+ */
+class EpcTftClassifierIndexTestCase : public TestCase
+{
+  public:
+    EpcTftClassifierIndexTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the classification of UDP packets over a grid of addresses and ports
+     *
+     * \param c the EPC TFT classifier
+     * \param tfts the TFTs added to the classifier
+     */
+    void CheckClassification(Ptr<EpcTftClassifier> c,
+                             const std::map<uint32_t, Ptr<EpcTft>>& tfts);
+};
+
+EpcTftClassifierIndexTestCase::EpcTftClassifierIndexTestCase()
+    : TestCase("Packet filter index selects the same TFT as the TFT walk")
+{
+}
+
+void
+EpcTftClassifierIndexTestCase::CheckClassification(Ptr<EpcTftClassifier> c,
+                                                   const std::map<uint32_t, Ptr<EpcTft>>& tfts)
+{
+    std::vector<std::string> ueAddresses = {"7.0.0.2", "7.0.0.3", "7.0.1.2"};
+    std::vector<std::string> remoteAddresses = {"1.0.0.2", "1.0.0.3", "2.0.0.2"};
+    std::vector<uint16_t> ports = {9, 1000, 1001, 2000, 2005, 2010, 3000, 5000};
+    std::vector<uint8_t> toses = {0, 0xb8};
+
+    for (EpcTft::Direction d : {EpcTft::DOWNLINK, EpcTft::UPLINK})
+    {
+        for (const auto& ue : ueAddresses)
+        {
+            for (const auto& remote : remoteAddresses)
+            {
+                for (uint16_t remotePort : ports)
+                {
+                    for (uint16_t localPort : ports)
+                    {
+                        for (uint8_t tos : toses)
+                        {
+                            uint32_t expectedId = 0;
+                            for (auto it = tfts.rbegin(); it != tfts.rend(); ++it)
+                            {
+                                if (it->second->Matches(d,
+                                                        Ipv4Address(remote.c_str()),
+                                                        Ipv4Address(ue.c_str()),
+                                                        remotePort,
+                                                        localPort,
+                                                        tos))
+                                {
+                                    expectedId = it->first;
+                                    break;
+                                }
+                            }
+
+                            Ipv4Header ipHeader;
+                            UdpHeader udpHeader;
+                            ipHeader.SetSource(
+                                Ipv4Address((d == EpcTft::UPLINK ? ue : remote).c_str()));
+                            ipHeader.SetDestination(
+                                Ipv4Address((d == EpcTft::UPLINK ? remote : ue).c_str()));
+                            ipHeader.SetTos(tos);
+                            ipHeader.SetPayloadSize(8);
+                            ipHeader.SetProtocol(UdpL4Protocol::PROT_NUMBER);
+                            udpHeader.SetSourcePort(d == EpcTft::UPLINK ? localPort : remotePort);
+                            udpHeader.SetDestinationPort(d == EpcTft::UPLINK ? remotePort
+                                                                             : localPort);
+                            Ptr<Packet> packet = Create<Packet>();
+                            packet->AddHeader(udpHeader);
+                            packet->AddHeader(ipHeader);
+
+                            uint32_t obtainedId =
+                                c->Classify(packet, d, Ipv4L3Protocol::PROT_NUMBER);
+                            NS_TEST_ASSERT_MSG_EQ(obtainedId,
+                                                  expectedId,
+                                                  "bad classification: d="
+                                                      << d << " ue=" << ue << " remote=" << remote
+                                                      << " rp=" << remotePort
+                                                      << " lp=" << localPort << " tos=0x"
+                                                      << std::hex << (uint16_t)tos);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+EpcTftClassifierIndexTestCase::DoRun()
+{
+    Ptr<EpcTftClassifier> c = Create<EpcTftClassifier>();
+    std::map<uint32_t, Ptr<EpcTft>> tfts;
+
+    // default bearer
+    tfts[1] = EpcTft::Default();
+
+    // fully specified 5-tuples
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        Ptr<EpcTft> tft = Create<EpcTft>();
+        EpcTft::PacketFilter pf;
+        pf.remoteAddress.Set("1.0.0.2");
+        pf.remoteMask.Set(0xffffffff);
+        pf.localAddress.Set(i == 2 ? "7.0.1.2" : "7.0.0.2");
+        pf.localMask.Set(0xffffffff);
+        pf.remotePortStart = 1000 + i;
+        pf.remotePortEnd = 1000 + i;
+        pf.localPortStart = 2000;
+        pf.localPortEnd = 2000;
+        pf.direction = (i == 1) ? EpcTft::DOWNLINK : EpcTft::BIDIRECTIONAL;
+        tft->Add(pf);
+        tfts[2 + i] = tft;
+    }
+
+    // single local port, any remote host
+    Ptr<EpcTft> localPortTft = Create<EpcTft>();
+    EpcTft::PacketFilter localPortPf;
+    localPortPf.localPortStart = 3000;
+    localPortPf.localPortEnd = 3000;
+    localPortTft->Add(localPortPf);
+    EpcTft::PacketFilter tosPf;
+    tosPf.typeOfService = 0xb8;
+    tosPf.typeOfServiceMask = 0xfc;
+    localPortTft->Add(tosPf);
+    tfts[5] = localPortTft;
+
+    // remote subnet
+    Ptr<EpcTft> subnetTft = Create<EpcTft>();
+    EpcTft::PacketFilter subnetPf;
+    subnetPf.remoteAddress.Set("2.0.0.0");
+    subnetPf.remoteMask.Set(0xff000000);
+    subnetPf.direction = EpcTft::UPLINK;
+    subnetTft->Add(subnetPf);
+    tfts[6] = subnetTft;
+
+    // port ranges, which overlap the exact filters
+    Ptr<EpcTft> rangeTft = Create<EpcTft>();
+    EpcTft::PacketFilter rangePf;
+    rangePf.localPortStart = 2000;
+    rangePf.localPortEnd = 2009;
+    rangeTft->Add(rangePf);
+    tfts[7] = rangeTft;
+
+    Ptr<EpcTft> remoteRangeTft = Create<EpcTft>();
+    EpcTft::PacketFilter remoteRangePf;
+    remoteRangePf.remotePortStart = 1001;
+    remoteRangePf.remotePortEnd = 1100;
+    remoteRangePf.localAddress.Set("7.0.0.3");
+    remoteRangePf.localMask.Set(0xffffffff);
+    remoteRangeTft->Add(remoteRangePf);
+    tfts[8] = remoteRangeTft;
+
+    // exact filter with a higher id than the ranges
+    Ptr<EpcTft> highTft = Create<EpcTft>();
+    EpcTft::PacketFilter highPf;
+    highPf.remoteAddress.Set("1.0.0.3");
+    highPf.remoteMask.Set(0xffffffff);
+    highPf.localPortStart = 2005;
+    highPf.localPortEnd = 2005;
+    highTft->Add(highPf);
+    tfts[9] = highTft;
+
+    for (const auto& tft : tfts)
+    {
+        c->Add(tft.second, tft.first);
+    }
+    CheckClassification(c, tfts);
+
+    // delete TFTs and check that the index is rebuilt
+    c->Delete(7);
+    tfts.erase(7);
+    c->Delete(3);
+    tfts.erase(3);
+    CheckClassification(c, tfts);
+
+    // replace a TFT
+    c->Add(rangeTft, 9);
+    tfts[9] = rangeTft;
+    CheckClassification(c, tfts);
+}
+
 /**
  * \ingroup lte-test
  *
@@ -1015,4 +1209,6 @@ EpcTftClassifierTestSuite::EpcTftClassifierTestSuite()
                                                  useIpv6),
                     TestCase::QUICK);
     }
+
+    AddTestCase(new EpcTftClassifierIndexTestCase(), TestCase::QUICK);
 }
@@ -18,6 +18,8 @@
  *
  */
 
+#include <ns3/a2-a4-rsrq-handover-algorithm.h>
+#include <ns3/a3-rsrp-handover-algorithm.h>
 #include <ns3/boolean.h>
 #include <ns3/callback.h>
 #include <ns3/config.h>
@@ -31,11 +33,13 @@
 #include <ns3/log.h>
 #include <ns3/lte-enb-net-device.h>
 #include <ns3/lte-enb-phy.h>
+#include <ns3/lte-handover-management-sap.h>
 #include <ns3/lte-helper.h>
 #include <ns3/mobility-helper.h>
 #include <ns3/net-device-container.h>
 #include <ns3/node-container.h>
 #include <ns3/nstime.h>
+#include <ns3/object-factory.h>
 #include <ns3/point-to-point-epc-helper.h>
 #include <ns3/point-to-point-helper.h>
 #include <ns3/position-allocator.h>
@@ -43,6 +47,10 @@
 #include <ns3/test.h>
 #include <ns3/uinteger.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("LteHandoverTargetTest");
@@ -80,6 +88,8 @@ class LteHandoverTargetTestCase : public TestCase
      *                     cell
      * \param handoverAlgorithmType the type of handover algorithm to be used in
      *                              all eNodeBs
+     * \param measReportBatching whether the eNodeBs batch the measurement
+     *                           reports (LteEnbRrc::MeasReportBatching)
      */
     LteHandoverTargetTestCase(std::string name,
                               Vector uePosition,
@@ -87,7 +97,8 @@ class LteHandoverTargetTestCase : public TestCase
                               uint8_t gridSizeY,
                               uint16_t sourceCellId,
                               uint16_t targetCellId,
-                              std::string handoverAlgorithmType);
+                              std::string handoverAlgorithmType,
+                              bool measReportBatching = false);
 
     ~LteHandoverTargetTestCase() override;
 
@@ -136,6 +147,7 @@ class LteHandoverTargetTestCase : public TestCase
     uint16_t m_sourceCellId;             ///< source cell ID
     uint16_t m_targetCellId;             ///< target cell ID
     std::string m_handoverAlgorithmType; ///< handover algorithm type
+    bool m_measReportBatching;           ///< batch the measurement reports?
 
     Ptr<LteEnbNetDevice> m_sourceEnbDev; ///< source ENB device
     bool m_hasHandoverOccurred;          ///< has handover occurred?
@@ -148,7 +160,8 @@ LteHandoverTargetTestCase::LteHandoverTargetTestCase(std::string name,
                                                      uint8_t gridSizeY,
                                                      uint16_t sourceCellId,
                                                      uint16_t targetCellId,
-                                                     std::string handoverAlgorithmType)
+                                                     std::string handoverAlgorithmType,
+                                                     bool measReportBatching)
     : TestCase(name),
       m_uePosition(uePosition),
       m_gridSizeX(gridSizeX),
@@ -156,6 +169,7 @@ LteHandoverTargetTestCase::LteHandoverTargetTestCase(std::string name,
       m_sourceCellId(sourceCellId),
       m_targetCellId(targetCellId),
       m_handoverAlgorithmType(handoverAlgorithmType),
+      m_measReportBatching(measReportBatching),
       m_sourceEnbDev(nullptr),
       m_hasHandoverOccurred(false)
 {
@@ -224,6 +238,7 @@ LteHandoverTargetTestCase::DoRun()
     Config::SetDefault("ns3::LteEnbPhy::TxPower", DoubleValue(38)); // micro cell
     Config::SetDefault("ns3::LteSpectrumPhy::CtrlErrorModelEnabled",
                        BooleanValue(false)); // disable control channel error model
+    Config::SetDefault("ns3::LteEnbRrc::MeasReportBatching", BooleanValue(m_measReportBatching));
 
     Ptr<LteHelper> lteHelper = CreateObject<LteHelper>();
     Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper>();
@@ -376,6 +391,146 @@ LteHandoverTargetTestCase::DoTeardown()
     NS_TEST_ASSERT_MSG_EQ(m_hasHandoverOccurred, true, "Handover did not occur");
 }
 
+/**
+ * \ingroup lte-test
+ *
+ * \brief Testing that a handover algorithm handles a batch of measurement
+ *        reports natively, making at most one handover decision per UE.
+ *
+ * Part of the `lte-handover-target` test suite.
+ *
+ * The reports are delivered directly to the handover algorithm through
+ * LteHandoverManagementSapProvider::ReportUeMeasBatch, and the handovers it
+ * triggers are recorded by a stub eNodeB RRC instance.
+ */
+class LteHandoverTargetBatchTestCase : public TestCase,
+                                       public LteHandoverManagementSapUser
+{
+  public:
+    /**
+     * \brief Construct a new test case.
+     * \param handoverAlgorithmType the type of handover algorithm to be tested
+     */
+    LteHandoverTargetBatchTestCase(std::string handoverAlgorithmType);
+
+    // inherited from LteHandoverManagementSapUser
+    std::vector<uint8_t> AddUeMeasReportConfigForHandover(
+        LteRrcSap::ReportConfigEutra reportConfig) override;
+    void TriggerHandover(uint16_t rnti, uint16_t targetCellId) override;
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Build a measurement report of neighbour cells.
+     * \param rnti the RNTI of the UE
+     * \param measId the measurement identity
+     * \param servingCellValue the RSRP and RSRQ of the serving cell
+     * \param cells the cell IDs of the neighbour cells with their RSRP and RSRQ
+     * \return the report
+     */
+    static LteHandoverManagementSapProvider::UeMeasReport MakeReport(
+        uint16_t rnti,
+        uint8_t measId,
+        uint8_t servingCellValue,
+        std::vector<std::pair<uint16_t, uint8_t>> cells);
+
+    std::string m_handoverAlgorithmType; ///< handover algorithm type
+    uint8_t m_lastMeasId;                ///< last measurement identity given
+    /// RNTI and target cell ID of the triggered handovers
+    std::vector<std::pair<uint16_t, uint16_t>> m_handovers;
+};
+
+LteHandoverTargetBatchTestCase::LteHandoverTargetBatchTestCase(std::string handoverAlgorithmType)
+    : TestCase("Batched reports to " + handoverAlgorithmType),
+      m_handoverAlgorithmType(handoverAlgorithmType),
+      m_lastMeasId(0)
+{
+}
+
+std::vector<uint8_t>
+LteHandoverTargetBatchTestCase::AddUeMeasReportConfigForHandover(
+    LteRrcSap::ReportConfigEutra reportConfig)
+{
+    return {++m_lastMeasId};
+}
+
+void
+LteHandoverTargetBatchTestCase::TriggerHandover(uint16_t rnti, uint16_t targetCellId)
+{
+    m_handovers.emplace_back(rnti, targetCellId);
+}
+
+LteHandoverManagementSapProvider::UeMeasReport
+LteHandoverTargetBatchTestCase::MakeReport(uint16_t rnti,
+                                           uint8_t measId,
+                                           uint8_t servingCellValue,
+                                           std::vector<std::pair<uint16_t, uint8_t>> cells)
+{
+    LteRrcSap::MeasResults measResults;
+    measResults.measId = measId;
+    measResults.measResultPCell.rsrpResult = servingCellValue;
+    measResults.measResultPCell.rsrqResult = servingCellValue;
+    measResults.haveMeasResultNeighCells = !cells.empty();
+    measResults.haveMeasResultServFreqList = false;
+    for (const auto& cell : cells)
+    {
+        LteRrcSap::MeasResultEutra measResultEutra;
+        measResultEutra.physCellId = cell.first;
+        measResultEutra.haveCgiInfo = false;
+        measResultEutra.haveRsrpResult = true;
+        measResultEutra.rsrpResult = cell.second;
+        measResultEutra.haveRsrqResult = true;
+        measResultEutra.rsrqResult = cell.second;
+        measResults.measResultListEutra.push_back(measResultEutra);
+    }
+    return {rnti, measResults};
+}
+
+void
+LteHandoverTargetBatchTestCase::DoRun()
+{
+    ObjectFactory factory;
+    factory.SetTypeId(m_handoverAlgorithmType);
+    Ptr<LteHandoverAlgorithm> algorithm = factory.Create<LteHandoverAlgorithm>();
+    algorithm->SetLteHandoverManagementSapUser(this);
+    algorithm->Initialize();
+
+    std::vector<LteHandoverManagementSapProvider::UeMeasReport> reports;
+    std::vector<std::pair<uint16_t, uint16_t>> expected;
+    if (m_handoverAlgorithmType == "ns3::A3RsrpHandoverAlgorithm")
+    {
+        // the best neighbour of each UE is selected over all its reports
+        reports.push_back(MakeReport(1, 1, 30, {{2, 40}, {3, 45}}));
+        reports.push_back(MakeReport(2, 1, 30, {{2, 50}}));
+        reports.push_back(MakeReport(1, 1, 30, {{4, 50}, {2, 42}}));
+        reports.push_back(MakeReport(3, 2, 30, {{2, 60}})); // unknown measId
+        expected = {{1, 4}, {2, 2}};
+    }
+    else
+    {
+        // measIds 1 and 2 are the Event A2 and Event A4 measurements; the A4
+        // reports of a UE are applied before its A2 report is evaluated
+        reports.push_back(MakeReport(1, 1, 10, {}));
+        reports.push_back(MakeReport(1, 2, 10, {{2, 20}, {3, 25}}));
+        reports.push_back(MakeReport(2, 2, 10, {{2, 20}}));
+        reports.push_back(MakeReport(3, 1, 10, {})); // no neighbour measurements
+        reports.push_back(MakeReport(1, 2, 10, {{2, 28}}));
+        expected = {{1, 2}};
+    }
+    algorithm->GetLteHandoverManagementSapProvider()->ReportUeMeasBatch(reports);
+
+    std::size_t nHandovers = m_handovers.size();
+    NS_TEST_ASSERT_MSG_EQ(nHandovers, expected.size(), "Wrong number of handovers");
+    for (std::size_t i = 0; i < std::min(nHandovers, expected.size()); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_handovers[i].first, expected[i].first, "Wrong RNTI");
+        NS_TEST_ASSERT_MSG_EQ(m_handovers[i].second, expected[i].second, "Wrong target cell");
+    }
+
+    algorithm->Dispose();
+}
+
 /**
  * \brief Test suite ``lte-handover-target``, verifying that handover
  *        algorithms are able to select the right target cell.
@@ -422,6 +577,29 @@ LteHandoverTargetTestSuite::LteHandoverTargetTestSuite()
                                               3,
                                               "ns3::A3RsrpHandoverAlgorithm"),
                 TestCase::QUICK);
+    AddTestCase(new LteHandoverTargetTestCase("4 cells and A2-A4-RSRQ algorithm, batched reports",
+                                              Vector(20, 40, 0),
+                                              2,
+                                              2,
+                                              1,
+                                              3,
+                                              "ns3::A2A4RsrqHandoverAlgorithm",
+                                              true),
+                TestCase::QUICK);
+    AddTestCase(
+        new LteHandoverTargetTestCase("4 cells and strongest cell algorithm, batched reports",
+                                      Vector(20, 40, 0),
+                                      2,
+                                      2,
+                                      1,
+                                      3,
+                                      "ns3::A3RsrpHandoverAlgorithm",
+                                      true),
+        TestCase::QUICK);
+    AddTestCase(new LteHandoverTargetBatchTestCase("ns3::A2A4RsrqHandoverAlgorithm"),
+                TestCase::QUICK);
+    AddTestCase(new LteHandoverTargetBatchTestCase("ns3::A3RsrpHandoverAlgorithm"),
+                TestCase::QUICK);
 
     /*
      *    4 --- 5 --- 6
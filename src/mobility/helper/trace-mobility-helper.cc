@@ -0,0 +1,159 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "trace-mobility-helper.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/waypoint-mobility-model.h"
+#include "ns3/waypoint-trace.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TraceMobilityHelper");
+
+namespace
+{
+
+/**
+ * \ingroup mobility
+ * \brief Feed the waypoints of a trace to the WaypointMobilityModel of
+ * the nodes, a window ahead of the simulation time.
+ */
+class WaypointTraceFeeder : public SimpleRefCount<WaypointTraceFeeder>
+{
+  public:
+    /**
+     * \param trace the trace
+     * \param objects the objects, by index in the trace
+     * \param window the time of the waypoints read ahead
+     */
+    WaypointTraceFeeder(Ptr<WaypointTrace> trace,
+                        const std::vector<Ptr<Object>>& objects,
+                        Time window)
+        : m_trace(trace),
+          m_objects(objects),
+          m_models(objects.size()),
+          m_window(window)
+    {
+        m_pending = m_trace->Read(m_record);
+    }
+
+    /**
+     * Add the waypoints of the next window to the models, and schedule the
+     * next feed after half a window.
+     */
+    void Feed()
+    {
+        Time horizon = Simulator::Now() + m_window;
+        uint32_t waypoints = 0;
+        while (m_pending && Seconds(m_record.time) <= horizon)
+        {
+            Ptr<WaypointMobilityModel> model = GetModel(m_record.node);
+            if (model)
+            {
+                NS_ABORT_MSG_IF(Seconds(m_record.time) < Simulator::Now(),
+                                "Waypoint of node " << m_record.node << " in the past, at "
+                                                    << m_record.time << " s");
+                model->AddWaypoint(Waypoint(Seconds(m_record.time), m_record.position));
+                waypoints++;
+            }
+            m_pending = m_trace->Read(m_record);
+        }
+        NS_LOG_LOGIC("Fed " << waypoints << " waypoints up to " << horizon.As(Time::S));
+        if (m_pending)
+        {
+            Simulator::Schedule(m_window / 2,
+                                &WaypointTraceFeeder::Feed,
+                                Ptr<WaypointTraceFeeder>(this));
+        }
+    }
+
+  private:
+    /**
+     * Get or create the WaypointMobilityModel of a node.
+     * \param node the index of the node
+     * \return the model, or \c nullptr if the node is not installed
+     */
+    Ptr<WaypointMobilityModel> GetModel(uint32_t node)
+    {
+        if (node >= m_objects.size() || !m_objects[node])
+        {
+            return nullptr;
+        }
+        if (!m_models[node])
+        {
+            Ptr<MobilityModel> mobility = m_objects[node]->GetObject<MobilityModel>();
+            m_models[node] = DynamicCast<WaypointMobilityModel>(mobility);
+            if (!mobility)
+            {
+                m_models[node] = CreateObject<WaypointMobilityModel>();
+                m_objects[node]->AggregateObject(m_models[node]);
+            }
+            NS_ABORT_MSG_UNLESS(m_models[node],
+                                "Node " << node << " has a MobilityModel, "
+                                        << "which is not a WaypointMobilityModel");
+        }
+        return m_models[node];
+    }
+
+    Ptr<WaypointTrace> m_trace;                       //!< the trace
+    std::vector<Ptr<Object>> m_objects;               //!< the objects, by index
+    std::vector<Ptr<WaypointMobilityModel>> m_models; //!< the models, by index
+    Time m_window;                                    //!< the time of the waypoints read ahead
+    WaypointTrace::Record m_record;                   //!< the next waypoint
+    bool m_pending;                                   //!< whether the next waypoint is valid
+};
+
+} // namespace
+
+TraceMobilityHelper::TraceMobilityHelper(std::string filename)
+    : m_filename(filename),
+      m_window(Seconds(10))
+{
+}
+
+void
+TraceMobilityHelper::SetWindow(Time window)
+{
+    NS_ABORT_MSG_UNLESS(window.IsStrictlyPositive(), "The window must be positive");
+    m_window = window;
+}
+
+void
+TraceMobilityHelper::Install() const
+{
+    Install(NodeList::Begin(), NodeList::End());
+}
+
+void
+TraceMobilityHelper::DoInstall(const std::vector<Ptr<Object>>& objects) const
+{
+    NS_LOG_FUNCTION(this << objects.size());
+    Ptr<WaypointTrace> trace = Create<WaypointTrace>();
+    NS_ABORT_MSG_UNLESS(trace->Open(m_filename), "Can't open waypoint trace " << m_filename);
+    Time window = std::max(m_window, Seconds(2 * trace->GetMaxGap()));
+    NS_LOG_INFO("Streaming " << m_filename << " with a window of " << window.As(Time::S));
+    Ptr<WaypointTraceFeeder> feeder = Create<WaypointTraceFeeder>(trace, objects, window);
+    feeder->Feed();
+}
+
+} // namespace ns3
@@ -0,0 +1,114 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TRACE_MOBILITY_HELPER_H
+#define TRACE_MOBILITY_HELPER_H
+
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup mobility
+ * \brief Helper class which streams a waypoint trace to the
+ * WaypointMobilityModel of the nodes.
+ *
+ * Unlike the Ns2MobilityHelper, which parses a whole movement file at
+ * setup, this helper reads a WaypointTrace, sorted by time, while the
+ * simulation runs: every half \c Window, the waypoints of the next
+ * \c Window are added to the WaypointMobilityModel of their nodes. The
+ * memory used by the mobility of the nodes is thus bounded by the waypoints
+ * of a window, whatever the length of the trace, and the setup only reads
+ * the first window.
+ *
+ * The node of a waypoint must have its next waypoint before it reaches
+ * this waypoint, otherwise the WaypointMobilityModel stops there. The
+ * window is thus at least twice the maximum gap of the trace, when it is
+ * known: the traces converted from ns-2 movement files by the
+ * convert-ns2-mobility program of utils have a known maximum gap, which
+ * may be bounded by splitting the long moves and pauses.
+ *
+ * The nodes without a MobilityModel get a WaypointMobilityModel at their
+ * first waypoint. The nodes whose index is not in the installed nodes are
+ * ignored.
+ */
+class TraceMobilityHelper
+{
+  public:
+    /**
+     * \param filename filename of the waypoint trace, text or binary.
+     */
+    TraceMobilityHelper(std::string filename);
+
+    /**
+     * \param window the time of the waypoints read ahead of the simulation
+     *        time (10 seconds by default).
+     */
+    void SetWindow(Time window);
+
+    /**
+     * Stream the trace to the nodes of the global ns3::NodeList whose
+     * nodeId matches the index of the nodes in the trace.
+     */
+    void Install() const;
+
+    /**
+     * \param begin an iterator which points to the start of the input
+     *        object array.
+     * \param end an iterator which points to the end of the input
+     *        object array.
+     *
+     * Stream the trace to the input objects. Each input object is
+     * identified by the index of the object in the input array.
+     */
+    template <typename T>
+    void Install(T begin, T end) const;
+
+  private:
+    /**
+     * Stream the trace to objects.
+     * \param objects the objects, by index in the trace
+     */
+    void DoInstall(const std::vector<Ptr<Object>>& objects) const;
+
+    std::string m_filename; //!< filename of the waypoint trace
+    Time m_window;          //!< time of the waypoints read ahead
+};
+
+} // namespace ns3
+
+namespace ns3
+{
+
+template <typename T>
+void
+TraceMobilityHelper::Install(T begin, T end) const
+{
+    std::vector<Ptr<Object>> objects;
+    for (T i = begin; i != end; ++i)
+    {
+        objects.push_back(*i);
+    }
+    DoInstall(objects);
+}
+
+} // namespace ns3
+
+#endif /* TRACE_MOBILITY_HELPER_H */
@@ -21,6 +21,7 @@
 
 #include "ns3/trace-source-accessor.h"
 
+#include <atomic>
 #include <cmath>
 
 namespace ns3
@@ -57,6 +58,7 @@ MobilityModel::GetTypeId()
 
 MobilityModel::MobilityModel()
 {
+    NewPositionEpoch();
 }
 
 MobilityModel::~MobilityModel()
@@ -92,6 +94,7 @@ void
 MobilityModel::SetPosition(const Vector& position)
 {
     DoSetPosition(position);
+    NewPositionEpoch();
 }
 
 double
@@ -111,9 +114,24 @@ MobilityModel::GetRelativeSpeed(Ptr<const MobilityModel> other) const
 void
 MobilityModel::NotifyCourseChange() const
 {
+    NewPositionEpoch();
     m_courseChangeTrace(this);
 }
 
+uint64_t
+MobilityModel::GetPositionEpoch() const
+{
+    return m_positionEpoch;
+}
+
+void
+MobilityModel::NewPositionEpoch() const
+{
+    // the models of different partitions can move concurrently
+    static std::atomic<uint64_t> epochs(0);
+    m_positionEpoch = epochs.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 int64_t
 MobilityModel::AssignStreams(int64_t start)
 {
@@ -90,6 +90,20 @@ class MobilityModel : public Object
      * \return the number of stream indices assigned by this model
      */
     int64_t AssignStreams(int64_t stream);
+    /**
+     * The position epoch changes whenever the course of the model changes,
+     * that is, when the position is set or the course change listeners are
+     * notified. The epochs are drawn from a counter shared by all the
+     * mobility models, so that an epoch identifies both a model and its
+     * course: two calls returning the same epoch are the same model, on the
+     * same course.
+     *
+     * The models whose velocity is not zero move without changing their
+     * epoch, which thus identifies their position only while they stand still.
+     *
+     * \return the position epoch of this model
+     */
+    uint64_t GetPositionEpoch() const;
 
     /**
      *  TracedCallback signature.
@@ -149,6 +163,13 @@ class MobilityModel : public Object
      * or position has occurred.
      */
     ns3::TracedCallback<Ptr<const MobilityModel>> m_courseChangeTrace;
+
+    /**
+     * Change the position epoch to a new value of the shared counter.
+     */
+    void NewPositionEpoch() const;
+
+    mutable uint64_t m_positionEpoch; //!< the position epoch
 };
 
 } // namespace ns3
@@ -0,0 +1,586 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "population-mobility-model.h"
+
+#include "ns3/abort.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PopulationMobilityModel");
+
+NS_OBJECT_ENSURE_REGISTERED(PopulationMobilityManager);
+NS_OBJECT_ENSURE_REGISTERED(PopulationMobilityModel);
+
+namespace
+{
+
+/** The number of slots of the timer wheel. */
+const uint64_t WHEEL_SIZE = 1024;
+/** The change slot of the nodes without change. */
+const uint64_t NO_CHANGE = std::numeric_limits<uint64_t>::max();
+/** The index of the models which are not in a population. */
+const uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max();
+
+/**
+ * Fold a coordinate of a straight move into an interval, as if the move
+ * rebounded on the bounds of the interval.
+ *
+ * \param x the coordinate of the straight move
+ * \param min the lower bound of the interval
+ * \param max the upper bound of the interval
+ * \param [out] sign the sign of the velocity along the coordinate, after the rebounds
+ * \return the folded coordinate
+ */
+double
+Fold(double x, double min, double max, double& sign)
+{
+    sign = 1;
+    double width = max - min;
+    if (width <= 0)
+    {
+        return min;
+    }
+    double u = std::fmod(x - min, 2 * width);
+    if (u < 0)
+    {
+        u += 2 * width;
+    }
+    if (u <= width)
+    {
+        return min + u;
+    }
+    sign = -1;
+    return max - (u - width);
+}
+
+} // unnamed namespace
+
+TypeId
+PopulationMobilityManager::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::PopulationMobilityManager")
+            .SetParent<Object>()
+            .SetGroupName("Mobility")
+            .AddConstructor<PopulationMobilityManager>()
+            .AddAttribute("Model",
+                          "The mobility model of the population.",
+                          EnumValue(PopulationMobilityManager::RANDOM_WALK),
+                          MakeEnumAccessor(&PopulationMobilityManager::m_model),
+                          MakeEnumChecker(PopulationMobilityManager::RANDOM_WALK,
+                                          "RandomWalk",
+                                          PopulationMobilityManager::RANDOM_DIRECTION,
+                                          "RandomDirection",
+                                          PopulationMobilityManager::RANDOM_WAYPOINT,
+                                          "RandomWaypoint"))
+            .AddAttribute("Bounds",
+                          "Bounds of the area of the random walk and random direction models.",
+                          RectangleValue(Rectangle(0.0, 100.0, 0.0, 100.0)),
+                          MakeRectangleAccessor(&PopulationMobilityManager::m_bounds),
+                          MakeRectangleChecker())
+            .AddAttribute("Mode",
+                          "The condition used to change the speed and direction of the "
+                          "random walk.",
+                          EnumValue(PopulationMobilityManager::MODE_DISTANCE),
+                          MakeEnumAccessor(&PopulationMobilityManager::m_mode),
+                          MakeEnumChecker(PopulationMobilityManager::MODE_DISTANCE,
+                                          "Distance",
+                                          PopulationMobilityManager::MODE_TIME,
+                                          "Time"))
+            .AddAttribute("Time",
+                          "Change the speed and direction of the random walk after moving for "
+                          "this delay.",
+                          TimeValue(Seconds(1.0)),
+                          MakeTimeAccessor(&PopulationMobilityManager::m_modeTime),
+                          MakeTimeChecker())
+            .AddAttribute("Distance",
+                          "Change the speed and direction of the random walk after moving for "
+                          "this distance.",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&PopulationMobilityManager::m_modeDistance),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("Speed",
+                          "A random variable used to pick the speed (m/s).",
+                          StringValue("ns3::UniformRandomVariable[Min=2.0|Max=4.0]"),
+                          MakePointerAccessor(&PopulationMobilityManager::m_speed),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("Direction",
+                          "A random variable used to pick the direction of the random walk "
+                          "(radians).",
+                          StringValue("ns3::UniformRandomVariable[Min=0.0|Max=6.283184]"),
+                          MakePointerAccessor(&PopulationMobilityManager::m_direction),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("Pause",
+                          "A random variable used to pick the pause of the random direction "
+                          "and random waypoint models (s).",
+                          StringValue("ns3::ConstantRandomVariable[Constant=2.0]"),
+                          MakePointerAccessor(&PopulationMobilityManager::m_pause),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("PositionAllocator",
+                          "The position model used to pick the destinations of the random "
+                          "waypoint model.",
+                          PointerValue(),
+                          MakePointerAccessor(&PopulationMobilityManager::m_position),
+                          MakePointerChecker<PositionAllocator>())
+            .AddAttribute("Resolution",
+                          "The length of the slots of the timer wheel: the course changes are "
+                          "processed at the end of their slot.",
+                          TimeValue(MilliSeconds(10)),
+                          MakeTimeAccessor(&PopulationMobilityManager::m_resolution),
+                          MakeTimeChecker(TimeStep(1)));
+    return tid;
+}
+
+PopulationMobilityManager::PopulationMobilityManager()
+    : m_wheel(WHEEL_SIZE),
+      m_slot(0),
+      m_tickSlot(0),
+      m_inTick(false)
+{
+    NS_LOG_FUNCTION(this);
+    m_uniform = CreateObject<UniformRandomVariable>();
+}
+
+PopulationMobilityManager::~PopulationMobilityManager()
+{
+    NS_LOG_FUNCTION(this);
+    m_tick.Cancel();
+}
+
+void
+PopulationMobilityManager::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_tick.Cancel();
+    m_position = nullptr;
+    Object::DoDispose();
+}
+
+uint32_t
+PopulationMobilityManager::GetN() const
+{
+    return m_models.size();
+}
+
+int64_t
+PopulationMobilityManager::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_speed->SetStream(stream);
+    m_direction->SetStream(stream + 1);
+    m_pause->SetStream(stream + 2);
+    m_uniform->SetStream(stream + 3);
+    int64_t streams = 4;
+    if (m_position)
+    {
+        streams += m_position->AssignStreams(stream + 4);
+    }
+    return streams;
+}
+
+uint32_t
+PopulationMobilityManager::Add(PopulationMobilityModel* model, const Vector& position)
+{
+    NS_LOG_FUNCTION(this << model << position);
+    double now = Simulator::Now().GetSeconds();
+    m_x.push_back(position.x);
+    m_y.push_back(position.y);
+    m_z.push_back(position.z);
+    m_vx.push_back(0);
+    m_vy.push_back(0);
+    m_vz.push_back(0);
+    m_start.push_back(now);
+    m_stop.push_back(now);
+    m_changeSlot.push_back(NO_CHANGE);
+    m_models.push_back(model);
+    return m_models.size() - 1;
+}
+
+void
+PopulationMobilityManager::Remove(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    Vector position = GetPosition(index);
+    double now = Simulator::Now().GetSeconds();
+    m_x[index] = position.x;
+    m_y[index] = position.y;
+    m_z[index] = position.z;
+    m_start[index] = now;
+    m_stop[index] = now;
+    m_changeSlot[index] = NO_CHANGE;
+    m_models[index] = nullptr;
+}
+
+void
+PopulationMobilityManager::Start(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    Vector position = GetPosition(index);
+    switch (m_model)
+    {
+    case RANDOM_WALK:
+        NS_ABORT_MSG_UNLESS(m_bounds.IsInside(position),
+                            "The position " << position << " is out of the bounds of the walk");
+        ChangeCourse(index);
+        break;
+    case RANDOM_DIRECTION:
+        NS_ABORT_MSG_UNLESS(m_bounds.IsInside(position),
+                            "The position " << position << " is out of the bounds");
+        MoveTowards(index, m_uniform->GetValue(0, 2 * M_PI));
+        break;
+    case RANDOM_WAYPOINT:
+        // the random waypoint model starts with a pause
+        SetCourse(index, position, Vector(), 0);
+        ScheduleChange(index, Seconds(m_pause->GetValue()));
+        break;
+    }
+}
+
+void
+PopulationMobilityManager::SetPosition(uint32_t index, const Vector& position)
+{
+    NS_LOG_FUNCTION(this << index << position);
+    m_changeSlot[index] = NO_CHANGE;
+    SetCourse(index, position, Vector(), 0);
+    if (m_models[index]->m_started)
+    {
+        Start(index);
+    }
+}
+
+Vector
+PopulationMobilityManager::GetPosition(uint32_t index) const
+{
+    double t = std::min(Simulator::Now().GetSeconds(), m_stop[index]);
+    double dt = t - m_start[index];
+    Vector position(m_x[index] + m_vx[index] * dt,
+                    m_y[index] + m_vy[index] * dt,
+                    m_z[index] + m_vz[index] * dt);
+    if (m_model == RANDOM_WALK)
+    {
+        double sign;
+        position.x = Fold(position.x, m_bounds.xMin, m_bounds.xMax, sign);
+        position.y = Fold(position.y, m_bounds.yMin, m_bounds.yMax, sign);
+    }
+    return position;
+}
+
+Vector
+PopulationMobilityManager::GetVelocity(uint32_t index) const
+{
+    double t = Simulator::Now().GetSeconds();
+    if (t >= m_stop[index])
+    {
+        return Vector();
+    }
+    Vector velocity(m_vx[index], m_vy[index], m_vz[index]);
+    if (m_model == RANDOM_WALK)
+    {
+        // the direction of the velocity after the rebounds
+        double dt = t - m_start[index];
+        double sign;
+        Fold(m_x[index] + m_vx[index] * dt, m_bounds.xMin, m_bounds.xMax, sign);
+        velocity.x *= sign;
+        Fold(m_y[index] + m_vy[index] * dt, m_bounds.yMin, m_bounds.yMax, sign);
+        velocity.y *= sign;
+    }
+    return velocity;
+}
+
+void
+PopulationMobilityManager::ChangeCourse(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    Vector position = GetPosition(index);
+    switch (m_model)
+    {
+    case RANDOM_WALK: {
+        double speed = m_speed->GetValue();
+        double direction = m_direction->GetValue();
+        SetCourse(index,
+                  position,
+                  Vector(std::cos(direction) * speed, std::sin(direction) * speed, 0.0),
+                  std::numeric_limits<double>::infinity());
+        if (m_mode == MODE_TIME)
+        {
+            ScheduleChange(index, m_modeTime);
+        }
+        else
+        {
+            NS_ABORT_MSG_UNLESS(speed > 0, "The speed of the walk in distance mode must be > 0");
+            ScheduleChange(index, Seconds(m_modeDistance / speed));
+        }
+        break;
+    }
+    case RANDOM_DIRECTION: {
+        // a new direction, away from the border where the node paused
+        double direction = 0;
+        switch (m_bounds.GetClosestSideOrCorner(position))
+        {
+        case Rectangle::RIGHTSIDE:
+            direction = m_uniform->GetValue(M_PI_2, M_PI + M_PI_2);
+            break;
+        case Rectangle::LEFTSIDE:
+            direction = m_uniform->GetValue(-M_PI_2, M_PI - M_PI_2);
+            break;
+        case Rectangle::TOPSIDE:
+            direction = m_uniform->GetValue(M_PI, 2 * M_PI);
+            break;
+        case Rectangle::BOTTOMSIDE:
+            direction = m_uniform->GetValue(0, M_PI);
+            break;
+        case Rectangle::TOPRIGHTCORNER:
+            direction = m_uniform->GetValue(M_PI, M_PI + M_PI_2);
+            break;
+        case Rectangle::TOPLEFTCORNER:
+            direction = m_uniform->GetValue(M_PI + M_PI_2, 2 * M_PI);
+            break;
+        case Rectangle::BOTTOMRIGHTCORNER:
+            direction = m_uniform->GetValue(M_PI_2, M_PI);
+            break;
+        case Rectangle::BOTTOMLEFTCORNER:
+            direction = m_uniform->GetValue(0, M_PI_2);
+            break;
+        }
+        MoveTowards(index, direction);
+        break;
+    }
+    case RANDOM_WAYPOINT: {
+        NS_ABORT_MSG_UNLESS(m_position, "No position allocator added before using this model");
+        Vector destination = m_position->GetNext();
+        double speed = m_speed->GetValue();
+        NS_ABORT_MSG_UNLESS(speed > 0, "The speed of the random waypoint model must be > 0");
+        double distance = CalculateDistance(destination, position);
+        Vector velocity;
+        if (distance > 0)
+        {
+            double k = speed / distance;
+            velocity = Vector(k * (destination.x - position.x),
+                              k * (destination.y - position.y),
+                              k * (destination.z - position.z));
+        }
+        SetCourse(index, position, velocity, distance / speed);
+        ScheduleChange(index, Seconds(distance / speed + m_pause->GetValue()));
+        break;
+    }
+    }
+}
+
+void
+PopulationMobilityManager::MoveTowards(uint32_t index, double direction)
+{
+    NS_LOG_FUNCTION(this << index << direction);
+    Vector position = GetPosition(index);
+    // the move ends on the border, up to the rounding errors of the course
+    position.x = std::min(std::max(position.x, m_bounds.xMin), m_bounds.xMax);
+    position.y = std::min(std::max(position.y, m_bounds.yMin), m_bounds.yMax);
+    double speed = m_speed->GetValue();
+    NS_ABORT_MSG_UNLESS(speed > 0, "The speed of the random direction model must be > 0");
+    Vector velocity(std::cos(direction) * speed, std::sin(direction) * speed, 0.0);
+    Vector next = m_bounds.CalculateIntersection(position, velocity);
+    next.z = position.z;
+    double moveTime = CalculateDistance(position, next) / speed;
+    SetCourse(index, position, velocity, moveTime);
+    ScheduleChange(index, Seconds(moveTime + m_pause->GetValue()));
+}
+
+void
+PopulationMobilityManager::SetCourse(uint32_t index,
+                                     const Vector& position,
+                                     const Vector& velocity,
+                                     double moveTime)
+{
+    NS_LOG_FUNCTION(this << index << position << velocity << moveTime);
+    double now = Simulator::Now().GetSeconds();
+    m_x[index] = position.x;
+    m_y[index] = position.y;
+    m_z[index] = position.z;
+    m_vx[index] = velocity.x;
+    m_vy[index] = velocity.y;
+    m_vz[index] = velocity.z;
+    m_start[index] = now;
+    m_stop[index] = now + moveTime;
+    m_models[index]->CourseChanged();
+}
+
+void
+PopulationMobilityManager::ScheduleChange(uint32_t index, Time delay)
+{
+    NS_LOG_FUNCTION(this << index << delay);
+    // the change is processed at the end of its slot, after the current one
+    int64_t resolution = m_resolution.GetTimeStep();
+    int64_t changeTime = (Simulator::Now() + delay).GetTimeStep();
+    uint64_t slot = (changeTime + resolution - 1) / resolution;
+    slot = std::max(slot, m_slot + 1);
+    m_changeSlot[index] = slot;
+    m_wheel[slot % WHEEL_SIZE].push_back({index, slot});
+    // the next event is scheduled at the end of the current tick
+    if (!m_inTick && (!m_tick.IsRunning() || slot < m_tickSlot))
+    {
+        m_tick.Cancel();
+        m_tickSlot = slot;
+        m_tick = Simulator::Schedule(TimeStep(slot * resolution) - Simulator::Now(),
+                                     &PopulationMobilityManager::Tick,
+                                     this);
+    }
+}
+
+void
+PopulationMobilityManager::Tick()
+{
+    NS_LOG_FUNCTION(this);
+    m_slot = m_tickSlot;
+    m_inTick = true;
+    std::vector<Entry> entries;
+    entries.swap(m_wheel[m_slot % WHEEL_SIZE]);
+    for (const Entry& entry : entries)
+    {
+        if (entry.slot > m_slot)
+        {
+            // a change of a later turn of the wheel
+            m_wheel[m_slot % WHEEL_SIZE].push_back(entry);
+        }
+        else if (m_changeSlot[entry.index] == entry.slot)
+        {
+            m_changeSlot[entry.index] = NO_CHANGE;
+            ChangeCourse(entry.index);
+        }
+        // else the change was canceled by SetPosition or Remove
+    }
+    m_inTick = false;
+
+    // the next slot with changes
+    int64_t resolution = m_resolution.GetTimeStep();
+    for (uint64_t slot = m_slot + 1; slot <= m_slot + WHEEL_SIZE; slot++)
+    {
+        if (!m_wheel[slot % WHEEL_SIZE].empty())
+        {
+            m_tickSlot = slot;
+            m_tick = Simulator::Schedule(TimeStep(slot * resolution) - Simulator::Now(),
+                                         &PopulationMobilityManager::Tick,
+                                         this);
+            break;
+        }
+    }
+}
+
+TypeId
+PopulationMobilityModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::PopulationMobilityModel")
+            .SetParent<MobilityModel>()
+            .SetGroupName("Mobility")
+            .AddConstructor<PopulationMobilityModel>()
+            .AddAttribute("Manager",
+                          "The manager of the population of the node.",
+                          PointerValue(),
+                          MakePointerAccessor(&PopulationMobilityModel::m_manager),
+                          MakePointerChecker<PopulationMobilityManager>());
+    return tid;
+}
+
+PopulationMobilityModel::PopulationMobilityModel()
+    : m_index(NO_INDEX),
+      m_started(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PopulationMobilityModel::~PopulationMobilityModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+PopulationMobilityModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_manager && m_index != NO_INDEX)
+    {
+        m_manager->Remove(m_index);
+    }
+    m_manager = nullptr;
+    MobilityModel::DoDispose();
+}
+
+void
+PopulationMobilityModel::DoInitialize()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_UNLESS(m_manager, "No manager set before using this model");
+    m_started = true;
+    if (m_index == NO_INDEX)
+    {
+        m_index = m_manager->Add(this, Vector());
+    }
+    m_manager->Start(m_index);
+    MobilityModel::DoInitialize();
+}
+
+Vector
+PopulationMobilityModel::DoGetPosition() const
+{
+    if (m_index == NO_INDEX)
+    {
+        return Vector();
+    }
+    return m_manager->GetPosition(m_index);
+}
+
+void
+PopulationMobilityModel::DoSetPosition(const Vector& position)
+{
+    NS_LOG_FUNCTION(this << position);
+    NS_ABORT_MSG_UNLESS(m_manager, "No manager set before using this model");
+    if (m_index == NO_INDEX)
+    {
+        m_index = m_manager->Add(this, position);
+        NotifyCourseChange();
+    }
+    else
+    {
+        m_manager->SetPosition(m_index, position);
+    }
+}
+
+Vector
+PopulationMobilityModel::DoGetVelocity() const
+{
+    if (m_index == NO_INDEX)
+    {
+        return Vector();
+    }
+    return m_manager->GetVelocity(m_index);
+}
+
+void
+PopulationMobilityModel::CourseChanged() const
+{
+    NotifyCourseChange();
+}
+
+} // namespace ns3
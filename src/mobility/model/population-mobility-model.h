@@ -0,0 +1,262 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef POPULATION_MOBILITY_MODEL_H
+#define POPULATION_MOBILITY_MODEL_H
+
+#include "mobility-model.h"
+#include "position-allocator.h"
+#include "rectangle.h"
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/random-variable-stream.h"
+
+#include <vector>
+
+namespace ns3
+{
+
+class PopulationMobilityModel;
+
+/**
+ * \ingroup mobility
+ * \brief Move a whole population of nodes with the same random mobility model.
+ *
+ * The random walk, random direction and random waypoint models, selected by
+ * the \c Model attribute, follow the RandomWalk2dMobilityModel, the
+ * RandomDirection2dMobilityModel and the RandomWaypointMobilityModel, with
+ * the same attributes. But instead of one model per node, each one with its
+ * own events, the manager keeps the course of all the nodes of the population
+ * in contiguous arrays, one entry per PopulationMobilityModel. A course is a
+ * straight move from a position at a constant velocity, possibly until a
+ * stop time, after which the node pauses. The position of a node is computed
+ * on demand from its course: the rebounds of the random walk on the bounds
+ * are folded into the course analytically, and the arrivals of the random
+ * direction and random waypoint models only stop the move.
+ *
+ * The course changes, i.e., the new directions and speeds of the random walk,
+ * and the ends of the pauses, are the only events. They are kept in a single
+ * timer wheel of slots of \c Resolution, and the changes of a slot are all
+ * processed by one simulator event. A change thus happens at the end of its
+ * slot, up to \c Resolution after the time at which the original model would
+ * change the course: the random walks of \c Time mode, with a \c Time
+ * multiple of the resolution and started together, are not delayed.
+ *
+ * The course change trace of the PopulationMobilityModel is fired on each
+ * course change, but not on the rebounds nor on the arrivals, which are not
+ * events.
+ */
+class PopulationMobilityManager : public Object
+{
+  public:
+    /**
+     * Register this type with the TypeId system.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    PopulationMobilityManager();
+    ~PopulationMobilityManager() override;
+
+    /** The mobility models of the population. */
+    enum Model
+    {
+        RANDOM_WALK,      //!< The model of the RandomWalk2dMobilityModel
+        RANDOM_DIRECTION, //!< The model of the RandomDirection2dMobilityModel
+        RANDOM_WAYPOINT   //!< The model of the RandomWaypointMobilityModel
+    };
+
+    /** The modes of the random walk. */
+    enum Mode
+    {
+        MODE_DISTANCE, //!< Change the course after a distance
+        MODE_TIME      //!< Change the course after a time
+    };
+
+    /**
+     * \return the number of nodes of the population
+     */
+    uint32_t GetN() const;
+
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by this manager.
+     *
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this manager
+     */
+    int64_t AssignStreams(int64_t stream);
+
+  private:
+    friend class PopulationMobilityModel;
+
+    void DoDispose() override;
+
+    /**
+     * Add a node to the population, standing at a position until it is started.
+     * \param model the mobility model of the node
+     * \param position the position of the node
+     * \return the index of the node
+     */
+    uint32_t Add(PopulationMobilityModel* model, const Vector& position);
+    /**
+     * Remove a node from the population: it stands at its position, and its
+     * course is not changed anymore.
+     * \param index the index of the node
+     */
+    void Remove(uint32_t index);
+    /**
+     * Start the mobility of a node, from its current position.
+     * \param index the index of the node
+     */
+    void Start(uint32_t index);
+    /**
+     * Move a node to a position, and start its mobility again if it started.
+     * \param index the index of the node
+     * \param position the position
+     */
+    void SetPosition(uint32_t index, const Vector& position);
+    /**
+     * \param index the index of the node
+     * \return the current position of the node
+     */
+    Vector GetPosition(uint32_t index) const;
+    /**
+     * \param index the index of the node
+     * \return the current velocity of the node
+     */
+    Vector GetVelocity(uint32_t index) const;
+
+    /**
+     * Set a new course of a node, from its current position, and schedule
+     * its next change.
+     * \param index the index of the node
+     */
+    void ChangeCourse(uint32_t index);
+    /**
+     * Move a node from its current position in a direction, until the bounds,
+     * and schedule its next change after a pause.
+     * \param index the index of the node
+     * \param direction the direction, in radians
+     */
+    void MoveTowards(uint32_t index, double direction);
+    /**
+     * Set the course of a node, from the current time.
+     * \param index the index of the node
+     * \param position the start position
+     * \param velocity the velocity
+     * \param moveTime the duration of the move, after which the node pauses
+     */
+    void SetCourse(uint32_t index, const Vector& position, const Vector& velocity, double moveTime);
+    /**
+     * Schedule the next course change of a node in the timer wheel.
+     * \param index the index of the node
+     * \param delay the delay of the change, from now
+     */
+    void ScheduleChange(uint32_t index, Time delay);
+    /**
+     * Process the course changes of the current slot of the timer wheel, and
+     * schedule the next slot with changes.
+     */
+    void Tick();
+
+    /** An entry of the timer wheel. */
+    struct Entry
+    {
+        uint32_t index; //!< The index of the node.
+        uint64_t slot;  //!< The slot of the change.
+    };
+
+    Model m_model;                         //!< The mobility model.
+    Rectangle m_bounds;                    //!< The bounds of the random walk and direction.
+    Mode m_mode;                           //!< The mode of the random walk.
+    Time m_modeTime;                       //!< The time between the walk changes.
+    double m_modeDistance;                 //!< The distance between the walk changes.
+    Ptr<RandomVariableStream> m_speed;     //!< The speed.
+    Ptr<RandomVariableStream> m_direction; //!< The direction of the random walk.
+    Ptr<RandomVariableStream> m_pause;     //!< The pause.
+    Ptr<PositionAllocator> m_position;     //!< The waypoints.
+    Ptr<UniformRandomVariable> m_uniform;  //!< The directions of the random direction model.
+    Time m_resolution;                     //!< The length of the slots of the timer wheel.
+
+    // the courses, one entry per node
+    std::vector<double> m_x;                        //!< The x coordinate of the start position.
+    std::vector<double> m_y;                        //!< The y coordinate of the start position.
+    std::vector<double> m_z;                        //!< The z coordinate of the start position.
+    std::vector<double> m_vx;                       //!< The x component of the velocity.
+    std::vector<double> m_vy;                       //!< The y component of the velocity.
+    std::vector<double> m_vz;                       //!< The z component of the velocity.
+    std::vector<double> m_start;                    //!< The start time, in seconds.
+    std::vector<double> m_stop;                     //!< The end time of the move, in seconds.
+    std::vector<uint64_t> m_changeSlot;             //!< The slot of the next change, if any.
+    std::vector<PopulationMobilityModel*> m_models; //!< The mobility models, if not removed.
+
+    std::vector<std::vector<Entry>> m_wheel; //!< The timer wheel, of the changes by slot.
+    uint64_t m_slot;                         //!< The last processed slot.
+    EventId m_tick;                          //!< The event of the next slot with changes.
+    uint64_t m_tickSlot;                     //!< The slot of the next event.
+    bool m_inTick;                           //!< Whether the changes of a slot are processed.
+};
+
+/**
+ * \ingroup mobility
+ * \brief The mobility model of a node of a PopulationMobilityManager.
+ *
+ * The model only holds the index of its node in the \c Manager, which moves
+ * all the nodes of the population. It is typically installed by the
+ * MobilityHelper, with a shared manager:
+ *
+ * \code
+ *   Ptr<PopulationMobilityManager> manager = CreateObject<PopulationMobilityManager>();
+ *   mobility.SetMobilityModel("ns3::PopulationMobilityModel", "Manager", PointerValue(manager));
+ *   mobility.Install(ueNodes);
+ * \endcode
+ *
+ * The node is added to the population by the first call to SetPosition(),
+ * and starts moving when the model is initialized.
+ */
+class PopulationMobilityModel : public MobilityModel
+{
+  public:
+    /**
+     * Register this type with the TypeId system.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    PopulationMobilityModel();
+    ~PopulationMobilityModel() override;
+
+  private:
+    friend class PopulationMobilityManager;
+
+    void DoDispose() override;
+    void DoInitialize() override;
+    Vector DoGetPosition() const override;
+    void DoSetPosition(const Vector& position) override;
+    Vector DoGetVelocity() const override;
+
+    /**
+     * Notify the course change listeners, on behalf of the manager.
+     */
+    void CourseChanged() const;
+
+    Ptr<PopulationMobilityManager> m_manager; //!< The manager of the population.
+    uint32_t m_index;                         //!< The index of the node in the population.
+    bool m_started;                           //!< Whether the model has been initialized.
+};
+
+} // namespace ns3
+
+#endif /* POPULATION_MOBILITY_MODEL_H */
@@ -0,0 +1,539 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "waypoint-trace.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <tuple>
+
+#ifndef __WIN32__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("WaypointTrace");
+
+namespace
+{
+
+/** The header of the binary waypoint traces. */
+struct WaypointTraceHeader
+{
+    char magic[8];       //!< "NS3WAYP".
+    uint32_t version;    //!< The version of the format.
+    uint32_t byteOrder;  //!< 0x01020304, in the byte order of the records.
+    uint64_t recordsNum; //!< The number of records.
+    double maxGap;       //!< The maximum gap of the trace, in seconds, or 0.
+    uint8_t padding[32]; //!< Up to the alignment of the records.
+};
+
+static_assert(sizeof(WaypointTraceHeader) == 64, "The header must be 64 bytes");
+
+/** A record of the binary waypoint traces. */
+struct WaypointTraceRecord
+{
+    double time;       //!< The time of the waypoint, in seconds.
+    uint32_t node;     //!< The index of the node.
+    uint32_t reserved; //!< Zero.
+    double x;          //!< The x coordinate of the position.
+    double y;          //!< The y coordinate of the position.
+    double z;          //!< The z coordinate of the position.
+};
+
+static_assert(sizeof(WaypointTraceRecord) == 40, "The records must be 40 bytes");
+
+/** The magic string of the binary waypoint traces. */
+const char WAYPOINT_TRACE_MAGIC[8] = "NS3WAYP";
+/** The version of the binary waypoint traces. */
+const uint32_t WAYPOINT_TRACE_VERSION = 1;
+/** The byte order mark of the binary waypoint traces. */
+const uint32_t WAYPOINT_TRACE_BYTE_ORDER = 0x01020304;
+
+/** A command of an ns-2 movement file. */
+struct Ns2Command
+{
+    double time;    //!< The time of the command, or -1 for the initial positions.
+    uint32_t node;  //!< The index of the node.
+    bool setdest;   //!< Whether the command is a \c setdest, or a \c set.
+    int axis;       //!< The coordinate set by a \c set command.
+    double value;   //!< The value of the coordinate set by a \c set command.
+    Vector target;  //!< The destination of a \c setdest command.
+    double speed;   //!< The speed of a \c setdest command.
+    uint64_t order; //!< The index of the command in the file.
+};
+
+/**
+ * Parse a line of an ns-2 movement file.
+ *
+ * \param [in] line The line.
+ * \param [out] command The command of the line.
+ * \returns \c false if the line is not a supported command.
+ */
+bool
+ParseNs2Line(std::string line, Ns2Command& command)
+{
+    std::replace(line.begin(), line.end(), '"', ' ');
+    std::replace(line.begin(), line.end(), ';', ' ');
+    std::istringstream iss(line);
+    std::vector<std::string> tokens{std::istream_iterator<std::string>(iss),
+                                    std::istream_iterator<std::string>()};
+    std::size_t i = 0;
+    command.time = -1;
+    if (tokens.size() > 3 && tokens[0][0] == '$' && tokens[1] == "at")
+    {
+        command.time = std::stod(tokens[2]);
+        i = 3;
+    }
+    if (tokens.size() < i + 4 || tokens[i].compare(0, 7, "$node_(") != 0)
+    {
+        return false;
+    }
+    command.node = std::stoul(tokens[i].substr(7));
+    if (tokens[i + 1] == "set" && tokens[i + 2].size() == 2 && tokens[i + 2][1] == '_' &&
+        tokens[i + 2][0] >= 'X' && tokens[i + 2][0] <= 'Z')
+    {
+        command.setdest = false;
+        command.axis = tokens[i + 2][0] - 'X';
+        command.value = std::stod(tokens[i + 3]);
+        return true;
+    }
+    if (tokens[i + 1] == "setdest" && tokens.size() >= i + 5 && command.time >= 0)
+    {
+        command.setdest = true;
+        command.target = Vector(std::stod(tokens[i + 2]), std::stod(tokens[i + 3]), 0);
+        command.speed = std::stod(tokens[i + 4]);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Add a waypoint to the waypoints of a node, replacing the last one if it
+ * has the same time.
+ *
+ * \param [in,out] waypoints The waypoints of the node.
+ * \param [in] time The time of the waypoint.
+ * \param [in] node The index of the node.
+ * \param [in] position The position of the node.
+ */
+void
+AddWaypoint(std::vector<WaypointTrace::Record>& waypoints,
+            double time,
+            uint32_t node,
+            const Vector& position)
+{
+    if (!waypoints.empty() && waypoints.back().time >= time)
+    {
+        waypoints.back().position = position;
+    }
+    else
+    {
+        waypoints.push_back({time, node, position});
+    }
+}
+
+/**
+ * Convert the commands of a node to its waypoints.
+ *
+ * \param [in] commands The commands of the node, in time order, the initial
+ *        positions first.
+ * \param [in] maxGap If positive, the maximum gap of the waypoints.
+ * \param [out] records The waypoints are appended to the records.
+ */
+void
+ConvertNs2Commands(const std::vector<Ns2Command>& commands,
+                   double maxGap,
+                   std::vector<WaypointTrace::Record>& records)
+{
+    uint32_t node = commands.front().node;
+    Vector position;
+    std::size_t i = 0;
+    for (; i < commands.size() && commands[i].time < 0; i++)
+    {
+        double* coordinates[] = {&position.x, &position.y, &position.z};
+        *coordinates[commands[i].axis] = commands[i].value;
+    }
+    std::vector<WaypointTrace::Record> waypoints{{0, node, position}};
+    // the current move, if any
+    bool moving = false;
+    Vector from;
+    double fromTime = 0;
+    Vector to;
+    double arrival = 0;
+    for (; i < commands.size(); i++)
+    {
+        const Ns2Command& command = commands[i];
+        if (moving && arrival <= command.time)
+        {
+            AddWaypoint(waypoints, arrival, node, to);
+            moving = false;
+            position = to;
+        }
+        if (moving)
+        {
+            double ratio = (command.time - fromTime) / (arrival - fromTime);
+            position = from + Vector(ratio * (to.x - from.x), ratio * (to.y - from.y), 0);
+            moving = false;
+        }
+        if (command.setdest)
+        {
+            AddWaypoint(waypoints, command.time, node, position);
+            to = Vector(command.target.x, command.target.y, position.z);
+            double distance = CalculateDistance(position, to);
+            if (command.speed > 0 && distance > 0)
+            {
+                moving = true;
+                from = position;
+                fromTime = command.time;
+                arrival = command.time + distance / command.speed;
+            }
+        }
+        else
+        {
+            double* coordinates[] = {&position.x, &position.y, &position.z};
+            *coordinates[command.axis] = command.value;
+            AddWaypoint(waypoints, command.time, node, position);
+        }
+    }
+    if (moving)
+    {
+        AddWaypoint(waypoints, arrival, node, to);
+    }
+
+    records.push_back(waypoints.front());
+    for (std::size_t j = 1; j < waypoints.size(); j++)
+    {
+        const WaypointTrace::Record& previous = waypoints[j - 1];
+        const WaypointTrace::Record& next = waypoints[j];
+        double gap = next.time - previous.time;
+        uint32_t steps = maxGap > 0 ? static_cast<uint32_t>(std::ceil(gap / maxGap)) : 1;
+        for (uint32_t step = 1; step < steps; step++)
+        {
+            double ratio = static_cast<double>(step) / steps;
+            Vector delta = next.position - previous.position;
+            records.push_back({previous.time + ratio * gap,
+                               node,
+                               previous.position +
+                                   Vector(ratio * delta.x, ratio * delta.y, ratio * delta.z)});
+        }
+        records.push_back(next);
+    }
+}
+
+} // namespace
+
+WaypointTrace::WaypointTrace()
+    : m_mapping(nullptr),
+      m_mappingSize(0),
+      m_records(nullptr),
+      m_recordsNum(0),
+      m_next(0),
+      m_maxGap(0),
+      m_lastTime(-std::numeric_limits<double>::infinity())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+WaypointTrace::~WaypointTrace()
+{
+    NS_LOG_FUNCTION(this);
+    Unmap();
+}
+
+bool
+WaypointTrace::Open(const std::string& fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    Unmap();
+    m_file.close();
+    m_maxGap = 0;
+    m_lastTime = -std::numeric_limits<double>::infinity();
+    if (MapBinary(fileName))
+    {
+        return true;
+    }
+    m_file.open(fileName);
+    if (!m_file.is_open())
+    {
+        NS_LOG_ERROR("Can't open waypoint trace " << fileName);
+        return false;
+    }
+    // the leading comments, with the maximum gap
+    while (m_file.peek() == '#' || m_file.peek() == '\n')
+    {
+        std::string line;
+        std::getline(m_file, line);
+        std::istringstream iss(line);
+        std::string hash;
+        std::string key;
+        if (iss >> hash >> key && key == "max-gap")
+        {
+            iss >> m_maxGap;
+        }
+    }
+    return true;
+}
+
+bool
+WaypointTrace::MapBinary(const std::string& fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    const uint8_t* data = nullptr;
+    std::size_t size = 0;
+#ifdef __WIN32__
+    std::ifstream file(fileName, std::ios::binary);
+    WaypointTraceHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, WAYPOINT_TRACE_MAGIC, sizeof(header.magic)) != 0)
+    {
+        return false;
+    }
+    file.seekg(0);
+    m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data = m_buffer.data();
+    size = m_buffer.size();
+#else
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(WaypointTraceHeader))
+    {
+        close(fd);
+        return false;
+    }
+    size = st.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        NS_LOG_ERROR("Can't map waypoint trace " << fileName);
+        return false;
+    }
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    m_mapping = mapping;
+    m_mappingSize = size;
+    data = static_cast<const uint8_t*>(mapping);
+#endif
+    WaypointTraceHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, WAYPOINT_TRACE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != WAYPOINT_TRACE_VERSION || header.byteOrder != WAYPOINT_TRACE_BYTE_ORDER ||
+        size < sizeof(header) + header.recordsNum * sizeof(WaypointTraceRecord))
+    {
+        NS_LOG_LOGIC("Not a binary waypoint trace: " << fileName);
+        Unmap();
+        return false;
+    }
+    m_records = data + sizeof(WaypointTraceHeader);
+    m_recordsNum = header.recordsNum;
+    m_next = 0;
+    m_maxGap = header.maxGap;
+    NS_LOG_INFO("Mapped waypoint trace " << fileName << " of " << m_recordsNum << " waypoints");
+    return true;
+}
+
+void
+WaypointTrace::Unmap()
+{
+#ifndef __WIN32__
+    if (m_mapping)
+    {
+        munmap(m_mapping, m_mappingSize);
+    }
+#endif
+    m_mapping = nullptr;
+    m_mappingSize = 0;
+    m_buffer.clear();
+    m_records = nullptr;
+    m_recordsNum = 0;
+    m_next = 0;
+}
+
+bool
+WaypointTrace::Read(Record& record)
+{
+    if (m_records)
+    {
+        if (m_next == m_recordsNum)
+        {
+            return false;
+        }
+        WaypointTraceRecord binary;
+        std::memcpy(&binary, m_records + m_next * sizeof(binary), sizeof(binary));
+        m_next++;
+        record.time = binary.time;
+        record.node = binary.node;
+        record.position = Vector(binary.x, binary.y, binary.z);
+    }
+    else
+    {
+        std::string line;
+        do
+        {
+            if (!std::getline(m_file, line))
+            {
+                return false;
+            }
+        } while (line.empty() || line[0] == '#');
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream iss(line);
+        iss >> record.time >> record.node >> record.position.x >> record.position.y >>
+            record.position.z;
+        NS_ABORT_MSG_IF(iss.fail(), "Malformed waypoint trace line: " << line);
+    }
+    NS_ABORT_MSG_IF(record.time < m_lastTime,
+                    "The waypoint trace is not sorted by time at " << record.time);
+    m_lastTime = record.time;
+    return true;
+}
+
+double
+WaypointTrace::GetMaxGap() const
+{
+    return m_maxGap;
+}
+
+bool
+WaypointTrace::Write(const std::string& fileName, const std::vector<Record>& records, bool binary)
+{
+    NS_LOG_FUNCTION(fileName << records.size() << binary);
+    std::map<uint32_t, double> lastTimes;
+    double maxGap = 0;
+    for (const auto& record : records)
+    {
+        auto it = lastTimes.find(record.node);
+        if (it != lastTimes.end())
+        {
+            maxGap = std::max(maxGap, record.time - it->second);
+        }
+        lastTimes[record.node] = record.time;
+    }
+
+    std::ofstream file(fileName, binary ? std::ios::binary : std::ios::out);
+    if (!file.is_open())
+    {
+        NS_LOG_ERROR("Can't create waypoint trace " << fileName);
+        return false;
+    }
+    if (binary)
+    {
+        WaypointTraceHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, WAYPOINT_TRACE_MAGIC, sizeof(header.magic));
+        header.version = WAYPOINT_TRACE_VERSION;
+        header.byteOrder = WAYPOINT_TRACE_BYTE_ORDER;
+        header.recordsNum = records.size();
+        header.maxGap = maxGap;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& record : records)
+        {
+            WaypointTraceRecord binaryRecord{record.time,
+                                             record.node,
+                                             0,
+                                             record.position.x,
+                                             record.position.y,
+                                             record.position.z};
+            file.write(reinterpret_cast<const char*>(&binaryRecord), sizeof(binaryRecord));
+        }
+    }
+    else
+    {
+        file << "# max-gap " << maxGap << "\n";
+        file << std::setprecision(std::numeric_limits<double>::max_digits10);
+        for (const auto& record : records)
+        {
+            file << record.time << "," << record.node << "," << record.position.x << ","
+                 << record.position.y << "," << record.position.z << "\n";
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+bool
+WaypointTrace::ConvertNs2Trace(const std::string& ns2FileName,
+                               const std::string& fileName,
+                               bool binary,
+                               double maxGap)
+{
+    NS_LOG_FUNCTION(ns2FileName << fileName << binary << maxGap);
+    std::ifstream file(ns2FileName);
+    if (!file.is_open())
+    {
+        NS_LOG_ERROR("Can't open ns-2 movement file " << ns2FileName);
+        return false;
+    }
+    std::vector<Ns2Command> commands;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        Ns2Command command;
+        if (ParseNs2Line(line, command))
+        {
+            command.order = commands.size();
+            commands.push_back(command);
+        }
+        else if (!line.empty() && line[0] != '#')
+        {
+            NS_LOG_WARN("Ignored ns-2 movement line: " << line);
+        }
+    }
+    if (commands.empty())
+    {
+        NS_LOG_ERROR("No commands in ns-2 movement file " << ns2FileName);
+        return false;
+    }
+    // by node, then by time, the initial positions first
+    std::sort(commands.begin(), commands.end(), [](const Ns2Command& a, const Ns2Command& b) {
+        return std::tie(a.node, a.time, a.order) < std::tie(b.node, b.time, b.order);
+    });
+
+    std::vector<Record> records;
+    std::size_t first = 0;
+    for (std::size_t i = 1; i <= commands.size(); i++)
+    {
+        if (i == commands.size() || commands[i].node != commands[first].node)
+        {
+            std::vector<Ns2Command> nodeCommands(commands.begin() + first, commands.begin() + i);
+            ConvertNs2Commands(nodeCommands, maxGap, records);
+            first = i;
+        }
+    }
+    std::stable_sort(records.begin(), records.end(), [](const Record& a, const Record& b) {
+        return a.time < b.time;
+    });
+    NS_LOG_INFO("Converted " << commands.size() << " ns-2 commands to " << records.size()
+                             << " waypoints");
+    return Write(fileName, records, binary);
+}
+
+} // namespace ns3
@@ -0,0 +1,148 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef WAYPOINT_TRACE_H
+#define WAYPOINT_TRACE_H
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup mobility
+ * \brief A sequential reader of a waypoint trace, sorted by time.
+ *
+ * A waypoint trace holds the waypoints of a set of nodes, identified by
+ * their index, in ascending time order. The nodes move in a straight line
+ * from a waypoint to the next one, as the WaypointMobilityModel. The traces
+ * are either text files, with one waypoint per line:
+ *
+ * \verbatim
+   # max-gap 10
+   0,0,10.5,20,1.5
+   0,1,100,20,1.5
+   2.5,0,12,20,1.5
+ \endverbatim
+ *
+ * i.e., the time in seconds, the index of the node and the coordinates of
+ * the position, with an optional \c max-gap comment, or binary files. The
+ * binary traces start with a 64 bytes header, followed by 40 bytes records.
+ * They are mapped in memory read-only, and read sequentially, so that
+ * reading a trace does not hold its waypoints in memory.
+ *
+ * The maximum gap of a trace, if known, is the longest time between two
+ * consecutive waypoints of a node. ConvertNs2Trace() writes the traces
+ * converted from ns-2 movement files, possibly splitting the long moves
+ * and pauses to bound their gap (see the convert-ns2-mobility program of
+ * utils).
+ */
+class WaypointTrace : public SimpleRefCount<WaypointTrace>
+{
+  public:
+    /** A waypoint of a node. */
+    struct Record
+    {
+        double time;     //!< The time of the waypoint, in seconds.
+        uint32_t node;   //!< The index of the node.
+        Vector position; //!< The position of the node.
+    };
+
+    WaypointTrace();
+    ~WaypointTrace();
+
+    /**
+     * Open a text or binary waypoint trace.
+     *
+     * \param [in] fileName The name of the trace file.
+     * \returns \c false if the trace can't be opened.
+     */
+    bool Open(const std::string& fileName);
+
+    /**
+     * Read the next waypoint of the trace.
+     *
+     * \param [out] record The waypoint.
+     * \returns \c false at the end of the trace.
+     */
+    bool Read(Record& record);
+
+    /**
+     * \returns The maximum gap of the trace, in seconds, or 0 if unknown.
+     */
+    double GetMaxGap() const;
+
+    /**
+     * Write a waypoint trace.
+     *
+     * \param [in] fileName The name of the trace file.
+     * \param [in] records The waypoints, in ascending time order.
+     * \param [in] binary Whether to write a binary trace.
+     * \returns \c false if the trace can't be written.
+     */
+    static bool Write(const std::string& fileName, const std::vector<Record>& records, bool binary);
+
+    /**
+     * Convert an ns-2 movement file, in the format read by the
+     * Ns2MobilityHelper, to a waypoint trace.
+     *
+     * The initial positions are waypoints at time 0, and each \c setdest
+     * command adds a waypoint at its time, at the current position of the
+     * node, and one at the arrival of the node at its destination, unless
+     * the next command of the node comes first. The \c set commands at a
+     * given time move the node to the new position at that time.
+     *
+     * \param [in] ns2FileName The name of the ns-2 movement file.
+     * \param [in] fileName The name of the waypoint trace.
+     * \param [in] binary Whether to write a binary trace.
+     * \param [in] maxGap If positive, the maximum gap of the trace, in
+     *        seconds: longer moves and pauses are split by waypoints.
+     * \returns \c false if the files can't be read or written.
+     */
+    static bool ConvertNs2Trace(const std::string& ns2FileName,
+                                const std::string& fileName,
+                                bool binary,
+                                double maxGap);
+
+  private:
+    /**
+     * Map a binary trace in memory.
+     *
+     * \param [in] fileName The name of the trace file.
+     * \returns \c false if the file is not a valid binary trace.
+     */
+    bool MapBinary(const std::string& fileName);
+    /** Unmap the binary trace, if any. */
+    void Unmap();
+
+    std::ifstream m_file;          //!< The text trace.
+    void* m_mapping;               //!< The mapping of the binary trace, if any.
+    std::size_t m_mappingSize;     //!< The size of the mapping.
+    const uint8_t* m_records;      //!< The records of the binary trace.
+    uint64_t m_recordsNum;         //!< The number of records of the binary trace.
+    uint64_t m_next;               //!< The index of the next record of the binary trace.
+    std::vector<uint8_t> m_buffer; //!< The binary trace, when it can't be mapped.
+    double m_maxGap;               //!< The maximum gap of the trace.
+    double m_lastTime;             //!< The time of the last record read.
+};
+
+} // namespace ns3
+
+#endif /* WAYPOINT_TRACE_H */
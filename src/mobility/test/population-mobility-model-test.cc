@@ -0,0 +1,247 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/pointer.h"
+#include "ns3/population-mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Check that the random walk of a PopulationMobilityManager rebounds
+ * on the bounds, without events.
+ */
+class PopulationMobilityReboundTestCase : public TestCase
+{
+  public:
+    PopulationMobilityReboundTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PopulationMobilityReboundTestCase::PopulationMobilityReboundTestCase()
+    : TestCase("Check the rebounds of the random walk of a population")
+{
+}
+
+void
+PopulationMobilityReboundTestCase::DoRun()
+{
+    Ptr<PopulationMobilityManager> manager = CreateObject<PopulationMobilityManager>();
+    manager->SetAttribute("Bounds", RectangleValue(Rectangle(0, 10, 0, 10)));
+    manager->SetAttribute("Mode", StringValue("Time"));
+    manager->SetAttribute("Time", TimeValue(Seconds(100)));
+    manager->SetAttribute("Speed", StringValue("ns3::ConstantRandomVariable[Constant=3.0]"));
+    manager->SetAttribute("Direction", StringValue("ns3::ConstantRandomVariable[Constant=0.0]"));
+    Ptr<MobilityModel> model =
+        CreateObjectWithAttributes<PopulationMobilityModel>("Manager", PointerValue(manager));
+    model->SetPosition(Vector(5, 5, 1.5));
+    model->Initialize();
+
+    Simulator::Stop(Seconds(4));
+    Simulator::Run();
+    // 12 m to the right, rebounding at x = 10
+    NS_TEST_EXPECT_MSG_EQ_TOL(CalculateDistance(model->GetPosition(), Vector(3, 5, 1.5)),
+                              0,
+                              1e-9,
+                              "Wrong position");
+    NS_TEST_EXPECT_MSG_EQ_TOL(CalculateDistance(model->GetVelocity(), Vector(-3, 0, 0)),
+                              0,
+                              1e-9,
+                              "Wrong velocity");
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+    // and again at x = 0
+    NS_TEST_EXPECT_MSG_EQ_TOL(CalculateDistance(model->GetPosition(), Vector(3, 5, 1.5)),
+                              0,
+                              1e-9,
+                              "Wrong position");
+    NS_TEST_EXPECT_MSG_EQ_TOL(CalculateDistance(model->GetVelocity(), Vector(3, 0, 0)),
+                              0,
+                              1e-9,
+                              "Wrong velocity");
+    // only the two stop events
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount(), 2, "The rebounds are events");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Check that the nodes of a large population move within their bounds,
+ * at their speed, with a few events for the whole population.
+ */
+class PopulationMobilityModelTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param model the mobility model of the population
+     */
+    PopulationMobilityModelTestCase(PopulationMobilityManager::Model model);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the positions and velocities of the nodes, since the previous check.
+     */
+    void Check();
+    /**
+     * Course change callback
+     * \param model the mobility model
+     */
+    void CourseChange(Ptr<const MobilityModel> model);
+
+    PopulationMobilityManager::Model m_model;   //!< the mobility model of the population
+    std::vector<Ptr<MobilityModel>> m_models;   //!< the mobility models of the nodes
+    std::vector<Vector> m_positions;            //!< the positions of the previous check
+    uint32_t m_moves;                           //!< the number of checks where a node moved
+    uint32_t m_courseChanges;                   //!< the number of course changes of a node
+    static constexpr double m_checkPeriod = 0.25; //!< the period of the checks, in seconds
+    static constexpr double m_maxSpeed = 4;       //!< the maximum speed
+};
+
+PopulationMobilityModelTestCase::PopulationMobilityModelTestCase(
+    PopulationMobilityManager::Model model)
+    : TestCase("Check the mobility of a population of model " + std::to_string(model)),
+      m_model(model),
+      m_moves(0),
+      m_courseChanges(0)
+{
+}
+
+void
+PopulationMobilityModelTestCase::Check()
+{
+    for (std::size_t i = 0; i < m_models.size(); i++)
+    {
+        Vector position = m_models[i]->GetPosition();
+        NS_TEST_EXPECT_MSG_EQ((position.x >= -1e-6 && position.x <= 100 + 1e-6 &&
+                               position.y >= -1e-6 && position.y <= 100 + 1e-6),
+                              true,
+                              "Node " << i << " out of the bounds at " << position);
+        double speed = m_models[i]->GetVelocity().GetLength();
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(speed, m_maxSpeed + 1e-9, "Node " << i << " too fast");
+        double distance = CalculateDistance(position, m_positions[i]);
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(distance,
+                                    m_maxSpeed * m_checkPeriod + 1e-9,
+                                    "Node " << i << " jumped");
+        if (distance > 0)
+        {
+            m_moves++;
+        }
+        m_positions[i] = position;
+    }
+    Simulator::Schedule(Seconds(m_checkPeriod), &PopulationMobilityModelTestCase::Check, this);
+}
+
+void
+PopulationMobilityModelTestCase::CourseChange(Ptr<const MobilityModel> model)
+{
+    m_courseChanges++;
+}
+
+void
+PopulationMobilityModelTestCase::DoRun()
+{
+    const uint32_t nodes = 1000;
+    Ptr<PopulationMobilityManager> manager = CreateObject<PopulationMobilityManager>();
+    manager->SetAttribute("Model", EnumValue(m_model));
+    manager->SetAttribute("Mode", StringValue("Time"));
+    manager->SetAttribute("Speed", StringValue("ns3::UniformRandomVariable[Min=2.0|Max=4.0]"));
+    manager->SetAttribute("Pause", StringValue("ns3::ConstantRandomVariable[Constant=0.5]"));
+    Ptr<RandomRectanglePositionAllocator> waypoints =
+        CreateObject<RandomRectanglePositionAllocator>();
+    waypoints->SetAttribute("X", StringValue("ns3::UniformRandomVariable[Min=0.0|Max=100.0]"));
+    waypoints->SetAttribute("Y", StringValue("ns3::UniformRandomVariable[Min=0.0|Max=100.0]"));
+    manager->SetAttribute("PositionAllocator", PointerValue(waypoints));
+    manager->AssignStreams(1);
+    Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable>();
+    uniform->SetStream(10);
+    for (uint32_t i = 0; i < nodes; i++)
+    {
+        Ptr<MobilityModel> model =
+            CreateObjectWithAttributes<PopulationMobilityModel>("Manager", PointerValue(manager));
+        model->SetPosition(Vector(uniform->GetValue(0, 100), uniform->GetValue(0, 100), 1.5));
+        m_models.push_back(model);
+        m_positions.push_back(model->GetPosition());
+    }
+    m_models[0]->TraceConnectWithoutContext(
+        "CourseChange",
+        MakeCallback(&PopulationMobilityModelTestCase::CourseChange, this));
+    for (const auto& model : m_models)
+    {
+        model->Initialize();
+    }
+    NS_TEST_ASSERT_MSG_EQ(manager->GetN(), nodes, "Wrong number of nodes");
+
+    Simulator::Schedule(Seconds(m_checkPeriod), &PopulationMobilityModelTestCase::Check, this);
+    Simulator::Stop(Seconds(9.9));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_GT(m_moves, nodes * 39 / 2, "The nodes do not move");
+    NS_TEST_EXPECT_MSG_GT(m_courseChanges, 0, "The course changes are not notified");
+    // the checks, the stop, and at most one event per slot of 10 ms
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(Simulator::GetEventCount(),
+                                39 + 1 + 990,
+                                "Too many events for the population");
+    if (m_model == PopulationMobilityManager::RANDOM_WALK)
+    {
+        // the start, and a change per second
+        NS_TEST_EXPECT_MSG_EQ(m_courseChanges, 10, "Wrong number of course changes");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(Simulator::GetEventCount(),
+                                    39 + 1 + 9,
+                                    "Too many events for the population");
+    }
+    Simulator::Destroy();
+    m_models.clear();
+}
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Test suite for the PopulationMobilityManager.
+ */
+class PopulationMobilityModelTestSuite : public TestSuite
+{
+  public:
+    PopulationMobilityModelTestSuite();
+};
+
+PopulationMobilityModelTestSuite::PopulationMobilityModelTestSuite()
+    : TestSuite("population-mobility-model", UNIT)
+{
+    AddTestCase(new PopulationMobilityReboundTestCase, TestCase::QUICK);
+    AddTestCase(new PopulationMobilityModelTestCase(PopulationMobilityManager::RANDOM_WALK),
+                TestCase::QUICK);
+    AddTestCase(new PopulationMobilityModelTestCase(PopulationMobilityManager::RANDOM_DIRECTION),
+                TestCase::QUICK);
+    AddTestCase(new PopulationMobilityModelTestCase(PopulationMobilityManager::RANDOM_WAYPOINT),
+                TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static PopulationMobilityModelTestSuite g_populationMobilityModelTestSuite;
@@ -0,0 +1,268 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/node-container.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/trace-mobility-helper.h"
+#include "ns3/waypoint-mobility-model.h"
+#include "ns3/waypoint-trace.h"
+
+#include <fstream>
+#include <map>
+#include <tuple>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Write the ns-2 movement file of the tests.
+ *
+ * Node 0 starts at (0, 0, 1.5), moves to (10, 0, 1.5) from 1 s to 6 s, and
+ * to (10, 10, 1.5) from 20 s to 30 s. Node 1 starts at (100, 0, 0), and
+ * moves to (100, 30, 0) from 4 s to 34 s.
+ *
+ * \param fileName the name of the file
+ */
+static void
+WriteNs2Trace(const std::string& fileName)
+{
+    std::ofstream file(fileName);
+    file << "$node_(0) set X_ 0.0\n"
+         << "$node_(0) set Y_ 0.0\n"
+         << "$node_(0) set Z_ 1.5\n"
+         << "$node_(1) set X_ 100.0\n"
+         << "$node_(1) set Y_ 0.0\n"
+         << "$ns_ at 20.0 \"$node_(0) setdest 10.0 10.0 1.0\"\n"
+         << "$ns_ at 1.0 \"$node_(0) setdest 10.0 0.0 2.0\"\n"
+         << "$ns_ at 4.0 \"$node_(1) setdest 100.0 30.0 1.0\"\n";
+}
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Check the conversion of an ns-2 movement file to text and binary
+ * waypoint traces.
+ */
+class WaypointTraceConversionTestCase : public TestCase
+{
+  public:
+    WaypointTraceConversionTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Read a waypoint trace.
+     * \param fileName the name of the trace
+     * \param maxGap the maximum gap of the trace
+     * \return the waypoints of the trace
+     */
+    std::vector<WaypointTrace::Record> ReadTrace(const std::string& fileName, double& maxGap);
+};
+
+WaypointTraceConversionTestCase::WaypointTraceConversionTestCase()
+    : TestCase("Check the conversion of ns-2 movement files to waypoint traces")
+{
+}
+
+std::vector<WaypointTrace::Record>
+WaypointTraceConversionTestCase::ReadTrace(const std::string& fileName, double& maxGap)
+{
+    WaypointTrace trace;
+    NS_TEST_EXPECT_MSG_EQ(trace.Open(fileName), true, "Can't open " << fileName);
+    maxGap = trace.GetMaxGap();
+    std::vector<WaypointTrace::Record> records;
+    WaypointTrace::Record record;
+    while (trace.Read(record))
+    {
+        records.push_back(record);
+    }
+    return records;
+}
+
+void
+WaypointTraceConversionTestCase::DoRun()
+{
+    std::string ns2FileName = CreateTempDirFilename("movements.ns2");
+    WriteNs2Trace(ns2FileName);
+
+    // without splitting: the waypoints of the moves and pauses
+    std::string csvFileName = CreateTempDirFilename("movements.csv");
+    NS_TEST_ASSERT_MSG_EQ(WaypointTrace::ConvertNs2Trace(ns2FileName, csvFileName, false, 0),
+                          true,
+                          "Conversion failed");
+    double maxGap = 0;
+    std::vector<WaypointTrace::Record> records = ReadTrace(csvFileName, maxGap);
+    NS_TEST_ASSERT_MSG_EQ(records.size(), 8, "Wrong number of waypoints");
+    NS_TEST_EXPECT_MSG_EQ_TOL(maxGap, 30, 1e-9, "Wrong maximum gap");
+    std::vector<std::pair<double, uint32_t>> expected = {
+        {0, 0},
+        {0, 1},
+        {1, 0},
+        {4, 1},
+        {6, 0},
+        {20, 0},
+        {30, 0},
+        {34, 1},
+    };
+    for (std::size_t i = 0; i < records.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(records[i].time, expected[i].first, 1e-9, "Wrong time");
+        NS_TEST_EXPECT_MSG_EQ(records[i].node, expected[i].second, "Wrong node");
+    }
+    NS_TEST_EXPECT_MSG_EQ_TOL(records[4].position.x, 10, 1e-9, "Wrong arrival");
+    NS_TEST_EXPECT_MSG_EQ_TOL(records[4].position.z, 1.5, 1e-9, "Wrong height");
+    NS_TEST_EXPECT_MSG_EQ_TOL(records[7].position.y, 30, 1e-9, "Wrong arrival");
+
+    // split, in both formats
+    std::string binaryFileName = CreateTempDirFilename("movements.wpt");
+    NS_TEST_ASSERT_MSG_EQ(WaypointTrace::ConvertNs2Trace(ns2FileName, csvFileName, false, 5),
+                          true,
+                          "Conversion failed");
+    NS_TEST_ASSERT_MSG_EQ(WaypointTrace::ConvertNs2Trace(ns2FileName, binaryFileName, true, 5),
+                          true,
+                          "Conversion failed");
+    double binaryMaxGap = 0;
+    records = ReadTrace(csvFileName, maxGap);
+    std::vector<WaypointTrace::Record> binaryRecords = ReadTrace(binaryFileName, binaryMaxGap);
+    NS_TEST_ASSERT_MSG_EQ(records.size(), 8 + 2 + 1 + 5, "Wrong number of split waypoints");
+    NS_TEST_ASSERT_MSG_EQ(binaryRecords.size(), records.size(), "Different binary trace");
+    NS_TEST_EXPECT_MSG_EQ_TOL(maxGap, 5, 1e-9, "Wrong maximum gap");
+    NS_TEST_EXPECT_MSG_EQ_TOL(binaryMaxGap, 5, 1e-9, "Wrong maximum gap");
+    std::map<uint32_t, double> lastTimes;
+    for (std::size_t i = 0; i < records.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(binaryRecords[i].time, records[i].time, "Different binary trace");
+        NS_TEST_EXPECT_MSG_EQ(binaryRecords[i].node, records[i].node, "Different binary trace");
+        NS_TEST_EXPECT_MSG_EQ(binaryRecords[i].position.y,
+                              records[i].position.y,
+                              "Different binary trace");
+        if (lastTimes.count(records[i].node))
+        {
+            NS_TEST_EXPECT_MSG_LT_OR_EQ(records[i].time - lastTimes[records[i].node],
+                                        5 + 1e-9,
+                                        "Gap too long");
+        }
+        lastTimes[records[i].node] = records[i].time;
+    }
+}
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Check that the TraceMobilityHelper moves the nodes along the trace,
+ * holding only the waypoints of a window.
+ */
+class TraceMobilityHelperTestCase : public TestCase
+{
+  public:
+    TraceMobilityHelperTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the position of a node.
+     * \param node the node
+     * \param position the expected position
+     */
+    void CheckPosition(Ptr<Node> node, Vector position);
+};
+
+TraceMobilityHelperTestCase::TraceMobilityHelperTestCase()
+    : TestCase("Check the streaming of a waypoint trace to the nodes")
+{
+}
+
+void
+TraceMobilityHelperTestCase::CheckPosition(Ptr<Node> node, Vector position)
+{
+    Ptr<WaypointMobilityModel> model = node->GetObject<WaypointMobilityModel>();
+    NS_TEST_EXPECT_MSG_EQ_TOL(CalculateDistance(model->GetPosition(), position),
+                              0,
+                              1e-6,
+                              "Node " << node->GetId() << " at " << model->GetPosition()
+                                      << " instead of " << position << " at "
+                                      << Simulator::Now().As(Time::S));
+    // at most the waypoints of 10 s, 5 s apart
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(model->WaypointsLeft(), 3, "Too many waypoints");
+}
+
+void
+TraceMobilityHelperTestCase::DoRun()
+{
+    std::string ns2FileName = CreateTempDirFilename("movements.ns2");
+    WriteNs2Trace(ns2FileName);
+    std::string binaryFileName = CreateTempDirFilename("movements.wpt");
+    NS_TEST_ASSERT_MSG_EQ(WaypointTrace::ConvertNs2Trace(ns2FileName, binaryFileName, true, 5),
+                          true,
+                          "Conversion failed");
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    TraceMobilityHelper helper(binaryFileName);
+    // too short for the maximum gap, which sets the window to 10 s
+    helper.SetWindow(Seconds(2));
+    helper.Install(nodes.Begin(), nodes.End());
+    Ptr<WaypointMobilityModel> model = nodes.Get(1)->GetObject<WaypointMobilityModel>();
+    NS_TEST_ASSERT_MSG_NE(model, nullptr, "No WaypointMobilityModel");
+    // the waypoints at 0 s, 4 s and 9 s, of the 8 waypoints of the node
+    NS_TEST_EXPECT_MSG_EQ(model->WaypointsLeft(), 1, "Not a window of the trace");
+
+    std::vector<std::tuple<double, uint32_t, Vector>> checks = {
+        {0.5, 0, Vector(0, 0, 1.5)},
+        {3, 0, Vector(4, 0, 1.5)},
+        {10, 0, Vector(10, 0, 1.5)},
+        {10, 1, Vector(100, 6, 0)},
+        {25, 0, Vector(10, 5, 1.5)},
+        {29, 1, Vector(100, 25, 0)},
+        {40, 0, Vector(10, 10, 1.5)},
+        {40, 1, Vector(100, 30, 0)},
+    };
+    for (const auto& [time, node, position] : checks)
+    {
+        Simulator::Schedule(Seconds(time),
+                            &TraceMobilityHelperTestCase::CheckPosition,
+                            this,
+                            nodes.Get(node),
+                            position);
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Test suite for the waypoint traces and the TraceMobilityHelper.
+ */
+class TraceMobilityHelperTestSuite : public TestSuite
+{
+  public:
+    TraceMobilityHelperTestSuite();
+};
+
+TraceMobilityHelperTestSuite::TraceMobilityHelperTestSuite()
+    : TestSuite("trace-mobility-helper", UNIT)
+{
+    AddTestCase(new WaypointTraceConversionTestCase, TestCase::QUICK);
+    AddTestCase(new TraceMobilityHelperTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static TraceMobilityHelperTestSuite g_traceMobilityHelperTestSuite;
@@ -0,0 +1,229 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-partition-helper.h"
+
+#include "ns3/abort.h"
+#include "ns3/channel-list.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <vector>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MultithreadedPartitionHelper");
+
+/**
+ * Find the representative of a node in a union-find forest
+ * \param parent the parent of each node
+ * \param node the node
+ * \return the representative of the group of the node
+ */
+static uint32_t
+FindGroup(std::vector<uint32_t>& parent, uint32_t node)
+{
+    while (parent[node] != node)
+    {
+        parent[node] = parent[parent[node]];
+        node = parent[node];
+    }
+    return node;
+}
+
+/// A link between two nodes that is not modelled by a channel
+struct PartitionLink
+{
+    uint32_t a; ///< the id of the first node
+    uint32_t b; ///< the id of the second node
+    Time delay; ///< the fixed delay of the link
+};
+
+/**
+ * \return the links declared with MultithreadedPartitionHelper::AddLink()
+ */
+static std::vector<PartitionLink>&
+GetPartitionLinks()
+{
+    static std::vector<PartitionLink> links;
+    return links;
+}
+
+/// Forget the declared links when the simulator is destroyed
+static void
+ClearPartitionLinks()
+{
+    GetPartitionLinks().clear();
+}
+
+MultithreadedPartitionHelper::MultithreadedPartitionHelper()
+    : m_lookahead(Seconds(0)),
+      m_maxPartitions(0),
+      m_installedLookahead(Seconds(0))
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedPartitionHelper::SetLookahead(Time lookahead)
+{
+    NS_LOG_FUNCTION(this << lookahead);
+    m_lookahead = lookahead;
+}
+
+void
+MultithreadedPartitionHelper::SetMaxPartitions(uint32_t nPartitions)
+{
+    NS_LOG_FUNCTION(this << nPartitions);
+    m_maxPartitions = nPartitions;
+}
+
+void
+MultithreadedPartitionHelper::AddLink(Ptr<Node> a, Ptr<Node> b, Time delay)
+{
+    NS_LOG_FUNCTION(a << b << delay);
+    std::vector<PartitionLink>& links = GetPartitionLinks();
+    if (links.empty())
+    {
+        Simulator::ScheduleDestroy(&ClearPartitionLinks);
+    }
+    links.push_back({a->GetId(), b->GetId(), delay});
+}
+
+Time
+MultithreadedPartitionHelper::GetLookahead() const
+{
+    return m_installedLookahead;
+}
+
+uint32_t
+MultithreadedPartitionHelper::Install()
+{
+    NS_LOG_FUNCTION(this);
+    Ptr<MultithreadedSimulatorImpl> impl =
+        DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+    NS_ABORT_MSG_IF(!impl,
+                    "SimulatorImplementationType must be ns3::MultithreadedSimulatorImpl "
+                    "to partition the nodes");
+
+    // the delay of each channel, zero if unknown, and of each declared link
+    std::vector<Time> delays;
+    Time lookahead = m_lookahead;
+    for (auto it = ChannelList::Begin(); it != ChannelList::End(); ++it)
+    {
+        TimeValue delay(Seconds(0));
+        (*it)->GetAttributeFailSafe("Delay", delay);
+        delays.push_back(delay.Get());
+        if (m_lookahead.IsZero() && delay.Get().IsStrictlyPositive() &&
+            (lookahead.IsZero() || delay.Get() < lookahead))
+        {
+            lookahead = delay.Get();
+        }
+    }
+    const std::vector<PartitionLink>& links = GetPartitionLinks();
+    for (const auto& link : links)
+    {
+        if (m_lookahead.IsZero() && link.delay.IsStrictlyPositive() &&
+            (lookahead.IsZero() || link.delay < lookahead))
+        {
+            lookahead = link.delay;
+        }
+    }
+
+    // group the nodes linked by a channel or a link shorter than the lookahead
+    uint32_t nNodes = NodeList::GetNNodes();
+    std::vector<uint32_t> parent(nNodes);
+    std::iota(parent.begin(), parent.end(), 0);
+    uint32_t channelIndex = 0;
+    for (auto it = ChannelList::Begin(); it != ChannelList::End(); ++it, ++channelIndex)
+    {
+        if (!lookahead.IsZero() && delays[channelIndex] >= lookahead)
+        {
+            continue;
+        }
+        Ptr<Channel> channel = *it;
+        int64_t first = -1;
+        for (std::size_t i = 0; i < channel->GetNDevices(); i++)
+        {
+            Ptr<NetDevice> device = channel->GetDevice(i);
+            if (!device || !device->GetNode())
+            {
+                continue;
+            }
+            uint32_t group = FindGroup(parent, device->GetNode()->GetId());
+            if (first < 0)
+            {
+                first = group;
+            }
+            else
+            {
+                parent[group] = first;
+            }
+        }
+    }
+
+    for (const auto& link : links)
+    {
+        if (lookahead.IsZero() || link.delay < lookahead)
+        {
+            parent[FindGroup(parent, link.b)] = FindGroup(parent, link.a);
+        }
+    }
+
+    // distribute the groups, largest first, to the least loaded partition
+    std::map<uint32_t, std::vector<uint32_t>> groups;
+    for (uint32_t node = 0; node < nNodes; node++)
+    {
+        groups[FindGroup(parent, node)].push_back(node);
+    }
+    std::vector<const std::vector<uint32_t>*> sortedGroups;
+    for (const auto& group : groups)
+    {
+        sortedGroups.push_back(&group.second);
+    }
+    std::stable_sort(sortedGroups.begin(), sortedGroups.end(), [](const auto* a, const auto* b) {
+        return a->size() > b->size();
+    });
+    uint32_t maxPartitions = m_maxPartitions > 0 ? m_maxPartitions : impl->GetMaxThreads();
+    uint32_t nPartitions = std::max<uint32_t>(
+        1,
+        std::min<uint32_t>(maxPartitions, lookahead.IsZero() ? 1 : sortedGroups.size()));
+    std::vector<uint32_t> load(nPartitions, 0);
+    for (const auto* group : sortedGroups)
+    {
+        uint32_t partition = std::min_element(load.begin(), load.end()) - load.begin();
+        load[partition] += group->size();
+        for (uint32_t node : *group)
+        {
+            impl->SetPartition(node, partition);
+        }
+    }
+    impl->SetLookahead(lookahead);
+    m_installedLookahead = lookahead;
+    NS_LOG_INFO(nNodes << " nodes in " << groups.size() << " groups and " << nPartitions
+                       << " partitions, lookahead " << lookahead.As(Time::S));
+    return nPartitions;
+}
+
+} // namespace ns3
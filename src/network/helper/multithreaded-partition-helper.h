@@ -0,0 +1,108 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_PARTITION_HELPER_H
+#define MULTITHREADED_PARTITION_HELPER_H
+
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <cstdint>
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief Partition the nodes for the MultithreadedSimulatorImpl.
+ *
+ * The nodes attached to a channel whose delay is shorter than the
+ * lookahead, or unknown, are put in the same partition; only the
+ * channels with a "Delay" attribute (e.g., the PointToPointChannel,
+ * CsmaChannel and SimpleChannel) can link nodes of different
+ * partitions. When the lookahead is not set, it is the shortest
+ * non-zero delay of these channels. The groups of nodes are then
+ * distributed among the partitions so that the partitions have about
+ * the same number of nodes.
+ *
+ * The interactions between nodes that are not modelled by a channel
+ * must be declared with AddLink(): a link with a zero delay (e.g., the
+ * direct calls between the applications of two nodes) keeps the nodes
+ * in the same partition, while a link with a fixed delay (e.g., events
+ * scheduled with that delay in the context of the other node) is
+ * treated like a channel with that delay.
+ *
+ * Note that the wireless channels (e.g., the SpectrumChannel of LTE)
+ * have no fixed delay, so all the nodes attached to the same wireless
+ * channel always end up in the same partition.
+ *
+ * The helper must be used after the topology is built and before
+ * Simulator::Run(), with the MultithreadedSimulatorImpl selected as the
+ * SimulatorImplementationType.
+ */
+class MultithreadedPartitionHelper
+{
+  public:
+    MultithreadedPartitionHelper();
+
+    /**
+     * Set the lookahead. By default, it is derived from the channel delays.
+     *
+     * \param lookahead the lookahead
+     */
+    void SetLookahead(Time lookahead);
+
+    /**
+     * Set the maximum number of partitions. By default, it is the maximum
+     * number of threads of the simulator.
+     *
+     * \param nPartitions the maximum number of partitions
+     */
+    void SetMaxPartitions(uint32_t nPartitions);
+
+    /**
+     * Declare a link between two nodes that is not modelled by a channel.
+     * The links are kept until the simulator is destroyed.
+     *
+     * \param a the first node
+     * \param b the second node
+     * \param delay the fixed delay of the link, zero if the nodes call
+     *              each other directly
+     */
+    static void AddLink(Ptr<Node> a, Ptr<Node> b, Time delay);
+
+    /**
+     * Partition all the nodes and configure the simulator accordingly.
+     *
+     * \return the number of partitions
+     */
+    uint32_t Install();
+
+    /**
+     * \return the lookahead configured by the last call to Install()
+     */
+    Time GetLookahead() const;
+
+  private:
+    Time m_lookahead;          ///< the configured lookahead
+    uint32_t m_maxPartitions;  ///< the maximum number of partitions
+    Time m_installedLookahead; ///< the lookahead configured by Install()
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_PARTITION_HELPER_H */
@@ -18,6 +18,7 @@
  */
 #include "node-container.h"
 
+#include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/node-list.h"
 
@@ -133,4 +134,61 @@ NodeContainer::Contains(uint32_t id) const
     return false;
 }
 
+Config::MatchContainer
+NodeContainer::LookupMatches(std::string path) const
+{
+    Config::CompiledPath compiled(path);
+    std::vector<Ptr<Object>> roots;
+    std::vector<std::string> contexts;
+    roots.reserve(m_nodes.size());
+    contexts.reserve(m_nodes.size());
+    for (const auto& node : m_nodes)
+    {
+        roots.emplace_back(node);
+        contexts.push_back("/NodeList/" + std::to_string(node->GetId()));
+    }
+    return compiled.LookupMatches(roots, contexts);
+}
+
+Config::MatchContainer
+NodeContainer::LookupLeafMatches(std::string path, std::string* leaf) const
+{
+    std::string::size_type slash = path.find_last_of('/');
+    if (slash == std::string::npos)
+    {
+        // an attribute or trace source of the nodes
+        *leaf = path;
+        return LookupMatches("");
+    }
+    *leaf = path.substr(slash + 1, path.size() - (slash + 1));
+    return LookupMatches(path.substr(0, slash));
+}
+
+void
+NodeContainer::Set(std::string path, const AttributeValue& value) const
+{
+    std::string leaf;
+    LookupLeafMatches(path, &leaf).Set(leaf, value);
+}
+
+void
+NodeContainer::Connect(std::string path, const CallbackBase& cb) const
+{
+    std::string leaf;
+    if (!LookupLeafMatches(path, &leaf).ConnectFailSafe(leaf, cb))
+    {
+        NS_FATAL_ERROR("Could not connect callback to " << path);
+    }
+}
+
+void
+NodeContainer::ConnectWithoutContext(std::string path, const CallbackBase& cb) const
+{
+    std::string leaf;
+    if (!LookupLeafMatches(path, &leaf).ConnectWithoutContextFailSafe(leaf, cb))
+    {
+        NS_FATAL_ERROR("Could not connect callback to " << path);
+    }
+}
+
 } // namespace ns3
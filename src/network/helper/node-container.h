@@ -19,6 +19,7 @@
 #ifndef NODE_CONTAINER_H
 #define NODE_CONTAINER_H
 
+#include "ns3/config.h"
 #include "ns3/node.h"
 
 #include <type_traits>
@@ -269,7 +270,70 @@ class NodeContainer
      */
     bool Contains(uint32_t id) const;
 
+    /**
+     * \brief Find the objects matching a Config path relative to each
+     * node of this container.
+     *
+     * The path is parsed once and resolved from each node, without going
+     * through the NodeList, so this is much faster than resolving
+     * "/NodeList/[id]/" + \p path for each node. The objects are matched
+     * with their full paths, starting with "/NodeList/[id]/".
+     *
+     * \param path The Config path relative to the nodes, e.g.,
+     *             "DeviceList/0/$ns3::PointToPointNetDevice/TxQueue".
+     * \return The matching objects.
+     */
+    Config::MatchContainer LookupMatches(std::string path) const;
+
+    /**
+     * \brief Set an attribute of the objects matching a Config path
+     * relative to each node of this container.
+     *
+     * \param path The Config path relative to the nodes, ending
+     *             with the name of the attribute.
+     * \param value The value to set.
+     *
+     * \sa LookupMatches() and Config::Set()
+     */
+    void Set(std::string path, const AttributeValue& value) const;
+
+    /**
+     * \brief Connect a sink to the trace sources matching a Config path
+     * relative to each node of this container, as Config::Connect() does
+     * for the path "/NodeList/[id]/" + \p path of each node.
+     *
+     * \param path The Config path relative to the nodes, ending
+     *             with the name of the trace source.
+     * \param cb The sink, which receives the full path of the trace source.
+     *
+     * \sa LookupMatches()
+     */
+    void Connect(std::string path, const CallbackBase& cb) const;
+
+    /**
+     * \brief Connect a sink to the trace sources matching a Config path
+     * relative to each node of this container.
+     *
+     * \param path The Config path relative to the nodes, ending
+     *             with the name of the trace source.
+     * \param cb The sink.
+     *
+     * \sa LookupMatches() and Config::ConnectWithoutContext()
+     */
+    void ConnectWithoutContext(std::string path, const CallbackBase& cb) const;
+
   private:
+    /**
+     * Break a Config path relative to the nodes into the leading path
+     * and the last leaf token, the name of an attribute or trace source,
+     * and find the objects matching the leading path.
+     *
+     * \param path The Config path relative to the nodes.
+     * \param [out] leaf The name following the last '/' of the path.
+     * \return The objects matching the leading path.
+     */
+    Config::MatchContainer LookupLeafMatches(std::string path, std::string* leaf) const;
+
     std::vector<Ptr<Node>> m_nodes; //!< Nodes smart pointers
 };
 
@@ -21,6 +21,8 @@
 #include "ns3/assert.h"
 #include "ns3/log.h"
 
+#include <new>
+
 #define LOG_INTERNAL_STATE(y)                                                                      \
     NS_LOG_LOGIC(y << "start=" << m_start << ", end=" << m_end                                     \
                    << ", zero start=" << m_zeroAreaStart << ", zero end=" << m_zeroAreaEnd         \
@@ -54,7 +56,7 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
-uint32_t Buffer::g_recommendedStart = 0;
+NS_MTP_THREAD_LOCAL uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -79,9 +81,9 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+NS_MTP_THREAD_LOCAL uint32_t Buffer::g_maxSize = 0;
+NS_MTP_THREAD_LOCAL Buffer::FreeList* Buffer::g_freeList = nullptr;
+NS_MTP_THREAD_LOCAL Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor()
 {
@@ -124,6 +126,9 @@ Buffer::Create(uint32_t dataSize)
     if (IS_UNINITIALIZED(g_freeList))
     {
         g_freeList = new Buffer::FreeList();
+        // With NS3_MTP, this registers the destructor of the free list
+        // of the calling thread, to be run when the thread exits.
+        (void)&g_localStaticDestructor;
     }
     else if (IS_INITIALIZED(g_freeList))
     {
@@ -174,7 +179,9 @@ Buffer::Allocate(uint32_t reqSize)
     reqSize += ALLOC_OVER_PROVISION;
     uint32_t size = reqSize - 1 + sizeof(Buffer::Data);
     auto b = new uint8_t[size];
-    auto data = reinterpret_cast<Buffer::Data*>(b);
+    // the header holds atomics, so its lifetime must start before they are
+    // stored
+    auto data = new (b) Buffer::Data;
     data->m_size = reqSize;
     data->m_count = 1;
     return data;
@@ -185,6 +192,7 @@ Buffer::Deallocate(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
+    data->~Data();
     auto buf = reinterpret_cast<uint8_t*>(data);
     delete[] buf;
 }
@@ -266,8 +274,7 @@ Buffer::operator=(const Buffer& o)
     if (m_data != o.m_data)
     {
         // not assignment to self.
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Recycle(m_data);
         }
@@ -289,8 +296,7 @@ Buffer::~Buffer()
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         Recycle(m_data);
     }
@@ -310,31 +316,76 @@ Buffer::GetInternalEnd() const
     return m_end - (m_zeroAreaEnd - m_zeroAreaStart);
 }
 
+bool
+Buffer::ClaimDirtyStart(uint32_t start)
+{
+    NS_LOG_FUNCTION(this << start);
+    uint32_t newStart = m_start - start;
+    if (m_data->m_count == 1)
+    {
+        m_data->m_dirtyStart = newStart;
+        return true;
+    }
+#ifdef NS3_MTP
+    // The other Buffer instances sharing the data can be owned by other
+    // threads: only one of them can extend the dirty area from m_start.
+    uint32_t expected = m_start;
+    return m_data->m_dirtyStart.compare_exchange_strong(expected, newStart);
+#else
+    if (m_start > m_data->m_dirtyStart)
+    {
+        return false;
+    }
+    NS_ASSERT(m_start == m_data->m_dirtyStart);
+    m_data->m_dirtyStart = newStart;
+    return true;
+#endif
+}
+
+bool
+Buffer::ClaimDirtyEnd(uint32_t end)
+{
+    NS_LOG_FUNCTION(this << end);
+    uint32_t newEnd = m_end + end;
+    if (m_data->m_count == 1)
+    {
+        m_data->m_dirtyEnd = newEnd;
+        return true;
+    }
+#ifdef NS3_MTP
+    uint32_t expected = m_end;
+    return m_data->m_dirtyEnd.compare_exchange_strong(expected, newEnd);
+#else
+    if (m_end < m_data->m_dirtyEnd)
+    {
+        return false;
+    }
+    NS_ASSERT(m_end == m_data->m_dirtyEnd);
+    m_data->m_dirtyEnd = newEnd;
+    return true;
+#endif
+}
+
 void
 Buffer::AddAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
     NS_ASSERT(CheckInternalState());
-    bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
-    if (m_start >= start && !isDirty)
+    if (m_start >= start && ClaimDirtyStart(start))
     {
         /* enough space in the buffer and not dirty.
          * To add: |..|
          * Before: |*****---------***|
          * After:  |***..---------***|
          */
-        NS_ASSERT(m_data->m_count == 1 || m_start == m_data->m_dirtyStart);
         m_start -= start;
-        // update dirty area
-        m_data->m_dirtyStart = m_start;
     }
     else
     {
         uint32_t newSize = GetInternalSize() + start;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data + start, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -361,26 +412,21 @@ Buffer::AddAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
     NS_ASSERT(CheckInternalState());
-    bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
-    if (GetInternalEnd() + end <= m_data->m_size && !isDirty)
+    if (GetInternalEnd() + end <= m_data->m_size && ClaimDirtyEnd(end))
     {
         /* enough space in buffer and not dirty
          * Add:    |...|
          * Before: |**----*****|
          * After:  |**----...**|
          */
-        NS_ASSERT(m_data->m_count == 1 || m_end == m_data->m_dirtyEnd);
         m_end += end;
-        // update dirty area.
-        m_data->m_dirtyEnd = m_end;
     }
     else
     {
         uint32_t newSize = GetInternalSize() + end;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
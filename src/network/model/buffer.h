@@ -20,6 +20,7 @@
 #define BUFFER_H
 
 #include "ns3/assert.h"
+#include "ns3/multithreading.h"
 
 #include <ostream>
 #include <stdint.h>
@@ -60,6 +61,14 @@ namespace ns3
  * In every other case, the BufferData must be copied before
  * being modified.
  *
+ * When ns-3 is built with multithreaded simulation support (NS3_MTP),
+ * a BufferData can be shared by Buffer instances owned by different
+ * threads: the reference count and the boundaries of the dirty area
+ * are then atomic, and a Buffer grows the dirty area of a shared
+ * BufferData only if it wins the compare-and-swap of the boundary.
+ * The free list of BufferData and the size heuristics are private
+ * to each thread.
+ *
  * To understand the way the Buffer::Add and Buffer::Remove methods
  * work, you first need to understand the "virtual offsets" used to
  * keep track of the content of buffers. Each Buffer instance
@@ -665,7 +674,7 @@ class Buffer
          * The reference count of an instance of this data structure.
          * Each buffer which references an instance holds a count.
          */
-        uint32_t m_count;
+        MtpAtomic<uint32_t> m_count;
         /**
          * the size of the m_data field below.
          */
@@ -674,12 +683,12 @@ class Buffer
          * offset from the start of the m_data field below to the
          * start of the area in which user bytes were written.
          */
-        uint32_t m_dirtyStart;
+        MtpAtomic<uint32_t> m_dirtyStart;
         /**
          * offset from the start of the m_data field below to the
          * end of the area in which user bytes were written.
          */
-        uint32_t m_dirtyEnd;
+        MtpAtomic<uint32_t> m_dirtyEnd;
         /**
          * The real data buffer holds _at least_ one byte.
          * Its real size is stored in the m_size field.
@@ -728,6 +737,27 @@ class Buffer
      */
     uint32_t GetInternalEnd() const;
 
+    /**
+     * \brief Extend the dirty area of the buffer data over the bytes
+     * which AddAtStart is about to write in place.
+     *
+     * \param start the number of bytes added at the start of the buffer
+     * \returns true if the bytes can be written in place, false if the
+     *          dirty area was already extended by another Buffer instance
+     *          and the buffer data must be copied.
+     */
+    bool ClaimDirtyStart(uint32_t start);
+    /**
+     * \brief Extend the dirty area of the buffer data over the bytes
+     * which AddAtEnd is about to write in place.
+     *
+     * \param end the number of bytes added at the end of the buffer
+     * \returns true if the bytes can be written in place, false if the
+     *          dirty area was already extended by another Buffer instance
+     *          and the buffer data must be copied.
+     */
+    bool ClaimDirtyEnd(uint32_t end);
+
     /**
      * \brief Recycle the buffer memory
      * \param data the buffer data storage
@@ -769,7 +799,7 @@ class Buffer
      * writing data. i.e., m_start should be initialized to this
      * value.
      */
-    static uint32_t g_recommendedStart;
+    static NS_MTP_THREAD_LOCAL uint32_t g_recommendedStart;
 
     /**
      * offset to the start of the virtual zero area from the start
@@ -802,9 +832,10 @@ class Buffer
         ~LocalStaticDestructor();
     };
 
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
+    static NS_MTP_THREAD_LOCAL uint32_t g_maxSize;   //!< Max observed data size
+    static NS_MTP_THREAD_LOCAL FreeList* g_freeList; //!< Buffer data container
+    /// Local static destructor
+    static NS_MTP_THREAD_LOCAL LocalStaticDestructor g_localStaticDestructor;
 #endif
 };
 
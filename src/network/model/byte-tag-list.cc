@@ -19,6 +19,7 @@
 #include "byte-tag-list.h"
 
 #include "ns3/log.h"
+#include "ns3/multithreading.h"
 
 #include <cstring>
 #include <limits>
@@ -42,10 +43,10 @@ NS_LOG_COMPONENT_DEFINE("ByteTagList");
  */
 struct ByteTagListData
 {
-    uint32_t size;   //!< size of the data
-    uint32_t count;  //!< use counter (for smart deallocation)
-    uint32_t dirty;  //!< number of bytes actually in use
-    uint8_t data[4]; //!< data
+    uint32_t size;             //!< size of the data
+    MtpAtomic<uint32_t> count; //!< use counter (for smart deallocation)
+    uint32_t dirty;            //!< number of bytes actually in use
+    uint8_t data[4];           //!< data
 };
 
 #ifdef USE_FREE_LIST
@@ -56,13 +57,19 @@ struct ByteTagListData
  *
  * Internal use only.
  */
-static class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
+class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
 {
   public:
     ~ByteTagListDataFreeList();
-} g_freeList; //!< Container for struct ByteTagListData
+};
+
+/**
+ * Container for struct ByteTagListData. When ns-3 is built with
+ * NS3_MTP, each thread has its own free list.
+ */
+static NS_MTP_THREAD_LOCAL ByteTagListDataFreeList g_freeList;
 
-static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
+static NS_MTP_THREAD_LOCAL uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
 
 ByteTagListDataFreeList::~ByteTagListDataFreeList()
 {
@@ -200,6 +207,17 @@ ByteTagList::~ByteTagList()
     m_used = 0;
 }
 
+bool
+ByteTagList::IsSharedDirty() const
+{
+#ifdef NS3_MTP
+    // The lists sharing the data can be owned by other threads
+    return m_data->count != 1;
+#else
+    return m_data->count != 1 && m_data->dirty != m_used;
+#endif
+}
+
 TagBuffer
 ByteTagList::Add(TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
 {
@@ -211,7 +229,7 @@ ByteTagList::Add(TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
         m_data = Allocate(spaceNeeded);
         m_used = 0;
     }
-    else if (m_data->size < spaceNeeded || (m_data->count != 1 && m_data->dirty != m_used))
+    else if (m_data->size < spaceNeeded || IsSharedDirty())
     {
         ByteTagListData* newData = Allocate(spaceNeeded);
         std::memcpy(&newData->data, &m_data->data, m_used);
@@ -386,8 +404,7 @@ ByteTagList::Deallocate(ByteTagListData* data)
         return;
     }
     g_maxSize = std::max(g_maxSize, data->size);
-    data->count--;
-    if (data->count == 0)
+    if (--data->count == 0)
     {
         if (g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
         {
@@ -423,8 +440,7 @@ ByteTagList::Deallocate(ByteTagListData* data)
     {
         return;
     }
-    data->count--;
-    if (data->count == 0)
+    if (--data->count == 0)
     {
         uint8_t* buffer = (uint8_t*)data;
         delete[] buffer;
@@ -270,6 +270,17 @@ class ByteTagList
      */
     ByteTagList::Iterator BeginAll() const;
 
+    /**
+     * \brief Check if a tag cannot be appended in place to the shared data
+     *
+     * With NS3_MTP, the lists sharing the data can be owned by other
+     * threads, so the tags are appended in place only if the data is
+     * not shared.
+     *
+     * \returns true if the data must be copied before appending a tag
+     */
+    bool IsSharedDirty() const;
+
     /**
      * \brief Allocate the memory for the ByteTagListData
      * \param size the memory to allocate
@@ -36,10 +36,11 @@ NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
-bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
-uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+MtpAtomic<bool> PacketMetadata::m_metadataSkipped(false);
+NS_MTP_THREAD_LOCAL uint32_t PacketMetadata::m_maxSize = 0;
+NS_MTP_THREAD_LOCAL uint16_t PacketMetadata::m_chunkUid = 0;
+NS_MTP_THREAD_LOCAL PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+NS_MTP_THREAD_LOCAL bool PacketMetadata::m_freeListDestroyed = false;
 
 PacketMetadata::DataFreeList::~DataFreeList()
 {
@@ -48,7 +49,12 @@ PacketMetadata::DataFreeList::~DataFreeList()
     {
         PacketMetadata::Deallocate(*i);
     }
+    PacketMetadata::m_freeListDestroyed = true;
+#ifndef NS3_MTP
+    // With NS3_MTP, this is the free list of a thread which exits,
+    // while the other threads can still use the packet metadata.
     PacketMetadata::m_enable = false;
+#endif
 }
 
 void
@@ -80,8 +86,7 @@ PacketMetadata::ReserveCopy(uint32_t size)
     PacketMetadata::Data* newData = PacketMetadata::Create(m_used + size);
     memcpy(newData->m_data, m_data->m_data, m_used);
     newData->m_dirtyEnd = m_used;
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -99,13 +104,22 @@ PacketMetadata::ReserveCopy(uint32_t size)
     }
 }
 
+bool
+PacketMetadata::IsSharedDirty() const
+{
+#ifdef NS3_MTP
+    return m_data->m_count != 1;
+#else
+    return m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd;
+#endif
+}
+
 void
 PacketMetadata::Reserve(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     NS_ASSERT(m_data != nullptr);
-    if (m_data->m_size >= m_used + size &&
-        (m_head == 0xffff || m_data->m_count == 1 || m_data->m_dirtyEnd == m_used))
+    if (m_data->m_size >= m_used + size && !IsSharedDirty())
     {
         /* enough room, not dirty. */
     }
@@ -384,8 +398,7 @@ PacketMetadata::AddSmall(const PacketMetadata::SmallItem* item)
     uint32_t typeUidSize = GetUleb128Size(item->typeUid);
     uint32_t sizeSize = GetUleb128Size(item->size);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2;
-    if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+    if (m_used + n > m_data->m_size || IsSharedDirty())
     {
         ReserveCopy(n);
     }
@@ -421,8 +434,7 @@ PacketMetadata::AddBig(uint32_t next,
     uint32_t fragEndSize = GetUleb128Size(extraItem->fragmentEnd);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
 
-    if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+    if (m_used + n > m_data->m_size || IsSharedDirty())
     {
         ReserveCopy(n);
     }
@@ -593,7 +605,7 @@ void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    if (!m_enable)
+    if (!m_enable || m_freeListDestroyed)
     {
         PacketMetadata::Deallocate(data);
         return;
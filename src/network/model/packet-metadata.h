@@ -23,6 +23,7 @@
 
 #include "ns3/assert.h"
 #include "ns3/callback.h"
+#include "ns3/multithreading.h"
 #include "ns3/type-id.h"
 
 #include <limits>
@@ -426,7 +427,7 @@ class PacketMetadata
     struct Data
     {
         /** number of references to this struct Data instance. */
-        uint32_t m_count;
+        MtpAtomic<uint32_t> m_count;
         /** size (in bytes) of m_data buffer below */
         uint16_t m_size;
         /** max of the m_used field over all objects which reference this struct Data instance */
@@ -606,6 +607,18 @@ class PacketMetadata
      * \param n space to reserve
      */
     inline void Reserve(uint32_t n);
+    /**
+     * \brief Check if new items cannot be appended in place to the data
+     *
+     * The items can be appended in place if the data is not shared
+     * or if no other instance sharing the data has appended items.
+     * When ns-3 is built with multithreaded simulation support (NS3_MTP),
+     * the instances sharing the data can be owned by other threads, so
+     * the items are appended in place only if the data is not shared.
+     *
+     * \returns true if the data must be copied before appending items
+     */
+    inline bool IsSharedDirty() const;
     /**
      * \brief Reserve space and make a metadata copy
      * \param n space to reserve
@@ -675,19 +688,25 @@ class PacketMetadata
      */
     static void Deallocate(PacketMetadata::Data* data);
 
-    static DataFreeList m_freeList; //!< the metadata data storage
-    static bool m_enable;           //!< Enable the packet metadata
-    static bool m_enableChecking;   //!< Enable the packet metadata checking
+    /**
+     * The metadata data storage. When ns-3 is built with NS3_MTP,
+     * each thread has its own free list.
+     */
+    static NS_MTP_THREAD_LOCAL DataFreeList m_freeList;
+    /// Set to true once m_freeList has been destroyed
+    static NS_MTP_THREAD_LOCAL bool m_freeListDestroyed;
+    static bool m_enable;         //!< Enable the packet metadata
+    static bool m_enableChecking; //!< Enable the packet metadata checking
 
     /**
      * Set to true when adding metadata to a packet is skipped because
      * m_enable is false; used to detect enabling of metadata in the
      * middle of a simulation, which isn't allowed.
      */
-    static bool m_metadataSkipped;
+    static MtpAtomic<bool> m_metadataSkipped;
 
-    static uint32_t m_maxSize;  //!< maximum metadata size
-    static uint16_t m_chunkUid; //!< Chunk Uid
+    static NS_MTP_THREAD_LOCAL uint32_t m_maxSize;  //!< maximum metadata size
+    static NS_MTP_THREAD_LOCAL uint16_t m_chunkUid; //!< Chunk Uid
 
     Data* m_data; //!< Metadata storage
     /*
@@ -739,8 +758,7 @@ PacketMetadata::operator=(const PacketMetadata& o)
     {
         // not self assignment
         NS_ASSERT(m_data != nullptr);
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             PacketMetadata::Recycle(m_data);
         }
@@ -758,8 +776,7 @@ PacketMetadata::operator=(const PacketMetadata& o)
 PacketMetadata::~PacketMetadata()
 {
     NS_ASSERT(m_data != nullptr);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
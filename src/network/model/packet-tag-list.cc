@@ -52,6 +52,23 @@ PacketTagList::CreateTagData(size_t dataSize)
     return tag;
 }
 
+void
+PacketTagList::CopyTags(const PacketTagList& o)
+{
+    NS_LOG_FUNCTION(this << &o);
+    TagData** prevNext = &m_next;
+    for (TagData* cur = o.m_next; cur != nullptr; cur = cur->next)
+    {
+        TagData* copy = CreateTagData(cur->size);
+        copy->tid = cur->tid;
+        copy->count = 1;
+        memcpy(copy->data, cur->data, cur->size);
+        *prevNext = copy;
+        prevNext = &copy->next;
+    }
+    *prevNext = nullptr;
+}
+
 bool
 PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 {
@@ -120,6 +120,13 @@ class Tag;
  *       The portion of the list between the first branch and the target is
  *       shared. This portion is copied before the #Remove or #Replace is
  *       performed.
+ *
+ * When ns-3 is built with multithreaded simulation support (NS3_MTP),
+ * the copies of a packet can be modified by different threads, so the
+ * copy constructor and the assignment copy the whole list instead of
+ * sharing it, and the tree is never branched. The lists are short, and
+ * the TagData are allocated with \c std::malloc, which already has
+ * per-thread arenas.
  */
 class PacketTagList
 {
@@ -252,6 +259,13 @@ class PacketTagList
      * \returns The newly constructed TagData object.
      */
     static TagData* CreateTagData(size_t dataSize);
+    /**
+     * Replace the list by a copy of the TagData of another list,
+     * which does not share any TagData with it.
+     *
+     * \param [in] o The PacketTagList to copy.
+     */
+    void CopyTags(const PacketTagList& o);
 
     /**
      * Typedef of method function pointer for copy-on-write operations
@@ -324,10 +338,14 @@ PacketTagList::PacketTagList()
 PacketTagList::PacketTagList(const PacketTagList& o)
     : m_next(o.m_next)
 {
+#ifdef NS3_MTP
+    CopyTags(o);
+#else
     if (m_next != nullptr)
     {
         m_next->count++;
     }
+#endif
 }
 
 PacketTagList&
@@ -339,11 +357,15 @@ PacketTagList::operator=(const PacketTagList& o)
         return *this;
     }
     RemoveAll();
+#ifdef NS3_MTP
+    CopyTags(o);
+#else
     m_next = o.m_next;
     if (m_next != nullptr)
     {
         m_next->count++;
     }
+#endif
     return *this;
 }
 
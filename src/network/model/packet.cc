@@ -20,6 +20,7 @@
 
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/multithreaded-simulator-impl.h"
 #include "ns3/simulator.h"
 
 #include <cstdarg>
@@ -30,7 +31,7 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
-uint32_t Packet::m_globalUid = 0;
+MtpAtomic<uint32_t> Packet::m_globalUid(0);
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -136,20 +137,34 @@ Packet::Copy() const
     return Ptr<Packet>(new Packet(*this), false);
 }
 
+uint64_t
+Packet::AllocateUid()
+{
+#ifdef NS3_MTP
+    // The packets created by the partitions of a multithreaded simulation
+    // are numbered by partition, independently of the other threads.
+    uint64_t uid;
+    if (MultithreadedSimulatorImpl::AllocatePartitionUid(uid))
+    {
+        return uid;
+    }
+#endif
+    /* The upper 32 bits of the packet id in
+     * metadata is for the system id. For non-
+     * distributed simulations, this is simply
+     * zero.  The lower 32 bits are for the
+     * global UID
+     */
+    return static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++;
+}
+
 Packet::Packet()
     : m_buffer(),
       m_byteTagList(),
       m_packetTagList(),
-      /* The upper 32 bits of the packet id in
-       * metadata is for the system id. For non-
-       * distributed simulations, this is simply
-       * zero.  The lower 32 bits are for the
-       * global UID
-       */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
+      m_metadata(AllocateUid(), 0),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
@@ -180,16 +195,9 @@ Packet::Packet(uint32_t size)
     : m_buffer(size),
       m_byteTagList(),
       m_packetTagList(),
-      /* The upper 32 bits of the packet id in
-       * metadata is for the system id. For non-
-       * distributed simulations, this is simply
-       * zero.  The lower 32 bits are for the
-       * global UID
-       */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
@@ -207,16 +215,9 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
     : m_buffer(),
       m_byteTagList(),
       m_packetTagList(),
-      /* The upper 32 bits of the packet id in
-       * metadata is for the system id. For non-
-       * distributed simulations, this is simply
-       * zero.  The lower 32 bits are for the
-       * global UID
-       */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
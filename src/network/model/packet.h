@@ -787,6 +787,18 @@ class Packet : public SimpleRefCount<Packet>
      */
     uint32_t Deserialize(const uint8_t* buffer, uint32_t size);
 
+    /**
+     * \brief Allocate the uid of a new packet.
+     *
+     * When ns-3 is built with multithreaded simulation support (NS3_MTP),
+     * the packets created by the events of a partition of the
+     * MultithreadedSimulatorImpl get their uid from the counter of the
+     * partition, so that the uids do not depend on the number of threads.
+     *
+     * \returns the packet uid.
+     */
+    static uint64_t AllocateUid();
+
     Buffer m_buffer;               //!< the packet buffer (it's actual contents)
     ByteTagList m_byteTagList;     //!< the ByteTag list
     PacketTagList m_packetTagList; //!< the packet's Tag list
@@ -795,7 +807,7 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-    static uint32_t m_globalUid; //!< Global counter of packets Uid
+    static MtpAtomic<uint32_t> m_globalUid; //!< Global counter of packets Uid
 };
 
 /**
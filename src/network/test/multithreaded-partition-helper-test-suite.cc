@@ -0,0 +1,183 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/config.h"
+#include "ns3/multithreaded-partition-helper.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check the partitions and the lookahead computed by the
+ * MultithreadedPartitionHelper from the channels and the declared links.
+ *
+ * The six nodes are linked as follows:
+ * - nodes 0 and 1, and nodes 1 and 2, by channels with a 10 ms delay;
+ * - nodes 3 and 4 by a channel without delay;
+ * - nodes 2 and 5 by a declared link without delay;
+ * - nodes 0 and 3 by a declared link with a 4 ms delay.
+ *
+ * With the derived lookahead (4 ms), the nodes are split in the four
+ * groups {0}, {1}, {2, 5} and {3, 4}, each in its own partition. With a
+ * 20 ms lookahead, all the nodes are in the same partition.
+ */
+class MultithreadedPartitionHelperTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * \param lookahead the lookahead given to the helper, zero to derive it
+     */
+    MultithreadedPartitionHelperTestCase(Time lookahead);
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Attach two nodes to a new SimpleChannel
+     * \param a the first node
+     * \param b the second node
+     * \param delay the delay of the channel
+     */
+    static void Connect(Ptr<Node> a, Ptr<Node> b, Time delay);
+
+    Time m_lookahead; //!< the lookahead given to the helper
+};
+
+MultithreadedPartitionHelperTestCase::MultithreadedPartitionHelperTestCase(Time lookahead)
+    : TestCase("Partitions with lookahead " +
+               (lookahead.IsZero() ? std::string("derived")
+                                   : std::to_string(lookahead.GetMilliSeconds()) + " ms")),
+      m_lookahead(lookahead)
+{
+}
+
+void
+MultithreadedPartitionHelperTestCase::Connect(Ptr<Node> a, Ptr<Node> b, Time delay)
+{
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    channel->SetAttribute("Delay", TimeValue(delay));
+    for (const auto& node : {a, b})
+    {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        device->SetChannel(channel);
+        node->AddDevice(device);
+    }
+}
+
+void
+MultithreadedPartitionHelperTestCase::DoRun()
+{
+    // start from an empty node list and a new simulator implementation
+    Simulator::Destroy();
+    Config::SetGlobal("SimulatorImplementationType",
+                      StringValue("ns3::MultithreadedSimulatorImpl"));
+    Ptr<MultithreadedSimulatorImpl> impl =
+        DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_ASSERT_MSG_NE(impl, nullptr, "Wrong simulator implementation");
+
+    NodeContainer nodes;
+    nodes.Create(6);
+    Connect(nodes.Get(0), nodes.Get(1), MilliSeconds(10));
+    Connect(nodes.Get(1), nodes.Get(2), MilliSeconds(10));
+    Connect(nodes.Get(3), nodes.Get(4), Seconds(0));
+    MultithreadedPartitionHelper::AddLink(nodes.Get(2), nodes.Get(5), Seconds(0));
+    MultithreadedPartitionHelper::AddLink(nodes.Get(0), nodes.Get(3), MilliSeconds(4));
+
+    MultithreadedPartitionHelper partitionHelper;
+    partitionHelper.SetMaxPartitions(4);
+    if (!m_lookahead.IsZero())
+    {
+        partitionHelper.SetLookahead(m_lookahead);
+    }
+    uint32_t nPartitions = partitionHelper.Install();
+
+    std::vector<uint32_t> partitions;
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        partitions.push_back(impl->GetPartition(nodes.Get(i)->GetId()));
+    }
+    Time lookahead = impl->GetLookahead();
+    Time helperLookahead = partitionHelper.GetLookahead();
+    NS_TEST_EXPECT_MSG_EQ(helperLookahead, lookahead, "Wrong lookahead of the helper");
+
+    if (m_lookahead.IsZero())
+    {
+        NS_TEST_EXPECT_MSG_EQ(lookahead, MilliSeconds(4), "Wrong derived lookahead");
+        NS_TEST_EXPECT_MSG_EQ(nPartitions, 4, "Wrong number of partitions");
+        NS_TEST_EXPECT_MSG_EQ(partitions[2], partitions[5], "Nodes 2 and 5 must not be split");
+        NS_TEST_EXPECT_MSG_EQ(partitions[3], partitions[4], "Nodes 3 and 4 must not be split");
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            for (uint32_t j = i + 1; j < 4; j++)
+            {
+                NS_TEST_EXPECT_MSG_NE(partitions[i],
+                                      partitions[j],
+                                      "Nodes " << i << " and " << j << " must be split");
+            }
+        }
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_EQ(lookahead, m_lookahead, "Wrong lookahead");
+        NS_TEST_EXPECT_MSG_EQ(nPartitions, 1, "Wrong number of partitions");
+        for (uint32_t i = 1; i < nodes.GetN(); i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(partitions[i], partitions[0], "Node " << i << " is split");
+        }
+    }
+
+    Simulator::Destroy();
+}
+
+void
+MultithreadedPartitionHelperTestCase::DoTeardown()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief The MultithreadedPartitionHelper TestSuite.
+ */
+class MultithreadedPartitionHelperTestSuite : public TestSuite
+{
+  public:
+    MultithreadedPartitionHelperTestSuite()
+        : TestSuite("multithreaded-partition-helper", UNIT)
+    {
+        AddTestCase(new MultithreadedPartitionHelperTestCase(Seconds(0)), TestCase::QUICK);
+        AddTestCase(new MultithreadedPartitionHelperTestCase(MilliSeconds(20)), TestCase::QUICK);
+    }
+};
+
+/// Static variable for test initialization.
+static MultithreadedPartitionHelperTestSuite g_multithreadedPartitionHelperTestSuite;
@@ -16,15 +16,22 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/config.h"
+#include "ns3/multithreaded-simulator-impl.h"
 #include "ns3/packet-tag-list.h"
 #include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <cstdarg>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
 #include <limits> // std:numeric_limits
+#include <set>
 #include <string>
 
 using namespace ns3;
@@ -1264,6 +1271,154 @@ PacketTagListTest::DoRun()
 } // Timing
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Packet uids in a multithreaded simulation.
+ *
+ * The nodes of four partitions create packets and send copies of them
+ * to each other, while modifying their own copy. The uids of the packets
+ * must be unique and must not depend on the number of threads.
+ */
+class PacketUidTest : public TestCase
+{
+  public:
+    PacketUidTest();
+
+  private:
+    void DoRun() override;
+    /**
+     * Run the scenario.
+     *
+     * \param threads The maximum number of threads.
+     * \return The uids of the packets created and received by each context.
+     */
+    std::vector<std::vector<uint64_t>> RunScenario(uint32_t threads);
+    /**
+     * Create a packet and send a copy of it to the next context.
+     *
+     * \param context The context.
+     * \param count The number of packets already created by the context.
+     */
+    void Send(uint32_t context, uint32_t count);
+    /**
+     * Receive a packet.
+     *
+     * \param context The context.
+     * \param packet The packet.
+     */
+    void Receive(uint32_t context, Ptr<Packet> packet);
+
+    static constexpr uint32_t N_CONTEXTS = 4; //!< Number of contexts.
+
+    /// The uids of the packets created and received by each context
+    std::vector<std::vector<uint64_t>> m_uids;
+};
+
+PacketUidTest::PacketUidTest()
+    : TestCase("Check the packet uids in a multithreaded simulation")
+{
+}
+
+void
+PacketUidTest::Send(uint32_t context, uint32_t count)
+{
+    Ptr<Packet> packet = Create<Packet>(100);
+    m_uids[context].push_back(packet->GetUid());
+    uint32_t peer = (context + 1) % N_CONTEXTS;
+    Simulator::ScheduleWithContext(peer,
+                                   MilliSeconds(1),
+                                   &PacketUidTest::Receive,
+                                   this,
+                                   peer,
+                                   packet->Copy());
+    // modify the copy kept by the sender while the receiver uses the other one
+    ATestTag<1> tag;
+    packet->AddByteTag(tag);
+    packet->AddAtEnd(Create<Packet>(10));
+    if (count < 50)
+    {
+        Simulator::Schedule(MicroSeconds(100), &PacketUidTest::Send, this, context, count + 1);
+    }
+}
+
+void
+PacketUidTest::Receive(uint32_t context, Ptr<Packet> packet)
+{
+    m_uids[context].push_back(packet->GetUid());
+    ATestTag<2> tag;
+    packet->AddByteTag(tag);
+    packet->AddAtEnd(Create<Packet>(10));
+    m_uids[context].push_back(packet->CreateFragment(0, 50)->GetUid());
+}
+
+std::vector<std::vector<uint64_t>>
+PacketUidTest::RunScenario(uint32_t threads)
+{
+    Config::SetGlobal("SimulatorImplementationType",
+                      StringValue("ns3::MultithreadedSimulatorImpl"));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue(threads));
+    m_uids.assign(N_CONTEXTS, {});
+
+    Ptr<MultithreadedSimulatorImpl> impl =
+        DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+    for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+        impl->SetPartition(context, context);
+        Simulator::ScheduleWithContext(context,
+                                       MicroSeconds(10 * context),
+                                       &PacketUidTest::Send,
+                                       this,
+                                       context,
+                                       0);
+    }
+    impl->SetLookahead(MilliSeconds(1));
+    Simulator::Run();
+    Simulator::Destroy();
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+
+    // Without NS3_MTP, the uids come from the global counter, which is not
+    // reset between the runs: compare the uids relative to the first one
+    uint64_t first = std::numeric_limits<uint64_t>::max();
+    for (const auto& uids : m_uids)
+    {
+        first = std::min(first, *std::min_element(uids.begin(), uids.end()));
+    }
+    for (auto& uids : m_uids)
+    {
+        for (auto& uid : uids)
+        {
+            uid -= first;
+        }
+    }
+    return m_uids;
+}
+
+void
+PacketUidTest::DoRun()
+{
+    auto expected = RunScenario(1);
+    auto uids = RunScenario(4);
+
+    std::set<uint64_t> distinct;
+    for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(uids[context].size(),
+                              expected[context].size(),
+                              "Wrong number of packets in context " << context);
+        for (std::size_t i = 0; i < uids[context].size(); i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(uids[context][i],
+                                  expected[context][i],
+                                  "Wrong uid of packet " << i << " in context " << context);
+        }
+        distinct.insert(uids[context].begin(), uids[context].end());
+    }
+    // the received packets and their fragments have the uid of a packet created by Send()
+    NS_TEST_EXPECT_MSG_EQ(distinct.size(), N_CONTEXTS * 51, "The packet uids are not unique");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1281,6 +1436,7 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::QUICK);
+    AddTestCase(new PacketUidTest, TestCase::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
@@ -23,10 +23,13 @@
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
+#include "ns3/rectangle.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
@@ -330,12 +333,28 @@ ThreeGppChannelConditionModel::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(
                               &ThreeGppChannelConditionModel::m_linkO2iConditionToAntennaHeight),
-                          MakeBooleanChecker());
+                          MakeBooleanChecker())
+            .AddAttribute("LosCorrelationDistance",
+                          "If positive, the LOS conditions of the links of a site are spatially "
+                          "consistent: they are drawn from a random field of the site, which is "
+                          "correlated over this distance (m), at the position of the other end "
+                          "of the links. Otherwise, they are drawn independently.",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(
+                              &ThreeGppChannelConditionModel::m_losCorrelationDistance),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("LosFieldBounds",
+                          "The area covered by the correlated random fields of the sites. The "
+                          "positions out of the area take the value of the closest border.",
+                          RectangleValue(Rectangle(-1000, 1000, -1000, 1000)),
+                          MakeRectangleAccessor(&ThreeGppChannelConditionModel::m_losFieldBounds),
+                          MakeRectangleChecker());
     return tid;
 }
 
 ThreeGppChannelConditionModel::ThreeGppChannelConditionModel()
-    : ChannelConditionModel()
+    : ChannelConditionModel(),
+      m_losCorrelationDistance(0)
 {
     m_uniformVar = CreateObject<UniformRandomVariable>();
     m_uniformVar->SetAttribute("Min", DoubleValue(0));
@@ -352,7 +371,10 @@ ThreeGppChannelConditionModel::~ThreeGppChannelConditionModel()
 void
 ThreeGppChannelConditionModel::DoDispose()
 {
-    m_channelConditionMap.clear();
+    m_conditions.clear();
+    m_sharedConditions.fill(nullptr);
+    m_losFields.clear();
+    m_firstHeights.clear();
     m_updatePeriod = Seconds(0.0);
 }
 
@@ -360,49 +382,41 @@ Ptr<ChannelCondition>
 ThreeGppChannelConditionModel::GetChannelCondition(Ptr<const MobilityModel> a,
                                                    Ptr<const MobilityModel> b) const
 {
-    Ptr<ChannelCondition> cond;
-
-    // get the key for this channel
-    uint32_t key = GetKey(a, b);
-
-    bool notFound = false; // indicates if the channel condition is not present in the map
-    bool update = false;   // indicates if the channel condition has to be updated
-
-    // look for the channel condition in m_channelConditionMap
-    auto mapItem = m_channelConditionMap.find(key);
-    if (mapItem != m_channelConditionMap.end())
+    // get the entry of this channel, in the row of its site
+    auto [site, other] = GetSite(a, b);
+    uint32_t siteId = site->GetObject<Node>()->GetId();
+    uint32_t otherId = other->GetObject<Node>()->GetId();
+    if (m_conditions.size() <= siteId)
     {
-        NS_LOG_DEBUG("found the channel condition in the map");
-        cond = mapItem->second.m_condition;
-
-        // check if it has to be updated
-        if (!m_updatePeriod.IsZero() &&
-            Simulator::Now() - mapItem->second.m_generatedTime > m_updatePeriod)
-        {
-            NS_LOG_DEBUG("it has to be updated");
-            update = true;
-        }
+        m_conditions.resize(siteId + 1);
     }
-    else
+    std::vector<Entry>& row = m_conditions[siteId];
+    if (row.size() <= otherId)
     {
-        NS_LOG_DEBUG("channel condition not found");
-        notFound = true;
+        row.resize(otherId + 1);
     }
+    Entry& entry = row[otherId];
 
-    // if the channel condition was not found or if it has to be updated
-    // generate a new channel condition
-    if (notFound || update)
+    // generate a new channel condition if the channel condition was not
+    // found or if it has to be updated
+    if (entry.m_condition == 0)
     {
-        cond = ComputeChannelCondition(a, b);
-        // store the channel condition in m_channelConditionMap, used as cache.
-        // For this reason you see a const_cast.
-        Item mapItem;
-        mapItem.m_condition = cond;
-        mapItem.m_generatedTime = Simulator::Now();
-        const_cast<ThreeGppChannelConditionModel*>(this)->m_channelConditionMap[key] = mapItem;
+        NS_LOG_DEBUG("channel condition not found");
     }
-
-    return cond;
+    else if (!m_updatePeriod.IsZero() &&
+             Simulator::Now() - TimeStep(entry.m_generatedTime) > m_updatePeriod)
+    {
+        NS_LOG_DEBUG("it has to be updated");
+    }
+    else
+    {
+        NS_LOG_DEBUG("found the channel condition in the table");
+        return Unpack(entry.m_condition);
+    }
+    Ptr<ChannelCondition> cond = ComputeChannelCondition(a, b);
+    entry.m_condition = Pack(cond);
+    entry.m_generatedTime = Simulator::Now().GetTimeStep();
+    return Unpack(entry.m_condition);
 }
 
 ChannelCondition::O2iConditionValue
@@ -448,8 +462,18 @@ ThreeGppChannelConditionModel::ComputeChannelCondition(Ptr<const MobilityModel>
     double pLos = ComputePlos(a, b);
     double pNlos = ComputePnlos(a, b);
 
-    // draw a random value
-    double pRef = m_uniformVar->GetValue();
+    // draw a random value, spatially consistent if the LOS conditions are
+    // correlated
+    double pRef;
+    if (m_losCorrelationDistance > 0)
+    {
+        auto [site, other] = GetSite(a, b);
+        pRef = GetCorrelatedUniform(site, other);
+    }
+    else
+    {
+        pRef = m_uniformVar->GetValue();
+    }
 
     NS_LOG_DEBUG("pRef " << pRef << " pLos " << pLos << " pNlos " << pNlos);
 
@@ -523,18 +547,108 @@ ThreeGppChannelConditionModel::Calculate2dDistance(const Vector& a, const Vector
     return distance2D;
 }
 
-uint32_t
-ThreeGppChannelConditionModel::GetKey(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b)
+double
+ThreeGppChannelConditionModel::GetFirstHeight(Ptr<const MobilityModel> mobility) const
 {
-    // use the nodes ids to obtain a unique key for the channel between a and b
-    // sort the nodes ids so that the key is reciprocal
-    uint32_t x1 = std::min(a->GetObject<Node>()->GetId(), b->GetObject<Node>()->GetId());
-    uint32_t x2 = std::max(a->GetObject<Node>()->GetId(), b->GetObject<Node>()->GetId());
+    uint32_t id = mobility->GetObject<Node>()->GetId();
+    if (m_firstHeights.size() <= id)
+    {
+        m_firstHeights.resize(id + 1, std::numeric_limits<double>::quiet_NaN());
+    }
+    if (std::isnan(m_firstHeights[id]))
+    {
+        m_firstHeights[id] = mobility->GetPosition().z;
+    }
+    return m_firstHeights[id];
+}
+
+std::pair<Ptr<const MobilityModel>, Ptr<const MobilityModel>>
+ThreeGppChannelConditionModel::GetSite(Ptr<const MobilityModel> a,
+                                       Ptr<const MobilityModel> b) const
+{
+    // the order is reciprocal, so that the links have a single entry, and
+    // does not depend on the current heights, so that it is kept
+    double aHeight = GetFirstHeight(a);
+    double bHeight = GetFirstHeight(b);
+    if (aHeight > bHeight ||
+        (aHeight == bHeight && a->GetObject<Node>()->GetId() < b->GetObject<Node>()->GetId()))
+    {
+        return {a, b};
+    }
+    return {b, a};
+}
 
-    // use the cantor function to obtain the key
-    uint32_t key = (((x1 + x2) * (x1 + x2 + 1)) / 2) + x2;
+double
+ThreeGppChannelConditionModel::GetCorrelatedUniform(Ptr<const MobilityModel> site,
+                                                    Ptr<const MobilityModel> other) const
+{
+    NS_LOG_FUNCTION(this << site << other);
+    // the Gaussian field is drawn at the points of a grid of the correlation
+    // distance, one point beyond the bounds, and interpolated bilinearly
+    // between them, for the spatially consistent LOS states of 3GPP TR 38.901,
+    // Sec. 7.6.3.3
+    auto nX = static_cast<uint32_t>(std::ceil((m_losFieldBounds.xMax - m_losFieldBounds.xMin) /
+                                              m_losCorrelationDistance)) +
+              2;
+    auto nY = static_cast<uint32_t>(std::ceil((m_losFieldBounds.yMax - m_losFieldBounds.yMin) /
+                                              m_losCorrelationDistance)) +
+              2;
+    std::vector<double>& field = m_losFields[site->GetObject<Node>()->GetId()];
+    if (field.empty())
+    {
+        // Box-Muller, from the uniform random variable of the LOS conditions
+        field.resize(static_cast<std::size_t>(nX) * nY);
+        for (std::size_t k = 0; k < field.size(); k += 2)
+        {
+            double radius = std::sqrt(-2 * std::log(1 - m_uniformVar->GetValue()));
+            double angle = 2 * M_PI * m_uniformVar->GetValue();
+            field[k] = radius * std::cos(angle);
+            if (k + 1 < field.size())
+            {
+                field[k + 1] = radius * std::sin(angle);
+            }
+        }
+    }
+    Vector position = other->GetPosition();
+    double u = (position.x - m_losFieldBounds.xMin) / m_losCorrelationDistance;
+    double v = (position.y - m_losFieldBounds.yMin) / m_losCorrelationDistance;
+    uint32_t i = std::min(static_cast<uint32_t>(std::max(u, 0.0)), nX - 2);
+    uint32_t j = std::min(static_cast<uint32_t>(std::max(v, 0.0)), nY - 2);
+    double fu = std::clamp(u - i, 0.0, 1.0);
+    double fv = std::clamp(v - j, 0.0, 1.0);
+    const double* values = field.data() + static_cast<std::size_t>(j) * nX + i;
+    const double* nextValues = values + nX;
+    double w[4] = {(1 - fu) * (1 - fv), fu * (1 - fv), (1 - fu) * fv, fu * fv};
+    double value =
+        w[0] * values[0] + w[1] * values[1] + w[2] * nextValues[0] + w[3] * nextValues[1];
+    // the interpolation of independent values has a lower variance
+    double norm = std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2] + w[3] * w[3]);
+    // the uniform value of the standard normal value
+    return 0.5 * std::erfc(-value / norm / M_SQRT2);
+}
+
+uint8_t
+ThreeGppChannelConditionModel::Pack(Ptr<const ChannelCondition> cond)
+{
+    // 2 bits per value, and a bit to tell the packed conditions from the
+    // empty entries
+    return 0x40 | static_cast<uint8_t>(cond->GetLosCondition()) |
+           static_cast<uint8_t>(cond->GetO2iCondition()) << 2 |
+           static_cast<uint8_t>(cond->GetO2iLowHighCondition()) << 4;
+}
 
-    return key;
+Ptr<ChannelCondition>
+ThreeGppChannelConditionModel::Unpack(uint8_t packed) const
+{
+    Ptr<ChannelCondition>& cond = m_sharedConditions[packed & 0x3f];
+    if (!cond)
+    {
+        cond = CreateObject<ChannelCondition>(
+            static_cast<ChannelCondition::LosConditionValue>(packed & 0x3),
+            static_cast<ChannelCondition::O2iConditionValue>(packed >> 2 & 0x3),
+            static_cast<ChannelCondition::O2iLowHighConditionValue>(packed >> 4 & 0x3));
+    }
+    return cond;
 }
 
 // ------------------------------------------------------------------------- //
@@ -22,9 +22,13 @@
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/rectangle.h"
 #include "ns3/vector.h"
 
+#include <array>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -259,6 +263,10 @@ class ChannelConditionModel : public Object
     /**
      * Computes the condition of the channel between a and b
      *
+     * The returned object may be shared by several links, as with the
+     * ThreeGppChannelConditionModel, so it must not be modified through its
+     * setters: doing so would change the condition of all these links.
+     *
      * \param a mobility model
      * \param b mobility model
      * \return the condition of the channel between a and b
@@ -465,6 +473,13 @@ class ThreeGppChannelConditionModel : public ChannelConditionModel
      * ComputeChannelCondition and stores it in a local cache, that will be updated
      * following the "UpdatePeriod" parameter.
      *
+     * The cache is a table of one packed condition and one time per link,
+     * with a row per site, the end of the links which was the higher when
+     * first seen, indexed by the node id of the other end. The returned
+     * conditions are interned: a single object is shared by all the links
+     * in the same condition. They must not be modified, since calling one of
+     * their setters would silently change the condition of all these links.
+     *
      * \param a mobility model
      * \param b mobility model
      * \return the condition of the channel between a and b
@@ -548,25 +563,69 @@ class ThreeGppChannelConditionModel : public ChannelConditionModel
     virtual double ComputePnlos(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b) const;
 
     /**
-     * \brief Returns a unique and reciprocal key for the channel between a and b.
+     * \brief Order the ends of a link, the site first. The site is the end
+     * that was higher when the model first saw each end, or the end with the
+     * smaller node id at the same height, so that the site of a link never
+     * changes when its ends move.
      * \param a tx mobility model
      * \param b rx mobility model
-     * \return channel key
+     * \return the site and the other end of the link
+     */
+    std::pair<Ptr<const MobilityModel>, Ptr<const MobilityModel>> GetSite(
+        Ptr<const MobilityModel> a,
+        Ptr<const MobilityModel> b) const;
+
+    /**
+     * \brief Get the height of a node when the model first saw it.
+     * \param mobility the mobility model of the node
+     * \return the first height of the node
+     */
+    double GetFirstHeight(Ptr<const MobilityModel> mobility) const;
+
+    /**
+     * \brief Draw the uniform random value compared to the LOS probability,
+     * from the correlated random field of the site of the link.
+     * \param site the mobility model of the site
+     * \param other the mobility model of the other end
+     * \return a uniform random value in [0, 1]
+     */
+    double GetCorrelatedUniform(Ptr<const MobilityModel> site,
+                                Ptr<const MobilityModel> other) const;
+
+    /**
+     * \brief Pack a channel condition in a byte.
+     * \param cond the channel condition
+     * \return the packed condition, which is never 0
+     */
+    static uint8_t Pack(Ptr<const ChannelCondition> cond);
+
+    /**
+     * \brief Get the shared channel condition of a packed condition.
+     * \param packed the packed condition
+     * \return the channel condition
      */
-    static uint32_t GetKey(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b);
+    Ptr<ChannelCondition> Unpack(uint8_t packed) const;
 
     /**
-     * Struct to store the channel condition in the m_channelConditionMap
+     * Struct to store the channel condition of a link in m_conditions
      */
-    struct Item
+    struct Entry
     {
-        Ptr<ChannelCondition> m_condition; //!< the channel condition
-        Time m_generatedTime;              //!< the time when the condition was generated
+        int64_t m_generatedTime{0}; //!< the time when the condition was generated, in time steps
+        uint8_t m_condition{0};     //!< the packed condition, or 0 if not generated yet
     };
 
-    std::unordered_map<uint32_t, Item>
-        m_channelConditionMap; //!< map to store the channel conditions
-    Time m_updatePeriod;       //!< the update period for the channel condition
+    /// the conditions of the links, by node id of the site, then of the other end
+    mutable std::vector<std::vector<Entry>> m_conditions;
+    /// the channel conditions shared by the links, by packed condition
+    mutable std::array<Ptr<ChannelCondition>, 64> m_sharedConditions;
+    /// the correlated random fields of the sites, by node id of the site
+    mutable std::unordered_map<uint32_t, std::vector<double>> m_losFields;
+    /// the heights of the nodes when first seen, by node id, or NaN if not seen yet
+    mutable std::vector<double> m_firstHeights;
+    Time m_updatePeriod;             //!< the update period for the channel condition
+    double m_losCorrelationDistance; //!< the correlation distance of the LOS conditions
+    Rectangle m_losFieldBounds;      //!< the bounds of the correlated random fields
 
     double m_o2iThreshold{
         0}; //!< the threshold for determining what is the ratio of channels with O2I
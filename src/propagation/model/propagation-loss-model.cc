@@ -28,6 +28,7 @@
 #include "ns3/mobility-model.h"
 #include "ns3/pointer.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 #include <cmath>
 
@@ -44,12 +45,43 @@ TypeId
 PropagationLossModel::GetTypeId()
 {
     static TypeId tid =
-        TypeId("ns3::PropagationLossModel").SetParent<Object>().SetGroupName("Propagation");
+        TypeId("ns3::PropagationLossModel")
+            .SetParent<Object>()
+            .SetGroupName("Propagation")
+            .AddAttribute("Cache",
+                          "If true, cache the loss of this model for the links whose ends "
+                          "stand still, until an end changes its course. Only correct for "
+                          "deterministic models whose loss does not depend on the "
+                          "transmission power.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PropagationLossModel::m_cacheEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("MaxCacheSize",
+                          "The number of links cached before the cache is flushed.",
+                          UintegerValue(1000000),
+                          MakeUintegerAccessor(&PropagationLossModel::m_maxCacheSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("CacheHits",
+                          "The number of losses found in the cache.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PropagationLossModel::GetCacheHits),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("CacheMisses",
+                          "The number of losses computed for the cache.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PropagationLossModel::GetCacheMisses),
+                          MakeUintegerChecker<uint64_t>());
     return tid;
 }
 
 PropagationLossModel::PropagationLossModel()
-    : m_next(nullptr)
+    : m_next(nullptr),
+      m_cacheEnabled(false),
+      m_maxCacheSize(1000000),
+      m_cacheHits(0),
+      m_cacheMisses(0)
 {
 }
 
@@ -74,7 +106,8 @@ PropagationLossModel::CalcRxPower(double txPowerDbm,
                                   Ptr<MobilityModel> a,
                                   Ptr<MobilityModel> b) const
 {
-    double self = DoCalcRxPower(txPowerDbm, a, b);
+    double self = m_cacheEnabled ? CalcCachedRxPower(txPowerDbm, a, b)
+                                 : DoCalcRxPower(txPowerDbm, a, b);
     if (m_next)
     {
         self = m_next->CalcRxPower(self, a, b);
@@ -82,6 +115,49 @@ PropagationLossModel::CalcRxPower(double txPowerDbm,
     return self;
 }
 
+double
+PropagationLossModel::CalcCachedRxPower(double txPowerDbm,
+                                        Ptr<MobilityModel> a,
+                                        Ptr<MobilityModel> b) const
+{
+    // read the velocities first, since they may update the course, and the
+    // epoch, of the models which move lazily
+    if (a->GetVelocity() != Vector() || b->GetVelocity() != Vector())
+    {
+        return DoCalcRxPower(txPowerDbm, a, b);
+    }
+    std::pair<uint64_t, uint64_t> epochs(a->GetPositionEpoch(), b->GetPositionEpoch());
+    auto it = m_cache.find(epochs);
+    if (it != m_cache.end())
+    {
+        m_cacheHits++;
+        return txPowerDbm - it->second;
+    }
+    double rxPowerDbm = DoCalcRxPower(txPowerDbm, a, b);
+    if (m_cache.size() >= m_maxCacheSize)
+    {
+        // the epochs of the links which changed their course are never found
+        // again: flush them with the others
+        NS_LOG_LOGIC("Flush the cache of " << m_cache.size() << " losses");
+        m_cache.clear();
+    }
+    m_cache.emplace(epochs, txPowerDbm - rxPowerDbm);
+    m_cacheMisses++;
+    return rxPowerDbm;
+}
+
+uint64_t
+PropagationLossModel::GetCacheHits() const
+{
+    return m_cacheHits;
+}
+
+uint64_t
+PropagationLossModel::GetCacheMisses() const
+{
+    return m_cacheMisses;
+}
+
 int64_t
 PropagationLossModel::AssignStreams(int64_t stream)
 {
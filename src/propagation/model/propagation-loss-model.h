@@ -28,6 +28,8 @@
 #include "ns3/random-variable-stream.h"
 
 #include <map>
+#include <unordered_map>
+#include <utility>
 
 namespace ns3
 {
@@ -51,6 +53,13 @@ class MobilityModel;
  *
  * Calculate the receive power (dbm) from a transmit power (dbm)
  * and a mobility model for the source and destination positions.
+ *
+ * When the \c Cache attribute is true, the loss of this model, not of the
+ * models chained to it, is cached for the links whose ends stand still,
+ * keyed by the position epochs of their mobility models (see
+ * MobilityModel::GetPositionEpoch): the loss is computed again only when
+ * an end of the link changes its course. The cache is only correct for the
+ * deterministic models whose loss does not depend on the transmission power.
  */
 class PropagationLossModel : public Object
 {
@@ -114,6 +123,16 @@ class PropagationLossModel : public Object
      */
     int64_t AssignStreams(int64_t stream);
 
+    /**
+     * \return the number of losses of this model found in the cache
+     */
+    uint64_t GetCacheHits() const;
+
+    /**
+     * \return the number of losses of this model computed for the cache
+     */
+    uint64_t GetCacheMisses() const;
+
   protected:
     /**
      * Assign a fixed random variable stream number to the random variables used by this model.
@@ -139,7 +158,38 @@ class PropagationLossModel : public Object
                                  Ptr<MobilityModel> a,
                                  Ptr<MobilityModel> b) const = 0;
 
+    /**
+     * Compute the loss of this model, or find it in the cache.
+     *
+     * \param txPowerDbm current transmission power (in dBm)
+     * \param a the mobility model of the source
+     * \param b the mobility model of the destination
+     * \returns the reception power after the loss of this model (in dBm)
+     */
+    double CalcCachedRxPower(double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+
+    /**
+     * Hash of the position epochs of the ends of a link.
+     */
+    struct EpochPairHash
+    {
+        /**
+         * \param epochs the position epochs of the source and destination
+         * \return the hash of the epochs
+         */
+        std::size_t operator()(const std::pair<uint64_t, uint64_t>& epochs) const
+        {
+            return std::hash<uint64_t>()(epochs.first * 0x9e3779b97f4a7c15ULL ^ epochs.second);
+        }
+    };
+
     Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
+    bool m_cacheEnabled;              //!< whether the losses of static links are cached
+    uint32_t m_maxCacheSize;          //!< the number of losses cached before a flush
+    /// the losses (in dB) of the static links, by position epochs of their ends
+    mutable std::unordered_map<std::pair<uint64_t, uint64_t>, double, EpochPairHash> m_cache;
+    mutable uint64_t m_cacheHits;   //!< the number of losses found in the cache
+    mutable uint64_t m_cacheMisses; //!< the number of losses computed for the cache
 };
 
 /**
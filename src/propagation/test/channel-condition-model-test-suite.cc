@@ -23,9 +23,13 @@
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/node-container.h"
+#include "ns3/rectangle.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
+#include <cmath>
+#include <vector>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("ChannelConditionModelsTest");
@@ -277,6 +281,120 @@ ThreeGppChannelConditionModelTestCase::DoRun()
     }
 }
 
+/**
+ * \ingroup propagation-tests
+ *
+ * Test case for the spatially consistent LOS conditions of the 3GPP channel
+ * condition models. It determines the channel conditions between many sites
+ * and the same positions, and checks that the LOS probability is kept, that
+ * the conditions of close positions are correlated, and that the conditions
+ * of distant positions are not.
+ */
+class ThreeGppCorrelatedChannelConditionTestCase : public TestCase
+{
+  public:
+    ThreeGppCorrelatedChannelConditionTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ThreeGppCorrelatedChannelConditionTestCase::ThreeGppCorrelatedChannelConditionTestCase()
+    : TestCase("Test case for the spatially consistent LOS conditions")
+{
+}
+
+void
+ThreeGppCorrelatedChannelConditionTestCase::DoRun()
+{
+    Ptr<ThreeGppChannelConditionModel> condModel =
+        CreateObject<ThreeGppUmaChannelConditionModel>();
+    condModel->SetAttribute("LosCorrelationDistance", DoubleValue(50));
+    condModel->SetAttribute("LosFieldBounds", RectangleValue(Rectangle(-500, 500, -500, 500)));
+    condModel->AssignStreams(1);
+
+    // the user terminals: two close to each other, and a distant one, all
+    // at the same distance of the sites
+    NodeContainer uts;
+    uts.Create(3);
+    std::vector<Vector> positions = {Vector(100, 0, 1.5),
+                                     Vector(100, 1, 1.5),
+                                     Vector(-100, 0, 1.5)};
+    for (uint32_t i = 0; i < uts.GetN(); ++i)
+    {
+        Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(positions[i]);
+        uts.Get(i)->AggregateObject(mobility);
+    }
+
+    uint32_t numberOfSites = 1000;
+    NodeContainer sites;
+    sites.Create(numberOfSites);
+    uint32_t numLos = 0;
+    uint32_t numCloseEqual = 0;
+    uint32_t numDistantEqual = 0;
+    Ptr<ChannelCondition> losCondition;
+    std::vector<Ptr<ChannelCondition>> firstUtConditions;
+    for (uint32_t i = 0; i < numberOfSites; ++i)
+    {
+        Ptr<MobilityModel> site = CreateObject<ConstantPositionMobilityModel>();
+        site->SetPosition(Vector(0, 0, 25));
+        sites.Get(i)->AggregateObject(site);
+
+        bool los[3];
+        for (uint32_t j = 0; j < uts.GetN(); ++j)
+        {
+            Ptr<MobilityModel> ut = uts.Get(j)->GetObject<MobilityModel>();
+            Ptr<ChannelCondition> cond = condModel->GetChannelCondition(site, ut);
+            NS_TEST_EXPECT_MSG_EQ(condModel->GetChannelCondition(ut, site),
+                                  cond,
+                                  "The condition is not reciprocal");
+            los[j] = cond->IsLos();
+            if (los[j] && !losCondition)
+            {
+                losCondition = cond;
+            }
+            else if (los[j])
+            {
+                NS_TEST_EXPECT_MSG_EQ(cond, losCondition, "The LOS condition is not shared");
+            }
+        }
+        firstUtConditions.push_back(
+            condModel->GetChannelCondition(site, uts.Get(0)->GetObject<MobilityModel>()));
+        numLos += los[0] ? 1 : 0;
+        numCloseEqual += los[0] == los[1] ? 1 : 0;
+        numDistantEqual += los[0] == los[2] ? 1 : 0;
+    }
+
+    // the LOS probability of TR 38.901, Table 7.4.2-1, at 100 m
+    double pLos = 18.0 / 100 + std::exp(-100 / 63.0) * (1 - 18.0 / 100);
+    NS_TEST_EXPECT_MSG_EQ_TOL(double(numLos) / numberOfSites,
+                              pLos,
+                              0.06,
+                              "Got unexpected LOS probability");
+    NS_TEST_EXPECT_MSG_GT(double(numCloseEqual) / numberOfSites,
+                          0.9,
+                          "The conditions of close positions are not correlated");
+    // independent conditions are equal with a probability of
+    // pLos^2 + (1 - pLos)^2
+    NS_TEST_EXPECT_MSG_LT(double(numDistantEqual) / numberOfSites,
+                          0.7,
+                          "The conditions of distant positions are correlated");
+
+    // the site of a link is chosen from the first heights of its ends, so
+    // the conditions are kept when the user terminal climbs above the sites
+    Ptr<MobilityModel> firstUt = uts.Get(0)->GetObject<MobilityModel>();
+    firstUt->SetPosition(Vector(100, 0, 30));
+    for (uint32_t i = 0; i < numberOfSites; ++i)
+    {
+        Ptr<MobilityModel> site = sites.Get(i)->GetObject<MobilityModel>();
+        NS_TEST_EXPECT_MSG_EQ(condModel->GetChannelCondition(firstUt, site),
+                              firstUtConditions[i],
+                              "The condition changed with the height of the user terminal");
+    }
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup propagation-tests
  *
@@ -292,6 +410,7 @@ ChannelConditionModelsTestSuite::ChannelConditionModelsTestSuite()
     : TestSuite("propagation-channel-condition-model", UNIT)
 {
     AddTestCase(new ThreeGppChannelConditionModelTestCase, TestCase::QUICK);
+    AddTestCase(new ThreeGppCorrelatedChannelConditionTestCase, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
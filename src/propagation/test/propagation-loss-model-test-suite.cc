@@ -16,13 +16,16 @@
  */
 
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -489,6 +492,80 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief Test of the cache of the losses of the static links
+ */
+class PropagationLossCacheTestCase : public TestCase
+{
+  public:
+    PropagationLossCacheTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PropagationLossCacheTestCase::PropagationLossCacheTestCase()
+    : TestCase("Test the cache of the losses of the static links")
+{
+}
+
+void
+PropagationLossCacheTestCase::DoRun()
+{
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    Ptr<ConstantVelocityMobilityModel> c = CreateObject<ConstantVelocityMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    b->SetPosition(Vector(100, 0, 0));
+    c->SetPosition(Vector(0, 50, 0));
+
+    Ptr<LogDistancePropagationLossModel> reference =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<LogDistancePropagationLossModel> lossModel =
+        CreateObject<LogDistancePropagationLossModel>();
+    lossModel->SetAttribute("Cache", BooleanValue(true));
+    lossModel->SetAttribute("MaxCacheSize", UintegerValue(2));
+    double tolerance = 1e-9;
+
+    // the first loss is computed, the next ones are found in the cache,
+    // whatever the transmission power
+    double expected = reference->CalcRxPower(10, a, b);
+    double resultdBm = lossModel->CalcRxPower(10, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expected, tolerance, "Wrong computed loss");
+    resultdBm = lossModel->CalcRxPower(10, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expected, tolerance, "Wrong cached loss");
+    resultdBm = lossModel->CalcRxPower(20, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expected + 10, tolerance, "Wrong cached loss");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetCacheMisses(), 1, "Wrong number of misses");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetCacheHits(), 2, "Wrong number of hits");
+
+    // a course change of an end invalidates the loss of the link
+    b->SetPosition(Vector(200, 0, 0));
+    expected = reference->CalcRxPower(10, a, b);
+    resultdBm = lossModel->CalcRxPower(10, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expected, tolerance, "Stale cached loss");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetCacheMisses(), 2, "Wrong number of misses");
+
+    // the links are directed
+    resultdBm = lossModel->CalcRxPower(10, b, a);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expected, tolerance, "Wrong computed loss");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetCacheMisses(), 3, "Wrong number of misses");
+
+    // the links of moving ends are not cached
+    c->SetVelocity(Vector(1, 0, 0));
+    expected = reference->CalcRxPower(10, a, c);
+    resultdBm = lossModel->CalcRxPower(10, a, c);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expected, tolerance, "Wrong loss of a moving end");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetCacheMisses(), 3, "Moving end cached");
+
+    UintegerValue hits;
+    lossModel->GetAttribute("CacheHits", hits);
+    NS_TEST_EXPECT_MSG_EQ(hits.Get(), 2, "Wrong CacheHits attribute");
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup propagation-tests
  *
@@ -500,6 +577,7 @@ RangePropagationLossModelTestCase::DoRun()
  *   - LogDistancePropagationLossModel
  *   - MatrixPropagationLossModel
  *   - RangePropagationLossModel
+ *   - the cache of the PropagationLossModel
  */
 class PropagationLossModelsTestSuite : public TestSuite
 {
@@ -515,6 +593,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::QUICK);
+    AddTestCase(new PropagationLossCacheTestCase, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
@@ -1304,6 +1304,82 @@ ThreeGppShadowingTestCase::DoRun()
     }
 }
 
+/**
+ * \ingroup propagation-tests
+ *
+ * Test to check that the shadowing of a static link is kept when the shared
+ * channel condition of the link is redrawn with the same LOS condition, and
+ * redrawn when the LOS condition changes
+ */
+class ThreeGppShadowingRedrawTestCase : public TestCase
+{
+  public:
+    ThreeGppShadowingRedrawTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ThreeGppShadowingRedrawTestCase::ThreeGppShadowingRedrawTestCase()
+    : TestCase("Test the shadowing across the updates of the channel condition")
+{
+}
+
+void
+ThreeGppShadowingRedrawTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0.0, 0.0, 25.0));
+    nodes.Get(0)->AggregateObject(a);
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    b->SetPosition(Vector(0.0, 100.0, 1.6));
+    nodes.Get(1)->AggregateObject(b);
+
+    // the condition is redrawn, independently, at each evaluation
+    Ptr<ThreeGppChannelConditionModel> condModel =
+        CreateObject<ThreeGppUmaChannelConditionModel>();
+    condModel->SetAttribute("UpdatePeriod", TimeValue(MilliSeconds(1)));
+    Ptr<ThreeGppPropagationLossModel> lossModel =
+        CreateObject<ThreeGppUmaPropagationLossModel>();
+    lossModel->SetAttribute("Frequency", DoubleValue(3.5e9));
+    lossModel->SetAttribute("ShadowingEnabled", BooleanValue(true));
+    lossModel->SetChannelConditionModel(condModel);
+    condModel->AssignStreams(1);
+    lossModel->AssignStreams(2);
+
+    uint32_t numKept = 0;
+    uint32_t numChanged = 0;
+    double lastRxPower = 0;
+    Ptr<ChannelCondition> lastCond;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        Simulator::Stop(MilliSeconds(2));
+        Simulator::Run();
+        double rxPower = lossModel->CalcRxPower(0, a, b);
+        Ptr<ChannelCondition> cond = condModel->GetChannelCondition(a, b);
+        if (lastCond && cond->GetLosCondition() == lastCond->GetLosCondition())
+        {
+            // the conditions are shared: a redraw with the same LOS condition
+            // returns the same object, and the shadowing of a static link is
+            // fully correlated
+            NS_TEST_EXPECT_MSG_EQ(cond, lastCond, "The conditions are not shared");
+            NS_TEST_EXPECT_MSG_EQ_TOL(rxPower, lastRxPower, 1e-9, "The shadowing was redrawn");
+            numKept++;
+        }
+        else if (lastCond)
+        {
+            numChanged++;
+        }
+        lastRxPower = rxPower;
+        lastCond = cond;
+    }
+    NS_TEST_EXPECT_MSG_GT(numKept, 0, "No redraw with the same LOS condition");
+    NS_TEST_EXPECT_MSG_GT(numChanged, 0, "No change of the LOS condition");
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup propagation-tests
  *
@@ -1334,6 +1410,7 @@ ThreeGppPropagationLossModelsTestSuite::ThreeGppPropagationLossModelsTestSuite()
     AddTestCase(new ThreeGppV2vUrbanPropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new ThreeGppV2vHighwayPropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new ThreeGppShadowingTestCase, TestCase::QUICK);
+    AddTestCase(new ThreeGppShadowingRedrawTestCase, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
@@ -0,0 +1,370 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "fading-trace.h"
+
+#include <ns3/log.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#ifndef __WIN32__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FadingTrace");
+
+namespace
+{
+
+/** The header of the binary fading traces. */
+struct FadingTraceHeader
+{
+    char magic[8];       //!< "NS3FADE".
+    uint32_t version;    //!< The version of the format.
+    uint32_t byteOrder;  //!< 0x01020304, in the byte order of the samples.
+    uint32_t sampleType; //!< The type of the samples.
+    uint32_t rbNum;      //!< The number of RBs.
+    uint32_t samplesNum; //!< The number of samples of each RB.
+    uint32_t stride;     //!< The distance between the RBs, in samples.
+    double step;         //!< The quantization step of the INT16 samples.
+    uint8_t padding[24]; //!< Up to the alignment of the samples.
+};
+
+static_assert(sizeof(FadingTraceHeader) == 64, "The header must be 64 bytes");
+
+/** The magic of the binary fading traces. */
+const char FADING_TRACE_MAGIC[8] = "NS3FADE";
+/** The version of the format of the binary fading traces. */
+const uint32_t FADING_TRACE_VERSION = 1;
+/** The byte order mark of the binary fading traces. */
+const uint32_t FADING_TRACE_BYTE_ORDER = 0x01020304;
+/** The alignment of the RBs of the binary fading traces, in bytes. */
+const uint32_t FADING_TRACE_ALIGNMENT = 64;
+
+/**
+ * \param [in] type The type of the samples.
+ * \returns The size of a sample, in bytes.
+ */
+uint32_t
+SampleSize(FadingTrace::SampleType type)
+{
+    switch (type)
+    {
+    case FadingTrace::FLOAT:
+        return sizeof(float);
+    case FadingTrace::INT16:
+        return sizeof(int16_t);
+    default:
+        return sizeof(double);
+    }
+}
+
+/**
+ * Check the header of a binary trace.
+ *
+ * \param [in] header The header.
+ * \param [in] size The size of the trace file.
+ * \returns \c false if the header is not valid.
+ */
+bool
+CheckHeader(const FadingTraceHeader& header, std::size_t size)
+{
+    if (std::memcmp(header.magic, FADING_TRACE_MAGIC, sizeof(header.magic)) != 0)
+    {
+        return false;
+    }
+    if (header.version != FADING_TRACE_VERSION || header.byteOrder != FADING_TRACE_BYTE_ORDER)
+    {
+        NS_LOG_ERROR("Unsupported version or byte order of the fading trace");
+        return false;
+    }
+    if (header.sampleType != FadingTrace::FLOAT && header.sampleType != FadingTrace::INT16)
+    {
+        NS_LOG_ERROR("Unsupported type of samples " << header.sampleType);
+        return false;
+    }
+    auto type = static_cast<FadingTrace::SampleType>(header.sampleType);
+    if (header.stride < header.samplesNum ||
+        sizeof(FadingTraceHeader) +
+                static_cast<std::size_t>(header.rbNum) * header.stride * SampleSize(type) >
+            size)
+    {
+        NS_LOG_ERROR("Truncated fading trace");
+        return false;
+    }
+    return true;
+}
+
+} // unnamed namespace
+
+FadingTrace::FadingTrace()
+    : m_rbNum(0),
+      m_samplesNum(0),
+      m_type(DOUBLE),
+      m_stride(0),
+      m_step(1),
+      m_samples(nullptr),
+      m_mapping(nullptr),
+      m_mappingSize(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+FadingTrace::~FadingTrace()
+{
+    NS_LOG_FUNCTION(this);
+#ifndef __WIN32__
+    if (m_mapping)
+    {
+        munmap(m_mapping, m_mappingSize);
+    }
+#endif
+}
+
+Ptr<const FadingTrace>
+FadingTrace::Get(const std::string& fileName, uint32_t rbNum, uint32_t samplesNum)
+{
+    NS_LOG_FUNCTION(fileName << rbNum << samplesNum);
+    // the traces loaded in this process, by file name, and by file name and
+    // dimensions for the text traces
+    static std::map<std::string, Ptr<const FadingTrace>> traces;
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::ostringstream textKey;
+    textKey << fileName << ":" << rbNum << "x" << samplesNum;
+    auto it = traces.find(fileName);
+    if (it == traces.end())
+    {
+        it = traces.find(textKey.str());
+    }
+    if (it != traces.end())
+    {
+        return it->second;
+    }
+
+    Ptr<FadingTrace> trace = Ptr<FadingTrace>(new FadingTrace(), false);
+    if (trace->MapBinary(fileName))
+    {
+        traces[fileName] = trace;
+        return trace;
+    }
+    if (!ReadText(fileName, rbNum, samplesNum, trace->m_loaded))
+    {
+        return nullptr;
+    }
+    trace->m_rbNum = rbNum;
+    trace->m_samplesNum = samplesNum;
+    trace->m_stride = samplesNum;
+    trace->m_samples = reinterpret_cast<const uint8_t*>(trace->m_loaded.data());
+    traces[textKey.str()] = trace;
+    return trace;
+}
+
+bool
+FadingTrace::ReadText(const std::string& fileName,
+                      uint32_t rbNum,
+                      uint32_t samplesNum,
+                      std::vector<double>& samples)
+{
+    NS_LOG_FUNCTION(fileName << rbNum << samplesNum);
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.good())
+    {
+        NS_LOG_ERROR("Can't open fading trace " << fileName);
+        return false;
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::size_t n = static_cast<std::size_t>(rbNum) * samplesNum;
+    samples.resize(n);
+    const char* p = text.c_str();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        char* end;
+        samples[i] = std::strtod(p, &end);
+        if (end == p)
+        {
+            NS_LOG_ERROR("Fading trace " << fileName << " has " << i << " samples, expected "
+                                         << n);
+            return false;
+        }
+        p = end;
+    }
+    return true;
+}
+
+bool
+FadingTrace::MapBinary(const std::string& fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    const uint8_t* data = nullptr;
+    std::size_t size = 0;
+#ifdef __WIN32__
+    std::ifstream file(fileName, std::ios::binary);
+    FadingTraceHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, FADING_TRACE_MAGIC, sizeof(header.magic)) != 0)
+    {
+        return false;
+    }
+    file.seekg(0);
+    m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data = m_buffer.data();
+    size = m_buffer.size();
+#else
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(FadingTraceHeader))
+    {
+        close(fd);
+        return false;
+    }
+    size = st.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        NS_LOG_ERROR("Can't map fading trace " << fileName);
+        return false;
+    }
+    m_mapping = mapping;
+    m_mappingSize = size;
+    data = static_cast<const uint8_t*>(mapping);
+#endif
+    FadingTraceHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (!CheckHeader(header, size))
+    {
+#ifndef __WIN32__
+        munmap(m_mapping, m_mappingSize);
+        m_mapping = nullptr;
+#endif
+        m_buffer.clear();
+        return false;
+    }
+    m_rbNum = header.rbNum;
+    m_samplesNum = header.samplesNum;
+    m_type = static_cast<SampleType>(header.sampleType);
+    m_stride = header.stride;
+    m_step = header.step;
+    m_samples = data + sizeof(FadingTraceHeader);
+    NS_LOG_INFO("Mapped fading trace " << fileName << " of " << m_rbNum << " RBs and "
+                                       << m_samplesNum << " samples");
+    return true;
+}
+
+bool
+FadingTrace::ConvertTextTrace(const std::string& textFileName,
+                              const std::string& fileName,
+                              uint32_t rbNum,
+                              uint32_t samplesNum,
+                              SampleType type,
+                              double step)
+{
+    NS_LOG_FUNCTION(textFileName << fileName << rbNum << samplesNum << type << step);
+    NS_ASSERT_MSG(type == FLOAT || type == INT16, "Unsupported type of samples " << type);
+    NS_ASSERT_MSG(step > 0, "The quantization step must be positive");
+    std::vector<double> samples;
+    if (!ReadText(textFileName, rbNum, samplesNum, samples))
+    {
+        return false;
+    }
+
+    uint32_t sampleSize = SampleSize(type);
+    uint32_t rowSize =
+        (samplesNum * sampleSize + FADING_TRACE_ALIGNMENT - 1) / FADING_TRACE_ALIGNMENT *
+        FADING_TRACE_ALIGNMENT;
+    FadingTraceHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, FADING_TRACE_MAGIC, sizeof(header.magic));
+    header.version = FADING_TRACE_VERSION;
+    header.byteOrder = FADING_TRACE_BYTE_ORDER;
+    header.sampleType = type;
+    header.rbNum = rbNum;
+    header.samplesNum = samplesNum;
+    header.stride = rowSize / sampleSize;
+    header.step = type == INT16 ? step : 1;
+
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if (!file.good())
+    {
+        NS_LOG_ERROR("Can't open file " << fileName);
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    std::vector<uint8_t> row(rowSize);
+    for (uint32_t rb = 0; rb < rbNum; rb++)
+    {
+        const double* values = samples.data() + static_cast<std::size_t>(rb) * samplesNum;
+        for (uint32_t i = 0; i < samplesNum; i++)
+        {
+            if (type == FLOAT)
+            {
+                float value = values[i];
+                std::memcpy(row.data() + i * sampleSize, &value, sampleSize);
+            }
+            else
+            {
+                double quantized = std::round(values[i] / step);
+                quantized = std::clamp<double>(quantized,
+                                               std::numeric_limits<int16_t>::min(),
+                                               std::numeric_limits<int16_t>::max());
+                auto value = static_cast<int16_t>(quantized);
+                std::memcpy(row.data() + i * sampleSize, &value, sampleSize);
+            }
+        }
+        file.write(reinterpret_cast<const char*>(row.data()), rowSize);
+    }
+    return file.good();
+}
+
+uint32_t
+FadingTrace::GetRbNum() const
+{
+    return m_rbNum;
+}
+
+uint32_t
+FadingTrace::GetSamplesNum() const
+{
+    return m_samplesNum;
+}
+
+FadingTrace::SampleType
+FadingTrace::GetSampleType() const
+{
+    return m_type;
+}
+
+} // namespace ns3
@@ -0,0 +1,164 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FADING_TRACE_H
+#define FADING_TRACE_H
+
+#include <ns3/assert.h>
+#include <ns3/ptr.h>
+#include <ns3/simple-ref-count.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief The samples, in dB, of a fading trace, for each RB.
+ *
+ * A fading trace is loaded once per process, by Get(), and shared by all
+ * the TraceFadingLossModel instances using it. The traces are either text
+ * files, holding the samples of each RB in turn, as written by the
+ * fading_trace_generator.m script of the LTE module, or binary files
+ * converted from the text files by ConvertTextTrace() (see the
+ * convert-fading-trace program of utils).
+ *
+ * The binary traces start with a 64 bytes header, followed by the samples
+ * of each RB, as 32 bits floats or as 16 bits integers in units of a
+ * quantization step, each RB starting at a multiple of 64 bytes. They are
+ * mapped in memory read-only, so that the processes using a trace share
+ * its pages, and loading it does not read the file.
+ */
+class FadingTrace : public SimpleRefCount<FadingTrace>
+{
+  public:
+    /** The type of the samples. */
+    enum SampleType : uint32_t
+    {
+        DOUBLE = 0, //!< 64 bits floats, for the traces loaded from text files.
+        FLOAT = 1,  //!< 32 bits floats.
+        INT16 = 2   //!< 16 bits integers, in units of the quantization step.
+    };
+
+    ~FadingTrace();
+
+    /**
+     * Get a fading trace, loading it if it is not loaded yet.
+     *
+     * \param [in] fileName The name of the trace file.
+     * \param [in] rbNum The number of RBs of a text trace.
+     * \param [in] samplesNum The number of samples of each RB of a text trace.
+     * \returns The trace, or \c nullptr if it can't be read.
+     */
+    static Ptr<const FadingTrace> Get(const std::string& fileName,
+                                      uint32_t rbNum,
+                                      uint32_t samplesNum);
+
+    /**
+     * Convert a text trace to a binary trace.
+     *
+     * \param [in] textFileName The name of the text trace.
+     * \param [in] fileName The name of the binary trace.
+     * \param [in] rbNum The number of RBs of the trace.
+     * \param [in] samplesNum The number of samples of each RB.
+     * \param [in] type The type of the samples of the binary trace.
+     * \param [in] step The quantization step, in dB, of the INT16 samples.
+     * \returns \c false if the text trace can't be read, or the binary trace
+     *          can't be written.
+     */
+    static bool ConvertTextTrace(const std::string& textFileName,
+                                 const std::string& fileName,
+                                 uint32_t rbNum,
+                                 uint32_t samplesNum,
+                                 SampleType type,
+                                 double step = 0.01);
+
+    /** \returns The number of RBs. */
+    uint32_t GetRbNum() const;
+    /** \returns The number of samples of each RB. */
+    uint32_t GetSamplesNum() const;
+    /** \returns The type of the samples. */
+    SampleType GetSampleType() const;
+    /**
+     * \param [in] rb The RB.
+     * \param [in] sample The index of the sample.
+     * \returns The sample, in dB.
+     */
+    double GetValue(uint32_t rb, uint32_t sample) const;
+
+  private:
+    /** Constructor. */
+    FadingTrace();
+
+    /**
+     * Read a text trace.
+     *
+     * \param [in] fileName The name of the trace file.
+     * \param [in] rbNum The number of RBs of the trace.
+     * \param [in] samplesNum The number of samples of each RB.
+     * \param [out] samples The samples of each RB in turn.
+     * \returns \c false if the trace can't be read.
+     */
+    static bool ReadText(const std::string& fileName,
+                         uint32_t rbNum,
+                         uint32_t samplesNum,
+                         std::vector<double>& samples);
+    /**
+     * Map a binary trace in memory.
+     *
+     * \param [in] fileName The name of the trace file.
+     * \returns \c false if the file is not a valid binary trace.
+     */
+    bool MapBinary(const std::string& fileName);
+
+    uint32_t m_rbNum;              //!< The number of RBs.
+    uint32_t m_samplesNum;         //!< The number of samples of each RB.
+    SampleType m_type;             //!< The type of the samples.
+    uint32_t m_stride;             //!< The distance between the RBs, in samples.
+    double m_step;                 //!< The quantization step of the INT16 samples.
+    const uint8_t* m_samples;      //!< The samples of the first RB.
+    std::vector<double> m_loaded;  //!< The samples loaded from a text trace.
+    void* m_mapping;               //!< The memory mapping of a binary trace.
+    std::size_t m_mappingSize;     //!< The size of the memory mapping.
+    std::vector<uint8_t> m_buffer; //!< The binary trace, where it can't be mapped.
+};
+
+/*************************************************************************
+ *   Implementation of the inline methods declared above.
+ *************************************************************************/
+
+inline double
+FadingTrace::GetValue(uint32_t rb, uint32_t sample) const
+{
+    NS_ASSERT(rb < m_rbNum && sample < m_samplesNum);
+    std::size_t i = static_cast<std::size_t>(rb) * m_stride + sample;
+    switch (m_type)
+    {
+    case FLOAT:
+        return reinterpret_cast<const float*>(m_samples)[i];
+    case INT16:
+        return reinterpret_cast<const int16_t*>(m_samples)[i] * m_step;
+    default:
+        return reinterpret_cast<const double*>(m_samples)[i];
+    }
+}
+
+} // namespace ns3
+
+#endif /* FADING_TRACE_H */
@@ -38,6 +38,7 @@
 #include <ns3/simulator.h>
 
 #include <algorithm>
+#include <vector>
 
 namespace ns3
 {
@@ -119,6 +120,9 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
     Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility();
 
+    // the receivers of the signal, towards which the gains of the tx antenna
+    // are evaluated at once
+    std::vector<Ptr<SpectrumPhy>> receivers;
     for (auto rxPhyIterator = m_phyList.begin(); rxPhyIterator != m_phyList.end(); ++rxPhyIterator)
     {
         Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
@@ -142,86 +146,103 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
         if ((*rxPhyIterator) != txParams->txPhy)
         {
-            Time delay = MicroSeconds(0);
+            receivers.push_back(*rxPhyIterator);
+        }
+    }
+
+    std::vector<double> txAntennaGains;
+    if (txParams->txAntenna && senderMobility)
+    {
+        std::vector<Angles> txAngles;
+        txAngles.reserve(receivers.size());
+        for (const auto& rxPhy : receivers)
+        {
+            Ptr<MobilityModel> receiverMobility = rxPhy->GetMobility();
+            // the gains towards the receivers without mobility are not used
+            txAngles.push_back(receiverMobility ? Angles(receiverMobility->GetPosition(),
+                                                         senderMobility->GetPosition())
+                                                : Angles(0, 0));
+        }
+        txParams->txAntenna->GetGainsDb(txAngles, txAntennaGains);
+    }
 
-            Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility();
-            NS_LOG_LOGIC("copying signal parameters " << txParams);
-            Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
+    for (std::size_t i = 0; i < receivers.size(); ++i)
+    {
+        Ptr<SpectrumPhy> rxPhy = receivers[i];
+        Ptr<NetDevice> rxNetDevice = rxPhy->GetDevice();
+        Time delay = MicroSeconds(0);
 
-            if (senderMobility && receiverMobility)
-            {
-                double txAntennaGain = 0;
-                double rxAntennaGain = 0;
-                double propagationGainDb = 0;
-                double pathLossDb = 0;
-                if (rxParams->txAntenna)
-                {
-                    Angles txAngles(receiverMobility->GetPosition(), senderMobility->GetPosition());
-                    txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
-                    NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
-                    pathLossDb -= txAntennaGain;
-                }
-                Ptr<AntennaModel> rxAntenna =
-                    DynamicCast<AntennaModel>((*rxPhyIterator)->GetAntenna());
-                if (rxAntenna)
-                {
-                    Angles rxAngles(senderMobility->GetPosition(), receiverMobility->GetPosition());
-                    rxAntennaGain = rxAntenna->GetGainDb(rxAngles);
-                    NS_LOG_LOGIC("rxAntennaGain = " << rxAntennaGain << " dB");
-                    pathLossDb -= rxAntennaGain;
-                }
-                if (m_propagationLoss)
-                {
-                    propagationGainDb =
-                        m_propagationLoss->CalcRxPower(0, senderMobility, receiverMobility);
-                    NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
-                    pathLossDb -= propagationGainDb;
-                }
-                NS_LOG_LOGIC("total pathLoss = " << pathLossDb << " dB");
-                // Gain trace
-                m_gainTrace(senderMobility,
-                            receiverMobility,
-                            txAntennaGain,
-                            rxAntennaGain,
-                            propagationGainDb,
-                            pathLossDb);
-                // Pathloss trace
-                m_pathLossTrace(txParams->txPhy, *rxPhyIterator, pathLossDb);
-                if (pathLossDb > m_maxLossDb)
-                {
-                    // beyond range
-                    continue;
-                }
-                double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
-                *(rxParams->psd) *= pathGainLinear;
+        Ptr<MobilityModel> receiverMobility = rxPhy->GetMobility();
+        NS_LOG_LOGIC("copying signal parameters " << txParams);
+        Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
 
-                if (m_propagationDelay)
-                {
-                    delay = m_propagationDelay->GetDelay(senderMobility, receiverMobility);
-                }
+        if (senderMobility && receiverMobility)
+        {
+            double txAntennaGain = 0;
+            double rxAntennaGain = 0;
+            double propagationGainDb = 0;
+            double pathLossDb = 0;
+            if (rxParams->txAntenna)
+            {
+                txAntennaGain = txAntennaGains[i];
+                NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
+                pathLossDb -= txAntennaGain;
             }
-
-            if (rxNetDevice)
+            Ptr<AntennaModel> rxAntenna = DynamicCast<AntennaModel>(rxPhy->GetAntenna());
+            if (rxAntenna)
             {
-                // the receiver has a NetDevice, so we expect that it is attached to a Node
-                uint32_t dstNode = rxNetDevice->GetNode()->GetId();
-                Simulator::ScheduleWithContext(dstNode,
-                                               delay,
-                                               &SingleModelSpectrumChannel::StartRx,
-                                               this,
-                                               rxParams,
-                                               *rxPhyIterator);
+                Angles rxAngles(senderMobility->GetPosition(), receiverMobility->GetPosition());
+                rxAntennaGain = rxAntenna->GetGainDb(rxAngles);
+                NS_LOG_LOGIC("rxAntennaGain = " << rxAntennaGain << " dB");
+                pathLossDb -= rxAntennaGain;
             }
-            else
+            if (m_propagationLoss)
             {
-                // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                // attached to a node
-                Simulator::Schedule(delay,
-                                    &SingleModelSpectrumChannel::StartRx,
-                                    this,
-                                    rxParams,
-                                    *rxPhyIterator);
+                propagationGainDb =
+                    m_propagationLoss->CalcRxPower(0, senderMobility, receiverMobility);
+                NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
+                pathLossDb -= propagationGainDb;
             }
+            NS_LOG_LOGIC("total pathLoss = " << pathLossDb << " dB");
+            // Gain trace
+            m_gainTrace(senderMobility,
+                        receiverMobility,
+                        txAntennaGain,
+                        rxAntennaGain,
+                        propagationGainDb,
+                        pathLossDb);
+            // Pathloss trace
+            m_pathLossTrace(txParams->txPhy, rxPhy, pathLossDb);
+            if (pathLossDb > m_maxLossDb)
+            {
+                // beyond range
+                continue;
+            }
+            double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
+            *(rxParams->psd) *= pathGainLinear;
+
+            if (m_propagationDelay)
+            {
+                delay = m_propagationDelay->GetDelay(senderMobility, receiverMobility);
+            }
+        }
+
+        if (rxNetDevice)
+        {
+            // the receiver has a NetDevice, so we expect that it is attached to a Node
+            uint32_t dstNode = rxNetDevice->GetNode()->GetId();
+            Simulator::ScheduleWithContext(dstNode,
+                                           delay,
+                                           &SingleModelSpectrumChannel::StartRx,
+                                           this,
+                                           rxParams,
+                                           rxPhy);
+        }
+        else
+        {
+            // the receiver is not attached to a NetDevice, so we cannot assume that it is
+            // attached to a node
+            Simulator::Schedule(delay, &SingleModelSpectrumChannel::StartRx, this, rxParams, rxPhy);
         }
     }
 }
@@ -1909,42 +1909,45 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
     Angles sAngle(uMob->GetPosition(), sMob->GetPosition());
     Angles uAngle(sMob->GetPosition(), uMob->GetPosition());
 
-    Complex2DVector raysPreComp(channelParams->m_reducedClusterNumber,
-                                table3gpp->m_raysPerCluster); // stores part of the ray expression,
-    // cached as independent from the u- and s-indexes
-    Double2DVector sinCosA; // cached multiplications of sin and cos of the ZoA and AoA angles
-    Double2DVector sinSinA; // cached multiplications of sines of the ZoA and AoA angles
-    Double2DVector cosZoA;  // cached cos of the ZoA angle
-    Double2DVector sinCosD; // cached multiplications of sin and cos of the ZoD and AoD angles
-    Double2DVector sinSinD; // cached multiplications of the cosines of the ZoA and AoA angles
-    Double2DVector cosZoD;  // cached cos of the ZoD angle
-
-    // resize to appropriate dimensions
-    sinCosA.resize(channelParams->m_reducedClusterNumber);
-    sinSinA.resize(channelParams->m_reducedClusterNumber);
-    cosZoA.resize(channelParams->m_reducedClusterNumber);
-    sinCosD.resize(channelParams->m_reducedClusterNumber);
-    sinSinD.resize(channelParams->m_reducedClusterNumber);
-    cosZoD.resize(channelParams->m_reducedClusterNumber);
-    for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
+    // The element locations are looked up once per channel matrix, not per cluster
+    std::vector<Vector> uLocs(uSize);
+    for (size_t uIndex = 0; uIndex < uSize; uIndex++)
+    {
+        uLocs[uIndex] = uAntenna->GetElementLocation(uIndex);
+    }
+    std::vector<Vector> sLocs(sSize);
+    for (size_t sIndex = 0; sIndex < sSize; sIndex++)
     {
-        sinCosA[nIndex].resize(table3gpp->m_raysPerCluster);
-        sinSinA[nIndex].resize(table3gpp->m_raysPerCluster);
-        cosZoA[nIndex].resize(table3gpp->m_raysPerCluster);
-        sinCosD[nIndex].resize(table3gpp->m_raysPerCluster);
-        sinSinD[nIndex].resize(table3gpp->m_raysPerCluster);
-        cosZoD[nIndex].resize(table3gpp->m_raysPerCluster);
+        sLocs[sIndex] = sAntenna->GetElementLocation(sIndex);
     }
-    // pre-compute the terms which are independent from uIndex and sIndex
+
+    // The channel coefficients of a (sub-)cluster (7.5-22) and (7.5-28) are the sum over its
+    // rays of the product of the u and s array responses to each ray. They are thus computed as
+    // the product of two matrices per (sub-)cluster: uSteering(u, m) holds the response of the u
+    // element to the ray m, weighted by the coefficient of the ray, and sSteering(m, s) the
+    // response of the s element to the ray m. This takes (uSize + sSize) complex exponentials
+    // per ray instead of uSize * sSize, and the sums are computed by the page-wise product of the
+    // matrix arrays, which uses Eigen when available.
+    // The rays of the two strongest clusters which belong to the 2nd and 3rd sub-clusters are
+    // set in the pages of these sub-clusters of uSteering, and the s responses are copied to
+    // these pages of sSteering.
+    uint8_t raysPerCluster = table3gpp->m_raysPerCluster;
+    Complex3DVector uSteering(uSize, raysPerCluster, numOverallCluster);
+    Complex3DVector sSteering(raysPerCluster, sSize, numOverallCluster);
+    // Keeps track of how many sub-clusters have been added up to now
+    uint8_t numSubClustersAdded = 0;
     for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
     {
-        for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+        bool isStrongest =
+            (nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd);
+        double rayScale = sqrt(channelParams->m_clusterPower[nIndex] / raysPerCluster);
+        for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
         {
             DoubleVector initialPhase = channelParams->m_clusterPhase[nIndex][mIndex];
             NS_ASSERT(4 <= initialPhase.size());
             double k = channelParams->m_crossPolarizationPowerRatios[nIndex][mIndex];
 
-            // cache the component of the "rays" terms which depend on the random angle of arrivals
+            // the component of the "rays" terms which depend on the random angle of arrivals
             // and departures and initial phases only
             auto [rxFieldPatternPhi, rxFieldPatternTheta] = uAntenna->GetElementFieldPattern(
                 Angles(channelParams->m_rayAoaRadian[nIndex][mIndex],
@@ -1952,7 +1955,7 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
             auto [txFieldPatternPhi, txFieldPatternTheta] = sAntenna->GetElementFieldPattern(
                 Angles(channelParams->m_rayAodRadian[nIndex][mIndex],
                        channelParams->m_rayZodRadian[nIndex][mIndex]));
-            raysPreComp(nIndex, mIndex) =
+            std::complex<double> rayPreComp =
                 std::complex<double>(cos(initialPhase[0]), sin(initialPhase[0])) *
                     rxFieldPatternTheta * txFieldPatternTheta +
                 std::complex<double>(cos(initialPhase[1]), sin(initialPhase[1])) *
@@ -1961,135 +1964,79 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                     std::sqrt(1.0 / k) * rxFieldPatternPhi * txFieldPatternTheta +
                 std::complex<double>(cos(initialPhase[3]), sin(initialPhase[3])) *
                     rxFieldPatternPhi * txFieldPatternPhi;
+            rayPreComp *= rayScale;
 
-            // cache the component of the "rxPhaseDiff" terms which depend on the random angle of
-            // arrivals only
-            double sinRayZoa = sin(rayZoaRadian[nIndex][mIndex]);
-            double sinRayAoa = sin(rayAoaRadian[nIndex][mIndex]);
-            double cosRayAoa = cos(rayAoaRadian[nIndex][mIndex]);
-            sinCosA[nIndex][mIndex] = sinRayZoa * cosRayAoa;
-            sinSinA[nIndex][mIndex] = sinRayZoa * sinRayAoa;
-            cosZoA[nIndex][mIndex] = cos(rayZoaRadian[nIndex][mIndex]);
-
-            // cache the component of the "txPhaseDiff" terms which depend on the random angle of
-            // departure only
-            double sinRayZod = sin(rayZodRadian[nIndex][mIndex]);
-            double sinRayAod = sin(rayAodRadian[nIndex][mIndex]);
-            double cosRayAod = cos(rayAodRadian[nIndex][mIndex]);
-            sinCosD[nIndex][mIndex] = sinRayZod * cosRayAod;
-            sinSinD[nIndex][mIndex] = sinRayZod * sinRayAod;
-            cosZoD[nIndex][mIndex] = cos(rayZodRadian[nIndex][mIndex]);
-        }
-    }
+            // the page of the (sub-)cluster of the ray (7.5-28)
+            size_t uPage = nIndex;
+            if (isStrongest)
+            {
+                switch (mIndex)
+                {
+                case 9:
+                case 10:
+                case 11:
+                case 12:
+                case 17:
+                case 18:
+                    uPage = channelParams->m_reducedClusterNumber + numSubClustersAdded;
+                    break;
+                case 13:
+                case 14:
+                case 15:
+                case 16:
+                    uPage = channelParams->m_reducedClusterNumber + numSubClustersAdded + 1;
+                    break;
+                default: // case 1,2,3,4,5,6,7,8,19,20
+                    break;
+                }
+            }
 
-    // The following for loops computes the channel coefficients
-    // Keeps track of how many sub-clusters have been added up to now
-    uint8_t numSubClustersAdded = 0;
-    for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
-    {
-        for (size_t uIndex = 0; uIndex < uSize; uIndex++)
-        {
-            Vector uLoc = uAntenna->GetElementLocation(uIndex);
+            // the "rxPhaseDiff" terms, lambda_0 is accounted in the antenna spacing uLoc
+            double sinRayZoa = sin(rayZoaRadian[nIndex][mIndex]);
+            double sinCosA = sinRayZoa * cos(rayAoaRadian[nIndex][mIndex]);
+            double sinSinA = sinRayZoa * sin(rayAoaRadian[nIndex][mIndex]);
+            double cosZoA = cos(rayZoaRadian[nIndex][mIndex]);
+            for (size_t uIndex = 0; uIndex < uSize; uIndex++)
+            {
+                const Vector& uLoc = uLocs[uIndex];
+                double rxPhaseDiff =
+                    2 * M_PI * (sinCosA * uLoc.x + sinSinA * uLoc.y + cosZoA * uLoc.z);
+                uSteering(uIndex, mIndex, uPage) =
+                    rayPreComp * std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff));
+            }
 
+            // the "txPhaseDiff" terms, lambda_0 is accounted in the antenna spacing sLoc
+            double sinRayZod = sin(rayZodRadian[nIndex][mIndex]);
+            double sinCosD = sinRayZod * cos(rayAodRadian[nIndex][mIndex]);
+            double sinSinD = sinRayZod * sin(rayAodRadian[nIndex][mIndex]);
+            double cosZoD = cos(rayZodRadian[nIndex][mIndex]);
             for (size_t sIndex = 0; sIndex < sSize; sIndex++)
             {
-                Vector sLoc = sAntenna->GetElementLocation(sIndex);
-                // Compute the N-2 weakest cluster, assuming 0 slant angle and a
-                // polarization slant angle configured in the array (7.5-22)
-                if (nIndex != channelParams->m_cluster1st && nIndex != channelParams->m_cluster2nd)
-                {
-                    std::complex<double> rays(0, 0);
-                    for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
-                    {
-                        // lambda_0 is accounted in the antenna spacing uLoc and sLoc.
-                        double rxPhaseDiff =
-                            2 * M_PI *
-                            (sinCosA[nIndex][mIndex] * uLoc.x + sinSinA[nIndex][mIndex] * uLoc.y +
-                             cosZoA[nIndex][mIndex] * uLoc.z);
-
-                        double txPhaseDiff =
-                            2 * M_PI *
-                            (sinCosD[nIndex][mIndex] * sLoc.x + sinSinD[nIndex][mIndex] * sLoc.y +
-                             cosZoD[nIndex][mIndex] * sLoc.z);
-
-                        // NOTE Doppler is computed in the CalcBeamformingGain function and is
-                        // simplified to only account for the center angle of each cluster.
-                        rays += raysPreComp(nIndex, mIndex) *
-                                std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                                std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
-                    }
-                    rays *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    hUsn(uIndex, sIndex, nIndex) = rays;
-                }
-                else //(7.5-28)
+                const Vector& sLoc = sLocs[sIndex];
+                double txPhaseDiff =
+                    2 * M_PI * (sinCosD * sLoc.x + sinSinD * sLoc.y + cosZoD * sLoc.z);
+                sSteering(mIndex, sIndex, nIndex) =
+                    std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+                if (isStrongest)
                 {
-                    std::complex<double> raysSub1(0, 0);
-                    std::complex<double> raysSub2(0, 0);
-                    std::complex<double> raysSub3(0, 0);
-
-                    for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+                    for (size_t subCluster = 0; subCluster < 2; subCluster++)
                     {
-                        // ZML:Just remind me that the angle offsets for the 3 subclusters were not
-                        // generated correctly.
-                        double rxPhaseDiff =
-                            2 * M_PI *
-                            (sinCosA[nIndex][mIndex] * uLoc.x + sinSinA[nIndex][mIndex] * uLoc.y +
-                             cosZoA[nIndex][mIndex] * uLoc.z);
-
-                        double txPhaseDiff =
-                            2 * M_PI *
-                            (sinCosD[nIndex][mIndex] * sLoc.x + sinSinD[nIndex][mIndex] * sLoc.y +
-                             cosZoD[nIndex][mIndex] * sLoc.z);
-
-                        std::complex<double> raySub =
-                            raysPreComp(nIndex, mIndex) *
-                            std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                            std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
-
-                        switch (mIndex)
-                        {
-                        case 9:
-                        case 10:
-                        case 11:
-                        case 12:
-                        case 17:
-                        case 18:
-                            raysSub2 += raySub;
-                            break;
-                        case 13:
-                        case 14:
-                        case 15:
-                        case 16:
-                            raysSub3 += raySub;
-                            break;
-                        default: // case 1,2,3,4,5,6,7,8,19,20
-                            raysSub1 += raySub;
-                            break;
-                        }
+                        sSteering(mIndex,
+                                  sIndex,
+                                  channelParams->m_reducedClusterNumber + numSubClustersAdded +
+                                      subCluster) = sSteering(mIndex, sIndex, nIndex);
                     }
-                    raysSub1 *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    raysSub2 *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    raysSub3 *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    hUsn(uIndex, sIndex, nIndex) = raysSub1;
-                    hUsn(uIndex,
-                         sIndex,
-                         channelParams->m_reducedClusterNumber + numSubClustersAdded) = raysSub2;
-                    hUsn(uIndex,
-                         sIndex,
-                         channelParams->m_reducedClusterNumber + numSubClustersAdded + 1) =
-                        raysSub3;
                 }
             }
         }
-        if (nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd)
+        if (isStrongest)
         {
             numSubClustersAdded += 2;
         }
     }
+    // NOTE Doppler is computed in the CalcBeamformingGain function and is
+    // simplified to only account for the center angle of each cluster.
+    hUsn = uSteering * sSteering;
 
     if (channelParams->m_losCondition == ChannelCondition::LOS) //(7.5-29) && (7.5-30)
     {
@@ -2106,45 +2053,45 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
         const double sinSAngleAz = sin(sAngle.GetAzimuth());
         const double cosSAngleAz = cos(sAngle.GetAzimuth());
 
+        // the field patterns do not depend on the elements
+        auto [rxFieldPatternPhi, rxFieldPatternTheta] = uAntenna->GetElementFieldPattern(
+            Angles(uAngle.GetAzimuth(), uAngle.GetInclination()));
+        auto [txFieldPatternPhi, txFieldPatternTheta] = sAntenna->GetElementFieldPattern(
+            Angles(sAngle.GetAzimuth(), sAngle.GetInclination()));
+
+        double kLinear = pow(10, channelParams->m_K_factor / 10.0);
+        // the LOS path should be attenuated if blockage is enabled.
+        std::complex<double> losCoefficient =
+            (rxFieldPatternTheta * txFieldPatternTheta - rxFieldPatternPhi * txFieldPatternPhi) *
+            phaseDiffDueToDistance * sqrt(kLinear / (1 + kLinear)) /
+            pow(10, channelParams->m_attenuation_dB[0] / 10.0);
+
+        // the LOS ray is the outer product of the u and s array responses
+        std::vector<std::complex<double>> sLosSteering(sSize);
+        for (size_t sIndex = 0; sIndex < sSize; sIndex++)
+        {
+            const Vector& sLoc = sLocs[sIndex];
+            double txPhaseDiff =
+                2 * M_PI *
+                (sinSAngleIncl * cosSAngleAz * sLoc.x + sinSAngleIncl * sinSAngleAz * sLoc.y +
+                 cosSAngleIncl * sLoc.z);
+            sLosSteering[sIndex] = std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+        }
+
+        //(7.5-30) for tau = tau2...tauN
+        hUsn = hUsn * std::complex<double>(sqrt(1.0 / (kLinear + 1)), 0);
         for (size_t uIndex = 0; uIndex < uSize; uIndex++)
         {
-            Vector uLoc = uAntenna->GetElementLocation(uIndex);
+            const Vector& uLoc = uLocs[uIndex];
             double rxPhaseDiff = 2 * M_PI *
                                  (sinUAngleIncl * cosUAngleAz * uLoc.x +
                                   sinUAngleIncl * sinUAngleAz * uLoc.y + cosUAngleIncl * uLoc.z);
-
+            std::complex<double> uLosSteering =
+                losCoefficient * std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff));
             for (size_t sIndex = 0; sIndex < sSize; sIndex++)
             {
-                Vector sLoc = sAntenna->GetElementLocation(sIndex);
-                std::complex<double> ray(0, 0);
-                double txPhaseDiff =
-                    2 * M_PI *
-                    (sinSAngleIncl * cosSAngleAz * sLoc.x + sinSAngleIncl * sinSAngleAz * sLoc.y +
-                     cosSAngleIncl * sLoc.z);
-
-                auto [rxFieldPatternPhi, rxFieldPatternTheta] = uAntenna->GetElementFieldPattern(
-                    Angles(uAngle.GetAzimuth(), uAngle.GetInclination()));
-                auto [txFieldPatternPhi, txFieldPatternTheta] = sAntenna->GetElementFieldPattern(
-                    Angles(sAngle.GetAzimuth(), sAngle.GetInclination()));
-
-                ray = (rxFieldPatternTheta * txFieldPatternTheta -
-                       rxFieldPatternPhi * txFieldPatternPhi) *
-                      phaseDiffDueToDistance *
-                      std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                      std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
-
-                double kLinear = pow(10, channelParams->m_K_factor / 10.0);
-                // the LOS path should be attenuated if blockage is enabled.
-                hUsn(uIndex, sIndex, 0) =
-                    sqrt(1.0 / (kLinear + 1)) * hUsn(uIndex, sIndex, 0) +
-                    sqrt(kLinear / (1 + kLinear)) * ray /
-                        pow(10,
-                            channelParams->m_attenuation_dB[0] / 10.0); //(7.5-30) for tau = tau1
-                for (size_t nIndex = 1; nIndex < hUsn.GetNumPages(); nIndex++)
-                {
-                    hUsn(uIndex, sIndex, nIndex) *=
-                        sqrt(1.0 / (kLinear + 1)); //(7.5-30) for tau = tau2...tauN
-                }
+                //(7.5-30) for tau = tau1
+                hUsn(uIndex, sIndex, 0) += uLosSteering * sLosSteering[sIndex];
             }
         }
     }
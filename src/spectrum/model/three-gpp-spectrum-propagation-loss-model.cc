@@ -55,6 +55,7 @@ void
 ThreeGppSpectrumPropagationLossModel::DoDispose()
 {
     m_longTermMap.clear();
+    m_delayTermsMap.clear();
     m_channelModel->Dispose();
     m_channelModel = nullptr;
 }
@@ -228,29 +229,69 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
     NS_ASSERT(numCluster <= doppler.GetSize());
 
     // apply the doppler term and the propagation delay to the long term component
-    // to obtain the beamforming gain
-    auto vit = tempPsd->ValuesBegin();      // psd iterator
-    auto sbit = tempPsd->ConstBandsBegin(); // band iterator
-    while (vit != tempPsd->ValuesEnd())
+    // to obtain the beamforming gain: the gain of each sub-band is the sum over the
+    // clusters of the delay terms, weighted by the long term and doppler terms,
+    // computed for all the sub-bands as a single matrix-vector product
+    PhasedArrayModel::ComplexVector clusterGains(numCluster);
+    for (uint16_t cIndex = 0; cIndex < numCluster; cIndex++)
+    {
+        clusterGains[cIndex] = longTerm[cIndex] * doppler[cIndex];
+    }
+    PhasedArrayModel::ComplexVector subbandGains =
+        GetDelayTerms(txPsd, channelParams, numCluster) * clusterGains;
+
+    size_t subbandIndex = 0;
+    for (auto vit = tempPsd->ValuesBegin(); vit != tempPsd->ValuesEnd(); vit++, subbandIndex++)
     {
         if ((*vit) != 0.00)
         {
-            std::complex<double> subsbandGain(0.0, 0.0);
-            double fsb = (*sbit).fc; // center frequency of the sub-band
-            for (uint16_t cIndex = 0; cIndex < numCluster; cIndex++)
-            {
-                double delay = -2 * M_PI * fsb * (channelParams->m_delay[cIndex]);
-                subsbandGain = subsbandGain + longTerm[cIndex] * doppler[cIndex] *
-                                                  std::complex<double>(cos(delay), sin(delay));
-            }
-            *vit = (*vit) * (norm(subsbandGain));
+            *vit = (*vit) * (norm(subbandGains[subbandIndex]));
         }
-        vit++;
-        sbit++;
     }
     return tempPsd;
 }
 
+const ComplexMatrixArray&
+ThreeGppSpectrumPropagationLossModel::GetDelayTerms(
+    Ptr<const SpectrumValue> psd,
+    Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams,
+    size_t numCluster) const
+{
+    NS_LOG_FUNCTION(this);
+
+    // the delays are shared by both directions of the link, and by all the
+    // antenna arrays of the two nodes
+    std::pair<uint64_t, SpectrumModelUid_t> delayTermsId(
+        MatrixBasedChannelModel::GetKey(channelParams->m_nodeIds.first,
+                                        channelParams->m_nodeIds.second),
+        psd->GetSpectrumModelUid());
+    auto it = m_delayTermsMap.find(delayTermsId);
+    if (it != m_delayTermsMap.end() && it->second->m_params == channelParams &&
+        it->second->m_delayTerms.GetNumCols() == numCluster)
+    {
+        return it->second->m_delayTerms;
+    }
+
+    NS_LOG_DEBUG("compute the delay terms");
+    NS_ASSERT(numCluster <= channelParams->m_delay.size());
+    Ptr<DelayTerms> delayTerms = Create<DelayTerms>();
+    delayTerms->m_params = channelParams;
+    delayTerms->m_delayTerms = ComplexMatrixArray(psd->GetValuesN(), numCluster);
+    size_t subbandIndex = 0;
+    for (auto sbit = psd->ConstBandsBegin(); sbit != psd->ConstBandsEnd(); sbit++, subbandIndex++)
+    {
+        double fsb = (*sbit).fc; // center frequency of the sub-band
+        for (size_t cIndex = 0; cIndex < numCluster; cIndex++)
+        {
+            double delay = -2 * M_PI * fsb * (channelParams->m_delay[cIndex]);
+            delayTerms->m_delayTerms(subbandIndex, cIndex) =
+                std::complex<double>(cos(delay), sin(delay));
+        }
+    }
+    m_delayTermsMap[delayTermsId] = delayTerms;
+    return delayTerms->m_delayTerms;
+}
+
 PhasedArrayModel::ComplexVector
 ThreeGppSpectrumPropagationLossModel::GetLongTerm(
     Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
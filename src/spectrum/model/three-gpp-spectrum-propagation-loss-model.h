@@ -142,6 +142,21 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
             m_uW; //!< the beamforming vector for the node u used to compute the long term
     };
 
+    /**
+     * Data structure that stores the delay terms of the beamforming gain for a
+     * pair of nodes and a spectrum model. They only depend on the cluster delays
+     * of the channel params, which are shared by all the antenna arrays of the
+     * two nodes and by both directions, and on the center frequencies of the
+     * sub-bands.
+     */
+    struct DelayTerms : public SimpleRefCount<DelayTerms>
+    {
+        Ptr<const MatrixBasedChannelModel::ChannelParams>
+            m_params; //!< the channel params of the cluster delays
+        ComplexMatrixArray
+            m_delayTerms; //!< the term exp(-j 2 pi fsb tau_n) of each sub-band (row) and cluster
+    };
+
     /**
      * Get the operating frequency
      * \return the operating frequency in Hz
@@ -191,8 +206,25 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
         const Vector& sSpeed,
         const Vector& uSpeed) const;
 
+    /**
+     * Looks for the delay terms of a pair of nodes and of the spectrum model
+     * of the PSD in m_delayTermsMap, and computes them if not found, or if the
+     * channel params changed. The terms of each spectrum model are kept, so
+     * that the downlink and uplink bands of FDD do not evict each other.
+     * \param psd the PSD whose sub-bands the terms are computed for
+     * \param channelParams the channel params structure
+     * \param numCluster the number of clusters of the channel matrix
+     * \return the delay terms, in a matrix of one row per sub-band and one column per cluster
+     */
+    const ComplexMatrixArray& GetDelayTerms(
+        Ptr<const SpectrumValue> psd,
+        Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams,
+        size_t numCluster) const;
+
     mutable std::unordered_map<uint64_t, Ptr<const LongTerm>>
-        m_longTermMap;                           //!< map containing the long term components
+        m_longTermMap; //!< map containing the long term components
+    mutable std::map<std::pair<uint64_t, SpectrumModelUid_t>, Ptr<const DelayTerms>>
+        m_delayTermsMap; //!< the delay terms of each pair of nodes and spectrum model
     Ptr<MatrixBasedChannelModel> m_channelModel; //!< the model to generate the channel matrix
 };
 } // namespace ns3
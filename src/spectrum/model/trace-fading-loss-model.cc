@@ -24,14 +24,13 @@
 #include "spectrum-value.h"
 
 #include "ns3/uinteger.h"
+#include <ns3/abort.h>
 #include <ns3/double.h>
 #include <ns3/log.h>
 #include <ns3/mobility-model.h>
 #include <ns3/simulator.h>
 #include <ns3/string.h>
 
-#include <fstream>
-
 namespace ns3
 {
 
@@ -48,7 +47,7 @@ TraceFadingLossModel::TraceFadingLossModel()
 
 TraceFadingLossModel::~TraceFadingLossModel()
 {
-    m_fadingTrace.clear();
+    m_fadingTrace = nullptr;
     m_windowOffsetsMap.clear();
     m_startVariableMap.clear();
 }
@@ -62,7 +61,8 @@ TraceFadingLossModel::GetTypeId()
             .SetGroupName("Spectrum")
             .AddConstructor<TraceFadingLossModel>()
             .AddAttribute("TraceFilename",
-                          "Name of file to load a trace from.",
+                          "Name of file to load a trace from, either a text trace, or a "
+                          "binary trace converted by the convert-fading-trace program.",
                           StringValue(""),
                           MakeStringAccessor(&TraceFadingLossModel::SetTraceFileName),
                           MakeStringChecker())
@@ -72,7 +72,8 @@ TraceFadingLossModel::GetTypeId()
                           MakeTimeAccessor(&TraceFadingLossModel::SetTraceLength),
                           MakeTimeChecker())
             .AddAttribute("SamplesNum",
-                          "The number of samples the trace is made of (default 10000)",
+                          "The number of samples the trace is made of (default 10000). "
+                          "Set from the header of the binary traces.",
                           UintegerValue(10000),
                           MakeUintegerAccessor(&TraceFadingLossModel::m_samplesNum),
                           MakeUintegerChecker<uint32_t>())
@@ -82,7 +83,8 @@ TraceFadingLossModel::GetTypeId()
                           MakeTimeAccessor(&TraceFadingLossModel::m_windowSize),
                           MakeTimeChecker())
             .AddAttribute("RbNum",
-                          "The number of RB the trace is made of (default 100)",
+                          "The number of RB the trace is made of (default 100). "
+                          "Set from the header of the binary traces.",
                           UintegerValue(100),
                           MakeUintegerAccessor(&TraceFadingLossModel::m_rbNum),
                           MakeUintegerChecker<uint32_t>())
@@ -120,28 +122,11 @@ void
 TraceFadingLossModel::LoadTrace()
 {
     NS_LOG_FUNCTION(this << "Loading Fading Trace " << m_traceFile);
-    std::ifstream ifTraceFile;
-    ifTraceFile.open(m_traceFile, std::ifstream::in);
-    m_fadingTrace.clear();
-    if (!ifTraceFile.good())
-    {
-        NS_LOG_INFO(this << " File: " << m_traceFile);
-        NS_ASSERT_MSG(ifTraceFile.good(), " Fading trace file not found");
-    }
-
-    //   NS_LOG_INFO (this << " length " << m_traceLength.GetSeconds ());
-    //   NS_LOG_INFO (this << " RB " << (uint32_t)m_rbNum << " samples " << m_samplesNum);
-    for (uint32_t i = 0; i < m_rbNum; i++)
-    {
-        FadingTraceSample rbTimeFadingTrace;
-        for (uint32_t j = 0; j < m_samplesNum; j++)
-        {
-            double sample;
-            ifTraceFile >> sample;
-            rbTimeFadingTrace.push_back(sample);
-        }
-        m_fadingTrace.push_back(rbTimeFadingTrace);
-    }
+    // loaded once per process, and shared by the instances using the same trace
+    m_fadingTrace = FadingTrace::Get(m_traceFile, m_rbNum, m_samplesNum);
+    NS_ABORT_MSG_IF(!m_fadingTrace, "Can't load the fading trace " << m_traceFile);
+    m_rbNum = m_fadingTrace->GetRbNum();
+    m_samplesNum = m_fadingTrace->GetSamplesNum();
     m_timeGranularity = m_traceLength.GetMilliSeconds() / m_samplesNum;
     m_lastWindowUpdate = Simulator::Now();
 }
@@ -206,17 +191,20 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity(Ptr<const SpectrumSignalParam
     // (aSpeedVector.y-bSpeedVector.y,2));
 
     NS_LOG_LOGIC(this << *rxPsd);
-    NS_ASSERT(!m_fadingTrace.empty());
+    NS_ASSERT(m_fadingTrace);
     int now_ms = static_cast<int>(Simulator::Now().GetMilliSeconds() * m_timeGranularity);
     int lastUpdate_ms = static_cast<int>(m_lastWindowUpdate.GetMilliSeconds() * m_timeGranularity);
     int index = ((*itOff).second + now_ms - lastUpdate_ms) % m_samplesNum;
+    // the RB count of a binary trace comes from its header
+    NS_ABORT_MSG_IF(rxPsd->GetValuesN() > m_rbNum,
+                    "The fading trace " << m_traceFile << " has " << m_rbNum
+                                        << " RBs, but the PSD has " << rxPsd->GetValuesN());
     int subChannel = 0;
     while (vit != rxPsd->ValuesEnd())
     {
-        NS_ASSERT(subChannel < 100);
         if (*vit != 0.)
         {
-            double fading = m_fadingTrace.at(subChannel).at(index);
+            double fading = m_fadingTrace->GetValue(subChannel, index);
             NS_LOG_INFO(this << " FADING now " << now_ms << " offset " << (*itOff).second << " id "
                              << index << " fading " << fading);
             double power = *vit;                     // in Watt/Hz
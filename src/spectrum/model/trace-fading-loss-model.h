@@ -21,6 +21,7 @@
 #ifndef TRACE_FADING_LOSS_MODEL_H
 #define TRACE_FADING_LOSS_MODEL_H
 
+#include "fading-trace.h"
 #include "spectrum-propagation-loss-model.h"
 
 #include "ns3/random-variable-stream.h"
@@ -107,18 +108,9 @@ class TraceFadingLossModel : public SpectrumPropagationLossModel
     mutable std::map<ChannelRealizationId_t, Ptr<UniformRandomVariable>>
         m_startVariableMap; ///< start variable map
 
-    /**
-     * Vector with fading samples in time domain (for a fixed RB)
-     */
-    typedef std::vector<double> FadingTraceSample;
-    /**
-     * Vector collecting the time fading traces in the frequency domain (per RB)
-     */
-    typedef std::vector<FadingTraceSample> FadingTrace;
-
     std::string m_traceFile; ///< the trace file name
 
-    FadingTrace m_fadingTrace; ///< fading trace
+    Ptr<const FadingTrace> m_fadingTrace; ///< fading trace, shared with the other instances
 
     Time m_traceLength;               ///< the trace time
     uint32_t m_samplesNum;            ///< number of samples
@@ -0,0 +1,164 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/fading-trace.h>
+#include <ns3/string.h>
+#include <ns3/test.h>
+#include <ns3/trace-fading-loss-model.h>
+#include <ns3/uinteger.h>
+
+#include <fstream>
+#include <iomanip>
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Convert a text fading trace to the binary formats, and check that
+ * the binary traces hold the samples of the text trace.
+ */
+class FadingTraceTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    FadingTraceTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \param [in] rb The RB.
+     * \param [in] sample The index of the sample.
+     * \returns The sample of the text trace.
+     */
+    static double Sample(uint32_t rb, uint32_t sample);
+};
+
+FadingTraceTestCase::FadingTraceTestCase()
+    : TestCase("Binary fading traces")
+{
+}
+
+double
+FadingTraceTestCase::Sample(uint32_t rb, uint32_t sample)
+{
+    return -10.0 * rb + 0.3125 * sample - 5.123;
+}
+
+void
+FadingTraceTestCase::DoRun()
+{
+    // the RBs of the binary traces are padded to 64 bytes
+    const uint32_t rbNum = 3;
+    const uint32_t samplesNum = 37;
+    std::string textFileName = CreateTempDirFilename("trace.fad");
+    std::ofstream text(textFileName);
+    text << std::setprecision(17);
+    for (uint32_t rb = 0; rb < rbNum; rb++)
+    {
+        for (uint32_t i = 0; i < samplesNum; i++)
+        {
+            text << Sample(rb, i) << " ";
+        }
+        text << "\n";
+    }
+    text.close();
+
+    Ptr<const FadingTrace> trace = FadingTrace::Get(textFileName, rbNum, samplesNum);
+    NS_TEST_ASSERT_MSG_NE(trace, nullptr, "Can't load the text trace");
+    NS_TEST_EXPECT_MSG_EQ(trace->GetSampleType(), FadingTrace::DOUBLE, "Wrong type");
+    NS_TEST_EXPECT_MSG_EQ(trace->GetValue(2, 36), Sample(2, 36), "Wrong sample");
+    NS_TEST_EXPECT_MSG_EQ(FadingTrace::Get(textFileName, rbNum, samplesNum),
+                          trace,
+                          "The trace is loaded again");
+    NS_TEST_EXPECT_MSG_EQ(FadingTrace::Get(textFileName, rbNum, samplesNum + 1),
+                          nullptr,
+                          "The text trace is too short");
+
+    std::string floatFileName = CreateTempDirFilename("trace-float.fadb");
+    std::string int16FileName = CreateTempDirFilename("trace-int16.fadb");
+    NS_TEST_ASSERT_MSG_EQ(FadingTrace::ConvertTextTrace(textFileName,
+                                                        floatFileName,
+                                                        rbNum,
+                                                        samplesNum,
+                                                        FadingTrace::FLOAT),
+                          true,
+                          "Can't convert the trace");
+    NS_TEST_ASSERT_MSG_EQ(FadingTrace::ConvertTextTrace(textFileName,
+                                                        int16FileName,
+                                                        rbNum,
+                                                        samplesNum,
+                                                        FadingTrace::INT16,
+                                                        0.01),
+                          true,
+                          "Can't convert the trace");
+
+    // the dimensions of the binary traces are read from their header
+    Ptr<const FadingTrace> floatTrace = FadingTrace::Get(floatFileName, 0, 0);
+    Ptr<const FadingTrace> int16Trace = FadingTrace::Get(int16FileName, 0, 0);
+    NS_TEST_ASSERT_MSG_NE(floatTrace, nullptr, "Can't load the binary trace");
+    NS_TEST_ASSERT_MSG_NE(int16Trace, nullptr, "Can't load the binary trace");
+    NS_TEST_EXPECT_MSG_EQ(floatTrace->GetSampleType(), FadingTrace::FLOAT, "Wrong type");
+    NS_TEST_EXPECT_MSG_EQ(int16Trace->GetSampleType(), FadingTrace::INT16, "Wrong type");
+    NS_TEST_EXPECT_MSG_EQ(int16Trace->GetRbNum(), rbNum, "Wrong number of RBs");
+    NS_TEST_EXPECT_MSG_EQ(int16Trace->GetSamplesNum(), samplesNum, "Wrong number of samples");
+    for (uint32_t rb = 0; rb < rbNum; rb++)
+    {
+        for (uint32_t i = 0; i < samplesNum; i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ_TOL(floatTrace->GetValue(rb, i),
+                                      Sample(rb, i),
+                                      1e-5,
+                                      "Wrong sample " << rb << " " << i);
+            NS_TEST_EXPECT_MSG_EQ_TOL(int16Trace->GetValue(rb, i),
+                                      Sample(rb, i),
+                                      0.005 + 1e-9,
+                                      "Wrong sample " << rb << " " << i);
+        }
+    }
+
+    // the models share the trace, and take its dimensions
+    Ptr<TraceFadingLossModel> model = CreateObject<TraceFadingLossModel>();
+    model->SetAttribute("TraceFilename", StringValue(int16FileName));
+    model->Initialize();
+    UintegerValue value;
+    model->GetAttribute("RbNum", value);
+    NS_TEST_EXPECT_MSG_EQ(value.Get(), rbNum, "Wrong number of RBs of the model");
+    model->GetAttribute("SamplesNum", value);
+    NS_TEST_EXPECT_MSG_EQ(value.Get(), samplesNum, "Wrong number of samples of the model");
+    NS_TEST_EXPECT_MSG_EQ(int16Trace->GetReferenceCount(), 3, "The trace is not shared");
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Fading trace test suite.
+ */
+class FadingTraceTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    FadingTraceTestSuite();
+};
+
+FadingTraceTestSuite::FadingTraceTestSuite()
+    : TestSuite("fading-trace", UNIT)
+{
+    AddTestCase(new FadingTraceTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static FadingTraceTestSuite g_fadingTraceTestSuite;
@@ -0,0 +1,140 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_TRACE_FORMAT_H
+#define BINARY_TRACE_FORMAT_H
+
+#include "binary-trace-schema.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup dataoutput
+ * The file format of the binary traces, shared by
+ * ns3::BinaryTraceWriter and ns3::BinaryTraceReader.
+ *
+ * A binary trace is a BinaryTraceFileHeader followed by blocks, each one
+ * a BinaryTraceBlockHeader followed by the (possibly compressed) content
+ * of the block. A block holds either the schema of a record type, which
+ * precedes all the records of this type, or a sequence of records, each
+ * one the uint16_t record type followed by the fields of the record.
+ * All the values are in the byte order of the host which wrote the trace.
+ */
+
+namespace ns3
+{
+
+/** The magic string of the binary traces. */
+static const char BINARY_TRACE_MAGIC[8] = {'N', 'S', '3', 'B', 'T', 'R', 'C', '\0'};
+/** The version of the format of the binary traces. */
+static const uint32_t BINARY_TRACE_VERSION = 1;
+/** The byte order mark of the binary traces. */
+static const uint32_t BINARY_TRACE_BYTE_ORDER = 0x01020304;
+
+/** The kinds of blocks. */
+enum BinaryTraceBlockKind : uint32_t
+{
+    BINARY_TRACE_BLOCK_SCHEMA = 0,  //!< The schema of a record type.
+    BINARY_TRACE_BLOCK_RECORDS = 1, //!< Records.
+};
+
+/** The compressions of the blocks. */
+enum BinaryTraceCodec : uint32_t
+{
+    BINARY_TRACE_CODEC_NONE = 0, //!< Not compressed.
+    BINARY_TRACE_CODEC_ZLIB = 1, //!< zlib (deflate) compressed.
+};
+
+/** The header of a binary trace. */
+struct BinaryTraceFileHeader
+{
+    char magic[8];      //!< BINARY_TRACE_MAGIC.
+    uint32_t version;   //!< BINARY_TRACE_VERSION.
+    uint32_t byteOrder; //!< BINARY_TRACE_BYTE_ORDER.
+};
+
+/** The header of a block. */
+struct BinaryTraceBlockHeader
+{
+    uint32_t kind;       //!< The BinaryTraceBlockKind.
+    uint32_t codec;      //!< The BinaryTraceCodec.
+    uint32_t size;       //!< The size of the content of the block.
+    uint32_t storedSize; //!< The size of the content of the block, as stored.
+    uint32_t nRecords;   //!< The number of records of the block.
+};
+
+/**
+ * Serialize the schema of a record type.
+ *
+ * \param [in] type The record type.
+ * \param [in] schema The schema.
+ * \param [in,out] buffer The buffer, to which the schema is appended.
+ */
+void BinaryTraceSerializeSchema(uint16_t type,
+                                const BinaryTraceSchema& schema,
+                                std::vector<uint8_t>& buffer);
+/**
+ * Deserialize the schema of a record type.
+ *
+ * \param [in] data The serialized schema.
+ * \param [in] size The size of the serialized schema.
+ * \param [out] type The record type.
+ * \param [out] schema The schema.
+ * \returns \c false if the serialized schema is not valid.
+ */
+bool BinaryTraceDeserializeSchema(const uint8_t* data,
+                                  uint32_t size,
+                                  uint16_t& type,
+                                  BinaryTraceSchema& schema);
+
+/**
+ * \param [in] codec A BinaryTraceCodec.
+ * \returns \c true if this build supports the codec.
+ */
+bool BinaryTraceIsCodecSupported(uint32_t codec);
+/**
+ * Compress the content of a block.
+ *
+ * \param [in] codec The BinaryTraceCodec.
+ * \param [in] data The content.
+ * \param [in] size The size of the content.
+ * \param [out] compressed The compressed content.
+ * \returns \c false if the content was not compressed to a smaller size.
+ */
+bool BinaryTraceCompress(uint32_t codec,
+                         const uint8_t* data,
+                         uint32_t size,
+                         std::vector<uint8_t>& compressed);
+/**
+ * Uncompress the content of a block.
+ *
+ * \param [in] codec The BinaryTraceCodec.
+ * \param [in] data The content, as stored.
+ * \param [in] storedSize The size of the content, as stored.
+ * \param [out] uncompressed The buffer of the content.
+ * \param [in] size The size of the content.
+ * \returns \c false if the content is not valid.
+ */
+bool BinaryTraceUncompress(uint32_t codec,
+                           const uint8_t* data,
+                           uint32_t storedSize,
+                           uint8_t* uncompressed,
+                           uint32_t size);
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_FORMAT_H */
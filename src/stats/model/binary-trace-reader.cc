@@ -0,0 +1,298 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "binary-trace-reader.h"
+
+#include "binary-trace-format.h"
+
+#include "ns3/log.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup dataoutput
+ * ns3::BinaryTraceReader implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryTraceReader");
+
+namespace
+{
+
+/**
+ * \ingroup dataoutput
+ * Print a real number with the fewest digits which read back as the same number.
+ *
+ * \tparam T \deduced The type of the number.
+ * \param [in,out] os The output stream.
+ * \param [in] value The number.
+ * \param [in] digits The number of digits which are always exact.
+ */
+template <typename T>
+void
+BinaryTracePrintReal(std::ostream& os, T value, int digits)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.*g", digits, static_cast<double>(value));
+    if (static_cast<T>(std::strtod(buffer, nullptr)) != value)
+    {
+        std::snprintf(buffer, sizeof(buffer), "%.*g", digits + 2, static_cast<double>(value));
+    }
+    os << buffer;
+}
+
+} // unnamed namespace
+
+BinaryTraceReader::BinaryTraceReader()
+    : m_size(0),
+      m_next(0),
+      m_record(0),
+      m_type(0),
+      m_fail(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+bool
+BinaryTraceReader::Open(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    Close();
+    m_file.open(filename, std::ios::in | std::ios::binary);
+    BinaryTraceFileHeader header;
+    if (!m_file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, BINARY_TRACE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != BINARY_TRACE_VERSION || header.byteOrder != BINARY_TRACE_BYTE_ORDER)
+    {
+        NS_LOG_ERROR("Can't read the binary trace " << filename);
+        m_fail = true;
+        return false;
+    }
+    return true;
+}
+
+void
+BinaryTraceReader::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_file.is_open())
+    {
+        m_file.close();
+    }
+    m_schemas.clear();
+    m_size = 0;
+    m_next = 0;
+    m_fail = false;
+}
+
+bool
+BinaryTraceReader::Fail() const
+{
+    return m_fail;
+}
+
+bool
+BinaryTraceReader::ReadBlock()
+{
+    NS_LOG_FUNCTION(this);
+    BinaryTraceBlockHeader header;
+    if (!m_file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        // the end of the trace, unless the header is truncated
+        m_fail = m_file.gcount() != 0;
+        return false;
+    }
+    if (m_block.size() < header.size)
+    {
+        m_block.resize(header.size);
+    }
+    if (header.codec == BINARY_TRACE_CODEC_NONE && header.storedSize == header.size)
+    {
+        m_file.read(reinterpret_cast<char*>(m_block.data()), header.size);
+    }
+    else
+    {
+        m_stored.resize(header.storedSize);
+        m_file.read(reinterpret_cast<char*>(m_stored.data()), header.storedSize);
+        if (m_file &&
+            !BinaryTraceUncompress(header.codec,
+                                   m_stored.data(),
+                                   header.storedSize,
+                                   m_block.data(),
+                                   header.size))
+        {
+            NS_LOG_ERROR("Can't uncompress a block with codec " << header.codec);
+            m_fail = true;
+            return false;
+        }
+    }
+    if (!m_file)
+    {
+        NS_LOG_ERROR("Truncated block");
+        m_fail = true;
+        return false;
+    }
+    m_size = header.size;
+    m_next = 0;
+    if (header.kind == BINARY_TRACE_BLOCK_SCHEMA)
+    {
+        uint16_t type;
+        BinaryTraceSchema schema;
+        if (!BinaryTraceDeserializeSchema(m_block.data(), m_size, type, schema) ||
+            type != m_schemas.size())
+        {
+            NS_LOG_ERROR("Invalid schema");
+            m_fail = true;
+            return false;
+        }
+        m_schemas.push_back(schema);
+        m_size = 0;
+    }
+    return true;
+}
+
+bool
+BinaryTraceReader::Next()
+{
+    while (m_next == m_size)
+    {
+        if (m_fail || !m_file.is_open() || !ReadBlock())
+        {
+            return false;
+        }
+    }
+    if (m_size - m_next < sizeof(m_type))
+    {
+        m_fail = true;
+        return false;
+    }
+    std::memcpy(&m_type, m_block.data() + m_next, sizeof(m_type));
+    if (m_type >= m_schemas.size() ||
+        m_size - m_next - sizeof(m_type) < m_schemas[m_type].GetRecordSize())
+    {
+        NS_LOG_ERROR("Invalid record of type " << m_type);
+        m_fail = true;
+        return false;
+    }
+    m_record = m_next + sizeof(m_type);
+    m_next = m_record + m_schemas[m_type].GetRecordSize();
+    return true;
+}
+
+uint16_t
+BinaryTraceReader::GetNTypes() const
+{
+    return m_schemas.size();
+}
+
+const BinaryTraceSchema&
+BinaryTraceReader::GetSchema(uint16_t type) const
+{
+    NS_ASSERT(type < m_schemas.size());
+    return m_schemas[type];
+}
+
+uint16_t
+BinaryTraceReader::GetType() const
+{
+    return m_type;
+}
+
+const BinaryTraceSchema&
+BinaryTraceReader::GetSchema() const
+{
+    return GetSchema(m_type);
+}
+
+const uint8_t*
+BinaryTraceReader::GetData() const
+{
+    return m_block.data() + m_record;
+}
+
+double
+BinaryTraceReader::GetAsDouble(std::size_t i) const
+{
+    switch (GetSchema().GetField(i).type)
+    {
+    case BinaryTraceSchema::UINT8:
+        return Get<uint8_t>(i);
+    case BinaryTraceSchema::UINT16:
+        return Get<uint16_t>(i);
+    case BinaryTraceSchema::UINT32:
+        return Get<uint32_t>(i);
+    case BinaryTraceSchema::UINT64:
+        return Get<uint64_t>(i);
+    case BinaryTraceSchema::INT8:
+        return Get<int8_t>(i);
+    case BinaryTraceSchema::INT16:
+        return Get<int16_t>(i);
+    case BinaryTraceSchema::INT32:
+        return Get<int32_t>(i);
+    case BinaryTraceSchema::INT64:
+        return Get<int64_t>(i);
+    case BinaryTraceSchema::FLOAT:
+        return Get<float>(i);
+    case BinaryTraceSchema::DOUBLE:
+        return Get<double>(i);
+    }
+    return 0;
+}
+
+void
+BinaryTraceReader::Print(std::ostream& os, std::size_t i) const
+{
+    switch (GetSchema().GetField(i).type)
+    {
+    case BinaryTraceSchema::UINT8:
+        os << +Get<uint8_t>(i);
+        break;
+    case BinaryTraceSchema::UINT16:
+        os << Get<uint16_t>(i);
+        break;
+    case BinaryTraceSchema::UINT32:
+        os << Get<uint32_t>(i);
+        break;
+    case BinaryTraceSchema::UINT64:
+        os << Get<uint64_t>(i);
+        break;
+    case BinaryTraceSchema::INT8:
+        os << +Get<int8_t>(i);
+        break;
+    case BinaryTraceSchema::INT16:
+        os << Get<int16_t>(i);
+        break;
+    case BinaryTraceSchema::INT32:
+        os << Get<int32_t>(i);
+        break;
+    case BinaryTraceSchema::INT64:
+        os << Get<int64_t>(i);
+        break;
+    case BinaryTraceSchema::FLOAT:
+        BinaryTracePrintReal(os, Get<float>(i), std::numeric_limits<float>::digits10);
+        break;
+    case BinaryTraceSchema::DOUBLE:
+        BinaryTracePrintReal(os, Get<double>(i), std::numeric_limits<double>::digits10);
+        break;
+    }
+}
+
+} // namespace ns3
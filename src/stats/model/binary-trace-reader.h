@@ -0,0 +1,169 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_TRACE_READER_H
+#define BINARY_TRACE_READER_H
+
+#include "binary-trace-schema.h"
+
+#include "ns3/assert.h"
+
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup dataoutput
+ * ns3::BinaryTraceReader declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup dataoutput
+ *
+ * Read the records of a binary trace written by a BinaryTraceWriter.
+ *
+ * \code
+ *   BinaryTraceReader reader;
+ *   if (!reader.Open("rsrp.bin"))
+ *   {
+ *       ...
+ *   }
+ *   while (reader.Next())
+ *   {
+ *       if (reader.GetSchema().GetName() == "Rsrp")
+ *       {
+ *           double time = reader.Get<double>(0);
+ *           ...
+ *       }
+ *   }
+ *   if (reader.Fail())
+ *   {
+ *       ...
+ *   }
+ * \endcode
+ *
+ * The reader loads one block of records at a time, and the fields are
+ * read in place.
+ */
+class BinaryTraceReader
+{
+  public:
+    BinaryTraceReader();
+
+    /**
+     * Open a binary trace and read its header.
+     *
+     * \param [in] filename The name of the file.
+     * \returns \c false if the file can't be read, or is not a binary trace
+     *          written with the byte order of this host.
+     */
+    bool Open(const std::string& filename);
+    /** Close the binary trace. */
+    void Close();
+    /**
+     * Read the next record.
+     *
+     * \returns \c false at the end of the trace, or if the trace is not valid.
+     */
+    bool Next();
+    /**
+     * \returns \c true if the trace, or the last record read, is not valid,
+     *          or if the trace uses a compression not supported by this build.
+     */
+    bool Fail() const;
+
+    /** \returns The number of record types read so far. */
+    uint16_t GetNTypes() const;
+    /**
+     * \param [in] type A record type.
+     * \returns The schema of the record type.
+     */
+    const BinaryTraceSchema& GetSchema(uint16_t type) const;
+
+    /** \returns The type of the current record. */
+    uint16_t GetType() const;
+    /** \returns The schema of the current record. */
+    const BinaryTraceSchema& GetSchema() const;
+    /** \returns The fields of the current record, as stored. */
+    const uint8_t* GetData() const;
+    /**
+     * Get a field of the current record.
+     *
+     * \tparam T \explicit The C++ type of the field.
+     * \param [in] i The index of the field.
+     * \returns The value of the field.
+     */
+    template <typename T>
+    T Get(std::size_t i) const;
+    /**
+     * Get a field of the current record, whatever its type.
+     *
+     * \param [in] i The index of the field.
+     * \returns The value of the field.
+     */
+    double GetAsDouble(std::size_t i) const;
+    /**
+     * Print a field of the current record.
+     *
+     * \param [in,out] os The output stream.
+     * \param [in] i The index of the field.
+     */
+    void Print(std::ostream& os, std::size_t i) const;
+
+  private:
+    /**
+     * Read the next block of the trace.
+     *
+     * \returns \c false at the end of the trace, or if the block is not valid.
+     */
+    bool ReadBlock();
+
+    std::ifstream m_file;                     //!< The trace file.
+    std::vector<BinaryTraceSchema> m_schemas; //!< The schemas, by record type.
+    std::vector<uint8_t> m_block;             //!< The content of the current block.
+    std::vector<uint8_t> m_stored;            //!< The compressed content of the current block.
+    uint32_t m_size;                          //!< The size of the content of the current block.
+    uint32_t m_next;                          //!< The offset of the next record in the block.
+    uint32_t m_record;                        //!< The offset of the fields of the current record.
+    uint16_t m_type;                          //!< The type of the current record.
+    bool m_fail;                              //!< Whether the trace is not valid.
+};
+
+/*************************************************************************
+ *   Implementation of the templates declared above.
+ *************************************************************************/
+
+template <typename T>
+T
+BinaryTraceReader::Get(std::size_t i) const
+{
+    const BinaryTraceSchema::Field& field = GetSchema().GetField(i);
+    NS_ASSERT_MSG(field.type == BinaryTraceSchema::GetFieldType<T>(),
+                  "Field " << field.name << " is a "
+                           << BinaryTraceSchema::GetFieldTypeName(field.type));
+    T value;
+    std::memcpy(&value, m_block.data() + m_record + field.offset, sizeof(T));
+    return value;
+}
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_READER_H */
@@ -0,0 +1,360 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "binary-trace-schema.h"
+
+#include "binary-trace-format.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <cstring>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+/**
+ * \file
+ * \ingroup dataoutput
+ * ns3::BinaryTraceSchema implementation, and the serialization
+ * of the binary traces.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryTraceSchema");
+
+BinaryTraceSchema::BinaryTraceSchema()
+    : m_size(0)
+{
+}
+
+BinaryTraceSchema::BinaryTraceSchema(const std::string& name)
+    : m_name(name),
+      m_size(0)
+{
+}
+
+BinaryTraceSchema&
+BinaryTraceSchema::AddField(const std::string& name, FieldType type)
+{
+    NS_LOG_FUNCTION(this << name << +type);
+    NS_ASSERT_MSG(GetFieldSize(type) != 0, "Invalid field type " << +type);
+    m_fields.push_back(Field{name, type, m_size});
+    m_size += GetFieldSize(type);
+    return *this;
+}
+
+const std::string&
+BinaryTraceSchema::GetName() const
+{
+    return m_name;
+}
+
+std::size_t
+BinaryTraceSchema::GetNFields() const
+{
+    return m_fields.size();
+}
+
+const BinaryTraceSchema::Field&
+BinaryTraceSchema::GetField(std::size_t i) const
+{
+    NS_ASSERT(i < m_fields.size());
+    return m_fields[i];
+}
+
+std::size_t
+BinaryTraceSchema::GetFieldIndex(const std::string& name) const
+{
+    std::size_t i = 0;
+    while (i < m_fields.size() && m_fields[i].name != name)
+    {
+        i++;
+    }
+    return i;
+}
+
+uint32_t
+BinaryTraceSchema::GetRecordSize() const
+{
+    return m_size;
+}
+
+uint32_t
+BinaryTraceSchema::GetFieldSize(FieldType type)
+{
+    switch (type)
+    {
+    case UINT8:
+    case INT8:
+        return 1;
+    case UINT16:
+    case INT16:
+        return 2;
+    case UINT32:
+    case INT32:
+    case FLOAT:
+        return 4;
+    case UINT64:
+    case INT64:
+    case DOUBLE:
+        return 8;
+    }
+    return 0;
+}
+
+std::string
+BinaryTraceSchema::GetFieldTypeName(FieldType type)
+{
+    switch (type)
+    {
+    case UINT8:
+        return "uint8";
+    case UINT16:
+        return "uint16";
+    case UINT32:
+        return "uint32";
+    case UINT64:
+        return "uint64";
+    case INT8:
+        return "int8";
+    case INT16:
+        return "int16";
+    case INT32:
+        return "int32";
+    case INT64:
+        return "int64";
+    case FLOAT:
+        return "float";
+    case DOUBLE:
+        return "double";
+    }
+    return "invalid";
+}
+
+bool
+operator==(const BinaryTraceSchema& a, const BinaryTraceSchema& b)
+{
+    if (a.GetName() != b.GetName() || a.GetNFields() != b.GetNFields())
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.GetNFields(); i++)
+    {
+        if (a.GetField(i).name != b.GetField(i).name || a.GetField(i).type != b.GetField(i).type)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace
+{
+
+/**
+ * Append a value to a buffer.
+ *
+ * \tparam T \deduced The type of the value.
+ * \param [in,out] buffer The buffer.
+ * \param [in] value The value.
+ */
+template <typename T>
+void
+BinaryTraceAppend(std::vector<uint8_t>& buffer, T value)
+{
+    std::size_t size = buffer.size();
+    buffer.resize(size + sizeof(T));
+    std::memcpy(buffer.data() + size, &value, sizeof(T));
+}
+
+/**
+ * Append a string, preceded by its length, to a buffer.
+ *
+ * \param [in,out] buffer The buffer.
+ * \param [in] s The string.
+ */
+void
+BinaryTraceAppendString(std::vector<uint8_t>& buffer, const std::string& s)
+{
+    NS_ASSERT(s.size() <= UINT16_MAX);
+    BinaryTraceAppend<uint16_t>(buffer, s.size());
+    buffer.insert(buffer.end(), s.begin(), s.end());
+}
+
+/**
+ * Read a value from a buffer.
+ *
+ * \tparam T \deduced The type of the value.
+ * \param [in,out] data The buffer, advanced past the value.
+ * \param [in,out] size The size of the buffer, decreased by the size of the value.
+ * \param [out] value The value.
+ * \returns \c false if the buffer is too short.
+ */
+template <typename T>
+bool
+BinaryTraceExtract(const uint8_t*& data, uint32_t& size, T& value)
+{
+    if (size < sizeof(T))
+    {
+        return false;
+    }
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    size -= sizeof(T);
+    return true;
+}
+
+/**
+ * Read a string, preceded by its length, from a buffer.
+ *
+ * \param [in,out] data The buffer, advanced past the string.
+ * \param [in,out] size The size of the buffer, decreased by the size of the string.
+ * \param [out] s The string.
+ * \returns \c false if the buffer is too short.
+ */
+bool
+BinaryTraceExtractString(const uint8_t*& data, uint32_t& size, std::string& s)
+{
+    uint16_t length;
+    if (!BinaryTraceExtract(data, size, length) || size < length)
+    {
+        return false;
+    }
+    s.assign(reinterpret_cast<const char*>(data), length);
+    data += length;
+    size -= length;
+    return true;
+}
+
+} // unnamed namespace
+
+void
+BinaryTraceSerializeSchema(uint16_t type,
+                           const BinaryTraceSchema& schema,
+                           std::vector<uint8_t>& buffer)
+{
+    BinaryTraceAppend(buffer, type);
+    BinaryTraceAppendString(buffer, schema.GetName());
+    BinaryTraceAppend<uint16_t>(buffer, schema.GetNFields());
+    for (std::size_t i = 0; i < schema.GetNFields(); i++)
+    {
+        BinaryTraceAppend<uint8_t>(buffer, schema.GetField(i).type);
+        BinaryTraceAppendString(buffer, schema.GetField(i).name);
+    }
+}
+
+bool
+BinaryTraceDeserializeSchema(const uint8_t* data,
+                             uint32_t size,
+                             uint16_t& type,
+                             BinaryTraceSchema& schema)
+{
+    std::string name;
+    uint16_t nFields;
+    if (!BinaryTraceExtract(data, size, type) || !BinaryTraceExtractString(data, size, name) ||
+        !BinaryTraceExtract(data, size, nFields))
+    {
+        return false;
+    }
+    schema = BinaryTraceSchema(name);
+    for (uint16_t i = 0; i < nFields; i++)
+    {
+        uint8_t fieldType;
+        std::string fieldName;
+        if (!BinaryTraceExtract(data, size, fieldType) ||
+            !BinaryTraceExtractString(data, size, fieldName) ||
+            BinaryTraceSchema::GetFieldSize(BinaryTraceSchema::FieldType(fieldType)) == 0)
+        {
+            return false;
+        }
+        schema.AddField(fieldName, BinaryTraceSchema::FieldType(fieldType));
+    }
+    return size == 0;
+}
+
+bool
+BinaryTraceIsCodecSupported(uint32_t codec)
+{
+    switch (codec)
+    {
+    case BINARY_TRACE_CODEC_NONE:
+        return true;
+#ifdef HAVE_ZLIB
+    case BINARY_TRACE_CODEC_ZLIB:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+bool
+BinaryTraceCompress(uint32_t codec,
+                    const uint8_t* data,
+                    uint32_t size,
+                    std::vector<uint8_t>& compressed)
+{
+    switch (codec)
+    {
+#ifdef HAVE_ZLIB
+    case BINARY_TRACE_CODEC_ZLIB: {
+        uLongf compressedSize = compressBound(size);
+        compressed.resize(compressedSize);
+        if (compress2(compressed.data(), &compressedSize, data, size, Z_BEST_SPEED) != Z_OK)
+        {
+            return false;
+        }
+        compressed.resize(compressedSize);
+        return compressedSize < size;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+bool
+BinaryTraceUncompress(uint32_t codec,
+                      const uint8_t* data,
+                      uint32_t storedSize,
+                      uint8_t* uncompressed,
+                      uint32_t size)
+{
+    switch (codec)
+    {
+    case BINARY_TRACE_CODEC_NONE:
+        if (storedSize != size)
+        {
+            return false;
+        }
+        std::memcpy(uncompressed, data, size);
+        return true;
+#ifdef HAVE_ZLIB
+    case BINARY_TRACE_CODEC_ZLIB: {
+        uLongf uncompressedSize = size;
+        return uncompress(uncompressed, &uncompressedSize, data, storedSize) == Z_OK &&
+               uncompressedSize == size;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+} // namespace ns3
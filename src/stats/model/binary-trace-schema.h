@@ -0,0 +1,202 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_TRACE_SCHEMA_H
+#define BINARY_TRACE_SCHEMA_H
+
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup dataoutput
+ * ns3::BinaryTraceSchema declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup dataoutput
+ *
+ * The description of a type of record of a binary trace: the name of the
+ * record type, and the names and types of its fields.
+ *
+ * The fields of a record are stored one after the other, in the order in
+ * which they are added to the schema, without padding and in the byte
+ * order of the host which wrote the trace.
+ *
+ * \code
+ *   BinaryTraceSchema schema("DlRsrpSinr");
+ *   schema.AddField<double>("time").AddField<uint16_t>("cellId").AddField<double>("rsrp");
+ * \endcode
+ */
+class BinaryTraceSchema
+{
+  public:
+    /** The type of a field. */
+    enum FieldType : uint8_t
+    {
+        UINT8 = 1, //!< uint8_t
+        UINT16,    //!< uint16_t
+        UINT32,    //!< uint32_t
+        UINT64,    //!< uint64_t
+        INT8,      //!< int8_t
+        INT16,     //!< int16_t
+        INT32,     //!< int32_t
+        INT64,     //!< int64_t
+        FLOAT,     //!< float
+        DOUBLE     //!< double
+    };
+
+    /** A field of the records. */
+    struct Field
+    {
+        std::string name; //!< The name of the field.
+        FieldType type;   //!< The type of the field.
+        uint32_t offset;  //!< The offset of the field in the records.
+    };
+
+    /** Default constructor, of a schema without name nor fields. */
+    BinaryTraceSchema();
+    /**
+     * Constructor.
+     *
+     * \param [in] name The name of the record type.
+     */
+    BinaryTraceSchema(const std::string& name);
+
+    /**
+     * Add a field to the records.
+     *
+     * \param [in] name The name of the field.
+     * \param [in] type The type of the field.
+     * \returns This schema.
+     */
+    BinaryTraceSchema& AddField(const std::string& name, FieldType type);
+    /**
+     * Add a field to the records.
+     *
+     * \tparam T \explicit The C++ type of the field.
+     * \param [in] name The name of the field.
+     * \returns This schema.
+     */
+    template <typename T>
+    BinaryTraceSchema& AddField(const std::string& name);
+
+    /** \returns The name of the record type. */
+    const std::string& GetName() const;
+    /** \returns The number of fields. */
+    std::size_t GetNFields() const;
+    /**
+     * \param [in] i The index of a field.
+     * \returns The field.
+     */
+    const Field& GetField(std::size_t i) const;
+    /**
+     * \param [in] name The name of a field.
+     * \returns The index of the field, or GetNFields() if there is none with this name.
+     */
+    std::size_t GetFieldIndex(const std::string& name) const;
+    /** \returns The size of the records, in bytes. */
+    uint32_t GetRecordSize() const;
+
+    /**
+     * Check that the types of the values of a record match the schema.
+     *
+     * \tparam Args \deduced The C++ types of the values.
+     * \returns \c true if the values match the fields.
+     */
+    template <typename... Args>
+    bool Matches() const;
+
+    /**
+     * \tparam T \explicit A C++ type.
+     * \returns The FieldType of the C++ type.
+     */
+    template <typename T>
+    static constexpr FieldType GetFieldType();
+    /**
+     * \param [in] type A field type.
+     * \returns The size of the field type, in bytes, or 0 if the type is not valid.
+     */
+    static uint32_t GetFieldSize(FieldType type);
+    /**
+     * \param [in] type A field type.
+     * \returns The name of the field type, e.g. "uint16" or "double".
+     */
+    static std::string GetFieldTypeName(FieldType type);
+
+  private:
+    std::string m_name;          //!< The name of the record type.
+    std::vector<Field> m_fields; //!< The fields.
+    uint32_t m_size;             //!< The size of the records.
+};
+
+/**
+ * \returns \c true if the schemas describe the same records.
+ * \param [in] a A schema.
+ * \param [in] b Another schema.
+ */
+bool operator==(const BinaryTraceSchema& a, const BinaryTraceSchema& b);
+
+/*************************************************************************
+ *   Implementation of the templates declared above.
+ *************************************************************************/
+
+template <typename T>
+constexpr BinaryTraceSchema::FieldType
+BinaryTraceSchema::GetFieldType()
+{
+    static_assert(std::is_arithmetic_v<T> && sizeof(T) <= 8, "Unsupported field type");
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Unsupported field type");
+        return sizeof(T) == 4 ? FLOAT : DOUBLE;
+    }
+    else if constexpr (std::is_signed_v<T>)
+    {
+        return sizeof(T) == 1 ? INT8 : sizeof(T) == 2 ? INT16 : sizeof(T) == 4 ? INT32 : INT64;
+    }
+    else
+    {
+        return sizeof(T) == 1 ? UINT8 : sizeof(T) == 2 ? UINT16 : sizeof(T) == 4 ? UINT32 : UINT64;
+    }
+}
+
+template <typename T>
+BinaryTraceSchema&
+BinaryTraceSchema::AddField(const std::string& name)
+{
+    return AddField(name, GetFieldType<T>());
+}
+
+template <typename... Args>
+bool
+BinaryTraceSchema::Matches() const
+{
+    if (sizeof...(Args) != m_fields.size())
+    {
+        return false;
+    }
+    std::size_t i = 0;
+    return ((m_fields[i++].type == GetFieldType<Args>()) && ...);
+}
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_SCHEMA_H */
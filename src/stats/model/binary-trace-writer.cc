@@ -0,0 +1,374 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "binary-trace-writer.h"
+
+#include "binary-trace-format.h"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
+/**
+ * \file
+ * \ingroup dataoutput
+ * ns3::BinaryTraceWriter implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryTraceWriter");
+
+NS_OBJECT_ENSURE_REGISTERED(BinaryTraceWriter);
+
+TypeId
+BinaryTraceWriter::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::BinaryTraceWriter")
+            .SetParent<Object>()
+            .SetGroupName("Stats")
+            .AddConstructor<BinaryTraceWriter>()
+            .AddAttribute("BlockSize",
+                          "The size, in bytes, of the blocks of records which are "
+                          "compressed and written at once.",
+                          UintegerValue(256 * 1024),
+                          MakeUintegerAccessor(&BinaryTraceWriter::m_blockSize),
+                          MakeUintegerChecker<uint32_t>(1024))
+            .AddAttribute("Compression",
+                          "The compression of the blocks.",
+                          EnumValue(BinaryTraceWriter::NONE),
+                          MakeEnumAccessor(&BinaryTraceWriter::m_compression),
+                          MakeEnumChecker(BinaryTraceWriter::NONE,
+                                          "None",
+                                          BinaryTraceWriter::ZLIB,
+                                          "Zlib"))
+            .AddAttribute("FlushThread",
+                          "Whether the blocks are compressed and written by a "
+                          "background thread.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&BinaryTraceWriter::m_useFlushThread),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+BinaryTraceWriter::BinaryTraceWriter()
+    : m_blockSize(256 * 1024),
+      m_compression(NONE),
+      m_useFlushThread(false),
+      m_writing(0),
+      m_stop(false)
+{
+    NS_LOG_FUNCTION(this);
+#ifdef NS3_MTP
+    static std::atomic<uint64_t> nextId{1};
+    m_id = nextId++;
+#else
+    m_slot.block = nullptr;
+#endif
+}
+
+BinaryTraceWriter::~BinaryTraceWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+    for (auto block : m_free)
+    {
+        delete block;
+    }
+}
+
+void
+BinaryTraceWriter::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+    Object::DoDispose();
+}
+
+bool
+BinaryTraceWriter::IsSupported(Compression compression)
+{
+    return BinaryTraceIsCodecSupported(compression == ZLIB ? BINARY_TRACE_CODEC_ZLIB
+                                                           : BINARY_TRACE_CODEC_NONE);
+}
+
+void
+BinaryTraceWriter::Open(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    NS_ABORT_MSG_IF(IsOpen(), "The binary trace " << m_filename << " is already open");
+    NS_ABORT_MSG_UNLESS(IsSupported(m_compression),
+                        "This build does not support the compression of the binary traces");
+    m_file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(), "Can't open file " << filename);
+    m_filename = filename;
+
+    BinaryTraceFileHeader header;
+    std::memcpy(header.magic, BINARY_TRACE_MAGIC, sizeof(header.magic));
+    header.version = BINARY_TRACE_VERSION;
+    header.byteOrder = BINARY_TRACE_BYTE_ORDER;
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // the schemas of a previous trace are written again
+    std::deque<BinaryTraceSchema> schemas;
+    schemas.swap(m_schemas);
+    for (const auto& schema : schemas)
+    {
+        AddSchema(schema);
+    }
+
+#ifndef NS3_MTP
+    m_slot.block = AllocateBlock(m_blockSize);
+#endif
+    m_stop = false;
+    if (m_useFlushThread)
+    {
+        m_thread = std::thread(&BinaryTraceWriter::RunFlushThread, this);
+    }
+}
+
+bool
+BinaryTraceWriter::IsOpen() const
+{
+    return m_file.is_open();
+}
+
+uint16_t
+BinaryTraceWriter::AddSchema(const BinaryTraceSchema& schema)
+{
+    NS_LOG_FUNCTION(this << schema.GetName());
+    NS_ABORT_MSG_IF(m_schemas.size() > UINT16_MAX, "Too many record types");
+    auto type = static_cast<uint16_t>(m_schemas.size());
+    m_schemas.push_back(schema);
+    if (IsOpen())
+    {
+        std::vector<uint8_t> buffer;
+        BinaryTraceSerializeSchema(type, schema, buffer);
+        Block* block = AllocateBlock(buffer.size());
+        std::memcpy(block->data.data(), buffer.data(), buffer.size());
+        block->size = buffer.size();
+        block->kind = BINARY_TRACE_BLOCK_SCHEMA;
+        SubmitBlock(block);
+    }
+    return type;
+}
+
+const BinaryTraceSchema&
+BinaryTraceWriter::GetSchema(uint16_t type) const
+{
+    NS_ASSERT(type < m_schemas.size());
+    return m_schemas[type];
+}
+
+#ifdef NS3_MTP
+BinaryTraceWriter::Slot*
+BinaryTraceWriter::GetThreadSlot()
+{
+    // The writers never reuse an id, so the cache of a thread is never stale
+    static thread_local std::pair<uint64_t, Slot*> cache{0, nullptr};
+    if (cache.first != m_id)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::unique_ptr<Slot>& slot = m_slots[std::this_thread::get_id()];
+        if (!slot)
+        {
+            slot = std::make_unique<Slot>();
+            slot->block = nullptr;
+        }
+        cache = {m_id, slot.get()};
+    }
+    if (cache.second->block == nullptr)
+    {
+        cache.second->block = AllocateBlock(m_blockSize);
+    }
+    return cache.second;
+}
+#endif
+
+BinaryTraceWriter::Block*
+BinaryTraceWriter::RenewBlock(Slot* slot, uint32_t size)
+{
+    NS_LOG_FUNCTION(this << slot << size);
+    SubmitBlock(slot->block);
+    slot->block = AllocateBlock(std::max(m_blockSize, size));
+    return slot->block;
+}
+
+BinaryTraceWriter::Block*
+BinaryTraceWriter::AllocateBlock(uint32_t capacity)
+{
+    Block* block = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_free.empty())
+        {
+            block = m_free.back();
+            m_free.pop_back();
+        }
+    }
+    if (block == nullptr)
+    {
+        block = new Block;
+    }
+    if (block->data.size() < capacity)
+    {
+        block->data.resize(capacity);
+    }
+    block->size = 0;
+    block->nRecords = 0;
+    block->kind = BINARY_TRACE_BLOCK_RECORDS;
+    return block;
+}
+
+void
+BinaryTraceWriter::SubmitBlock(Block* block)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_thread.joinable())
+    {
+        m_written.wait(lock, [this]() { return m_queue.size() < MAX_QUEUED_BLOCKS; });
+        m_queue.push_back(block);
+        m_queued.notify_one();
+    }
+    else
+    {
+        WriteBlock(block);
+        m_free.push_back(block);
+    }
+}
+
+void
+BinaryTraceWriter::WriteBlock(Block* block)
+{
+    NS_LOG_FUNCTION(this << block->size << block->nRecords);
+    BinaryTraceBlockHeader header;
+    header.kind = block->kind;
+    header.codec = BINARY_TRACE_CODEC_NONE;
+    header.size = block->size;
+    header.storedSize = block->size;
+    header.nRecords = block->nRecords;
+    const uint8_t* data = block->data.data();
+    if (m_compression == ZLIB &&
+        BinaryTraceCompress(BINARY_TRACE_CODEC_ZLIB, data, block->size, m_compressed))
+    {
+        header.codec = BINARY_TRACE_CODEC_ZLIB;
+        header.storedSize = m_compressed.size();
+        data = m_compressed.data();
+    }
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    m_file.write(reinterpret_cast<const char*>(data), header.storedSize);
+}
+
+void
+BinaryTraceWriter::RunFlushThread()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_queued.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty())
+        {
+            return;
+        }
+        Block* block = m_queue.front();
+        m_queue.pop_front();
+        m_writing++;
+        // only this thread writes to the file, while the simulation fills the other blocks
+        lock.unlock();
+        WriteBlock(block);
+        lock.lock();
+        m_writing--;
+        m_free.push_back(block);
+        m_written.notify_all();
+    }
+}
+
+void
+BinaryTraceWriter::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (!IsOpen())
+    {
+        return;
+    }
+    std::vector<Slot*> slots;
+#ifdef NS3_MTP
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& [id, slot] : m_slots)
+        {
+            slots.push_back(slot.get());
+        }
+    }
+#else
+    slots.push_back(&m_slot);
+#endif
+    for (auto slot : slots)
+    {
+        if (slot->block != nullptr && slot->block->size > 0)
+        {
+            RenewBlock(slot, 0);
+        }
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_written.wait(lock, [this]() { return m_queue.empty() && m_writing == 0; });
+    m_file.flush();
+}
+
+void
+BinaryTraceWriter::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (!IsOpen())
+    {
+        return;
+    }
+    Flush();
+    if (m_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+            m_queued.notify_one();
+        }
+        m_thread.join();
+    }
+#ifdef NS3_MTP
+    for (auto& [id, slot] : m_slots)
+    {
+        if (slot->block != nullptr)
+        {
+            m_free.push_back(slot->block);
+            slot->block = nullptr;
+        }
+    }
+#else
+    m_free.push_back(m_slot.block);
+    m_slot.block = nullptr;
+#endif
+    m_file.close();
+}
+
+} // namespace ns3
@@ -0,0 +1,265 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_TRACE_WRITER_H
+#define BINARY_TRACE_WRITER_H
+
+#include "binary-trace-schema.h"
+
+#include "ns3/assert.h"
+#include "ns3/object.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef NS3_MTP
+#include <unordered_map>
+#endif
+
+/**
+ * \file
+ * \ingroup dataoutput
+ * ns3::BinaryTraceWriter declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup dataoutput
+ *
+ * Write typed records to a binary trace file.
+ *
+ * Each record type is described by a BinaryTraceSchema, registered with
+ * AddSchema(), and the records are appended with Write(), which copies the
+ * values of the fields to a buffer without formatting them:
+ *
+ * \code
+ *   Ptr<BinaryTraceWriter> writer = CreateObject<BinaryTraceWriter>();
+ *   writer->Open("rsrp.bin");
+ *   uint16_t rsrp = writer->AddSchema(BinaryTraceSchema("Rsrp")
+ *                                         .AddField<double>("time")
+ *                                         .AddField<uint16_t>("cellId")
+ *                                         .AddField<double>("rsrp"));
+ *   writer->Write(rsrp, Simulator::Now().GetSeconds(), cellId, rsrp);
+ * \endcode
+ *
+ * The types of the values passed to Write() must be the types of the
+ * fields of the schema (this is asserted).
+ *
+ * The records are buffered in blocks of \c BlockSize bytes, which are
+ * written to the file when they are full, optionally compressed. With the
+ * \c FlushThread attribute, the blocks are compressed and written by a
+ * background thread, while the simulation fills the next blocks. When ns-3
+ * is configured with \c --enable-mtp, each thread appends to its own
+ * blocks, so the records of different threads may be interleaved by block
+ * in the file; the records of a thread stay in order.
+ *
+ * The traces are read back by the BinaryTraceReader, and converted to CSV
+ * or column files by the \c convert-binary-trace program of \c utils.
+ */
+class BinaryTraceWriter : public Object
+{
+  public:
+    /** The compression of the blocks. */
+    enum Compression
+    {
+        NONE, //!< Not compressed.
+        ZLIB  //!< zlib (deflate) compressed, if ns-3 is built with zlib.
+    };
+
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    BinaryTraceWriter();
+    ~BinaryTraceWriter() override;
+
+    /**
+     * Create the trace file and write its header.
+     *
+     * \param [in] filename The name of the file.
+     */
+    void Open(const std::string& filename);
+    /** \returns \c true if the trace file is open. */
+    bool IsOpen() const;
+    /**
+     * Register a record type.
+     *
+     * \param [in] schema The schema of the records.
+     * \returns The record type, to pass to Write().
+     */
+    uint16_t AddSchema(const BinaryTraceSchema& schema);
+    /**
+     * \param [in] type A record type.
+     * \returns The schema of the record type.
+     */
+    const BinaryTraceSchema& GetSchema(uint16_t type) const;
+    /**
+     * Append a record.
+     *
+     * \tparam Args \deduced The types of the fields.
+     * \param [in] type The record type.
+     * \param [in] values The values of the fields.
+     */
+    template <typename... Args>
+    void Write(uint16_t type, Args... values);
+    /**
+     * Write the records appended so far to the file.
+     *
+     * When ns-3 is configured with \c --enable-mtp, this method must not be
+     * called while other threads append records.
+     */
+    void Flush();
+    /** Flush the records and close the trace file. */
+    void Close();
+
+    /**
+     * \param [in] compression A compression.
+     * \returns \c true if this build supports the compression.
+     */
+    static bool IsSupported(Compression compression);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /** A block of records. */
+    struct Block
+    {
+        std::vector<uint8_t> data; //!< The buffer, whose size is the capacity of the block.
+        uint32_t size;             //!< The size of the content.
+        uint32_t nRecords;         //!< The number of records.
+        uint32_t kind;             //!< The kind of block.
+    };
+
+    /** The block of a thread. */
+    struct Slot
+    {
+        Block* block; //!< The block being filled, or \c nullptr.
+    };
+
+    /** \returns The slot of this thread. */
+    Slot* GetSlot();
+#ifdef NS3_MTP
+    /** \returns The slot of this thread, looked up in \c m_slots. */
+    Slot* GetThreadSlot();
+#endif
+    /**
+     * Submit the block of a slot, and replace it with a new block.
+     *
+     * \param [in] slot The slot.
+     * \param [in] size The size of the record which does not fit in the block.
+     * \returns The new block.
+     */
+    Block* RenewBlock(Slot* slot, uint32_t size);
+    /**
+     * Get an empty block.
+     *
+     * \param [in] capacity The minimum capacity of the block.
+     * \returns The block.
+     */
+    Block* AllocateBlock(uint32_t capacity);
+    /**
+     * Queue a block to be written, or write it.
+     *
+     * \param [in] block The block, which is recycled once written.
+     */
+    void SubmitBlock(Block* block);
+    /**
+     * Write a block to the file, with \c m_mutex unlocked if called by the flush thread.
+     *
+     * \param [in] block The block.
+     */
+    void WriteBlock(Block* block);
+    /** Write the queued blocks to the file, until Close(). */
+    void RunFlushThread();
+
+    /** The maximum number of blocks queued for the flush thread. */
+    static const std::size_t MAX_QUEUED_BLOCKS = 16;
+
+    uint32_t m_blockSize;                    //!< The size of the blocks.
+    Compression m_compression;               //!< The compression of the blocks.
+    bool m_useFlushThread;                   //!< Whether the blocks are written by a thread.
+    std::string m_filename;                  //!< The name of the trace file.
+    std::ofstream m_file;                    //!< The trace file.
+    std::deque<BinaryTraceSchema> m_schemas; //!< The schemas, by record type.
+#ifdef NS3_MTP
+    /** The unique id of this writer, which tags the slot caches of the threads. */
+    uint64_t m_id;
+    /** The slots of the threads. */
+    std::unordered_map<std::thread::id, std::unique_ptr<Slot>> m_slots;
+#else
+    Slot m_slot; //!< The slot of the simulation.
+#endif
+    std::mutex m_mutex;                //!< Protects the blocks and the file.
+    std::condition_variable m_queued;  //!< Signaled when a block is queued, or on Close().
+    std::condition_variable m_written; //!< Signaled when a queued block is written.
+    std::deque<Block*> m_queue;        //!< The blocks to be written by the flush thread.
+    std::size_t m_writing;             //!< The number of blocks being written.
+    std::vector<Block*> m_free;        //!< The recycled blocks.
+    std::vector<uint8_t> m_compressed; //!< The buffer of the compressed blocks.
+    std::thread m_thread;              //!< The flush thread.
+    bool m_stop;                       //!< Whether the flush thread must stop.
+};
+
+/*************************************************************************
+ *   Implementation of the templates declared above.
+ *************************************************************************/
+
+inline BinaryTraceWriter::Slot*
+BinaryTraceWriter::GetSlot()
+{
+#ifdef NS3_MTP
+    return GetThreadSlot();
+#else
+    return &m_slot;
+#endif
+}
+
+template <typename... Args>
+void
+BinaryTraceWriter::Write(uint16_t type, Args... values)
+{
+    NS_ASSERT_MSG(IsOpen(), "The binary trace is not open");
+    NS_ASSERT_MSG(type < m_schemas.size() && m_schemas[type].template Matches<Args...>(),
+                  "The values do not match the schema of the record type " << type);
+    constexpr uint32_t size = sizeof(type) + (0 + ... + sizeof(Args));
+    Slot* slot = GetSlot();
+    Block* block = slot->block;
+    if (block->size + size > block->data.size())
+    {
+        block = RenewBlock(slot, size);
+    }
+    uint8_t* p = block->data.data() + block->size;
+    std::memcpy(p, &type, sizeof(type));
+    p += sizeof(type);
+    ((std::memcpy(p, &values, sizeof(Args)), p += sizeof(Args)), ...);
+    block->size += size;
+    block->nRecords++;
+}
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_WRITER_H */
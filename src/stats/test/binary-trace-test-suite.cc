@@ -0,0 +1,196 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/binary-trace-reader.h"
+#include "ns3/binary-trace-writer.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <cstdio>
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Write a binary trace and read it back.
+ */
+class BinaryTraceTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param compression the compression of the blocks
+     * \param flushThread whether the blocks are written by a thread
+     */
+    BinaryTraceTestCase(BinaryTraceWriter::Compression compression, bool flushThread);
+
+  private:
+    void DoRun() override;
+
+    BinaryTraceWriter::Compression m_compression; //!< The compression of the blocks.
+    bool m_flushThread;                           //!< Whether the blocks are written by a thread.
+};
+
+BinaryTraceTestCase::BinaryTraceTestCase(BinaryTraceWriter::Compression compression,
+                                         bool flushThread)
+    : TestCase(std::string("Write and read a binary trace, compression ") +
+               (compression == BinaryTraceWriter::ZLIB ? "zlib" : "none") +
+               (flushThread ? ", with a flush thread" : "")),
+      m_compression(compression),
+      m_flushThread(flushThread)
+{
+}
+
+void
+BinaryTraceTestCase::DoRun()
+{
+    const uint32_t nRecords = 20000;
+    std::string filename = CreateTempDirFilename("binary-trace-test.bin");
+
+    Ptr<BinaryTraceWriter> writer = CreateObject<BinaryTraceWriter>();
+    // small blocks, to have many of them
+    writer->SetAttribute("BlockSize", UintegerValue(1024));
+    writer->SetAttribute("Compression", EnumValue(m_compression));
+    writer->SetAttribute("FlushThread", BooleanValue(m_flushThread));
+    writer->Open(filename);
+    uint16_t sinr = writer->AddSchema(BinaryTraceSchema("Sinr")
+                                          .AddField<double>("time")
+                                          .AddField<uint16_t>("cellId")
+                                          .AddField<uint64_t>("imsi")
+                                          .AddField<float>("sinr"));
+    for (uint32_t i = 0; i < nRecords; i++)
+    {
+        writer->Write(sinr, i * 0.001, static_cast<uint16_t>(i % 7), uint64_t(i), i * 0.5f);
+        if (i == nRecords / 2)
+        {
+            // a record type added while writing
+            uint16_t handover = writer->AddSchema(BinaryTraceSchema("Handover")
+                                                      .AddField<int64_t>("time")
+                                                      .AddField<uint8_t>("target"));
+            NS_TEST_ASSERT_MSG_EQ(handover, 1, "Wrong record type");
+            writer->Write(handover, int64_t(-1), uint8_t(3));
+        }
+    }
+    writer->Dispose();
+    NS_TEST_ASSERT_MSG_EQ(writer->IsOpen(), false, "Trace not closed by Dispose");
+
+    BinaryTraceReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(filename), true, "Can't open the trace");
+    uint32_t i = 0;
+    bool handover = false;
+    while (reader.Next())
+    {
+        if (reader.GetSchema().GetName() == "Handover")
+        {
+            NS_TEST_EXPECT_MSG_EQ(i, nRecords / 2 + 1, "Handover record out of order");
+            NS_TEST_EXPECT_MSG_EQ(reader.Get<int64_t>(0), -1, "Wrong time");
+            NS_TEST_EXPECT_MSG_EQ(+reader.Get<uint8_t>(1), 3, "Wrong target");
+            handover = true;
+            continue;
+        }
+        NS_TEST_ASSERT_MSG_EQ(reader.GetType(), 0, "Wrong record type");
+        NS_TEST_EXPECT_MSG_EQ(reader.Get<double>(0), i * 0.001, "Wrong time");
+        NS_TEST_EXPECT_MSG_EQ(reader.Get<uint16_t>(1), i % 7, "Wrong cell id");
+        NS_TEST_EXPECT_MSG_EQ(reader.Get<uint64_t>(2), i, "Wrong IMSI");
+        NS_TEST_EXPECT_MSG_EQ(reader.GetAsDouble(3), i * 0.5, "Wrong SINR");
+        i++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(reader.Fail(), false, "Invalid trace");
+    NS_TEST_EXPECT_MSG_EQ(i, nRecords, "Wrong number of records");
+    NS_TEST_EXPECT_MSG_EQ(handover, true, "Missing handover record");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetNTypes(), 2, "Wrong number of record types");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetSchema(1).GetFieldIndex("target"), 1, "Wrong schema");
+    reader.Close();
+    std::remove(filename.c_str());
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Check the printing of the fields of a binary trace.
+ */
+class BinaryTracePrintTestCase : public TestCase
+{
+  public:
+    BinaryTracePrintTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BinaryTracePrintTestCase::BinaryTracePrintTestCase()
+    : TestCase("Print the fields of a binary trace")
+{
+}
+
+void
+BinaryTracePrintTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("binary-trace-print-test.bin");
+    Ptr<BinaryTraceWriter> writer = CreateObject<BinaryTraceWriter>();
+    writer->Open(filename);
+    uint16_t type = writer->AddSchema(BinaryTraceSchema("Values")
+                                          .AddField<double>("a")
+                                          .AddField<double>("b")
+                                          .AddField<int8_t>("c")
+                                          .AddField<float>("d"));
+    writer->Write(type, 0.1, 1.0 / 3, int8_t(-5), 2.5f);
+    writer->Close();
+
+    BinaryTraceReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(filename), true, "Can't open the trace");
+    NS_TEST_ASSERT_MSG_EQ(reader.Next(), true, "Missing record");
+    std::ostringstream oss;
+    for (std::size_t i = 0; i < reader.GetSchema().GetNFields(); i++)
+    {
+        reader.Print(oss, i);
+        oss << " ";
+    }
+    NS_TEST_EXPECT_MSG_EQ(oss.str(), "0.1 0.33333333333333331 -5 2.5 ", "Wrong printed values");
+    NS_TEST_EXPECT_MSG_EQ(reader.Next(), false, "Unexpected record");
+    NS_TEST_EXPECT_MSG_EQ(reader.Fail(), false, "Invalid trace");
+    reader.Close();
+    std::remove(filename.c_str());
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Binary trace TestSuite
+ */
+class BinaryTraceTestSuite : public TestSuite
+{
+  public:
+    BinaryTraceTestSuite();
+};
+
+BinaryTraceTestSuite::BinaryTraceTestSuite()
+    : TestSuite("binary-trace", UNIT)
+{
+    AddTestCase(new BinaryTraceTestCase(BinaryTraceWriter::NONE, false), TestCase::QUICK);
+    AddTestCase(new BinaryTraceTestCase(BinaryTraceWriter::NONE, true), TestCase::QUICK);
+    if (BinaryTraceWriter::IsSupported(BinaryTraceWriter::ZLIB))
+    {
+        AddTestCase(new BinaryTraceTestCase(BinaryTraceWriter::ZLIB, false), TestCase::QUICK);
+        AddTestCase(new BinaryTraceTestCase(BinaryTraceWriter::ZLIB, true), TestCase::QUICK);
+    }
+    AddTestCase(new BinaryTracePrintTestCase, TestCase::QUICK);
+}
+
+static BinaryTraceTestSuite g_binaryTraceTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,176 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the setup of the attributes and
+// trace sinks of many nodes through Config paths, as done by the helpers
+// and the scenarios wiring the nodes one by one. Each node has 'devices'
+// SimpleNetDevices.
+// Sample usage:  ./ns3 run 'bench-config --nodes=10000 --devices=2'
+
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+/// The number of trace sink calls
+static uint64_t g_drops = 0;
+
+/**
+ * The trace sink
+ * \param p the dropped packet
+ */
+static void
+PhyRxDrop(Ptr<const Packet> p)
+{
+    g_drops++;
+}
+
+/// The devices, relative to a node
+static const std::string g_devices = "DeviceList/*/$ns3::SimpleNetDevice";
+/// The trace source of the devices, relative to a node
+static const std::string g_trace = g_devices + "/PhyRxDrop";
+/// An attribute of the first device, relative to a node
+static const std::string g_attribute = "DeviceList/0/$ns3::SimpleNetDevice/PointToPointMode";
+
+/**
+ * Get the path of a node
+ * \param node the node
+ * \return the path of the node, with a trailing '/'
+ */
+static std::string
+NodePath(Ptr<Node> node)
+{
+    return "/NodeList/" + std::to_string(node->GetId()) + "/";
+}
+
+/**
+ * Connect the sink node by node with Config::ConnectWithoutContext
+ * \param nodes the nodes
+ */
+static void
+BenchConnectPerNode(const NodeContainer& nodes)
+{
+    for (auto i = nodes.Begin(); i != nodes.End(); ++i)
+    {
+        Config::ConnectWithoutContext(NodePath(*i) + g_trace, MakeCallback(&PhyRxDrop));
+    }
+}
+
+/**
+ * Set the attribute node by node with Config::Set
+ * \param nodes the nodes
+ */
+static void
+BenchSetPerNode(const NodeContainer& nodes)
+{
+    for (auto i = nodes.Begin(); i != nodes.End(); ++i)
+    {
+        Config::Set(NodePath(*i) + g_attribute, BooleanValue(true));
+    }
+}
+
+/**
+ * Connect the sink with a wildcard on the NodeList
+ * \param nodes the nodes
+ */
+static void
+BenchConnectWildcard(const NodeContainer& nodes)
+{
+    Config::ConnectWithoutContext("/NodeList/*/" + g_trace, MakeCallback(&PhyRxDrop));
+}
+
+/**
+ * Connect the sink node by node with a compiled path
+ * \param nodes the nodes
+ */
+static void
+BenchConnectCompiled(const NodeContainer& nodes)
+{
+    Config::CompiledPath path(g_devices);
+    for (auto i = nodes.Begin(); i != nodes.End(); ++i)
+    {
+        Config::MatchContainer devices = path.LookupMatches({*i}, {NodePath(*i)});
+        devices.ConnectWithoutContext("PhyRxDrop", MakeCallback(&PhyRxDrop));
+    }
+}
+
+/**
+ * Connect the sink with NodeContainer::ConnectWithoutContext
+ * \param nodes the nodes
+ */
+static void
+BenchConnectContainer(const NodeContainer& nodes)
+{
+    nodes.ConnectWithoutContext(g_trace, MakeCallback(&PhyRxDrop));
+}
+
+/**
+ * Run a benchmark and print its setup time
+ * \param bench the benchmark function
+ * \param nodes the nodes
+ * \param name the benchmark name
+ */
+static void
+RunBench(void (*bench)(const NodeContainer&), const NodeContainer& nodes, const char* name)
+{
+    SystemWallClockMs time;
+    time.Start();
+    (*bench)(nodes);
+    uint64_t deltaMs = std::max<uint64_t>(time.End(), 1);
+    std::cout << nodes.GetN() * 1000.0 / deltaMs << " nodes/s"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nNodes = 10000;
+    uint32_t nDevices = 2;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the Config path resolution");
+    cmd.AddValue("nodes", "number of nodes", nNodes);
+    cmd.AddValue("devices", "number of devices per node", nDevices);
+    cmd.Parse(argc, argv);
+
+    std::cout << "Running bench-config with " << nNodes << " nodes and " << nDevices
+              << " devices per node" << std::endl;
+
+    NodeContainer nodes(nNodes);
+    for (auto i = nodes.Begin(); i != nodes.End(); ++i)
+    {
+        for (uint32_t j = 0; j < nDevices; j++)
+        {
+            (*i)->AddDevice(CreateObject<SimpleNetDevice>());
+        }
+    }
+
+    RunBench(&BenchConnectPerNode, nodes, "Config::ConnectWithoutContext per node");
+    RunBench(&BenchSetPerNode, nodes, "Config::Set per node");
+    RunBench(&BenchConnectWildcard, nodes, "Config::ConnectWithoutContext on /NodeList/*");
+    RunBench(&BenchConnectCompiled, nodes, "Config::CompiledPath per node");
+    RunBench(&BenchConnectContainer, nodes, "NodeContainer::ConnectWithoutContext");
+
+    return 0;
+}
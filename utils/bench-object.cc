@@ -0,0 +1,179 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark Object::GetObject on an
+// aggregate of 'aggregates' Objects of different types, as done on the
+// nodes for their MobilityModel, Ipv4, etc. Each lookup is repeated
+// 'lookups' times.
+// Sample usage:  ./ns3 run 'bench-object --aggregates=10 --lookups=10000000'
+
+#include "ns3/command-line.h"
+#include "ns3/object.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/// The maximum number of aggregates
+static const int MAX_AGGREGATES = 16;
+
+/**
+ * An Object type, to be aggregated with the other ones.
+ * \tparam N the index of the type
+ */
+template <int N>
+class BenchObject : public Object
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::BenchObject" + std::to_string(N))
+                                .SetParent<Object>()
+                                .SetGroupName("Core")
+                                .AddConstructor<BenchObject<N>>();
+        return tid;
+    }
+};
+
+/// The sum of the pointers found, so that the lookups are not optimized out
+static uintptr_t g_sum = 0;
+
+/**
+ * Look up an aggregate of type BenchObject<N>, if N is less than \p n
+ * \tparam N the index of the type
+ * \param object an aggregate
+ * \param n the number of aggregates
+ */
+template <int N>
+static void
+GetBenchObject(const Ptr<Object>& object, uint32_t n)
+{
+    if (static_cast<uint32_t>(N) < n)
+    {
+        g_sum += reinterpret_cast<uintptr_t>(PeekPointer(object->GetObject<BenchObject<N>>()));
+    }
+}
+
+/**
+ * Look up the same aggregate
+ * \tparam N the index of the type looked up
+ * \param object an aggregate
+ * \param nLookups the number of lookups
+ * \return the number of lookups done
+ */
+template <int N>
+static uint32_t
+BenchSame(Ptr<Object> object, uint32_t nLookups)
+{
+    for (uint32_t i = 0; i < nLookups; i++)
+    {
+        g_sum += reinterpret_cast<uintptr_t>(PeekPointer(object->GetObject<BenchObject<N>>()));
+    }
+    return nLookups;
+}
+
+/**
+ * Look up all the aggregates in turn, as the protocols of a node do
+ * \tparam N the indexes of the types
+ * \param object an aggregate
+ * \param n the number of aggregates
+ * \param nLookups the number of lookups
+ * \return the number of lookups done
+ */
+template <int... N>
+static uint32_t
+BenchAll(Ptr<Object> object, uint32_t n, uint32_t nLookups, std::integer_sequence<int, N...>)
+{
+    for (uint32_t i = 0; i < nLookups / n; i++)
+    {
+        (GetBenchObject<N>(object, n), ...);
+    }
+    return nLookups / n * n;
+}
+
+/**
+ * Create the aggregates
+ * \tparam N the indexes of the types
+ * \param n the number of aggregates
+ * \return the aggregates, in aggregation order
+ */
+template <int... N>
+static std::vector<Ptr<Object>>
+CreateAggregates(uint32_t n, std::integer_sequence<int, N...>)
+{
+    std::vector<Ptr<Object>> objects = {CreateObject<BenchObject<N>>()...};
+    objects.resize(n);
+    for (uint32_t i = 1; i < n; i++)
+    {
+        objects[0]->AggregateObject(objects[i]);
+    }
+    return objects;
+}
+
+/**
+ * Run a benchmark and print the time per lookup
+ * \param nLookups the number of lookups done by the benchmark
+ * \param time the timer, started before the benchmark
+ * \param name the benchmark name
+ */
+static void
+PrintBench(uint32_t nLookups, SystemWallClockMs& time, const char* name)
+{
+    uint64_t deltaMs = std::max<uint64_t>(time.End(), 1);
+    std::cout << deltaMs * 1e6 / nLookups << " ns/lookup"
+              << " (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nAggregates = 10;
+    uint32_t nLookups = 10000000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the lookups of the aggregated Objects");
+    cmd.AddValue("aggregates", "number of aggregates (from 2 to 16)", nAggregates);
+    cmd.AddValue("lookups", "number of lookups", nLookups);
+    cmd.Parse(argc, argv);
+
+    nAggregates = std::min<uint32_t>(std::max<uint32_t>(nAggregates, 2), MAX_AGGREGATES);
+    std::cout << "Running bench-object with " << nAggregates << " aggregates and " << nLookups
+              << " lookups" << std::endl;
+
+    auto seq = std::make_integer_sequence<int, MAX_AGGREGATES>();
+    std::vector<Ptr<Object>> objects = CreateAggregates(nAggregates, seq);
+    Ptr<Object> object = objects.back();
+
+    SystemWallClockMs time;
+    time.Start();
+    PrintBench(BenchSame<1>(object, nLookups), time, "GetObject of the same aggregate");
+    time.Start();
+    PrintBench(BenchAll(object, nAggregates, nLookups, seq), time, "GetObject of each aggregate");
+    time.Start();
+    PrintBench(BenchSame<MAX_AGGREGATES>(object, nLookups), time, "GetObject of a missing type");
+
+    object->Dispose();
+    return g_sum == 0;
+}
@@ -20,6 +20,13 @@
 // This program can be used to benchmark packet serialization/deserialization
 // operations using Headers and Tags, for various numbers of packets 'n'
 // Sample usage:  ./ns3 run 'bench-packets --n=10000'
+//
+// With '--threads', each benchmark is run concurrently by several threads,
+// to measure the scalability of the packet allocators. This requires ns-3
+// to be built with multithreaded simulation support (--enable-mtp), which
+// gives each thread its own free lists; the single threaded results of
+// such a build can be compared with the ones of a default build, which
+// uses a global free list.
 
 #include "ns3/command-line.h"
 #include "ns3/packet-metadata.h"
@@ -32,6 +39,8 @@
 #include <sstream>
 #include <stdlib.h> // for exit ()
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace ns3;
 
@@ -351,25 +360,50 @@ benchByteTags(uint32_t n)
 }
 
 static uint64_t
-runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
+runBenchOneIteration(void (*bench)(uint32_t), uint32_t n, uint32_t threads)
 {
+    if (threads > 1)
+    {
+        // register the TypeIds used by the benchmark before starting the threads
+        (*bench)(1);
+    }
     SystemWallClockMs time;
     time.Start();
-    (*bench)(n);
+    if (threads > 1)
+    {
+        std::vector<std::thread> workers;
+        for (uint32_t i = 0; i < threads; i++)
+        {
+            workers.emplace_back(bench, n);
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+    else
+    {
+        (*bench)(n);
+    }
     uint64_t deltaMs = time.End();
     return deltaMs;
 }
 
 static void
-runBench(void (*bench)(uint32_t), uint32_t n, uint32_t minIterations, const char* name)
+runBench(void (*bench)(uint32_t),
+         uint32_t n,
+         uint32_t threads,
+         uint32_t minIterations,
+         const char* name)
 {
     uint64_t minDelay = std::numeric_limits<uint64_t>::max();
     for (uint32_t i = 0; i < minIterations; i++)
     {
-        uint64_t delay = runBenchOneIteration(bench, n);
+        uint64_t delay = runBenchOneIteration(bench, n, threads);
         minDelay = std::min(minDelay, delay);
     }
     double ps = n;
+    ps *= threads;
     ps *= 1000;
     ps /= minDelay;
     std::cout << ps << " packets/s"
@@ -381,6 +415,7 @@ main(int argc, char* argv[])
 {
     uint32_t n = 0;
     uint32_t minIterations = 1;
+    uint32_t threads = 1;
     bool enablePrinting = false;
 
     CommandLine cmd(__FILE__);
@@ -390,6 +425,7 @@ main(int argc, char* argv[])
                  "number of subiterations to minimize iteration time over",
                  minIterations);
     cmd.AddValue("enable-printing", "enable packet printing", enablePrinting);
+    cmd.AddValue("threads", "number of threads running each benchmark concurrently", threads);
     cmd.Parse(argc, argv);
 
     if (n == 0)
@@ -398,15 +434,28 @@ main(int argc, char* argv[])
                   << "by command-line argument --n=(number of packets)" << std::endl;
         exit(1);
     }
-    std::cout << "Running bench-packets with n=" << n << std::endl;
+#ifndef NS3_MTP
+    if (threads != 1)
+    {
+        std::cerr << "Error-- the packets can be used by several threads only "
+                  << "if ns-3 is built with multithreaded simulation support" << std::endl;
+        exit(1);
+    }
+#endif
+    if (threads == 0)
+    {
+        std::cerr << "Error-- number of threads must be positive" << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-packets with n=" << n << ", threads=" << threads << std::endl;
     std::cout << "All tests begin by adding UDP and IPv4 headers." << std::endl;
 
-    runBench(&benchA, n, minIterations, "Copy packet, remove headers");
-    runBench(&benchB, n, minIterations, "Just add headers");
-    runBench(&benchC, n, minIterations, "Remove by func call");
-    runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
-    runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
-    runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    runBench(&benchA, n, threads, minIterations, "Copy packet, remove headers");
+    runBench(&benchB, n, threads, minIterations, "Just add headers");
+    runBench(&benchC, n, threads, minIterations, "Remove by func call");
+    runBench(&benchD, n, threads, minIterations, "Intermixed add/remove headers and tags");
+    runBench(&benchFragment, n, threads, minIterations, "Fragmentation and concatenation");
+    runBench(&benchByteTags, n, threads, minIterations, "Benchmark byte tags");
 
     return 0;
 }
@@ -23,6 +23,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string.h>
 #include <vector>
 
@@ -451,12 +452,74 @@ GetRandomStream(std::string filename)
     return stream;
 }
 
+/**
+ *  Create a RandomVariableStream replaying the event delays
+ *  recorded in a DES Metrics trace.
+ *
+ *  The trace is the JSON file written by a simulation run from
+ *  an ns-3 build configured with \c --enable-des-metrics,
+ *  for example one of the LENA examples, see DesMetrics.
+ *  Each event record gives the time the event was scheduled
+ *  and the time it was executed, in the Time resolution of
+ *  the simulation; their difference is the event delay.
+ *
+ *  \param [in] filename The DES Metrics trace file name.
+ *  \returns The RandomVariableStream.
+ */
+Ptr<RandomVariableStream>
+GetDesMetricsStream(std::string filename)
+{
+    LOG("  Event time distribution:      from DES Metrics trace " << filename);
+    std::ifstream input(filename);
+    if (!input.is_open())
+    {
+        NS_FATAL_ERROR("Can't open DES Metrics trace " << filename);
+    }
+
+    std::vector<double> delays;
+    std::string line;
+    while (std::getline(input, line))
+    {
+        // Event records look like  ["src","send","dst","recv"],
+        auto pos = line.find_first_not_of(" \t");
+        if (pos == std::string::npos || line[pos] != '[' || line.find('"') == std::string::npos)
+        {
+            continue;
+        }
+        for (auto& c : line)
+        {
+            if (c == '[' || c == ']' || c == '"' || c == ',')
+            {
+                c = ' ';
+            }
+        }
+        std::istringstream record(line);
+        uint64_t src;
+        uint64_t send;
+        uint64_t dst;
+        uint64_t recv;
+        if (record >> src >> send >> dst >> recv)
+        {
+            delays.push_back(recv - send);
+        }
+    }
+    LOG("    Found " << delays.size() << " entries");
+    if (delays.empty())
+    {
+        NS_FATAL_ERROR("No event records in DES Metrics trace " << filename);
+    }
+    auto drv = CreateObject<DeterministicRandomVariable>();
+    drv->SetValueArray(&delays[0], delays.size());
+    return drv;
+}
+
 int
 main(int argc, char* argv[])
 {
     bool allSched = false;
     bool schedCal = false;
     bool schedHeap = false;
+    bool schedLadder = false;
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
@@ -465,6 +528,7 @@ main(int argc, char* argv[])
     uint64_t total = 1000000;
     uint64_t runs = 1;
     std::string filename = "";
+    std::string desFilename = "";
     bool calRev = false;
 
     CommandLine cmd(__FILE__);
@@ -476,12 +540,15 @@ main(int argc, char* argv[])
               "  or standard input, by the argument --file=\"-\"\n"
               "In the case of either --file form, the input is expected\n"
               "to be ascii, giving the relative event times in ns.\n"
+              "Alternatively, the event intervals can be replayed from the\n"
+              "DES Metrics trace of a simulation, by --des=\"<filename>\".\n"
               "\n"
               "If no scheduler is specified the MapScheduler will be run.");
     cmd.AddValue("all", "use all schedulers", allSched);
     cmd.AddValue("cal", "use CalendarSheduler", schedCal);
     cmd.AddValue("calrev", "reverse ordering in the CalendarScheduler", calRev);
     cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderScheduler", schedLadder);
     cmd.AddValue("list", "use ListSheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
@@ -490,6 +557,7 @@ main(int argc, char* argv[])
     cmd.AddValue("total", "total number of events to run", total);
     cmd.AddValue("runs", "number of runs", runs);
     cmd.AddValue("file", "file of relative event times", filename);
+    cmd.AddValue("des", "DES Metrics trace of the event times", desFilename);
     cmd.AddValue("prec", "printed output precision", g_fwidth);
     cmd.Parse(argc, argv);
 
@@ -505,15 +573,16 @@ main(int argc, char* argv[])
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedLadder = schedList = schedMap = schedPQ = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedLadder || schedList || schedMap || schedPQ))
     {
         schedMap = true;
     }
 
-    auto eventStream = GetRandomStream(filename);
+    auto eventStream =
+        desFilename.empty() ? GetRandomStream(filename) : GetDesMetricsStream(desFilename);
 
     ObjectFactory factory("ns3::MapScheduler");
     if (schedCal)
@@ -532,6 +601,11 @@ main(int argc, char* argv[])
         factory.SetTypeId("ns3::HeapScheduler");
         BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
     }
+    if (schedLadder)
+    {
+        factory.SetTypeId("ns3::LadderScheduler");
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+    }
     if (schedList)
     {
         factory.SetTypeId("ns3::ListScheduler");
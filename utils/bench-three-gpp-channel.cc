@@ -0,0 +1,460 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the generation of the channel matrix by
+// the ThreeGppChannelModel, and the computation of the beamforming gain by the
+// ThreeGppSpectrumPropagationLossModel, compared to the loops over the clusters,
+// rays, antenna elements and sub-bands that they used to run.
+// Both nodes have a UniformPlanarArray of 'rows' x 'columns' elements, in a LOS
+// UMi-StreetCanyon link at 28 GHz, and the PSD has 'bands' sub-bands of 180 kHz.
+// Sample usage:  ./ns3 run 'bench-three-gpp-channel --n=100 --rows=8 --columns=8'
+
+#include "ns3/channel-condition-model.h"
+#include "ns3/command-line.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/three-gpp-channel-model.h"
+#include "ns3/three-gpp-spectrum-propagation-loss-model.h"
+#include "ns3/uinteger.h"
+#include "ns3/uniform-planar-array.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * A ThreeGppChannelModel giving access to the generation of the channel matrix
+ * from given channel params, and to the loops it used to run.
+ */
+class BenchThreeGppChannelModel : public ThreeGppChannelModel
+{
+  public:
+    /**
+     * Generate the channel params of a LOS link
+     * \param sMob the mobility model of the node s
+     * \param uMob the mobility model of the node u
+     */
+    void GenerateParams(Ptr<const MobilityModel> sMob, Ptr<const MobilityModel> uMob);
+
+    /**
+     * Generate the channel matrix from the channel params
+     * \param sAntenna the antenna array of the node s
+     * \param uAntenna the antenna array of the node u
+     * \return the channel matrix
+     */
+    Ptr<const ChannelMatrix> NewChannel(Ptr<const PhasedArrayModel> sAntenna,
+                                        Ptr<const PhasedArrayModel> uAntenna) const;
+
+    /**
+     * Generate the channel matrix from the channel params, with the loops over
+     * the clusters, the elements and the rays
+     * \param sAntenna the antenna array of the node s
+     * \param uAntenna the antenna array of the node u
+     * \return the channel matrix
+     */
+    Ptr<const ChannelMatrix> LoopChannel(Ptr<const PhasedArrayModel> sAntenna,
+                                         Ptr<const PhasedArrayModel> uAntenna) const;
+
+  private:
+    Ptr<const MobilityModel> m_sMob;          //!< the mobility model of the node s
+    Ptr<const MobilityModel> m_uMob;          //!< the mobility model of the node u
+    Ptr<const ParamsTable> m_table;           //!< the 3GPP parameters of the link
+    Ptr<const ThreeGppChannelParams> m_param; //!< the channel params of the link
+};
+
+void
+BenchThreeGppChannelModel::GenerateParams(Ptr<const MobilityModel> sMob,
+                                          Ptr<const MobilityModel> uMob)
+{
+    m_sMob = sMob;
+    m_uMob = uMob;
+    Ptr<ChannelCondition> condition = CreateObject<ChannelCondition>(ChannelCondition::LOS);
+    Vector sPos = sMob->GetPosition();
+    Vector uPos = uMob->GetPosition();
+    double distance2D = std::hypot(sPos.x - uPos.x, sPos.y - uPos.y);
+    m_table = GetThreeGppTable(condition,
+                               std::max(sPos.z, uPos.z),
+                               std::min(sPos.z, uPos.z),
+                               distance2D);
+    m_param = GenerateChannelParameters(condition, m_table, sMob, uMob);
+}
+
+Ptr<const MatrixBasedChannelModel::ChannelMatrix>
+BenchThreeGppChannelModel::NewChannel(Ptr<const PhasedArrayModel> sAntenna,
+                                      Ptr<const PhasedArrayModel> uAntenna) const
+{
+    return GetNewChannel(m_param, m_table, m_sMob, m_uMob, sAntenna, uAntenna);
+}
+
+Ptr<const MatrixBasedChannelModel::ChannelMatrix>
+BenchThreeGppChannelModel::LoopChannel(Ptr<const PhasedArrayModel> sAntenna,
+                                       Ptr<const PhasedArrayModel> uAntenna) const
+{
+    Ptr<ChannelMatrix> channelMatrix = Create<ChannelMatrix>();
+    size_t uSize = uAntenna->GetNumberOfElements();
+    size_t sSize = sAntenna->GetNumberOfElements();
+    uint8_t numClusters = m_param->m_reducedClusterNumber;
+    uint8_t raysPerCluster = m_table->m_raysPerCluster;
+    uint16_t numOverallCluster =
+        (m_param->m_cluster1st != m_param->m_cluster2nd) ? numClusters + 4 : numClusters + 2;
+    Complex3DVector hUsn(uSize, sSize, numOverallCluster);
+
+    Complex2DVector raysPreComp(numClusters, raysPerCluster);
+    Double2DVector sinCosA(numClusters, DoubleVector(raysPerCluster));
+    Double2DVector sinSinA(numClusters, DoubleVector(raysPerCluster));
+    Double2DVector cosZoA(numClusters, DoubleVector(raysPerCluster));
+    Double2DVector sinCosD(numClusters, DoubleVector(raysPerCluster));
+    Double2DVector sinSinD(numClusters, DoubleVector(raysPerCluster));
+    Double2DVector cosZoD(numClusters, DoubleVector(raysPerCluster));
+    for (uint8_t nIndex = 0; nIndex < numClusters; nIndex++)
+    {
+        for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+        {
+            DoubleVector initialPhase = m_param->m_clusterPhase[nIndex][mIndex];
+            double k = m_param->m_crossPolarizationPowerRatios[nIndex][mIndex];
+            double rayAoa = m_param->m_rayAoaRadian[nIndex][mIndex];
+            double rayZoa = m_param->m_rayZoaRadian[nIndex][mIndex];
+            double rayAod = m_param->m_rayAodRadian[nIndex][mIndex];
+            double rayZod = m_param->m_rayZodRadian[nIndex][mIndex];
+            auto [rxFieldPatternPhi, rxFieldPatternTheta] =
+                uAntenna->GetElementFieldPattern(Angles(rayAoa, rayZoa));
+            auto [txFieldPatternPhi, txFieldPatternTheta] =
+                sAntenna->GetElementFieldPattern(Angles(rayAod, rayZod));
+            raysPreComp(nIndex, mIndex) =
+                std::complex<double>(cos(initialPhase[0]), sin(initialPhase[0])) *
+                    rxFieldPatternTheta * txFieldPatternTheta +
+                std::complex<double>(cos(initialPhase[1]), sin(initialPhase[1])) *
+                    std::sqrt(1.0 / k) * rxFieldPatternTheta * txFieldPatternPhi +
+                std::complex<double>(cos(initialPhase[2]), sin(initialPhase[2])) *
+                    std::sqrt(1.0 / k) * rxFieldPatternPhi * txFieldPatternTheta +
+                std::complex<double>(cos(initialPhase[3]), sin(initialPhase[3])) *
+                    rxFieldPatternPhi * txFieldPatternPhi;
+            sinCosA[nIndex][mIndex] = sin(rayZoa) * cos(rayAoa);
+            sinSinA[nIndex][mIndex] = sin(rayZoa) * sin(rayAoa);
+            cosZoA[nIndex][mIndex] = cos(rayZoa);
+            sinCosD[nIndex][mIndex] = sin(rayZod) * cos(rayAod);
+            sinSinD[nIndex][mIndex] = sin(rayZod) * sin(rayAod);
+            cosZoD[nIndex][mIndex] = cos(rayZod);
+        }
+    }
+
+    uint8_t numSubClustersAdded = 0;
+    for (uint8_t nIndex = 0; nIndex < numClusters; nIndex++)
+    {
+        bool isStrongest = (nIndex == m_param->m_cluster1st || nIndex == m_param->m_cluster2nd);
+        double rayScale = sqrt(m_param->m_clusterPower[nIndex] / raysPerCluster);
+        for (size_t uIndex = 0; uIndex < uSize; uIndex++)
+        {
+            Vector uLoc = uAntenna->GetElementLocation(uIndex);
+            for (size_t sIndex = 0; sIndex < sSize; sIndex++)
+            {
+                Vector sLoc = sAntenna->GetElementLocation(sIndex);
+                std::complex<double> raysSub[3];
+                for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+                {
+                    double rxPhaseDiff =
+                        2 * M_PI *
+                        (sinCosA[nIndex][mIndex] * uLoc.x + sinSinA[nIndex][mIndex] * uLoc.y +
+                         cosZoA[nIndex][mIndex] * uLoc.z);
+                    double txPhaseDiff =
+                        2 * M_PI *
+                        (sinCosD[nIndex][mIndex] * sLoc.x + sinSinD[nIndex][mIndex] * sLoc.y +
+                         cosZoD[nIndex][mIndex] * sLoc.z);
+                    std::complex<double> ray =
+                        raysPreComp(nIndex, mIndex) *
+                        std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
+                        std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+                    size_t subCluster = 0;
+                    if (isStrongest && ((mIndex >= 9 && mIndex <= 12) || mIndex == 17 ||
+                                        mIndex == 18))
+                    {
+                        subCluster = 1;
+                    }
+                    else if (isStrongest && mIndex >= 13 && mIndex <= 16)
+                    {
+                        subCluster = 2;
+                    }
+                    raysSub[subCluster] += ray;
+                }
+                hUsn(uIndex, sIndex, nIndex) = raysSub[0] * rayScale;
+                if (isStrongest)
+                {
+                    hUsn(uIndex, sIndex, numClusters + numSubClustersAdded) =
+                        raysSub[1] * rayScale;
+                    hUsn(uIndex, sIndex, numClusters + numSubClustersAdded + 1) =
+                        raysSub[2] * rayScale;
+                }
+            }
+        }
+        if (isStrongest)
+        {
+            numSubClustersAdded += 2;
+        }
+    }
+
+    // the LOS ray
+    Angles sAngle(m_uMob->GetPosition(), m_sMob->GetPosition());
+    Angles uAngle(m_sMob->GetPosition(), m_uMob->GetPosition());
+    double lambda = 3.0e8 / GetFrequency();
+    double distance3D = m_sMob->GetDistanceFrom(m_uMob);
+    std::complex<double> phaseDiffDueToDistance(cos(-2 * M_PI * distance3D / lambda),
+                                                sin(-2 * M_PI * distance3D / lambda));
+    double kLinear = pow(10, m_param->m_K_factor / 10.0);
+    for (size_t uIndex = 0; uIndex < uSize; uIndex++)
+    {
+        Vector uLoc = uAntenna->GetElementLocation(uIndex);
+        double rxPhaseDiff =
+            2 * M_PI *
+            (sin(uAngle.GetInclination()) * cos(uAngle.GetAzimuth()) * uLoc.x +
+             sin(uAngle.GetInclination()) * sin(uAngle.GetAzimuth()) * uLoc.y +
+             cos(uAngle.GetInclination()) * uLoc.z);
+        for (size_t sIndex = 0; sIndex < sSize; sIndex++)
+        {
+            Vector sLoc = sAntenna->GetElementLocation(sIndex);
+            double txPhaseDiff =
+                2 * M_PI *
+                (sin(sAngle.GetInclination()) * cos(sAngle.GetAzimuth()) * sLoc.x +
+                 sin(sAngle.GetInclination()) * sin(sAngle.GetAzimuth()) * sLoc.y +
+                 cos(sAngle.GetInclination()) * sLoc.z);
+            auto [rxFieldPatternPhi, rxFieldPatternTheta] =
+                uAntenna->GetElementFieldPattern(uAngle);
+            auto [txFieldPatternPhi, txFieldPatternTheta] =
+                sAntenna->GetElementFieldPattern(sAngle);
+            std::complex<double> ray =
+                (rxFieldPatternTheta * txFieldPatternTheta -
+                 rxFieldPatternPhi * txFieldPatternPhi) *
+                phaseDiffDueToDistance * std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
+                std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+            hUsn(uIndex, sIndex, 0) = sqrt(1.0 / (kLinear + 1)) * hUsn(uIndex, sIndex, 0) +
+                                      sqrt(kLinear / (1 + kLinear)) * ray /
+                                          pow(10, m_param->m_attenuation_dB[0] / 10.0);
+            for (size_t nIndex = 1; nIndex < hUsn.GetNumPages(); nIndex++)
+            {
+                hUsn(uIndex, sIndex, nIndex) *= sqrt(1.0 / (kLinear + 1));
+            }
+        }
+    }
+    channelMatrix->m_channel = hUsn;
+    return channelMatrix;
+}
+
+/**
+ * Compute the beamforming gain of a link with the loops over the sub-bands and
+ * the clusters, as the ThreeGppSpectrumPropagationLossModel used to do
+ * \param txPsd the tx PSD
+ * \param longTerm the long term component
+ * \param channelParams the channel params of the link, in the direction of the channel matrix
+ * \param frequency the operating frequency
+ * \return the rx PSD
+ */
+static Ptr<SpectrumValue>
+LoopBeamformingGain(Ptr<const SpectrumValue> txPsd,
+                    const PhasedArrayModel::ComplexVector& longTerm,
+                    Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams,
+                    double frequency)
+{
+    Ptr<SpectrumValue> rxPsd = Copy<SpectrumValue>(txPsd);
+    size_t numCluster = longTerm.GetSize();
+    // the nodes do not move
+    double factor = 2 * M_PI * Simulator::Now().GetSeconds() * frequency / 3e8;
+    PhasedArrayModel::ComplexVector doppler(numCluster);
+    for (size_t cIndex = 0; cIndex < numCluster; cIndex++)
+    {
+        double tempDoppler =
+            factor * 2 * channelParams->m_alpha[cIndex] * channelParams->m_D[cIndex];
+        doppler[cIndex] = std::complex<double>(cos(tempDoppler), sin(tempDoppler));
+    }
+    auto sbit = rxPsd->ConstBandsBegin();
+    for (auto vit = rxPsd->ValuesBegin(); vit != rxPsd->ValuesEnd(); vit++, sbit++)
+    {
+        if ((*vit) != 0.00)
+        {
+            std::complex<double> subsbandGain(0.0, 0.0);
+            double fsb = (*sbit).fc;
+            for (size_t cIndex = 0; cIndex < numCluster; cIndex++)
+            {
+                double delay = -2 * M_PI * fsb * (channelParams->m_delay[cIndex]);
+                subsbandGain = subsbandGain + longTerm[cIndex] * doppler[cIndex] *
+                                                  std::complex<double>(cos(delay), sin(delay));
+            }
+            *vit = (*vit) * (norm(subsbandGain));
+        }
+    }
+    return rxPsd;
+}
+
+/**
+ * Run a benchmark and print its call rate
+ * \param bench the benchmark function, returning a checksum
+ * \param n the number of calls
+ * \param name the benchmark name
+ */
+static void
+RunBench(const std::function<double()>& bench, uint32_t n, const char* name)
+{
+    SystemWallClockMs time;
+    time.Start();
+    double sum = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        sum += bench();
+    }
+    uint64_t deltaMs = std::max<uint64_t>(time.End(), 1);
+    std::cout << n * 1000.0 / deltaMs << " calls/s"
+              << " (" << deltaMs << " ms elapsed, checksum " << sum << ")\t" << name
+              << std::endl;
+}
+
+/**
+ * \param a a channel matrix
+ * \param b another channel matrix of the same dimensions
+ * \return the largest absolute difference between the coefficients of the matrices
+ */
+static double
+MaxDifference(const ComplexMatrixArray& a, const ComplexMatrixArray& b)
+{
+    double maxDifference = 0;
+    for (size_t i = 0; i < a.GetSize(); i++)
+    {
+        maxDifference = std::max(maxDifference, std::abs(a.GetValues()[i] - b.GetValues()[i]));
+    }
+    return maxDifference;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 100;
+    uint32_t rows = 8;
+    uint32_t columns = 8;
+    uint32_t bands = 100;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark ThreeGppChannelModel and ThreeGppSpectrumPropagationLossModel");
+    cmd.AddValue("n", "number of channel matrices, and 100 times the number of PSDs", n);
+    cmd.AddValue("rows", "number of rows of the antenna arrays", rows);
+    cmd.AddValue("columns", "number of columns of the antenna arrays", columns);
+    cmd.AddValue("bands", "number of sub-bands of the PSD", bands);
+    cmd.Parse(argc, argv);
+
+    std::cout << "Running bench-three-gpp-channel with n=" << n << ", arrays of " << rows << "x"
+              << columns << " elements and " << bands << " sub-bands" << std::endl;
+
+    const double frequency = 28e9;
+    Ptr<BenchThreeGppChannelModel> channelModel = CreateObject<BenchThreeGppChannelModel>();
+    channelModel->SetAttribute("Frequency", DoubleValue(frequency));
+    channelModel->SetAttribute("Scenario", StringValue("UMi-StreetCanyon"));
+    channelModel->SetAttribute("ChannelConditionModel",
+                               PointerValue(CreateObject<AlwaysLosChannelConditionModel>()));
+    channelModel->AssignStreams(1);
+
+    Ptr<Node> sNode = CreateObject<Node>();
+    Ptr<MobilityModel> sMob = CreateObject<ConstantPositionMobilityModel>();
+    sMob->SetPosition(Vector(0, 0, 10));
+    sNode->AggregateObject(sMob);
+    Ptr<Node> uNode = CreateObject<Node>();
+    Ptr<MobilityModel> uMob = CreateObject<ConstantPositionMobilityModel>();
+    uMob->SetPosition(Vector(60, 20, 1.5));
+    uNode->AggregateObject(uMob);
+
+    Ptr<PhasedArrayModel> sAntenna = CreateObjectWithAttributes<UniformPlanarArray>(
+        "NumRows",
+        UintegerValue(rows),
+        "NumColumns",
+        UintegerValue(columns));
+    Ptr<PhasedArrayModel> uAntenna = CreateObjectWithAttributes<UniformPlanarArray>(
+        "NumRows",
+        UintegerValue(rows),
+        "NumColumns",
+        UintegerValue(columns));
+    sAntenna->SetBeamformingVector(
+        sAntenna->GetBeamformingVector(Angles(uMob->GetPosition(), sMob->GetPosition())));
+    uAntenna->SetBeamformingVector(
+        uAntenna->GetBeamformingVector(Angles(sMob->GetPosition(), uMob->GetPosition())));
+
+    // the channel matrix
+    channelModel->GenerateParams(sMob, uMob);
+    std::cout << "Largest difference of the channel coefficients: "
+              << MaxDifference(channelModel->NewChannel(sAntenna, uAntenna)->m_channel,
+                               channelModel->LoopChannel(sAntenna, uAntenna)->m_channel)
+              << std::endl;
+    RunBench(
+        [&]() { return channelModel->LoopChannel(sAntenna, uAntenna)->m_channel(0, 0, 0).real(); },
+        n,
+        "loops");
+    RunBench(
+        [&]() { return channelModel->NewChannel(sAntenna, uAntenna)->m_channel(0, 0, 0).real(); },
+        n,
+        "ThreeGppChannelModel");
+
+    // the beamforming gain
+    Ptr<ThreeGppSpectrumPropagationLossModel> spectrumLossModel =
+        CreateObject<ThreeGppSpectrumPropagationLossModel>();
+    spectrumLossModel->SetChannelModel(channelModel);
+    std::vector<double> centerFrequencies;
+    for (uint32_t i = 0; i < bands; i++)
+    {
+        centerFrequencies.push_back(frequency + (i - bands / 2.0) * 180e3);
+    }
+    Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters>();
+    params->psd = Create<SpectrumValue>(Create<SpectrumModel>(centerFrequencies));
+    *params->psd = 1;
+    Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix =
+        channelModel->GetChannel(sMob, uMob, sAntenna, uAntenna);
+    Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams =
+        channelModel->GetParams(sMob, uMob);
+    PhasedArrayModel::ComplexVector longTerm =
+        channelMatrix->m_channel.MultiplyByLeftAndRightMatrix(
+            uAntenna->GetBeamformingVector().Transpose(),
+            sAntenna->GetBeamformingVector());
+    Ptr<SpectrumValue> loopPsd =
+        LoopBeamformingGain(params->psd, longTerm, channelParams, frequency);
+    Ptr<SpectrumValue> rxPsd =
+        spectrumLossModel->CalcRxPowerSpectralDensity(params, sMob, uMob, sAntenna, uAntenna);
+    double maxDifference = 0;
+    for (uint32_t i = 0; i < bands; i++)
+    {
+        maxDifference =
+            std::max(maxDifference, std::abs((*rxPsd)[i] - (*loopPsd)[i]) / (*loopPsd)[i]);
+    }
+    std::cout << "Largest relative difference of the beamforming gains: " << maxDifference
+              << std::endl;
+    RunBench(
+        [&]() {
+            return (*LoopBeamformingGain(params->psd, longTerm, channelParams, frequency))[0];
+        },
+        n * 100,
+        "loops");
+    RunBench(
+        [&]() {
+            return (*spectrumLossModel->CalcRxPowerSpectralDensity(params,
+                                                                   sMob,
+                                                                   uMob,
+                                                                   sAntenna,
+                                                                   uAntenna))[0];
+        },
+        n * 100,
+        "ThreeGppSpectrumPropagationLossModel");
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program converts a binary trace written by a BinaryTraceWriter.
+// With --format=csv, the records of each type are written to
+// <output>-<type>.csv, with a header line naming the fields.
+// With --format=columns, each field of each type is written to
+// <output>-<type>-<field>.<uint8|...|double>, as an array of raw values
+// in the byte order of this host, which can be loaded as is, e.g. with
+// numpy.fromfile(), or by a Parquet writer.
+// Sample usage:  ./ns3 run 'convert-binary-trace --input=rsrp.bin --output=rsrp'
+
+#include "ns3/abort.h"
+#include "ns3/binary-trace-reader.h"
+#include "ns3/command-line.h"
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Open an output file.
+ * \param filename the name of the file
+ * \returns the file
+ */
+static std::unique_ptr<std::ofstream>
+OpenOutput(const std::string& filename)
+{
+    auto file = std::make_unique<std::ofstream>(filename, std::ios::out | std::ios::binary);
+    NS_ABORT_MSG_UNLESS(file->is_open(), "Can't open file " << filename);
+    std::cout << "Writing " << filename << std::endl;
+    return file;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+    std::string format = "csv";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Convert a binary trace to CSV or column files.");
+    cmd.AddValue("input", "the binary trace", input);
+    cmd.AddValue("output", "the prefix of the output files [default: the input]", output);
+    cmd.AddValue("format", "csv, or columns", format);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(input.empty(), "Missing --input");
+    NS_ABORT_MSG_UNLESS(format == "csv" || format == "columns", "Unknown format " << format);
+    if (output.empty())
+    {
+        output = input;
+    }
+
+    BinaryTraceReader reader;
+    NS_ABORT_MSG_UNLESS(reader.Open(input), "Can't read the binary trace " << input);
+
+    // the output files of each record type, opened on its first record
+    std::vector<std::vector<std::unique_ptr<std::ofstream>>> files;
+    uint64_t nRecords = 0;
+    while (reader.Next())
+    {
+        uint16_t type = reader.GetType();
+        const BinaryTraceSchema& schema = reader.GetSchema();
+        if (files.size() <= type)
+        {
+            files.resize(type + 1);
+        }
+        std::vector<std::unique_ptr<std::ofstream>>& typeFiles = files[type];
+        if (typeFiles.empty())
+        {
+            std::string prefix = output + "-" + schema.GetName();
+            if (format == "csv")
+            {
+                typeFiles.push_back(OpenOutput(prefix + ".csv"));
+                for (std::size_t i = 0; i < schema.GetNFields(); i++)
+                {
+                    *typeFiles[0] << (i == 0 ? "" : ",") << schema.GetField(i).name;
+                }
+                *typeFiles[0] << "\n";
+            }
+            else
+            {
+                for (std::size_t i = 0; i < schema.GetNFields(); i++)
+                {
+                    const BinaryTraceSchema::Field& field = schema.GetField(i);
+                    typeFiles.push_back(
+                        OpenOutput(prefix + "-" + field.name + "." +
+                                   BinaryTraceSchema::GetFieldTypeName(field.type)));
+                }
+            }
+        }
+
+        if (format == "csv")
+        {
+            std::ostream& os = *typeFiles[0];
+            for (std::size_t i = 0; i < schema.GetNFields(); i++)
+            {
+                if (i > 0)
+                {
+                    os << ",";
+                }
+                reader.Print(os, i);
+            }
+            os << "\n";
+        }
+        else
+        {
+            for (std::size_t i = 0; i < schema.GetNFields(); i++)
+            {
+                const BinaryTraceSchema::Field& field = schema.GetField(i);
+                typeFiles[i]->write(reinterpret_cast<const char*>(reader.GetData()) + field.offset,
+                                    BinaryTraceSchema::GetFieldSize(field.type));
+            }
+        }
+        nRecords++;
+    }
+    NS_ABORT_MSG_IF(reader.Fail(), "Invalid binary trace " << input);
+    std::cout << nRecords << " records converted" << std::endl;
+
+    return 0;
+}
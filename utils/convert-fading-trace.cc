@@ -0,0 +1,69 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program converts a text fading trace, as generated by the
+// fading_trace_generator.m script of the LTE module, to a binary fading
+// trace, which TraceFadingLossModel maps in memory instead of parsing it.
+// With --format=float, the samples are stored as 32 bits floats.
+// With --format=int16, the samples are quantized to 16 bits integers, in
+// units of --step dB, which halves the size of the trace.
+// Sample usage:
+//  ./ns3 run 'convert-fading-trace --input=fading_trace_EPA_3kmph.fad
+//             --output=fading_trace_EPA_3kmph.fadb --format=int16'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/fading-trace.h"
+
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+    std::string format = "float";
+    uint32_t rbNum = 100;
+    uint32_t samplesNum = 10000;
+    double step = 0.01;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Convert a text fading trace to a binary fading trace.");
+    cmd.AddValue("input", "the text trace", input);
+    cmd.AddValue("output", "the binary trace [default: the input, with .fadb]", output);
+    cmd.AddValue("rbNum", "the number of RBs of the trace", rbNum);
+    cmd.AddValue("samplesNum", "the number of samples of each RB", samplesNum);
+    cmd.AddValue("format", "float, or int16", format);
+    cmd.AddValue("step", "the quantization step of the int16 format, in dB", step);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(input.empty(), "Missing --input");
+    NS_ABORT_MSG_UNLESS(format == "float" || format == "int16", "Unknown format " << format);
+    NS_ABORT_MSG_UNLESS(step > 0, "The step must be positive");
+    if (output.empty())
+    {
+        output = input.substr(0, input.rfind(".fad")) + ".fadb";
+    }
+
+    FadingTrace::SampleType type = format == "float" ? FadingTrace::FLOAT : FadingTrace::INT16;
+    NS_ABORT_MSG_UNLESS(
+        FadingTrace::ConvertTextTrace(input, output, rbNum, samplesNum, type, step),
+        "Can't convert the fading trace " << input);
+    std::cout << "Wrote " << output << std::endl;
+    return 0;
+}
@@ -0,0 +1,63 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program converts an ns-2 movement file, as read by the
+// Ns2MobilityHelper, to a waypoint trace sorted by time, which the
+// TraceMobilityHelper streams to the WaypointMobilityModel of the nodes.
+// With --format=binary, the trace is mapped in memory while it is read.
+// With --format=csv, the trace is a text file, one waypoint per line.
+// With --maxGap, the moves and pauses longer than --maxGap seconds are
+// split, which bounds the window the TraceMobilityHelper reads ahead.
+// Sample usage:
+//  ./ns3 run 'convert-ns2-mobility --input=default.ns_movements
+//             --output=default.wpt --maxGap=10'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/waypoint-trace.h"
+
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+    std::string format = "binary";
+    double maxGap = 0;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Convert an ns-2 movement file to a waypoint trace.");
+    cmd.AddValue("input", "the ns-2 movement file", input);
+    cmd.AddValue("output", "the waypoint trace [default: the input, with .wpt]", output);
+    cmd.AddValue("format", "binary, or csv", format);
+    cmd.AddValue("maxGap", "if positive, the maximum time between two waypoints, in s", maxGap);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(input.empty(), "Missing --input");
+    NS_ABORT_MSG_UNLESS(format == "binary" || format == "csv", "Unknown format " << format);
+    if (output.empty())
+    {
+        output = input.substr(0, input.rfind('.')) + ".wpt";
+    }
+
+    NS_ABORT_MSG_UNLESS(WaypointTrace::ConvertNs2Trace(input, output, format == "binary", maxGap),
+                        "Can't convert the ns-2 movement file " << input);
+    std::cout << "Wrote " << output << std::endl;
+    return 0;
+}